@@ -53,6 +53,17 @@
 #define PLANK_ATOMIC_XMAX           0xFFFFFFFFFFFFFFFFUL
 #define PLANK_ATOMIC_PMASK          0xFFFFFFFFFFFFFFFFUL
 
+// use the __atomic builtins where available so operations can specify their memory ordering
+#if defined(__ATOMIC_ACQUIRE) && defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_8)
+    #define PLANK_ATOMIC_MEMORYORDER 1
+#endif
+
+// cmpxchg16b is available on all but the earliest x86-64 processors even if the compiler
+// hasn't been told to use it (i.e., without -mcx16)
+#if defined(__x86_64__) && !defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+    #define PLANK_ATOMIC_CMPXCHG16B 1
+#endif
+
 #if !DOXYGEN
 typedef struct PlankAtomicI
 {
@@ -111,7 +122,7 @@ typedef struct PlankAtomicP
 } PlankAtomicP PLANK_ALIGN(8);
 #endif
 
-#ifdef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_16
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16) || PLANK_ATOMIC_CMPXCHG16B
 typedef struct PlankAtomicPX
 {
     volatile PlankP ptr;
@@ -142,6 +153,18 @@ static PLANK_INLINE_LOW void pl_AtomicMemoryBarrier()
     __sync_synchronize();
 }
 
+#if PLANK_ATOMIC_MEMORYORDER
+static PLANK_INLINE_LOW void pl_AtomicAcquireFence()
+{
+    __atomic_thread_fence (__ATOMIC_ACQUIRE);
+}
+
+static PLANK_INLINE_LOW void pl_AtomicReleaseFence()
+{
+    __atomic_thread_fence (__ATOMIC_RELEASE);
+}
+#endif
+
 //------------------------------------------------------------------------------
 
 static PLANK_INLINE_LOW PlankResult pl_AtomicI_Init (PlankAtomicIRef p)
@@ -173,6 +196,9 @@ static PLANK_INLINE_LOW PlankI pl_AtomicI_GetUnchecked (PlankAtomicIRef p)
 
 static PLANK_INLINE_LOW PlankI pl_AtomicI_Swap (PlankAtomicIRef p, PlankI newValue)
 {
+#if PLANK_ATOMIC_MEMORYORDER
+    return __atomic_exchange_n (&p->value, newValue, __ATOMIC_SEQ_CST);
+#else
     PlankI oldValue;
     PlankB success;
     
@@ -182,6 +208,7 @@ static PLANK_INLINE_LOW PlankI pl_AtomicI_Swap (PlankAtomicIRef p, PlankI newVal
     } while (!success);
     
     return oldValue;
+#endif
 }
 
 static PLANK_INLINE_LOW void pl_AtomicI_SwapOther (PlankAtomicIRef p1, PlankAtomicIRef p2)
@@ -200,7 +227,11 @@ static PLANK_INLINE_LOW void pl_AtomicI_SwapOther (PlankAtomicIRef p1, PlankAtom
 
 static PLANK_INLINE_LOW void pl_AtomicI_Set (PlankAtomicIRef p, PlankI newValue)
 {
+#if PLANK_ATOMIC_MEMORYORDER
+    __atomic_store_n (&p->value, newValue, __ATOMIC_SEQ_CST);
+#else
     pl_AtomicI_Swap (p, newValue);
+#endif
 }
 
 static PLANK_INLINE_LOW PlankI pl_AtomicI_Add (PlankAtomicIRef p, PlankI operand)
@@ -261,6 +292,9 @@ static PLANK_INLINE_LOW PlankL pl_AtomicL_GetUnchecked (PlankAtomicLRef p)
 
 static PLANK_INLINE_LOW PlankL pl_AtomicL_Swap (PlankAtomicLRef p, PlankL newValue)
 {
+#if PLANK_ATOMIC_MEMORYORDER
+    return __atomic_exchange_n (&p->value, newValue, __ATOMIC_SEQ_CST);
+#else
     PlankL oldValue;
     PlankB success;
     
@@ -270,6 +304,7 @@ static PLANK_INLINE_LOW PlankL pl_AtomicL_Swap (PlankAtomicLRef p, PlankL newVal
     } while (!success);
     
     return oldValue;
+#endif
 }
 
 static PLANK_INLINE_LOW void pl_AtomicL_SwapOther (PlankAtomicLRef p1, PlankAtomicLRef p2)
@@ -288,7 +323,11 @@ static PLANK_INLINE_LOW void pl_AtomicL_SwapOther (PlankAtomicLRef p1, PlankAtom
 
 static PLANK_INLINE_LOW void pl_AtomicL_Set (PlankAtomicLRef p, PlankL newValue)
 {
+#if PLANK_ATOMIC_MEMORYORDER
+    __atomic_store_n (&p->value, newValue, __ATOMIC_SEQ_CST);
+#else
     pl_AtomicL_Swap (p, newValue);
+#endif
 }
 
 #ifdef  __GCC_HAVE_SYNC_COMPARE_AND_SWAP_8
@@ -395,6 +434,9 @@ static PLANK_INLINE_LOW PlankLL pl_AtomicLL_GetUnchecked (PlankAtomicLLRef p)
 
 static PLANK_INLINE_LOW PlankLL pl_AtomicLL_Swap (PlankAtomicLLRef p, PlankLL newValue)
 {
+#if PLANK_ATOMIC_MEMORYORDER
+    return __atomic_exchange_n (&p->value, newValue, __ATOMIC_SEQ_CST);
+#else
     PlankLL oldValue;
     PlankB success;
     
@@ -404,6 +446,7 @@ static PLANK_INLINE_LOW PlankLL pl_AtomicLL_Swap (PlankAtomicLLRef p, PlankLL ne
     } while (!success);
     
     return oldValue;
+#endif
 }
 
 static PLANK_INLINE_LOW void pl_AtomicLL_SwapOther (PlankAtomicLLRef p1, PlankAtomicLLRef p2)
@@ -422,7 +465,11 @@ static PLANK_INLINE_LOW void pl_AtomicLL_SwapOther (PlankAtomicLLRef p1, PlankAt
 
 static PLANK_INLINE_LOW void pl_AtomicLL_Set (PlankAtomicLLRef p, PlankLL newValue)
 {
+#if PLANK_ATOMIC_MEMORYORDER
+    __atomic_store_n (&p->value, newValue, __ATOMIC_SEQ_CST);
+#else
     pl_AtomicLL_Swap (p, newValue);
+#endif
 }
 
 #ifdef  __GCC_HAVE_SYNC_COMPARE_AND_SWAP_8
@@ -735,6 +782,9 @@ static PLANK_INLINE_LOW PlankP pl_AtomicP_GetUnchecked (PlankAtomicPRef p)
 
 static PLANK_INLINE_LOW PlankP pl_AtomicP_Swap (PlankAtomicPRef p, PlankP newPtr)
 {
+#if PLANK_ATOMIC_MEMORYORDER
+    return __atomic_exchange_n (&p->ptr, newPtr, __ATOMIC_SEQ_CST);
+#else
     PlankP oldPtr;
     PlankB success;
     
@@ -744,6 +794,7 @@ static PLANK_INLINE_LOW PlankP pl_AtomicP_Swap (PlankAtomicPRef p, PlankP newPtr
     } while (!success);
     
     return oldPtr;    
+#endif
 }
 
 static PLANK_INLINE_LOW void pl_AtomicP_SwapOther (PlankAtomicPRef p1, PlankAtomicPRef p2)
@@ -762,7 +813,11 @@ static PLANK_INLINE_LOW void pl_AtomicP_SwapOther (PlankAtomicPRef p1, PlankAtom
 
 static PLANK_INLINE_LOW void pl_AtomicP_Set (PlankAtomicPRef p, PlankP newPtr)
 {
+#if PLANK_ATOMIC_MEMORYORDER
+    __atomic_store_n (&p->ptr, newPtr, __ATOMIC_SEQ_CST);
+#else
     pl_AtomicP_Swap (p, newPtr);
+#endif
 }
 
 #ifdef  __GCC_HAVE_SYNC_COMPARE_AND_SWAP_8
@@ -1017,10 +1072,24 @@ static PLANK_INLINE_LOW  PlankB pl_AtomicPX_CompareAndSwap (PlankAtomicPXRef p,
     PlankAtomicPX oldAll = { oldPtr, oldExtra };
     PlankAtomicPX newAll = { newPtr, newExtra };
     
-    return __sync_bool_compare_and_swap ((volatile (__int128_t*)p,
+    return __sync_bool_compare_and_swap ((volatile __int128_t*)p,
                                          *(__int128_t*)&oldAll,
                                          *(__int128_t*)&newAll);
 }
+#elif PLANK_ATOMIC_CMPXCHG16B
+static PLANK_INLINE_LOW  PlankB pl_AtomicPX_CompareAndSwap (PlankAtomicPXRef p, PlankP oldPtr, PlankUL oldExtra, PlankP newPtr, PlankUL newExtra)
+{
+    PlankUC success;
+    
+    // compares rdx:rax with the 16 bytes at p and if equal stores rcx:rbx there
+    __asm__ __volatile__ ("lock cmpxchg16b %1\n\t"
+                          "sete %0"
+                          : "=q" (success), "+m" (*p), "+a" (oldPtr), "+d" (oldExtra)
+                          : "b" (newPtr), "c" (newExtra)
+                          : "cc", "memory");
+    
+    return success;
+}
 #elif defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_8)
 static PLANK_INLINE_LOW  PlankB pl_AtomicPX_CompareAndSwap (PlankAtomicPXRef p, PlankP oldPtr, PlankUL oldExtra, PlankP newPtr, PlankUL newExtra)
 {
@@ -1070,6 +1139,137 @@ static PLANK_INLINE_LOW void pl_AtomicPX_SetAllUnchecked (PlankAtomicPXRef p, Pl
     p->extra = newExtra;
 }
 
+//------------------------------------------------------------------------------
+
+#if PLANK_ATOMIC_MEMORYORDER
+
+static PLANK_INLINE_LOW PlankI pl_AtomicI_GetAcquire (PlankAtomicIRef p)
+{
+    return __atomic_load_n (&p->value, __ATOMIC_ACQUIRE);
+}
+
+static PLANK_INLINE_LOW void pl_AtomicI_SetRelease (PlankAtomicIRef p, PlankI newValue)
+{
+    __atomic_store_n (&p->value, newValue, __ATOMIC_RELEASE);
+}
+
+static PLANK_INLINE_LOW PlankI pl_AtomicI_AddRelaxed (PlankAtomicIRef p, PlankI operand)
+{
+    return __atomic_add_fetch (&p->value, operand, __ATOMIC_RELAXED);
+}
+
+static PLANK_INLINE_LOW PlankI pl_AtomicI_AddRelease (PlankAtomicIRef p, PlankI operand)
+{
+    return __atomic_add_fetch (&p->value, operand, __ATOMIC_RELEASE);
+}
+
+static PLANK_INLINE_LOW PlankL pl_AtomicL_GetAcquire (PlankAtomicLRef p)
+{
+    return __atomic_load_n (&p->value, __ATOMIC_ACQUIRE);
+}
+
+static PLANK_INLINE_LOW void pl_AtomicL_SetRelease (PlankAtomicLRef p, PlankL newValue)
+{
+    __atomic_store_n (&p->value, newValue, __ATOMIC_RELEASE);
+}
+
+static PLANK_INLINE_LOW PlankL pl_AtomicL_AddRelaxed (PlankAtomicLRef p, PlankL operand)
+{
+    return __atomic_add_fetch (&p->value, operand, __ATOMIC_RELAXED);
+}
+
+static PLANK_INLINE_LOW PlankL pl_AtomicL_AddRelease (PlankAtomicLRef p, PlankL operand)
+{
+    return __atomic_add_fetch (&p->value, operand, __ATOMIC_RELEASE);
+}
+
+static PLANK_INLINE_LOW PlankLL pl_AtomicLL_GetAcquire (PlankAtomicLLRef p)
+{
+    return __atomic_load_n (&p->value, __ATOMIC_ACQUIRE);
+}
+
+static PLANK_INLINE_LOW void pl_AtomicLL_SetRelease (PlankAtomicLLRef p, PlankLL newValue)
+{
+    __atomic_store_n (&p->value, newValue, __ATOMIC_RELEASE);
+}
+
+static PLANK_INLINE_LOW PlankLL pl_AtomicLL_AddRelaxed (PlankAtomicLLRef p, PlankLL operand)
+{
+    return __atomic_add_fetch (&p->value, operand, __ATOMIC_RELAXED);
+}
+
+static PLANK_INLINE_LOW PlankLL pl_AtomicLL_AddRelease (PlankAtomicLLRef p, PlankLL operand)
+{
+    return __atomic_add_fetch (&p->value, operand, __ATOMIC_RELEASE);
+}
+
+static PLANK_INLINE_LOW PlankF pl_AtomicF_GetAcquire (PlankAtomicFRef p)
+{
+    PlankF value;
+    __atomic_load ((PlankF*)&p->value, &value, __ATOMIC_ACQUIRE);
+    return value;
+}
+
+static PLANK_INLINE_LOW void pl_AtomicF_SetRelease (PlankAtomicFRef p, PlankF newValue)
+{
+    __atomic_store ((PlankF*)&p->value, &newValue, __ATOMIC_RELEASE);
+}
+
+static PLANK_INLINE_LOW PlankF pl_AtomicF_AddRelaxed (PlankAtomicFRef p, PlankF operand)
+{
+    return pl_AtomicF_Add (p, operand); // no floating point fetch-add
+}
+
+static PLANK_INLINE_LOW PlankF pl_AtomicF_AddRelease (PlankAtomicFRef p, PlankF operand)
+{
+    return pl_AtomicF_Add (p, operand);
+}
+
+static PLANK_INLINE_LOW PlankD pl_AtomicD_GetAcquire (PlankAtomicDRef p)
+{
+    PlankD value;
+    __atomic_load ((PlankD*)&p->value, &value, __ATOMIC_ACQUIRE);
+    return value;
+}
+
+static PLANK_INLINE_LOW void pl_AtomicD_SetRelease (PlankAtomicDRef p, PlankD newValue)
+{
+    __atomic_store ((PlankD*)&p->value, &newValue, __ATOMIC_RELEASE);
+}
+
+static PLANK_INLINE_LOW PlankD pl_AtomicD_AddRelaxed (PlankAtomicDRef p, PlankD operand)
+{
+    return pl_AtomicD_Add (p, operand); // no floating point fetch-add
+}
+
+static PLANK_INLINE_LOW PlankD pl_AtomicD_AddRelease (PlankAtomicDRef p, PlankD operand)
+{
+    return pl_AtomicD_Add (p, operand);
+}
+
+static PLANK_INLINE_LOW PlankP pl_AtomicP_GetAcquire (PlankAtomicPRef p)
+{
+    return __atomic_load_n (&p->ptr, __ATOMIC_ACQUIRE);
+}
+
+static PLANK_INLINE_LOW void pl_AtomicP_SetRelease (PlankAtomicPRef p, PlankP newPtr)
+{
+    __atomic_store_n (&p->ptr, newPtr, __ATOMIC_RELEASE);
+}
+
+static PLANK_INLINE_LOW PlankP pl_AtomicP_AddRelaxed (PlankAtomicPRef p, PlankL operand)
+{
+    return (PlankP)__atomic_add_fetch ((volatile PlankL*)p, operand, __ATOMIC_RELAXED);
+}
+
+static PLANK_INLINE_LOW PlankP pl_AtomicP_AddRelease (PlankAtomicPRef p, PlankL operand)
+{
+    return (PlankP)__atomic_add_fetch ((volatile PlankL*)p, operand, __ATOMIC_RELEASE);
+}
+
+#define PLANK_ATOMICS_ORDERED_DEFINED 1
+#endif // PLANK_ATOMIC_MEMORYORDER
+
 #define PLANK_ATOMICS_DEFINED 1
                             
 #endif // __GCC_HAVE_SYNC_COMPARE_AND_SWAP_4                                         
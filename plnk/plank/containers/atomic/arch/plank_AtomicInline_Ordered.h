@@ -0,0 +1,202 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+// help prevent accidental inclusion other than via the intended header
+#if PLANK_INLINING_FUNCTIONS
+
+// Memory ordered operations for platforms without a native implementation.
+// These use the fully ordered operations which are always at least as strong.
+
+static PLANK_INLINE_LOW void pl_AtomicAcquireFence()
+{
+    pl_AtomicMemoryBarrier();
+}
+
+static PLANK_INLINE_LOW void pl_AtomicReleaseFence()
+{
+    pl_AtomicMemoryBarrier();
+}
+
+//------------------------------------------------------------------------------
+
+static PLANK_INLINE_LOW PlankI pl_AtomicI_GetAcquire (PlankAtomicIRef p)
+{
+    const PlankI value = pl_AtomicI_Get (p);
+    pl_AtomicMemoryBarrier();
+    return value;
+}
+
+static PLANK_INLINE_LOW void pl_AtomicI_SetRelease (PlankAtomicIRef p, PlankI newValue)
+{
+    pl_AtomicI_Set (p, newValue);
+}
+
+static PLANK_INLINE_LOW PlankI pl_AtomicI_AddRelaxed (PlankAtomicIRef p, PlankI operand)
+{
+    return pl_AtomicI_Add (p, operand);
+}
+
+static PLANK_INLINE_LOW PlankI pl_AtomicI_AddRelease (PlankAtomicIRef p, PlankI operand)
+{
+    return pl_AtomicI_Add (p, operand);
+}
+
+//------------------------------------------------------------------------------
+
+static PLANK_INLINE_LOW PlankL pl_AtomicL_GetAcquire (PlankAtomicLRef p)
+{
+    const PlankL value = pl_AtomicL_Get (p);
+    pl_AtomicMemoryBarrier();
+    return value;
+}
+
+static PLANK_INLINE_LOW void pl_AtomicL_SetRelease (PlankAtomicLRef p, PlankL newValue)
+{
+    pl_AtomicL_Set (p, newValue);
+}
+
+static PLANK_INLINE_LOW PlankL pl_AtomicL_AddRelaxed (PlankAtomicLRef p, PlankL operand)
+{
+    return pl_AtomicL_Add (p, operand);
+}
+
+static PLANK_INLINE_LOW PlankL pl_AtomicL_AddRelease (PlankAtomicLRef p, PlankL operand)
+{
+    return pl_AtomicL_Add (p, operand);
+}
+
+//------------------------------------------------------------------------------
+
+static PLANK_INLINE_LOW PlankLL pl_AtomicLL_GetAcquire (PlankAtomicLLRef p)
+{
+    const PlankLL value = pl_AtomicLL_Get (p);
+    pl_AtomicMemoryBarrier();
+    return value;
+}
+
+static PLANK_INLINE_LOW void pl_AtomicLL_SetRelease (PlankAtomicLLRef p, PlankLL newValue)
+{
+    pl_AtomicLL_Set (p, newValue);
+}
+
+static PLANK_INLINE_LOW PlankLL pl_AtomicLL_AddRelaxed (PlankAtomicLLRef p, PlankLL operand)
+{
+    return pl_AtomicLL_Add (p, operand);
+}
+
+static PLANK_INLINE_LOW PlankLL pl_AtomicLL_AddRelease (PlankAtomicLLRef p, PlankLL operand)
+{
+    return pl_AtomicLL_Add (p, operand);
+}
+
+//------------------------------------------------------------------------------
+
+static PLANK_INLINE_LOW PlankF pl_AtomicF_GetAcquire (PlankAtomicFRef p)
+{
+    const PlankF value = pl_AtomicF_Get (p);
+    pl_AtomicMemoryBarrier();
+    return value;
+}
+
+static PLANK_INLINE_LOW void pl_AtomicF_SetRelease (PlankAtomicFRef p, PlankF newValue)
+{
+    pl_AtomicF_Set (p, newValue);
+}
+
+static PLANK_INLINE_LOW PlankF pl_AtomicF_AddRelaxed (PlankAtomicFRef p, PlankF operand)
+{
+    return pl_AtomicF_Add (p, operand);
+}
+
+static PLANK_INLINE_LOW PlankF pl_AtomicF_AddRelease (PlankAtomicFRef p, PlankF operand)
+{
+    return pl_AtomicF_Add (p, operand);
+}
+
+//------------------------------------------------------------------------------
+
+static PLANK_INLINE_LOW PlankD pl_AtomicD_GetAcquire (PlankAtomicDRef p)
+{
+    const PlankD value = pl_AtomicD_Get (p);
+    pl_AtomicMemoryBarrier();
+    return value;
+}
+
+static PLANK_INLINE_LOW void pl_AtomicD_SetRelease (PlankAtomicDRef p, PlankD newValue)
+{
+    pl_AtomicD_Set (p, newValue);
+}
+
+static PLANK_INLINE_LOW PlankD pl_AtomicD_AddRelaxed (PlankAtomicDRef p, PlankD operand)
+{
+    return pl_AtomicD_Add (p, operand);
+}
+
+static PLANK_INLINE_LOW PlankD pl_AtomicD_AddRelease (PlankAtomicDRef p, PlankD operand)
+{
+    return pl_AtomicD_Add (p, operand);
+}
+
+//------------------------------------------------------------------------------
+
+static PLANK_INLINE_LOW PlankP pl_AtomicP_GetAcquire (PlankAtomicPRef p)
+{
+    const PlankP value = pl_AtomicP_Get (p);
+    pl_AtomicMemoryBarrier();
+    return value;
+}
+
+static PLANK_INLINE_LOW void pl_AtomicP_SetRelease (PlankAtomicPRef p, PlankP newValue)
+{
+    pl_AtomicP_Set (p, newValue);
+}
+
+static PLANK_INLINE_LOW PlankP pl_AtomicP_AddRelaxed (PlankAtomicPRef p, PlankL operand)
+{
+    return pl_AtomicP_Add (p, operand);
+}
+
+static PLANK_INLINE_LOW PlankP pl_AtomicP_AddRelease (PlankAtomicPRef p, PlankL operand)
+{
+    return pl_AtomicP_Add (p, operand);
+}
+
+#define PLANK_ATOMICS_ORDERED_DEFINED 1
+
+#endif // PLANK_INLINING_FUNCTIONS
+
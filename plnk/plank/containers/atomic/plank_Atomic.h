@@ -51,6 +51,14 @@ PLANK_BEGIN_C_LINKAGE
 /** A crossplatform read/write memory barrier. */
 static void pl_AtomicMemoryBarrier();
 
+/** A barrier preventing memory accesses after it being moved before preceding loads.
+ Use after a relaxed or release operation that needs to be seen as an acquire
+ e.g., before deleting an object whose reference count has reached zero. */
+static void pl_AtomicAcquireFence();
+
+/** A barrier preventing memory accesses before it being moved after following stores. */
+static void pl_AtomicReleaseFence();
+
 /** @} */
 
 //------------------------------------------------------------------------------
@@ -165,6 +173,32 @@ static PlankI pl_AtomicI_Decrement (PlankAtomicIRef p);
  @return @c true if the swap was successful, otherwise @c false. */
 static PlankB pl_AtomicI_CompareAndSwap (PlankAtomicIRef p, PlankI oldValue, PlankI newValue);
 
+/** Get the current value with acquire ordering.
+ Memory accesses after this can't be moved before it so data published with
+ pl_AtomicI_SetRelease() is visible once the new value is seen.
+ @param p The <i>Plank %AtomicI</i> object. 
+ @return The value. */
+static PlankI pl_AtomicI_GetAcquire (PlankAtomicIRef p);
+
+/** Set the current value with release ordering.
+ Memory accesses before this can't be moved after it.
+ @param p The <i>Plank %AtomicI</i> object. 
+ @param newValue The new value to store. */
+static void pl_AtomicI_SetRelease (PlankAtomicIRef p, PlankI newValue);
+
+/** Add a value to the current value without ordering other memory accesses.
+ Suitable for counters that don't guard other data.
+ @param p The <i>Plank %AtomicI</i> object. 
+ @param operand The value to add. 
+ @return The new value. */
+static PlankI pl_AtomicI_AddRelaxed (PlankAtomicIRef p, PlankI operand);
+
+/** Add a value to the current value with release ordering.
+ @param p The <i>Plank %AtomicI</i> object. 
+ @param operand The value to add. 
+ @return The new value. */
+static PlankI pl_AtomicI_AddRelease (PlankAtomicIRef p, PlankI operand);
+
 /** @} */
 
 //------------------------------------------------------------------------------
@@ -279,6 +313,32 @@ static PlankL pl_AtomicL_Decrement (PlankAtomicLRef p);
  @return @c true if the swap was successful, otherwise @c false. */
 static PlankB pl_AtomicL_CompareAndSwap (PlankAtomicLRef p, PlankL oldValue, PlankL newValue);
 
+/** Get the current value with acquire ordering.
+ Memory accesses after this can't be moved before it so data published with
+ pl_AtomicL_SetRelease() is visible once the new value is seen.
+ @param p The <i>Plank %AtomicL</i> object. 
+ @return The value. */
+static PlankL pl_AtomicL_GetAcquire (PlankAtomicLRef p);
+
+/** Set the current value with release ordering.
+ Memory accesses before this can't be moved after it.
+ @param p The <i>Plank %AtomicL</i> object. 
+ @param newValue The new value to store. */
+static void pl_AtomicL_SetRelease (PlankAtomicLRef p, PlankL newValue);
+
+/** Add a value to the current value without ordering other memory accesses.
+ Suitable for counters that don't guard other data.
+ @param p The <i>Plank %AtomicL</i> object. 
+ @param operand The value to add. 
+ @return The new value. */
+static PlankL pl_AtomicL_AddRelaxed (PlankAtomicLRef p, PlankL operand);
+
+/** Add a value to the current value with release ordering.
+ @param p The <i>Plank %AtomicL</i> object. 
+ @param operand The value to add. 
+ @return The new value. */
+static PlankL pl_AtomicL_AddRelease (PlankAtomicLRef p, PlankL operand);
+
 /** @} */
 
 //------------------------------------------------------------------------------
@@ -397,6 +457,32 @@ static PlankLL pl_AtomicLL_Decrement (PlankAtomicLLRef p);
 //#endif
 static PlankB pl_AtomicLL_CompareAndSwap (PlankAtomicLLRef p, PlankLL oldValue, PlankLL newValue);
 
+/** Get the current value with acquire ordering.
+ Memory accesses after this can't be moved before it so data published with
+ pl_AtomicLL_SetRelease() is visible once the new value is seen.
+ @param p The <i>Plank %AtomicLL</i> object. 
+ @return The value. */
+static PlankLL pl_AtomicLL_GetAcquire (PlankAtomicLLRef p);
+
+/** Set the current value with release ordering.
+ Memory accesses before this can't be moved after it.
+ @param p The <i>Plank %AtomicLL</i> object. 
+ @param newValue The new value to store. */
+static void pl_AtomicLL_SetRelease (PlankAtomicLLRef p, PlankLL newValue);
+
+/** Add a value to the current value without ordering other memory accesses.
+ Suitable for counters that don't guard other data.
+ @param p The <i>Plank %AtomicLL</i> object. 
+ @param operand The value to add. 
+ @return The new value. */
+static PlankLL pl_AtomicLL_AddRelaxed (PlankAtomicLLRef p, PlankLL operand);
+
+/** Add a value to the current value with release ordering.
+ @param p The <i>Plank %AtomicLL</i> object. 
+ @param operand The value to add. 
+ @return The new value. */
+static PlankLL pl_AtomicLL_AddRelease (PlankAtomicLLRef p, PlankLL operand);
+
 /** @} */
 
 //------------------------------------------------------------------------------
@@ -515,6 +601,32 @@ static PlankF pl_AtomicF_Decrement (PlankAtomicFRef p);
  @return @c true if the swap was successful, otherwise @c false. */
 static PlankB pl_AtomicF_CompareAndSwap (PlankAtomicFRef p, PlankF oldValue, PlankF newValue);
 
+/** Get the current value with acquire ordering.
+ Memory accesses after this can't be moved before it so data published with
+ pl_AtomicF_SetRelease() is visible once the new value is seen.
+ @param p The <i>Plank %AtomicF</i> object. 
+ @return The value. */
+static PlankF pl_AtomicF_GetAcquire (PlankAtomicFRef p);
+
+/** Set the current value with release ordering.
+ Memory accesses before this can't be moved after it.
+ @param p The <i>Plank %AtomicF</i> object. 
+ @param newValue The new value to store. */
+static void pl_AtomicF_SetRelease (PlankAtomicFRef p, PlankF newValue);
+
+/** Add a value to the current value without ordering other memory accesses.
+ Suitable for counters that don't guard other data.
+ @param p The <i>Plank %AtomicF</i> object. 
+ @param operand The value to add. 
+ @return The new value. */
+static PlankF pl_AtomicF_AddRelaxed (PlankAtomicFRef p, PlankF operand);
+
+/** Add a value to the current value with release ordering.
+ @param p The <i>Plank %AtomicF</i> object. 
+ @param operand The value to add. 
+ @return The new value. */
+static PlankF pl_AtomicF_AddRelease (PlankAtomicFRef p, PlankF operand);
+
 /** @} */
 
 //------------------------------------------------------------------------------
@@ -636,6 +748,32 @@ static PlankD pl_AtomicD_Decrement (PlankAtomicDRef p);
  @return @c true if the swap was successful, otherwise @c false. */
 static PlankB pl_AtomicD_CompareAndSwap (PlankAtomicDRef p, PlankD oldValue, PlankD newValue);
 
+/** Get the current value with acquire ordering.
+ Memory accesses after this can't be moved before it so data published with
+ pl_AtomicD_SetRelease() is visible once the new value is seen.
+ @param p The <i>Plank %AtomicD</i> object. 
+ @return The value. */
+static PlankD pl_AtomicD_GetAcquire (PlankAtomicDRef p);
+
+/** Set the current value with release ordering.
+ Memory accesses before this can't be moved after it.
+ @param p The <i>Plank %AtomicD</i> object. 
+ @param newValue The new value to store. */
+static void pl_AtomicD_SetRelease (PlankAtomicDRef p, PlankD newValue);
+
+/** Add a value to the current value without ordering other memory accesses.
+ Suitable for counters that don't guard other data.
+ @param p The <i>Plank %AtomicD</i> object. 
+ @param operand The value to add. 
+ @return The new value. */
+static PlankD pl_AtomicD_AddRelaxed (PlankAtomicDRef p, PlankD operand);
+
+/** Add a value to the current value with release ordering.
+ @param p The <i>Plank %AtomicD</i> object. 
+ @param operand The value to add. 
+ @return The new value. */
+static PlankD pl_AtomicD_AddRelease (PlankAtomicDRef p, PlankD operand);
+
 /** @} */
 
 //------------------------------------------------------------------------------
@@ -752,6 +890,32 @@ static PlankP pl_AtomicP_Decrement (PlankAtomicPRef p);
  @return @c true if the swap was successful, otherwise @c false. */
 static PlankB pl_AtomicP_CompareAndSwap (PlankAtomicPRef p, PlankP oldPtr, PlankP newPtr);
 
+/** Get the current value with acquire ordering.
+ Memory accesses after this can't be moved before it so data published with
+ pl_AtomicP_SetRelease() is visible once the new pointer is seen.
+ @param p The <i>Plank %AtomicP</i> object. 
+ @return The pointer. */
+static PlankP pl_AtomicP_GetAcquire (PlankAtomicPRef p);
+
+/** Set the current value with release ordering.
+ Memory accesses before this can't be moved after it.
+ @param p The <i>Plank %AtomicP</i> object. 
+ @param newPtr The new pointer to store. */
+static void pl_AtomicP_SetRelease (PlankAtomicPRef p, PlankP newPtr);
+
+/** Add a value to the current value without ordering other memory accesses.
+ Suitable for counters that don't guard other data.
+ @param p The <i>Plank %AtomicP</i> object. 
+ @param operand The value to add. 
+ @return The new pointer. */
+static PlankP pl_AtomicP_AddRelaxed (PlankAtomicPRef p, PlankL operand);
+
+/** Add a value to the current value with release ordering.
+ @param p The <i>Plank %AtomicP</i> object. 
+ @param operand The value to add. 
+ @return The new pointer. */
+static PlankP pl_AtomicP_AddRelease (PlankAtomicPRef p, PlankL operand);
+
 /** @} */
 
 //------------------------------------------------------------------------------
@@ -68,3 +68,7 @@
 #if !PLANK_ATOMICS_DEFINED
 #include "arch/plank_AtomicInline_Lock.h"
 #endif
+
+#if !PLANK_ATOMICS_ORDERED_DEFINED
+#include "arch/plank_AtomicInline_Ordered.h"
+#endif
@@ -250,7 +250,7 @@ PlankResult pl_LockFreeQueue_Push (PlankLockFreeQueueRef p, const PlankLockFreeQ
                                 tailElement, tailExtra,
                                 element, tailExtra + 1);
 
-    pl_AtomicI_Increment (&p->count);
+    pl_AtomicI_AddRelaxed (&p->count, 1);
 
     return result;
 }
@@ -424,7 +424,7 @@ PlankResult pl_LockFreeQueue_Pop (PlankLockFreeQueueRef p, PlankLockFreeQueueEle
         }
     }
     
-    pl_AtomicI_Decrement (&p->count);
+    pl_AtomicI_AddRelaxed (&p->count, -1);
     
     if (headElement == &p->dummyElement)
     {
@@ -207,7 +207,7 @@ PlankResult pl_LockFreeStack_Push (PlankLockFreeStackRef p, const PlankLockFreeS
         success = pl_AtomicPX_CompareAndSwap ((PlankAtomicPXRef)&(p->atom), oldPtr, oldExtra, newPtr, newExtra);
 	} while (!success);
     
-    pl_AtomicLL_Increment (&p->count);
+    pl_AtomicLL_AddRelaxed (&p->count, 1);
     
     return result;
 }
@@ -240,7 +240,7 @@ PlankResult pl_LockFreeStack_Pop (PlankLockFreeStackRef p, PlankLockFreeStackEle
 	} while (!success);
     
     *element = headPtr;
-    pl_AtomicLL_Decrement (&p->count);
+    pl_AtomicLL_AddRelaxed (&p->count, -1);
 
 exit:
     return result;    
@@ -0,0 +1,337 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+/*
+ Based on the bounded MPMC queue by Dmitry Vyukov
+ http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ 
+ Each slot's sequence number is its position when it is free for a producer and 
+ its position + 1 once a producer has copied in its item. The consumer sets it to
+ position + capacity as it frees the slot for the next lap.
+ */
+
+#include "../core/plank_StandardHeader.h"
+#include "plank_RingBufferMPSC.h"
+#include "../maths/plank_Maths.h"
+
+#define PLANKRINGBUFFER_MAXIMUMCAPACITY 0x40000000
+
+PlankRingBufferMPSCRef pl_RingBufferMPSC_CreateAndInit()
+{
+    PlankRingBufferMPSCRef p;
+    p = pl_RingBufferMPSC_Create();
+    
+    if (p != PLANK_NULL)
+    {
+        if (pl_RingBufferMPSC_Init (p) != PlankResult_OK)
+            pl_RingBufferMPSC_Destroy (p);
+        else
+            return p;
+    }
+    
+    return PLANK_NULL;
+}
+
+PlankRingBufferMPSCRef pl_RingBufferMPSC_Create()
+{
+    PlankMemoryRef m;
+    PlankRingBufferMPSCRef p;
+    
+    m = pl_MemoryGlobal();
+    p = (PlankRingBufferMPSCRef)pl_Memory_AllocateBytes (m, sizeof (PlankRingBufferMPSC));
+    
+    if (p != PLANK_NULL)
+        pl_MemoryZero (p, sizeof (PlankRingBufferMPSC));
+    
+    return p;
+}
+
+PlankResult pl_RingBufferMPSC_Init (PlankRingBufferMPSCRef p)
+{
+    return pl_RingBufferMPSC_InitWithItemSizeAndCapacity (p, sizeof (PlankP), PLANKRINGBUFFER_DEFAULTCAPACITY);
+}
+
+PlankResult pl_RingBufferMPSC_InitWithItemSizeAndCapacity (PlankRingBufferMPSCRef p, const PlankL itemSize, const PlankL capacity)
+{
+    PlankResult result = PlankResult_OK;
+    PlankMemoryRef m;
+    PlankUI roundedCapacity, i;
+    
+    if (p == PLANK_NULL)
+    {
+        result = PlankResult_MemoryError;
+        goto exit;
+    }
+    
+    if ((itemSize <= 0) || (capacity <= 0) || (capacity > PLANKRINGBUFFER_MAXIMUMCAPACITY))
+    {
+        result = PlankResult_ItemCountInvalid;
+        goto exit;
+    }
+    
+    pl_MemoryZero (p, sizeof (PlankRingBufferMPSC));
+    
+    roundedCapacity = 1;
+    
+    while (roundedCapacity < (PlankUI)capacity)
+        roundedCapacity <<= 1;
+    
+    m = pl_MemoryGlobal();
+    p->sequences = (PlankAtomicI*)pl_Memory_AllocateBytes (m, roundedCapacity * sizeof (PlankAtomicI));
+    p->items = (PlankUC*)pl_Memory_AllocateBytes (m, roundedCapacity * itemSize);
+    
+    if ((p->sequences == PLANK_NULL) || (p->items == PLANK_NULL))
+    {
+        result = PlankResult_MemoryError;
+        goto exit;
+    }
+    
+    for (i = 0; i < roundedCapacity; ++i)
+    {
+        pl_AtomicI_Init (&p->sequences[i]);
+        pl_AtomicI_Set (&p->sequences[i], (PlankI)i);
+    }
+    
+    p->mask = roundedCapacity - 1;
+    p->itemSize = itemSize;
+    
+    pl_AtomicI_Init (&p->head);
+    pl_AtomicI_Init (&p->tail);
+    
+exit:
+    return result;
+}
+
+PlankResult pl_RingBufferMPSC_DeInit (PlankRingBufferMPSCRef p)
+{
+    PlankResult result = PlankResult_OK;
+    PlankMemoryRef m;
+    
+    if (p == PLANK_NULL)
+    {
+        result = PlankResult_MemoryError;
+        goto exit;
+    }
+    
+    m = pl_MemoryGlobal();
+    
+    if (p->sequences != PLANK_NULL)
+    {
+        if ((result = pl_Memory_Free (m, p->sequences)) != PlankResult_OK)
+            goto exit;
+    }
+    
+    if (p->items != PLANK_NULL)
+    {
+        if ((result = pl_Memory_Free (m, p->items)) != PlankResult_OK)
+            goto exit;
+    }
+    
+    pl_AtomicI_DeInit (&p->head);
+    pl_AtomicI_DeInit (&p->tail);
+    pl_MemoryZero (p, sizeof (PlankRingBufferMPSC));
+    
+exit:
+    return result;
+}
+
+PlankResult pl_RingBufferMPSC_Destroy (PlankRingBufferMPSCRef p)
+{
+    PlankResult result = PlankResult_OK;
+    PlankMemoryRef m = pl_MemoryGlobal();
+    
+    if (p == PLANK_NULL)
+    {
+        result = PlankResult_MemoryError;
+        goto exit;
+    }
+    
+    if ((result = pl_RingBufferMPSC_DeInit (p)) != PlankResult_OK)
+        goto exit;
+    
+    result = pl_Memory_Free (m, p);
+    
+exit:
+    return result;
+}
+
+PlankResult pl_RingBufferMPSC_Clear (PlankRingBufferMPSCRef p)
+{
+    PlankUI head = (PlankUI)pl_AtomicI_GetUnchecked (&p->head);
+    PlankAtomicIRef sequence = &p->sequences[head & p->mask];
+    
+    while ((PlankUI)pl_AtomicI_Get (sequence) == (head + 1))
+    {
+        pl_AtomicI_Set (sequence, (PlankI)(head + p->mask + 1));
+        sequence = &p->sequences[++head & p->mask];
+    }
+    
+    pl_AtomicI_Set (&p->head, (PlankI)head);
+    
+    return PlankResult_OK;
+}
+
+PlankB pl_RingBufferMPSC_Push (PlankRingBufferMPSCRef p, PlankConstantP item)
+{
+    PlankUI tail = (PlankUI)pl_AtomicI_Get (&p->tail);
+    PlankI diff;
+    
+    for (;;)
+    {
+        diff = (PlankI)((PlankUI)pl_AtomicI_Get (&p->sequences[tail & p->mask]) - tail);
+        
+        if (diff == 0)
+        {
+            if (pl_AtomicI_CompareAndSwap (&p->tail, (PlankI)tail, (PlankI)(tail + 1)))
+                break;
+        }
+        else if (diff < 0)
+        {
+            return PLANK_FALSE; // the consumer hasn't freed this slot yet
+        }
+        
+        tail = (PlankUI)pl_AtomicI_Get (&p->tail);
+    }
+    
+    pl_MemoryCopy (p->items + (tail & p->mask) * p->itemSize, item, p->itemSize);
+    pl_AtomicI_Set (&p->sequences[tail & p->mask], (PlankI)(tail + 1)); // publishes the item to the consumer
+    
+    return PLANK_TRUE;
+}
+
+PlankL pl_RingBufferMPSC_PushItems (PlankRingBufferMPSCRef p, PlankConstantP items, const PlankL count)
+{
+    const PlankUC* src;
+    PlankUI tail, space, last, n, i;
+    PlankI diff;
+    
+    if (count <= 0)
+        return 0;
+    
+    tail = (PlankUI)pl_AtomicI_Get (&p->tail);
+    
+    for (;;)
+    {
+        space = p->mask + 1 - (tail - (PlankUI)pl_AtomicI_Get (&p->head));
+        n = pl_MinUI (pl_MinUI (space, (PlankUI)count), p->mask + 1);
+        
+        if (n == 0)
+            return 0;
+        
+        // the consumer frees slots in order so if the last slot is free for us so are all the others
+        last = tail + n - 1;
+        diff = (PlankI)((PlankUI)pl_AtomicI_Get (&p->sequences[last & p->mask]) - last);
+        
+        if ((diff == 0) && pl_AtomicI_CompareAndSwap (&p->tail, (PlankI)tail, (PlankI)(tail + n)))
+            break;
+        
+        tail = (PlankUI)pl_AtomicI_Get (&p->tail);
+    }
+    
+    src = (const PlankUC*)items;
+    
+    for (i = 0; i < n; ++i)
+    {
+        pl_MemoryCopy (p->items + ((tail + i) & p->mask) * p->itemSize, src, p->itemSize);
+        pl_AtomicI_Set (&p->sequences[(tail + i) & p->mask], (PlankI)(tail + i + 1));
+        src += p->itemSize;
+    }
+    
+    return (PlankL)n;
+}
+
+PlankB pl_RingBufferMPSC_Pop (PlankRingBufferMPSCRef p, PlankP item)
+{
+    const PlankUI head = (PlankUI)pl_AtomicI_GetUnchecked (&p->head);
+    PlankAtomicIRef sequence = &p->sequences[head & p->mask];
+    
+    if ((PlankUI)pl_AtomicI_Get (sequence) != (head + 1))
+        return PLANK_FALSE;
+    
+    pl_AtomicMemoryBarrier(); // don't read the item before the sequence that published it
+    pl_MemoryCopy (item, p->items + (head & p->mask) * p->itemSize, p->itemSize);
+    pl_AtomicI_Set (sequence, (PlankI)(head + p->mask + 1));
+    pl_AtomicI_Set (&p->head, (PlankI)(head + 1));
+    
+    return PLANK_TRUE;
+}
+
+PlankL pl_RingBufferMPSC_PopItems (PlankRingBufferMPSCRef p, PlankP items, const PlankL count)
+{
+    const PlankUI head = (PlankUI)pl_AtomicI_GetUnchecked (&p->head);
+    PlankAtomicIRef sequence;
+    PlankUC* dst;
+    PlankUI n;
+    
+    dst = (PlankUC*)items;
+    
+    for (n = 0; n < (PlankUI)pl_MaxL (count, 0); ++n)
+    {
+        sequence = &p->sequences[(head + n) & p->mask];
+        
+        if ((PlankUI)pl_AtomicI_Get (sequence) != (head + n + 1))
+            break;
+        
+        pl_AtomicMemoryBarrier();
+        pl_MemoryCopy (dst, p->items + ((head + n) & p->mask) * p->itemSize, p->itemSize);
+        pl_AtomicI_Set (sequence, (PlankI)(head + n + p->mask + 1));
+        dst += p->itemSize;
+    }
+    
+    if (n > 0)
+        pl_AtomicI_Set (&p->head, (PlankI)(head + n));
+    
+    return (PlankL)n;
+}
+
+PlankL pl_RingBufferMPSC_GetSize (PlankRingBufferMPSCRef p)
+{
+    const PlankUI head = (PlankUI)pl_AtomicI_Get (&p->head);
+    const PlankUI tail = (PlankUI)pl_AtomicI_Get (&p->tail);
+    return (PlankL)(tail - head);
+}
+
+PlankL pl_RingBufferMPSC_GetCapacity (PlankRingBufferMPSCRef p)
+{
+    return (PlankL)p->mask + 1;
+}
+
+PlankL pl_RingBufferMPSC_GetItemSize (PlankRingBufferMPSCRef p)
+{
+    return p->itemSize;
+}
@@ -0,0 +1,139 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLANK_RINGBUFFERMPSC_H
+#define PLANK_RINGBUFFERMPSC_H
+
+#include "plank_RingBufferSPSC.h"
+
+PLANK_BEGIN_C_LINKAGE
+
+/** A bounded multiple-producer, single-consumer ring buffer (FIFO).
+ 
+ Like the RingBufferSPSC items are copied into and out of a preallocated 
+ power of 2 sized array so pushing and popping never allocates. Any number of 
+ threads may push concurrently but only one thread may pop at any one time. 
+ Producers claim slots with a single compare-and-swap on the tail index and 
+ each slot has a sequence number to publish it to the consumer. The consumer 
+ never waits: if the producer that claimed the next slot is still copying its 
+ item the buffer appears empty until that push completes.
+ 
+ @defgroup PlankRingBufferMPSCClass Plank RingBufferMPSC class
+ @ingroup PlankClasses
+ @{
+ */
+
+/** An opaque reference to the <i>Plank RingBufferMPSC</i> object. */
+typedef struct PlankRingBufferMPSC* PlankRingBufferMPSCRef; 
+
+/** Creates and intialises a <i>Plank RingBufferMPSC</i> object and return an oqaque reference to it.
+ This holds up to PLANKRINGBUFFER_DEFAULTCAPACITY pointer-sized items.
+ @return A <i>Plank RingBufferMPSC</i> object as an opaque reference or PLANK_NULL. */
+PlankRingBufferMPSCRef pl_RingBufferMPSC_CreateAndInit();
+
+/** Create a <i>Plank RingBufferMPSC</i> object and return an oqaque reference to it.
+ @return A <i>Plank RingBufferMPSC</i> object as an opaque reference or PLANK_NULL. */
+PlankRingBufferMPSCRef pl_RingBufferMPSC_Create();
+
+/** Initialise the ring buffer to hold up to PLANKRINGBUFFER_DEFAULTCAPACITY pointer-sized items.
+ @param p The <i>Plank RingBufferMPSC</i> object.
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_RingBufferMPSC_Init (PlankRingBufferMPSCRef p);
+
+/** Initialise the ring buffer.
+ @param p The <i>Plank RingBufferMPSC</i> object.
+ @param itemSize The size of each item in bytes.
+ @param capacity The minimum number of items the buffer can hold, this is rounded up to a power of 2.
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_RingBufferMPSC_InitWithItemSizeAndCapacity (PlankRingBufferMPSCRef p, const PlankL itemSize, const PlankL capacity);
+
+/** Deinitialise the ring buffer. 
+ Any items remaining in the buffer are discarded. */
+PlankResult pl_RingBufferMPSC_DeInit (PlankRingBufferMPSCRef p);
+
+/** Destroy a <i>Plank RingBufferMPSC</i> object. */
+PlankResult pl_RingBufferMPSC_Destroy (PlankRingBufferMPSCRef p);
+
+/** Discards all the items in the buffer. This must only be called from the consumer thread. */
+PlankResult pl_RingBufferMPSC_Clear (PlankRingBufferMPSCRef p);
+
+/** Copy an item into the buffer. This may be called from any thread.
+ @return PLANK_TRUE if the item was pushed or PLANK_FALSE if the buffer was full. */
+PlankB pl_RingBufferMPSC_Push (PlankRingBufferMPSCRef p, PlankConstantP item);
+
+/** Copy up to @e count items into the buffer. This may be called from any thread.
+ The items are claimed together so they are contiguous in the buffer even with 
+ other producers pushing at the same time.
+ @return The number of items pushed, which is less than @e count if the buffer became full. */
+PlankL pl_RingBufferMPSC_PushItems (PlankRingBufferMPSCRef p, PlankConstantP items, const PlankL count);
+
+/** Copy an item out of the buffer. This must only be called from the consumer thread.
+ @return PLANK_TRUE if an item was popped or PLANK_FALSE if the buffer was empty. */
+PlankB pl_RingBufferMPSC_Pop (PlankRingBufferMPSCRef p, PlankP item);
+
+/** Copy up to @e count items out of the buffer. This must only be called from the consumer thread.
+ @return The number of items popped, which is less than @e count if the buffer became empty. */
+PlankL pl_RingBufferMPSC_PopItems (PlankRingBufferMPSCRef p, PlankP items, const PlankL count);
+
+/** NB the result of this could be invalid by the time it is returned in a multithreaded context. 
+ This includes items that producers have claimed but not yet finished copying. */
+PlankL pl_RingBufferMPSC_GetSize (PlankRingBufferMPSCRef p);
+
+/** Get the maximum number of items the buffer can hold. */
+PlankL pl_RingBufferMPSC_GetCapacity (PlankRingBufferMPSCRef p);
+
+/** Get the size of a single item stored in the buffer. */
+PlankL pl_RingBufferMPSC_GetItemSize (PlankRingBufferMPSCRef p);
+
+/** @} */
+
+PLANK_END_C_LINKAGE
+
+#if !DOXYGEN
+typedef struct PlankRingBufferMPSC
+{
+    PLANK_ALIGN(PLANK_CACHELINESIZE) PlankAtomicI   head;       // written by the consumer
+    PLANK_ALIGN(PLANK_CACHELINESIZE) PlankAtomicI   tail;       // claimed by the producers
+    PLANK_ALIGN(PLANK_CACHELINESIZE) PlankAtomicI*  sequences;  // the position each slot is ready for
+    PlankUC*                                        items;
+    PlankUI                                         mask;
+    PlankL                                          itemSize;
+} PlankRingBufferMPSC PLANK_ALIGN(PLANK_CACHELINESIZE);
+#endif
+
+#endif // PLANK_RINGBUFFERMPSC_H
@@ -0,0 +1,305 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#include "../core/plank_StandardHeader.h"
+#include "plank_RingBufferSPSC.h"
+#include "../maths/plank_Maths.h"
+
+#define PLANKRINGBUFFER_MAXIMUMCAPACITY 0x40000000
+
+static void pl_RingBufferSPSC_CopyIn (PlankRingBufferSPSCRef p, const PlankUI index, PlankConstantP items, const PlankUI count)
+{
+    const PlankUI start = index & p->mask;
+    const PlankUI first = pl_MinUI (count, p->mask + 1 - start);
+    
+    pl_MemoryCopy (p->items + start * p->itemSize, items, first * p->itemSize);
+    
+    if (count > first)
+        pl_MemoryCopy (p->items, (const PlankUC*)items + first * p->itemSize, (count - first) * p->itemSize);
+}
+
+static void pl_RingBufferSPSC_CopyOut (PlankRingBufferSPSCRef p, const PlankUI index, PlankP items, const PlankUI count)
+{
+    const PlankUI start = index & p->mask;
+    const PlankUI first = pl_MinUI (count, p->mask + 1 - start);
+    
+    pl_MemoryCopy (items, p->items + start * p->itemSize, first * p->itemSize);
+    
+    if (count > first)
+        pl_MemoryCopy ((PlankUC*)items + first * p->itemSize, p->items, (count - first) * p->itemSize);
+}
+
+PlankRingBufferSPSCRef pl_RingBufferSPSC_CreateAndInit()
+{
+    PlankRingBufferSPSCRef p;
+    p = pl_RingBufferSPSC_Create();
+    
+    if (p != PLANK_NULL)
+    {
+        if (pl_RingBufferSPSC_Init (p) != PlankResult_OK)
+            pl_RingBufferSPSC_Destroy (p);
+        else
+            return p;
+    }
+    
+    return PLANK_NULL;
+}
+
+PlankRingBufferSPSCRef pl_RingBufferSPSC_Create()
+{
+    PlankMemoryRef m;
+    PlankRingBufferSPSCRef p;
+    
+    m = pl_MemoryGlobal();
+    p = (PlankRingBufferSPSCRef)pl_Memory_AllocateBytes (m, sizeof (PlankRingBufferSPSC));
+    
+    if (p != PLANK_NULL)
+        pl_MemoryZero (p, sizeof (PlankRingBufferSPSC));
+    
+    return p;
+}
+
+PlankResult pl_RingBufferSPSC_Init (PlankRingBufferSPSCRef p)
+{
+    return pl_RingBufferSPSC_InitWithItemSizeAndCapacity (p, sizeof (PlankP), PLANKRINGBUFFER_DEFAULTCAPACITY);
+}
+
+PlankResult pl_RingBufferSPSC_InitWithItemSizeAndCapacity (PlankRingBufferSPSCRef p, const PlankL itemSize, const PlankL capacity)
+{
+    PlankResult result = PlankResult_OK;
+    PlankMemoryRef m;
+    PlankUI roundedCapacity;
+    
+    if (p == PLANK_NULL)
+    {
+        result = PlankResult_MemoryError;
+        goto exit;
+    }
+    
+    if ((itemSize <= 0) || (capacity <= 0) || (capacity > PLANKRINGBUFFER_MAXIMUMCAPACITY))
+    {
+        result = PlankResult_ItemCountInvalid;
+        goto exit;
+    }
+    
+    pl_MemoryZero (p, sizeof (PlankRingBufferSPSC));
+    
+    roundedCapacity = 1;
+    
+    while (roundedCapacity < (PlankUI)capacity)
+        roundedCapacity <<= 1;
+    
+    m = pl_MemoryGlobal();
+    p->items = (PlankUC*)pl_Memory_AllocateBytes (m, roundedCapacity * itemSize);
+    
+    if (p->items == PLANK_NULL)
+    {
+        result = PlankResult_MemoryError;
+        goto exit;
+    }
+    
+    p->mask = roundedCapacity - 1;
+    p->itemSize = itemSize;
+    
+    pl_AtomicI_Init (&p->head);
+    pl_AtomicI_Init (&p->tail);
+    
+exit:
+    return result;
+}
+
+PlankResult pl_RingBufferSPSC_DeInit (PlankRingBufferSPSCRef p)
+{
+    PlankResult result = PlankResult_OK;
+    PlankMemoryRef m;
+    
+    if (p == PLANK_NULL)
+    {
+        result = PlankResult_MemoryError;
+        goto exit;
+    }
+    
+    m = pl_MemoryGlobal();
+    
+    if (p->items != PLANK_NULL)
+    {
+        if ((result = pl_Memory_Free (m, p->items)) != PlankResult_OK)
+            goto exit;
+    }
+    
+    pl_AtomicI_DeInit (&p->head);
+    pl_AtomicI_DeInit (&p->tail);
+    pl_MemoryZero (p, sizeof (PlankRingBufferSPSC));
+    
+exit:
+    return result;
+}
+
+PlankResult pl_RingBufferSPSC_Destroy (PlankRingBufferSPSCRef p)
+{
+    PlankResult result = PlankResult_OK;
+    PlankMemoryRef m = pl_MemoryGlobal();
+    
+    if (p == PLANK_NULL)
+    {
+        result = PlankResult_MemoryError;
+        goto exit;
+    }
+    
+    if ((result = pl_RingBufferSPSC_DeInit (p)) != PlankResult_OK)
+        goto exit;
+    
+    result = pl_Memory_Free (m, p);
+    
+exit:
+    return result;
+}
+
+PlankResult pl_RingBufferSPSC_Clear (PlankRingBufferSPSCRef p)
+{
+    p->tailCache = (PlankUI)pl_AtomicI_Get (&p->tail);
+    pl_AtomicI_Set (&p->head, (PlankI)p->tailCache);
+    return PlankResult_OK;
+}
+
+PlankB pl_RingBufferSPSC_Push (PlankRingBufferSPSCRef p, PlankConstantP item)
+{
+    const PlankUI tail = (PlankUI)pl_AtomicI_GetUnchecked (&p->tail);
+    
+    if ((tail - p->headCache) > p->mask)
+    {
+        p->headCache = (PlankUI)pl_AtomicI_GetAcquire (&p->head);
+        
+        if ((tail - p->headCache) > p->mask)
+            return PLANK_FALSE;
+    }
+    
+    pl_MemoryCopy (p->items + (tail & p->mask) * p->itemSize, item, p->itemSize);
+    pl_AtomicI_SetRelease (&p->tail, (PlankI)(tail + 1)); // publishes the item to the consumer
+    
+    return PLANK_TRUE;
+}
+
+PlankL pl_RingBufferSPSC_PushItems (PlankRingBufferSPSCRef p, PlankConstantP items, const PlankL count)
+{
+    const PlankUI tail = (PlankUI)pl_AtomicI_GetUnchecked (&p->tail);
+    PlankUI space, n;
+    
+    if (count <= 0)
+        return 0;
+    
+    space = p->mask + 1 - (tail - p->headCache);
+    
+    if (space < (PlankUI)count)
+    {
+        p->headCache = (PlankUI)pl_AtomicI_GetAcquire (&p->head);
+        space = p->mask + 1 - (tail - p->headCache);
+    }
+    
+    n = pl_MinUI (space, (PlankUI)count);
+    
+    if (n == 0)
+        return 0;
+    
+    pl_RingBufferSPSC_CopyIn (p, tail, items, n);
+    pl_AtomicI_SetRelease (&p->tail, (PlankI)(tail + n));
+    
+    return (PlankL)n;
+}
+
+PlankB pl_RingBufferSPSC_Pop (PlankRingBufferSPSCRef p, PlankP item)
+{
+    const PlankUI head = (PlankUI)pl_AtomicI_GetUnchecked (&p->head);
+    
+    if (head == p->tailCache)
+    {
+        p->tailCache = (PlankUI)pl_AtomicI_GetAcquire (&p->tail);
+        
+        if (head == p->tailCache)
+            return PLANK_FALSE;
+    }
+    
+    pl_MemoryCopy (item, p->items + (head & p->mask) * p->itemSize, p->itemSize);
+    pl_AtomicI_SetRelease (&p->head, (PlankI)(head + 1)); // hands the slot back to the producer
+    
+    return PLANK_TRUE;
+}
+
+PlankL pl_RingBufferSPSC_PopItems (PlankRingBufferSPSCRef p, PlankP items, const PlankL count)
+{
+    const PlankUI head = (PlankUI)pl_AtomicI_GetUnchecked (&p->head);
+    PlankUI available, n;
+    
+    if (count <= 0)
+        return 0;
+    
+    available = p->tailCache - head;
+    
+    if (available < (PlankUI)count)
+    {
+        p->tailCache = (PlankUI)pl_AtomicI_GetAcquire (&p->tail);
+        available = p->tailCache - head;
+    }
+    
+    n = pl_MinUI (available, (PlankUI)count);
+    
+    if (n == 0)
+        return 0;
+    
+    pl_RingBufferSPSC_CopyOut (p, head, items, n);
+    pl_AtomicI_SetRelease (&p->head, (PlankI)(head + n));
+    
+    return (PlankL)n;
+}
+
+PlankL pl_RingBufferSPSC_GetSize (PlankRingBufferSPSCRef p)
+{
+    const PlankUI head = (PlankUI)pl_AtomicI_Get (&p->head);
+    const PlankUI tail = (PlankUI)pl_AtomicI_Get (&p->tail);
+    return (PlankL)(tail - head);
+}
+
+PlankL pl_RingBufferSPSC_GetCapacity (PlankRingBufferSPSCRef p)
+{
+    return (PlankL)p->mask + 1;
+}
+
+PlankL pl_RingBufferSPSC_GetItemSize (PlankRingBufferSPSCRef p)
+{
+    return p->itemSize;
+}
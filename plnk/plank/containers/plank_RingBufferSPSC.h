@@ -0,0 +1,140 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLANK_RINGBUFFERSPSC_H
+#define PLANK_RINGBUFFERSPSC_H
+
+#include "atomic/plank_Atomic.h"
+
+#define PLANKRINGBUFFER_DEFAULTCAPACITY 64
+
+PLANK_BEGIN_C_LINKAGE
+
+/** A bounded wait-free single-producer, single-consumer ring buffer (FIFO).
+ 
+ Items are copied into and out of a contiguous array of fixed size items 
+ (rounded up to a power of 2 capacity) so, unlike the LockFreeQueue, pushing 
+ and popping never allocates. Exactly one thread may push and exactly one 
+ (possibly different) thread may pop at any one time. The producer and consumer 
+ indices are each on their own cache line and each side keeps a cached copy of 
+ the other side's index so the shared indices are only read when the buffer 
+ appears to be full or empty.
+ 
+ @defgroup PlankRingBufferSPSCClass Plank RingBufferSPSC class
+ @ingroup PlankClasses
+ @{
+ */
+
+/** An opaque reference to the <i>Plank RingBufferSPSC</i> object. */
+typedef struct PlankRingBufferSPSC* PlankRingBufferSPSCRef; 
+
+/** Creates and intialises a <i>Plank RingBufferSPSC</i> object and return an oqaque reference to it.
+ This holds up to PLANKRINGBUFFER_DEFAULTCAPACITY pointer-sized items.
+ @return A <i>Plank RingBufferSPSC</i> object as an opaque reference or PLANK_NULL. */
+PlankRingBufferSPSCRef pl_RingBufferSPSC_CreateAndInit();
+
+/** Create a <i>Plank RingBufferSPSC</i> object and return an oqaque reference to it.
+ @return A <i>Plank RingBufferSPSC</i> object as an opaque reference or PLANK_NULL. */
+PlankRingBufferSPSCRef pl_RingBufferSPSC_Create();
+
+/** Initialise the ring buffer to hold up to PLANKRINGBUFFER_DEFAULTCAPACITY pointer-sized items.
+ @param p The <i>Plank RingBufferSPSC</i> object.
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_RingBufferSPSC_Init (PlankRingBufferSPSCRef p);
+
+/** Initialise the ring buffer.
+ @param p The <i>Plank RingBufferSPSC</i> object.
+ @param itemSize The size of each item in bytes.
+ @param capacity The minimum number of items the buffer can hold, this is rounded up to a power of 2.
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_RingBufferSPSC_InitWithItemSizeAndCapacity (PlankRingBufferSPSCRef p, const PlankL itemSize, const PlankL capacity);
+
+/** Deinitialise the ring buffer. 
+ Any items remaining in the buffer are discarded. */
+PlankResult pl_RingBufferSPSC_DeInit (PlankRingBufferSPSCRef p);
+
+/** Destroy a <i>Plank RingBufferSPSC</i> object. */
+PlankResult pl_RingBufferSPSC_Destroy (PlankRingBufferSPSCRef p);
+
+/** Discards all the items in the buffer. This must only be called from the consumer thread. */
+PlankResult pl_RingBufferSPSC_Clear (PlankRingBufferSPSCRef p);
+
+/** Copy an item into the buffer. This must only be called from the producer thread.
+ @return PLANK_TRUE if the item was pushed or PLANK_FALSE if the buffer was full. */
+PlankB pl_RingBufferSPSC_Push (PlankRingBufferSPSCRef p, PlankConstantP item);
+
+/** Copy up to @e count items into the buffer. This must only be called from the producer thread.
+ The items are made available to the consumer together.
+ @return The number of items pushed, which is less than @e count if the buffer became full. */
+PlankL pl_RingBufferSPSC_PushItems (PlankRingBufferSPSCRef p, PlankConstantP items, const PlankL count);
+
+/** Copy an item out of the buffer. This must only be called from the consumer thread.
+ @return PLANK_TRUE if an item was popped or PLANK_FALSE if the buffer was empty. */
+PlankB pl_RingBufferSPSC_Pop (PlankRingBufferSPSCRef p, PlankP item);
+
+/** Copy up to @e count items out of the buffer. This must only be called from the consumer thread.
+ @return The number of items popped, which is less than @e count if the buffer became empty. */
+PlankL pl_RingBufferSPSC_PopItems (PlankRingBufferSPSCRef p, PlankP items, const PlankL count);
+
+/** NB the result of this could be invalid by the time it is returned in a multithreaded context. */
+PlankL pl_RingBufferSPSC_GetSize (PlankRingBufferSPSCRef p);
+
+/** Get the maximum number of items the buffer can hold. */
+PlankL pl_RingBufferSPSC_GetCapacity (PlankRingBufferSPSCRef p);
+
+/** Get the size of a single item stored in the buffer. */
+PlankL pl_RingBufferSPSC_GetItemSize (PlankRingBufferSPSCRef p);
+
+/** @} */
+
+PLANK_END_C_LINKAGE
+
+#if !DOXYGEN
+typedef struct PlankRingBufferSPSC
+{
+    PLANK_ALIGN(PLANK_CACHELINESIZE) PlankAtomicI   head;       // written by the consumer
+    PlankUI                                         tailCache;  // the consumer's last view of the tail
+    PLANK_ALIGN(PLANK_CACHELINESIZE) PlankAtomicI   tail;       // written by the producer
+    PlankUI                                         headCache;  // the producer's last view of the head
+    PLANK_ALIGN(PLANK_CACHELINESIZE) PlankUC*       items;
+    PlankUI                                         mask;
+    PlankL                                          itemSize;
+} PlankRingBufferSPSC PLANK_ALIGN(PLANK_CACHELINESIZE);
+#endif
+
+#endif // PLANK_RINGBUFFERSPSC_H
@@ -175,7 +175,16 @@ void pl_Lock_WaitTimeout (PlankLockRef p, double time)
     pthread_mutex_lock (&p->mutex);
     
     pl_TimeToTimeSpec (&timeout, pl_TimeNow() + time);
-    pthread_cond_timedwait (&p->condition, &p->mutex, &timeout);
+    
+    if (!p->flag)
+    {
+        do
+        {
+            if (pthread_cond_timedwait (&p->condition, &p->mutex, &timeout) != 0)
+                break;
+        } while (!p->flag);
+    }
+    
     p->flag = PLANK_FALSE;
 
     pthread_mutex_unlock (&p->mutex);
@@ -273,7 +282,16 @@ void pl_Lock_WaitTimeout (PlankLockRef p, double time)
     pthread_mutex_lock (&p->mutex);
     
     pl_TimeToTimeSpec (&timeout, pl_TimeNow() + time);
-    pthread_cond_timedwait (&p->condition, &p->mutex, &timeout);
+    
+    if (!p->flag)
+    {
+        do
+        {
+            if (pthread_cond_timedwait (&p->condition, &p->mutex, &timeout) != 0)
+                break;
+        } while (!p->flag);
+    }
+    
     p->flag = PLANK_FALSE;
     
     pthread_mutex_unlock (&p->mutex);
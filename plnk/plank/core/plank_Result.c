@@ -63,6 +63,7 @@ const char* pl_ResultString (PlankResult result)
         "File seek failed",                     //PlankResult_FileSeekFailed,
         "File remove failed",                   //PlankResult_FileRemoveFailed
         "Failed to make a directory",           //PlankResult_FileMakeDirectoryFailed
+        "File not held in memory",              //PlankResult_FileNotMapped
         
         "The specified chunk ID was not found",                                         //PlankResult_IffFileReaderChunkNotFound
         
@@ -63,6 +63,7 @@ enum PlankResultIdentifiers
     PlankResult_FileSeekFailed,             ///< The file failed to seek.
     PlankResult_FileRemoveFailed,           ///< A request to remove a file from the filesystem failed.
     PlankResult_FileMakeDirectoryFailed,    ///< Failed to make a directory.
+    PlankResult_FileNotMapped,              ///< Direct access was requested from a file that is not held in (or mapped to) memory.
     
     PlankResult_IffFileReaderChunkNotFound,                   ///< The specified chunk ID was not found.
     
@@ -56,6 +56,9 @@
  PLANK_FFT_VDSP=1           -   use vDSP on Mac OS X for FFT routines
  PLANK_FFT_VDSP_FLIPIMAG=1  -   flip the imag part of the FFT to match FFTReal data closely
  PLANK_VEC_VDSP 1           -   use vDSP on Mac OS X for vector ops
+ PLANK_VEC_SSE=1            -   use SSE2 for vector ops (the default on x86 other than Mac OS X)
+ PLANK_VEC_AVX=1            -   also build AVX vector ops, selected at runtime if the CPU supports them
+ PLANK_VEC_NOSIMD=1         -   use the scalar vector ops even where SSE2 is available
 */
 
 #ifndef PLANK_API
@@ -275,7 +278,7 @@
         #endif
 
         // probably avoid needing to know the CPU for linux...
-        #if defined(__i386__)
+        #if defined(__i386__) || defined(__x86_64__)
             #define PLANK_X86 1
         #elif defined(__arm__)
             #define PLANK_ARM 1
@@ -309,6 +312,10 @@
     #define PLANK_WIDESIZE 16
 #endif
 
+#ifndef PLANK_CACHELINESIZE
+    #define PLANK_CACHELINESIZE 64
+#endif
+
 typedef float PlankF;
 typedef double PlankD;
 
@@ -421,6 +428,13 @@ static PLANK_INLINE_LOW double pl_TimeNow()
     struct timeval now;
     gettimeofday (&now, 0);
     return (double)now.tv_sec + now.tv_usec * 0.000001;
+#elif PLANK_WIN
+    FILETIME now;
+    ULARGE_INTEGER ticks;
+    GetSystemTimeAsFileTime (&now);
+    ticks.LowPart = now.dwLowDateTime;
+    ticks.HighPart = now.dwHighDateTime;
+    return (double)ticks.QuadPart * 0.0000001;
 #else
     return 0.0;
 #endif
@@ -430,7 +444,7 @@ static PLANK_INLINE_LOW double pl_TimeNow()
 static PLANK_INLINE_LOW void pl_TimeToTimeSpec (struct timespec* time, double seconds)
 {
     time->tv_sec = (long)seconds;
-    time->tv_nsec = (long)((seconds - time->tv_sec) * 0.000000001);
+    time->tv_nsec = (long)((seconds - time->tv_sec) * 1000000000.0);
 }
 #endif
 
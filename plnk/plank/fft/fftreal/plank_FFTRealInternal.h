@@ -46,6 +46,11 @@ void pl_FFTRealF_Destroy (void* peer);
 void pl_FFTRealF_Forward (void* peer, float* output, const float* input);
 void pl_FFTRealF_Inverse (void* peer, float* output, const float* input);
 
+void* pl_FFTRealD_CreateAndInitWithLength (const long length);
+void pl_FFTRealD_Destroy (void* peer);
+void pl_FFTRealD_Forward (void* peer, double* output, const double* input);
+void pl_FFTRealD_Inverse (void* peer, double* output, const double* input);
+
 PLANK_END_C_LINKAGE
 
 #endif // PLANK_FFTREALINTERNAL_H
@@ -0,0 +1,613 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+/*
+ A mixed-radix (2, 3, 4 and 5) real FFT for sizes FFTReal can't handle, e.g., 
+ 480 and 960 for 48kHz block sizes. 
+ 
+ A real FFT of size N is computed using a complex FFT of size N/2 on the even
+ and odd samples packed as real and imaginary parts, followed by a pass to 
+ separate the two spectra. The complex FFT is a Stockham autosort algorithm so
+ it needs no bit-reversal pass. Data is held as separate real and imaginary 
+ arrays so the inner loop of each pass runs over contiguous data and is 
+ vectorised with SSE where the stride allows (i.e., all but the first pass).
+ 
+ The twiddle factors are held in plans which are shared between all the engines
+ of the same size and precision. The output format and scaling match FFTReal.
+ */
+
+#include "../../core/plank_StandardHeader.h"
+#include "../../core/plank_SpinLock.h"
+#include "../../maths/vectors/plank_Vectors.h"
+#include "plank_FFTMixedRadixInternal.h"
+#include <math.h>
+
+namespace plank_mixedradix
+{
+    enum Constants
+    {
+        MaxStages = 32
+    };
+    
+    static int factorise (long halfLength, int* radices)
+    {
+        int numStages = 0;
+        
+        if (halfLength < 1)
+            return -1;
+        
+        // radix 4 first so that all the strides after the first pass are a multiple of the SIMD width
+        while ((halfLength % 4) == 0) { radices[numStages++] = 4; halfLength /= 4; }
+        while ((halfLength % 2) == 0) { radices[numStages++] = 2; halfLength /= 2; }
+        while ((halfLength % 3) == 0) { radices[numStages++] = 3; halfLength /= 3; }
+        while ((halfLength % 5) == 0) { radices[numStages++] = 5; halfLength /= 5; }
+        
+        return (halfLength == 1) ? numStages : -1;
+    }
+    
+    //--------------------------------------------------------------------------
+    
+    template<class T>
+    struct ScalarOps
+    {
+        typedef T V;
+        enum { Width = 1 };
+        static PLANK_INLINE_LOW V load (const T* p)         { return *p; }
+        static PLANK_INLINE_LOW void store (T* p, V a)      { *p = a; }
+        static PLANK_INLINE_LOW V set1 (const T a)          { return a; }
+        static PLANK_INLINE_LOW V add (V a, V b)            { return a + b; }
+        static PLANK_INLINE_LOW V sub (V a, V b)            { return a - b; }
+        static PLANK_INLINE_LOW V mul (V a, V b)            { return a * b; }
+    };
+    
+#if defined(PLANK_VEC_SSE) && PLANK_VEC_SSE
+    struct SSEOpsF
+    {
+        typedef __m128 V;
+        enum { Width = 4 };
+        static PLANK_INLINE_LOW V load (const float* p)     { return _mm_loadu_ps (p); }
+        static PLANK_INLINE_LOW void store (float* p, V a)  { _mm_storeu_ps (p, a); }
+        static PLANK_INLINE_LOW V set1 (const float a)      { return _mm_set1_ps (a); }
+        static PLANK_INLINE_LOW V add (V a, V b)            { return _mm_add_ps (a, b); }
+        static PLANK_INLINE_LOW V sub (V a, V b)            { return _mm_sub_ps (a, b); }
+        static PLANK_INLINE_LOW V mul (V a, V b)            { return _mm_mul_ps (a, b); }
+    };
+    
+    struct SSEOpsD
+    {
+        typedef __m128d V;
+        enum { Width = 2 };
+        static PLANK_INLINE_LOW V load (const double* p)    { return _mm_loadu_pd (p); }
+        static PLANK_INLINE_LOW void store (double* p, V a) { _mm_storeu_pd (p, a); }
+        static PLANK_INLINE_LOW V set1 (const double a)     { return _mm_set1_pd (a); }
+        static PLANK_INLINE_LOW V add (V a, V b)            { return _mm_add_pd (a, b); }
+        static PLANK_INLINE_LOW V sub (V a, V b)            { return _mm_sub_pd (a, b); }
+        static PLANK_INLINE_LOW V mul (V a, V b)            { return _mm_mul_pd (a, b); }
+    };
+    
+    template<class T> struct VectorOps             { typedef ScalarOps<T> Type; };
+    template<>        struct VectorOps<float>      { typedef SSEOpsF Type; };
+    template<>        struct VectorOps<double>     { typedef SSEOpsD Type; };
+#else
+    template<class T> struct VectorOps             { typedef ScalarOps<T> Type; };
+#endif
+    
+    //--------------------------------------------------------------------------
+    
+    /* One Stockham pass: for each p < m and q < s the radix-point DFT of 
+       x[q + s * (p + k * m)] is multiplied by the twiddles w^(p * j) and stored 
+       to y[q + s * (radix * p + j)]. */
+    template<class T, class Ops>
+    struct Pass
+    {
+        typedef typename Ops::V V;
+        
+        static PLANK_INLINE_LOW void twiddle (V& re, V& im, const T wr, const T wi)
+        {
+            const V vwr = Ops::set1 (wr);
+            const V vwi = Ops::set1 (wi);
+            const V tr = Ops::sub (Ops::mul (re, vwr), Ops::mul (im, vwi));
+            im = Ops::add (Ops::mul (re, vwi), Ops::mul (im, vwr));
+            re = tr;
+        }
+        
+        static void radix2 (const T* xr, const T* xi, T* yr, T* yi, const long s, const long m, const T* twr, const T* twi)
+        {
+            long p, q;
+            
+            for (p = 0; p < m; ++p)
+            {
+                const T w1r = twr[p], w1i = twi[p];
+                const long i0 = s * p, i1 = s * (p + m);
+                const long o0 = s * (2 * p), o1 = o0 + s;
+                
+                for (q = 0; q < s; q += Ops::Width)
+                {
+                    const V a0r = Ops::load (xr + i0 + q), a0i = Ops::load (xi + i0 + q);
+                    const V a1r = Ops::load (xr + i1 + q), a1i = Ops::load (xi + i1 + q);
+                    
+                    V b1r = Ops::sub (a0r, a1r), b1i = Ops::sub (a0i, a1i);
+                    twiddle (b1r, b1i, w1r, w1i);
+                    
+                    Ops::store (yr + o0 + q, Ops::add (a0r, a1r)); Ops::store (yi + o0 + q, Ops::add (a0i, a1i));
+                    Ops::store (yr + o1 + q, b1r);                 Ops::store (yi + o1 + q, b1i);
+                }
+            }
+        }
+        
+        static void radix3 (const T* xr, const T* xi, T* yr, T* yi, const long s, const long m, const T* twr, const T* twi)
+        {
+            const V half = Ops::set1 (T (0.5));
+            const V sin60 = Ops::set1 (T (0.86602540378443864676));
+            long p, q;
+            
+            for (p = 0; p < m; ++p)
+            {
+                const T w1r = twr[p], w1i = twi[p];
+                const T w2r = twr[m + p], w2i = twi[m + p];
+                const long i0 = s * p, i1 = s * (p + m), i2 = s * (p + 2 * m);
+                const long o0 = s * (3 * p), o1 = o0 + s, o2 = o1 + s;
+                
+                for (q = 0; q < s; q += Ops::Width)
+                {
+                    const V a0r = Ops::load (xr + i0 + q), a0i = Ops::load (xi + i0 + q);
+                    const V a1r = Ops::load (xr + i1 + q), a1i = Ops::load (xi + i1 + q);
+                    const V a2r = Ops::load (xr + i2 + q), a2i = Ops::load (xi + i2 + q);
+                    
+                    const V t1r = Ops::add (a1r, a2r), t1i = Ops::add (a1i, a2i);
+                    const V t2r = Ops::sub (a0r, Ops::mul (half, t1r)), t2i = Ops::sub (a0i, Ops::mul (half, t1i));
+                    const V t3r = Ops::mul (sin60, Ops::sub (a1i, a2i));            // -i * sin60 * (a1 - a2)
+                    const V t3i = Ops::mul (sin60, Ops::sub (a2r, a1r));
+                    
+                    V b1r = Ops::add (t2r, t3r), b1i = Ops::add (t2i, t3i);
+                    V b2r = Ops::sub (t2r, t3r), b2i = Ops::sub (t2i, t3i);
+                    twiddle (b1r, b1i, w1r, w1i);
+                    twiddle (b2r, b2i, w2r, w2i);
+                    
+                    Ops::store (yr + o0 + q, Ops::add (a0r, t1r)); Ops::store (yi + o0 + q, Ops::add (a0i, t1i));
+                    Ops::store (yr + o1 + q, b1r);                 Ops::store (yi + o1 + q, b1i);
+                    Ops::store (yr + o2 + q, b2r);                 Ops::store (yi + o2 + q, b2i);
+                }
+            }
+        }
+        
+        static void radix4 (const T* xr, const T* xi, T* yr, T* yi, const long s, const long m, const T* twr, const T* twi)
+        {
+            long p, q;
+            
+            for (p = 0; p < m; ++p)
+            {
+                const T w1r = twr[p], w1i = twi[p];
+                const T w2r = twr[m + p], w2i = twi[m + p];
+                const T w3r = twr[2 * m + p], w3i = twi[2 * m + p];
+                const long i0 = s * p, i1 = s * (p + m), i2 = s * (p + 2 * m), i3 = s * (p + 3 * m);
+                const long o0 = s * (4 * p), o1 = o0 + s, o2 = o1 + s, o3 = o2 + s;
+                
+                for (q = 0; q < s; q += Ops::Width)
+                {
+                    const V a0r = Ops::load (xr + i0 + q), a0i = Ops::load (xi + i0 + q);
+                    const V a1r = Ops::load (xr + i1 + q), a1i = Ops::load (xi + i1 + q);
+                    const V a2r = Ops::load (xr + i2 + q), a2i = Ops::load (xi + i2 + q);
+                    const V a3r = Ops::load (xr + i3 + q), a3i = Ops::load (xi + i3 + q);
+                    
+                    const V t0r = Ops::add (a0r, a2r), t0i = Ops::add (a0i, a2i);
+                    const V t1r = Ops::sub (a0r, a2r), t1i = Ops::sub (a0i, a2i);
+                    const V t2r = Ops::add (a1r, a3r), t2i = Ops::add (a1i, a3i);
+                    const V t3r = Ops::sub (a1r, a3r), t3i = Ops::sub (a1i, a3i);
+                    
+                    // -i * t3 = (t3i, -t3r)
+                    V b1r = Ops::add (t1r, t3i), b1i = Ops::sub (t1i, t3r);
+                    V b2r = Ops::sub (t0r, t2r), b2i = Ops::sub (t0i, t2i);
+                    V b3r = Ops::sub (t1r, t3i), b3i = Ops::add (t1i, t3r);
+                    twiddle (b1r, b1i, w1r, w1i);
+                    twiddle (b2r, b2i, w2r, w2i);
+                    twiddle (b3r, b3i, w3r, w3i);
+                    
+                    Ops::store (yr + o0 + q, Ops::add (t0r, t2r)); Ops::store (yi + o0 + q, Ops::add (t0i, t2i));
+                    Ops::store (yr + o1 + q, b1r);                 Ops::store (yi + o1 + q, b1i);
+                    Ops::store (yr + o2 + q, b2r);                 Ops::store (yi + o2 + q, b2i);
+                    Ops::store (yr + o3 + q, b3r);                 Ops::store (yi + o3 + q, b3i);
+                }
+            }
+        }
+        
+        static void radix5 (const T* xr, const T* xi, T* yr, T* yi, const long s, const long m, const T* twr, const T* twi)
+        {
+            const V c1 = Ops::set1 (T (0.30901699437494742410));     // cos (2pi/5)
+            const V c2 = Ops::set1 (T (-0.80901699437494742410));    // cos (4pi/5)
+            const V s1 = Ops::set1 (T (0.95105651629515357212));     // sin (2pi/5)
+            const V s2 = Ops::set1 (T (0.58778525229247312917));     // sin (4pi/5)
+            long p, q;
+            
+            for (p = 0; p < m; ++p)
+            {
+                const T w1r = twr[p], w1i = twi[p];
+                const T w2r = twr[m + p], w2i = twi[m + p];
+                const T w3r = twr[2 * m + p], w3i = twi[2 * m + p];
+                const T w4r = twr[3 * m + p], w4i = twi[3 * m + p];
+                const long i0 = s * p, i1 = s * (p + m), i2 = s * (p + 2 * m), i3 = s * (p + 3 * m), i4 = s * (p + 4 * m);
+                const long o0 = s * (5 * p), o1 = o0 + s, o2 = o1 + s, o3 = o2 + s, o4 = o3 + s;
+                
+                for (q = 0; q < s; q += Ops::Width)
+                {
+                    const V a0r = Ops::load (xr + i0 + q), a0i = Ops::load (xi + i0 + q);
+                    const V a1r = Ops::load (xr + i1 + q), a1i = Ops::load (xi + i1 + q);
+                    const V a2r = Ops::load (xr + i2 + q), a2i = Ops::load (xi + i2 + q);
+                    const V a3r = Ops::load (xr + i3 + q), a3i = Ops::load (xi + i3 + q);
+                    const V a4r = Ops::load (xr + i4 + q), a4i = Ops::load (xi + i4 + q);
+                    
+                    const V t1r = Ops::add (a1r, a4r), t1i = Ops::add (a1i, a4i);
+                    const V t2r = Ops::add (a2r, a3r), t2i = Ops::add (a2i, a3i);
+                    const V t3r = Ops::sub (a1r, a4r), t3i = Ops::sub (a1i, a4i);
+                    const V t4r = Ops::sub (a2r, a3r), t4i = Ops::sub (a2i, a3i);
+                    
+                    const V m1r = Ops::add (a0r, Ops::add (Ops::mul (c1, t1r), Ops::mul (c2, t2r)));
+                    const V m1i = Ops::add (a0i, Ops::add (Ops::mul (c1, t1i), Ops::mul (c2, t2i)));
+                    const V m2r = Ops::add (a0r, Ops::add (Ops::mul (c2, t1r), Ops::mul (c1, t2r)));
+                    const V m2i = Ops::add (a0i, Ops::add (Ops::mul (c2, t1i), Ops::mul (c1, t2i)));
+                    const V n1r = Ops::add (Ops::mul (s1, t3r), Ops::mul (s2, t4r));
+                    const V n1i = Ops::add (Ops::mul (s1, t3i), Ops::mul (s2, t4i));
+                    const V n2r = Ops::sub (Ops::mul (s2, t3r), Ops::mul (s1, t4r));
+                    const V n2i = Ops::sub (Ops::mul (s2, t3i), Ops::mul (s1, t4i));
+                    
+                    // b1 = m1 - i n1, b4 = m1 + i n1, b2 = m2 - i n2, b3 = m2 + i n2
+                    V b1r = Ops::add (m1r, n1i), b1i = Ops::sub (m1i, n1r);
+                    V b4r = Ops::sub (m1r, n1i), b4i = Ops::add (m1i, n1r);
+                    V b2r = Ops::add (m2r, n2i), b2i = Ops::sub (m2i, n2r);
+                    V b3r = Ops::sub (m2r, n2i), b3i = Ops::add (m2i, n2r);
+                    twiddle (b1r, b1i, w1r, w1i);
+                    twiddle (b2r, b2i, w2r, w2i);
+                    twiddle (b3r, b3i, w3r, w3i);
+                    twiddle (b4r, b4i, w4r, w4i);
+                    
+                    Ops::store (yr + o0 + q, Ops::add (a0r, Ops::add (t1r, t2r)));
+                    Ops::store (yi + o0 + q, Ops::add (a0i, Ops::add (t1i, t2i)));
+                    Ops::store (yr + o1 + q, b1r); Ops::store (yi + o1 + q, b1i);
+                    Ops::store (yr + o2 + q, b2r); Ops::store (yi + o2 + q, b2i);
+                    Ops::store (yr + o3 + q, b3r); Ops::store (yi + o3 + q, b3i);
+                    Ops::store (yr + o4 + q, b4r); Ops::store (yi + o4 + q, b4i);
+                }
+            }
+        }
+        
+        static void run (const int radix, const T* xr, const T* xi, T* yr, T* yi, const long s, const long m, const T* twr, const T* twi)
+        {
+            switch (radix)
+            {
+                case 2: radix2 (xr, xi, yr, yi, s, m, twr, twi); break;
+                case 3: radix3 (xr, xi, yr, yi, s, m, twr, twi); break;
+                case 4: radix4 (xr, xi, yr, yi, s, m, twr, twi); break;
+                case 5: radix5 (xr, xi, yr, yi, s, m, twr, twi); break;
+                default: break;
+            }
+        }
+    };
+    
+    //--------------------------------------------------------------------------
+
+    /** The twiddle factors for one size, shared by all the engines of that size. */
+    template<class T>
+    class Plan
+    {
+    public:
+        static Plan* acquire (const long length)
+        {
+            Plan* plan;
+            
+            pl_SpinLock_Lock (&lock);
+            
+            for (plan = plans; plan != 0; plan = plan->next)
+            {
+                if (plan->length == length)
+                    break;
+            }
+            
+            if (plan == 0)
+            {
+                plan = new Plan (length);
+                plan->next = plans;
+                plans = plan;
+            }
+            
+            ++plan->refCount;
+            
+            pl_SpinLock_Unlock (&lock);
+            
+            return plan;
+        }
+        
+        static void release (Plan* plan)
+        {
+            Plan** link;
+            
+            pl_SpinLock_Lock (&lock);
+            
+            if (--plan->refCount == 0)
+            {
+                for (link = &plans; *link != plan; link = &(*link)->next) { }
+                *link = plan->next;
+            }
+            else plan = 0;
+            
+            pl_SpinLock_Unlock (&lock);
+            
+            delete plan;
+        }
+        
+        long length;
+        long halfLength;
+        int numStages;
+        int radices[MaxStages];
+        T* stageTwiddles[MaxStages];    // real then imaginary parts for the (radix - 1) * m twiddles of each pass
+        T* realTwiddles;                // cos then sin of 2pi k/length for k < halfLength
+
+    private:
+        Plan (const long lengthToUse)
+        :   length (lengthToUse),
+            halfLength (lengthToUse / 2),
+            numStages (factorise (lengthToUse / 2, radices)),
+            refCount (0),
+            next (0)
+        {
+            const double twoPi = 6.283185307179586476925286766559;
+            long n, m, p;
+            int stage, j;
+            
+            for (n = halfLength, stage = 0; stage < numStages; n /= radices[stage], ++stage)
+            {
+                const int radix = radices[stage];
+                m = n / radix;
+                stageTwiddles[stage] = new T[2 * (radix - 1) * m];
+                
+                for (j = 1; j < radix; ++j)
+                {
+                    for (p = 0; p < m; ++p)
+                    {
+                        const double angle = -twoPi * double (p * j) / double (n);
+                        stageTwiddles[stage][(j - 1) * m + p] = T (cos (angle));
+                        stageTwiddles[stage][(radix - 1) * m + (j - 1) * m + p] = T (sin (angle));
+                    }
+                }
+            }
+            
+            realTwiddles = new T[2 * halfLength];
+            
+            for (p = 0; p < halfLength; ++p)
+            {
+                const double angle = twoPi * double (p) / double (length);
+                realTwiddles[p] = T (cos (angle));
+                realTwiddles[halfLength + p] = T (sin (angle));
+            }
+        }
+        
+        ~Plan()
+        {
+            for (int stage = 0; stage < numStages; ++stage)
+                delete [] stageTwiddles[stage];
+            
+            delete [] realTwiddles;
+        }
+        
+        int refCount;
+        Plan* next;
+        
+        static Plan* plans;
+        static PlankSpinLock lock;
+    };
+    
+    template<class T> Plan<T>* Plan<T>::plans = 0;
+    template<class T> PlankSpinLock Plan<T>::lock;
+    
+    //--------------------------------------------------------------------------
+
+    template<class T>
+    class Engine
+    {
+    public:
+        typedef typename VectorOps<T>::Type VOps;
+        typedef ScalarOps<T>                SOps;
+        
+        Engine (const long length)
+        :   plan (Plan<T>::acquire (length)),
+            buffers (new T[4 * (length / 2)])
+        {
+        }
+        
+        ~Engine()
+        {
+            Plan<T>::release (plan);
+            delete [] buffers;
+        }
+        
+        void forward (T* output, const T* input)
+        {
+            const long M = plan->halfLength;
+            const T* const c = plan->realTwiddles;
+            const T* const s = plan->realTwiddles + M;
+            T* zr = buffers;
+            T* zi = buffers + M;
+            long k;
+            
+            for (k = 0; k < M; ++k)
+            {
+                zr[k] = input[2 * k];
+                zi[k] = input[2 * k + 1];
+            }
+            
+            transform (zr, zi);
+            
+            output[0] = zr[0] + zi[0];
+            output[M] = zr[0] - zi[0];
+            
+            for (k = 1; k < M; ++k)
+            {
+                // separate the spectra of the even (E) and odd (O) samples then X = E + W^k O
+                const T er = T (0.5) * (zr[k] + zr[M - k]);
+                const T ei = T (0.5) * (zi[k] - zi[M - k]);
+                const T orr = T (0.5) * (zi[k] + zi[M - k]);
+                const T oi = T (0.5) * (zr[M - k] - zr[k]);
+                
+                output[k] = er + c[k] * orr + s[k] * oi;
+                output[M + k] = -(ei + c[k] * oi - s[k] * orr); // FFTReal stores the negative imaginary parts
+            }
+        }
+        
+        void inverse (T* output, const T* input)
+        {
+            const long M = plan->halfLength;
+            const T* const c = plan->realTwiddles;
+            const T* const s = plan->realTwiddles + M;
+            T* zr = buffers;
+            T* zi = buffers + M;
+            long k;
+            
+            zr[0] = input[0] + input[M];
+            zi[0] = -(input[0] - input[M]);  // conjugated for the inverse
+            
+            for (k = 1; k < M; ++k)
+            {
+                const T ar = input[k],      ai = -input[M + k];
+                const T br = input[M - k],  bi = input[M + M - k]; // conj (X[M - k])
+                const T er = ar + br, ei = ai + bi;
+                const T dr = ar - br, di = ai - bi;
+                const T orr = dr * c[k] - di * s[k];
+                const T oi = dr * s[k] + di * c[k];
+                
+                zr[k] = er - oi;
+                zi[k] = -(ei + orr);
+            }
+            
+            transform (zr, zi);
+            
+            for (k = 0; k < M; ++k)
+            {
+                output[2 * k] = zr[k];
+                output[2 * k + 1] = -zi[k];
+            }
+        }
+        
+    private:
+        Plan<T>* plan;
+        T* buffers;
+        
+        /** Forward complex FFT, zr and zi are updated to point to the result. */
+        void transform (T*& zr, T*& zi)
+        {
+            const long M = plan->halfLength;
+            T* xr = zr;
+            T* xi = zi;
+            T* yr = (zr == buffers) ? buffers + 2 * M : buffers;
+            T* yi = yr + M;
+            T* tmp;
+            long n, s;
+            int stage;
+            
+            for (n = M, s = 1, stage = 0; stage < plan->numStages; ++stage)
+            {
+                const int radix = plan->radices[stage];
+                const long m = n / radix;
+                const T* const twr = plan->stageTwiddles[stage];
+                const T* const twi = twr + (radix - 1) * m;
+                
+                if ((s % VOps::Width) == 0)
+                    Pass<T,VOps>::run (radix, xr, xi, yr, yi, s, m, twr, twi);
+                else
+                    Pass<T,SOps>::run (radix, xr, xi, yr, yi, s, m, twr, twi);
+                
+                tmp = xr; xr = yr; yr = tmp;
+                tmp = xi; xi = yi; yi = tmp;
+                n = m;
+                s *= radix;
+            }
+            
+            zr = xr;
+            zi = xi;
+        }
+        
+        Engine (Engine const&);
+        Engine& operator= (Engine const&);
+    };
+}
+
+using namespace plank_mixedradix;
+
+PlankB pl_FFTMixedRadix_IsSupportedLength (const long length)
+{
+    int radices[MaxStages];
+    return ((length >= 2) && ((length % 2) == 0) && (factorise (length / 2, radices) >= 0)) ? PLANK_TRUE : PLANK_FALSE;
+}
+
+void* pl_FFTMixedRadixF_CreateAndInitWithLength (const long length)
+{
+    return pl_FFTMixedRadix_IsSupportedLength (length) ? new Engine<float> (length) : 0;
+}
+
+void pl_FFTMixedRadixF_Destroy (void* peer)
+{
+    delete static_cast<Engine<float>*> (peer);
+}
+
+void pl_FFTMixedRadixF_Forward (void* peer, float* output, const float* input)
+{
+    static_cast<Engine<float>*> (peer)->forward (output, input);
+}
+
+void pl_FFTMixedRadixF_Inverse (void* peer, float* output, const float* input)
+{
+    static_cast<Engine<float>*> (peer)->inverse (output, input);
+}
+
+void* pl_FFTMixedRadixD_CreateAndInitWithLength (const long length)
+{
+    return pl_FFTMixedRadix_IsSupportedLength (length) ? new Engine<double> (length) : 0;
+}
+
+void pl_FFTMixedRadixD_Destroy (void* peer)
+{
+    delete static_cast<Engine<double>*> (peer);
+}
+
+void pl_FFTMixedRadixD_Forward (void* peer, double* output, const double* input)
+{
+    static_cast<Engine<double>*> (peer)->forward (output, input);
+}
+
+void pl_FFTMixedRadixD_Inverse (void* peer, double* output, const double* input)
+{
+    static_cast<Engine<double>*> (peer)->inverse (output, input);
+}
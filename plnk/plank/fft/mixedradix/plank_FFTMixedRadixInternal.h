@@ -0,0 +1,60 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLANK_FFTMIXEDRADIXINTERNAL_H
+#define PLANK_FFTMIXEDRADIXINTERNAL_H
+
+PLANK_BEGIN_C_LINKAGE
+
+/** Determine whether a real FFT size is supported by the mixed-radix engine.
+ The length must be even and half the length must only have factors of 2, 3 and 5. */
+PlankB pl_FFTMixedRadix_IsSupportedLength (const long length);
+
+void* pl_FFTMixedRadixF_CreateAndInitWithLength (const long length);
+void pl_FFTMixedRadixF_Destroy (void* peer);
+void pl_FFTMixedRadixF_Forward (void* peer, float* output, const float* input);
+void pl_FFTMixedRadixF_Inverse (void* peer, float* output, const float* input);
+
+void* pl_FFTMixedRadixD_CreateAndInitWithLength (const long length);
+void pl_FFTMixedRadixD_Destroy (void* peer);
+void pl_FFTMixedRadixD_Forward (void* peer, double* output, const double* input);
+void pl_FFTMixedRadixD_Inverse (void* peer, double* output, const double* input);
+
+PLANK_END_C_LINKAGE
+
+#endif // PLANK_FFTMIXEDRADIXINTERNAL_H
@@ -46,6 +46,8 @@
     #include "fftreal/plank_FFTRealInternal.h"
 #endif
 
+#include "mixedradix/plank_FFTMixedRadixInternal.h"
+
 #if !DOXYGEN
 typedef struct PlankFFTF
 {
@@ -56,6 +58,7 @@ typedef struct PlankFFTF
     float fftScale;
     float ifftScale;
     float* buffer;
+    PlankB mixedRadix;
 #ifdef PLANK_FFT_VDSP
     DSPSplitComplex bufferComplex;
 #endif
@@ -117,6 +120,13 @@ PlankResult pl_FFTF_InitWithLength (PlankFFTFRef p, const PlankL length)
         p->length = (PlankL)1 << p->length; // less than 16 use it as a power of 2
     
     p->halfLength = p->length / 2;
+    p->mixedRadix = (p->length & (p->length - 1)) ? PLANK_TRUE : PLANK_FALSE;
+    
+    if (p->mixedRadix && !pl_FFTMixedRadix_IsSupportedLength (p->length))
+    {
+        result = PlankResult_ItemCountInvalid;
+        goto exit;
+    }
     
     p->lengthLog2 = 4;
     while (((PlankL)1 << p->lengthLog2) < p->length)
@@ -130,17 +140,27 @@ PlankResult pl_FFTF_InitWithLength (PlankFFTFRef p, const PlankL length)
         goto exit;
     }
     
+    if (p->mixedRadix)
+    {
+        // same scaling as FFTReal
+        p->peer = pl_FFTMixedRadixF_CreateAndInitWithLength (p->length);
+        p->fftScale = 2.f / (int)p->length;
+        p->ifftScale = 0.5f;
+    }
+    else
+    {
 #ifdef PLANK_FFT_VDSP    
-    p->peer = vDSP_create_fftsetup (p->lengthLog2, 0);
-    p->bufferComplex.realp = p->buffer;
-    p->bufferComplex.imagp = p->buffer + p->halfLength;
-    p->fftScale = 1.f / p->length;
-    p->ifftScale = 0.5f;
+        p->peer = vDSP_create_fftsetup (p->lengthLog2, 0);
+        p->bufferComplex.realp = p->buffer;
+        p->bufferComplex.imagp = p->buffer + p->halfLength;
+        p->fftScale = 1.f / p->length;
+        p->ifftScale = 0.5f;
 #else   
-    p->peer = pl_FFTRealF_CreateAndInitWithLength (p->length);
-    p->fftScale = 2.f / (int)p->length;
-    p->ifftScale = 0.5f;
+        p->peer = pl_FFTRealF_CreateAndInitWithLength (p->length);
+        p->fftScale = 2.f / (int)p->length;
+        p->ifftScale = 0.5f;
 #endif
+    }
     
     if (p->peer == PLANK_NULL)
     {
@@ -164,12 +184,19 @@ PlankResult pl_FFTF_DeInit (PlankFFTFRef p)
         goto exit;
     }
     
+    if (p->mixedRadix)
+    {
+        pl_FFTMixedRadixF_Destroy (p->peer);
+    }
+    else
+    {
 #ifdef PLANK_FFT_VDSP
-    FFTSetup fftvDSP = (FFTSetup)p->peer;
-    vDSP_destroy_fftsetup (fftvDSP);
+        FFTSetup fftvDSP = (FFTSetup)p->peer;
+        vDSP_destroy_fftsetup (fftvDSP);
 #else
-    pl_FFTRealF_Destroy (p->peer);
+        pl_FFTRealF_Destroy (p->peer);
 #endif
+    }
     
     p->peer = PLANK_NULL;
     result = pl_Memory_Free (m, p->buffer);
@@ -201,6 +228,18 @@ void pl_FFTF_Forward (PlankFFTFRef p, float* output, const float* input)
 {
     const PlankL N = p->length;
     const float scale = p->fftScale;
+    
+    if (p->mixedRadix)
+    {
+        pl_FFTMixedRadixF_Forward (p->peer, output, input);
+        pl_VectorMulF_NN1 (output, output, scale, N);
+        
+#if defined(PLANK_FFT_VDSP) && !defined(PLANK_FFT_VDSP_FLIPIMAG)
+        // match the imaginary sign of the vDSP power-of-2 sizes
+        pl_VectorNegF_NN (output + p->halfLength + 1, output + p->halfLength + 1, p->halfLength - 1);
+#endif
+        return;
+    }
 
 #ifdef PLANK_FFT_VDSP
     FFTSetup fftvDSP = (FFTSetup)p->peer;
@@ -242,6 +281,16 @@ void pl_FFTF_Inverse (PlankFFTFRef p, float* output, const float* input)
     float* buffer = p->buffer;
 
     pl_MemoryCopy (buffer, input, sizeof (float) * N);
+    
+    if (p->mixedRadix)
+    {
+#if defined(PLANK_FFT_VDSP) && !defined(PLANK_FFT_VDSP_FLIPIMAG)
+        pl_VectorNegF_NN (buffer + p->halfLength + 1, buffer + p->halfLength + 1, p->halfLength - 1);
+#endif
+        pl_FFTMixedRadixF_Inverse (p->peer, output, buffer);
+        pl_VectorMulF_NN1 (output, output, scale, N);
+        return;
+    }
 
 #ifdef PLANK_FFT_VDSP
     FFTSetup fftvDSP = (FFTSetup)p->peer;
@@ -283,3 +332,286 @@ float* pl_FFTF_Temp (PlankFFTFRef p)
     return p->buffer;
 }
 
+#if !DOXYGEN
+typedef struct PlankFFTD
+{
+    void* peer;
+    PlankL length;
+    PlankL halfLength;
+    PlankL lengthLog2;
+    double fftScale;
+    double ifftScale;
+    double* buffer;
+    PlankB mixedRadix;
+#ifdef PLANK_FFT_VDSP
+    DSPDoubleSplitComplex bufferComplex;
+#endif
+} PlankFFTD;
+#endif
+
+PlankFFTDRef pl_FFTD_CreateAndInit()
+{
+    PlankFFTDRef p;
+    p = pl_FFTD_Create();
+    
+    if (p != PLANK_NULL)
+    {
+        if (pl_FFTD_Init (p) != PlankResult_OK)
+            pl_FFTD_Destroy (p);
+        else
+            return p;
+    }
+    
+    return (PlankFFTDRef)PLANK_NULL;
+}
+
+PlankFFTDRef pl_FFTD_Create()
+{
+    PlankMemoryRef m;
+    PlankFFTDRef p;
+
+    m = pl_MemoryGlobal();
+    p = (PlankFFTDRef)pl_Memory_AllocateBytes (m, sizeof (PlankFFTD));
+
+    if (p != NULL)
+        pl_MemoryZero (p, sizeof (PlankFFTD));
+    
+    return p;
+}
+
+PlankResult pl_FFTD_Init (PlankFFTDRef p)
+{
+    return pl_FFTD_InitWithLength (p, 0);
+}
+
+PlankResult pl_FFTD_InitWithLength (PlankFFTDRef p, const PlankL length)
+{
+    PlankResult result = PlankResult_OK;
+    PlankMemoryRef m;    
+    m = pl_MemoryGlobal();
+    
+    if (p == PLANK_NULL)
+    {
+        result = PlankResult_MemoryError;
+        goto exit;
+    }
+    
+    p->length = length;
+    
+    if (p->length <= 0)
+        p->length = PLANKFFTD_DEFAULTLENGTH;
+    else if (p->length < 16)
+        p->length = (PlankL)1 << p->length; // less than 16 use it as a power of 2
+    
+    p->halfLength = p->length / 2;
+    p->mixedRadix = (p->length & (p->length - 1)) ? PLANK_TRUE : PLANK_FALSE;
+    
+    if (p->mixedRadix && !pl_FFTMixedRadix_IsSupportedLength (p->length))
+    {
+        result = PlankResult_ItemCountInvalid;
+        goto exit;
+    }
+    
+    p->lengthLog2 = 4;
+    while (((PlankL)1 << p->lengthLog2) < p->length)
+        PLANK_INC (p->lengthLog2);
+    
+    p->buffer = (double*)pl_Memory_AllocateBytes (m, sizeof (double) * p->length);
+    
+    if (p->buffer == PLANK_NULL)
+    {
+        result = PlankResult_MemoryError;
+        goto exit;
+    }
+    
+    if (p->mixedRadix)
+    {
+        // same scaling as FFTReal
+        p->peer = pl_FFTMixedRadixD_CreateAndInitWithLength (p->length);
+        p->fftScale = 2.0 / (int)p->length;
+        p->ifftScale = 0.5;
+    }
+    else
+    {
+#ifdef PLANK_FFT_VDSP    
+        p->peer = vDSP_create_fftsetupD (p->lengthLog2, 0);
+        p->bufferComplex.realp = p->buffer;
+        p->bufferComplex.imagp = p->buffer + p->halfLength;
+        p->fftScale = 1.0 / p->length;
+        p->ifftScale = 0.5;
+#else   
+        p->peer = pl_FFTRealD_CreateAndInitWithLength (p->length);
+        p->fftScale = 2.0 / (int)p->length;
+        p->ifftScale = 0.5;
+#endif
+    }
+    
+    if (p->peer == PLANK_NULL)
+    {
+        result = PlankResult_MemoryError;
+        goto exit;
+    }        
+    
+exit:
+    return result;
+}
+
+PlankResult pl_FFTD_DeInit (PlankFFTDRef p)
+{
+    PlankResult result = PlankResult_OK;
+    PlankMemoryRef m;
+    m = pl_MemoryGlobal();
+    
+    if (p->peer == PLANK_NULL)
+    {
+        result = PlankResult_MemoryError;
+        goto exit;
+    }
+    
+    if (p->mixedRadix)
+    {
+        pl_FFTMixedRadixD_Destroy (p->peer);
+    }
+    else
+    {
+#ifdef PLANK_FFT_VDSP
+        FFTSetupD fftvDSP = (FFTSetupD)p->peer;
+        vDSP_destroy_fftsetupD (fftvDSP);
+#else
+        pl_FFTRealD_Destroy (p->peer);
+#endif
+    }
+    
+    p->peer = PLANK_NULL;
+    result = pl_Memory_Free (m, p->buffer);
+    
+    pl_MemoryZero (p, sizeof (PlankFFTD));
+
+exit:
+    return result;
+}
+
+PlankResult pl_FFTD_Destroy (PlankFFTDRef p)
+{
+    PlankResult result;
+    PlankMemoryRef m;
+    
+    result = PlankResult_OK;
+    m = pl_MemoryGlobal();
+    
+    if ((result = pl_FFTD_DeInit (p)) != PlankResult_OK)
+        goto exit;
+    
+    result = pl_Memory_Free (m, p);
+    
+exit:
+    return result;
+}
+
+void pl_FFTD_Forward (PlankFFTDRef p, double* output, const double* input)
+{
+    const PlankL N = p->length;
+    const double scale = p->fftScale;
+    
+    if (p->mixedRadix)
+    {
+        pl_FFTMixedRadixD_Forward (p->peer, output, input);
+        pl_VectorMulD_NN1 (output, output, scale, N);
+        
+#if defined(PLANK_FFT_VDSP) && !defined(PLANK_FFT_VDSP_FLIPIMAG)
+        // match the imaginary sign of the vDSP power-of-2 sizes
+        pl_VectorNegD_NN (output + p->halfLength + 1, output + p->halfLength + 1, p->halfLength - 1);
+#endif
+        return;
+    }
+
+#ifdef PLANK_FFT_VDSP
+    FFTSetupD fftvDSP = (FFTSetupD)p->peer;
+    const PlankL N2 = p->halfLength;
+    const PlankL Nlog2 = p->lengthLog2;
+    double* buffer = p->buffer;
+
+    DSPDoubleSplitComplex outputComplex;
+    outputComplex.realp = output;
+    outputComplex.imagp = output + N2;
+    
+    if (scale != 1.0)
+        pl_VectorMulD_NN1 (buffer, input, scale, N);
+    
+    vDSP_ctozD ((DOUBLE_COMPLEX*)buffer, 2, &outputComplex, 1, N2);
+    vDSP_fft_zripD (fftvDSP, &outputComplex, 1, Nlog2, FFT_FORWARD);
+        
+    #ifdef PLANK_FFT_VDSP_FLIPIMAG
+    double* flip = output + N2;
+    double nyquist = flip[0];
+
+    pl_VectorNegD_NN (flip, flip, N2);    
+    
+    flip[0] = nyquist;
+    #endif
+    
+#else
+    pl_FFTRealD_Forward (p->peer, output, input);
+    
+    if (scale != 1.0)
+        pl_VectorMulD_NN1(output, output, scale, N);
+#endif
+}
+
+void pl_FFTD_Inverse (PlankFFTDRef p, double* output, const double* input)
+{
+    const PlankL N = p->length;
+    const double scale = p->ifftScale;
+    double* buffer = p->buffer;
+
+    pl_MemoryCopy (buffer, input, sizeof (double) * N);
+    
+    if (p->mixedRadix)
+    {
+#if defined(PLANK_FFT_VDSP) && !defined(PLANK_FFT_VDSP_FLIPIMAG)
+        pl_VectorNegD_NN (buffer + p->halfLength + 1, buffer + p->halfLength + 1, p->halfLength - 1);
+#endif
+        pl_FFTMixedRadixD_Inverse (p->peer, output, buffer);
+        pl_VectorMulD_NN1 (output, output, scale, N);
+        return;
+    }
+
+#ifdef PLANK_FFT_VDSP
+    FFTSetupD fftvDSP = (FFTSetupD)p->peer;
+    DSPDoubleSplitComplex* bufferComplex = &p->bufferComplex;
+    const PlankL N2 = p->halfLength;
+    const PlankL Nlog2 = p->lengthLog2;
+
+    #ifdef PLANK_FFT_VDSP_FLIPIMAG
+    double* flip = buffer + N2;
+    double nyquist = flip[0];
+    
+    pl_VectorNegD_NN (flip, flip, N2);    
+    
+    flip[0] = nyquist;
+    #endif    
+    
+    vDSP_fft_zripD (fftvDSP, bufferComplex, 1, Nlog2, FFT_INVERSE);
+    vDSP_ztocD (bufferComplex, 1, (DOUBLE_COMPLEX*)output, 2, N2);
+#else
+    pl_FFTRealD_Inverse (p->peer, output, buffer);
+#endif
+    
+    if (scale != 1.0)
+        pl_VectorMulD_NN1(output, output, scale, N);
+}
+
+PlankL pl_FFTD_Length (PlankFFTDRef p)
+{
+    return p->length;
+}
+
+PlankL pl_FFTD_HalfLength (PlankFFTDRef p)
+{
+    return p->halfLength;
+}
+
+double* pl_FFTD_Temp (PlankFFTDRef p)
+{
+    return p->buffer;
+}
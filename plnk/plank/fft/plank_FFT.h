@@ -40,6 +40,7 @@
 #define PLANK_FFT_H
 
 #define PLANKFFTF_DEFAULTLENGTH 4096
+#define PLANKFFTD_DEFAULTLENGTH 4096
 
 PLANK_BEGIN_C_LINKAGE
 
@@ -51,6 +52,10 @@ PLANK_BEGIN_C_LINKAGE
  FFTReal (via the Plank FFTRealInternal class). To use vDSP on Mac OS X or iOS 
  define the preprocessor macro PLANK_FFT_VDSP.
  
+ Sizes which are not a power of 2 but whose factors are only 2, 3 and 5 (e.g., 480 or
+ 960) use a mixed-radix engine (via the Plank FFTMixedRadixInternal class) which 
+ produces the same layout and scaling as the power of 2 sizes. These sizes must be even.
+ 
  @code
  PlankFFTFRef fft;
  float input[128];
@@ -112,9 +117,11 @@ PlankResult pl_FFTF_Init (PlankFFTFRef p);
 
 /** Initialise a <i>Plank FFTF</i> object. 
  @param p The <i>Plank FFTF</i> object. 
- @param length  The FFT size - this must be a power of 2 or less than 16 (where it will
+ @param length  The FFT size - this must be a power of 2, an even size with no prime factors
+                other than 2, 3 and 5 (e.g., 480) or less than 16 (where it will
                 specify the log2 FFT size e.g., length 8 = pow(2,8) = 256
- @return A result code which will be PlankResult_OK if the operation was completely successful. */
+ @return A result code which will be PlankResult_OK if the operation was completely successful
+         or PlankResult_ItemCountInvalid if the size is not supported. */
 PlankResult pl_FFTF_InitWithLength (PlankFFTFRef p, const PlankL length);
 
 /** Deinitialise a <i>Plank FFTF</i> object. 
@@ -162,6 +169,83 @@ float* pl_FFTF_Temp (PlankFFTFRef p);
 
 /// @} // End group PlankFFTFClass
 
+/** A double precision version of the <i>Plank FFTF</i> class.
+ The API, data layout and supported sizes are the same as <i>Plank FFTF</i>.
+ @defgroup PlankFFTDClass Plank FFTD class
+ @ingroup PlankClasses
+ @{
+ */
+
+/** An opaque reference to the <i>Plank FFTD</i> object. */
+typedef struct PlankFFTD* PlankFFTDRef; 
+
+/** Create and initialise a <i>Plank FFTD</i> object and return an oqaque reference to it. 
+ @return A <i>Plank FFTD</i> object as an opaque reference. */
+PlankFFTDRef pl_FFTD_CreateAndInit();
+
+/** Create a <i>Plank FFTD</i> object and return an oqaque reference to it. 
+ @return A <i>Plank FFTD</i> object as an opaque reference. */
+PlankFFTDRef pl_FFTD_Create();
+
+/** Initialise a <i>Plank FFTD</i> object with a default length (PLANKFFTD_DEFAULTLENGTH). 
+ @param p The <i>Plank FFTD</i> object. 
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_FFTD_Init (PlankFFTDRef p);
+
+/** Initialise a <i>Plank FFTD</i> object. 
+ @param p The <i>Plank FFTD</i> object. 
+ @param length  The FFT size - this must be a power of 2, an even size with no prime factors
+                other than 2, 3 and 5 (e.g., 480) or less than 16 (where it will
+                specify the log2 FFT size e.g., length 8 = pow(2,8) = 256
+ @return A result code which will be PlankResult_OK if the operation was completely successful
+         or PlankResult_ItemCountInvalid if the size is not supported. */
+PlankResult pl_FFTD_InitWithLength (PlankFFTDRef p, const PlankL length);
+
+/** Deinitialise a <i>Plank FFTD</i> object. 
+ @param p The <i>Plank FFTD</i> object. 
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_FFTD_DeInit (PlankFFTDRef p);
+
+/** Destroy a <i>Plank FFTD</i> object. 
+ @param p The <i>Plank FFTD</i> object. 
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_FFTD_Destroy (PlankFFTDRef p);
+
+/** Apply the FFT to the input and place the result in output.
+ This may be performed in-place (i.e., input and output can point to the same data). 
+ @param p The <i>Plank FFTD</i> object. 
+ @param output A pointer to an array of doubles to store the result. 
+ @param input A pointer to an array of doubles holding the input data. */
+void pl_FFTD_Forward (PlankFFTDRef p, double* output, const double* input);
+
+/** Apply the inverse-FFT to the input and place the result in output.
+ This may be performed in-place (i.e., input and output can point to the same data). 
+ @param p The <i>Plank FFTD</i> object. 
+ @param output A pointer to an array of doubles to store the result. 
+ @param input A pointer to an array of doubles holding the input data. */
+void pl_FFTD_Inverse (PlankFFTDRef p, double* output, const double* input);
+
+/** Get the FFT size. 
+ @param p The <i>Plank FFTD</i> object. 
+ @return The FFT size. */
+PlankL pl_FFTD_Length (PlankFFTDRef p);
+
+/** Get half FFT size. 
+ This is just as a convenience as it is already cached for efficiency. 
+ @param p The <i>Plank FFTD</i> object. 
+ @return The half FFT size. */
+PlankL pl_FFTD_HalfLength (PlankFFTDRef p);
+
+/** Get a pointer to the internal temporary buffer.
+ This is an array of doubles the size of the FFT. This could 
+ be useful as a scratch space to save allocating more memory. Of
+ course its contents may be invalidated by any other Plank FFTD calls. 
+ @param p The <i>Plank FFTD</i> object. 
+ @return A pointer to the temporary double buffer. */
+double* pl_FFTD_Temp (PlankFFTDRef p);
+
+/// @} // End group PlankFFTDClass
+
 PLANK_END_C_LINKAGE
 
 #endif // PLANK_FFT_H
@@ -38,6 +38,7 @@
 
 #include "../../core/plank_StandardHeader.h"
 #include "../../maths/plank_Maths.h"
+#include "../../maths/vectors/plank_Vectors.h"
 #include "../plank_File.h"
 #include "../plank_Path.h"
 #include "../plank_MultiFileReader.h"
@@ -50,6 +51,8 @@
 
 // private structures
 
+#define PLANKAUDIOFILEREADER_READAHEADBYTES 262144
+
 // private functions and data
 typedef PlankResult (*PlankAudioFileReaderReadFramesFunction)(PlankAudioFileReaderRef, const PlankB, const int, void*, int *);
 typedef PlankResult (*PlankAudioFileReaderSetFramePositionFunction)(PlankAudioFileReaderRef, const PlankLL);
@@ -497,6 +500,28 @@ PlankResult pl_AudioFileReader_OpenWithFile (PlankAudioFileReaderRef p, PlankFil
     return pl_AudioFileReader_OpenInternalInternal (p, 0, file, metaDataIOFlags);
 }
 
+PlankResult pl_AudioFileReader_OpenMapped (PlankAudioFileReaderRef p, const char* filepath, const PlankAudioFileMetaDataIOFlags metaDataIOFlags)
+{
+    PlankResult result;
+    PlankFile file;
+    
+    pl_File_Init (&file);
+    
+    if ((result = pl_File_OpenMapped (&file, filepath, PLANK_FALSE)) == PlankResult_OK)
+        result = pl_AudioFileReader_OpenWithFile (p, &file, metaDataIOFlags);
+    
+    // the reader takes the file if it opened it (leaving ours zeroed) otherwise close it here
+    pl_File_DeInit (&file);
+    
+    if ((result != PlankResult_OK) || (p->peer == PLANK_NULL))
+    {
+        // not mappable (e.g., empty or the address space is full) or a compressed format
+        result = pl_AudioFileReader_OpenInternal (p, filepath, metaDataIOFlags);
+    }
+    
+    return result;
+}
+
 PlankResult pl_AudioFileReader_OpenWithAudioFileArray (PlankAudioFileReaderRef p, PlankDynamicArrayRef array, PlankB ownArray, const int multiMode, int* indexRef)
 {
     return pl_AudioFileReader_Array_Open (p, array, ownArray, multiMode, indexRef);
@@ -826,6 +851,79 @@ PlankResult pl_AudioFileReader_ReadFrames (PlankAudioFileReaderRef p, const Plan
     return ((PlankAudioFileReaderReadFramesFunction)p->readFramesFunction)(p, convertByteOrder, numFrames, data, framesRead);
 }
 
+PlankResult pl_AudioFileReader_ReadFramesDirect (PlankAudioFileReaderRef p, const int numFrames, const void** frames, int *framesRead)
+{
+    PlankResult result = PlankResult_OK;
+    PlankFileRef file;
+    PlankLL startFrame, endFrame, position;
+    int framesToRead, bytesToRead, bytesRead, type, bytesPerSample;
+    
+    *frames = PLANK_NULL;
+    bytesRead = 0;
+    
+    if ((p->peer == PLANK_NULL) || (p->readFramesFunction != (PlankM)pl_AudioFileReader_Iff_ReadFrames))
+    {
+        result = PlankResult_FileNotMapped;
+        goto exit;
+    }
+    
+    file = (PlankFileRef)p->peer;
+    
+    if ((result = pl_File_GetStreamType (file, &type)) != PlankResult_OK) goto exit;
+    
+    if ((type != PLANKFILE_STREAMTYPE_MEMORY) && (type != PLANKFILE_STREAMTYPE_MAPPED))
+    {
+        result = PlankResult_FileNotMapped;
+        goto exit;
+    }
+    
+    if ((p->dataPosition < 0) || (p->formatInfo.bytesPerFrame <= 0))
+    {
+        result = PlankResult_AudioFileNotReady;
+        goto exit;
+    }
+    
+    if ((result = pl_AudioFileReader_GetFramePosition (p, &startFrame)) != PlankResult_OK) goto exit;
+    
+    if (startFrame < 0)
+    {
+        result = PlankResult_AudioFileInvalidFilePosition;
+        goto exit;
+    }
+    
+    endFrame = startFrame + numFrames;
+    framesToRead = ((p->numFrames == -1) || (endFrame <= p->numFrames)) ? (numFrames) : (int)(p->numFrames - startFrame);
+    bytesToRead = framesToRead * p->formatInfo.bytesPerFrame;
+    
+    if (bytesToRead > 0)
+    {
+        if ((result = pl_File_GetPosition (file, &position)) != PlankResult_OK) goto exit;
+        
+        result = pl_File_ReadDirect (file, frames, bytesToRead, &bytesRead);
+        
+        // 24-bit samples are read bytewise but others must be aligned for their type
+        bytesPerSample = p->formatInfo.bytesPerFrame / pl_AudioFileFormatInfo_GetNumChannels (&p->formatInfo);
+        
+        if ((result == PlankResult_OK) && (bytesPerSample != 3) && (((PlankUL)*frames % (PlankUL)bytesPerSample) != 0))
+        {
+            *frames = PLANK_NULL;
+            bytesRead = 0;
+            pl_File_SetPosition (file, position);
+            result = PlankResult_FileNotMapped;
+        }
+    }
+    else
+    {
+        result = PlankResult_FileEOF;
+    }
+    
+exit:
+    if (framesRead != PLANK_NULL)
+        *framesRead = (p->formatInfo.bytesPerFrame > 0) ? bytesRead / p->formatInfo.bytesPerFrame : 0;
+    
+    return result;
+}
+
 PlankAudioFileMetaDataRef pl_AudioFileReader_GetMetaData (PlankAudioFileReaderRef p)
 {
     return p->metaData;
@@ -2345,8 +2443,7 @@ PlankResult pl_AudioFileReader_Iff_ReadFrames (PlankAudioFileReaderRef p,  const
 {
     PlankResult result = PlankResult_OK;
     PlankLL startFrame, endFrame;
-    int framesToRead, framesReadLocal, bytesToRead, bytesRead, i, bytesPerSample, numSamples, numChannels;
-    PlankUC* swapPtr;
+    int framesToRead, framesReadLocal, bytesToRead, bytesRead, bytesPerSample, numSamples, numChannels;
     
     if (p->peer == PLANK_NULL)
     {
@@ -2390,39 +2487,13 @@ PlankResult pl_AudioFileReader_Iff_ReadFrames (PlankAudioFileReaderRef p,  const
     if ((framesReadLocal > 0) && convertByteOrder && (bytesPerSample > 1))
     {
         numSamples = framesReadLocal * numChannels;
-        swapPtr = data;
         
         switch (bytesPerSample)
         {
-            case 2:
-                for (i = 0; i < numSamples; ++i)
-                {
-                    pl_SwapEndianS ((PlankS*)swapPtr);
-                    swapPtr += 2;
-                }                    
-                break;
-            case 3:
-                for (i = 0; i < numSamples; ++i)
-                {
-                    pl_SwapEndianI24 ((PlankI24*)swapPtr);
-                    swapPtr += 3;
-                }
-                break;
-            case 4:
-                for (i = 0; i < numSamples; ++i)
-                {
-                    pl_SwapEndianI ((PlankI*)swapPtr);
-                    swapPtr += 4;
-                }
-
-                break;
-            case 8:
-                for (i = 0; i < numSamples; ++i)
-                {
-                    pl_SwapEndianD ((PlankD*)swapPtr);
-                    swapPtr += 8;
-                }
-                break;
+            case 2: pl_VectorSwapEndianS ((PlankS*)data, numSamples);         break;
+            case 3: pl_VectorSwapEndianI24 ((PlankI24*)data, numSamples);     break;
+            case 4: pl_VectorSwapEndianI ((PlankI*)data, numSamples);         break;
+            case 8: pl_VectorSwapEndianULL ((PlankULL*)data, numSamples);     break;
             default:
                 result = PlankResult_AudioFileInavlidType;
                 goto exit;
@@ -2450,7 +2521,11 @@ PlankResult pl_AudioFileReader_Iff_SetFramePosition (PlankAudioFileReaderRef p,
     }
     
     pos = p->dataPosition + frameIndex * p->formatInfo.bytesPerFrame;
-    result = pl_File_SetPosition ((PlankFileRef)p->peer, pos);
+    
+    if ((result = pl_File_SetPosition ((PlankFileRef)p->peer, pos)) != PlankResult_OK) goto exit;
+    
+    // a jump in a mapped file will usually page fault on the next read so ask for it early
+    result = pl_File_ReadAhead ((PlankFileRef)p->peer, pos, PLANKAUDIOFILEREADER_READAHEADBYTES);
     
 exit:
     return result;
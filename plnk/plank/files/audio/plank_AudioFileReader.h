@@ -95,6 +95,11 @@ PlankResult pl_AudioFileReader_OpenInternal (PlankAudioFileReaderRef p, const ch
  The AudioFileReader takes ownership of the file and zeros the incomming file object. */
 PlankResult pl_AudioFileReader_OpenWithFile (PlankAudioFileReaderRef p, PlankFileRef file, const PlankAudioFileMetaDataIOFlags metaDataIOFlags);
 
+/** Open a file by mapping it into memory rather than streaming it.
+ Uncompressed files can then be read without copying using pl_AudioFileReader_ReadFramesDirect().
+ If the file can't be mapped or is a compressed format this falls back to opening the file normally. */
+PlankResult pl_AudioFileReader_OpenMapped (PlankAudioFileReaderRef p, const char* filepath, const PlankAudioFileMetaDataIOFlags metaDataIOFlags);
+
 PlankResult pl_AudioFileReader_OpenWithAudioFileArray (PlankAudioFileReaderRef p, PlankDynamicArrayRef array, PlankB ownArray, const int multiMode, int* indexRef);
 
 typedef PlankResult (*PlankAudioFileReaderCustomNextFunction)(PlankP, PlankAudioFileReaderRef, PlankAudioFileReaderRef*);
@@ -184,6 +189,20 @@ PlankResult pl_AudioFileReader_GetFramePosition (PlankAudioFileReaderRef p, Plan
  @return A result code which will be PlankResult_OK if the operation was completely successful. */
 PlankResult pl_AudioFileReader_ReadFrames (PlankAudioFileReaderRef p, const PlankB convertByteOrder, const int numFrames, void* data, int* framesRead);
 
+/** Get a pointer to the next frames without copying them.
+ This is only available for uncompressed files that are held in memory (i.e., opened with
+ pl_AudioFileReader_OpenMapped() or from a memory file) where the samples are suitably aligned for 
+ their type, otherwise PlankResult_FileNotMapped is returned, the position is left unchanged and 
+ pl_AudioFileReader_ReadFrames() should be used instead. The frames are in the file's
+ byte order and remain valid until the reader is closed. The frame position is advanced as with
+ pl_AudioFileReader_ReadFrames().
+ @param p The <i>Plank AudioFileReader</i> object. 
+ @param numFrames The maximum number of frames to access.
+ @param frames On success this is set to point to the frames.
+ @param framesRead The number of frames available at @e frames (may be less than @e numFrames at the end of the file).
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_AudioFileReader_ReadFramesDirect (PlankAudioFileReaderRef p, const int numFrames, const void** frames, int* framesRead);
+
 PlankAudioFileMetaDataRef pl_AudioFileReader_GetMetaData (PlankAudioFileReaderRef p);
 
 PlankResult pl_AudioFileReader_SetName (PlankAudioFileReaderRef p, const char* text);
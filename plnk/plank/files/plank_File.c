@@ -38,6 +38,12 @@
 
 #include <sys/stat.h>
 #include "../core/plank_StandardHeader.h"
+
+#if !PLANK_WIN
+    #include <sys/mman.h>
+    #include <fcntl.h>
+#endif
+
 #include "plank_File.h"
 #include "../maths/plank_Maths.h"
 #include "plank_MultiFileReader.h"
@@ -291,6 +297,7 @@ static PlankResult pl_FileMemoryReadCallback (PlankFileRef p, PlankP ptr, int ma
 
     if (bytesRead <= 0)
     {
+        bytesRead = 0;
         result = PlankResult_FileEOF;
         goto exit;
     }
@@ -300,11 +307,11 @@ static PlankResult pl_FileMemoryReadCallback (PlankFileRef p, PlankP ptr, int ma
     if ((result = pl_MemoryCopy (ptr, src, bytesRead)) != PlankResult_OK) goto exit;
     
     p->position += bytesRead;
-        
+    
+exit:
     if (bytesReadOut)
         *bytesReadOut = bytesRead;
     
-exit:
     return result;
 }
 
@@ -366,6 +373,42 @@ static PlankResult pl_FileMemoryGetPositionCallback (PlankFileRef p, PlankLL* po
     return PlankResult_OK;
 }
 
+// mapped callbacks (reading and positioning is the same as memory)
+
+static PlankResult pl_FileMappedOpenCallback (PlankFileRef p)
+{
+    // the mapping is made by pl_File_OpenMapped()
+    (void)p;
+    return PlankResult_OK;
+}
+
+static PlankResult pl_FileMappedCloseCallback (PlankFileRef p)
+{
+#if PLANK_WIN
+    if (!UnmapViewOfFile (p->stream))
+        return PlankResult_FileCloseFailed;
+#else
+    if (munmap (p->stream, (size_t)p->size) != 0)
+        return PlankResult_FileCloseFailed;
+#endif
+    
+    return pl_File_Init (p);
+}
+
+static PlankResult pl_FileMappedClearCallback (PlankFileRef p)
+{
+    (void)p;
+    return PlankResult_FileWriteError;
+}
+
+static PlankResult pl_FileMappedWriteCallback (PlankFileRef p, const void* data, const int maximumBytes)
+{
+    (void)p;
+    (void)data;
+    (void)maximumBytes;
+    return PlankResult_FileWriteError;
+}
+
 // dynamic array callbacks
 
 static PlankResult pl_FileDynamicArrayOpenCallback (PlankFileRef p)
@@ -884,6 +927,7 @@ PlankResult pl_File_Open (PlankFileRef p, const char* filepath, const int mode)
         return PlankResult_FilePathInvalid;
     
     strncpy (p->path, filepath, PLANKPATH_MAXLENGTH);
+    p->path[PLANKPATH_MAXLENGTH - 1] = '\0'; // strncpy doesn't terminate paths that are too long
     
     p->mode = mode & PLANKFILE_MASK;    // without the big endian flag
     result = (p->openFunction) (p);
@@ -1114,6 +1158,128 @@ exit:
     return result;    
 }
 
+PlankResult pl_File_OpenMapped (PlankFileRef p, const char* filepath, const PlankB isBigEndian)
+{
+    PlankResult result;
+    PlankLL size;
+    void* memory;
+    
+    result = PlankResult_OK;
+    memory = PLANK_NULL;
+    
+    if (p->stream != 0)
+    {
+        if ((result = pl_File_Close (p)) != PlankResult_OK)
+            goto exit;
+    }
+    
+    if ((filepath == 0) || (filepath[0] == 0))
+    {
+        result = PlankResult_FilePathInvalid;
+        goto exit;
+    }
+    
+#if PLANK_WIN
+    {
+        HANDLE file, mapping;
+        LARGE_INTEGER fileSize;
+        
+        file = CreateFileA (filepath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            result = PlankResult_FileOpenFailed;
+            goto exit;
+        }
+        
+        if (!GetFileSizeEx (file, &fileSize) || (fileSize.QuadPart < 1))
+        {
+            CloseHandle (file);
+            result = PlankResult_FileOpenFailed;
+            goto exit;
+        }
+        
+        size = (PlankLL)fileSize.QuadPart;
+        mapping = CreateFileMappingA (file, NULL, PAGE_READONLY, 0, 0, NULL);
+        CloseHandle (file);
+        
+        if (mapping == NULL)
+        {
+            result = PlankResult_FileOpenFailed;
+            goto exit;
+        }
+        
+        // the view keeps the mapping alive
+        memory = MapViewOfFile (mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle (mapping);
+        
+        if (memory == NULL)
+        {
+            result = PlankResult_FileOpenFailed;
+            goto exit;
+        }
+    }
+#else
+    {
+        struct stat st;
+        int fd;
+        
+        fd = open (filepath, O_RDONLY);
+        
+        if (fd < 0)
+        {
+            result = PlankResult_FileOpenFailed;
+            goto exit;
+        }
+        
+        if ((fstat (fd, &st) != 0) || (st.st_size < 1))
+        {
+            close (fd);
+            result = PlankResult_FileOpenFailed;
+            goto exit;
+        }
+        
+        size = (PlankLL)st.st_size;
+        memory = mmap (0, (size_t)size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close (fd); // the mapping keeps its own reference to the file
+        
+        if (memory == MAP_FAILED)
+        {
+            result = PlankResult_FileOpenFailed;
+            goto exit;
+        }
+        
+        madvise (memory, (size_t)size, MADV_SEQUENTIAL);
+    }
+#endif
+    
+    strncpy (p->path, filepath, PLANKPATH_MAXLENGTH);
+    p->path[PLANKPATH_MAXLENGTH - 1] = '\0'; // strncpy doesn't terminate paths that are too long
+    p->stream = memory;
+    p->size = size;
+    p->position = 0;
+    p->mode = PLANKFILE_BINARY | PLANKFILE_READ | (isBigEndian ? PLANKFILE_BIGENDIAN : 0);
+    p->type = PLANKFILE_STREAMTYPE_MAPPED;
+    
+    result = pl_File_SetFunction (p,
+                                  pl_FileMappedOpenCallback,
+                                  pl_FileMappedCloseCallback,
+                                  pl_FileMappedClearCallback,
+                                  pl_FileMemoryGetStatusCallback,
+                                  pl_FileMemoryReadCallback,
+                                  pl_FileMappedWriteCallback,
+                                  pl_FileMemorySetPositionCallback,
+                                  pl_FileMemoryGetPositionCallback);
+    
+    if (result != PlankResult_OK) goto exit;
+    
+    result = (p->openFunction) (p);
+    if (result != PlankResult_OK) goto exit;
+    
+exit:
+    return result;
+}
+
 #define PLANKFILE_COPYCHUNKSIZE 512
 
 PlankResult pl_File_Copy (PlankFileRef p, PlankFileRef source, const PlankLL size)
@@ -1332,6 +1498,80 @@ PlankResult pl_File_Read (PlankFileRef p, PlankP data, const int maximumBytes, i
     return (p->readFunction) (p, data, maximumBytes, bytesRead);    
 }
 
+PlankResult pl_File_ReadDirect (PlankFileRef p, const void** data, const int maximumBytes, int* bytesReadOut)
+{
+    PlankResult result;
+    int bytesRead;
+    
+    result = PlankResult_OK;
+    bytesRead = 0;
+    
+    if (p->stream == 0)
+    {
+        result = PlankResult_FileInvalid;
+        goto exit;
+    }
+    
+    if (! (p->mode & PLANKFILE_READ))
+    {
+        result = PlankResult_FileReadError;
+        goto exit;
+    }
+    
+    if ((p->type != PLANKFILE_STREAMTYPE_MEMORY) && (p->type != PLANKFILE_STREAMTYPE_MAPPED))
+    {
+        result = PlankResult_FileNotMapped;
+        goto exit;
+    }
+    
+    bytesRead = (int)pl_MinLL (maximumBytes, p->size - p->position);
+    
+    if (bytesRead <= 0)
+    {
+        bytesRead = 0;
+        result = PlankResult_FileEOF;
+        goto exit;
+    }
+    
+    *data = (const PlankUC*)p->stream + p->position;
+    p->position += bytesRead;
+    
+exit:
+    if (bytesReadOut)
+        *bytesReadOut = bytesRead;
+    
+    return result;
+}
+
+PlankResult pl_File_ReadAhead (PlankFileRef p, const PlankLL position, const PlankLL numBytes)
+{
+#if !PLANK_WIN
+    PlankLL start, end, pageSize;
+#endif
+    
+    if (p->stream == 0)
+        return PlankResult_FileInvalid;
+    
+    if (p->type != PLANKFILE_STREAMTYPE_MAPPED)
+        return PlankResult_OK;
+    
+#if !PLANK_WIN
+    pageSize = (PlankLL)sysconf (_SC_PAGESIZE);
+    start = pl_ClipLL (position, 0, p->size);
+    end = pl_ClipLL (position + numBytes, 0, p->size);
+    start -= start % pageSize; // madvise needs a page aligned address
+    
+    if (end > start)
+        madvise ((PlankUC*)p->stream + start, (size_t)(end - start), MADV_WILLNEED);
+#else
+    // PrefetchVirtualMemory() would do this but needs Windows 8 so rely on the system's own readahead
+    (void)position;
+    (void)numBytes;
+#endif
+    
+    return PlankResult_OK;
+}
+
 PlankResult pl_File_ReadC (PlankFileRef p, char* data)
 {
     PlankResult result;
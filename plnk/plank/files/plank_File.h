@@ -105,6 +105,7 @@ typedef struct PlankFile* PlankFileRef;
 #define PLANKFILE_STREAMTYPE_DYNAMICARRAY   3
 #define PLANKFILE_STREAMTYPE_NETWORK        4
 #define PLANKFILE_STREAMTYPE_MULTI          5
+#define PLANKFILE_STREAMTYPE_MAPPED         6
 #define PLANKFILE_STREAMTYPE_OTHER          999
 
 #define PLANKFILE_SETPOSITION_ABSOLUTE       SEEK_SET
@@ -231,6 +232,18 @@ PlankResult pl_File_OpenDynamicArray (PlankFileRef p, PlankDynamicArrayRef memor
 
 PlankResult pl_File_OpenMulti (PlankFileRef p, PlankMulitFileReaderRef multi, const int mode);
 
+/** Open a binary file for reading by mapping it into memory.
+ The whole file is mapped read-only and reads are then copies from the mapping, 
+ or no copy at all using pl_File_ReadDirect(). This avoids the system call and 
+ the extra copy per read of the stdio based files which is useful for large 
+ sample libraries. Mapped files can't be written to or cleared.
+ @param p The <i>Plank %File</i> object. 
+ @param filepath The filepath of the file to open.
+ @param isBigEndian Set to @c true to read multibyte values in big endian 
+                    format, otherwise read in little endian format.
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_File_OpenMapped (PlankFileRef p, const char* filepath, const PlankB isBigEndian);
+
 PlankResult pl_File_Copy (PlankFileRef p, PlankFileRef source, const PlankLL size);
 
 PlankResult pl_File_Clear (PlankFileRef p);
@@ -328,6 +341,30 @@ PlankResult pl_File_SetEndian (PlankFileRef p, const PlankB isBigEndian);
  @return A result code which will be PlankResult_OK if the operation was completely successful. */
 PlankResult pl_File_Read (PlankFileRef p, PlankP data, const int maximumBytes, int* bytesRead);
 
+/** Read an array of bytes from the file without copying.
+ This is only available for memory and mapped files (see pl_File_OpenMemory() and 
+ pl_File_OpenMapped()). The pointer refers to the data at the current position 
+ which is then advanced in the same way as pl_File_Read(). The data remain valid 
+ until the file is closed. As with pl_File_Read() this takes no account of the 
+ endian format of the data.
+ @param p The <i>Plank %File</i> object. 
+ @param data On return points to the data.
+ @param maximumBytes The number of bytes to read.
+ @param bytesRead On return contains the number of bytes available at @e data (pass PLANK_NULL to ignore this).
+ @return A result code which will be PlankResult_OK if the operation was completely successful,
+         PlankResult_FileEOF if there are no more bytes or PlankResult_FileNotMapped if the
+         file is not held in memory. */
+PlankResult pl_File_ReadDirect (PlankFileRef p, const void** data, const int maximumBytes, int* bytesRead);
+
+/** Hint that a range of the file will be read soon.
+ For mapped files this starts reading the range into memory ahead of time, it 
+ does nothing for other types of file.
+ @param p The <i>Plank %File</i> object. 
+ @param position The start of the range, in bytes.
+ @param numBytes The length of the range, in bytes.
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_File_ReadAhead (PlankFileRef p, const PlankLL position, const PlankLL numBytes);
+
 /** Read one signed byte from the file.
  @param p The <i>Plank %File</i> object. 
  @param data A pointer to the memory location that will receive the data.
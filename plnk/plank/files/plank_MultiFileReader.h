@@ -36,8 +36,8 @@
  -------------------------------------------------------------------------------
  */
 
-#ifndef PLANK_IFFFILEWRITER_H
-#define PLANK_IFFFILEWRITER_H
+#ifndef PLANK_MULTIFILEREADER_H
+#define PLANK_MULTIFILEREADER_H
 
 #include "plank_File.h"
 #include "../containers/plank_DynamicArray.h"
@@ -119,4 +119,4 @@ typedef struct PlankMulitFileReader
 
 
 
-#endif // PLANK_IFFFILEWRITER_H
+#endif // PLANK_MULTIFILEREADER_H
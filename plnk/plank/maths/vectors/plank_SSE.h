@@ -0,0 +1,887 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLANK_SSE_H
+#define PLANK_SSE_H
+
+#if !DOXYGEN
+
+#ifdef PLANK_VEC_CUSTOM
+    #error only one custom vectorised libary may be specified
+#endif
+
+#define PLANK_VEC_CUSTOM
+#include <emmintrin.h>
+
+#if PLANK_VEC_AVX
+    #include <immintrin.h>
+
+    #if PLANK_WIN
+        #define PLANK_SSE_AVXTARGET
+    #else
+        #include <cpuid.h>
+        #define PLANK_SSE_AVXTARGET __attribute__ ((target ("avx")))
+    #endif
+#endif
+
+#define PLANK_SIMDF_LENGTH  4   // vector 4 floats
+#define PLANK_SIMDF_SIZE   16
+#define PLANK_SIMDF_SHIFT   2   // divide by 4 for length
+#define PLANK_SIMDF_MASK    3   // remainder mask for non-multiples of 4
+typedef __m128 PlankVF;
+
+#define PLANK_SIMDD_LENGTH  2   // vector 2 doubles
+#define PLANK_SIMDD_SIZE   16
+#define PLANK_SIMDD_SHIFT   1   // divide by 2 for length
+#define PLANK_SIMDD_MASK    1   // remainder mask for non-even lengths
+typedef __m128d PlankVD;
+
+#define PLANK_SIMDI_LENGTH  4   // vector 4 ints
+#define PLANK_SIMDI_SIZE   16
+#define PLANK_SIMDI_SHIFT   2   // divide by 4 for length
+#define PLANK_SIMDI_MASK    3   // remainder mask for non-multiples of 4
+typedef __m128i PlankVI;
+
+#define PLANK_SIMDS_LENGTH  8   // vector 8 shorts
+#define PLANK_SIMDS_SIZE   16
+#define PLANK_SIMDS_SHIFT   3   // divide by 8 for length
+#define PLANK_SIMDS_MASK    7   // remainder mask for non-multiples of 8
+typedef __m128i PlankVS;
+
+#define PLANK_SIMDLL_LENGTH  2   // vector 2 LongLongs
+#define PLANK_SIMDLL_SIZE   16
+#define PLANK_SIMDLL_SHIFT   1   // divide by 2 for length
+#define PLANK_SIMDLL_MASK    1   // remainder mask for non-even lengths
+typedef __m128i PlankVLL;
+
+//------------------------------ dispatch --------------------------------------
+
+#define PLANK_SIMDLEVEL_UNKNOWN 0
+#define PLANK_SIMDLEVEL_SSE2    1
+#define PLANK_SIMDLEVEL_AVX     2
+
+/** Query the CPU for the best instruction set we have kernels for.
+ SSE2 is the baseline on every x86 CPU we target so this only needs to 
+ check for AVX and that the OS saves the YMM registers on context switch. */
+static PLANK_INLINE_LOW int pl_VectorSIMDLevelDetect()
+{
+#if PLANK_VEC_AVX
+    unsigned int info[4] = { 0, 0, 0, 0 };
+    unsigned long long xcr0;
+    
+#if PLANK_WIN
+    __cpuid ((int*)info, 1);
+#else
+    if (! __get_cpuid (1, &info[0], &info[1], &info[2], &info[3]))
+        return PLANK_SIMDLEVEL_SSE2;
+#endif
+    
+    // need both AVX (bit 28) and OSXSAVE (bit 27)
+    if ((info[2] & 0x18000000) != 0x18000000)
+        return PLANK_SIMDLEVEL_SSE2;
+    
+#if PLANK_WIN
+    xcr0 = _xgetbv (0);
+#else
+    {
+        unsigned int lo, hi;
+        __asm__ __volatile__ ("xgetbv" : "=a" (lo), "=d" (hi) : "c" (0));
+        xcr0 = ((unsigned long long)hi << 32) | lo;
+    }
+#endif
+
+    return ((xcr0 & 0x6) == 0x6) ? PLANK_SIMDLEVEL_AVX : PLANK_SIMDLEVEL_SSE2;
+#else
+    return PLANK_SIMDLEVEL_SSE2;
+#endif
+}
+
+/** Returns the SIMD level used by the vector functions.
+ The result is cached after the first call. Racing threads will all store the
+ same value so no synchronisation is needed. */
+static PLANK_INLINE_LOW int pl_VectorSIMDLevel()
+{
+    static int level = PLANK_SIMDLEVEL_UNKNOWN;
+    
+    if (level == PLANK_SIMDLEVEL_UNKNOWN)
+        level = pl_VectorSIMDLevelDetect();
+    
+    return level;
+}
+
+#if PLANK_VEC_AVX
+    #define PLANK_SSE_AVXDISPATCH(CALL) if (pl_VectorSIMDLevel() >= PLANK_SIMDLEVEL_AVX) { CALL; }
+    #define PLANK_SSE_AVXONLY(CODE) CODE
+#else
+    #define PLANK_SSE_AVXDISPATCH(CALL)
+    #define PLANK_SSE_AVXONLY(CODE)
+#endif
+
+//------------------------------ kernels ---------------------------------------
+
+// Each kernel is written once per register width and the loop macros below
+// stamp out the vector functions. The AVX loops return the number of items
+// they processed so the SSE loop and a scalar tail can finish the remainder.
+
+static PLANK_INLINE_HIGH __m128 pl_SSEOneF()                        { return _mm_set1_ps (1.f); }
+static PLANK_INLINE_HIGH __m128 pl_SSESignMaskF()                   { return _mm_set1_ps (-0.f); }
+static PLANK_INLINE_HIGH __m128d pl_SSEOneD()                       { return _mm_set1_pd (1.0); }
+static PLANK_INLINE_HIGH __m128d pl_SSESignMaskD()                  { return _mm_set1_pd (-0.0); }
+
+static PLANK_INLINE_HIGH __m128 pl_SSEMoveF (__m128 a)              { return a; }
+static PLANK_INLINE_HIGH __m128 pl_SSEIncF (__m128 a)               { return _mm_add_ps (a, pl_SSEOneF()); }
+static PLANK_INLINE_HIGH __m128 pl_SSEDecF (__m128 a)               { return _mm_sub_ps (a, pl_SSEOneF()); }
+static PLANK_INLINE_HIGH __m128 pl_SSENegF (__m128 a)               { return _mm_xor_ps (a, pl_SSESignMaskF()); }
+static PLANK_INLINE_HIGH __m128 pl_SSEAbsF (__m128 a)               { return _mm_andnot_ps (pl_SSESignMaskF(), a); }
+static PLANK_INLINE_HIGH __m128 pl_SSESquaredF (__m128 a)           { return _mm_mul_ps (a, a); }
+static PLANK_INLINE_HIGH __m128 pl_SSECubedF (__m128 a)             { return _mm_mul_ps (_mm_mul_ps (a, a), a); }
+static PLANK_INLINE_HIGH __m128 pl_SSEReciprocalF (__m128 a)        { return _mm_div_ps (pl_SSEOneF(), a); }
+static PLANK_INLINE_HIGH __m128 pl_SSESqrtF (__m128 a)              { return _mm_sqrt_ps (a); }
+static PLANK_INLINE_HIGH __m128 pl_SSESignF (__m128 a)
+{
+    const __m128 zero = _mm_setzero_ps();
+    return _mm_sub_ps (_mm_and_ps (_mm_cmpgt_ps (a, zero), pl_SSEOneF()),
+                       _mm_and_ps (_mm_cmplt_ps (a, zero), pl_SSEOneF()));
+}
+
+static PLANK_INLINE_HIGH __m128 pl_SSEAddF (__m128 a, __m128 b)                     { return _mm_add_ps (a, b); }
+static PLANK_INLINE_HIGH __m128 pl_SSESubF (__m128 a, __m128 b)                     { return _mm_sub_ps (a, b); }
+static PLANK_INLINE_HIGH __m128 pl_SSEMulF (__m128 a, __m128 b)                     { return _mm_mul_ps (a, b); }
+static PLANK_INLINE_HIGH __m128 pl_SSEDivF (__m128 a, __m128 b)                     { return _mm_div_ps (a, b); }
+static PLANK_INLINE_HIGH __m128 pl_SSEMinF (__m128 a, __m128 b)                     { return _mm_min_ps (b, a); } // matches (a > b) ? b : a
+static PLANK_INLINE_HIGH __m128 pl_SSEMaxF (__m128 a, __m128 b)                     { return _mm_max_ps (b, a); } // matches (a < b) ? b : a
+static PLANK_INLINE_HIGH __m128 pl_SSEIsEqualToF (__m128 a, __m128 b)               { return _mm_and_ps (_mm_cmpeq_ps (a, b), pl_SSEOneF()); }
+static PLANK_INLINE_HIGH __m128 pl_SSEIsNotEqualToF (__m128 a, __m128 b)            { return _mm_and_ps (_mm_cmpneq_ps (a, b), pl_SSEOneF()); }
+static PLANK_INLINE_HIGH __m128 pl_SSEIsGreaterThanF (__m128 a, __m128 b)           { return _mm_and_ps (_mm_cmpgt_ps (a, b), pl_SSEOneF()); }
+static PLANK_INLINE_HIGH __m128 pl_SSEIsGreaterThanOrEqualToF (__m128 a, __m128 b)  { return _mm_and_ps (_mm_cmpge_ps (a, b), pl_SSEOneF()); }
+static PLANK_INLINE_HIGH __m128 pl_SSEIsLessThanF (__m128 a, __m128 b)              { return _mm_and_ps (_mm_cmplt_ps (a, b), pl_SSEOneF()); }
+static PLANK_INLINE_HIGH __m128 pl_SSEIsLessThanOrEqualToF (__m128 a, __m128 b)     { return _mm_and_ps (_mm_cmple_ps (a, b), pl_SSEOneF()); }
+static PLANK_INLINE_HIGH __m128 pl_SSESumSqrF (__m128 a, __m128 b)                  { return _mm_add_ps (_mm_mul_ps (a, a), _mm_mul_ps (b, b)); }
+static PLANK_INLINE_HIGH __m128 pl_SSEDifSqrF (__m128 a, __m128 b)                  { return _mm_sub_ps (_mm_mul_ps (a, a), _mm_mul_ps (b, b)); }
+static PLANK_INLINE_HIGH __m128 pl_SSESqrSumF (__m128 a, __m128 b)                  { a = _mm_add_ps (a, b); return _mm_mul_ps (a, a); }
+static PLANK_INLINE_HIGH __m128 pl_SSESqrDifF (__m128 a, __m128 b)                  { a = _mm_sub_ps (a, b); return _mm_mul_ps (a, a); }
+static PLANK_INLINE_HIGH __m128 pl_SSEAbsDifF (__m128 a, __m128 b)                  { return pl_SSEAbsF (_mm_sub_ps (a, b)); }
+static PLANK_INLINE_HIGH __m128 pl_SSEThreshF (__m128 a, __m128 b)                  { return _mm_andnot_ps (_mm_cmplt_ps (a, b), a); }
+
+static PLANK_INLINE_HIGH __m128d pl_SSEMoveD (__m128d a)            { return a; }
+static PLANK_INLINE_HIGH __m128d pl_SSEIncD (__m128d a)             { return _mm_add_pd (a, pl_SSEOneD()); }
+static PLANK_INLINE_HIGH __m128d pl_SSEDecD (__m128d a)             { return _mm_sub_pd (a, pl_SSEOneD()); }
+static PLANK_INLINE_HIGH __m128d pl_SSENegD (__m128d a)             { return _mm_xor_pd (a, pl_SSESignMaskD()); }
+static PLANK_INLINE_HIGH __m128d pl_SSEAbsD (__m128d a)             { return _mm_andnot_pd (pl_SSESignMaskD(), a); }
+static PLANK_INLINE_HIGH __m128d pl_SSESquaredD (__m128d a)         { return _mm_mul_pd (a, a); }
+static PLANK_INLINE_HIGH __m128d pl_SSECubedD (__m128d a)           { return _mm_mul_pd (_mm_mul_pd (a, a), a); }
+static PLANK_INLINE_HIGH __m128d pl_SSEReciprocalD (__m128d a)      { return _mm_div_pd (pl_SSEOneD(), a); }
+static PLANK_INLINE_HIGH __m128d pl_SSESqrtD (__m128d a)            { return _mm_sqrt_pd (a); }
+static PLANK_INLINE_HIGH __m128d pl_SSESignD (__m128d a)
+{
+    const __m128d zero = _mm_setzero_pd();
+    return _mm_sub_pd (_mm_and_pd (_mm_cmpgt_pd (a, zero), pl_SSEOneD()),
+                       _mm_and_pd (_mm_cmplt_pd (a, zero), pl_SSEOneD()));
+}
+
+static PLANK_INLINE_HIGH __m128d pl_SSEAddD (__m128d a, __m128d b)                      { return _mm_add_pd (a, b); }
+static PLANK_INLINE_HIGH __m128d pl_SSESubD (__m128d a, __m128d b)                      { return _mm_sub_pd (a, b); }
+static PLANK_INLINE_HIGH __m128d pl_SSEMulD (__m128d a, __m128d b)                      { return _mm_mul_pd (a, b); }
+static PLANK_INLINE_HIGH __m128d pl_SSEDivD (__m128d a, __m128d b)                      { return _mm_div_pd (a, b); }
+static PLANK_INLINE_HIGH __m128d pl_SSEMinD (__m128d a, __m128d b)                      { return _mm_min_pd (b, a); }
+static PLANK_INLINE_HIGH __m128d pl_SSEMaxD (__m128d a, __m128d b)                      { return _mm_max_pd (b, a); }
+static PLANK_INLINE_HIGH __m128d pl_SSEIsEqualToD (__m128d a, __m128d b)                { return _mm_and_pd (_mm_cmpeq_pd (a, b), pl_SSEOneD()); }
+static PLANK_INLINE_HIGH __m128d pl_SSEIsNotEqualToD (__m128d a, __m128d b)             { return _mm_and_pd (_mm_cmpneq_pd (a, b), pl_SSEOneD()); }
+static PLANK_INLINE_HIGH __m128d pl_SSEIsGreaterThanD (__m128d a, __m128d b)            { return _mm_and_pd (_mm_cmpgt_pd (a, b), pl_SSEOneD()); }
+static PLANK_INLINE_HIGH __m128d pl_SSEIsGreaterThanOrEqualToD (__m128d a, __m128d b)   { return _mm_and_pd (_mm_cmpge_pd (a, b), pl_SSEOneD()); }
+static PLANK_INLINE_HIGH __m128d pl_SSEIsLessThanD (__m128d a, __m128d b)               { return _mm_and_pd (_mm_cmplt_pd (a, b), pl_SSEOneD()); }
+static PLANK_INLINE_HIGH __m128d pl_SSEIsLessThanOrEqualToD (__m128d a, __m128d b)      { return _mm_and_pd (_mm_cmple_pd (a, b), pl_SSEOneD()); }
+static PLANK_INLINE_HIGH __m128d pl_SSESumSqrD (__m128d a, __m128d b)                   { return _mm_add_pd (_mm_mul_pd (a, a), _mm_mul_pd (b, b)); }
+static PLANK_INLINE_HIGH __m128d pl_SSEDifSqrD (__m128d a, __m128d b)                   { return _mm_sub_pd (_mm_mul_pd (a, a), _mm_mul_pd (b, b)); }
+static PLANK_INLINE_HIGH __m128d pl_SSESqrSumD (__m128d a, __m128d b)                   { a = _mm_add_pd (a, b); return _mm_mul_pd (a, a); }
+static PLANK_INLINE_HIGH __m128d pl_SSESqrDifD (__m128d a, __m128d b)                   { a = _mm_sub_pd (a, b); return _mm_mul_pd (a, a); }
+static PLANK_INLINE_HIGH __m128d pl_SSEAbsDifD (__m128d a, __m128d b)                   { return pl_SSEAbsD (_mm_sub_pd (a, b)); }
+static PLANK_INLINE_HIGH __m128d pl_SSEThreshD (__m128d a, __m128d b)                   { return _mm_andnot_pd (_mm_cmplt_pd (a, b), a); }
+
+#if PLANK_VEC_AVX
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXOneF()                    { return _mm256_set1_ps (1.f); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXSignMaskF()               { return _mm256_set1_ps (-0.f); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXOneD()                   { return _mm256_set1_pd (1.0); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXSignMaskD()              { return _mm256_set1_pd (-0.0); }
+
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXMoveF (__m256 a)          { return a; }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXIncF (__m256 a)           { return _mm256_add_ps (a, pl_AVXOneF()); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXDecF (__m256 a)           { return _mm256_sub_ps (a, pl_AVXOneF()); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXNegF (__m256 a)           { return _mm256_xor_ps (a, pl_AVXSignMaskF()); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXAbsF (__m256 a)           { return _mm256_andnot_ps (pl_AVXSignMaskF(), a); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXSquaredF (__m256 a)       { return _mm256_mul_ps (a, a); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXCubedF (__m256 a)         { return _mm256_mul_ps (_mm256_mul_ps (a, a), a); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXReciprocalF (__m256 a)    { return _mm256_div_ps (pl_AVXOneF(), a); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXSqrtF (__m256 a)          { return _mm256_sqrt_ps (a); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXSignF (__m256 a)
+{
+    const __m256 zero = _mm256_setzero_ps();
+    return _mm256_sub_ps (_mm256_and_ps (_mm256_cmp_ps (a, zero, _CMP_GT_OQ), pl_AVXOneF()),
+                          _mm256_and_ps (_mm256_cmp_ps (a, zero, _CMP_LT_OQ), pl_AVXOneF()));
+}
+
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXAddF (__m256 a, __m256 b)                     { return _mm256_add_ps (a, b); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXSubF (__m256 a, __m256 b)                     { return _mm256_sub_ps (a, b); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXMulF (__m256 a, __m256 b)                     { return _mm256_mul_ps (a, b); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXDivF (__m256 a, __m256 b)                     { return _mm256_div_ps (a, b); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXMinF (__m256 a, __m256 b)                     { return _mm256_min_ps (b, a); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXMaxF (__m256 a, __m256 b)                     { return _mm256_max_ps (b, a); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXIsEqualToF (__m256 a, __m256 b)               { return _mm256_and_ps (_mm256_cmp_ps (a, b, _CMP_EQ_OQ), pl_AVXOneF()); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXIsNotEqualToF (__m256 a, __m256 b)            { return _mm256_and_ps (_mm256_cmp_ps (a, b, _CMP_NEQ_UQ), pl_AVXOneF()); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXIsGreaterThanF (__m256 a, __m256 b)           { return _mm256_and_ps (_mm256_cmp_ps (a, b, _CMP_GT_OQ), pl_AVXOneF()); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXIsGreaterThanOrEqualToF (__m256 a, __m256 b)  { return _mm256_and_ps (_mm256_cmp_ps (a, b, _CMP_GE_OQ), pl_AVXOneF()); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXIsLessThanF (__m256 a, __m256 b)              { return _mm256_and_ps (_mm256_cmp_ps (a, b, _CMP_LT_OQ), pl_AVXOneF()); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXIsLessThanOrEqualToF (__m256 a, __m256 b)     { return _mm256_and_ps (_mm256_cmp_ps (a, b, _CMP_LE_OQ), pl_AVXOneF()); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXSumSqrF (__m256 a, __m256 b)                  { return _mm256_add_ps (_mm256_mul_ps (a, a), _mm256_mul_ps (b, b)); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXDifSqrF (__m256 a, __m256 b)                  { return _mm256_sub_ps (_mm256_mul_ps (a, a), _mm256_mul_ps (b, b)); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXSqrSumF (__m256 a, __m256 b)                  { a = _mm256_add_ps (a, b); return _mm256_mul_ps (a, a); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXSqrDifF (__m256 a, __m256 b)                  { a = _mm256_sub_ps (a, b); return _mm256_mul_ps (a, a); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXAbsDifF (__m256 a, __m256 b)                  { return pl_AVXAbsF (_mm256_sub_ps (a, b)); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256 pl_AVXThreshF (__m256 a, __m256 b)                  { return _mm256_andnot_ps (_mm256_cmp_ps (a, b, _CMP_LT_OQ), a); }
+
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXMoveD (__m256d a)        { return a; }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXIncD (__m256d a)         { return _mm256_add_pd (a, pl_AVXOneD()); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXDecD (__m256d a)         { return _mm256_sub_pd (a, pl_AVXOneD()); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXNegD (__m256d a)         { return _mm256_xor_pd (a, pl_AVXSignMaskD()); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXAbsD (__m256d a)         { return _mm256_andnot_pd (pl_AVXSignMaskD(), a); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXSquaredD (__m256d a)     { return _mm256_mul_pd (a, a); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXCubedD (__m256d a)       { return _mm256_mul_pd (_mm256_mul_pd (a, a), a); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXReciprocalD (__m256d a)  { return _mm256_div_pd (pl_AVXOneD(), a); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXSqrtD (__m256d a)        { return _mm256_sqrt_pd (a); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXSignD (__m256d a)
+{
+    const __m256d zero = _mm256_setzero_pd();
+    return _mm256_sub_pd (_mm256_and_pd (_mm256_cmp_pd (a, zero, _CMP_GT_OQ), pl_AVXOneD()),
+                          _mm256_and_pd (_mm256_cmp_pd (a, zero, _CMP_LT_OQ), pl_AVXOneD()));
+}
+
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXAddD (__m256d a, __m256d b)                      { return _mm256_add_pd (a, b); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXSubD (__m256d a, __m256d b)                      { return _mm256_sub_pd (a, b); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXMulD (__m256d a, __m256d b)                      { return _mm256_mul_pd (a, b); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXDivD (__m256d a, __m256d b)                      { return _mm256_div_pd (a, b); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXMinD (__m256d a, __m256d b)                      { return _mm256_min_pd (b, a); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXMaxD (__m256d a, __m256d b)                      { return _mm256_max_pd (b, a); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXIsEqualToD (__m256d a, __m256d b)                { return _mm256_and_pd (_mm256_cmp_pd (a, b, _CMP_EQ_OQ), pl_AVXOneD()); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXIsNotEqualToD (__m256d a, __m256d b)             { return _mm256_and_pd (_mm256_cmp_pd (a, b, _CMP_NEQ_UQ), pl_AVXOneD()); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXIsGreaterThanD (__m256d a, __m256d b)            { return _mm256_and_pd (_mm256_cmp_pd (a, b, _CMP_GT_OQ), pl_AVXOneD()); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXIsGreaterThanOrEqualToD (__m256d a, __m256d b)   { return _mm256_and_pd (_mm256_cmp_pd (a, b, _CMP_GE_OQ), pl_AVXOneD()); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXIsLessThanD (__m256d a, __m256d b)               { return _mm256_and_pd (_mm256_cmp_pd (a, b, _CMP_LT_OQ), pl_AVXOneD()); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXIsLessThanOrEqualToD (__m256d a, __m256d b)      { return _mm256_and_pd (_mm256_cmp_pd (a, b, _CMP_LE_OQ), pl_AVXOneD()); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXSumSqrD (__m256d a, __m256d b)                   { return _mm256_add_pd (_mm256_mul_pd (a, a), _mm256_mul_pd (b, b)); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXDifSqrD (__m256d a, __m256d b)                   { return _mm256_sub_pd (_mm256_mul_pd (a, a), _mm256_mul_pd (b, b)); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXSqrSumD (__m256d a, __m256d b)                   { a = _mm256_add_pd (a, b); return _mm256_mul_pd (a, a); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXSqrDifD (__m256d a, __m256d b)                   { a = _mm256_sub_pd (a, b); return _mm256_mul_pd (a, a); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXAbsDifD (__m256d a, __m256d b)                   { return pl_AVXAbsD (_mm256_sub_pd (a, b)); }
+static PLANK_SSE_AVXTARGET PLANK_INLINE_HIGH __m256d pl_AVXThreshD (__m256d a, __m256d b)                   { return _mm256_andnot_pd (_mm256_cmp_pd (a, b, _CMP_LT_OQ), a); }
+#endif // PLANK_VEC_AVX
+
+//------------------------------ loop macros -----------------------------------
+
+// The loop macros take the type code, scalar type, then the SSE register type, 
+// load, store, splat and lane count followed by the same for AVX.
+#define PLANK_SSE_ARGSF float, __m128, _mm_loadu_ps, _mm_storeu_ps, _mm_set1_ps, 4, __m256, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_set1_ps, 8
+#define PLANK_SSE_ARGSD double, __m128d, _mm_loadu_pd, _mm_storeu_pd, _mm_set1_pd, 2, __m256d, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd, 4
+#define PLANK_SSE_APPLY(MACRO,ARGS) MACRO ARGS
+
+#define PLANK_SSE_UNARYOP_DEFINE(OP,TYPECODE,TYPE,V,LD,ST,SET1,W,AV,ALD,AST,ASET1,AW) \
+    PLANK_SSE_AVXONLY(\
+    static PLANK_SSE_AVXTARGET PLANK_INLINE_LOW PlankUL pl_VectorAVX##OP##TYPECODE##_NN (TYPE *result, const TYPE* a, PlankUL N) {\
+        PlankUL i; for (i = 0; i + AW <= N; i += AW) { AST (result + i, pl_AVX##OP##TYPECODE (ALD (a + i))); }\
+        _mm256_zeroupper(); return i;\
+    })\
+    static PLANK_INLINE_LOW void pl_Vector##OP##TYPECODE##_NN (TYPE *result, const TYPE* a, PlankUL N) {\
+        PlankUL i = 0;\
+        PLANK_SSE_AVXDISPATCH(i = pl_VectorAVX##OP##TYPECODE##_NN (result, a, N))\
+        for (; i + W <= N; i += W) { ST (result + i, pl_SSE##OP##TYPECODE (LD (a + i))); }\
+        for (; i < N; PLANK_INC (i)) { result[i] = pl_##OP##TYPECODE (a[i]); }\
+    }
+
+#define PLANK_SSE_BINARYOP_DEFINE(OP,TYPECODE,TYPE,V,LD,ST,SET1,W,AV,ALD,AST,ASET1,AW) \
+    PLANK_SSE_AVXONLY(\
+    static PLANK_SSE_AVXTARGET PLANK_INLINE_LOW PlankUL pl_VectorAVX##OP##TYPECODE##_NNN (TYPE *result, const TYPE* a, const TYPE* b, PlankUL N) {\
+        PlankUL i; for (i = 0; i + AW <= N; i += AW) { AST (result + i, pl_AVX##OP##TYPECODE (ALD (a + i), ALD (b + i))); }\
+        _mm256_zeroupper(); return i;\
+    }\
+    static PLANK_SSE_AVXTARGET PLANK_INLINE_LOW PlankUL pl_VectorAVX##OP##TYPECODE##_NN1 (TYPE *result, const TYPE* a, TYPE b, PlankUL N) {\
+        const AV vb = ASET1 (b);\
+        PlankUL i; for (i = 0; i + AW <= N; i += AW) { AST (result + i, pl_AVX##OP##TYPECODE (ALD (a + i), vb)); }\
+        _mm256_zeroupper(); return i;\
+    }\
+    static PLANK_SSE_AVXTARGET PLANK_INLINE_LOW PlankUL pl_VectorAVX##OP##TYPECODE##_N1N (TYPE *result, TYPE a, const TYPE* b, PlankUL N) {\
+        const AV va = ASET1 (a);\
+        PlankUL i; for (i = 0; i + AW <= N; i += AW) { AST (result + i, pl_AVX##OP##TYPECODE (va, ALD (b + i))); }\
+        _mm256_zeroupper(); return i;\
+    })\
+    static PLANK_INLINE_LOW void pl_Vector##OP##TYPECODE##_NNN (TYPE *result, const TYPE* a, const TYPE* b, PlankUL N) {\
+        PlankUL i = 0;\
+        PLANK_SSE_AVXDISPATCH(i = pl_VectorAVX##OP##TYPECODE##_NNN (result, a, b, N))\
+        for (; i + W <= N; i += W) { ST (result + i, pl_SSE##OP##TYPECODE (LD (a + i), LD (b + i))); }\
+        for (; i < N; PLANK_INC (i)) { result[i] = pl_##OP##TYPECODE (a[i], b[i]); }\
+    }\
+    static PLANK_INLINE_LOW void pl_Vector##OP##TYPECODE##_NN1 (TYPE *result, const TYPE* a, TYPE b, PlankUL N) {\
+        const V vb = SET1 (b);\
+        PlankUL i = 0;\
+        PLANK_SSE_AVXDISPATCH(i = pl_VectorAVX##OP##TYPECODE##_NN1 (result, a, b, N))\
+        for (; i + W <= N; i += W) { ST (result + i, pl_SSE##OP##TYPECODE (LD (a + i), vb)); }\
+        for (; i < N; PLANK_INC (i)) { result[i] = pl_##OP##TYPECODE (a[i], b); }\
+    }\
+    static PLANK_INLINE_LOW void pl_Vector##OP##TYPECODE##_N1N (TYPE *result, TYPE a, const TYPE* b, PlankUL N) {\
+        const V va = SET1 (a);\
+        PlankUL i = 0;\
+        PLANK_SSE_AVXDISPATCH(i = pl_VectorAVX##OP##TYPECODE##_N1N (result, a, b, N))\
+        for (; i + W <= N; i += W) { ST (result + i, pl_SSE##OP##TYPECODE (va, LD (b + i))); }\
+        for (; i < N; PLANK_INC (i)) { result[i] = pl_##OP##TYPECODE (a, b[i]); }\
+    }
+
+// ...and the multiply-add variants: 
+// _NNNN = in * mul[] + add[], _NNN = io * mul[] + add[], _NNN1 = in * mul[] + add, 
+// _NN11 = in * mul + add, _NN1N = in * mul + add[]
+#define PLANK_SSE_MULADD_DEFINE(TYPECODE,TYPE,V,LD,ST,SET1,W,AV,ALD,AST,ASET1,AW) \
+    PLANK_SSE_AVXONLY(\
+    static PLANK_SSE_AVXTARGET PLANK_INLINE_LOW PlankUL pl_VectorAVXMulAdd##TYPECODE##_NNNN (TYPE *result, const TYPE* input, const TYPE* mul, const TYPE* add, PlankUL N) {\
+        PlankUL i; for (i = 0; i + AW <= N; i += AW) { AST (result + i, pl_AVXAdd##TYPECODE (pl_AVXMul##TYPECODE (ALD (input + i), ALD (mul + i)), ALD (add + i))); }\
+        _mm256_zeroupper(); return i;\
+    }\
+    static PLANK_SSE_AVXTARGET PLANK_INLINE_LOW PlankUL pl_VectorAVXMulAdd##TYPECODE##_NNN1 (TYPE *result, const TYPE* input, const TYPE* mul, TYPE add, PlankUL N) {\
+        const AV vadd = ASET1 (add);\
+        PlankUL i; for (i = 0; i + AW <= N; i += AW) { AST (result + i, pl_AVXAdd##TYPECODE (pl_AVXMul##TYPECODE (ALD (input + i), ALD (mul + i)), vadd)); }\
+        _mm256_zeroupper(); return i;\
+    }\
+    static PLANK_SSE_AVXTARGET PLANK_INLINE_LOW PlankUL pl_VectorAVXMulAdd##TYPECODE##_NN11 (TYPE *result, const TYPE* input, TYPE mul, TYPE add, PlankUL N) {\
+        const AV vmul = ASET1 (mul);\
+        const AV vadd = ASET1 (add);\
+        PlankUL i; for (i = 0; i + AW <= N; i += AW) { AST (result + i, pl_AVXAdd##TYPECODE (pl_AVXMul##TYPECODE (ALD (input + i), vmul), vadd)); }\
+        _mm256_zeroupper(); return i;\
+    }\
+    static PLANK_SSE_AVXTARGET PLANK_INLINE_LOW PlankUL pl_VectorAVXMulAdd##TYPECODE##_NN1N (TYPE *result, const TYPE* input, TYPE mul, const TYPE* add, PlankUL N) {\
+        const AV vmul = ASET1 (mul);\
+        PlankUL i; for (i = 0; i + AW <= N; i += AW) { AST (result + i, pl_AVXAdd##TYPECODE (pl_AVXMul##TYPECODE (ALD (input + i), vmul), ALD (add + i))); }\
+        _mm256_zeroupper(); return i;\
+    })\
+    static PLANK_INLINE_LOW void pl_VectorMulAdd##TYPECODE##_NNNN (TYPE *result, const TYPE* input, const TYPE* mul, const TYPE* add, PlankUL N) {\
+        PlankUL i = 0;\
+        PLANK_SSE_AVXDISPATCH(i = pl_VectorAVXMulAdd##TYPECODE##_NNNN (result, input, mul, add, N))\
+        for (; i + W <= N; i += W) { ST (result + i, pl_SSEAdd##TYPECODE (pl_SSEMul##TYPECODE (LD (input + i), LD (mul + i)), LD (add + i))); }\
+        for (; i < N; PLANK_INC (i)) { result[i] = pl_Add##TYPECODE (pl_Mul##TYPECODE (input[i], mul[i]), add[i]); }\
+    }\
+    static PLANK_INLINE_LOW void pl_VectorMulAdd##TYPECODE##_NNN (TYPE *io, const TYPE* mul, const TYPE* add, PlankUL N) {\
+        pl_VectorMulAdd##TYPECODE##_NNNN (io, io, mul, add, N);\
+    }\
+    static PLANK_INLINE_LOW void pl_VectorMulAdd##TYPECODE##_NNN1 (TYPE *result, const TYPE* input, const TYPE* mul, TYPE add, PlankUL N) {\
+        const V vadd = SET1 (add);\
+        PlankUL i = 0;\
+        PLANK_SSE_AVXDISPATCH(i = pl_VectorAVXMulAdd##TYPECODE##_NNN1 (result, input, mul, add, N))\
+        for (; i + W <= N; i += W) { ST (result + i, pl_SSEAdd##TYPECODE (pl_SSEMul##TYPECODE (LD (input + i), LD (mul + i)), vadd)); }\
+        for (; i < N; PLANK_INC (i)) { result[i] = pl_Add##TYPECODE (pl_Mul##TYPECODE (input[i], mul[i]), add); }\
+    }\
+    static PLANK_INLINE_LOW void pl_VectorMulAdd##TYPECODE##_NN11 (TYPE *result, const TYPE* input, TYPE mul, TYPE add, PlankUL N) {\
+        const V vmul = SET1 (mul);\
+        const V vadd = SET1 (add);\
+        PlankUL i = 0;\
+        PLANK_SSE_AVXDISPATCH(i = pl_VectorAVXMulAdd##TYPECODE##_NN11 (result, input, mul, add, N))\
+        for (; i + W <= N; i += W) { ST (result + i, pl_SSEAdd##TYPECODE (pl_SSEMul##TYPECODE (LD (input + i), vmul), vadd)); }\
+        for (; i < N; PLANK_INC (i)) { result[i] = pl_Add##TYPECODE (pl_Mul##TYPECODE (input[i], mul), add); }\
+    }\
+    static PLANK_INLINE_LOW void pl_VectorMulAdd##TYPECODE##_NN1N (TYPE *result, const TYPE* input, TYPE mul, const TYPE* add, PlankUL N) {\
+        const V vmul = SET1 (mul);\
+        PlankUL i = 0;\
+        PLANK_SSE_AVXDISPATCH(i = pl_VectorAVXMulAdd##TYPECODE##_NN1N (result, input, mul, add, N))\
+        for (; i + W <= N; i += W) { ST (result + i, pl_SSEAdd##TYPECODE (pl_SSEMul##TYPECODE (LD (input + i), vmul), LD (add + i))); }\
+        for (; i < N; PLANK_INC (i)) { result[i] = pl_Add##TYPECODE (pl_Mul##TYPECODE (input[i], mul), add[i]); }\
+    }
+
+#define PLANK_SSE_ZMUL_DEFINE(TYPECODE,TYPE,V,LD,ST,SET1,W,AV,ALD,AST,ASET1,AW) \
+    PLANK_SSE_AVXONLY(\
+    static PLANK_SSE_AVXTARGET PLANK_INLINE_LOW PlankUL pl_VectorAVXZMul##TYPECODE##_ZNNNNN (TYPE *resultReal, TYPE *resultImag,\
+                                                                                          const TYPE* leftReal, const TYPE* leftImag,\
+                                                                                          const TYPE* rightReal, const TYPE* rightImag,\
+                                                                                          PlankUL N) {\
+        PlankUL i;\
+        for (i = 0; i + AW <= N; i += AW) {\
+            const AV lr = ALD (leftReal + i);  const AV li = ALD (leftImag + i);\
+            const AV rr = ALD (rightReal + i); const AV ri = ALD (rightImag + i);\
+            AST (resultReal + i, pl_AVXSub##TYPECODE (pl_AVXMul##TYPECODE (lr, rr), pl_AVXMul##TYPECODE (li, ri)));\
+            AST (resultImag + i, pl_AVXAdd##TYPECODE (pl_AVXMul##TYPECODE (lr, ri), pl_AVXMul##TYPECODE (li, rr)));\
+        }\
+        _mm256_zeroupper(); return i;\
+    })\
+    static PLANK_INLINE_LOW void pl_VectorZMul##TYPECODE##_ZNNNNN (TYPE *resultReal, TYPE *resultImag,\
+                                                                 const TYPE* leftReal, const TYPE* leftImag,\
+                                                                 const TYPE* rightReal, const TYPE* rightImag,\
+                                                                 PlankUL N) {\
+        PlankUL i = 0;\
+        PLANK_SSE_AVXDISPATCH(i = pl_VectorAVXZMul##TYPECODE##_ZNNNNN (resultReal, resultImag, leftReal, leftImag, rightReal, rightImag, N))\
+        for (; i + W <= N; i += W) {\
+            const V lr = LD (leftReal + i);  const V li = LD (leftImag + i);\
+            const V rr = LD (rightReal + i); const V ri = LD (rightImag + i);\
+            ST (resultReal + i, pl_SSESub##TYPECODE (pl_SSEMul##TYPECODE (lr, rr), pl_SSEMul##TYPECODE (li, ri)));\
+            ST (resultImag + i, pl_SSEAdd##TYPECODE (pl_SSEMul##TYPECODE (lr, ri), pl_SSEMul##TYPECODE (li, rr)));\
+        }\
+        for (; i < N; PLANK_INC (i)) {\
+            const TYPE lr = leftReal[i]; const TYPE li = leftImag[i];\
+            resultReal[i] = lr * rightReal[i] - li * rightImag[i];\
+            resultImag[i] = lr * rightImag[i] + li * rightReal[i];\
+        }\
+    }
+
+#define PLANK_SSE_FILL_DEFINE(TYPECODE,TYPE,V,LD,ST,SET1,W,AV,ALD,AST,ASET1,AW) \
+    static PLANK_INLINE_LOW void pl_VectorFill##TYPECODE##_N1 (TYPE *result, TYPE value, PlankUL N) {\
+        const V v = SET1 (value);\
+        PlankUL i; for (i = 0; i + W <= N; i += W) { ST (result + i, v); }\
+        for (; i < N; PLANK_INC (i)) { result[i] = value; }\
+    }\
+    static PLANK_INLINE_LOW void pl_VectorClear##TYPECODE##_N (TYPE *result, PlankUL N) {\
+        pl_VectorFill##TYPECODE##_N1 (result, (TYPE)0, N);\
+    }
+
+#define PLANK_SSE_UNARYOPF_DEFINE(OP)   PLANK_SSE_APPLY(PLANK_SSE_UNARYOP_DEFINE,(OP,F,PLANK_SSE_ARGSF))
+#define PLANK_SSE_UNARYOPD_DEFINE(OP)   PLANK_SSE_APPLY(PLANK_SSE_UNARYOP_DEFINE,(OP,D,PLANK_SSE_ARGSD))
+#define PLANK_SSE_BINARYOPF_DEFINE(OP)  PLANK_SSE_APPLY(PLANK_SSE_BINARYOP_DEFINE,(OP,F,PLANK_SSE_ARGSF))
+#define PLANK_SSE_BINARYOPD_DEFINE(OP)  PLANK_SSE_APPLY(PLANK_SSE_BINARYOP_DEFINE,(OP,D,PLANK_SSE_ARGSD))
+
+
+//------------------------------- float ----------------------------------------
+
+PLANK_SSE_APPLY(PLANK_SSE_FILL_DEFINE,(F,PLANK_SSE_ARGSF))
+
+static PLANK_INLINE_LOW void pl_VectorRampF_N11 (float *result, float a, float b, PlankUL N)
+{
+    const __m128 step = _mm_set1_ps (b * 4.f);
+    __m128 v = _mm_add_ps (_mm_set1_ps (a), _mm_mul_ps (_mm_set_ps (3.f, 2.f, 1.f, 0.f), _mm_set1_ps (b)));
+    PlankUL i;
+    
+    for (i = 0; i + 4 <= N; i += 4)
+    {
+        _mm_storeu_ps (result + i, v);
+        v = _mm_add_ps (v, step);
+    }
+    
+    for (; i < N; PLANK_INC (i))
+        result[i] = a + (float)i * b;
+}
+
+PLANK_VECTORLINE_DEFINE(F)
+
+PLANK_SSE_UNARYOPF_DEFINE(Move)
+PLANK_SSE_UNARYOPF_DEFINE(Inc)
+PLANK_SSE_UNARYOPF_DEFINE(Dec)
+PLANK_SSE_UNARYOPF_DEFINE(Neg)
+PLANK_SSE_UNARYOPF_DEFINE(Abs)
+PLANK_SSE_UNARYOPF_DEFINE(Squared)
+PLANK_SSE_UNARYOPF_DEFINE(Cubed)
+PLANK_SSE_UNARYOPF_DEFINE(Sign)
+PLANK_SSE_UNARYOPF_DEFINE(Reciprocal)
+PLANK_SSE_UNARYOPF_DEFINE(Sqrt)
+
+PLANK_VECTORUNARYOP_DEFINE(Log2,F)
+PLANK_VECTORUNARYOP_DEFINE(Sin,F)
+PLANK_VECTORUNARYOP_DEFINE(Cos,F)
+PLANK_VECTORUNARYOP_DEFINE(Tan,F)
+PLANK_VECTORUNARYOP_DEFINE(Asin,F)
+PLANK_VECTORUNARYOP_DEFINE(Acos,F)
+PLANK_VECTORUNARYOP_DEFINE(Atan,F)
+PLANK_VECTORUNARYOP_DEFINE(Sinh,F)
+PLANK_VECTORUNARYOP_DEFINE(Cosh,F)
+PLANK_VECTORUNARYOP_DEFINE(Tanh,F)
+PLANK_VECTORUNARYOP_DEFINE(Log,F)
+PLANK_VECTORUNARYOP_DEFINE(Log10,F)
+PLANK_VECTORUNARYOP_DEFINE(Exp,F)
+PLANK_VECTORUNARYOP_DEFINE(Ceil,F)
+PLANK_VECTORUNARYOP_DEFINE(Floor,F)
+PLANK_VECTORUNARYOP_DEFINE(Frac,F)
+PLANK_VECTORUNARYOP_DEFINE(M2F,F)
+PLANK_VECTORUNARYOP_DEFINE(F2M,F)
+PLANK_VECTORUNARYOP_DEFINE(A2dB,F)
+PLANK_VECTORUNARYOP_DEFINE(dB2A,F)
+PLANK_VECTORUNARYOP_DEFINE(D2R,F)
+PLANK_VECTORUNARYOP_DEFINE(R2D,F)
+PLANK_VECTORUNARYOP_DEFINE(Distort,F)
+PLANK_VECTORUNARYOP_DEFINE(Zap,F)
+
+PLANK_SSE_BINARYOPF_DEFINE(Add)
+PLANK_SSE_BINARYOPF_DEFINE(Sub)
+PLANK_SSE_BINARYOPF_DEFINE(Mul)
+PLANK_SSE_BINARYOPF_DEFINE(Div)
+PLANK_SSE_BINARYOPF_DEFINE(Min)
+PLANK_SSE_BINARYOPF_DEFINE(Max)
+PLANK_VECTORBINARYOP_DEFINE(Mod,F)
+
+PLANK_SSE_BINARYOPF_DEFINE(IsEqualTo)
+PLANK_SSE_BINARYOPF_DEFINE(IsNotEqualTo)
+PLANK_SSE_BINARYOPF_DEFINE(IsGreaterThan)
+PLANK_SSE_BINARYOPF_DEFINE(IsGreaterThanOrEqualTo)
+PLANK_SSE_BINARYOPF_DEFINE(IsLessThan)
+PLANK_SSE_BINARYOPF_DEFINE(IsLessThanOrEqualTo)
+
+PLANK_SSE_BINARYOPF_DEFINE(SumSqr)
+PLANK_SSE_BINARYOPF_DEFINE(DifSqr)
+PLANK_SSE_BINARYOPF_DEFINE(SqrSum)
+PLANK_SSE_BINARYOPF_DEFINE(SqrDif)
+PLANK_SSE_BINARYOPF_DEFINE(AbsDif)
+PLANK_SSE_BINARYOPF_DEFINE(Thresh)
+
+PLANK_VECTORBINARYOP_DEFINE(Pow,F)
+PLANK_VECTORBINARYOP_DEFINE(Hypot,F)
+PLANK_VECTORBINARYOP_DEFINE(Atan2,F)
+
+PLANK_SSE_APPLY(PLANK_SSE_MULADD_DEFINE,(F,PLANK_SSE_ARGSF))
+
+static PLANK_INLINE_LOW void pl_VectorAddMulF_1NN (float *result, const float* a, const float* b, PlankUL N)
+{
+    __m128 sum = _mm_setzero_ps();
+    float total;
+    PlankUL i;
+    
+    for (i = 0; i + 4 <= N; i += 4)
+        sum = _mm_add_ps (sum, _mm_mul_ps (_mm_loadu_ps (a + i), _mm_loadu_ps (b + i)));
+    
+    sum = _mm_add_ps (sum, _mm_movehl_ps (sum, sum));
+    sum = _mm_add_ss (sum, _mm_shuffle_ps (sum, sum, 1));
+    total = _mm_cvtss_f32 (sum);
+    
+    for (; i < N; PLANK_INC (i))
+        total += a[i] * b[i];
+    
+    *result = total;
+}
+
+PLANK_SSE_APPLY(PLANK_SSE_ZMUL_DEFINE,(F,PLANK_SSE_ARGSF))
+
+static PLANK_INLINE_LOW void pl_VectorLookupF_NnN (float *result, float *table, PlankUL n, float *index, PlankUL N)
+{
+    PLANK_ALIGN(16) int index0[4];
+    __m128 idx, frac, value0, value1;
+    __m128i idx0;
+    PlankUL i;
+    
+    PLANK_UNUSED(n);
+    
+    for (i = 0; i + 4 <= N; i += 4)
+    {
+        idx  = _mm_loadu_ps (index + i);
+        idx0 = _mm_cvttps_epi32 (idx);
+        frac = _mm_sub_ps (idx, _mm_cvtepi32_ps (idx0));
+        _mm_store_si128 ((__m128i*)index0, idx0);
+        
+        value0 = _mm_set_ps (table[index0[3]],     table[index0[2]],     table[index0[1]],     table[index0[0]]);
+        value1 = _mm_set_ps (table[index0[3] + 1], table[index0[2] + 1], table[index0[1] + 1], table[index0[0] + 1]);
+        _mm_storeu_ps (result + i, _mm_add_ps (value0, _mm_mul_ps (frac, _mm_sub_ps (value1, value0))));
+    }
+    
+    for (; i < N; PLANK_INC (i))
+        result[i] = pl_LookupF (table, index[i]);
+}
+
+
+//------------------------------- double ---------------------------------------
+
+PLANK_SSE_APPLY(PLANK_SSE_FILL_DEFINE,(D,PLANK_SSE_ARGSD))
+
+static PLANK_INLINE_LOW void pl_VectorRampD_N11 (double *result, double a, double b, PlankUL N)
+{
+    const __m128d step = _mm_set1_pd (b * 2.0);
+    __m128d v = _mm_set_pd (a + b, a);
+    PlankUL i;
+    
+    for (i = 0; i + 2 <= N; i += 2)
+    {
+        _mm_storeu_pd (result + i, v);
+        v = _mm_add_pd (v, step);
+    }
+    
+    for (; i < N; PLANK_INC (i))
+        result[i] = a + (double)i * b;
+}
+
+PLANK_VECTORLINE_DEFINE(D)
+
+PLANK_SSE_UNARYOPD_DEFINE(Move)
+PLANK_SSE_UNARYOPD_DEFINE(Inc)
+PLANK_SSE_UNARYOPD_DEFINE(Dec)
+PLANK_SSE_UNARYOPD_DEFINE(Neg)
+PLANK_SSE_UNARYOPD_DEFINE(Abs)
+PLANK_SSE_UNARYOPD_DEFINE(Squared)
+PLANK_SSE_UNARYOPD_DEFINE(Cubed)
+PLANK_SSE_UNARYOPD_DEFINE(Sign)
+PLANK_SSE_UNARYOPD_DEFINE(Reciprocal)
+PLANK_SSE_UNARYOPD_DEFINE(Sqrt)
+
+PLANK_VECTORUNARYOP_DEFINE(Log2,D)
+PLANK_VECTORUNARYOP_DEFINE(Sin,D)
+PLANK_VECTORUNARYOP_DEFINE(Cos,D)
+PLANK_VECTORUNARYOP_DEFINE(Tan,D)
+PLANK_VECTORUNARYOP_DEFINE(Asin,D)
+PLANK_VECTORUNARYOP_DEFINE(Acos,D)
+PLANK_VECTORUNARYOP_DEFINE(Atan,D)
+PLANK_VECTORUNARYOP_DEFINE(Sinh,D)
+PLANK_VECTORUNARYOP_DEFINE(Cosh,D)
+PLANK_VECTORUNARYOP_DEFINE(Tanh,D)
+PLANK_VECTORUNARYOP_DEFINE(Log,D)
+PLANK_VECTORUNARYOP_DEFINE(Log10,D)
+PLANK_VECTORUNARYOP_DEFINE(Exp,D)
+PLANK_VECTORUNARYOP_DEFINE(Ceil,D)
+PLANK_VECTORUNARYOP_DEFINE(Floor,D)
+PLANK_VECTORUNARYOP_DEFINE(Frac,D)
+PLANK_VECTORUNARYOP_DEFINE(M2F,D)
+PLANK_VECTORUNARYOP_DEFINE(F2M,D)
+PLANK_VECTORUNARYOP_DEFINE(A2dB,D)
+PLANK_VECTORUNARYOP_DEFINE(dB2A,D)
+PLANK_VECTORUNARYOP_DEFINE(D2R,D)
+PLANK_VECTORUNARYOP_DEFINE(R2D,D)
+PLANK_VECTORUNARYOP_DEFINE(Distort,D)
+PLANK_VECTORUNARYOP_DEFINE(Zap,D)
+
+PLANK_SSE_BINARYOPD_DEFINE(Add)
+PLANK_SSE_BINARYOPD_DEFINE(Sub)
+PLANK_SSE_BINARYOPD_DEFINE(Mul)
+PLANK_SSE_BINARYOPD_DEFINE(Div)
+PLANK_SSE_BINARYOPD_DEFINE(Min)
+PLANK_SSE_BINARYOPD_DEFINE(Max)
+PLANK_VECTORBINARYOP_DEFINE(Mod,D)
+
+PLANK_SSE_BINARYOPD_DEFINE(IsEqualTo)
+PLANK_SSE_BINARYOPD_DEFINE(IsNotEqualTo)
+PLANK_SSE_BINARYOPD_DEFINE(IsGreaterThan)
+PLANK_SSE_BINARYOPD_DEFINE(IsGreaterThanOrEqualTo)
+PLANK_SSE_BINARYOPD_DEFINE(IsLessThan)
+PLANK_SSE_BINARYOPD_DEFINE(IsLessThanOrEqualTo)
+
+PLANK_SSE_BINARYOPD_DEFINE(SumSqr)
+PLANK_SSE_BINARYOPD_DEFINE(DifSqr)
+PLANK_SSE_BINARYOPD_DEFINE(SqrSum)
+PLANK_SSE_BINARYOPD_DEFINE(SqrDif)
+PLANK_SSE_BINARYOPD_DEFINE(AbsDif)
+PLANK_SSE_BINARYOPD_DEFINE(Thresh)
+
+PLANK_VECTORBINARYOP_DEFINE(Pow,D)
+PLANK_VECTORBINARYOP_DEFINE(Hypot,D)
+PLANK_VECTORBINARYOP_DEFINE(Atan2,D)
+
+PLANK_SSE_APPLY(PLANK_SSE_MULADD_DEFINE,(D,PLANK_SSE_ARGSD))
+
+static PLANK_INLINE_LOW void pl_VectorAddMulD_1NN (double *result, const double* a, const double* b, PlankUL N)
+{
+    __m128d sum = _mm_setzero_pd();
+    double total;
+    PlankUL i;
+    
+    for (i = 0; i + 2 <= N; i += 2)
+        sum = _mm_add_pd (sum, _mm_mul_pd (_mm_loadu_pd (a + i), _mm_loadu_pd (b + i)));
+    
+    sum = _mm_add_sd (sum, _mm_unpackhi_pd (sum, sum));
+    total = _mm_cvtsd_f64 (sum);
+    
+    for (; i < N; PLANK_INC (i))
+        total += a[i] * b[i];
+    
+    *result = total;
+}
+
+PLANK_SSE_APPLY(PLANK_SSE_ZMUL_DEFINE,(D,PLANK_SSE_ARGSD))
+
+static PLANK_INLINE_LOW void pl_VectorLookupD_NnN (double *result, double *table, PlankUL n, double *index, PlankUL N)
+{
+    PLANK_ALIGN(16) int index0[4];
+    __m128d idx, frac, value0, value1;
+    __m128i idx0;
+    PlankUL i;
+    
+    PLANK_UNUSED(n);
+    
+    for (i = 0; i + 2 <= N; i += 2)
+    {
+        idx  = _mm_loadu_pd (index + i);
+        idx0 = _mm_cvttpd_epi32 (idx);
+        frac = _mm_sub_pd (idx, _mm_cvtepi32_pd (idx0));
+        _mm_store_si128 ((__m128i*)index0, idx0);
+        
+        value0 = _mm_set_pd (table[index0[1]],     table[index0[0]]);
+        value1 = _mm_set_pd (table[index0[1] + 1], table[index0[0] + 1]);
+        _mm_storeu_pd (result + i, _mm_add_pd (value0, _mm_mul_pd (frac, _mm_sub_pd (value1, value0))));
+    }
+    
+    for (; i < N; PLANK_INC (i))
+        result[i] = pl_LookupD (table, index[i]);
+}
+
+
+//------------------------------- integer --------------------------------------
+
+// the integer ops are rarely on the audio path, leave these to the compiler
+PLANK_VECTOR_OPS_COMMON(S)
+PLANK_VECTOR_OPS_COMMON(I)
+PLANK_VECTOR_OPS_COMMON(LL)
+
+
+//------------------------------ converters ------------------------------------
+
+static PLANK_INLINE_LOW void pl_VectorConvertF2D_NN (double *result, const float* input, PlankUL N)
+{
+    __m128 v;
+    PlankUL i;
+    
+    for (i = 0; i + 4 <= N; i += 4)
+    {
+        v = _mm_loadu_ps (input + i);
+        _mm_storeu_pd (result + i,     _mm_cvtps_pd (v));
+        _mm_storeu_pd (result + i + 2, _mm_cvtps_pd (_mm_movehl_ps (v, v)));
+    }
+    
+    for (; i < N; PLANK_INC (i))
+        result[i] = (double)input[i];
+}
+
+static PLANK_INLINE_LOW void pl_VectorConvertD2F_NN (float *result, const double* input, PlankUL N)
+{
+    PlankUL i;
+    
+    for (i = 0; i + 4 <= N; i += 4)
+        _mm_storeu_ps (result + i, _mm_movelh_ps (_mm_cvtpd_ps (_mm_loadu_pd (input + i)),
+                                                  _mm_cvtpd_ps (_mm_loadu_pd (input + i + 2))));
+    
+    for (; i < N; PLANK_INC (i))
+        result[i] = (float)input[i];
+}
+
+static PLANK_INLINE_LOW void pl_VectorConvertI2F_NN (float *result, const int* input, PlankUL N)
+{
+    PlankUL i;
+    
+    for (i = 0; i + 4 <= N; i += 4)
+        _mm_storeu_ps (result + i, _mm_cvtepi32_ps (_mm_loadu_si128 ((const __m128i*)(input + i))));
+    
+    for (; i < N; PLANK_INC (i))
+        result[i] = (float)input[i];
+}
+
+static PLANK_INLINE_LOW void pl_VectorConvertF2I_NN (int *result, const float* input, PlankUL N)
+{
+    PlankUL i;
+    
+    for (i = 0; i + 4 <= N; i += 4)
+        _mm_storeu_si128 ((__m128i*)(result + i), _mm_cvttps_epi32 (_mm_loadu_ps (input + i)));
+    
+    for (; i < N; PLANK_INC (i))
+        result[i] = (int)input[i];
+}
+
+static PLANK_INLINE_LOW void pl_VectorConvertI2D_NN (double *result, const int* input, PlankUL N)
+{
+    PlankUL i;
+    
+    for (i = 0; i + 2 <= N; i += 2)
+        _mm_storeu_pd (result + i, _mm_cvtepi32_pd (_mm_loadl_epi64 ((const __m128i*)(input + i))));
+    
+    for (; i < N; PLANK_INC (i))
+        result[i] = (double)input[i];
+}
+
+static PLANK_INLINE_LOW void pl_VectorConvertD2I_NN (int *result, const double* input, PlankUL N)
+{
+    PlankUL i;
+    
+    for (i = 0; i + 2 <= N; i += 2)
+        _mm_storel_epi64 ((__m128i*)(result + i), _mm_cvttpd_epi32 (_mm_loadu_pd (input + i)));
+    
+    for (; i < N; PLANK_INC (i))
+        result[i] = (int)input[i];
+}
+
+static PLANK_INLINE_LOW void pl_VectorConvertS2F_NN (float *result, const short* input, PlankUL N)
+{
+    __m128i v;
+    PlankUL i;
+    
+    for (i = 0; i + 8 <= N; i += 8)
+    {
+        // sign extend by unpacking into the top half then shifting down
+        v = _mm_loadu_si128 ((const __m128i*)(input + i));
+        _mm_storeu_ps (result + i,     _mm_cvtepi32_ps (_mm_srai_epi32 (_mm_unpacklo_epi16 (v, v), 16)));
+        _mm_storeu_ps (result + i + 4, _mm_cvtepi32_ps (_mm_srai_epi32 (_mm_unpackhi_epi16 (v, v), 16)));
+    }
+    
+    for (; i < N; PLANK_INC (i))
+        result[i] = (float)input[i];
+}
+
+static PLANK_INLINE_LOW void pl_VectorConvertF2S_NN (short *result, const float* input, PlankUL N)
+{
+    // clamp before converting so values beyond the int range saturate too, not just those beyond the short range
+    const __m128 lower = _mm_set1_ps (-32768.f);
+    const __m128 upper = _mm_set1_ps (32767.f);
+    __m128i lo, hi;
+    PlankUL i;
+    
+    for (i = 0; i + 8 <= N; i += 8)
+    {
+        lo = _mm_cvttps_epi32 (_mm_min_ps (_mm_max_ps (_mm_loadu_ps (input + i),     lower), upper));
+        hi = _mm_cvttps_epi32 (_mm_min_ps (_mm_max_ps (_mm_loadu_ps (input + i + 4), lower), upper));
+        _mm_storeu_si128 ((__m128i*)(result + i), _mm_packs_epi32 (lo, hi));
+    }
+    
+    for (; i < N; PLANK_INC (i))
+        result[i] = (short)pl_ClipF (input[i], -32768.f, 32767.f);
+}
+
+PLANK_VECTORCONVERT_DEFINE(I,C)
+PLANK_VECTORCONVERT_DEFINE(S,C)
+PLANK_VECTORCONVERT_DEFINE(F,C)
+PLANK_VECTORCONVERT_DEFINE(D,C)
+PLANK_VECTORCONVERT_DEFINE(LL,C)
+PLANK_VECTORCONVERT_DEFINE(C,I)
+PLANK_VECTORCONVERT_DEFINE(S,I)
+PLANK_VECTORCONVERT_DEFINE(LL,I)
+PLANK_VECTORCONVERT_DEFINE(C,S)
+PLANK_VECTORCONVERT_DEFINE(I,S)
+PLANK_VECTORCONVERT_DEFINE(D,S)
+PLANK_VECTORCONVERT_DEFINE(LL,S)
+PLANK_VECTORCONVERT_DEFINE(C,F)
+PLANK_VECTORCONVERT_DEFINE(LL,F)
+PLANK_VECTORCONVERT_DEFINE(C,D)
+PLANK_VECTORCONVERT_DEFINE(S,D)
+PLANK_VECTORCONVERT_DEFINE(LL,D)
+PLANK_VECTORCONVERT_DEFINE(C,LL)
+PLANK_VECTORCONVERT_DEFINE(I,LL)
+PLANK_VECTORCONVERT_DEFINE(S,LL)
+PLANK_VECTORCONVERT_DEFINE(F,LL)
+PLANK_VECTORCONVERT_DEFINE(D,LL)
+
+PLANK_VECTORCONVERTERSROUND_DEFINE
+
+#endif // !DOXYGEN
+#endif // PLANK_SSE_H
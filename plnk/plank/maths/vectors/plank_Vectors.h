@@ -405,8 +405,16 @@
 
 /// @} End group PlankVectorMacros
 
+#if !defined(PLANK_VEC_VDSP) && !defined(PLANK_VEC_SSE) && !defined(PLANK_VEC_NOSIMD)
+    #if PLANK_X86 && !PLANK_APPLE && (defined(__SSE2__) || PLANK_64BIT)
+        #define PLANK_VEC_SSE 1
+    #endif
+#endif
+
 #if defined(PLANK_VEC_VDSP) //&& !DOXYGEN
     #include "plank_vDSP.h"
+#elif defined(PLANK_VEC_SSE) && PLANK_VEC_SSE
+    #include "plank_SSE.h"
 #elif defined(PLANK_VEC_OTHERLIB) //etc!
     #include "some other vector lib" // must define PLANK_VEC_CUSTOM
 #endif
@@ -484,10 +492,20 @@ typedef PlankLL PlankVLL;
  @ingroup PlankEndianFunctions */
 static PLANK_INLINE_LOW void pl_VectorSwapEndianUS (PlankUS* data, PlankUL N)
 {
-    PlankUL i;
+    PlankUL i = 0;
     
-    for (i = 0; i < N; PLANK_INC (i), PLANK_INC (data))
-        pl_SwapEndianUS (data);
+#if defined(PLANK_VEC_SSE) && PLANK_VEC_SSE
+    __m128i v;
+    
+    for (; i + 8 <= N; i += 8)
+    {
+        v = _mm_loadu_si128 ((const __m128i*)(data + i));
+        _mm_storeu_si128 ((__m128i*)(data + i), _mm_or_si128 (_mm_slli_epi16 (v, 8), _mm_srli_epi16 (v, 8)));
+    }
+#endif
+    
+    for (; i < N; PLANK_INC (i))
+        pl_SwapEndianUS (data + i);
 }
 
 /** Swap the endianness of a vector of short elements.
@@ -518,10 +536,22 @@ static PLANK_INLINE_LOW void pl_VectorSwapEndianI24 (PlankI24* data, PlankUL N)
  @ingroup PlankEndianFunctions */
 static PLANK_INLINE_LOW void pl_VectorSwapEndianUI (PlankUI* data, PlankUL N)
 {
-    PlankUL i;
+    PlankUL i = 0;
     
-    for (i = 0; i < N; PLANK_INC (i), PLANK_INC (data))
-        pl_SwapEndianUI (data);
+#if defined(PLANK_VEC_SSE) && PLANK_VEC_SSE
+    __m128i v;
+    
+    for (; i + 4 <= N; i += 4)
+    {
+        // swap the 16-bit halves then the bytes within each half
+        v = _mm_loadu_si128 ((const __m128i*)(data + i));
+        v = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (v, _MM_SHUFFLE (2, 3, 0, 1)), _MM_SHUFFLE (2, 3, 0, 1));
+        _mm_storeu_si128 ((__m128i*)(data + i), _mm_or_si128 (_mm_slli_epi16 (v, 8), _mm_srli_epi16 (v, 8)));
+    }
+#endif
+    
+    for (; i < N; PLANK_INC (i))
+        pl_SwapEndianUI (data + i);
 }
 
 /** Swap the endianness of a vector of int elements.
@@ -552,10 +582,22 @@ static PLANK_INLINE_LOW void pl_VectorSwapEndianL (PlankL* data, PlankUL N)
  @ingroup PlankEndianFunctions */
 static PLANK_INLINE_LOW void pl_VectorSwapEndianULL (PlankULL* data, PlankUL N)
 {
-    PlankUL i;
+    PlankUL i = 0;
     
-    for (i = 0; i < N; PLANK_INC (i), PLANK_INC (data))
-        pl_SwapEndianULL (data);
+#if defined(PLANK_VEC_SSE) && PLANK_VEC_SSE
+    __m128i v;
+    
+    for (; i + 2 <= N; i += 2)
+    {
+        // reverse the four 16-bit words then the bytes within each word
+        v = _mm_loadu_si128 ((const __m128i*)(data + i));
+        v = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (v, _MM_SHUFFLE (0, 1, 2, 3)), _MM_SHUFFLE (0, 1, 2, 3));
+        _mm_storeu_si128 ((__m128i*)(data + i), _mm_or_si128 (_mm_slli_epi16 (v, 8), _mm_srli_epi16 (v, 8)));
+    }
+#endif
+    
+    for (; i < N; PLANK_INC (i))
+        pl_SwapEndianULL (data + i);
 }
 
 /** Swap the endianness of a vector of long long (64-bit) elements.
@@ -565,6 +607,391 @@ static PLANK_INLINE_LOW void pl_VectorSwapEndianLL (PlankLL* data, PlankUL N)
     pl_VectorSwapEndianULL ((PlankULL*)data, N);
 }
 
+/** Convert a vector of packed native-endian 24-bit ints to float.
+ The 24-bit values are assembled into ints a chunk at a time so the int to
+ float conversion can use the vector library.
+ @ingroup PlankEndianFunctions */
+static PLANK_INLINE_LOW void pl_VectorConvertI242F_NN (float* result, const PlankI24* input, PlankUL N)
+{
+    int temp[64];
+    const PlankUC* bytes;
+    PlankUL i, j, chunk;
+    
+    bytes = (const PlankUC*)input;
+    
+    for (i = 0; i < N; i += chunk)
+    {
+        chunk = ((N - i) < 64) ? (N - i) : 64;
+        
+        for (j = 0; j < chunk; PLANK_INC (j), bytes += 3)
+        {
+#if PLANK_BIGENDIAN
+            temp[j] = (int)(((PlankUI)bytes[2] << 8) | ((PlankUI)bytes[1] << 16) | ((PlankUI)bytes[0] << 24)) >> 8;
+#else
+            temp[j] = (int)(((PlankUI)bytes[0] << 8) | ((PlankUI)bytes[1] << 16) | ((PlankUI)bytes[2] << 24)) >> 8;
+#endif
+        }
+        
+        pl_VectorConvertI2F_NN (result + i, temp, chunk);
+    }
+}
+
+/** @defgroup PlankVectorFilterFunctions Plank vector filter functions
+ Filters that run the recurrence for several channels at once. The samples
+ are interleaved so that each channel is a lane of a SIMD register, this 
+ vectorises what is otherwise a serial computation within each channel.
+ 
+ Each channel is a cascade of two-pole, two-zero sections in transposed direct
+ form II. This is more robust with float coefficients than direct form II at 
+ low frequencies. As with the Plonk filter forms the feedback coefficients 
+ are added rather than subtracted:
+ @f$ y = a_0 x + s_1,\ s_1 = a_1 x + b_1 y + s_2,\ s_2 = a_2 x + b_2 y @f$
+ 
+ The taps functions are short FIRs vectorised across the output samples 
+ instead, these interpolate fractional reads from delay lines.
+ @ingroup PlankFunctions
+ @{
+ */
+
+#define PLANK_VECTORBIQUADBANK_NUMCOEFFS 5
+
+#define PLANK_VECTORBIQUADBANKSCALAR_DEFINE(TYPECODE,TYPE) \
+    static PLANK_INLINE_LOW void pl_VectorBiquadBankScalar##TYPECODE (TYPE* io, TYPE* state, const TYPE* coeffs, PlankUL coeffsStride, PlankUL numChannels, PlankUL c, PlankUL N) {\
+        const TYPE* k; TYPE* x; TYPE s1, s2, in, out; PlankUL n;\
+        for (; c < numChannels; PLANK_INC (c)) {\
+            s1 = state[c]; s2 = state[numChannels + c];\
+            for (n = 0, x = io + c, k = coeffs + c; n < N; PLANK_INC (n), x += numChannels, k += coeffsStride) {\
+                in = *x; out = k[0] * in + s1;\
+                s1 = k[numChannels] * in + k[numChannels * 3] * out + s2;\
+                s2 = k[numChannels * 2] * in + k[numChannels * 4] * out;\
+                *x = out;\
+            }\
+            state[c] = s1; state[numChannels + c] = s2;\
+        }\
+    }
+
+PLANK_VECTORBIQUADBANKSCALAR_DEFINE(F,float)
+PLANK_VECTORBIQUADBANKSCALAR_DEFINE(D,double)
+
+#if defined(PLANK_VEC_SSE) && PLANK_VEC_SSE
+// one step of the recurrence for W channels, the b1 and b2 products are kept
+// at the end of the dependency chain
+#define PLANK_VECTORBIQUADBANKLANES_STEP(LD,ST,ADD,MUL,X,S1,S2,A0,A1,A2,B1,B2) \
+    in = LD (X); out = ADD (MUL (A0, in), S1);\
+    S1 = ADD (MUL (B1, out), ADD (MUL (A1, in), S2));\
+    S2 = ADD (MUL (B2, out), MUL (A2, in));\
+    ST (X, out);
+
+// one kernel per register width, each returns the first channel it didn't process.
+// Pairs of registers are filtered together so that two independent chains
+// are in flight.
+#define PLANK_VECTORBIQUADBANKLANES_DEFINE(NAME,TARGET,TYPE,V,LD,ST,W,ADD,MUL,CLEANUP) \
+    static TARGET PLANK_INLINE_LOW PlankUL NAME (TYPE* io, TYPE* state, const TYPE* coeffs, PlankUL coeffsStride, PlankUL numChannels, PlankUL c, PlankUL N) {\
+        const TYPE* k; TYPE* x; V s1, s2, t1, t2, in, out, a0, a1, a2, b1, b2, c0, c1, c2, d1, d2; PlankUL n;\
+        const PlankUL nc = numChannels;\
+        for (; c + W * 2 <= nc; c += W * 2) {\
+            s1 = LD (state + c); s2 = LD (state + nc + c);\
+            t1 = LD (state + c + W); t2 = LD (state + nc + c + W);\
+            x = io + c; k = coeffs + c;\
+            if (coeffsStride == 0) {\
+                a0 = LD (k); a1 = LD (k + nc); a2 = LD (k + nc * 2); b1 = LD (k + nc * 3); b2 = LD (k + nc * 4);\
+                c0 = LD (k + W); c1 = LD (k + nc + W); c2 = LD (k + nc * 2 + W); d1 = LD (k + nc * 3 + W); d2 = LD (k + nc * 4 + W);\
+                for (n = 0; n < N; PLANK_INC (n), x += nc) {\
+                    PLANK_VECTORBIQUADBANKLANES_STEP (LD, ST, ADD, MUL, x, s1, s2, a0, a1, a2, b1, b2)\
+                    PLANK_VECTORBIQUADBANKLANES_STEP (LD, ST, ADD, MUL, x + W, t1, t2, c0, c1, c2, d1, d2)\
+                }\
+            } else {\
+                for (n = 0; n < N; PLANK_INC (n), x += nc, k += coeffsStride) {\
+                    PLANK_VECTORBIQUADBANKLANES_STEP (LD, ST, ADD, MUL, x, s1, s2, LD (k), LD (k + nc), LD (k + nc * 2), LD (k + nc * 3), LD (k + nc * 4))\
+                    PLANK_VECTORBIQUADBANKLANES_STEP (LD, ST, ADD, MUL, x + W, t1, t2, LD (k + W), LD (k + nc + W), LD (k + nc * 2 + W), LD (k + nc * 3 + W), LD (k + nc * 4 + W))\
+                }\
+            }\
+            ST (state + c, s1); ST (state + nc + c, s2);\
+            ST (state + c + W, t1); ST (state + nc + c + W, t2);\
+        }\
+        for (; c + W <= nc; c += W) {\
+            s1 = LD (state + c); s2 = LD (state + nc + c);\
+            x = io + c; k = coeffs + c;\
+            for (n = 0; n < N; PLANK_INC (n), x += nc, k += coeffsStride) {\
+                PLANK_VECTORBIQUADBANKLANES_STEP (LD, ST, ADD, MUL, x, s1, s2, LD (k), LD (k + nc), LD (k + nc * 2), LD (k + nc * 3), LD (k + nc * 4))\
+            }\
+            ST (state + c, s1); ST (state + nc + c, s2);\
+        }\
+        CLEANUP;\
+        return c;\
+    }
+
+PLANK_VECTORBIQUADBANKLANES_DEFINE(pl_VectorBiquadBankSSEF, , float, __m128, _mm_loadu_ps, _mm_storeu_ps, 4, pl_SSEAddF, pl_SSEMulF, (void)0)
+PLANK_VECTORBIQUADBANKLANES_DEFINE(pl_VectorBiquadBankSSED, , double, __m128d, _mm_loadu_pd, _mm_storeu_pd, 2, pl_SSEAddD, pl_SSEMulD, (void)0)
+PLANK_SSE_AVXONLY(PLANK_VECTORBIQUADBANKLANES_DEFINE(pl_VectorBiquadBankAVXF, PLANK_SSE_AVXTARGET, float, __m256, _mm256_loadu_ps, _mm256_storeu_ps, 8, pl_AVXAddF, pl_AVXMulF, _mm256_zeroupper()))
+PLANK_SSE_AVXONLY(PLANK_VECTORBIQUADBANKLANES_DEFINE(pl_VectorBiquadBankAVXD, PLANK_SSE_AVXTARGET, double, __m256d, _mm256_loadu_pd, _mm256_storeu_pd, 4, pl_AVXAddD, pl_AVXMulD, _mm256_zeroupper()))
+#endif
+
+#define PLANK_VECTORBIQUADBANK_DEFINE(TYPECODE,TYPE) \
+    /** Filters interleaved channels through one two-pole, two-zero section each.
+     @param io              N frames of numChannels interleaved samples, filtered in place.
+     @param state           s1 for every channel followed by s2 for every channel.
+     @param coeffs          a0 for every channel followed by a1, a2, b1 then b2 similarly.
+     @param coeffsStride    0 to use the same coefficients for every frame, otherwise 
+                            the amount to advance coeffs for each frame (e.g., 
+                            5 * numChannels for a new set each frame).
+     @param numChannels     The number of channels (there is no need to pad this).
+     @param N               The number of frames. */\
+    static PLANK_INLINE_LOW void pl_VectorBiquadBank##TYPECODE (TYPE* io, TYPE* state, const TYPE* coeffs, PlankUL coeffsStride, PlankUL numChannels, PlankUL N) {\
+        PlankUL c = 0;\
+        PLANK_VECTORBIQUADBANK_LANES(TYPECODE)\
+        pl_VectorBiquadBankScalar##TYPECODE (io, state, coeffs, coeffsStride, numChannels, c, N);\
+    }
+
+#if defined(PLANK_VEC_SSE) && PLANK_VEC_SSE
+    #define PLANK_VECTORBIQUADBANK_LANES(TYPECODE) \
+        PLANK_SSE_AVXDISPATCH(c = pl_VectorBiquadBankAVX##TYPECODE (io, state, coeffs, coeffsStride, numChannels, c, N))\
+        c = pl_VectorBiquadBankSSE##TYPECODE (io, state, coeffs, coeffsStride, numChannels, c, N);
+#else
+    #define PLANK_VECTORBIQUADBANK_LANES(TYPECODE)
+#endif
+
+PLANK_VECTORBIQUADBANK_DEFINE(F,float)
+PLANK_VECTORBIQUADBANK_DEFINE(D,double)
+
+/** The most weights pl_VectorTapsF and pl_VectorTapsD take. */
+#define PLANK_VECTORTAPS_MAXWEIGHTS 4
+
+#define PLANK_VECTORTAPSSCALAR_DEFINE(TYPECODE,TYPE) \
+    static PLANK_INLINE_LOW void pl_VectorTapsScalar##TYPECODE (TYPE* result, const TYPE* input, const TYPE* weights, PlankUL numWeights, PlankUL n, PlankUL N) {\
+        TYPE sum; PlankUL k;\
+        for (; n < N; PLANK_INC (n)) {\
+            sum = weights[0] * input[n];\
+            for (k = 1; k < numWeights; PLANK_INC (k)) sum += weights[k] * input[n + k];\
+            result[n] = sum;\
+        }\
+    }
+
+PLANK_VECTORTAPSSCALAR_DEFINE(F,float)
+PLANK_VECTORTAPSSCALAR_DEFINE(D,double)
+
+#if defined(PLANK_VEC_SSE) && PLANK_VEC_SSE
+// W outputs at a time from unaligned loads of the input at each weight's offset
+#define PLANK_VECTORTAPSLANES_DEFINE(NAME,TARGET,TYPE,V,LD,ST,SET1,W,ADD,MUL,CLEANUP) \
+    static TARGET PLANK_INLINE_LOW PlankUL NAME (TYPE* result, const TYPE* input, const TYPE* weights, PlankUL numWeights, PlankUL n, PlankUL N) {\
+        V w[PLANK_VECTORTAPS_MAXWEIGHTS], sum; PlankUL k;\
+        for (k = 0; k < numWeights; PLANK_INC (k)) w[k] = SET1 (weights[k]);\
+        for (; n + W <= N; n += W) {\
+            sum = MUL (w[0], LD (input + n));\
+            for (k = 1; k < numWeights; PLANK_INC (k)) sum = ADD (sum, MUL (w[k], LD (input + n + k)));\
+            ST (result + n, sum);\
+        }\
+        CLEANUP;\
+        return n;\
+    }
+
+PLANK_VECTORTAPSLANES_DEFINE(pl_VectorTapsSSEF, , float, __m128, _mm_loadu_ps, _mm_storeu_ps, _mm_set1_ps, 4, pl_SSEAddF, pl_SSEMulF, (void)0)
+PLANK_VECTORTAPSLANES_DEFINE(pl_VectorTapsSSED, , double, __m128d, _mm_loadu_pd, _mm_storeu_pd, _mm_set1_pd, 2, pl_SSEAddD, pl_SSEMulD, (void)0)
+PLANK_SSE_AVXONLY(PLANK_VECTORTAPSLANES_DEFINE(pl_VectorTapsAVXF, PLANK_SSE_AVXTARGET, float, __m256, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_set1_ps, 8, pl_AVXAddF, pl_AVXMulF, _mm256_zeroupper()))
+PLANK_SSE_AVXONLY(PLANK_VECTORTAPSLANES_DEFINE(pl_VectorTapsAVXD, PLANK_SSE_AVXTARGET, double, __m256d, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd, 4, pl_AVXAddD, pl_AVXMulD, _mm256_zeroupper()))
+#endif
+
+#define PLANK_VECTORTAPS_DEFINE(TYPECODE,TYPE) \
+    /** A short FIR with constant weights, e.g., a fractional read from a delay line.
+     @f$ result_n = \sum_k weights_k \, input_{n+k} @f$
+     @param result      N output samples (which must not overlap the input).
+     @param input       The N + numWeights - 1 input samples.
+     @param weights     The weights.
+     @param numWeights  The number of weights, from 1 to PLANK_VECTORTAPS_MAXWEIGHTS.
+     @param N           The number of output samples. */\
+    static PLANK_INLINE_LOW void pl_VectorTaps##TYPECODE (TYPE* result, const TYPE* input, const TYPE* weights, PlankUL numWeights, PlankUL N) {\
+        PlankUL n = 0;\
+        PLANK_VECTORTAPS_LANES(TYPECODE)\
+        pl_VectorTapsScalar##TYPECODE (result, input, weights, numWeights, n, N);\
+    }
+
+#if defined(PLANK_VEC_SSE) && PLANK_VEC_SSE
+    #define PLANK_VECTORTAPS_LANES(TYPECODE) \
+        PLANK_SSE_AVXDISPATCH(n = pl_VectorTapsAVX##TYPECODE (result, input, weights, numWeights, n, N))\
+        n = pl_VectorTapsSSE##TYPECODE (result, input, weights, numWeights, n, N);
+#else
+    #define PLANK_VECTORTAPS_LANES(TYPECODE)
+#endif
+
+PLANK_VECTORTAPS_DEFINE(F,float)
+PLANK_VECTORTAPS_DEFINE(D,double)
+
+/// @} // End group PlankVectorFilterFunctions
+
+/** @defgroup PlankVectorMatrixFunctions Plank vector matrix functions
+ Matrices are row-major arrays of rows * columns elements. The matrix 
+ multiply takes its second matrix transposed so that every result is a dot 
+ product of two contiguous rows, e.g., a batch of input vectors (one per row) 
+ against a matrix of weights (one row per output).
+ @ingroup PlankFunctions
+ @{
+ */
+
+/** The size of the block of the second matrix kept in the cache while the 
+ first matrix is swept across it. */
+#define PLANK_VECTORMATRIX_BLOCKBYTES 16384
+
+#define PLANK_VECTORMATRIXDOTS4SCALAR_DEFINE(TYPECODE,TYPE) \
+    static PLANK_INLINE_LOW void pl_VectorMatrixDots4Scalar##TYPECODE (TYPE* sums, const TYPE* a, const TYPE* b0, const TYPE* b1, const TYPE* b2, const TYPE* b3, PlankUL k, PlankUL K) {\
+        TYPE x;\
+        for (; k < K; PLANK_INC (k)) {\
+            x = a[k];\
+            sums[0] += x * b0[k]; sums[1] += x * b1[k];\
+            sums[2] += x * b2[k]; sums[3] += x * b3[k];\
+        }\
+    }
+
+PLANK_VECTORMATRIXDOTS4SCALAR_DEFINE(F,float)
+PLANK_VECTORMATRIXDOTS4SCALAR_DEFINE(D,double)
+
+#define PLANK_VECTORMATRIXDOTS8SCALAR_DEFINE(TYPECODE,TYPE) \
+    static PLANK_INLINE_LOW void pl_VectorMatrixDots8Scalar##TYPECODE (TYPE* sums, const TYPE* a0, const TYPE* a1, const TYPE* b0, const TYPE* b1, const TYPE* b2, const TYPE* b3, PlankUL k, PlankUL K) {\
+        pl_VectorMatrixDots4Scalar##TYPECODE (sums, a0, b0, b1, b2, b3, k, K);\
+        pl_VectorMatrixDots4Scalar##TYPECODE (sums + 4, a1, b0, b1, b2, b3, k, K);\
+    }
+
+PLANK_VECTORMATRIXDOTS8SCALAR_DEFINE(F,float)
+PLANK_VECTORMATRIXDOTS8SCALAR_DEFINE(D,double)
+
+#if defined(PLANK_VEC_SSE) && PLANK_VEC_SSE
+// four dot products of one row against four others, each load of the first row 
+// is used four times and the four sums are independent chains. Returns the 
+// first element it didn't process.
+#define PLANK_VECTORMATRIXDOTS4LANES_DEFINE(NAME,TARGET,TYPE,V,LD,ST,ZERO,W,ADD,MUL,CLEANUP) \
+    static TARGET PLANK_INLINE_LOW PlankUL NAME (TYPE* sums, const TYPE* a, const TYPE* b0, const TYPE* b1, const TYPE* b2, const TYPE* b3, PlankUL k, PlankUL K) {\
+        V s0, s1, s2, s3, x; TYPE t[W * 4]; PlankUL w;\
+        if (k + W > K) return k;\
+        s0 = s1 = s2 = s3 = ZERO ();\
+        for (; k + W <= K; k += W) {\
+            x = LD (a + k);\
+            s0 = ADD (s0, MUL (x, LD (b0 + k)));\
+            s1 = ADD (s1, MUL (x, LD (b1 + k)));\
+            s2 = ADD (s2, MUL (x, LD (b2 + k)));\
+            s3 = ADD (s3, MUL (x, LD (b3 + k)));\
+        }\
+        ST (t, s0); ST (t + W, s1); ST (t + W * 2, s2); ST (t + W * 3, s3);\
+        for (w = 0; w < W; PLANK_INC (w)) {\
+            sums[0] += t[w]; sums[1] += t[W + w];\
+            sums[2] += t[W * 2 + w]; sums[3] += t[W * 3 + w];\
+        }\
+        CLEANUP;\
+        return k;\
+    }
+
+PLANK_VECTORMATRIXDOTS4LANES_DEFINE(pl_VectorMatrixDots4SSEF, , float, __m128, _mm_loadu_ps, _mm_storeu_ps, _mm_setzero_ps, 4, pl_SSEAddF, pl_SSEMulF, (void)0)
+PLANK_VECTORMATRIXDOTS4LANES_DEFINE(pl_VectorMatrixDots4SSED, , double, __m128d, _mm_loadu_pd, _mm_storeu_pd, _mm_setzero_pd, 2, pl_SSEAddD, pl_SSEMulD, (void)0)
+PLANK_SSE_AVXONLY(PLANK_VECTORMATRIXDOTS4LANES_DEFINE(pl_VectorMatrixDots4AVXF, PLANK_SSE_AVXTARGET, float, __m256, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_setzero_ps, 8, pl_AVXAddF, pl_AVXMulF, _mm256_zeroupper()))
+PLANK_SSE_AVXONLY(PLANK_VECTORMATRIXDOTS4LANES_DEFINE(pl_VectorMatrixDots4AVXD, PLANK_SSE_AVXTARGET, double, __m256d, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_setzero_pd, 4, pl_AVXAddD, pl_AVXMulD, _mm256_zeroupper()))
+
+// two rows against four, each load of the four rows is used twice
+#define PLANK_VECTORMATRIXDOTS8LANES_DEFINE(NAME,TARGET,TYPE,V,LD,ST,ZERO,W,ADD,MUL,CLEANUP) \
+    static TARGET PLANK_INLINE_LOW PlankUL NAME (TYPE* sums, const TYPE* a0, const TYPE* a1, const TYPE* b0, const TYPE* b1, const TYPE* b2, const TYPE* b3, PlankUL k, PlankUL K) {\
+        V s0, s1, s2, s3, s4, s5, s6, s7, x0, x1, y; TYPE t[W * 8]; PlankUL w, r;\
+        if (k + W > K) return k;\
+        s0 = s1 = s2 = s3 = s4 = s5 = s6 = s7 = ZERO ();\
+        for (; k + W <= K; k += W) {\
+            x0 = LD (a0 + k); x1 = LD (a1 + k);\
+            y = LD (b0 + k); s0 = ADD (s0, MUL (x0, y)); s4 = ADD (s4, MUL (x1, y));\
+            y = LD (b1 + k); s1 = ADD (s1, MUL (x0, y)); s5 = ADD (s5, MUL (x1, y));\
+            y = LD (b2 + k); s2 = ADD (s2, MUL (x0, y)); s6 = ADD (s6, MUL (x1, y));\
+            y = LD (b3 + k); s3 = ADD (s3, MUL (x0, y)); s7 = ADD (s7, MUL (x1, y));\
+        }\
+        ST (t, s0); ST (t + W, s1); ST (t + W * 2, s2); ST (t + W * 3, s3);\
+        ST (t + W * 4, s4); ST (t + W * 5, s5); ST (t + W * 6, s6); ST (t + W * 7, s7);\
+        for (r = 0; r < 8; PLANK_INC (r))\
+            for (w = 0; w < W; PLANK_INC (w))\
+                sums[r] += t[W * r + w];\
+        CLEANUP;\
+        return k;\
+    }
+
+PLANK_VECTORMATRIXDOTS8LANES_DEFINE(pl_VectorMatrixDots8SSEF, , float, __m128, _mm_loadu_ps, _mm_storeu_ps, _mm_setzero_ps, 4, pl_SSEAddF, pl_SSEMulF, (void)0)
+PLANK_VECTORMATRIXDOTS8LANES_DEFINE(pl_VectorMatrixDots8SSED, , double, __m128d, _mm_loadu_pd, _mm_storeu_pd, _mm_setzero_pd, 2, pl_SSEAddD, pl_SSEMulD, (void)0)
+PLANK_SSE_AVXONLY(PLANK_VECTORMATRIXDOTS8LANES_DEFINE(pl_VectorMatrixDots8AVXF, PLANK_SSE_AVXTARGET, float, __m256, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_setzero_ps, 8, pl_AVXAddF, pl_AVXMulF, _mm256_zeroupper()))
+PLANK_SSE_AVXONLY(PLANK_VECTORMATRIXDOTS8LANES_DEFINE(pl_VectorMatrixDots8AVXD, PLANK_SSE_AVXTARGET, double, __m256d, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_setzero_pd, 4, pl_AVXAddD, pl_AVXMulD, _mm256_zeroupper()))
+#endif
+
+#define PLANK_VECTORMATRIXMULNT_DEFINE(TYPECODE,TYPE) \
+    /** Multiplies a matrix by the transpose of another.
+     @f$ result_{ij} = \sum_k a_{ik} \, b_{jk} @f$
+     The rows of @e b are taken in blocks of PLANK_VECTORMATRIX_BLOCKBYTES and 
+     every row of @e a is run against a block before moving to the next. The
+     results are calculated in tiles of two rows of @e a by four of @e b, with 
+     M = 1 this is a matrix-vector product.
+     @param result  The M * N result (which must not overlap the inputs).
+     @param a       The M * K matrix.
+     @param b       The N * K matrix.
+     @param M       The number of rows of @e a and the result.
+     @param N       The number of rows of @e b and columns of the result.
+     @param K       The number of columns of @e a and @e b. */\
+    static PLANK_INLINE_LOW void pl_VectorMatrixMulNT##TYPECODE (TYPE* result, const TYPE* a, const TYPE* b, PlankUL M, PlankUL N, PlankUL K) {\
+        TYPE sums[8]; const TYPE* ai; const TYPE* bj[4]; TYPE* ri; PlankUL blockRows, j0, j1, i, j, r, k;\
+        blockRows = (PLANK_VECTORMATRIX_BLOCKBYTES / sizeof (TYPE)) / (K > 0 ? K : 1);\
+        blockRows = blockRows < 4 ? 4 : blockRows & ~(PlankUL)3;\
+        for (j0 = 0; j0 < N; j0 += blockRows) {\
+            j1 = (j0 + blockRows < N) ? j0 + blockRows : N;\
+            for (i = 0, ai = a, ri = result; i < M; i += 2, ai += K * 2, ri += N * 2) {\
+                for (j = j0; j < j1; j += 4) {\
+                    for (r = 0; r < 4; PLANK_INC (r))\
+                        bj[r] = b + ((j + r < j1) ? j + r : j) * K;\
+                    for (r = 0; r < 8; PLANK_INC (r))\
+                        sums[r] = (TYPE)0;\
+                    k = 0;\
+                    if (i + 1 < M) {\
+                        PLANK_VECTORMATRIXMULNT_LANES8(TYPECODE)\
+                        pl_VectorMatrixDots8Scalar##TYPECODE (sums, ai, ai + K, bj[0], bj[1], bj[2], bj[3], k, K);\
+                        for (r = 0; (r < 4) && (j + r < j1); PLANK_INC (r))\
+                            ri[N + j + r] = sums[4 + r];\
+                    } else {\
+                        PLANK_VECTORMATRIXMULNT_LANES4(TYPECODE)\
+                        pl_VectorMatrixDots4Scalar##TYPECODE (sums, ai, bj[0], bj[1], bj[2], bj[3], k, K);\
+                    }\
+                    for (r = 0; (r < 4) && (j + r < j1); PLANK_INC (r))\
+                        ri[j + r] = sums[r];\
+                }\
+            }\
+        }\
+    }
+
+#if defined(PLANK_VEC_SSE) && PLANK_VEC_SSE
+    #define PLANK_VECTORMATRIXMULNT_LANES4(TYPECODE) \
+        PLANK_SSE_AVXDISPATCH(k = pl_VectorMatrixDots4AVX##TYPECODE (sums, ai, bj[0], bj[1], bj[2], bj[3], k, K))\
+        k = pl_VectorMatrixDots4SSE##TYPECODE (sums, ai, bj[0], bj[1], bj[2], bj[3], k, K);
+    #define PLANK_VECTORMATRIXMULNT_LANES8(TYPECODE) \
+        PLANK_SSE_AVXDISPATCH(k = pl_VectorMatrixDots8AVX##TYPECODE (sums, ai, ai + K, bj[0], bj[1], bj[2], bj[3], k, K))\
+        k = pl_VectorMatrixDots8SSE##TYPECODE (sums, ai, ai + K, bj[0], bj[1], bj[2], bj[3], k, K);
+#else
+    #define PLANK_VECTORMATRIXMULNT_LANES4(TYPECODE)
+    #define PLANK_VECTORMATRIXMULNT_LANES8(TYPECODE)
+#endif
+
+PLANK_VECTORMATRIXMULNT_DEFINE(F,float)
+PLANK_VECTORMATRIXMULNT_DEFINE(D,double)
+
+#define PLANK_VECTORMATRIXTRANSPOSE_DEFINE(TYPECODE,TYPE) \
+    /** Transposes a matrix, a tile at a time so both sides stay in the cache.
+     @param result  The columns * rows result (which must not overlap the input).
+     @param input   The rows * columns matrix.
+     @param rows    The number of rows of the input.
+     @param columns The number of columns of the input. */\
+    static PLANK_INLINE_LOW void pl_VectorMatrixTranspose##TYPECODE (TYPE* result, const TYPE* input, PlankUL rows, PlankUL columns) {\
+        PlankUL i0, j0, i1, j1, i, j;\
+        for (i0 = 0; i0 < rows; i0 += 16) {\
+            i1 = (i0 + 16 < rows) ? i0 + 16 : rows;\
+            for (j0 = 0; j0 < columns; j0 += 16) {\
+                j1 = (j0 + 16 < columns) ? j0 + 16 : columns;\
+                for (i = i0; i < i1; PLANK_INC (i))\
+                    for (j = j0; j < j1; PLANK_INC (j))\
+                        result[j * rows + i] = input[i * columns + j];\
+            }\
+        }\
+    }
+
+PLANK_VECTORMATRIXTRANSPOSE_DEFINE(F,float)
+PLANK_VECTORMATRIXTRANSPOSE_DEFINE(D,double)
+
+/// @} // End group PlankVectorMatrixFunctions
+
 
 #endif // PLANK_VECTORS_H
 
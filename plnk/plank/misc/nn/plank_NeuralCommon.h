@@ -45,6 +45,7 @@
 typedef struct PlankNeuralNodeF* PlankNeuralNodeFRef;
 typedef struct PlankNeuralNetworkF* PlankNeuralNetworkFRef;
 typedef struct PlankNeuralLayerF* PlankNeuralLayerFRef;
+typedef struct PlankNeuralBatchF* PlankNeuralBatchFRef;
 #endif
 
 #endif // PLANK_NEURALCOMMON_H
@@ -42,9 +42,26 @@
 #include "plank_NeuralNode.h"
 #include "plank_NeuralLayer.h"
 #include "../../maths/vectors/plank_Vectors.h"
-//#include "../../random/plank_RNG.h"
+#include "../../random/plank_RNG.h"
 
+static PLANK_INLINE_LOW float* pl_NeuralLayerF_GetRow (PlankNeuralLayerFRef p, const int nodeIndex)
+{
+    return (float*)pl_DynamicArray_GetArray (&p->weightMatrix) + nodeIndex * (int)pl_DynamicArray_GetSize (&p->inputVector);
+}
+
+static PlankResult pl_NeuralLayerF_InitVectors (PlankNeuralLayerFRef p, const int numNodes, const int numPreviousNodes)
+{
+    PlankResult result = PlankResult_OK;
+
+    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->weightMatrix, sizeof (PlankF), numNodes * numPreviousNodes, PLANK_TRUE)) != PlankResult_OK) goto exit;
+    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->thresholdVector, sizeof (PlankF), numNodes, PLANK_TRUE)) != PlankResult_OK) goto exit;
+    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->outputVector, sizeof (PlankF), numNodes, PLANK_TRUE)) != PlankResult_OK) goto exit;
+    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->inputVector, sizeof (PlankF), numPreviousNodes, PLANK_TRUE)) != PlankResult_OK) goto exit;
+    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->adjustVector, sizeof (PlankF), numPreviousNodes, PLANK_TRUE)) != PlankResult_OK) goto exit;
 
+exit:
+    return result;
+}
 
 PlankResult pl_NeuralLayerF_InitNumNodesAndPrevious (PlankNeuralLayerFRef p, PlankNeuralNetworkFRef network, const int numNodes, const int numPreviousNodes)
 {
@@ -54,8 +71,6 @@ PlankResult pl_NeuralLayerF_InitNumNodesAndPrevious (PlankNeuralLayerFRef p, Pla
 PlankResult pl_NeuralLayerF_InitNumNodesPreviousWithRange (PlankNeuralLayerFRef p, PlankNeuralNetworkFRef network, const int numNodes, const int numPreviousNodes, const float range)
 {
     PlankResult result;
-    int numNodesChecked, numPreviousNodesChecked, i;
-    PlankNeuralNodeF* nodeArray;
     
     result = PlankResult_OK;
     
@@ -67,23 +82,13 @@ PlankResult pl_NeuralLayerF_InitNumNodesPreviousWithRange (PlankNeuralLayerFRef
     
     pl_MemoryZero (p, sizeof (PlankNeuralLayerF));
     
-    numNodesChecked = pl_MaxI (1, numNodes);
-    numPreviousNodesChecked = pl_MaxI (1, numPreviousNodes);
+    p->network = network;
     
-    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->nodes, sizeof (PlankNeuralNodeF), numNodesChecked, PLANK_FALSE)) != PlankResult_OK)
+    if ((result = pl_NeuralLayerF_InitVectors (p, pl_MaxI (1, numNodes), pl_MaxI (1, numPreviousNodes))) != PlankResult_OK)
         goto exit;
     
-    nodeArray = (PlankNeuralNodeF*)pl_DynamicArray_GetArray (&p->nodes);
-    
-    for (i = 0; i < numNodesChecked; ++i)
-    {
-        if ((result = pl_NeuralNodeF_InitWithNumWeightsAndRange (&nodeArray[i], network, numPreviousNodesChecked, range)) != PlankResult_OK)
-            goto exit;
-    }
-
-    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->outputVector, sizeof (PlankF), numNodesChecked, PLANK_TRUE)) != PlankResult_OK) goto exit;    
-    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->inputVector, sizeof (PlankF), numPreviousNodesChecked, PLANK_TRUE)) != PlankResult_OK) goto exit;
-    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->adjustVector, sizeof (PlankF), numPreviousNodesChecked, PLANK_TRUE)) != PlankResult_OK) goto exit;
+    if ((result = pl_NeuralLayerF_Randomise (p, range)) != PlankResult_OK)
+        goto exit;
 
 exit:
     return result;
@@ -92,8 +97,6 @@ exit:
 PlankResult pl_NeuralLayerF_DeInit (PlankNeuralLayerFRef p)
 {
     PlankResult result;
-    int numNodes, i;
-    PlankNeuralNodeF* nodeArray;
 
     result = PlankResult_OK;
 
@@ -103,13 +106,8 @@ PlankResult pl_NeuralLayerF_DeInit (PlankNeuralLayerFRef p)
         goto exit;
     }
     
-    numNodes = (int)pl_DynamicArray_GetSize (&p->nodes);
-    nodeArray = (PlankNeuralNodeF*)pl_DynamicArray_GetArray (&p->nodes);
-
-    for (i = 0; i < numNodes; ++i)
-        pl_NeuralNodeF_DeInit (&nodeArray[i]);
-    
-    pl_DynamicArray_DeInit (&p->nodes);
+    pl_DynamicArray_DeInit (&p->weightMatrix);
+    pl_DynamicArray_DeInit (&p->thresholdVector);
     pl_DynamicArray_DeInit (&p->outputVector);
     pl_DynamicArray_DeInit (&p->inputVector);
     pl_DynamicArray_DeInit (&p->adjustVector);
@@ -122,52 +120,66 @@ exit:
 
 PlankResult pl_NeuralLayerF_Reset (PlankNeuralLayerFRef p, const float amount)
 {
-    PlankResult result;
-    int numNodes, i;
-    PlankNeuralNodeF* nodeArray;
+    PlankRNGRef r;
+    float amount2;
+    float* weightMatrixPtr;
+    float* thresholdVectorPtr;
+    int numNodes, numInputs, i, j;
+    
+    weightMatrixPtr = (float*)pl_DynamicArray_GetArray (&p->weightMatrix);
+    thresholdVectorPtr = (float*)pl_DynamicArray_GetArray (&p->thresholdVector);
+    numNodes = (int)pl_DynamicArray_GetSize (&p->outputVector);
+    numInputs = (int)pl_DynamicArray_GetSize (&p->inputVector);
+    r = pl_RNGGlobal();
     
-    result = PlankResult_OK;
-    numNodes = (int)pl_DynamicArray_GetSize (&p->nodes);
-    nodeArray = (PlankNeuralNodeF*)pl_DynamicArray_GetArray (&p->nodes);
+    amount2 = amount * 2.f;
     
-    for (i = 0; i < numNodes; ++i)
+    // same order as the nodes were randomised, the weights then the threshold
+    for (i = 0; i < numNodes; ++i, weightMatrixPtr += numInputs)
     {
-        if ((result = pl_NeuralNodeF_Reset (&nodeArray[i], amount)) != PlankResult_OK)
-            goto exit;
+        for (j = 0; j < numInputs; ++j)
+            weightMatrixPtr[j] = pl_RNG_NextFloat (r) * amount2 - amount;
+        
+        thresholdVectorPtr[i] = pl_RNG_NextFloat (r) * amount2 - amount;
     }
     
-exit:
-    return result;
+    return PlankResult_OK;
 }
 
 PlankResult pl_NeuralLayerF_Randomise (PlankNeuralLayerFRef p, const float amount)
 {
-    PlankResult result;
-    int numNodes, i;
-    PlankNeuralNodeF* nodeArray;
+    PlankRNGRef r;
+    float amount2;
+    float* weightMatrixPtr;
+    float* thresholdVectorPtr;
+    int numNodes, numInputs, i, j;
+    
+    weightMatrixPtr = (float*)pl_DynamicArray_GetArray (&p->weightMatrix);
+    thresholdVectorPtr = (float*)pl_DynamicArray_GetArray (&p->thresholdVector);
+    numNodes = (int)pl_DynamicArray_GetSize (&p->outputVector);
+    numInputs = (int)pl_DynamicArray_GetSize (&p->inputVector);
+    r = pl_RNGGlobal();
     
-    result = PlankResult_OK;
-    numNodes = (int)pl_DynamicArray_GetSize (&p->nodes);
-    nodeArray = (PlankNeuralNodeF*)pl_DynamicArray_GetArray (&p->nodes);
-
-    for (i = 0; i < numNodes; ++i)
+    amount2 = amount * 2.f;
+    
+    for (i = 0; i < numNodes; ++i, weightMatrixPtr += numInputs)
     {
-        if ((result = pl_NeuralNodeF_Randomise (&nodeArray[i], amount)) != PlankResult_OK)
-            goto exit;
+        for (j = 0; j < numInputs; ++j)
+            weightMatrixPtr[j] += pl_RNG_NextFloat (r) * amount2 - amount;
+        
+        thresholdVectorPtr[i] += pl_RNG_NextFloat (r) * amount2 - amount;
     }
     
-exit:
-    return result;
+    return PlankResult_OK;
 }
 
 PlankResult pl_NeuralLayerF_SetNode (PlankNeuralLayerFRef p, const int nodeIndex, const float* weights, const float threshold)
 {
     PlankResult result;
     int numNodes;
-    PlankNeuralNodeF* nodeArray;
     
     result = PlankResult_OK;
-    numNodes = (int)pl_DynamicArray_GetSize (&p->nodes);
+    numNodes = (int)pl_DynamicArray_GetSize (&p->outputVector);
 
     if ((nodeIndex < 0) || (nodeIndex >= numNodes))
     {
@@ -175,8 +187,8 @@ PlankResult pl_NeuralLayerF_SetNode (PlankNeuralLayerFRef p, const int nodeIndex
         goto exit;
     }
     
-    nodeArray = (PlankNeuralNodeF*)pl_DynamicArray_GetArray (&p->nodes);
-    result = pl_NeuralNodeF_Set (&nodeArray[nodeIndex], weights, threshold);
+    pl_VectorMoveF_NN (pl_NeuralLayerF_GetRow (p, nodeIndex), weights, pl_DynamicArray_GetSize (&p->inputVector));
+    ((float*)pl_DynamicArray_GetArray (&p->thresholdVector))[nodeIndex] = threshold;
     
 exit:
     return result;
@@ -186,10 +198,9 @@ PlankResult pl_NeuralLayerF_SetThreshold (PlankNeuralLayerFRef p, const int node
 {
     PlankResult result;
     int numNodes;
-    PlankNeuralNodeF* nodeArray;
     
     result = PlankResult_OK;
-    numNodes = (int)pl_DynamicArray_GetSize (&p->nodes);
+    numNodes = (int)pl_DynamicArray_GetSize (&p->outputVector);
     
     if ((nodeIndex < 0) || (nodeIndex >= numNodes))
     {
@@ -197,8 +208,7 @@ PlankResult pl_NeuralLayerF_SetThreshold (PlankNeuralLayerFRef p, const int node
         goto exit;
     }
     
-    nodeArray = (PlankNeuralNodeF*)pl_DynamicArray_GetArray (&p->nodes);
-    result = pl_NeuralNodeF_SetThreshold (&nodeArray[nodeIndex], threshold);
+    ((float*)pl_DynamicArray_GetArray (&p->thresholdVector))[nodeIndex] = threshold;
     
 exit:
     return result;
@@ -207,20 +217,19 @@ exit:
 PlankResult pl_NeuralLayerF_SetWeight (PlankNeuralLayerFRef p, const int nodeIndex, const int weightIndex, const float weight)
 {
     PlankResult result;
-    int numNodes;
-    PlankNeuralNodeF* nodeArray;
+    int numNodes, numInputs;
     
     result = PlankResult_OK;
-    numNodes = (int)pl_DynamicArray_GetSize (&p->nodes);
+    numNodes = (int)pl_DynamicArray_GetSize (&p->outputVector);
+    numInputs = (int)pl_DynamicArray_GetSize (&p->inputVector);
     
-    if ((nodeIndex < 0) || (nodeIndex >= numNodes))
+    if ((nodeIndex < 0) || (nodeIndex >= numNodes) || (weightIndex < 0) || (weightIndex >= numInputs))
     {
         result = PlankResult_IndexOutOfRange;
         goto exit;
     }
     
-    nodeArray = (PlankNeuralNodeF*)pl_DynamicArray_GetArray (&p->nodes);
-    result = pl_NeuralNodeF_SetWeight (&nodeArray[nodeIndex], weightIndex, weight);
+    pl_NeuralLayerF_GetRow (p, nodeIndex)[weightIndex] = weight;
     
 exit:
     return result;
@@ -230,10 +239,9 @@ PlankResult pl_NeuralLayerF_GetNode (PlankNeuralLayerFRef p, const int nodeIndex
 {
     PlankResult result;
     int numNodes;
-    PlankNeuralNodeF* nodeArray;
     
     result = PlankResult_OK;
-    numNodes = (int)pl_DynamicArray_GetSize (&p->nodes);
+    numNodes = (int)pl_DynamicArray_GetSize (&p->outputVector);
     
     if ((nodeIndex < 0) || (nodeIndex >= numNodes))
     {
@@ -241,8 +249,8 @@ PlankResult pl_NeuralLayerF_GetNode (PlankNeuralLayerFRef p, const int nodeIndex
         goto exit;
     }
     
-    nodeArray = (PlankNeuralNodeF*)pl_DynamicArray_GetArray (&p->nodes);
-    result = pl_NeuralNodeF_Get (&nodeArray[nodeIndex], weights, threshold);
+    pl_VectorMoveF_NN (weights, pl_NeuralLayerF_GetRow (p, nodeIndex), pl_DynamicArray_GetSize (&p->inputVector));
+    *threshold = ((const float*)pl_DynamicArray_GetArray (&p->thresholdVector))[nodeIndex];
     
 exit:
     return result;
@@ -251,51 +259,163 @@ exit:
 PlankResult pl_NeuralLayerF_Propogate (PlankNeuralLayerFRef p, const float* inputs)
 {
     PlankResult result;
-    int numNodes, numInputs, i;
-    PlankNeuralNodeF* nodeArray;
+    int numInputs;
     float* inputVectorPtr;
-    float* outputVectorPtr;
     
     result = PlankResult_OK;
-    numNodes = (int)pl_DynamicArray_GetSize (&p->nodes);
     numInputs = (int)pl_DynamicArray_GetSize (&p->inputVector);
-    
     inputVectorPtr = (float*)pl_DynamicArray_GetArray (&p->inputVector);
-    outputVectorPtr = (float*)pl_DynamicArray_GetArray (&p->outputVector);
-    nodeArray = (PlankNeuralNodeF*)pl_DynamicArray_GetArray (&p->nodes);
 
     pl_VectorMoveF_NN (inputVectorPtr, inputs, numInputs);
-
-    for (i = 0; i < numNodes; ++i)
-        outputVectorPtr[i] = pl_NeuralNodeF_Propogate (&nodeArray[i], inputVectorPtr);
+    
+    result = pl_NeuralLayerF_PropogateBatch (p, (float*)pl_DynamicArray_GetArray (&p->outputVector), inputVectorPtr, 1);
         
-//exit:
     return result;
 }
 
 PlankResult pl_NeuralLayerF_BackProp (PlankNeuralLayerFRef p, const float* errors, const float actFuncOffset, const float learnRate)
 {
     PlankResult result;
-    int numNodes, i;
-    PlankNeuralNodeF* nodeArray;
+    int numNodes, numInputs, i;
     const float* inputVectorPtr;
+    const float* outputVectorPtr;
     float* adjustVectorPtr;
+    float* weightMatrixPtr;
+    float* thresholdVectorPtr;
+    float output, adjust, learn;
    
     result = PlankResult_OK;
-    numNodes = (int)pl_DynamicArray_GetSize (&p->nodes);
+    numNodes = (int)pl_DynamicArray_GetSize (&p->outputVector);
+    numInputs = (int)pl_DynamicArray_GetSize (&p->inputVector);
     
     pl_DynamicArray_Zero (&p->adjustVector);
     
     inputVectorPtr = (const float*)pl_DynamicArray_GetArray (&p->inputVector);
+    outputVectorPtr = (const float*)pl_DynamicArray_GetArray (&p->outputVector);
     adjustVectorPtr = (float*)pl_DynamicArray_GetArray (&p->adjustVector);
-    nodeArray = (PlankNeuralNodeF*)pl_DynamicArray_GetArray (&p->nodes);
+    weightMatrixPtr = (float*)pl_DynamicArray_GetArray (&p->weightMatrix);
+    thresholdVectorPtr = (float*)pl_DynamicArray_GetArray (&p->thresholdVector);
 
-    for (i = 0; i < numNodes; ++i)
-        pl_NeuralNodeF_BackProp (&nodeArray[i], inputVectorPtr, errors[i], actFuncOffset, learnRate, adjustVectorPtr);
+    // a row at a time, each node's adjustment uses its updated weights as the nodes did
+    for (i = 0; i < numNodes; ++i, weightMatrixPtr += numInputs)
+    {
+        output = outputVectorPtr[i];
+        adjust = errors[i] * (actFuncOffset + (output * (1.f - output)));
+        learn = adjust * learnRate;
+        
+        pl_VectorMulAddF_NN1N (weightMatrixPtr, inputVectorPtr, learn, weightMatrixPtr, numInputs);
+        pl_VectorMulAddF_NN1N (adjustVectorPtr, weightMatrixPtr, adjust, adjustVectorPtr, numInputs);
+        
+        thresholdVectorPtr[i] += learn;
+    }
+    
+    return result;
+}
+
+PlankResult pl_NeuralLayerF_PropogateBatch (PlankNeuralLayerFRef p, float* outputs, const float* inputs, const int numPatterns)
+{
+    PlankResult result;
+    PlankNeuralNetworkFActFunction actFunc;
+    int numNodes, numInputs, i, j;
+    const float* thresholdVectorPtr;
+    
+    result = PlankResult_OK;
+    numNodes = (int)pl_DynamicArray_GetSize (&p->outputVector);
+    numInputs = (int)pl_DynamicArray_GetSize (&p->inputVector);
+    thresholdVectorPtr = (const float*)pl_DynamicArray_GetArray (&p->thresholdVector);
+    actFunc = p->network->actFunc;
+    
+    if (numPatterns < 1)
+    {
+        result = PlankResult_ItemCountInvalid;
+        goto exit;
+    }
+    
+    pl_VectorMatrixMulNTF (outputs, inputs, (const float*)pl_DynamicArray_GetArray (&p->weightMatrix), numPatterns, numNodes, numInputs);
+    
+    for (i = 0; i < numPatterns; ++i, outputs += numNodes)
+    {
+        for (j = 0; j < numNodes; ++j)
+            outputs[j] = actFunc (outputs[j] + thresholdVectorPtr[j]);
+    }
     
+exit:
     return result;
 }
 
+int pl_NeuralLayerF_GetBatchScratchSize (PlankNeuralLayerFRef p, const int numPatterns)
+{
+    int numNodes, numInputs;
+    
+    numNodes = (int)pl_DynamicArray_GetSize (&p->outputVector);
+    numInputs = (int)pl_DynamicArray_GetSize (&p->inputVector);
+    
+    return pl_MaxI ((numNodes + numInputs) * numPatterns, numNodes * numInputs);
+}
+
+PlankResult pl_NeuralLayerF_GradientBatch (PlankNeuralLayerFRef p, float* weightGradient, float* thresholdGradient, float* previousErrors, float* errors, const float* outputs, const float* inputs, const int numPatterns, const float actFuncOffset, float* scratch)
+{
+    PlankResult result;
+    int numNodes, numInputs, size, i;
+    float* adjustsTransposed;
+    float* inputsTransposed;
+    float output;
+    
+    result = PlankResult_OK;
+    numNodes = (int)pl_DynamicArray_GetSize (&p->outputVector);
+    numInputs = (int)pl_DynamicArray_GetSize (&p->inputVector);
+    size = numNodes * numPatterns;
+    
+    if (numPatterns < 1)
+    {
+        result = PlankResult_ItemCountInvalid;
+        goto exit;
+    }
+    
+    for (i = 0; i < size; ++i)
+    {
+        output = outputs[i];
+        errors[i] *= actFuncOffset + (output * (1.f - output));
+    }
+    
+    pl_VectorMoveF_NN (thresholdGradient, errors, numNodes);
+    
+    for (i = 1; i < numPatterns; ++i)
+        pl_VectorAddF_NNN (thresholdGradient, thresholdGradient, errors + i * numNodes, numNodes);
+    
+    // the weight gradient is the adjustments (transposed) times the inputs
+    adjustsTransposed = scratch;
+    inputsTransposed = scratch + size;
+    
+    pl_VectorMatrixTransposeF (adjustsTransposed, errors, numPatterns, numNodes);
+    pl_VectorMatrixTransposeF (inputsTransposed, inputs, numPatterns, numInputs);
+    pl_VectorMatrixMulNTF (weightGradient, adjustsTransposed, inputsTransposed, numNodes, numInputs, numPatterns);
+    
+    // and the previous layer's errors are the adjustments times the weights
+    if (previousErrors != PLANK_NULL)
+    {
+        pl_VectorMatrixTransposeF (scratch, (const float*)pl_DynamicArray_GetArray (&p->weightMatrix), numNodes, numInputs);
+        pl_VectorMatrixMulNTF (previousErrors, errors, scratch, numPatterns, numInputs, numNodes);
+    }
+    
+exit:
+    return result;
+}
+
+PlankResult pl_NeuralLayerF_ApplyGradient (PlankNeuralLayerFRef p, const float* weightGradient, const float* thresholdGradient, const float amount)
+{
+    float* weightMatrixPtr;
+    float* thresholdVectorPtr;
+    
+    weightMatrixPtr = (float*)pl_DynamicArray_GetArray (&p->weightMatrix);
+    thresholdVectorPtr = (float*)pl_DynamicArray_GetArray (&p->thresholdVector);
+    
+    pl_VectorMulAddF_NN1N (weightMatrixPtr, weightGradient, amount, weightMatrixPtr, pl_DynamicArray_GetSize (&p->weightMatrix));
+    pl_VectorMulAddF_NN1N (thresholdVectorPtr, thresholdGradient, amount, thresholdVectorPtr, pl_DynamicArray_GetSize (&p->thresholdVector));
+    
+    return PlankResult_OK;
+}
+
 PlankResult pl_NeuralLayerF_GetOutputs (PlankNeuralLayerFRef p, float* outputs)
 {
     PlankResult result;
@@ -332,8 +452,8 @@ int pl_NeuralLayerF_GetNumOutputs (PlankNeuralLayerFRef p)
 PlankResult pl_NeuralLayerF_ToJSON (PlankNeuralLayerFRef p, PlankJSONRef j, const PlankB useBinary)
 {
     PlankResult result;
-    int i, numNodes;
-    PlankNeuralNodeF* nodeArray;
+    int i, numNodes, numInputs;
+    const float* thresholdVectorPtr;
     PlankJSONRef jlayer;
     PlankJSONRef jnodes;
     
@@ -345,12 +465,14 @@ PlankResult pl_NeuralLayerF_ToJSON (PlankNeuralLayerFRef p, PlankJSONRef j, cons
     pl_JSON_ObjectSetType (jlayer, PLANK_NEURALLAYERF_JSON_TYPE);
     pl_JSON_ObjectSetVersionString (jlayer, PLANK_NEURALLAYERF_JSON_VERSION);
 
-    numNodes = (int)pl_DynamicArray_GetSize (&p->nodes);
-    nodeArray = (PlankNeuralNodeF*)pl_DynamicArray_GetArray (&p->nodes);
+    numNodes = (int)pl_DynamicArray_GetSize (&p->outputVector);
+    numInputs = (int)pl_DynamicArray_GetSize (&p->inputVector);
+    thresholdVectorPtr = (const float*)pl_DynamicArray_GetArray (&p->thresholdVector);
     
+    // each row is stored as a node so the format is unchanged
     for (i = 0; i < numNodes; ++i)
 	{        
-        if ((result = pl_NeuralNodeF_ToJSON (&nodeArray[i], jnodes, useBinary)) != PlankResult_OK)
+        if ((result = pl_NeuralNodeF_WeightsToJSON (pl_NeuralLayerF_GetRow (p, i), numInputs, thresholdVectorPtr[i], jnodes, useBinary)) != PlankResult_OK)
             goto exit;
     }
     
@@ -365,11 +487,14 @@ PlankResult pl_NeuralLayerF_InitFromJSON (PlankNeuralLayerFRef p, PlankNeuralNet
 {
     PlankResult result;
     PlankJSONRef jnodes;
+    PlankDynamicArray weights;
     int numNodes, numPreviousNodes, i;
-    PlankNeuralNodeF* nodeArray;
+    float threshold;
     
     result = PlankResult_OK;
     
+    pl_MemoryZero (&weights, sizeof (PlankDynamicArray));
+    
     if (p == PLANK_NULL)
     {
         result = PlankResult_MemoryError;
@@ -377,6 +502,7 @@ PlankResult pl_NeuralLayerF_InitFromJSON (PlankNeuralLayerFRef p, PlankNeuralNet
     }
     
     pl_MemoryZero (p, sizeof (PlankNeuralLayerF));
+    p->network = network;
     
     if (!pl_JSON_IsObjectType (j, PLANK_NEURALLAYERF_JSON_TYPE))
     {
@@ -410,23 +536,34 @@ PlankResult pl_NeuralLayerF_InitFromJSON (PlankNeuralLayerFRef p, PlankNeuralNet
         goto exit;
     }
     
-    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->nodes, sizeof (PlankNeuralNodeF), numNodes, PLANK_FALSE)) != PlankResult_OK) goto exit;
-    
-    nodeArray = (PlankNeuralNodeF*)pl_DynamicArray_GetArray (&p->nodes);
+    numPreviousNodes = 0;
     
     for (i = 0; i < numNodes; ++i)
     {
-        if ((result = pl_NeuralNodeF_InitFromJSON (&nodeArray[i], network, pl_JSON_ArrayAt (jnodes, i))) != PlankResult_OK)
+        pl_DynamicArray_DeInit (&weights);
+        
+        if ((result = pl_NeuralNodeF_WeightsFromJSON (pl_JSON_ArrayAt (jnodes, i), &weights, &threshold)) != PlankResult_OK)
+            goto exit;
+        
+        if (i == 0)
+        {
+            numPreviousNodes = (int)pl_DynamicArray_GetSize (&weights);
+            
+            if ((result = pl_NeuralLayerF_InitVectors (p, numNodes, numPreviousNodes)) != PlankResult_OK)
+                goto exit;
+        }
+        else if ((int)pl_DynamicArray_GetSize (&weights) != numPreviousNodes)
+        {
+            result = PlankResult_JSONError;
+            goto exit;
+        }
+        
+        if ((result = pl_NeuralLayerF_SetNode (p, i, (const float*)pl_DynamicArray_GetArray (&weights), threshold)) != PlankResult_OK)
             goto exit;
     }
-    
-    numPreviousNodes = pl_NeuralNodeF_GetNumWeights (&nodeArray[0]);
-    
-    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->outputVector, sizeof (PlankF), numNodes, PLANK_TRUE)) != PlankResult_OK) goto exit;
-    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->inputVector, sizeof (PlankF), numPreviousNodes, PLANK_TRUE)) != PlankResult_OK) goto exit;
-    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->adjustVector, sizeof (PlankF), numPreviousNodes, PLANK_TRUE)) != PlankResult_OK) goto exit;
         
 exit:
+    pl_DynamicArray_DeInit (&weights);
     return result;
 }
 
@@ -54,6 +54,9 @@
 PLANK_BEGIN_C_LINKAGE
 
 /** A neural layer.
+ The weights are stored as a row-major matrix, one row of weights for each 
+ node, so a layer's nodes are propogated together as a matrix-vector product
+ (or a matrix multiply for batches of input vectors).
   
  @defgroup PlankNeuralLayerFClass Plank NeuralNetwork class
  @ingroup PlankClasses
@@ -95,6 +98,38 @@ int pl_NeuralLayerF_GetNumOutputs (PlankNeuralLayerFRef p);
 PlankResult pl_NeuralLayerF_ToJSON (PlankNeuralLayerFRef p, PlankJSONRef j, const PlankB useBinary);
 PlankResult pl_NeuralLayerF_InitFromJSON (PlankNeuralLayerFRef p, PlankNeuralNetworkFRef network, PlankJSONRef j);
 
+/** Propogates a batch of input vectors through the layer.
+ This uses the layer's weights but none of its other state so several threads
+ may propogate batches through the same layer as long as none change the weights.
+ @param p The <i>Plank %NeuralLayerF</i> object.
+ @param outputs Receives numPatterns rows of pl_NeuralLayerF_GetNumOutputs() values.
+ @param inputs The numPatterns rows of pl_NeuralLayerF_GetNumInputs() values.
+ @param numPatterns The number of input vectors.
+ @return PlankResult_OK if successful, otherwise an error code. */
+PlankResult pl_NeuralLayerF_PropogateBatch (PlankNeuralLayerFRef p, float* outputs, const float* inputs, const int numPatterns);
+
+/** The number of floats of scratch space pl_NeuralLayerF_GradientBatch() needs. */
+int pl_NeuralLayerF_GetBatchScratchSize (PlankNeuralLayerFRef p, const int numPatterns);
+
+/** Calculates the gradients for a batch without changing the weights.
+ The gradients are summed over the batch, pl_NeuralLayerF_ApplyGradient() applies them.
+ @param p The <i>Plank %NeuralLayerF</i> object.
+ @param weightGradient Receives the gradient of each weight (the size of the weight matrix).
+ @param thresholdGradient Receives the gradient of each threshold.
+ @param previousErrors Receives the errors for the previous layer (numPatterns rows 
+                       of pl_NeuralLayerF_GetNumInputs() values), this may be @c NULL.
+ @param errors The errors of this layer's outputs, these are replaced by the adjustments.
+ @param outputs The outputs from pl_NeuralLayerF_PropogateBatch().
+ @param inputs The inputs that were given to pl_NeuralLayerF_PropogateBatch().
+ @param numPatterns The number of patterns in the batch.
+ @param actFuncOffset The network's activation function offset.
+ @param scratch At least pl_NeuralLayerF_GetBatchScratchSize() floats.
+ @return PlankResult_OK if successful, otherwise an error code. */
+PlankResult pl_NeuralLayerF_GradientBatch (PlankNeuralLayerFRef p, float* weightGradient, float* thresholdGradient, float* previousErrors, float* errors, const float* outputs, const float* inputs, const int numPatterns, const float actFuncOffset, float* scratch);
+
+/** Adds gradients scaled by @e amount to the weights and thresholds. */
+PlankResult pl_NeuralLayerF_ApplyGradient (PlankNeuralLayerFRef p, const float* weightGradient, const float* thresholdGradient, const float amount);
+
 
 
 
@@ -103,7 +138,9 @@ PLANK_END_C_LINKAGE
 #if !DOXYGEN
 typedef struct PlankNeuralLayerF
 {
-    PlankDynamicArray nodes;
+    PlankNeuralNetworkFRef network;
+    PlankDynamicArray weightMatrix;
+    PlankDynamicArray thresholdVector;
     PlankDynamicArray outputVector;
     PlankDynamicArray inputVector;
     PlankDynamicArray adjustVector;
@@ -522,3 +522,246 @@ PlankResult pl_NeuralNetworkF_InitFromJSON (PlankNeuralNetworkFRef p, PlankJSONR
 exit:
     return result;
 }
+
+PlankResult pl_NeuralNetworkF_ApplyBatch (PlankNeuralNetworkFRef p, PlankNeuralBatchFRef batch, const int totalPatterns)
+{
+    PlankResult result;
+    int numLayers, numNodes, numWeights, i;
+    PlankNeuralLayerF* layerArray;
+    const float* gradients;
+    float amount;
+    
+    result = PlankResult_OK;
+    
+    if ((batch->network != p) || (totalPatterns < 1))
+    {
+        result = PlankResult_ArrayParameterError;
+        goto exit;
+    }
+    
+    numLayers = (int)pl_DynamicArray_GetSize (&p->layers);
+    layerArray = (PlankNeuralLayerF*)pl_DynamicArray_GetArray (&p->layers);
+    gradients = (const float*)pl_DynamicArray_GetArray (&batch->gradients);
+    amount = p->learnRate / (float)totalPatterns;
+    
+    for (i = 0; i < numLayers; ++i)
+    {
+        numNodes = pl_NeuralLayerF_GetNumOutputs (&layerArray[i]);
+        numWeights = numNodes * pl_NeuralLayerF_GetNumInputs (&layerArray[i]);
+        
+        if ((result = pl_NeuralLayerF_ApplyGradient (&layerArray[i], gradients, gradients + numWeights, amount)) != PlankResult_OK) goto exit;
+        
+        gradients += numWeights + numNodes;
+    }
+    
+exit:
+    return result;
+}
+
+PlankResult pl_NeuralNetworkF_BackPropBatch (PlankNeuralNetworkFRef p, PlankNeuralBatchFRef batch, const float* inputs, const float* targets, const int numPatterns)
+{
+    PlankResult result;
+    
+    result = PlankResult_OK;
+
+    if (batch->network != p)
+    {
+        result = PlankResult_ArrayParameterError;
+        goto exit;
+    }
+    
+    if ((result = pl_NeuralBatchF_Gradient (batch, inputs, targets, numPatterns)) != PlankResult_OK) goto exit;
+    if ((result = pl_NeuralNetworkF_ApplyBatch (p, batch, numPatterns)) != PlankResult_OK) goto exit;
+
+exit:
+    return result;
+}
+
+//------------------------------------------------------------------------------
+
+PlankResult pl_NeuralBatchF_Init (PlankNeuralBatchFRef p, PlankNeuralNetworkFRef network, const int maxPatterns)
+{
+    PlankResult result;
+    int numLayers, numNodes, numInputs, numActivations, numGradients, scratchSize, i;
+    PlankNeuralLayerF* layerArray;
+    
+    result = PlankResult_OK;
+    
+    if (p == PLANK_NULL)
+    {
+        result = PlankResult_MemoryError;
+        goto exit;
+    }
+    
+    pl_MemoryZero (p, sizeof (PlankNeuralBatchF));
+    
+    if (maxPatterns < 1)
+    {
+        result = PlankResult_ItemCountInvalid;
+        goto exit;
+    }
+    
+    p->network = network;
+    p->maxPatterns = maxPatterns;
+    
+    numLayers = (int)pl_DynamicArray_GetSize (&network->layers);
+    layerArray = (PlankNeuralLayerF*)pl_DynamicArray_GetArray (&network->layers);
+    numActivations = 0;
+    numGradients = 0;
+    scratchSize = 0;
+    
+    for (i = 0; i < numLayers; ++i)
+    {
+        numNodes = pl_NeuralLayerF_GetNumOutputs (&layerArray[i]);
+        numInputs = pl_NeuralLayerF_GetNumInputs (&layerArray[i]);
+        numActivations += numNodes * maxPatterns;
+        numGradients += numNodes * numInputs + numNodes;
+        scratchSize = pl_MaxI (scratchSize, pl_NeuralLayerF_GetBatchScratchSize (&layerArray[i], maxPatterns));
+    }
+    
+    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->outputs, sizeof (PlankF), numActivations, PLANK_TRUE)) != PlankResult_OK) goto exit;
+    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->errors, sizeof (PlankF), numActivations, PLANK_TRUE)) != PlankResult_OK) goto exit;
+    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->gradients, sizeof (PlankF), numGradients, PLANK_TRUE)) != PlankResult_OK) goto exit;
+    if ((result = pl_DynamicArray_InitWithItemSizeAndSize (&p->scratch, sizeof (PlankF), scratchSize, PLANK_TRUE)) != PlankResult_OK) goto exit;
+    
+exit:
+    return result;
+}
+
+PlankResult pl_NeuralBatchF_DeInit (PlankNeuralBatchFRef p)
+{
+    PlankResult result;
+    
+    result = PlankResult_OK;
+    
+    if (p == PLANK_NULL)
+    {
+        result = PlankResult_MemoryError;
+        goto exit;
+    }
+    
+    pl_DynamicArray_DeInit (&p->outputs);
+    pl_DynamicArray_DeInit (&p->errors);
+    pl_DynamicArray_DeInit (&p->gradients);
+    pl_DynamicArray_DeInit (&p->scratch);
+    
+    pl_MemoryZero (p, sizeof (PlankNeuralBatchF));
+    
+exit:
+    return result;
+}
+
+int pl_NeuralBatchF_GetMaxPatterns (PlankNeuralBatchFRef p)
+{
+    return p->maxPatterns;
+}
+
+PlankResult pl_NeuralBatchF_Propogate (PlankNeuralBatchFRef p, const float* inputs, const int numPatterns)
+{
+    PlankResult result;
+    int numLayers, i;
+    PlankNeuralLayerF* layerArray;
+    const float* layerInputs;
+    float* layerOutputs;
+    
+    result = PlankResult_OK;
+    
+    if ((numPatterns < 1) || (numPatterns > p->maxPatterns))
+    {
+        result = PlankResult_ItemCountInvalid;
+        goto exit;
+    }
+    
+    numLayers = (int)pl_DynamicArray_GetSize (&p->network->layers);
+    layerArray = (PlankNeuralLayerF*)pl_DynamicArray_GetArray (&p->network->layers);
+    layerInputs = inputs;
+    layerOutputs = (float*)pl_DynamicArray_GetArray (&p->outputs);
+    
+    // each layer's outputs are stored after the previous layer's
+    for (i = 0; i < numLayers; ++i)
+    {
+        if ((result = pl_NeuralLayerF_PropogateBatch (&layerArray[i], layerOutputs, layerInputs, numPatterns)) != PlankResult_OK) goto exit;
+        
+        layerInputs = layerOutputs;
+        layerOutputs += pl_NeuralLayerF_GetNumOutputs (&layerArray[i]) * p->maxPatterns;
+    }
+    
+    p->numPatterns = numPatterns;
+    
+exit:
+    return result;
+}
+
+const float* pl_NeuralBatchF_GetOutputsPtr (PlankNeuralBatchFRef p)
+{
+    int numLayers, i;
+    PlankNeuralLayerF* layerArray;
+    const float* layerOutputs;
+
+    numLayers = (int)pl_DynamicArray_GetSize (&p->network->layers);
+    layerArray = (PlankNeuralLayerF*)pl_DynamicArray_GetArray (&p->network->layers);
+    layerOutputs = (const float*)pl_DynamicArray_GetArray (&p->outputs);
+
+    for (i = 0; i < numLayers - 1; ++i)
+        layerOutputs += pl_NeuralLayerF_GetNumOutputs (&layerArray[i]) * p->maxPatterns;
+    
+    return layerOutputs;
+}
+
+PlankResult pl_NeuralBatchF_Gradient (PlankNeuralBatchFRef p, const float* inputs, const float* targets, const int numPatterns)
+{
+    PlankResult result;
+    int numLayers, numNodes, numWeights, activationOffset, gradientOffset, i;
+    PlankNeuralLayerF* layerArray;
+    float* outputs;
+    float* errors;
+    float* gradients;
+    float* previousErrors;
+    const float* layerInputs;
+    
+    result = PlankResult_OK;
+    
+    if ((result = pl_NeuralBatchF_Propogate (p, inputs, numPatterns)) != PlankResult_OK) goto exit;
+    
+    numLayers = (int)pl_DynamicArray_GetSize (&p->network->layers);
+    layerArray = (PlankNeuralLayerF*)pl_DynamicArray_GetArray (&p->network->layers);
+    outputs = (float*)pl_DynamicArray_GetArray (&p->outputs);
+    errors = (float*)pl_DynamicArray_GetArray (&p->errors);
+    gradients = (float*)pl_DynamicArray_GetArray (&p->gradients);
+    
+    activationOffset = (int)pl_DynamicArray_GetSize (&p->outputs);
+    gradientOffset = (int)pl_DynamicArray_GetSize (&p->gradients);
+    
+    // work back from the end of the arrays, the output layer's errors first
+    for (i = numLayers - 1; i >= 0; --i)
+    {
+        numNodes = pl_NeuralLayerF_GetNumOutputs (&layerArray[i]);
+        numWeights = numNodes * pl_NeuralLayerF_GetNumInputs (&layerArray[i]);
+        activationOffset -= numNodes * p->maxPatterns;
+        gradientOffset -= numWeights + numNodes;
+        
+        if (i == numLayers - 1)
+            pl_VectorSubF_NNN (errors + activationOffset, targets, outputs + activationOffset, numNodes * numPatterns);
+        
+        if (i > 0)
+        {
+            layerInputs = outputs + activationOffset - pl_NeuralLayerF_GetNumOutputs (&layerArray[i - 1]) * p->maxPatterns;
+            previousErrors = errors + (layerInputs - outputs);
+        }
+        else
+        {
+            layerInputs = inputs;
+            previousErrors = PLANK_NULL;
+        }
+        
+        if ((result = pl_NeuralLayerF_GradientBatch (&layerArray[i], 
+                                                     gradients + gradientOffset, gradients + gradientOffset + numWeights,
+                                                     previousErrors, errors + activationOffset, 
+                                                     outputs + activationOffset, layerInputs,
+                                                     numPatterns, p->network->actFuncOffset,
+                                                     (float*)pl_DynamicArray_GetArray (&p->scratch))) != PlankResult_OK) goto exit;
+    }
+    
+exit:
+    return result;
+}
@@ -109,6 +109,83 @@ PlankResult pl_NeuralNetworkF_SetActFunc (PlankNeuralNetworkFRef p, PlankNeuralN
 PlankResult pl_NeuralNetworkF_ToJSON (PlankNeuralNetworkFRef p, PlankJSONRef j, const PlankB useBinary);
 PlankResult pl_NeuralNetworkF_InitFromJSON (PlankNeuralNetworkFRef p, PlankJSONRef j);
 
+/** Applies the gradients calculated by pl_NeuralBatchF_Gradient().
+ The weights move by the learn rate times the mean gradient, @e totalPatterns 
+ is the size of the whole mini-batch. When a mini-batch is split across several
+ <i>Plank %NeuralBatchF</i> objects (e.g., one per thread) calculate all their 
+ gradients first then apply each of them with the same @e totalPatterns.
+ @param p The <i>Plank %NeuralNetworkF</i> object.
+ @param batch A <i>Plank %NeuralBatchF</i> object for this network.
+ @param totalPatterns The total number of patterns in the mini-batch.
+ @return PlankResult_OK if successful, otherwise an error code. */
+PlankResult pl_NeuralNetworkF_ApplyBatch (PlankNeuralNetworkFRef p, PlankNeuralBatchFRef batch, const int totalPatterns);
+
+/** Trains the network with a mini-batch of patterns.
+ The patterns are propogated together and the weights updated once with the 
+ mean gradient. Unlike pl_NeuralNetworkF_BackProp() the gradients all use the 
+ weights from before the update.
+ @param p The <i>Plank %NeuralNetworkF</i> object.
+ @param batch A <i>Plank %NeuralBatchF</i> object for this network.
+ @param inputs numPatterns rows of pl_NeuralNetworkF_GetNumInputs() values.
+ @param targets numPatterns rows of pl_NeuralNetworkF_GetNumOutputs() values.
+ @param numPatterns The number of patterns, up to the batch's maximum.
+ @return PlankResult_OK if successful, otherwise an error code. */
+PlankResult pl_NeuralNetworkF_BackPropBatch (PlankNeuralNetworkFRef p, PlankNeuralBatchFRef batch, const float* inputs, const float* targets, const int numPatterns);
+
+/** @} */
+
+/** The working memory for propogating and training batches of patterns.
+ Each holds the activations, errors and gradients of every layer for up to a 
+ maximum number of patterns. These only read the network's weights so several 
+ can be used at once from different threads, as long as the weights are not
+ changed (i.e., with pl_NeuralNetworkF_ApplyBatch()) at the same time. 
+ The network must not be reinitialised while it has batches.
+ 
+ @defgroup PlankNeuralBatchFClass Plank NeuralBatch class
+ @ingroup PlankClasses
+ @{
+ */
+
+#if DOXYGEN
+/** An opaque reference to the <i>Plank %NeuralBatchF</i> object. */
+typedef struct PlankNeuralBatchF* PlankNeuralBatchFRef;
+#endif 
+
+/** Initialise a <i>Plank %NeuralBatchF</i> object.
+ @param p The <i>Plank %NeuralBatchF</i> object.
+ @param network The network the batch is for.
+ @param maxPatterns The largest number of patterns that will be processed at once.
+ @return PlankResult_OK if successful, otherwise an error code. */
+PlankResult pl_NeuralBatchF_Init (PlankNeuralBatchFRef p, PlankNeuralNetworkFRef network, const int maxPatterns);
+
+/** Deinitialise a <i>Plank %NeuralBatchF</i> object.
+ @param p The <i>Plank %NeuralBatchF</i> object.
+ @return PlankResult_OK if successful, otherwise an error code. */
+PlankResult pl_NeuralBatchF_DeInit (PlankNeuralBatchFRef p);
+
+int pl_NeuralBatchF_GetMaxPatterns (PlankNeuralBatchFRef p);
+
+/** Propogates a batch of input vectors through the network.
+ @param p The <i>Plank %NeuralBatchF</i> object.
+ @param inputs numPatterns rows of pl_NeuralNetworkF_GetNumInputs() values.
+ @param numPatterns The number of patterns, up to the batch's maximum.
+ @return PlankResult_OK if successful, otherwise an error code. */
+PlankResult pl_NeuralBatchF_Propogate (PlankNeuralBatchFRef p, const float* inputs, const int numPatterns);
+
+/** The outputs of the last propogation, numPatterns rows of pl_NeuralNetworkF_GetNumOutputs() values. */
+const float* pl_NeuralBatchF_GetOutputsPtr (PlankNeuralBatchFRef p);
+
+/** Propogates a batch of patterns and calculates the gradients summed over the batch.
+ This does not change the network, see pl_NeuralNetworkF_ApplyBatch().
+ @param p The <i>Plank %NeuralBatchF</i> object.
+ @param inputs numPatterns rows of pl_NeuralNetworkF_GetNumInputs() values.
+ @param targets numPatterns rows of pl_NeuralNetworkF_GetNumOutputs() values.
+ @param numPatterns The number of patterns, up to the batch's maximum.
+ @return PlankResult_OK if successful, otherwise an error code. */
+PlankResult pl_NeuralBatchF_Gradient (PlankNeuralBatchFRef p, const float* inputs, const float* targets, const int numPatterns);
+
+/** @} */
+
 
 
 
@@ -122,6 +199,16 @@ typedef struct PlankNeuralNetworkF
 	PlankDynamicArray errorVector;
     PlankNeuralNetworkFActFunction actFunc;
 } PlankNeuralNetworkF;
+
+typedef struct PlankNeuralBatchF
+{
+    PlankNeuralNetworkFRef network;
+    int maxPatterns, numPatterns;
+    PlankDynamicArray outputs;
+    PlankDynamicArray errors;
+    PlankDynamicArray gradients;
+    PlankDynamicArray scratch;
+} PlankNeuralBatchF;
 #endif
 
 
@@ -341,31 +341,31 @@ float pl_NeuralNodeF_GetOutput (PlankNeuralNodeFRef p)
 }
 
 PlankResult pl_NeuralNodeF_ToJSON (PlankNeuralNodeFRef p, PlankJSONRef j, const PlankB useBinary)
+{
+    return pl_NeuralNodeF_WeightsToJSON ((const float*)pl_DynamicArray_GetArray (&p->weightVector),
+                                         (int)pl_DynamicArray_GetSize (&p->weightVector),
+                                         p->threshold, j, useBinary);
+}
+
+PlankResult pl_NeuralNodeF_WeightsToJSON (const float* weights, const int numWeights, const float threshold, PlankJSONRef j, const PlankB useBinary)
 {
     PlankResult result;
-    int numWeights;
-    const float* weightArray;
     PlankJSONRef jnode;
-    PlankJSONRef jweights;
     
     result = PlankResult_OK;
     
     jnode = pl_JSON_Object();
-    jweights = (PlankJSONRef)PLANK_NULL;
     
     pl_JSON_ObjectSetType (jnode, PLANK_NEURALNODEF_JSON_TYPE);
     pl_JSON_ObjectSetVersionString (jnode, PLANK_NEURALNODEF_JSON_VERSION);
     
-    numWeights = (int)pl_DynamicArray_GetSize (&p->weightVector);
-    weightArray = (const float*)pl_DynamicArray_GetArray (&p->weightVector);
-
     pl_JSON_ObjectPutKey (jnode,
                           PLANK_NEURALNODEF_JSON_THRESHOLD,
-                          useBinary ? pl_JSON_FloatBinary (p->threshold) : pl_JSON_Float (p->threshold));
+                          useBinary ? pl_JSON_FloatBinary (threshold) : pl_JSON_Float (threshold));
     
     pl_JSON_ObjectPutKey (jnode,
                           PLANK_NEURALNODEF_JSON_WEIGHTS,
-                          useBinary ? pl_JSON_FloatArrayBinary (weightArray, numWeights) : pl_JSON_FloatArray (weightArray, numWeights));    
+                          useBinary ? pl_JSON_FloatArrayBinary (weights, numWeights) : pl_JSON_FloatArray (weights, numWeights));    
     
     pl_JSON_ArrayAppend (j, jnode);
     
@@ -376,7 +376,6 @@ PlankResult pl_NeuralNodeF_ToJSON (PlankNeuralNodeFRef p, PlankJSONRef j, const
 PlankResult pl_NeuralNodeF_InitFromJSON (PlankNeuralNodeFRef p, PlankNeuralNetworkFRef network, PlankJSONRef j)
 {
     PlankResult result;
-    PlankJSONRef jweights;
     int numWeights;
     
     result = PlankResult_OK;
@@ -390,6 +389,33 @@ PlankResult pl_NeuralNodeF_InitFromJSON (PlankNeuralNodeFRef p, PlankNeuralNetwo
     pl_MemoryZero (p, sizeof (PlankNeuralNodeF));
     p->network = network;
     
+    if ((result = pl_NeuralNodeF_WeightsFromJSON (j, &p->weightVector, &p->threshold)) != PlankResult_OK)
+        goto exit;
+    
+    numWeights = (int)pl_DynamicArray_GetSize (&p->weightVector);
+    
+    if (numWeights < 8)
+    {
+        p->propogate = pl_NeuralNodeF_PropogateScalar;
+        p->backProp = pl_NeuralNodeF_BackPropScalar;
+    }
+    else
+    {
+        p->propogate = pl_NeuralNodeF_PropogateVector;
+        p->backProp = pl_NeuralNodeF_BackPropVector;
+    }
+    
+exit:
+    return result;
+}
+
+PlankResult pl_NeuralNodeF_WeightsFromJSON (PlankJSONRef j, PlankDynamicArrayRef weights, float* threshold)
+{
+    PlankResult result;
+    PlankJSONRef jweights;
+    
+    result = PlankResult_OK;
+    
     if (!pl_JSON_IsObjectType (j, PLANK_NEURALNODEF_JSON_TYPE))
     {
         result = PlankResult_JSONError;
@@ -414,31 +440,16 @@ PlankResult pl_NeuralNodeF_InitFromJSON (PlankNeuralNodeFRef p, PlankNeuralNetwo
         goto exit;
     }
     
-    if ((result = pl_JSON_FloatArrayGet (jweights, &p->weightVector)) != PlankResult_OK) goto exit;
+    if ((result = pl_JSON_FloatArrayGet (jweights, weights)) != PlankResult_OK) goto exit;
     
-    numWeights = (int)pl_DynamicArray_GetSize (&p->weightVector);
-    
-    if (numWeights < 1)
+    if (pl_DynamicArray_GetSize (weights) < 1)
     {
         result = PlankResult_JSONError;
         goto exit;
     }
         
-    p->threshold = pl_JSON_FloatGet (pl_JSON_ObjectAtKey (j, PLANK_NEURALNODEF_JSON_THRESHOLD));
-    
-    if (numWeights < 8)
-    {
-        p->propogate = pl_NeuralNodeF_PropogateScalar;
-        p->backProp = pl_NeuralNodeF_BackPropScalar;
-    }
-    else
-    {
-        p->propogate = pl_NeuralNodeF_PropogateVector;
-        p->backProp = pl_NeuralNodeF_BackPropVector;
-    }
+    *threshold = pl_JSON_FloatGet (pl_JSON_ObjectAtKey (j, PLANK_NEURALNODEF_JSON_THRESHOLD));
     
 exit:
     return result;
 }
-
-
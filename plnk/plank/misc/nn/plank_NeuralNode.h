@@ -104,6 +104,17 @@ float pl_NeuralNodeF_GetOutput (PlankNeuralNodeFRef p);
 PlankResult pl_NeuralNodeF_ToJSON (PlankNeuralNodeFRef p, PlankJSONRef j, const PlankB useBinary);
 PlankResult pl_NeuralNodeF_InitFromJSON (PlankNeuralNodeFRef p, PlankNeuralNetworkFRef network, PlankJSONRef j);
 
+/** Appends a node's JSON object to a JSON array.
+ This is the format pl_NeuralNodeF_ToJSON() writes, the layers use it to store
+ the rows of their weight matrices. */
+PlankResult pl_NeuralNodeF_WeightsToJSON (const float* weights, const int numWeights, const float threshold, PlankJSONRef j, const PlankB useBinary);
+
+/** Reads the weights and threshold from a node's JSON object.
+ @param j The JSON object.
+ @param weights An initialised or zeroed array, this is resized to the number of weights.
+ @param threshold Receives the threshold. */
+PlankResult pl_NeuralNodeF_WeightsFromJSON (PlankJSONRef j, PlankDynamicArrayRef weights, float* threshold);
+
 
 PLANK_END_C_LINKAGE
 
@@ -70,6 +70,8 @@
 #include "containers/plank_LockFreeDynamicArray.h"
 #include "containers/plank_LockFreeQueue.h"
 #include "containers/plank_LockFreeStack.h"
+#include "containers/plank_RingBufferSPSC.h"
+#include "containers/plank_RingBufferMPSC.h"
 #include "containers/plank_SimpleQueue.h"
 #include "containers/plank_SimpleStack.h"
 #include "containers/plank_SimpleLinkedList.h"
@@ -102,6 +104,7 @@
 #include "files/audio/plank_AudioFileRegion.h"
 
 #include "random/plank_RNG.h"
+#include "random/plank_RNGStream.h"
 #include "fft/plank_FFT.h"
 
 /** Plank modules....
@@ -0,0 +1,503 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#include "../core/plank_StandardHeader.h"
+#include "plank_RNGStream.h"
+#include "../maths/vectors/plank_Vectors.h"
+
+#define PLANK_RNGSTREAM_M0          0xD2511F53
+#define PLANK_RNGSTREAM_M1          0xCD9E8D57
+#define PLANK_RNGSTREAM_W0          0x9E3779B9
+#define PLANK_RNGSTREAM_W1          0xBB67AE85
+#define PLANK_RNGSTREAM_ROUNDS      10
+#define PLANK_RNGSTREAM_GOLDEN      ((((PlankULL)0x9E3779B9) << 32) | 0x7F4A7C15)
+#define PLANK_RNGSTREAM_MIX1        ((((PlankULL)0xBF58476D) << 32) | 0x1CE4E5B9)
+#define PLANK_RNGSTREAM_MIX2        ((((PlankULL)0x94D049BB) << 32) | 0x133111EB)
+#define PLANK_RNGSTREAM_CHUNK       128     // values converted per pass, using stack buffers
+#define PLANK_RNGSTREAM_SCALEF      (1.f / 16777216.f)
+#define PLANK_RNGSTREAM_SCALED      (1.0 / 9007199254740992.0)
+
+static void pl_RNGStreamBlock (PlankRNGStreamRef p, const PlankULL block, PlankUI* dst)
+{
+    PlankUI c0, c1, c2, c3, k0, k1, hi0, lo0, hi1, lo1;
+    PlankULL product;
+    int i;
+    
+    c0 = (PlankUI)block;
+    c1 = (PlankUI)(block >> 32);
+    c2 = p->stream[0];
+    c3 = p->stream[1];
+    k0 = p->key[0];
+    k1 = p->key[1];
+    
+    for (i = 0; i < PLANK_RNGSTREAM_ROUNDS; ++i)
+    {
+        product = (PlankULL)PLANK_RNGSTREAM_M0 * c0;
+        hi0 = (PlankUI)(product >> 32);
+        lo0 = (PlankUI)product;
+        product = (PlankULL)PLANK_RNGSTREAM_M1 * c2;
+        hi1 = (PlankUI)(product >> 32);
+        lo1 = (PlankUI)product;
+        
+        c0 = hi1 ^ c1 ^ k0;
+        c1 = lo1;
+        c2 = hi0 ^ c3 ^ k1;
+        c3 = lo0;
+        
+        k0 += PLANK_RNGSTREAM_W0;
+        k1 += PLANK_RNGSTREAM_W1;
+    }
+    
+    dst[0] = c0;
+    dst[1] = c1;
+    dst[2] = c2;
+    dst[3] = c3;
+}
+
+#if defined(PLANK_VEC_SSE) && PLANK_VEC_SSE
+// Each 32-bit word of a block is held in the low half of a 64-bit lane so that _mm_mul_epu32 
+// gives the full product without any shuffling. The high halves of the lanes fill up with 
+// junk but only the low halves are ever multiplied or stored. Two sets of lanes are run 
+// together to hide the multiply latency.
+static void pl_RNGStreamBlocks4 (PlankRNGStreamRef p, const __m128i* keys, const PlankULL block, PlankUI* dst)
+{
+    __m128i a0, a1, a2, a3, b0, b1, b2, b3, pa0, pa2, pb0, pb2;
+    const __m128i m0 = _mm_set1_epi32 ((int)PLANK_RNGSTREAM_M0);
+    const __m128i m1 = _mm_set1_epi32 ((int)PLANK_RNGSTREAM_M1);
+    int i;
+    
+    a0 = _mm_set_epi32 (0, (int)(PlankUI)(block + 1),         0, (int)(PlankUI)block);
+    a1 = _mm_set_epi32 (0, (int)(PlankUI)((block + 1) >> 32), 0, (int)(PlankUI)(block >> 32));
+    b0 = _mm_set_epi32 (0, (int)(PlankUI)(block + 3),         0, (int)(PlankUI)(block + 2));
+    b1 = _mm_set_epi32 (0, (int)(PlankUI)((block + 3) >> 32), 0, (int)(PlankUI)((block + 2) >> 32));
+    a2 = b2 = _mm_set1_epi32 ((int)p->stream[0]);
+    a3 = b3 = _mm_set1_epi32 ((int)p->stream[1]);
+    
+    for (i = 0; i < PLANK_RNGSTREAM_ROUNDS; ++i)
+    {
+        pa0 = _mm_mul_epu32 (a0, m0);
+        pb0 = _mm_mul_epu32 (b0, m0);
+        pa2 = _mm_mul_epu32 (a2, m1);
+        pb2 = _mm_mul_epu32 (b2, m1);
+        
+        a0 = _mm_xor_si128 (_mm_xor_si128 (_mm_shuffle_epi32 (pa2, _MM_SHUFFLE (2, 3, 0, 1)), a1), keys[i * 2]);
+        b0 = _mm_xor_si128 (_mm_xor_si128 (_mm_shuffle_epi32 (pb2, _MM_SHUFFLE (2, 3, 0, 1)), b1), keys[i * 2]);
+        a1 = pa2;
+        b1 = pb2;
+        a2 = _mm_xor_si128 (_mm_xor_si128 (_mm_shuffle_epi32 (pa0, _MM_SHUFFLE (2, 3, 0, 1)), a3), keys[i * 2 + 1]);
+        b2 = _mm_xor_si128 (_mm_xor_si128 (_mm_shuffle_epi32 (pb0, _MM_SHUFFLE (2, 3, 0, 1)), b3), keys[i * 2 + 1]);
+        a3 = pa0;
+        b3 = pb0;
+    }
+    
+    // gather the low halves back into the same order as pl_RNGStreamBlock
+    pa0 = _mm_unpacklo_epi32 (a0, a1);
+    pa2 = _mm_unpacklo_epi32 (a2, a3);
+    _mm_storeu_si128 ((__m128i*)dst,        _mm_unpacklo_epi64 (pa0, pa2));
+    pa0 = _mm_unpackhi_epi32 (a0, a1);
+    pa2 = _mm_unpackhi_epi32 (a2, a3);
+    _mm_storeu_si128 ((__m128i*)(dst + 4),  _mm_unpacklo_epi64 (pa0, pa2));
+    pb0 = _mm_unpacklo_epi32 (b0, b1);
+    pb2 = _mm_unpacklo_epi32 (b2, b3);
+    _mm_storeu_si128 ((__m128i*)(dst + 8),  _mm_unpacklo_epi64 (pb0, pb2));
+    pb0 = _mm_unpackhi_epi32 (b0, b1);
+    pb2 = _mm_unpackhi_epi32 (b2, b3);
+    _mm_storeu_si128 ((__m128i*)(dst + 12), _mm_unpacklo_epi64 (pb0, pb2));
+}
+#endif
+
+static void pl_RNGStreamBlocks (PlankRNGStreamRef p, PlankUI* dst, PlankL numBlocks)
+{
+#if defined(PLANK_VEC_SSE) && PLANK_VEC_SSE
+    if (numBlocks >= 4)
+    {
+        // the key schedule is the same for every block so broadcast it once
+        __m128i keys[PLANK_RNGSTREAM_ROUNDS * 2];
+        PlankUI key0, key1;
+        int i;
+        
+        key0 = p->key[0];
+        key1 = p->key[1];
+        
+        for (i = 0; i < PLANK_RNGSTREAM_ROUNDS; ++i)
+        {
+            keys[i * 2]     = _mm_set1_epi32 ((int)key0);
+            keys[i * 2 + 1] = _mm_set1_epi32 ((int)key1);
+            key0 += PLANK_RNGSTREAM_W0;
+            key1 += PLANK_RNGSTREAM_W1;
+        }
+        
+        while (numBlocks >= 4)
+        {
+            pl_RNGStreamBlocks4 (p, keys, p->block, dst);
+            p->block += 4;
+            dst += 16;
+            numBlocks -= 4;
+        }
+    }
+#endif
+    
+    while (numBlocks > 0)
+    {
+        pl_RNGStreamBlock (p, p->block, dst);
+        p->block++;
+        dst += 4;
+        numBlocks--;
+    }
+}
+
+static PLANK_INLINE_LOW PlankULL pl_RNGStreamMix (PlankULL x)
+{
+    // the SplitMix64 finaliser
+    x = (x ^ (x >> 30)) * PLANK_RNGSTREAM_MIX1;
+    x = (x ^ (x >> 27)) * PLANK_RNGSTREAM_MIX2;
+    return x ^ (x >> 31);
+}
+
+PlankRNGStreamRef pl_RNGStream_CreateAndInit()
+{
+    PlankRNGStreamRef p;
+    p = pl_RNGStream_Create();
+    
+    if (p != PLANK_NULL)
+    {
+        if (pl_RNGStream_Init (p) != PlankResult_OK)
+            pl_RNGStream_Destroy (p);
+        else
+            return p;
+    }
+    
+    return PLANK_NULL;
+}
+
+PlankRNGStreamRef pl_RNGStream_Create()
+{
+    PlankMemoryRef m;
+    PlankRNGStreamRef p;
+    
+    m = pl_MemoryGlobal();
+    p = (PlankRNGStreamRef)pl_Memory_AllocateBytes (m, sizeof (PlankRNGStream));
+    
+    if (p != NULL)
+        pl_MemoryZero (p, sizeof (PlankRNGStream));
+    
+    return p;
+}
+
+PlankResult pl_RNGStream_Init (PlankRNGStreamRef p)
+{
+    if (p == PLANK_NULL)
+        return PlankResult_MemoryError;
+    
+    pl_RNGStream_Seed (p, (PlankULL)time (NULL));
+    return PlankResult_OK;
+}
+
+PlankResult pl_RNGStream_DeInit (PlankRNGStreamRef p)
+{
+    if (p == PLANK_NULL)
+        return PlankResult_MemoryError;
+    
+    return PlankResult_OK;
+}
+
+PlankResult pl_RNGStream_Destroy (PlankRNGStreamRef p)
+{
+    PlankResult result;
+    PlankMemoryRef m;
+    
+    result = PlankResult_OK;
+    m = pl_MemoryGlobal();
+    
+    if (p == PLANK_NULL)
+    {
+        result = PlankResult_MemoryError;
+        goto exit;
+    }
+    
+    if ((result = pl_RNGStream_DeInit (p)) != PlankResult_OK)
+        goto exit;
+    
+    result = pl_Memory_Free (m, p);
+    
+exit:
+    return result;
+}
+
+void pl_RNGStream_Seed (PlankRNGStreamRef p, const PlankULL seed)
+{
+    p->key[0]       = (PlankUI)seed;
+    p->key[1]       = (PlankUI)(seed >> 32);
+    p->stream[0]    = 0;
+    p->stream[1]    = 0;
+    p->block        = 0;
+    p->bufferIndex  = 4;
+}
+
+void pl_RNGStream_Split (PlankRNGStreamRef p, PlankRNGStreamRef child, const PlankULL index)
+{
+    PlankULL stream;
+    
+    stream = ((PlankULL)p->stream[1] << 32) | p->stream[0];
+    stream = pl_RNGStreamMix (stream + (index + 1) * PLANK_RNGSTREAM_GOLDEN);
+    
+    child->key[0]       = p->key[0];
+    child->key[1]       = p->key[1];
+    child->stream[0]    = (PlankUI)stream;
+    child->stream[1]    = (PlankUI)(stream >> 32);
+    child->block        = 0;
+    child->bufferIndex  = 4;
+}
+
+void pl_RNGStream_Seek (PlankRNGStreamRef p, const PlankULL position)
+{
+    p->block = position >> 2;
+    p->bufferIndex = (int)(position & 3);
+    
+    if (p->bufferIndex == 0)
+    {
+        p->bufferIndex = 4;
+    }
+    else
+    {
+        pl_RNGStreamBlock (p, p->block, p->buffer);
+        p->block++;
+    }
+}
+
+PlankULL pl_RNGStream_GetPosition (PlankRNGStreamRef p)
+{
+    return p->block * 4 - (4 - p->bufferIndex);
+}
+
+void pl_RNGStream_FillUI (PlankRNGStreamRef p, PlankUI* dst, const PlankL n)
+{
+    PlankL remaining, numBlocks;
+    
+    remaining = n;
+    
+    while ((p->bufferIndex < 4) && (remaining > 0))
+    {
+        *dst++ = p->buffer[p->bufferIndex++];
+        remaining--;
+    }
+    
+    numBlocks = remaining >> 2;
+    
+    if (numBlocks > 0)
+    {
+        pl_RNGStreamBlocks (p, dst, numBlocks);
+        dst += numBlocks << 2;
+        remaining -= numBlocks << 2;
+    }
+    
+    if (remaining > 0)
+    {
+        pl_RNGStreamBlock (p, p->block, p->buffer);
+        p->block++;
+        p->bufferIndex = 0;
+        
+        while (remaining > 0)
+        {
+            *dst++ = p->buffer[p->bufferIndex++];
+            remaining--;
+        }
+    }
+}
+
+void pl_RNGStream_FillUniformF (PlankRNGStreamRef p, float* dst, const PlankL n, const float lower, const float upper)
+{
+    const float scale = (upper - lower) * PLANK_RNGSTREAM_SCALEF;
+    PlankUI* bits;
+    PlankL i;
+    
+    // floats and the raw outputs are the same size so convert in place
+    bits = (PlankUI*)dst;
+    pl_RNGStream_FillUI (p, bits, n);
+    
+    i = 0;
+    
+#if defined(PLANK_VEC_SSE) && PLANK_VEC_SSE
+    {
+        const __m128 vscale = _mm_set1_ps (scale);
+        const __m128 vlower = _mm_set1_ps (lower);
+        
+        for (; i < (n & ~3); i += 4)
+        {
+            const __m128i v = _mm_srli_epi32 (_mm_loadu_si128 ((const __m128i*)(bits + i)), 8);
+            _mm_storeu_ps (dst + i, _mm_add_ps (_mm_mul_ps (_mm_cvtepi32_ps (v), vscale), vlower));
+        }
+    }
+#endif
+    
+    for (; i < n; ++i)
+        dst[i] = (float)(int)(bits[i] >> 8) * scale + lower;
+}
+
+static PLANK_INLINE_LOW double pl_RNGStreamToDouble (const PlankUI a, const PlankUI b)
+{
+    return ((double)(a >> 5) * 67108864.0 + (double)(b >> 6)) * PLANK_RNGSTREAM_SCALED;
+}
+
+void pl_RNGStream_FillUniformD (PlankRNGStreamRef p, double* dst, const PlankL n, const double lower, const double upper)
+{
+    const double range = upper - lower;
+    PlankUI bits[PLANK_RNGSTREAM_CHUNK * 2];
+    PlankL remaining, chunk, i;
+    
+    remaining = n;
+    
+    while (remaining > 0)
+    {
+        chunk = remaining < PLANK_RNGSTREAM_CHUNK ? remaining : PLANK_RNGSTREAM_CHUNK;
+        pl_RNGStream_FillUI (p, bits, chunk * 2);
+        
+        for (i = 0; i < chunk; ++i)
+            dst[i] = pl_RNGStreamToDouble (bits[i * 2], bits[i * 2 + 1]) * range + lower;
+        
+        dst += chunk;
+        remaining -= chunk;
+    }
+}
+
+void pl_RNGStream_FillExponentialF (PlankRNGStreamRef p, float* dst, const PlankL n, const float lower, const float upper)
+{
+    PlankL i;
+    
+    pl_RNGStream_FillUniformF (p, dst, n, 0.f, logf (upper / lower));
+    pl_VectorExpF_NN (dst, dst, n);
+    
+    for (i = 0; i < n; ++i)
+        dst[i] *= lower;
+}
+
+void pl_RNGStream_FillExponentialD (PlankRNGStreamRef p, double* dst, const PlankL n, const double lower, const double upper)
+{
+    PlankL i;
+    
+    pl_RNGStream_FillUniformD (p, dst, n, 0.0, log (upper / lower));
+    pl_VectorExpD_NN (dst, dst, n);
+    
+    for (i = 0; i < n; ++i)
+        dst[i] *= lower;
+}
+
+void pl_RNGStream_FillGaussianF (PlankRNGStreamRef p, float* dst, const PlankL n, const float mean, const float deviation)
+{
+    PlankUI bits[PLANK_RNGSTREAM_CHUNK];
+    float radius[PLANK_RNGSTREAM_CHUNK / 2];
+    float angle[PLANK_RNGSTREAM_CHUNK / 2];
+    float cosine[PLANK_RNGSTREAM_CHUNK / 2];
+    PlankL remaining, chunk, numPairs, i;
+    
+    remaining = n;
+    
+    while (remaining > 0)
+    {
+        chunk = remaining < PLANK_RNGSTREAM_CHUNK ? remaining : PLANK_RNGSTREAM_CHUNK;
+        numPairs = (chunk + 1) >> 1;
+        pl_RNGStream_FillUI (p, bits, numPairs * 2);
+        
+        // radius from (0,1] so the log is finite, angle from [0,2pi)
+        for (i = 0; i < numPairs; ++i)
+        {
+            radius[i] = (float)(int)((bits[i] >> 8) + 1) * PLANK_RNGSTREAM_SCALEF;
+            angle[i]  = (float)(int)(bits[numPairs + i] >> 8) * (PLANK_RNGSTREAM_SCALEF * 2.f * PLANK_PI_F);
+        }
+        
+        pl_VectorLogF_NN (radius, radius, numPairs);
+        
+        for (i = 0; i < numPairs; ++i)
+            radius[i] = -2.f * radius[i];
+        
+        pl_VectorSqrtF_NN (radius, radius, numPairs);
+        pl_VectorCosF_NN (cosine, angle, numPairs);
+        pl_VectorSinF_NN (angle, angle, numPairs);
+        
+        for (i = 0; i < numPairs; ++i)
+            dst[i] = radius[i] * cosine[i] * deviation + mean;
+        
+        for (i = numPairs; i < chunk; ++i)
+            dst[i] = radius[i - numPairs] * angle[i - numPairs] * deviation + mean;
+        
+        dst += chunk;
+        remaining -= chunk;
+    }
+}
+
+void pl_RNGStream_FillGaussianD (PlankRNGStreamRef p, double* dst, const PlankL n, const double mean, const double deviation)
+{
+    PlankUI bits[PLANK_RNGSTREAM_CHUNK * 2];
+    double radius[PLANK_RNGSTREAM_CHUNK / 2];
+    double angle[PLANK_RNGSTREAM_CHUNK / 2];
+    double cosine[PLANK_RNGSTREAM_CHUNK / 2];
+    PlankL remaining, chunk, numPairs, i;
+    
+    remaining = n;
+    
+    while (remaining > 0)
+    {
+        chunk = remaining < PLANK_RNGSTREAM_CHUNK ? remaining : PLANK_RNGSTREAM_CHUNK;
+        numPairs = (chunk + 1) >> 1;
+        pl_RNGStream_FillUI (p, bits, numPairs * 4);
+        
+        for (i = 0; i < numPairs; ++i)
+        {
+            radius[i] = 1.0 - pl_RNGStreamToDouble (bits[i * 2], bits[i * 2 + 1]);
+            angle[i]  = pl_RNGStreamToDouble (bits[(numPairs + i) * 2], bits[(numPairs + i) * 2 + 1]) * (2.0 * PLANK_PI_D);
+        }
+        
+        pl_VectorLogD_NN (radius, radius, numPairs);
+        
+        for (i = 0; i < numPairs; ++i)
+            radius[i] = -2.0 * radius[i];
+        
+        pl_VectorSqrtD_NN (radius, radius, numPairs);
+        pl_VectorCosD_NN (cosine, angle, numPairs);
+        pl_VectorSinD_NN (angle, angle, numPairs);
+        
+        for (i = 0; i < numPairs; ++i)
+            dst[i] = radius[i] * cosine[i] * deviation + mean;
+        
+        for (i = numPairs; i < chunk; ++i)
+            dst[i] = radius[i - numPairs] * angle[i - numPairs] * deviation + mean;
+        
+        dst += chunk;
+        remaining -= chunk;
+    }
+}
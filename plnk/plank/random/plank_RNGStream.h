@@ -0,0 +1,190 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLANK_RNGSTREAM_H
+#define PLANK_RNGSTREAM_H
+
+PLANK_BEGIN_C_LINKAGE
+
+/** A counter-based random number generator for filling blocks of samples.
+ 
+ Unlike the <i>Plank %RNG</i> class (which steps a linear congruential generator
+ one value at a time) each block of four 32-bit outputs is computed directly from 
+ its position in the stream using the Philox4x32-10 bijection (Salmon et al., 
+ "Parallel random numbers: as easy as 1, 2, 3", SC11). This means blocks can be
+ generated independently (and several at a time using SIMD where available),
+ a stream can seek to any position in constant time, and a stream can be split
+ into any number of independent child streams, e.g., one per channel or thread.
+ 
+ A stream is a plain struct and may be embedded in other structs and copied.
+ Streams are not thread safe, each thread should use its own stream (which can
+ be obtained via pl_RNGStream_Split()).
+ 
+ @code
+ PlankRNGStream stream;
+ float buffer[512];
+ pl_RNGStream_Init (&stream);
+ pl_RNGStream_Seed (&stream, 1234);
+ pl_RNGStream_FillUniformF (&stream, buffer, 512, -1.f, 1.f);
+ pl_RNGStream_DeInit (&stream);
+ @endcode
+ 
+ @defgroup PlankRNGStreamClass Plank RNGStream class
+ @ingroup PlankClasses
+ @{
+ */
+
+/** An opaque reference to the <i>Plank RNGStream</i> object. */
+typedef struct PlankRNGStream* PlankRNGStreamRef; 
+
+/** Create and initialise a <i>Plank RNGStream</i> object and return an oqaque reference to it.
+ @return A <i>Plank RNGStream</i> object as an opaque reference or NULL. */
+PlankRNGStreamRef pl_RNGStream_CreateAndInit();
+
+/** Create a <i>Plank RNGStream</i> object and return an oqaque reference to it.
+ @return A <i>Plank RNGStream</i> object as an opaque reference or NULL. */
+PlankRNGStreamRef pl_RNGStream_Create();
+
+/** Initialise a <i>Plank RNGStream</i> object.
+ The stream is seeded from the current time.
+ @param p The <i>Plank RNGStream</i> object. 
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_RNGStream_Init (PlankRNGStreamRef p);
+
+/** Deinitialise a <i>Plank RNGStream</i> object.
+ @param p The <i>Plank RNGStream</i> object. 
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_RNGStream_DeInit (PlankRNGStreamRef p);
+
+/** Destroy a <i>Plank RNGStream</i> object. 
+ @param p The <i>Plank RNGStream</i> object. 
+ @return A result code which will be PlankResult_OK if the operation was completely successful. */
+PlankResult pl_RNGStream_Destroy (PlankRNGStreamRef p);
+
+/** Seed a <i>Plank RNGStream</i> object.
+ This also resets the stream to the start of its first substream.
+ @param p The <i>Plank RNGStream</i> object. 
+ @param seed The new seed. */
+void pl_RNGStream_Seed (PlankRNGStreamRef p, const PlankULL seed);
+
+/** Initialise another stream as an independent child of this stream.
+ The same parent and index always produce the same child, different indices 
+ produce statistically independent streams. The parent is not modified.
+ @param p The parent <i>Plank RNGStream</i> object. 
+ @param child The <i>Plank RNGStream</i> object to initialise. 
+ @param index The index of the child stream, e.g., a channel or thread number. */
+void pl_RNGStream_Split (PlankRNGStreamRef p, PlankRNGStreamRef child, const PlankULL index);
+
+/** Move to a position in the stream.
+ @param p The <i>Plank RNGStream</i> object. 
+ @param position The position measured in 32-bit outputs from the start of the stream. */
+void pl_RNGStream_Seek (PlankRNGStreamRef p, const PlankULL position);
+
+/** Get the current position in the stream.
+ @param p The <i>Plank RNGStream</i> object. 
+ @return The position measured in 32-bit outputs from the start of the stream. */
+PlankULL pl_RNGStream_GetPosition (PlankRNGStreamRef p);
+
+/** Fill a buffer with uniformly distributed 32-bit random integers. 
+ @param p The <i>Plank RNGStream</i> object. 
+ @param dst The buffer to fill.
+ @param n The number of values to generate. */
+void pl_RNGStream_FillUI (PlankRNGStreamRef p, PlankUI* dst, const PlankL n);
+
+/** Fill a buffer with uniformly distributed random floats between lower and upper.
+ Use -1 and 1 for bipolar noise. Each value consumes one 32-bit output.
+ @param p The <i>Plank RNGStream</i> object. 
+ @param dst The buffer to fill.
+ @param n The number of values to generate. 
+ @param lower The lower limit (inclusive). 
+ @param upper The upper limit (exclusive). */
+void pl_RNGStream_FillUniformF (PlankRNGStreamRef p, float* dst, const PlankL n, const float lower, const float upper);
+
+/** Fill a buffer with uniformly distributed random doubles between lower and upper.
+ Each value consumes two 32-bit outputs.
+ @param p The <i>Plank RNGStream</i> object. 
+ @param dst The buffer to fill.
+ @param n The number of values to generate. 
+ @param lower The lower limit (inclusive). 
+ @param upper The upper limit (exclusive). */
+void pl_RNGStream_FillUniformD (PlankRNGStreamRef p, double* dst, const PlankL n, const double lower, const double upper);
+
+/** Fill a buffer with exponentially distributed random floats between lower and upper.
+ The logarithms of the values are uniformly distributed (as with plonk's exprand),
+ lower and upper must both be non-zero and have the same sign.
+ @param p The <i>Plank RNGStream</i> object. 
+ @param dst The buffer to fill.
+ @param n The number of values to generate. 
+ @param lower The lower limit. 
+ @param upper The upper limit. */
+void pl_RNGStream_FillExponentialF (PlankRNGStreamRef p, float* dst, const PlankL n, const float lower, const float upper);
+
+/** Fill a buffer with exponentially distributed random doubles between lower and upper.
+ @see pl_RNGStream_FillExponentialF */
+void pl_RNGStream_FillExponentialD (PlankRNGStreamRef p, double* dst, const PlankL n, const double lower, const double upper);
+
+/** Fill a buffer with normally distributed random floats.
+ This uses the Box-Muller transform, each pair of values consumes two 32-bit outputs.
+ @param p The <i>Plank RNGStream</i> object. 
+ @param dst The buffer to fill.
+ @param n The number of values to generate. 
+ @param mean The mean of the distribution. 
+ @param deviation The standard deviation of the distribution. */
+void pl_RNGStream_FillGaussianF (PlankRNGStreamRef p, float* dst, const PlankL n, const float mean, const float deviation);
+
+/** Fill a buffer with normally distributed random doubles.
+ Each pair of values consumes four 32-bit outputs.
+ @see pl_RNGStream_FillGaussianF */
+void pl_RNGStream_FillGaussianD (PlankRNGStreamRef p, double* dst, const PlankL n, const double mean, const double deviation);
+
+/** @} */
+
+PLANK_END_C_LINKAGE
+
+#if !DOXYGEN
+typedef struct PlankRNGStream
+{
+    PlankUI key[2];         // the seed
+    PlankUI stream[2];      // the substream, the upper half of the Philox counter
+    PlankULL block;         // the next block to generate, the lower half of the Philox counter
+    PlankUI buffer[4];      // the most recent block when the position isn't on a block boundary
+    int bufferIndex;        // the next unused value in the buffer, 4 if empty
+} PlankRNGStream;
+#endif
+
+#endif // PLANK_RNGSTREAM_H
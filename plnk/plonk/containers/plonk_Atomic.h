@@ -47,6 +47,16 @@ public:
     {
         pl_AtomicMemoryBarrier();
     }
+    
+    PLONK_INLINE_LOW static void acquireFence() throw()
+    {
+        pl_AtomicAcquireFence();
+    }
+    
+    PLONK_INLINE_LOW static void releaseFence() throw()
+    {
+        pl_AtomicReleaseFence();
+    }
 };
 
 template<class Type>
@@ -148,6 +158,10 @@ class AtomicExtended : public AtomicBase<Type>
         PLONK_INLINE_LOW void setValue (const Plank##TYPECODE other) throw() { pl_Atomic##FUNCCODE##_Set (getAtomicRef(), other); }\
         PLONK_INLINE_LOW Plank##TYPECODE getValue() const throw() { return pl_Atomic##FUNCCODE##_Get (getAtomicRef()); }\
         PLONK_INLINE_LOW Plank##TYPECODE getValueUnchecked() const throw() { return pl_Atomic##FUNCCODE##_GetUnchecked (getAtomicRef()); }\
+        PLONK_INLINE_LOW Plank##TYPECODE getValueAcquire() const throw() { return pl_Atomic##FUNCCODE##_GetAcquire (getAtomicRef()); }\
+        PLONK_INLINE_LOW void setValueRelease (const Plank##TYPECODE other) throw() { pl_Atomic##FUNCCODE##_SetRelease (getAtomicRef(), other); }\
+        PLONK_INLINE_LOW const Plank##TYPECODE addRelaxed (const Plank##NUMCODE operand) throw() { return pl_Atomic##FUNCCODE##_AddRelaxed (getAtomicRef(), operand); }\
+        PLONK_INLINE_LOW const Plank##TYPECODE addRelease (const Plank##NUMCODE operand) throw() { return pl_Atomic##FUNCCODE##_AddRelease (getAtomicRef(), operand); }\
         \
         template<class OtherType> operator OtherType () const throw() { return static_cast<OtherType> (pl_Atomic##FUNCCODE##_Get (getAtomicRef())); }\
         PLONK_INLINE_LOW operator Plank##TYPECODE () const throw() { return pl_Atomic##FUNCCODE##_Get (getAtomicRef()); }\
@@ -298,6 +312,8 @@ public:
     PLONK_INLINE_LOW Type* operator->() const throw()                 { return static_cast<Type*> (pl_AtomicP_Get (getAtomicRef())); }
 
     PLONK_INLINE_LOW Type* getValueUnchecked() const throw()          { return static_cast<Type*> (pl_AtomicP_GetUnchecked (getAtomicRef())); }
+    PLONK_INLINE_LOW Type* getValueAcquire() const throw()            { return static_cast<Type*> (pl_AtomicP_GetAcquire (getAtomicRef())); }
+    PLONK_INLINE_LOW void setValueRelease (Type* other) throw()       { pl_AtomicP_SetRelease (getAtomicRef(), static_cast<void*> (other)); }
     PLONK_INLINE_LOW Type* getPtrUnchecked() const throw()            { return static_cast<Type*> (pl_AtomicP_GetUnchecked (getAtomicRef())); }
     PLONK_INLINE_LOW Long getExtra() const throw()                    { return pl_AtomicP_GetExtra (getAtomicRef()); }
     PLONK_INLINE_LOW Long getExtraUnchecked() const throw()           { return pl_AtomicP_GetExtraUnchecked (getAtomicRef()); }
@@ -445,6 +461,8 @@ public:
     PLONK_INLINE_LOW void* operator->() const throw()                 { return pl_AtomicP_Get (getAtomicRef()); }
     
     PLONK_INLINE_LOW void* getValueUnchecked() const throw()          { return pl_AtomicP_GetUnchecked (getAtomicRef()); }
+    PLONK_INLINE_LOW void* getValueAcquire() const throw()            { return pl_AtomicP_GetAcquire (getAtomicRef()); }
+    PLONK_INLINE_LOW void setValueRelease (void* other) throw()       { pl_AtomicP_SetRelease (getAtomicRef(), other); }
     PLONK_INLINE_LOW void* getPtrUnchecked() const throw()            { return pl_AtomicP_GetUnchecked (getAtomicRef()); }
     PLONK_INLINE_LOW UnsignedLong getExtra() const throw()                    { return pl_AtomicP_GetExtra (getAtomicRef()); }
     PLONK_INLINE_LOW UnsignedLong getExtraUnchecked() const throw()           { return pl_AtomicP_GetExtraUnchecked (getAtomicRef()); }
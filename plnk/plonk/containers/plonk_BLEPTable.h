@@ -0,0 +1,241 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_BLEPTABLE_H
+#define PLONK_BLEPTABLE_H
+
+#include "../core/plonk_CoreForwardDeclarations.h"
+#include "plonk_ContainerForwardDeclarations.h"
+#include "plonk_NumericalArray.h"
+#include "../fft/plonk_FFTEngine.h"
+
+
+/** Corrections that band limit the discontinuities of naive waveforms.
+ A naive sawtooth or pulse wave aliases because each jump is an ideal step. 
+ Adding the difference between a band limited step (BLEP) and the ideal step
+ at each jump removes most of the aliasing. Impulses are handled the same 
+ way using a band limited impulse.
+ 
+ The table holds a Blackman windowed sinc converted to minimum phase 
+ (minBLEP), so all of the correction comes after the discontinuity and can be
+ added as soon as it is found. The band limited steps are then centred 
+ getDelay() samples after the discontinuities so the parts of a waveform 
+ between them should be delayed to match, otherwise a sawtooth gains an
+ offset proportional to its frequency. addPolyStep() and addPolyImpulse() are a cheap
+ two sample polynomial approximation (PolyBLEP) that leaves more aliasing at
+ high frequencies.
+ 
+ The table only needs to be built once so use getShared() rather than 
+ creating one directly. This is intended for float and double samples only.
+ @ingroup PlonkContainerClasses */
+template<class SampleType>
+class BLEPTableBase
+{
+public:
+    typedef NumericalArray<SampleType>  Buffer;
+    typedef FFTEngineBase<double>       FFTEngineType;
+    
+    enum Constants
+    {
+        ZeroCrossings = 16,                 ///< The zero crossings each side of the windowed sinc.
+        Oversample = 64,                    ///< The table entries per sample.
+        Span = ZeroCrossings * 2,           ///< The number of samples corrected after a discontinuity.
+        TableLength = Span * Oversample,
+        FFTLength = TableLength * 4         ///< Padded to limit aliasing of the cepstrum.
+    };
+    
+    /** Creates the table. */
+    BLEPTableBase() throw()
+    :   steps (Buffer::newClear (TableLength + 2)),
+        impulses (Buffer::newClear (TableLength + 2)),
+        delay (0.0)
+    {
+        FFTEngineType fft (FFTLength);
+        DoubleArray signal (DoubleArray::newClear (FFTLength));
+        DoubleArray spectrum (DoubleArray::newClear (FFTLength));
+        double* const signalSamples = signal.getArray();
+        double* const spectrumSamples = spectrum.getArray();
+        const int halfLength = FFTLength / 2;
+        const double pi = Math<double>::getPi();
+        int i;
+        
+        for (i = 0; i < TableLength; ++i)
+        {
+            const double x = pi * double (i - TableLength / 2) / Oversample;
+            const double w = 2.0 * pi * double (i) / (TableLength - 1);
+            const double window = 0.42 - 0.5 * plonk::cos (w) + 0.08 * plonk::cos (2.0 * w);
+            signalSamples[i] = (x == 0.0 ? 1.0 : plonk::sin (x) / x) * window;
+        }
+        
+        // the real cepstrum is the inverse FFT of the log magnitudes
+        fft.forward (spectrumSamples, signalSamples);
+        
+        spectrumSamples[0] = logMagnitude (spectrumSamples[0], 0.0);
+        spectrumSamples[halfLength] = logMagnitude (spectrumSamples[halfLength], 0.0);
+        
+        for (i = 1; i < halfLength; ++i)
+        {
+            spectrumSamples[i] = logMagnitude (spectrumSamples[i], spectrumSamples[halfLength + i]);
+            spectrumSamples[halfLength + i] = 0.0;
+        }
+        
+        fft.inverse (signalSamples, spectrumSamples);
+        
+        // folding it onto positive times gives the cepstrum of the minimum phase version
+        for (i = 1; i < halfLength; ++i)
+        {
+            signalSamples[i] *= 2.0;
+            signalSamples[halfLength + i] = 0.0;
+        }
+        
+        fft.forward (spectrumSamples, signalSamples);
+        
+        spectrumSamples[0] = plonk::exp (spectrumSamples[0]);
+        spectrumSamples[halfLength] = plonk::exp (spectrumSamples[halfLength]);
+        
+        for (i = 1; i < halfLength; ++i)
+        {
+            const double magnitude = plonk::exp (spectrumSamples[i]);
+            const double phase = spectrumSamples[halfLength + i];
+            spectrumSamples[i] = magnitude * plonk::cos (phase);
+            spectrumSamples[halfLength + i] = magnitude * plonk::sin (phase);
+        }
+        
+        fft.inverse (signalSamples, spectrumSamples);
+        
+        double sum = 0.0;
+        
+        for (i = 0; i < TableLength; ++i)
+            sum += signalSamples[i];
+        
+        // impulses sum to 1 at any offset, steps are stored less the ideal step so end at 0
+        SampleType* const stepSamples = steps.getArray();
+        SampleType* const impulseSamples = impulses.getArray();
+        double step = 0.0;
+        double area = 0.0;
+        
+        for (i = 0; i < TableLength; ++i)
+        {
+            step += signalSamples[i] / sum;
+            stepSamples[i] = SampleType (step - 1.0);
+            impulseSamples[i] = SampleType (signalSamples[i] * Oversample / sum);
+            area += double (stepSamples[i]);
+        }
+        
+        // the area of the interpolated step correction is how much it lags the ideal step
+        area -= 0.5 * double (stepSamples[0]);
+        delay = -area / Oversample;
+    }
+    
+    /** Returns the table shared by all users. 
+     The table is created on first use, it is worth calling this before the 
+     audio thread does (e.g., when an oscillator using it is created). */
+    static const BLEPTableBase& getShared() throw()
+    {
+        static const BLEPTableBase table;
+        return table;
+    }
+    
+    /** The mean delay of the table's band limited impulse in samples. 
+     This is also how much area each step correction removes per unit height. */
+    PLONK_INLINE_LOW double getDelay() const throw() { return delay; }
+    
+    /** Adds the correction for a step using the table.
+     @param output  The first sample after the step, Span samples are changed.
+     @param offset  How long after the step the first sample is (0-1 samples).
+     @param height  The change in level at the step. */
+    PLONK_INLINE_LOW void addStep (SampleType* const output, const SampleType offset, const SampleType height) const throw()
+    {
+        add (output, steps.getArray(), offset, height);
+    }
+    
+    /** Adds a band limited impulse using the table.
+     @param output  The first sample after the impulse, Span samples are changed.
+     @param offset  How long after the impulse the first sample is (0-1 samples).
+     @param height  The area of the impulse. */
+    PLONK_INLINE_LOW void addImpulse (SampleType* const output, const SampleType offset, const SampleType height) const throw()
+    {
+        add (output, impulses.getArray(), offset, height);
+    }
+    
+    /** Adds the PolyBLEP correction for a step.
+     @param output  The first sample after the step, this and the sample before are changed.
+     @param offset  How long after the step the first sample is (0-1 samples).
+     @param height  The change in level at the step. */
+    static PLONK_INLINE_HIGH void addPolyStep (SampleType* const output, const SampleType offset, const SampleType height) throw()
+    {
+        const SampleType half (0.5);
+        const SampleType remaining = SampleType (1) - offset;
+        output[-1] += height * half * offset * offset;
+        output[0] -= height * half * remaining * remaining;
+    }
+    
+    /** Adds an impulse shared linearly between the samples either side.
+     @param output  The first sample after the impulse, this and the sample before are changed.
+     @param offset  How long after the impulse the first sample is (0-1 samples).
+     @param height  The area of the impulse. */
+    static PLONK_INLINE_HIGH void addPolyImpulse (SampleType* const output, const SampleType offset, const SampleType height) throw()
+    {
+        output[-1] += height * offset;
+        output[0] += height * (SampleType (1) - offset);
+    }
+    
+private:
+    Buffer steps;
+    Buffer impulses;
+    double delay;
+    
+    static double logMagnitude (const double real, const double imag) throw()
+    {
+        return plonk::log (plonk::max (plonk::sqrt (real * real + imag * imag), 1.0e-10));
+    }
+    
+    static PLONK_INLINE_HIGH void add (SampleType* const output, const SampleType* const table, 
+                                       const SampleType offset, const SampleType height) throw()
+    {
+        const SampleType position = offset * SampleType (Oversample);
+        int index = int (position);
+        const SampleType frac = position - SampleType (index);
+        
+        // the tables have two zeros at the end for offsets up to 1
+        for (int i = 0; i < Span; ++i, index += Oversample)
+            output[i] += height * (table[index] + frac * (table[index + 1] - table[index]));
+    }
+};
+
+#endif // PLONK_BLEPTABLE_H
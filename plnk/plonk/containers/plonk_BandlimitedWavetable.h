@@ -0,0 +1,305 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_BANDLIMITEDWAVETABLE_H
+#define PLONK_BANDLIMITEDWAVETABLE_H
+
+#include "../core/plonk_CoreForwardDeclarations.h"
+#include "plonk_ContainerForwardDeclarations.h"
+#include "plonk_NumericalArray.h"
+#include "../fft/plonk_FFTEngine.h"
+
+
+/** Waveforms available as shared bandlimited wavetables.
+ @see BandlimitedWavetableBase */
+class BandlimitedShape
+{
+public:
+    enum Shape
+    {
+        Saw,
+        Square,
+        Tri,
+        NumShapes
+    };
+};
+
+/** @internal */
+template<class Type>
+class BandlimitedWavetableLookup
+{
+public:
+    static PLONK_INLINE_HIGH void lookup (Type* output, const Type* table, const Type* indices, const int numItems) throw()
+    {
+        for (int i = 0; i < numItems; ++i)
+        {
+            const int index0 = int (indices[i]);
+            const Type frac = indices[i] - Type (index0);
+            output[i] = table[index0] + frac * (table[index0 + 1] - table[index0]);
+        }
+    }
+    
+    static PLONK_INLINE_HIGH void fade (Type* io, Type* other, const Type amount, const int numItems) throw()
+    {
+        for (int i = 0; i < numItems; ++i)
+            io[i] += amount * (other[i] - io[i]);
+    }
+};
+
+template<>
+class BandlimitedWavetableLookup<float>
+{
+public:
+    static PLONK_INLINE_HIGH void lookup (float* output, const float* table, const float* indices, const int numItems) throw()
+    {
+        pl_VectorLookupF_NnN (output, const_cast<float*> (table), 0, const_cast<float*> (indices), numItems);
+    }
+    
+    static PLONK_INLINE_HIGH void fade (float* io, float* other, const float amount, const int numItems) throw()
+    {
+        pl_VectorSubF_NNN (other, other, io, numItems);
+        pl_VectorMulAddF_NN1N (io, other, amount, io, numItems);
+    }
+};
+
+template<>
+class BandlimitedWavetableLookup<double>
+{
+public:
+    static PLONK_INLINE_HIGH void lookup (double* output, const double* table, const double* indices, const int numItems) throw()
+    {
+        pl_VectorLookupD_NnN (output, const_cast<double*> (table), 0, const_cast<double*> (indices), numItems);
+    }
+    
+    static PLONK_INLINE_HIGH void fade (double* io, double* other, const double amount, const int numItems) throw()
+    {
+        pl_VectorSubD_NNN (other, other, io, numItems);
+        pl_VectorMulAddD_NN1N (io, other, amount, io, numItems);
+    }
+};
+
+/** A set of per-octave wavetables for alias-free table lookup oscillators.
+ Level 0 holds the most harmonics, each following level holds half as many 
+ and the last level is a pure sine. Each level is generated with an inverse 
+ FFT so holds exactly its harmonics with no ripple from truncated series.
+ 
+ For a given frequency selectLevel() returns the level whose highest harmonic 
+ is between a quarter of the sample rate and Nyquist along with a fade towards 
+ the next level. The fade reaches the next level as the highest harmonic 
+ reaches Nyquist so the output never aliases and has no steps as the 
+ frequency sweeps.
+ 
+ The tables are large so use getShared() for the standard shapes rather than
+ creating them directly. This is intended for float and double samples only.
+ @ingroup PlonkContainerClasses */
+template<class SampleType>
+class BandlimitedWavetableBase
+{
+public:
+    typedef NumericalArray<SampleType>  Buffer;
+    typedef FFTEngineBase<SampleType>   FFTEngineType;
+    
+    /** Creates a table.
+     @param weights         The amplitudes of the sine phase harmonics, starting 
+                            at the fundamental. Harmonics beyond the capacity of
+                            level 0 are ignored.
+     @param tableLength     The length of each level, this must be a power of 2. 
+                            Level 0 holds up to a quarter of this many harmonics. */
+    BandlimitedWavetableBase (Buffer const& weights, const int tableLength = 4096) throw()
+    :   length (tableLength),
+        stride (tableLength + 2),
+        numLevels (Bits::countTrailingZeroes (tableLength) - 1),
+        levels (Buffer::newClear ((tableLength + 2) * (Bits::countTrailingZeroes (tableLength) - 1)))
+    {
+        plonk_assert (Bits::isPowerOf2 (tableLength) && (tableLength >= 16));
+        plonk_assert (weights.length() > 0);
+        
+        FFTEngineType fft (length);
+        Buffer spectrum (Buffer::withSize (length));
+        const int halfLength = length / 2;
+        const int numWeights = weights.length();
+        SampleType* const spectrumSamples = spectrum.getArray();
+        SampleType* const levelSamples = levels.getArray();
+        SampleType peak (0);
+        int level, i;
+        
+        for (level = 0; level < numLevels; ++level)
+        {
+            const int numHarmonics = plonk::min (numWeights, getNumHarmonics (level));
+            SampleType* const table = levelSamples + level * stride;
+            
+            spectrum.zero();
+            
+            // sine phase harmonics are the imaginary parts, in the upper half of the packed layout
+            for (i = 0; i < numHarmonics; ++i)
+                spectrumSamples[halfLength + i + 1] = weights.atUnchecked (i);
+            
+            fft.inverse (table, spectrumSamples);
+            
+            table[length] = table[0];
+            table[length + 1] = table[1];
+            
+            for (i = 0; i < length; ++i)
+                peak = plonk::max (peak, plonk::abs (table[i]));
+        }
+        
+        // one gain for all levels so fading between them doesn't change the level
+        if (peak > SampleType (0))
+            levels *= SampleType (1) / peak;
+    }
+    
+    /** Returns the table shared by all users of a shape. 
+     The table is created on first use, it is worth calling this before the 
+     audio thread does (e.g., when a BandlimitedTableUnit is created). */
+    static const BandlimitedWavetableBase& getShared (const BandlimitedShape::Shape shape) throw()
+    {
+        switch (shape)
+        {
+            case BandlimitedShape::Square:  { static const BandlimitedWavetableBase table (weights (BandlimitedShape::Square)); return table; }
+            case BandlimitedShape::Tri:     { static const BandlimitedWavetableBase table (weights (BandlimitedShape::Tri));    return table; }
+            default:                        { static const BandlimitedWavetableBase table (weights (BandlimitedShape::Saw));    return table; }
+        }
+    }
+    
+    /** Returns the harmonic amplitudes used for the shared tables. */
+    static Buffer weights (const BandlimitedShape::Shape shape, const int numHarmonics = 1024) throw()
+    {
+        Buffer result (Buffer::newClear (numHarmonics));
+        SampleType* const resultSamples = result.getArray();
+        
+        for (int i = 0; i < numHarmonics; ++i)
+        {
+            const int harmonic = i + 1;
+            
+            switch (shape)
+            {
+                case BandlimitedShape::Square:
+                    resultSamples[i] = (harmonic & 1) ? SampleType (1.0 / harmonic) : SampleType (0);
+                    break;
+                case BandlimitedShape::Tri:
+                    resultSamples[i] = (harmonic & 1) ? SampleType ((harmonic & 2 ? -1.0 : 1.0) / (double (harmonic) * harmonic)) : SampleType (0);
+                    break;
+                default:
+                    resultSamples[i] = SampleType (1.0 / harmonic);
+            }
+        }
+        
+        return result;
+    }
+    
+    PLONK_INLINE_LOW int getTableLength() const throw()    { return length; }
+    PLONK_INLINE_LOW int getNumLevels() const throw()      { return numLevels; }
+    
+    /** Returns the most harmonics a level can hold. */
+    PLONK_INLINE_LOW int getNumHarmonics (const int level) const throw()
+    {
+        return (length / 4) >> level;
+    }
+    
+    /** Returns a level's samples, these extend two samples past the table length
+     so that positions from 0 up to the table length can be interpolated. */
+    PLONK_INLINE_LOW const SampleType* getLevel (const int level) const throw()
+    {
+        plonk_assert ((level >= 0) && (level < numLevels));
+        return levels.getArray() + level * stride;
+    }
+    
+    /** Chooses the level for a frequency.
+     @param frequency   The frequency as a proportion of the sample rate.
+     @param level       Receives the level to use.
+     @param fade        Receives the amount of the next level to mix in (0-1). */
+    PLONK_INLINE_LOW void selectLevel (const double frequency, int& level, SampleType& fade) const throw()
+    {
+        const double absFrequency = plonk::abs (frequency);
+        
+        if (absFrequency > 0.0)
+        {
+            // the highest harmonic of level n is at Nyquist when this is n
+            const double octave = plonk::log2 (absFrequency * getNumHarmonics (0)) + 1.0;
+            const double floorOctave = plonk::floor (octave);
+            
+            level = int (floorOctave) + 1;
+            
+            if (level < 0)
+            {
+                level = 0;
+                fade = SampleType (0);
+                return;
+            }
+            else if (level >= numLevels - 1)
+            {
+                level = numLevels - 1;
+                fade = SampleType (0);
+                return;
+            }
+            
+            fade = SampleType (octave - floorOctave);
+        }
+        else
+        {
+            level = 0;
+            fade = SampleType (0);
+        }
+    }
+    
+    /** Looks up a block of positions.
+     @param output      Receives the samples.
+     @param positions   The positions, each from 0 up to the table length.
+     @param scratch     Must hold numItems samples, used only if fade is non-zero.
+     @param level       The level from selectLevel().
+     @param fade        The fade from selectLevel(). */
+    PLONK_INLINE_LOW void lookup (SampleType* output, const SampleType* positions, SampleType* scratch, 
+                                  const int level, const SampleType fade, const int numItems) const throw()
+    {
+        BandlimitedWavetableLookup<SampleType>::lookup (output, getLevel (level), positions, numItems);
+        
+        if (fade > SampleType (0))
+        {
+            BandlimitedWavetableLookup<SampleType>::lookup (scratch, getLevel (level + 1), positions, numItems);
+            BandlimitedWavetableLookup<SampleType>::fade (output, scratch, fade, numItems);
+        }
+    }
+
+private:
+    int length;
+    int stride;
+    int numLevels;
+    Buffer levels;
+};
+
+#endif // PLONK_BANDLIMITEDWAVETABLE_H
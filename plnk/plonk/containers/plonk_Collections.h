@@ -57,12 +57,14 @@ public:
     typedef Dictionary<ValueType,KeyType> Container;
     
 	DictionaryInternal() throw()
+    :   generation (0)
 	{
 	}
 	
     DictionaryInternal (const int initialCapacity) throw()
     :   values (ObjectArray<ValueType>::emptyWithAllocatedSize (initialCapacity)),
-        keys (ObjectArray<KeyType>::emptyWithAllocatedSize (initialCapacity))
+        keys (ObjectArray<KeyType>::emptyWithAllocatedSize (initialCapacity)),
+        generation (0)
 	{
 	}
     
@@ -89,10 +91,21 @@ public:
 	{
 		return keys;
 	}
+    
+    int getGeneration() const throw()
+    {
+        return generation;
+    }
+    
+    void changed() throw()
+    {
+        ++generation;
+    }
 	
 private:
 	ObjectArray<ValueType> values;
 	ObjectArray<KeyType> keys;
+    int generation;
 };
 
 
@@ -225,6 +238,13 @@ public:
 	{
 		return this->getInternal()->getKeys(); 
 	}
+    
+    /** Returns a count that changes each time an item is put or removed. 
+     Copies of the dictionary share this. */
+    int getGeneration() const throw()
+    {
+        return this->getInternal()->getGeneration();
+    }
 
 	/** Returns an array of the key/value pairs. */
 	KeyValuePairArrayType getPairs() const throw()
@@ -247,6 +267,7 @@ public:
 		ObjectArray<KeyType>& keys = this->getInternal()->getKeys();
 
 		int index = keys.indexOf (key);
+		this->getInternal()->changed();
 		
 		if (index >= 0)
 		{
@@ -362,6 +383,7 @@ public:
 		
 		if (index >= 0)
 		{
+			this->getInternal()->changed();
 			ValueType removed = values[index];
 			keys.remove (index);
 			values.remove (index);
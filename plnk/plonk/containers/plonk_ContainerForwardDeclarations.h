@@ -70,6 +70,8 @@ template<class ValueType>                                                   clas
 
 template<class ValueType>                                                   class LockFreeQueue;
 template<class ValueType>                                                   class LockFreeStack;
+template<class ValueType>                                                   class RingBufferSPSC;
+template<class ValueType>                                                   class RingBufferMPSC;
 
 template<class ValueType>                                                   class SimpleQueue;
 template<class ValueType>                                                   class SimpleStack;
@@ -81,6 +83,9 @@ template<class SampleType>                                                  clas
 template<class SampleType>                                                  class BreakpointsInternal;
 template<class SampleType>                                                  class BreakpointsBase;
 template<class SampleType>                                                  class WavetableBase;
+template<class SampleType>                                                  class SincTableBase;
+template<class SampleType>                                                  class BandlimitedWavetableBase;
+template<class SampleType>                                                  class BLEPTableBase;
 template<class SampleType>                                                  class SignalBase;
 
 template<class ReturnType,
@@ -221,6 +226,18 @@ typedef WavetableBase<Int24>                 Int24Wavetable;
 typedef WavetableBase<Long>                  LongWavetable;
 typedef WavetableBase<PLONK_TYPE_DEFAULT>    Wavetable;
 
+typedef SincTableBase<Float>                 FloatSincTable;
+typedef SincTableBase<Double>                DoubleSincTable;
+typedef SincTableBase<PLONK_TYPE_DEFAULT>    SincTable;
+
+typedef BandlimitedWavetableBase<Float>                 FloatBandlimitedWavetable;
+typedef BandlimitedWavetableBase<Double>                DoubleBandlimitedWavetable;
+typedef BandlimitedWavetableBase<PLONK_TYPE_DEFAULT>    BandlimitedWavetable;
+
+typedef BLEPTableBase<Float>                 FloatBLEPTable;
+typedef BLEPTableBase<Double>                DoubleBLEPTable;
+typedef BLEPTableBase<PLONK_TYPE_DEFAULT>    BLEPTable;
+
 typedef SignalBase<Float>                 FloatSignal;
 typedef SignalBase<Double>                DoubleSignal;
 typedef SignalBase<Short>                 ShortSignal;
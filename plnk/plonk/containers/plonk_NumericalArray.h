@@ -151,6 +151,50 @@ public:
 		}
         else plonk_assertfalse;
 	}
+    
+    /** Fill with uniformly distributed values from a stream.
+     This generates doubles in chunks and converts them so that it works for any 
+     type, the float and double specialisations fill the destination directly. */
+    static PLONK_INLINE_LOW void rand (PlankRNGStream& stream,
+                                       NumericalType* const dst,
+                                       const UnsignedLong size, 
+                                       const NumericalType lower, 
+                                       const NumericalType upper) throw()
+    {
+        double values[64];
+        UnsignedLong i, j, chunk;
+        
+        for (i = 0; i < size; i += chunk)
+        {
+            chunk = plonk::min (size - i, UnsignedLong (64));
+            pl_RNGStream_FillUniformD (&stream, values, chunk, double (lower), double (upper));
+            
+            for (j = 0; j < chunk; ++j)
+                dst[i + j] = NumericalType (values[j]);
+        }
+    }
+    
+    /** Fill with normally distributed values from a stream.
+     Values are clipped to the range of the type. */
+    static PLONK_INLINE_LOW void gaussian (PlankRNGStream& stream,
+                                           NumericalType* const dst,
+                                           const UnsignedLong size, 
+                                           const NumericalType mean, 
+                                           const NumericalType deviation) throw()
+    {
+        const double peak = double (TypeUtility<NumericalType>::getTypePeak());
+        double values[64];
+        UnsignedLong i, j, chunk;
+        
+        for (i = 0; i < size; i += chunk)
+        {
+            chunk = plonk::min (size - i, UnsignedLong (64));
+            pl_RNGStream_FillGaussianD (&stream, values, chunk, double (mean), double (deviation));
+            
+            for (j = 0; j < chunk; ++j)
+                dst[i + j] = NumericalType (plonk::clip (values[j], -peak, peak));
+        }
+    }
 };
 
 template<class NumericalType>
@@ -187,6 +231,40 @@ public:
 		}
         else plonk_assertfalse;
 	}
+    
+    static PLONK_INLINE_LOW void rand (float* const dst, const UnsignedLong size, const float lower, const float upper) throw()
+	{
+        if (size >= 1)
+            RNG::global().fillUniform (dst, size, lower, upper);
+        else plonk_assertfalse;
+    }
+    
+    static PLONK_INLINE_LOW void rand (float* const dst, const UnsignedLong size, const float upper) throw()
+    {
+        rand (dst, size, float (0), upper);
+    }
+	
+	static PLONK_INLINE_LOW void rand2 (float* const dst, const UnsignedLong size, const float positive) throw()
+	{
+		rand (dst, size, -positive, positive);
+	}
+	
+	static PLONK_INLINE_LOW void exprand (float* const dst, const UnsignedLong size, const float lower, const float upper) throw()
+	{
+        if (size >= 1)
+            RNG::global().fillExponential (dst, size, lower, upper);
+        else plonk_assertfalse;
+	}
+    
+    static PLONK_INLINE_LOW void rand (PlankRNGStream& stream, float* const dst, const UnsignedLong size, const float lower, const float upper) throw()
+    {
+        pl_RNGStream_FillUniformF (&stream, dst, size, lower, upper);
+    }
+    
+    static PLONK_INLINE_LOW void gaussian (PlankRNGStream& stream, float* const dst, const UnsignedLong size, const float mean, const float deviation) throw()
+    {
+        pl_RNGStream_FillGaussianF (&stream, dst, size, mean, deviation);
+    }
 };
 
 template<>
@@ -218,6 +296,40 @@ public:
 		}
         else plonk_assertfalse;
 	}
+    
+    static PLONK_INLINE_LOW void rand (double* const dst, const UnsignedLong size, const double lower, const double upper) throw()
+	{
+        if (size >= 1)
+            RNG::global().fillUniform (dst, size, lower, upper);
+        else plonk_assertfalse;
+    }
+    
+    static PLONK_INLINE_LOW void rand (double* const dst, const UnsignedLong size, const double upper) throw()
+    {
+        rand (dst, size, double (0), upper);
+    }
+	
+	static PLONK_INLINE_LOW void rand2 (double* const dst, const UnsignedLong size, const double positive) throw()
+	{
+		rand (dst, size, -positive, positive);
+	}
+	
+	static PLONK_INLINE_LOW void exprand (double* const dst, const UnsignedLong size, const double lower, const double upper) throw()
+	{
+        if (size >= 1)
+            RNG::global().fillExponential (dst, size, lower, upper);
+        else plonk_assertfalse;
+	}
+    
+    static PLONK_INLINE_LOW void rand (PlankRNGStream& stream, double* const dst, const UnsignedLong size, const double lower, const double upper) throw()
+    {
+        pl_RNGStream_FillUniformD (&stream, dst, size, lower, upper);
+    }
+    
+    static PLONK_INLINE_LOW void gaussian (PlankRNGStream& stream, double* const dst, const UnsignedLong size, const double mean, const double deviation) throw()
+    {
+        pl_RNGStream_FillGaussianD (&stream, dst, size, mean, deviation);
+    }
 };
 
 
@@ -302,8 +414,8 @@ class NumericalArrayConverterBase<float, Int24>
 public:
     static PLONK_INLINE_LOW void convertDirect (float* const dst, const Int24* const src, const UnsignedLong numItems) throw()
     {
-        for (UnsignedLong i = 0; i < numItems; ++i)
-            dst[i] = float (src[i]);
+        plonk_staticassert (sizeof (Int24) == sizeof (Int24::Internal));
+        pl_VectorConvertI242F_NN (dst, reinterpret_cast<const Int24::Internal*> (src), numItems);
     }
     
     static PLONK_INLINE_LOW void convertScaled (float* const dst, const Int24* const src, const UnsignedLong numItems) throw()
@@ -941,6 +1053,21 @@ public:
         
         return *this;
 	}
+    
+#if PLONK_RVALUEREFERENCES
+    /** Move constructor. */
+    PLONK_INLINE_LOW NumericalArray (NumericalArray&& other) throw()
+	:	Base (static_cast<Base&&> (other))
+	{
+	}    
+    
+    /** Move assignment operator. */
+    PLONK_INLINE_LOW NumericalArray& operator= (NumericalArray&& other) throw()
+	{
+        Base::operator= (static_cast<Base&&> (other));
+        return *this;
+	}
+#endif
 
     PLONK_INLINE_LOW NumericalArray (ObjectArray<NumericalType> const& copy) throw()
 	:	Base (static_cast<Base const&> (copy))
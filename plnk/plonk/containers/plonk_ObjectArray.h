@@ -200,6 +200,21 @@ public:
         
         return *this;
 	}
+    
+#if PLONK_RVALUEREFERENCES
+    /** Move constructor. */
+    PLONK_INLINE_LOW ObjectArray (ObjectArray&& other) throw()
+    :   Base (static_cast<Base&&> (other))
+    {
+    }
+    
+    /** Move assignment operator. */
+    ObjectArray& operator= (ObjectArray&& other) throw()
+	{
+        Base::operator= (static_cast<Base&&> (other));
+        return *this;
+	}
+#endif
     	
 	/** Create a copy of another array.
 	 You need to be sure that the other array type can be casted to the type of this array. */
@@ -50,6 +50,96 @@ BEGIN_PLONK_NAMESPACE
 //static AtomicInt blockDeallocationCounts[ObjectMemoryPools::NumQueues];
 #endif
 
+/** A stack of free blocks of one size class. */
+class ObjectMemoryPools::Magazine
+{
+public:
+    int count;
+    void* blocks[MagazineSize];
+};
+
+/** A thread's loaded and previous magazines for each size class. */
+class ObjectMemoryPools::ThreadCache
+{
+public:
+    ObjectMemoryPools* owner;               // 0 while being flushed
+    Magazine* loaded[NumSizeClasses];
+    Magazine* previous[NumSizeClasses];
+    int hits[NumSizeClasses];               // not yet added to the shared counters
+};
+
+/** The shared pool of magazines for a size class. */
+class ObjectMemoryPools::SizeClass : public PlonkBase
+{
+public:
+    LockFreeQueue<Element> full;            // magazines holding at least one block
+    LockFreeQueue<Element> empty;
+    AtomicInt numFull;
+    AtomicInt minFull;                      // the fewest full magazines since the last trim
+    AtomicInt reserve;                      // full magazines that trimming keeps
+    AtomicLong hits;
+    AtomicLong misses;
+    AtomicLong numBlocks;
+    AtomicLong highWater;
+    AtomicLong numTrimmed;
+    AtomicLong numAdopted;
+    AtomicInt numEmpty;
+    AtomicInt reserveEmpty;                 // empty magazines kept for preheated blocks
+};
+
+/** Spare thread caches and blocks freed when no empty magazine was spare. */
+class ObjectMemoryPools::Spares : public PlonkBase
+{
+public:
+    LockFreeQueue<Element> caches;
+    AtomicInt numCaches;
+    AtomicInt numCachesWanted;
+    AtomicValue<void*> frees;               // linked through each block's first word
+};
+
+/** Set in the header of blocks allocated before the pools were installed,
+ these aren't counted in any size class until they are freed into the pools. */
+static const UnsignedLong plonk_ObjectMemoryPoolsUncounted = 1;
+
+static PLONK_THREADLOCAL void* plonk_ObjectMemoryPoolsThreadCache = 0;
+
+#if PLONK_WIN
+static VOID WINAPI plonk_ObjectMemoryPoolsThreadExit (PVOID cache)
+#else
+static void plonk_ObjectMemoryPoolsThreadExit (void* cache)
+#endif
+{
+    // threads that didn't flush their cache before exiting
+    plonk_ObjectMemoryPoolsThreadCache = cache;
+    ObjectMemoryPools::flushThreadCache();
+}
+
+#if !PLONK_WIN
+static pthread_key_t plonk_createObjectMemoryPoolsThreadExitKey() throw()
+{
+    pthread_key_t key;
+    pthread_key_create (&key, plonk_ObjectMemoryPoolsThreadExit);
+    return key;
+}
+#endif
+
+static void plonk_setObjectMemoryPoolsThreadExit (void* cache) throw()
+{
+#if PLONK_WIN
+    static const DWORD key = FlsAlloc (plonk_ObjectMemoryPoolsThreadExit);
+    FlsSetValue (key, cache);
+#else
+    static const pthread_key_t key = plonk_createObjectMemoryPoolsThreadExitKey();
+    pthread_setspecific (key, cache);
+#endif
+}
+
+static AtomicValue<ObjectMemoryPools*>& plonk_getActiveObjectMemoryPoolsRef() throw()
+{
+    static AtomicValue<ObjectMemoryPools*> activePools;
+    return activePools;
+}
+
 void* ObjectMemoryPools::staticAlloc (void* userData, UnsignedLong size)
 {
     ObjectMemoryPools& om = *static_cast<ObjectMemoryPools*> (userData);
@@ -64,10 +154,10 @@ void ObjectMemoryPools::staticFree (void* userData, void* ptr)
 
 static PLONK_INLINE_LOW void* staticDoAlloc (void* userData, UnsignedLong requestedSize) throw()
 {    
-    const UnsignedLong align = PLONK_WORDSIZE * 2;
-    const UnsignedLong size = Bits::nextPowerOf2 (requestedSize + align);
+    const UnsignedLong align = ObjectMemoryPools::Alignment;
+    const UnsignedLong size = ObjectMemoryPools::getSizeClassBytes (ObjectMemoryPools::getSizeClass (requestedSize + align));
     UnsignedChar* raw = static_cast<UnsignedChar*> (pl_MemoryDefaultAllocateBytes (userData, size));
-    *reinterpret_cast<UnsignedLong*> (raw) = size;
+    *reinterpret_cast<UnsignedLong*> (raw) = size | plonk_ObjectMemoryPoolsUncounted;
         
     return raw + align;
 }
@@ -80,7 +170,7 @@ static PLONK_INLINE_LOW void staticDoFree (void* userData, void* ptr) throw()
     
     if (ptr != 0)
     {
-        const UnsignedLong align = PLONK_WORDSIZE * 2;
+        const UnsignedLong align = ObjectMemoryPools::Alignment;
         UnsignedChar* const raw = static_cast<UnsignedChar*> (ptr) - align;
         pl_MemoryDefaultFree (userData, raw);
     }
@@ -88,90 +178,631 @@ static PLONK_INLINE_LOW void staticDoFree (void* userData, void* ptr) throw()
 
 ObjectMemoryPools::ObjectMemoryPools (Memory& m) throw()
 :   ObjectMemoryBase (m),
-    Threading::Thread ("plonk::ObjectMemoryPools::Threading::Thread")
+    Threading::Thread ("plonk::ObjectMemoryPools::Threading::Thread"),
+    trimInterval (10.0)
 {
     getMemory().resetUserData();
     getMemory().setFunctions (staticDoAlloc, staticDoFree); 
     
     AtomicOps::memoryBarrier();
-    queues = new LockFreeQueue<Element>[NumQueues];
+    sizeClasses = new SizeClass[NumSizeClasses];
+    spares = new Spares;
+    spares->numCachesWanted.setValue (MinimumSpareThreadCaches);
     AtomicOps::memoryBarrier();
     
+    // create the thread exit key now rather than on the audio thread
+    plonk_setObjectMemoryPoolsThreadExit (plonk_ObjectMemoryPoolsThreadCache);
+    
+    plonk_getActiveObjectMemoryPoolsRef().setPtr (this);
     getMemory().setUserData (this);
     getMemory().setFunctions (staticAlloc, staticFree); 
+    
+    topUp();
 }
 
 ObjectMemoryPools::~ObjectMemoryPools()
 {
-    setShouldExitAndWait(); // the thread clears the queues
+    flushThreadCache();
+    setShouldExitAndWait(); // the thread releases the pooled blocks
     //<-- something could happen here on another thread but we should be shut down by now..?
+    
+    if (plonk_getActiveObjectMemoryPoolsRef().getPtr() == this)
+        plonk_getActiveObjectMemoryPoolsRef().setPtr (0);
+    
     getMemory().resetUserData();
     getMemory().setFunctions (staticDoAlloc, staticDoFree); 
-    delete [] queues;
+    trim (true); // in case the thread was never started
+    delete spares;
+    delete [] sizeClasses;
+}
+
+int ObjectMemoryPools::getSizeClass (const UnsignedLong size) throw()
+{
+    if (size <= MinimumBlockSize)
+        return 0;
+    
+    // four classes in each octave, e.g., 40, 48, 56, 64 for 33 to 64 bytes
+    const UnsignedLong value = size - 1;
+    const int octave = (int)Bits::numBitsRequired (value) - 1;
+    const int step = (int)(value >> (octave - 2)) - NumSizeClassesPerOctave;
+    
+    return 1 + (octave - MinimumBlockSizeLog2) * NumSizeClassesPerOctave + step;
+}
+
+UnsignedLong ObjectMemoryPools::getSizeClassBytes (const int sizeClass) throw()
+{
+    plonk_assert (sizeClass >= 0 && sizeClass < NumSizeClasses);
+    
+    if (sizeClass == 0)
+        return MinimumBlockSize;
+    
+    const int octave = (sizeClass - 1) / NumSizeClassesPerOctave + MinimumBlockSizeLog2;
+    const int step = (sizeClass - 1) % NumSizeClassesPerOctave;
+    
+    return UnsignedLong (NumSizeClassesPerOctave + 1 + step) << (octave - 2);
 }
 
 void* ObjectMemoryPools::allocateBytes (UnsignedLong requestedSize)
 {    
-    const UnsignedLong align = PLONK_WORDSIZE * 2;
-    const UnsignedLong size = Bits::nextPowerOf2 (requestedSize + align);
-    const UnsignedLong sizeLog2 = size > 0 ? Bits::countTrailingZeroes (size) : 0;
-    plonk_assert (sizeLog2 >= 0 && sizeLog2 < NumQueues);
+    const int sizeClass = getSizeClass (requestedSize + Alignment);
+    plonk_assert (sizeClass >= 0 && sizeClass < NumSizeClasses);
     
-    void* rtn = 0;
-    Element e = queues[sizeLog2].pop();
+    ThreadCache* const cache = getThreadCache();
     
-    if (e.ptr != 0)
+    if (cache != 0)
     {
-        rtn = e.ptr;
-#if PLONK_DEBUG
-        UnsignedChar* raw = static_cast<UnsignedChar*> (rtn) - align;
-        plonk_assert (*reinterpret_cast<UnsignedLong*> (raw) == size);
-#endif
+        Magazine* const loaded = cache->loaded[sizeClass];
+        
+        if ((loaded != 0) && (loaded->count > 0))
+        {
+            ++cache->hits[sizeClass];
+            return loaded->blocks[--loaded->count];
+        }
+        
+        Magazine* const previous = cache->previous[sizeClass];
+        
+        if ((previous != 0) && (previous->count > 0))
+        {
+            cache->previous[sizeClass] = loaded;
+            cache->loaded[sizeClass] = previous;
+            ++cache->hits[sizeClass];
+            return previous->blocks[--previous->count];
+        }
+        
+        Magazine* const full = popFull (sizeClass);
+        
+        if (full != 0)
+        {
+            // keep one empty magazine for frees, the other goes back to the pool
+            void* const ptr = full->blocks[--full->count];
+            cache->loaded[sizeClass] = full;
+            cache->previous[sizeClass] = loaded;
+            
+            sizeClasses[sizeClass].hits += cache->hits[sizeClass] + 1;
+            cache->hits[sizeClass] = 0;
+            
+            // do this last, it may allocate from this cache
+            if (previous != 0)
+                pushEmpty (sizeClass, previous);
+            
+            return ptr;
+        }
     }
     else
     {
-        rtn = staticDoAlloc (this, size);
+        Magazine* const magazine = popFull (sizeClass);
+        
+        if (magazine != 0)
+        {
+            void* const ptr = magazine->blocks[--magazine->count];
+            
+            if (magazine->count > 0)
+                pushFull (sizeClass, magazine);
+            else
+                pushEmpty (sizeClass, magazine);
+            
+            ++sizeClasses[sizeClass].hits;
+            return ptr;
+        }
     }
-
-    return rtn;
+    
+    ++sizeClasses[sizeClass].misses;
+    return allocateBlock (sizeClass);
 }
 
 void ObjectMemoryPools::free (void* ptr)
 {
     if (ptr != 0)
     {
-        const UnsignedLong align = PLONK_WORDSIZE * 2;
-        UnsignedChar* const raw = static_cast<UnsignedChar*> (ptr) - align;
-        const UnsignedLong size = *reinterpret_cast<UnsignedLong*> (raw);
-        const UnsignedLong sizeLog2 = size > 0 ? Bits::countTrailingZeroes (size) : 0;
-        plonk_assert (sizeLog2 >= 0 && sizeLog2 < NumQueues);
+        UnsignedChar* const raw = static_cast<UnsignedChar*> (ptr) - Alignment;
+        UnsignedLong& header = *reinterpret_cast<UnsignedLong*> (raw);
+        const UnsignedLong size = header & ~plonk_ObjectMemoryPoolsUncounted;
+        const int sizeClass = getSizeClass (size);
+        plonk_assert (getSizeClassBytes (sizeClass) == size);
+        
+        if (header != size)
+        {
+            // allocated before the pools were installed, count it from now on
+            SizeClass& pool = sizeClasses[sizeClass];
+            header = size;
+            pool.highWater.setIfLarger (++pool.numBlocks);
+            ++pool.numAdopted;
+        }
+        
+        ThreadCache* const cache = getThreadCache();
+        
+        if (cache != 0)
+        {
+            Magazine* const loaded = cache->loaded[sizeClass];
+            
+            if ((loaded != 0) && (loaded->count < MagazineSize))
+            {
+                loaded->blocks[loaded->count++] = ptr;
+                return;
+            }
+            
+            Magazine* const previous = cache->previous[sizeClass];
+            
+            if ((previous != 0) && (previous->count < MagazineSize))
+            {
+                cache->previous[sizeClass] = loaded;
+                cache->loaded[sizeClass] = previous;
+                previous->blocks[previous->count++] = ptr;
+                return;
+            }
+            
+            // both full, start an empty magazine and return the older full one to the pool
+            Magazine* const empty = popEmpty (sizeClass);
+            
+            if (empty == 0)
+            {
+                deferFree (ptr);
+                return;
+            }
+            
+            empty->blocks[empty->count++] = ptr;
+            cache->loaded[sizeClass] = empty;
+            cache->previous[sizeClass] = loaded;
+            
+            // do this last, it may allocate from this cache
+            if (previous != 0)
+                pushFull (sizeClass, previous);
+        }
+        else
+        {
+            Magazine* const magazine = popEmpty (sizeClass);
+            
+            if (magazine == 0)
+            {
+                deferFree (ptr);
+                return;
+            }
+            
+            magazine->blocks[magazine->count++] = ptr;
+            pushFull (sizeClass, magazine);
+        }
+    }
+}
+
+void ObjectMemoryPools::preheat (const UnsignedLong size, const int count) throw()
+{
+    const int sizeClass = getSizeClass (size + Alignment);
+    SizeClass& pool = sizeClasses[sizeClass];
+    int remaining = count;
+    
+    while (remaining > 0)
+    {
+        Magazine* const magazine = popEmpty (sizeClass);
+        
+        while ((magazine->count < MagazineSize) && (remaining > 0))
+        {
+            magazine->blocks[magazine->count++] = allocateBlock (sizeClass);
+            --remaining;
+        }
+        
+        pushFull (sizeClass, magazine);
+        ++pool.reserve;
+        ++pool.reserveEmpty;
+    }
+    
+    // empty magazines so frees of these blocks don't need to allocate either
+    topUp();
+}
+
+void ObjectMemoryPools::preheatThreads (const int numThreads) throw()
+{
+    spares->numCachesWanted.setIfLarger (numThreads);
+    topUp();
+}
+
+void ObjectMemoryPools::setTrimInterval (const double seconds) throw()
+{
+    trimInterval.setValue (seconds);
+}
+
+double ObjectMemoryPools::getTrimInterval() const throw()
+{
+    return trimInterval.getValue();
+}
+
+ObjectMemoryPools::Stats ObjectMemoryPools::getStats (const int sizeClass) const throw()
+{
+    plonk_assert (sizeClass >= 0 && sizeClass < NumSizeClasses);
+
+    const SizeClass& pool = sizeClasses[sizeClass];
+    Stats stats;
+    
+    stats.hits       = pool.hits.getValue();
+    stats.misses     = pool.misses.getValue();
+    stats.numBlocks  = pool.numBlocks.getValue();
+    stats.highWater  = pool.highWater.getValue();
+    stats.numTrimmed = pool.numTrimmed.getValue();
+    stats.numAdopted = pool.numAdopted.getValue();
+    stats.numBytes   = stats.numBlocks * (Long)getSizeClassBytes (sizeClass);
+    
+    return stats;
+}
+
+ObjectMemoryPools::Stats ObjectMemoryPools::getStats() const throw()
+{
+    Stats total;
+    
+    for (int i = 0; i < NumSizeClasses; ++i)
+    {
+        const Stats stats = getStats (i);
+        total.hits       += stats.hits;
+        total.misses     += stats.misses;
+        total.numBlocks  += stats.numBlocks;
+        total.highWater  += stats.highWater;
+        total.numTrimmed += stats.numTrimmed;
+        total.numAdopted += stats.numAdopted;
+        total.numBytes   += stats.numBytes;
+    }
+    
+    return total;
+}
+
+void ObjectMemoryPools::flushThreadCache() throw()
+{
+    ThreadCache* const cache = static_cast<ThreadCache*> (plonk_ObjectMemoryPoolsThreadCache);
+    
+    if ((cache != 0) && (cache->owner != 0))
+    {
+        ObjectMemoryPools* const active = plonk_getActiveObjectMemoryPoolsRef().getPtr();
+        
+        if (cache->owner == active)
+            active->flushThreadCache (cache);
+        else
+            discardThreadCache (cache);
+    }
+}
+
+ObjectMemoryPools::ThreadCache* ObjectMemoryPools::getThreadCache() throw()
+{
+    ThreadCache* cache = static_cast<ThreadCache*> (plonk_ObjectMemoryPoolsThreadCache);
+    
+    if ((cache != 0) && (cache->owner != this) && (cache->owner != 0) && 
+        (cache->owner != plonk_getActiveObjectMemoryPoolsRef().getPtrUnchecked()))
+    {
+        // left over from pools that have since been deleted
+        discardThreadCache (cache);
+        cache = 0;
+    }
+    
+    if (cache == 0)
+    {
+        Element e;
+        
+        if (spares->caches.pop (e))
+        {
+            --spares->numCaches;
+            cache = static_cast<ThreadCache*> (e.ptr);
+        }
+        else if (Threading::currentThreadIsAudioThread())
+        {
+            // use the shared pools until the pool thread makes more spares
+            return 0;
+        }
+        else
+        {
+            cache = static_cast<ThreadCache*> (pl_MemoryDefaultAllocateBytes (this, sizeof (ThreadCache)));
+            
+            if (cache == 0)
+                return 0;
+        }
+        
+        Memory::zero (cache, sizeof (ThreadCache));
+        cache->owner = this;
+        setThreadCache (cache);
+    }
+    
+    return cache->owner == this ? cache : 0;
+}
+
+void ObjectMemoryPools::flushThreadCache (ThreadCache* const cache) throw()
+{
+    plonk_assert (cache->owner == this);
+    
+    // allocations while flushing bypass the cache
+    cache->owner = 0;
+    
+    for (int i = 0; i < NumSizeClasses; ++i)
+    {
+        sizeClasses[i].hits += cache->hits[i];
+        
+        Magazine* const magazines[2] = { cache->loaded[i], cache->previous[i] };
+        cache->loaded[i] = cache->previous[i] = 0;
+
+        for (int j = 0; j < 2; ++j)
+        {
+            if (magazines[j] != 0)
+            {
+                if (magazines[j]->count > 0)
+                    pushFull (i, magazines[j]);
+                else
+                    pushEmpty (i, magazines[j]);
+            }
+        }
+    }
+    
+    setThreadCache (0);
+    pl_MemoryDefaultFree (this, cache);
+}
+
+void ObjectMemoryPools::discardThreadCache (ThreadCache* const cache) throw()
+{
+    for (int i = 0; i < NumSizeClasses; ++i)
+    {
+        Magazine* const magazines[2] = { cache->loaded[i], cache->previous[i] };
+        
+        for (int j = 0; j < 2; ++j)
+        {
+            if (magazines[j] != 0)
+            {
+                for (int k = 0; k < magazines[j]->count; ++k)
+                    staticDoFree (0, magazines[j]->blocks[k]);
+                
+                pl_MemoryDefaultFree (0, magazines[j]);
+            }
+        }
+    }
+    
+    setThreadCache (0);
+    pl_MemoryDefaultFree (0, cache);
+}
 
-        Element e (ptr);
-        queues[sizeLog2].push (e);
+void ObjectMemoryPools::setThreadCache (ThreadCache* const cache) throw()
+{
+    plonk_ObjectMemoryPoolsThreadCache = cache;
+    plonk_setObjectMemoryPoolsThreadExit (cache);
+}
+
+void* ObjectMemoryPools::allocateBlock (const int sizeClass) throw()
+{
+    SizeClass& pool = sizeClasses[sizeClass];
+    const UnsignedLong size = getSizeClassBytes (sizeClass);
+    UnsignedChar* const raw = static_cast<UnsignedChar*> (pl_MemoryDefaultAllocateBytes (this, size));
+    
+    if (raw == 0)
+        return 0;
+    
+    *reinterpret_cast<UnsignedLong*> (raw) = size;
+    pool.highWater.setIfLarger (++pool.numBlocks);
+    
+    return raw + Alignment;
+}
+
+void ObjectMemoryPools::freeBlock (const int sizeClass, void* const ptr) throw()
+{
+    SizeClass& pool = sizeClasses[sizeClass];
+    staticDoFree (this, ptr);
+    --pool.numBlocks;
+}
+
+ObjectMemoryPools::Magazine* ObjectMemoryPools::popFull (const int sizeClass) throw()
+{
+    SizeClass& pool = sizeClasses[sizeClass];
+    Element e;
+    
+    if (!pool.full.pop (e))
+        return 0;
+    
+    pool.minFull.setIfSmaller (--pool.numFull);
+    return static_cast<Magazine*> (e.ptr);
+}
+
+void ObjectMemoryPools::pushFull (const int sizeClass, Magazine* const magazine) throw()
+{
+    SizeClass& pool = sizeClasses[sizeClass];
+    plonk_assert (magazine->count > 0);
+    pool.full.push (Element (magazine));
+    ++pool.numFull;
+}
+
+ObjectMemoryPools::Magazine* ObjectMemoryPools::popEmpty (const int sizeClass) throw()
+{
+    SizeClass& pool = sizeClasses[sizeClass];
+    Element e;
+    
+    if (pool.empty.pop (e))
+    {
+        --pool.numEmpty;
+        return static_cast<Magazine*> (e.ptr);
+    }
+    
+    // the pool thread tops up the empty magazines for the audio thread
+    if (Threading::currentThreadIsAudioThread())
+        return 0;
+    
+    return allocateMagazine();
+}
+
+void ObjectMemoryPools::pushEmpty (const int sizeClass, Magazine* const magazine) throw()
+{
+    SizeClass& pool = sizeClasses[sizeClass];
+    plonk_assert (magazine->count == 0);
+    pool.empty.push (Element (magazine));
+    ++pool.numEmpty;
+}
+
+ObjectMemoryPools::Magazine* ObjectMemoryPools::allocateMagazine() throw()
+{
+    Magazine* const magazine = static_cast<Magazine*> (pl_MemoryDefaultAllocateBytes (this, sizeof (Magazine)));
+    
+    if (magazine != 0)
+        magazine->count = 0;
+    
+    return magazine;
+}
+
+void ObjectMemoryPools::deferFree (void* const ptr) throw()
+{
+    void* head;
+    
+    do
+    {
+        head = spares->frees.getValueUnchecked();
+        *static_cast<void**> (ptr) = head;
+    } while (!spares->frees.compareAndSwap (head, ptr));
+}
+
+bool ObjectMemoryPools::poolDeferredFrees() throw()
+{
+    void* ptr = spares->frees.swap (0);
+    
+    if (ptr == 0)
+        return false;
+    
+    while (ptr != 0)
+    {
+        void* const next = *static_cast<void**> (ptr);
+        free (ptr);
+        ptr = next;
+    }
+    
+    return true;
+}
+
+void ObjectMemoryPools::topUp() throw()
+{
+    for (int i = 0; i < NumSizeClasses; ++i)
+    {
+        SizeClass& pool = sizeClasses[i];
+        
+        if ((pool.numBlocks.getValue() == 0) && (pool.reserveEmpty.getValue() == 0))
+            continue;
+        
+        const int numWanted = plonk::max (pool.reserveEmpty.getValue(), (int)MinimumEmptyMagazines);
+        
+        while (pool.numEmpty.getValue() < numWanted)
+        {
+            Magazine* const magazine = allocateMagazine();
+            
+            if (magazine == 0)
+                break;
+            
+            pushEmpty (i, magazine);
+        }
+    }
+    
+    while (spares->numCaches.getValue() < spares->numCachesWanted.getValue())
+    {
+        void* const cache = pl_MemoryDefaultAllocateBytes (this, sizeof (ThreadCache));
+        
+        if (cache == 0)
+            break;
+        
+        spares->caches.push (Element (cache));
+        ++spares->numCaches;
+    }
+}
+
+void ObjectMemoryPools::trim (const bool all) throw()
+{
+    for (int i = 0; i < NumSizeClasses; ++i)
+    {
+        SizeClass& pool = sizeClasses[i];
+        
+        // magazines that stayed in the pool for the whole interval weren't needed
+        int numToRelease = all ? pool.numFull.getValue() : pool.minFull.getValue() - pool.reserve.getValue();
+        Magazine* magazine;
+        
+        while ((numToRelease-- > 0) && ((magazine = popFull (i)) != 0))
+        {
+            pool.numTrimmed += magazine->count;
+            
+            for (int j = 0; j < magazine->count; ++j)
+                freeBlock (i, magazine->blocks[j]);
+            
+            pl_MemoryDefaultFree (this, magazine);
+        }
+        
+        if (all)
+        {
+            Element e;
+            
+            while (pool.empty.pop (e))
+            {
+                --pool.numEmpty;
+                pl_MemoryDefaultFree (this, e.ptr);
+            }
+        }
+        
+        pool.minFull.setValue (pool.numFull.getValue());
+    }
+    
+    if (all)
+    {
+        void* ptr = spares->frees.swap (0);
+        
+        while (ptr != 0)
+        {
+            void* const next = *static_cast<void**> (ptr);
+            const UnsignedLong size = *reinterpret_cast<UnsignedLong*> (static_cast<UnsignedChar*> (ptr) - Alignment);
+            freeBlock (getSizeClass (size), ptr);
+            ptr = next;
+        }
+        
+        Element e;
+        
+        while (spares->caches.pop (e))
+        {
+            --spares->numCaches;
+            pl_MemoryDefaultFree (this, e.ptr);
+        }
     }
 }
 
 ResultCode ObjectMemoryPools::run() throw()
 {
-    int i;
-//    const double minDuration = 0.000001;
-    const double maxDuration = 0.1;
-    double duration = maxDuration;//minDuration;
+    const double checkInterval = 0.1;
+    double elapsed = 0.0;
     
     while (!getShouldExit())
     {
-        for (i = 0; i < NumQueues; ++i)
+        plonk_assert (getMemory().getUserData() == this);
+        Threading::sleep (checkInterval);
+        elapsed += checkInterval;
+        
+        // return this thread's magazines so the blocks can be reused elsewhere
+        if (poolDeferredFrees())
+            flushThreadCache();
+        
+        topUp();
+        
+        const double interval = trimInterval.getValue();
+        
+        if ((interval > 0.0) && (elapsed >= interval))
         {
-            plonk_assert (getMemory().getUserData() == this);
-            // could delete some here gradually
-            Threading::sleep (duration);
+            trim (false);
+            elapsed = 0.0;
         }
     }
     
     getMemory().setFunctions (staticDoAlloc, staticDoFree); 
     
-    for (i = 0; i < NumQueues; ++i)
-        queues[i].clearAll();
+    flushThreadCache();
+    trim (true);
     
     return 0;
 }
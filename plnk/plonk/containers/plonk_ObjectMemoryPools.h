@@ -39,6 +39,19 @@
 #ifndef PLONK_OBJECTMEMORYPOOLS_H
 #define PLONK_OBJECTMEMORYPOOLS_H
 
+/** Pooled memory allocation.
+ Freed blocks are kept in pools by size class and reused. The size classes step
+ by at most 1.25x. Each thread has a cache of two "magazines" of blocks for each 
+ size class so most allocations and frees touch only the thread's own cache, 
+ whole magazines are exchanged with the shared pools. 
+ 
+ Use preheat() to fill the pools before starting the audio thread so it
+ doesn't need to allocate from the system. The audio thread never allocates a
+ thread cache or an empty magazine itself: it takes spares kept by the background
+ thread (see preheatThreads()) or uses the shared pools directly, and blocks it 
+ can't put in a magazine are handed to the background thread to pool. 
+ The background thread also periodically returns blocks that have been unused 
+ for the whole trim interval to the system. */
 class ObjectMemoryPools :   public ObjectMemoryBase,
                             public Threading::Thread
 {
@@ -46,7 +59,14 @@ public:
     
     enum Constants
     {
-        NumQueues = 64
+        Alignment = PLONK_WORDSIZE * 2,     // also space for the header storing the block size
+        MinimumBlockSize = 32,
+        MinimumBlockSizeLog2 = 5,
+        NumSizeClassesPerOctave = 4,
+        NumSizeClasses = 1 + (PLONK_WORDBITS - MinimumBlockSizeLog2) * NumSizeClassesPerOctave,
+        MagazineSize = 32,
+        MinimumEmptyMagazines = 2,          // kept in each size class in use
+        MinimumSpareThreadCaches = 2
     };
     
     class Element : public PlonkBase
@@ -57,6 +77,24 @@ public:
 
         void* ptr;
     };
+    
+    /** Counters for a size class or for all size classes. */
+    class Stats
+    {
+    public:
+        Stats() throw()
+        :   hits (0), misses (0), numBlocks (0), highWater (0), numTrimmed (0), numAdopted (0), numBytes (0)
+        {
+        }
+        
+        Long hits;          ///< Allocations reusing a pooled block (threads' caches are counted as whole magazines are exchanged).
+        Long misses;        ///< Allocations needing a new block from the system.
+        Long numBlocks;     ///< Blocks currently allocated from the system, in use or pooled.
+        Long highWater;     ///< The largest numBlocks has been (for all size classes this is the sum of each class's high water).
+        Long numTrimmed;    ///< Blocks returned to the system by trimming.
+        Long numAdopted;    ///< Blocks allocated before the pools were installed and later freed into them.
+        Long numBytes;      ///< Bytes currently allocated from the system.
+    };
             
     ObjectMemoryPools (Memory& memory) throw();
     ~ObjectMemoryPools();
@@ -70,8 +108,65 @@ public:
     void* allocateBytes (PlankUL size);
     void free (void* ptr);
     
+    /** Allocate blocks in advance for allocations of a particular size.
+     These blocks are reserved so trimming will not return them to the system. 
+     An empty magazine is also kept for each full one so frees of these blocks
+     don't need to allocate either. This should be called before the audio thread starts. */
+    void preheat (const UnsignedLong size, const int count) throw();
+    
+    /** Keep enough spare thread caches for this many threads to start allocating
+     without allocating their caches from the system. */
+    void preheatThreads (const int numThreads) throw();
+    
+    /** Set how long blocks must be unused before trimming returns them to the system. 
+     The default is 10 seconds, 0 disables trimming. */
+    void setTrimInterval (const double seconds) throw();
+    double getTrimInterval() const throw();
+    
+    /** Return the calling thread's cached blocks to the shared pools.
+     This is done automatically when any thread that has a cache exits. */
+    static void flushThreadCache() throw();
+    
+    /** Get the counters for a size class. */
+    Stats getStats (const int sizeClass) const throw();
+    
+    /** Get the counters for all the size classes. */
+    Stats getStats() const throw();
+    
+    /** Get the size class needed for a block of this many bytes (including the header). */
+    static int getSizeClass (const UnsignedLong size) throw();
+    
+    /** Get the size in bytes of blocks in a size class (including the header). */
+    static UnsignedLong getSizeClassBytes (const int sizeClass) throw();
+    
 private:
-    LockFreeQueue<Element>* queues;    
+    class Magazine;
+    class ThreadCache;
+    class SizeClass;
+    class Spares;
+    
+    SizeClass* sizeClasses;
+    Spares* spares;
+    AtomicDouble trimInterval;
+    
+    ThreadCache* getThreadCache() throw();
+    void flushThreadCache (ThreadCache* const cache) throw();
+    static void discardThreadCache (ThreadCache* const cache) throw();
+    static void setThreadCache (ThreadCache* const cache) throw();
+    
+    void* allocateBlock (const int sizeClass) throw();
+    void freeBlock (const int sizeClass, void* const ptr) throw();
+    
+    Magazine* popFull (const int sizeClass) throw();
+    void pushFull (const int sizeClass, Magazine* const magazine) throw();
+    Magazine* popEmpty (const int sizeClass) throw();
+    void pushEmpty (const int sizeClass, Magazine* const magazine) throw();
+    Magazine* allocateMagazine() throw();
+    
+    void deferFree (void* const ptr) throw();
+    bool poolDeferredFrees() throw();
+    void topUp() throw();
+    void trim (const bool all) throw();
 };
 
 #endif // PLONK_OBJECTMEMORYPOOLS_H
\ No newline at end of file
@@ -0,0 +1,558 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_RINGBUFFER_H
+#define PLONK_RINGBUFFER_H
+
+#include "../core/plonk_CoreForwardDeclarations.h"
+#include "plonk_ContainerForwardDeclarations.h"
+
+#include "../core/plonk_SmartPointer.h"
+#include "../core/plonk_WeakPointer.h"
+
+/** Raw storage for relocating values into and out of the Plank ring buffers.
+ The ring buffers copy items bytewise so values are copy constructed here and 
+ their bytes handed over to the buffer, which then owns those references. This 
+ relies on ValueType being relocatable with a bytewise copy, which is true of 
+ all the Plonk containers and smart pointers. */
+template<class ValueType, int Count>
+class RingBufferSlots
+{
+public:
+    PLONK_INLINE_LOW RingBufferSlots() throw()
+    :   numConstructed (0)
+    {
+    }
+    
+    PLONK_INLINE_LOW ~RingBufferSlots()
+    {
+        destroy (0);
+    }
+    
+    /** Copy constructs values ready to be pushed. */
+    PLONK_INLINE_LOW void construct (const ValueType* values, const int count) throw()
+    {
+        plonk_assert (numConstructed == 0);
+        plonk_assert (count <= Count);
+        
+        for (int i = 0; i < count; ++i)
+            ::new (storage + i * sizeof (ValueType)) ValueType (values[i]);
+        
+        numConstructed = count;
+    }
+    
+    /** The buffer now owns the first @e count values, any others are destroyed. */
+    PLONK_INLINE_LOW void release (const int count) throw()
+    {
+        destroy (count);
+    }
+    
+    /** The buffer popped @e count values into the storage. */
+    PLONK_INLINE_LOW void adopt (const int count) throw()
+    {
+        plonk_assert (numConstructed == 0);
+        plonk_assert (count <= Count);
+        numConstructed = count;
+    }
+    
+    /** Moves the values out and destroys the remains. */
+    template<class OtherType>
+    PLONK_INLINE_LOW void moveTo (OtherType* values) throw()
+    {
+        for (int i = 0; i < numConstructed; ++i)
+        {
+#if PLONK_RVALUEREFERENCES
+            values[i] = static_cast<ValueType&&> (at (i));
+#else
+            values[i] = at (i);
+#endif
+        }
+        
+        destroy (0);
+    }
+    
+    PLONK_INLINE_LOW void* getStorage() throw() { return storage; }
+    
+private:
+    PLONK_ALIGN(16) char storage[sizeof (ValueType) * Count];
+    int numConstructed;
+    
+    PLONK_INLINE_LOW ValueType& at (const int index) throw()
+    {
+        return *reinterpret_cast<ValueType*> (storage + index * sizeof (ValueType));
+    }
+    
+    PLONK_INLINE_LOW void destroy (const int start) throw()
+    {
+        for (int i = start; i < numConstructed; ++i)
+            at (i).~ValueType();
+        
+        numConstructed = 0;
+    }
+    
+    RingBufferSlots (RingBufferSlots const&);
+    RingBufferSlots& operator= (RingBufferSlots const&);
+};
+
+//------------------------------------------------------------------------------
+
+template<class ValueType>
+class RingBufferSPSCInternal : public SmartPointer
+{
+public:
+    typedef RingBufferSlots<ValueType,1>    Slot;
+    typedef RingBufferSlots<ValueType,32>   Batch;
+    
+    RingBufferSPSCInternal (const int capacity) throw()
+    {
+        ResultCode result = pl_RingBufferSPSC_InitWithItemSizeAndCapacity (&buffer, sizeof (ValueType), capacity);
+        plonk_assert (result == PlankResult_OK);
+#ifndef PLONK_DEBUG
+        (void)result;
+#endif
+    }
+    
+    ~RingBufferSPSCInternal()
+    {
+        clear();
+        pl_RingBufferSPSC_DeInit (&buffer);
+    }
+    
+    PLONK_INLINE_LOW bool push (ValueType const& value) throw()
+    {
+        Slot slot;
+        slot.construct (&value, 1);
+        const bool pushed = pl_RingBufferSPSC_Push (&buffer, slot.getStorage()) != PLANK_FALSE;
+        slot.release (pushed ? 1 : 0);
+        return pushed;
+    }
+    
+    template<class OtherType>
+    PLONK_INLINE_LOW bool pop (OtherType& value) throw()
+    {
+        Slot slot;
+        
+        if (! pl_RingBufferSPSC_Pop (&buffer, slot.getStorage()))
+            return false;
+        
+        slot.adopt (1);
+        slot.moveTo (&value);
+        return true;
+    }
+    
+    int pushItems (const ValueType* values, const int count) throw()
+    {
+        Batch batch;
+        int numPushed = 0;
+        
+        while (numPushed < count)
+        {
+            const int numToPush = plonk::min (count - numPushed, 32);
+            batch.construct (values + numPushed, numToPush);
+            
+            const int numDone = (int)pl_RingBufferSPSC_PushItems (&buffer, batch.getStorage(), numToPush);
+            batch.release (numDone);
+            numPushed += numDone;
+            
+            if (numDone < numToPush)
+                break;
+        }
+        
+        return numPushed;
+    }
+    
+    template<class OtherType>
+    int popItems (OtherType* values, const int count) throw()
+    {
+        Batch batch;
+        int numPopped = 0;
+        
+        while (numPopped < count)
+        {
+            const int numToPop = plonk::min (count - numPopped, 32);
+            
+            const int numDone = (int)pl_RingBufferSPSC_PopItems (&buffer, batch.getStorage(), numToPop);
+            batch.adopt (numDone);
+            batch.moveTo (values + numPopped);
+            numPopped += numDone;
+            
+            if (numDone < numToPop)
+                break;
+        }
+        
+        return numPopped;
+    }
+    
+    void clear() throw()
+    {
+        ValueType value;
+        while (pop (value)) { }
+    }
+    
+    PLONK_INLINE_LOW int length() throw()
+    {
+        return (int)pl_RingBufferSPSC_GetSize (&buffer);
+    }
+    
+    PLONK_INLINE_LOW int getCapacity() throw()
+    {
+        return (int)pl_RingBufferSPSC_GetCapacity (&buffer);
+    }
+    
+private:
+    PlankRingBufferSPSC buffer;
+};
+
+//------------------------------------------------------------------------------
+
+template<class ValueType>
+class RingBufferMPSCInternal : public SmartPointer
+{
+public:
+    typedef RingBufferSlots<ValueType,1>    Slot;
+    typedef RingBufferSlots<ValueType,32>   Batch;
+    
+    RingBufferMPSCInternal (const int capacity) throw()
+    {
+        ResultCode result = pl_RingBufferMPSC_InitWithItemSizeAndCapacity (&buffer, sizeof (ValueType), capacity);
+        plonk_assert (result == PlankResult_OK);
+#ifndef PLONK_DEBUG
+        (void)result;
+#endif
+    }
+    
+    ~RingBufferMPSCInternal()
+    {
+        clear();
+        pl_RingBufferMPSC_DeInit (&buffer);
+    }
+    
+    PLONK_INLINE_LOW bool push (ValueType const& value) throw()
+    {
+        Slot slot;
+        slot.construct (&value, 1);
+        const bool pushed = pl_RingBufferMPSC_Push (&buffer, slot.getStorage()) != PLANK_FALSE;
+        slot.release (pushed ? 1 : 0);
+        return pushed;
+    }
+    
+    template<class OtherType>
+    PLONK_INLINE_LOW bool pop (OtherType& value) throw()
+    {
+        Slot slot;
+        
+        if (! pl_RingBufferMPSC_Pop (&buffer, slot.getStorage()))
+            return false;
+        
+        slot.adopt (1);
+        slot.moveTo (&value);
+        return true;
+    }
+    
+    int pushItems (const ValueType* values, const int count) throw()
+    {
+        Batch batch;
+        int numPushed = 0;
+        
+        while (numPushed < count)
+        {
+            const int numToPush = plonk::min (count - numPushed, 32);
+            batch.construct (values + numPushed, numToPush);
+            
+            const int numDone = (int)pl_RingBufferMPSC_PushItems (&buffer, batch.getStorage(), numToPush);
+            batch.release (numDone);
+            numPushed += numDone;
+            
+            if (numDone < numToPush)
+                break;
+        }
+        
+        return numPushed;
+    }
+    
+    template<class OtherType>
+    int popItems (OtherType* values, const int count) throw()
+    {
+        Batch batch;
+        int numPopped = 0;
+        
+        while (numPopped < count)
+        {
+            const int numToPop = plonk::min (count - numPopped, 32);
+            
+            const int numDone = (int)pl_RingBufferMPSC_PopItems (&buffer, batch.getStorage(), numToPop);
+            batch.adopt (numDone);
+            batch.moveTo (values + numPopped);
+            numPopped += numDone;
+            
+            if (numDone < numToPop)
+                break;
+        }
+        
+        return numPopped;
+    }
+    
+    void clear() throw()
+    {
+        ValueType value;
+        while (pop (value)) { }
+    }
+    
+    PLONK_INLINE_LOW int length() throw()
+    {
+        return (int)pl_RingBufferMPSC_GetSize (&buffer);
+    }
+    
+    PLONK_INLINE_LOW int getCapacity() throw()
+    {
+        return (int)pl_RingBufferMPSC_GetCapacity (&buffer);
+    }
+    
+private:
+    PlankRingBufferMPSC buffer;
+};
+
+//------------------------------------------------------------------------------
+
+/** A bounded wait-free single-producer, single-consumer FIFO.
+ Unlike the LockFreeQueue this never allocates after construction but push() 
+ fails if the buffer is full. Only one thread may push and one thread may pop 
+ at any one time.
+ @ingroup PlonkContainerClasses */
+template<class ValueType>                                               
+class RingBufferSPSC : public SmartPointerContainer<RingBufferSPSCInternal<ValueType> >
+{
+public:
+    typedef RingBufferSPSCInternal<ValueType>   Internal;
+    typedef SmartPointerContainer<Internal>     Base;
+    typedef WeakPointerContainer<RingBufferSPSC> Weak;
+    typedef ValueType                           Value;
+    
+    /** Creates a buffer for at least @e capacity values, rounded up to a power of 2. */
+    PLONK_INLINE_LOW explicit RingBufferSPSC (const int capacity = PLANKRINGBUFFER_DEFAULTCAPACITY)
+    :   Base (new Internal (capacity))
+    {
+    }
+    
+    PLONK_INLINE_LOW explicit RingBufferSPSC (Internal* internalToUse) throw() 
+	:	Base (internalToUse)
+	{
+	}
+    
+    /** Get a weakly linked copy of this object. 
+     This will return a blank/empty/null object of this type if
+     the original has already been deleted. */    
+    static RingBufferSPSC fromWeak (Weak const& weak) throw()
+    {
+        return weak.fromWeak();
+    }    
+    
+    /** Copy constructor. */
+    PLONK_INLINE_LOW RingBufferSPSC (RingBufferSPSC const& copy) throw()
+    :   Base (static_cast<Base const&> (copy))
+    {
+    }
+    
+    /** Assignment operator. */
+    PLONK_INLINE_LOW RingBufferSPSC& operator= (RingBufferSPSC const& other) throw()
+	{
+		if (this != &other)
+            this->setInternal (other.getInternal());
+        
+        return *this;
+	}
+    
+    /** Pushes a copy of a value, returning false if the buffer was full. */
+    PLONK_INLINE_LOW bool push (ValueType const& value) throw()
+    {
+        return this->getInternal()->push (value);
+    }
+    
+    /** Pops a value or returns a null value if the buffer was empty. */
+    PLONK_INLINE_LOW ValueType pop() throw()
+    {
+        ValueType value;
+        this->getInternal()->pop (value);
+        return value;
+    }
+    
+    /** Pops a value returning false if the buffer was empty. */
+    template<class OtherType>
+    PLONK_INLINE_LOW bool pop (OtherType& value) throw()
+    {
+        return this->getInternal()->pop (value);
+    }
+    
+    /** Pushes copies of up to @e count values, returning the number pushed. 
+     The values are published to the consumer in batches. */
+    PLONK_INLINE_LOW int pushItems (const ValueType* values, const int count) throw()
+    {
+        return this->getInternal()->pushItems (values, count);
+    }
+    
+    /** Pops up to @e count values, returning the number popped. */
+    template<class OtherType>
+    PLONK_INLINE_LOW int popItems (OtherType* values, const int count) throw()
+    {
+        return this->getInternal()->popItems (values, count);
+    }
+    
+    /** Pops and discards all the values, only call this from the consumer thread. */
+    PLONK_INLINE_LOW void clear() throw()
+    {
+        this->getInternal()->clear();
+    }
+    
+    PLONK_INLINE_LOW int length() throw()
+    {
+        return this->getInternal()->length();
+    }
+    
+    PLONK_INLINE_LOW int getCapacity() throw()
+    {
+        return this->getInternal()->getCapacity();
+    }
+    
+    PLONK_OBJECTARROWOPERATOR(RingBufferSPSC);
+};
+
+//------------------------------------------------------------------------------
+
+/** A bounded multiple-producer, single-consumer FIFO.
+ Unlike the LockFreeQueue this never allocates after construction but push() 
+ fails if the buffer is full. Any thread may push but only one thread may pop
+ at any one time.
+ @ingroup PlonkContainerClasses */
+template<class ValueType>                                               
+class RingBufferMPSC : public SmartPointerContainer<RingBufferMPSCInternal<ValueType> >
+{
+public:
+    typedef RingBufferMPSCInternal<ValueType>   Internal;
+    typedef SmartPointerContainer<Internal>     Base;
+    typedef WeakPointerContainer<RingBufferMPSC> Weak;
+    typedef ValueType                           Value;
+    
+    /** Creates a buffer for at least @e capacity values, rounded up to a power of 2. */
+    PLONK_INLINE_LOW explicit RingBufferMPSC (const int capacity = PLANKRINGBUFFER_DEFAULTCAPACITY)
+    :   Base (new Internal (capacity))
+    {
+    }
+    
+    PLONK_INLINE_LOW explicit RingBufferMPSC (Internal* internalToUse) throw() 
+	:	Base (internalToUse)
+	{
+	}
+    
+    /** Get a weakly linked copy of this object. 
+     This will return a blank/empty/null object of this type if
+     the original has already been deleted. */    
+    static RingBufferMPSC fromWeak (Weak const& weak) throw()
+    {
+        return weak.fromWeak();
+    }    
+    
+    /** Copy constructor. */
+    PLONK_INLINE_LOW RingBufferMPSC (RingBufferMPSC const& copy) throw()
+    :   Base (static_cast<Base const&> (copy))
+    {
+    }
+    
+    /** Assignment operator. */
+    PLONK_INLINE_LOW RingBufferMPSC& operator= (RingBufferMPSC const& other) throw()
+	{
+		if (this != &other)
+            this->setInternal (other.getInternal());
+        
+        return *this;
+	}
+    
+    /** Pushes a copy of a value, returning false if the buffer was full. */
+    PLONK_INLINE_LOW bool push (ValueType const& value) throw()
+    {
+        return this->getInternal()->push (value);
+    }
+    
+    /** Pops a value or returns a null value if the buffer was empty. */
+    PLONK_INLINE_LOW ValueType pop() throw()
+    {
+        ValueType value;
+        this->getInternal()->pop (value);
+        return value;
+    }
+    
+    /** Pops a value returning false if the buffer was empty. */
+    template<class OtherType>
+    PLONK_INLINE_LOW bool pop (OtherType& value) throw()
+    {
+        return this->getInternal()->pop (value);
+    }
+    
+    /** Pushes copies of up to @e count values, returning the number pushed. 
+     Each batch occupies contiguous slots even with other threads pushing. */
+    PLONK_INLINE_LOW int pushItems (const ValueType* values, const int count) throw()
+    {
+        return this->getInternal()->pushItems (values, count);
+    }
+    
+    /** Pops up to @e count values, returning the number popped. */
+    template<class OtherType>
+    PLONK_INLINE_LOW int popItems (OtherType* values, const int count) throw()
+    {
+        return this->getInternal()->popItems (values, count);
+    }
+    
+    /** Pops and discards all the values, only call this from the consumer thread. */
+    PLONK_INLINE_LOW void clear() throw()
+    {
+        this->getInternal()->clear();
+    }
+    
+    PLONK_INLINE_LOW int length() throw()
+    {
+        return this->getInternal()->length();
+    }
+    
+    PLONK_INLINE_LOW int getCapacity() throw()
+    {
+        return this->getInternal()->getCapacity();
+    }
+    
+    PLONK_OBJECTARROWOPERATOR(RingBufferMPSC);
+};
+
+#endif // PLONK_RINGBUFFER_H
@@ -0,0 +1,357 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_SINCTABLE_H
+#define PLONK_SINCTABLE_H
+
+#include "../core/plonk_CoreForwardDeclarations.h"
+#include "plonk_ContainerForwardDeclarations.h"
+#include "plonk_NumericalArray.h"
+
+
+/** @internal */
+template<class Type>
+class SincTableDot
+{
+public:
+    static PLONK_INLINE_HIGH Type dot (const Type* a, const Type* b, const int numItems) throw()
+    {
+        Type result (0);
+        
+        for (int i = 0; i < numItems; ++i)
+            result += a[i] * b[i];
+        
+        return result;
+    }
+};
+
+template<>
+class SincTableDot<float>
+{
+public:
+    static PLONK_INLINE_HIGH float dot (const float* a, const float* b, const int numItems) throw()
+    {
+        float result;
+        pl_VectorAddMulF_1NN (&result, a, b, numItems);
+        return result;
+    }
+};
+
+template<>
+class SincTableDot<double>
+{
+public:
+    static PLONK_INLINE_HIGH double dot (const double* a, const double* b, const int numItems) throw()
+    {
+        double result;
+        pl_VectorAddMulD_1NN (&result, a, b, numItems);
+        return result;
+    }
+};
+
+/** A precomputed Kaiser-windowed sinc kernel for bandlimited interpolation.
+ The kernel is stored polyphase: one row of taps per fractional position so
+ that each output sample is an inner product of contiguous data (using the 
+ SIMD vector functions for float and double). Outputs between rows are linearly
+ interpolated from the neighbouring two rows. 
+ 
+ The tables are large and only depend on the quality preset so use getShared()
+ rather than creating them directly. This is intended for float and double
+ samples only. 
+ @ingroup PlonkContainerClasses */
+template<class SampleType>
+class SincTableBase
+{
+public:
+    typedef NumericalArray<SampleType> Buffer;
+    
+    /** Creates a table.
+     @param numTaps     The kernel length in samples, this must be even.
+     @param numPhases   The number of rows between adjacent samples.
+     @param beta        The Kaiser window shape, higher values trade a wider
+                        transition band for a lower stopband.
+     @param cutoff      The cutoff as a proportion of the Nyquist frequency. */
+    SincTableBase (const int numTaps, const int numPhases, const double beta, const double cutoff) throw()
+    :   taps (numTaps),
+        halfTaps (numTaps / 2),
+        phases (numPhases),
+        rows (Buffer::withSize ((numPhases + 1) * numTaps)),
+        impulse (Buffer::withSize (numTaps * numPhases + 1))
+    {
+        plonk_assert ((numTaps > 0) && ((numTaps & 1) == 0));
+        plonk_assert (numPhases > 0);
+        
+        const double window0 = besselI0 (beta);
+        SampleType* const rowSamples = rows.getArray();
+        SampleType* const impulseSamples = impulse.getArray();
+        int i, j;
+        
+        for (i = 0; i <= phases; ++i)
+        {
+            SampleType* const row = rowSamples + i * taps;
+            const double frac = double (i) / phases;
+            double sum = 0.0;
+            
+            for (j = 0; j < taps; ++j)
+            {
+                const double value = kernel (double (j - halfTaps + 1) - frac, beta, window0, cutoff);
+                row[j] = SampleType (value);
+                sum += value;
+            }
+            
+            // normalise each row for unity gain at DC
+            for (j = 0; j < taps; ++j)
+                row[j] = SampleType (row[j] / sum);
+        }
+        
+        for (i = 0; i < impulse.length(); ++i)
+            impulseSamples[i] = SampleType (kernel (double (i) / phases - halfTaps, beta, window0, cutoff));
+    }
+    
+    /** Returns the table shared by all users of a quality preset. 
+     The table is created on first use, it is worth calling this before the 
+     audio thread does (e.g., when a SincResampleUnit is created). */
+    static const SincTableBase& getShared (const SincQuality::Preset quality) throw()
+    {
+        switch (quality)
+        {
+            case SincQuality::Low:      { static const SincTableBase table (8,  128,  4.0,  0.85); return table; }
+            case SincQuality::High:     { static const SincTableBase table (32, 512,  8.5,  0.94); return table; }
+            case SincQuality::Best:     { static const SincTableBase table (64, 1024, 11.0, 0.97); return table; }
+            default:                    { static const SincTableBase table (16, 256,  6.0,  0.90); return table; }
+        }
+    }
+    
+    PLONK_INLINE_LOW int getNumTaps() const throw()     { return taps; }
+    PLONK_INLINE_LOW int getHalfTaps() const throw()    { return halfTaps; }
+    PLONK_INLINE_LOW int getNumPhases() const throw()   { return phases; }
+    
+    /** Returns the number of samples read either side of the index when the
+     kernel is stretched by 1/scale. */
+    PLONK_INLINE_LOW int getScaledHalfTaps (const double scale) const throw()
+    {
+        plonk_assert ((scale > 0.0) && (scale <= 1.0));
+        const int scaledHalfTaps = int (halfTaps / scale);
+        return (scaledHalfTaps * scale < halfTaps) ? scaledHalfTaps + 1 : scaledHalfTaps;
+    }
+    
+    /** Returns the number of rows between adjacent samples for buildScaledRows().
+     The stretched kernel is smoother so needs proportionally fewer. */
+    PLONK_INLINE_LOW int getScaledNumPhases (const double scale) const throw()
+    {
+        return plonk::max (16, int (phases * scale));
+    }
+    
+    /** Returns the number of values needed to hold the rows made by buildScaledRows(). */
+    PLONK_INLINE_LOW int getScaledRowsSize (const double scale) const throw()
+    {
+        return (getScaledNumPhases (scale) + 1) * getScaledHalfTaps (scale) * 2;
+    }
+    
+    /** Returns the most values buildScaledRows() needs for any scale from minScale up to 1.
+     Fewer rows are needed as the scale falls so this isn't at minScale. Within
+     each number of rows the most taps are needed at the smallest scale. */
+    int getMaxScaledRowsSize (const double minScale) const throw()
+    {
+        int maxSize = getScaledRowsSize (minScale);
+        
+        for (int i = int (phases * minScale) + 1; i < phases; ++i)
+        {
+            const int numPhases = plonk::max (16, i);
+            const int size = (numPhases + 1) * getScaledHalfTaps (double (i) / phases) * 2;
+            maxSize = plonk::max (maxSize, size);
+        }
+        
+        return maxSize;
+    }
+    
+    /** Interpolates between samples[index] and samples[index + 1].
+     This reads samples[index - getHalfTaps() + 1] to samples[index + getHalfTaps()]. */
+    PLONK_INLINE_LOW SampleType interpolate (const SampleType* samples, const int index, const double frac) const throw()
+    {
+        return interpolateRows (samples + index - halfTaps + 1, frac, rows.getArray(), taps, phases);
+    }
+    
+    /** Interpolates with the kernel stretched to band limit for downsampling.
+     The taps are built into the scratch array and then applied as an inner 
+     product. This suits ratios that change every sample, for a fixed ratio 
+     buildScaledRows() and interpolateScaled() are much cheaper.
+     @param scale   The reciprocal of the downsampling ratio (0-1).
+     @param scratch Must hold at least getScaledHalfTaps (scale) * 2 values.
+     This reads samples[index - getScaledHalfTaps (scale) + 1] to 
+     samples[index + getScaledHalfTaps (scale)]. */
+    PLONK_INLINE_LOW SampleType interpolate (const SampleType* samples, 
+                                             const int index, 
+                                             const double frac, 
+                                             const double scale,
+                                             SampleType* scratch) const throw()
+    {
+        plonk_assert ((frac >= 0.0) && (frac < 1.0));
+        
+        const int scaledHalfTaps = getScaledHalfTaps (scale);
+        const SampleType sum = buildScaled (frac, scale, scratch);
+        return SincTableDot<SampleType>::dot (samples + index - scaledHalfTaps + 1, scratch, scaledHalfTaps * 2) / sum;
+    }
+    
+    /** Builds a polyphase table for one downsampling ratio. 
+     @param scale       The reciprocal of the downsampling ratio (0-1).
+     @param scaledRows  Must hold getScaledRowsSize (scale) values. */
+    void buildScaledRows (const double scale, SampleType* scaledRows) const throw()
+    {
+        const int scaledTaps = getScaledHalfTaps (scale) * 2;
+        const int scaledPhases = getScaledNumPhases (scale);
+        
+        for (int i = 0; i <= scaledPhases; ++i)
+        {
+            SampleType* const row = scaledRows + i * scaledTaps;
+            const SampleType sum = buildScaled (double (i) / scaledPhases, scale, row);
+            
+            for (int j = 0; j < scaledTaps; ++j)
+                row[j] /= sum;
+        }
+    }
+    
+    /** Interpolates using rows made by buildScaledRows() with the same scale.
+     This reads the same samples as the scaled interpolate() function. */
+    PLONK_INLINE_LOW SampleType interpolateScaled (const SampleType* samples, 
+                                                   const int index, 
+                                                   const double frac, 
+                                                   const double scale,
+                                                   const SampleType* scaledRows) const throw()
+    {
+        const int scaledHalfTaps = getScaledHalfTaps (scale);
+        return interpolateRows (samples + index - scaledHalfTaps + 1, frac, scaledRows, scaledHalfTaps * 2, getScaledNumPhases (scale));
+    }
+    
+private:
+    int taps;
+    int halfTaps;
+    int phases;
+    Buffer rows;
+    Buffer impulse;
+    
+    static PLONK_INLINE_LOW SampleType interpolateRows (const SampleType* data, 
+                                                        const double frac, 
+                                                        const SampleType* rowSamples, 
+                                                        const int numTaps, 
+                                                        const int numPhases) throw()
+    {
+        plonk_assert ((frac >= 0.0) && (frac < 1.0));
+        
+        const double position = frac * numPhases;
+        const int row = int (position);
+        const SampleType rowFrac = SampleType (position - row);
+        const SampleType* const coeffs = rowSamples + row * numTaps;
+        
+        const SampleType value0 = SincTableDot<SampleType>::dot (data, coeffs, numTaps);
+        const SampleType value1 = SincTableDot<SampleType>::dot (data, coeffs + numTaps, numTaps);
+        return value0 + (value1 - value0) * rowFrac;
+    }
+    
+    /** Fills coeffs with the stretched kernel and returns their sum. */
+    PLONK_INLINE_LOW SampleType buildScaled (const double frac, const double scale, SampleType* coeffs) const throw()
+    {
+        const int scaledHalfTaps = getScaledHalfTaps (scale);
+        const int scaledTaps = scaledHalfTaps * 2;
+        const SampleType* const impulseSamples = impulse.getArray();
+        const int impulseLength = taps * phases;
+        const double step = scale * phases;
+        const double position0 = (double (1 - scaledHalfTaps) - frac) * step + double (halfTaps * phases);
+        
+        // only the outermost taps can fall outside the kernel
+        int start = 0;
+        int end = scaledTaps;
+        
+        while ((start < end) && (position0 + start * step <= 0.0))
+            coeffs[start++] = SampleType (0);
+        
+        while ((end > start) && (position0 + (end - 1) * step >= impulseLength))
+            coeffs[--end] = SampleType (0);
+        
+        SampleType sum (0);
+        double position = position0 + start * step;
+        
+        for (int i = start; i < end; ++i)
+        {
+            const int positionIndex = int (position);
+            const SampleType positionFrac = SampleType (position - positionIndex);
+            const SampleType value0 = impulseSamples[positionIndex];
+            const SampleType coeff = value0 + (impulseSamples[positionIndex + 1] - value0) * positionFrac;
+            coeffs[i] = coeff;
+            sum += coeff;
+            position += step;
+        }
+        
+        return sum;
+    }
+    
+    static double besselI0 (const double x) throw()
+    {
+        const double halfX = x * 0.5;
+        double sum = 1.0;
+        double term = 1.0;
+        
+        for (int k = 1; k < 64; ++k)
+        {
+            const double factor = halfX / k;
+            term *= factor * factor;
+            sum += term;
+            
+            if (term < sum * 1.0e-17)
+                break;
+        }
+        
+        return sum;
+    }
+    
+    double kernel (const double x, const double beta, const double window0, const double cutoff) const throw()
+    {
+        const double u = x / halfTaps;
+        
+        if ((u <= -1.0) || (u >= 1.0))
+            return 0.0;
+        
+        const double window = besselI0 (beta * plonk::sqrt (1.0 - u * u)) / window0;
+        const double angle = Math<double>::getPi() * cutoff * x;
+        const double sinc = (x == 0.0) ? 1.0 : plonk::sin (angle) / angle;
+        return cutoff * sinc * window;
+    }
+};
+
+
+#endif // PLONK_SINCTABLE_H
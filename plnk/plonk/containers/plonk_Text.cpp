@@ -196,6 +196,19 @@ Text& Text::operator= (Text const& other) throw()
     return *this;
 }
 
+#if PLONK_RVALUEREFERENCES
+Text::Text (Text&& other) throw()
+:	Base (static_cast<Base&&> (other))
+{
+}
+
+Text& Text::operator= (Text&& other) throw()
+{
+    Base::operator= (static_cast<Base&&> (other));
+    return *this;
+}
+#endif
+
 Text& Text::operator= (Base const& other) throw()
 {
 	return operator= (static_cast<Text const&> (other) );
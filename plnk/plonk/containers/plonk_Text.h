@@ -92,6 +92,11 @@ public:
     Text (Dynamic const& other) throw();
 //    Text (FilePath const& path) throw();
     Text& operator= (Text const& other) throw();
+    
+#if PLONK_RVALUEREFERENCES
+    Text (Text&& other) throw();
+    Text& operator= (Text&& other) throw();
+#endif
 
         
 	/** Copy numerical values from another numerical array type to a new Text string. */
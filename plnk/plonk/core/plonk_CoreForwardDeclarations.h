@@ -40,7 +40,6 @@
 #define PLONK_COREFORWARDDECLARATIONS_H
 
 class SmartPointer;
-class SmartPointerCounter;
 class WeakPointer;
 class TypeCode;
 
@@ -70,12 +70,14 @@
 #include "../containers/plonk_TextArray.h"
 #include "../containers/plonk_BreakPoints.h"
 #include "../containers/plonk_Wavetable.h"
+#include "../containers/plonk_SincTable.h"
 #include "../containers/plonk_Signal.h"
 #include "../containers/plonk_Int24.h"
 #include "../containers/plonk_Fix.h"
 #include "../containers/plonk_Function.h"
 #include "../containers/plonk_LockFreeQueue.h"
 #include "../containers/plonk_LockFreeStack.h"
+#include "../containers/plonk_RingBuffer.h"
 #include "../containers/plonk_ObjectMemoryDeferFree.h"
 #include "../containers/plonk_ObjectMemoryPools.h"
 
@@ -108,6 +110,8 @@
 
 #include "../fft/plonk_FFTEngine.h"
 #include "../fft/plonk_FFTEngineInternal.h"
+#include "../containers/plonk_BandlimitedWavetable.h"
+#include "../containers/plonk_BLEPTable.h"
 
 #include "../graph/plonk_GraphForwardDeclarations.h"
 
@@ -126,19 +130,25 @@
 #include "../graph/utility/plonk_TimeStamp.h"
 #include "../graph/utility/plonk_ProcessInfo.h"
 #include "../graph/utility/plonk_ProcessInfoInternal.h"
+#include "../graph/utility/plonk_ParallelRenderer.h"
+#include "../graph/utility/plonk_TaskPool.h"
 
 #include "../graph/info/plonk_InfoHeaders.h"
 
 #include "../graph/plonk_Unit.h"
+#include "../graph/utility/plonk_BufferPlanner.h"
+#include "../graph/utility/plonk_GraphSnapshot.h"
 
 #include "../graph/converters/plonk_TypeChannel.h"
 #include "../graph/converters/plonk_ResampleChannel.h"
+#include "../graph/converters/plonk_SincResampleChannel.h"
 #include "../graph/converters/plonk_OverlapMakeChannel.h"
 #include "../graph/converters/plonk_OverlapMixChannel.h"
 #include "../graph/converters/plonk_TaskChannel.h"
 #include "../graph/converters/plonk_ReblockChannel.h"
 
 
+#include "../graph/simple/plonk_FusedOpChannel.h"
 #include "../graph/simple/plonk_BinaryOpChannel.h"
 #include "../graph/simple/plonk_ConstantChannel.h"
 #include "../graph/simple/plonk_LinearPanChannel.h"
@@ -153,10 +163,15 @@
 #include "../graph/simple/plonk_PatchChannel.h"
 #include "../graph/simple/plonk_QueueChannel.h"
 #include "../graph/simple/plonk_BufferQueueChannel.h"
+#include "../graph/simple/plonk_PolyVoiceChannel.h"
 
 #include "../graph/generators/plonk_Saw.h"
 #include "../graph/generators/plonk_WhiteNoise.h"
+#include "../graph/generators/plonk_PinkNoise.h"
+#include "../graph/generators/plonk_GaussianNoise.h"
 #include "../graph/generators/plonk_Table.h"
+#include "../graph/generators/plonk_BandlimitedTable.h"
+#include "../graph/generators/plonk_BLEPOscillator.h"
 #include "../graph/generators/plonk_SignalPlay.h"
 #include "../graph/generators/plonk_SignalRead.h"
 #include "../graph/generators/plonk_FilePlay.h"
@@ -168,6 +183,7 @@
 #include "../graph/filters/plonk_FilterForms.h"
 #include "../graph/filters/plonk_FilterShapes.h"
 #include "../graph/filters/plonk_Filter.h"
+#include "../graph/filters/plonk_FilterBank.h"
 #include "../graph/filters/plonk_FilterCoeffs1Param.h"
 #include "../graph/filters/plonk_FilterCoeffs2Param.h"
 #include "../graph/filters/plonk_FilterCoeffs3Param.h"
@@ -190,6 +206,7 @@
 #include "../graph/delay/plonk_Delay2Param.h"
 #include "../graph/delay/plonk_Delay3Param.h"
 #include "../graph/delay/plonk_Delay4Param.h"
+#include "../graph/delay/plonk_DelayMultiTap.h"
 
 #include "../graph/control/plonk_EnvelopeChannel.h"
 #include "../graph/control/plonk_TriggerChannel.h"
@@ -200,6 +217,7 @@
 #include "../graph/fft/plonk_FFTChannel.h"
 #include "../graph/fft/plonk_IFFTChannel.h"
 #include "../graph/fft/plonk_ZMulChannel.h"
+#include "../graph/fft/plonk_ConvolveChannel.h"
 
 #include "../hosts/plonk_AudioHostBase.h"
 
@@ -99,21 +99,10 @@ static AtomicLong& getTotalSmartPointersAtom() throw()
     return totalSmartPointers;
 }
 
-static AtomicLong& getTotalSmartPointerCountersAtom() throw()
-{
-    static AtomicLong totalSmartPointerCounters;
-    return totalSmartPointerCounters;
-}
-
 const Long getTotalSmartPointers() throw()
 {
     return getTotalSmartPointersAtom().getValue();
 }
-
-const Long getTotalSmartPointerCounters() throw()
-{
-    return getTotalSmartPointerCountersAtom().getValue();
-}
 #endif
 
 
@@ -151,19 +140,11 @@ void PlonkBase::operator delete[] (void* ptr)
     Memory::global().free (ptr); 
 }
 
-SmartPointer::SmartPointer (const bool allocateWeakPointer) throw()
-:	counter (0), weakPointer (0)
+SmartPointer::SmartPointer (const bool allowWeakPointer) throw()
+:	refCount (0), 
+    weakPointer (0),
+    weakPointerAllowed (allowWeakPointer)
 {		
-    counter = new SmartPointerCounter (this);
-    
-	if (allocateWeakPointer)
-    {
-        WeakPointer* weak = new WeakPointer (counter);
-        weak->incrementRefCount();  // for the WeakPointer object
-        weak->incrementWeakCount(); // for the weak count for this object
-        this->weakPointer = weak;
-    }
-    
 #if PLONK_SMARTPOINTER_DEBUG
     ++getTotalSmartPointersAtom();
 #if PLONK_SMARTPOINTER_DEBUGLOG
@@ -181,213 +162,57 @@ SmartPointer::~SmartPointer()
 #endif
 #endif
     
-    // actually OK now as the weak ref would be nulled on the when the refcount hit zero
-    // another thread getting the weak ref must have intervened and inc'd it
-	//plonk_assert (counter->getRefCount() == 0); 
-    
     if (weakPointer != 0)
     {
         WeakPointer* weak = static_cast<WeakPointer*> (weakPointer.getPtrUnchecked());
-        weak->decrementWeakCount(); // for the weak count for this object
+        weak->clearPeer();          // waits for any thread in the middle of WeakPointer::retainPeer()
         weak->decrementRefCount();  // for the WeakPointer object
         weakPointer = 0;
     }    
 }
 
-void SmartPointer::incrementRefCount()  throw()
-{	
-    counter->incrementRefCount();
-}
-
-void SmartPointer::decrementRefCount()  throw()
-{ 
-    plonk_assert (counter->getRefCount() > 0);
-    counter->decrementRefCount(); 
-}
-
-void* SmartPointer::getWeak() const throw()               
-{ 
-    return weakPointer.getPtrUnchecked(); 
-}
-
-int SmartPointer::getRefCount() const throw()            
-{ 
-    return counter->getRefCount(); 
-}
-
-///-----------------------------------------------------------------------------
-
-SmartPointerCounter::SmartPointerCounter (SmartPointer* smartPointer) throw()
-:   atom (smartPointer, 0)
+bool SmartPointer::incrementRefCountIfNotZero() throw()
 {
-    
-#if PLONK_SMARTPOINTER_DEBUG
-    ++getTotalSmartPointerCountersAtom();
-#if PLONK_SMARTPOINTER_DEBUGLOG
-    printf("++SmartPointerCounter++ %p, %ld\n", this, totalSmartPointerCounters.getValueUnchecked());    
-#endif
-#endif
-}
-
-SmartPointerCounter::~SmartPointerCounter()
-{
-#if PLONK_SMARTPOINTER_DEBUG
-    --getTotalSmartPointerCountersAtom();
-#if PLONK_SMARTPOINTER_DEBUGLOG
-    printf("--SmartPointerCounter-- %p, %ld\n", this, totalSmartPointerCounters.getValueUnchecked());    
-#endif
-#endif
-}
-
-SmartPointer* SmartPointerCounter::getSmartPointer() const throw()
-{
-    return atom.getPtr();
-}
-
-void SmartPointerCounter::incrementRefCount() throw()
-{
-    SmartPointer *ptr;
-    UnsignedLong oldExtra, refCount;
+    int oldCount;
     bool success;
     
     do
     {
-        ptr      = atom.getPtrUnchecked();
-        oldExtra = atom.getExtraUnchecked();
-        refCount = PLANK_SHAREDPTR_XGETREFCOUNT(oldExtra) + 1;
+        oldCount = refCount.getValueUnchecked();
         
-        plonk_assert ((refCount & PLANK_ATOMIC_XREFCOUNTMAX) != 0); // overflow occurred
-        
-        success = atom.compareAndSwap (ptr, oldExtra,
-                                       ptr, PLANK_SHAREDPTR_XREFCOUNT(oldExtra, refCount));
-    } while (!success);
-}
-
-void SmartPointerCounter::decrementRefCount() throw()
-{    
-    SmartPointer *oldPtr, *newPtr;
-    UnsignedLong oldExtra, refCount;
-    bool success;
-    
-    do
-    {
-        oldPtr   = atom.getPtrUnchecked();
-        oldExtra = atom.getExtraUnchecked();
-        refCount = PLANK_SHAREDPTR_XGETREFCOUNT(oldExtra) - 1;
-        newPtr   = refCount == 0 ? static_cast<SmartPointer*> (0) : oldPtr;
+        if (oldCount == 0)
+            return false;
         
-        success = atom.compareAndSwap (oldPtr, oldExtra,
-                                       newPtr, PLANK_SHAREDPTR_XREFCOUNT(oldExtra, refCount));
+        success = refCount.compareAndSwap (oldCount, oldCount + 1);
     } while (!success);
     
-    if (refCount == 0)
-    {
-        delete oldPtr; // might be zero in multithreaded if we inc'd and dec'd again but that's OK
-        
-        if (PLANK_SHAREDPTR_XGETWEAKCOUNT(oldExtra) == 0)
-            delete this;
-    }
-}
-
-int SmartPointerCounter::getRefCount() const throw()
-{
-    return PLANK_SHAREDPTR_XGETREFCOUNT(atom.getExtraUnchecked());
-}
-
-void SmartPointerCounter::incrementWeakCount() throw()
-{
-    SmartPointer *ptr;
-    UnsignedLong oldExtra, weakCount;
-    bool success;
-    
-    do
-    {
-        ptr       = atom.getPtrUnchecked();
-        oldExtra  = atom.getExtraUnchecked();
-        weakCount = PLANK_SHAREDPTR_XGETWEAKCOUNT(oldExtra) + 1;
-        
-        plonk_assert ((weakCount & PLANK_ATOMIC_XWEAKCOUNTMAX) != 0); // overflow occurred
-        
-        success = atom.compareAndSwap (ptr, oldExtra,
-                                       ptr, PLANK_SHAREDPTR_XWEAKCOUNT(oldExtra, weakCount));
-    } while (!success);
-}
-
-void SmartPointerCounter::decrementWeakCount() throw()
-{    
-    SmartPointer *ptr;
-    UnsignedLong oldExtra, weakCount;
-    bool success;
-    
-    do
-    {
-        ptr       = atom.getPtrUnchecked();
-        oldExtra  = atom.getExtraUnchecked();
-        weakCount = PLANK_SHAREDPTR_XGETWEAKCOUNT(oldExtra) - 1;
-        
-        success = atom.compareAndSwap (ptr, oldExtra,
-                                       ptr, PLANK_SHAREDPTR_XWEAKCOUNT(oldExtra, weakCount));
-    } while (!success);
-    
-    if ((weakCount == 0) && (PLANK_SHAREDPTR_XGETREFCOUNT(oldExtra) == 0))
-        delete this;
-}
-
-int SmartPointerCounter::getWeakCount() const throw()
-{
-    return PLANK_SHAREDPTR_XGETWEAKCOUNT(atom.getExtraUnchecked());
-}
-
-void SmartPointerCounter::incrementCounts() throw()
-{
-    SmartPointer *ptr;
-    UnsignedLong oldExtra, refCount, weakCount;
-    bool success;
-    
-    do
-    {
-        ptr       = atom.getPtrUnchecked();
-        oldExtra  = atom.getExtraUnchecked();
-
-        refCount  = PLANK_SHAREDPTR_XGETREFCOUNT(oldExtra) + 1;
-        weakCount = PLANK_SHAREDPTR_XGETWEAKCOUNT(oldExtra) + 1;
-
-        plonk_assert ((refCount & PLANK_ATOMIC_XREFCOUNTMAX) != 0); // overflow occurred
-        plonk_assert ((weakCount & PLANK_ATOMIC_XWEAKCOUNTMAX) != 0); // overflow occurred
-
-        success = atom.compareAndSwap (ptr, oldExtra,
-                                       ptr, PLANK_SHAREDPTR_XCOUNTS(refCount, weakCount));
-    } while (!success);
+    return true;
 }
 
-void SmartPointerCounter::decrementCounts() throw()
-{    
-    SmartPointer *oldPtr, *newPtr;
-    UnsignedLong oldExtra, refCount, weakCount;
-    bool success;
-    
-    do
-    {
-        oldPtr    = atom.getPtrUnchecked();
-        oldExtra  = atom.getExtraUnchecked();
-
-        refCount  = PLANK_SHAREDPTR_XGETREFCOUNT(oldExtra) - 1;
-        weakCount = PLANK_SHAREDPTR_XGETWEAKCOUNT(oldExtra) - 1;
-        
-        newPtr    = refCount == 0 ? static_cast<SmartPointer*> (0) : oldPtr;
-        
-        success = atom.compareAndSwap (oldPtr, oldExtra,
-                                       newPtr, PLANK_SHAREDPTR_XCOUNTS(refCount, weakCount));
-    } while (!success);
+void* SmartPointer::getWeak() const throw()               
+{ 
+    void* weak = weakPointer.getPtrUnchecked();
     
-    if (refCount == 0)
+    if ((weak == 0) && weakPointerAllowed)
     {
-        delete oldPtr; // might be zero in multithreaded if we inc'd and dec'd again but that's OK
+        // the caller holds a reference so this can't be deleted under us, 
+        // but another thread might be creating the weak pointer too
+        WeakPointer* newWeak = new WeakPointer (const_cast<SmartPointer*> (this));
+        newWeak->incrementRefCount(); // for this object
         
-        if (weakCount == 0)
-            delete this;
+        if (weakPointer.compareAndSwap (0, newWeak))
+        {
+            weak = newWeak;
+        }
+        else
+        {
+            newWeak->clearPeer();
+            newWeak->decrementRefCount();
+            weak = weakPointer.getPtr();
+        }
     }
+    
+    return weak; 
 }
 
-
 END_PLONK_NAMESPACE
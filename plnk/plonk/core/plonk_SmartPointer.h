@@ -64,7 +64,6 @@
 
 #if PLONK_SMARTPOINTER_DEBUG
 const Long getTotalSmartPointers() throw();
-const Long getTotalSmartPointerCounters() throw();
 #endif
 
 class PlonkBase
@@ -87,6 +86,10 @@ public:
  especially with dynamically allocated audio components. A 'weak' version
  of this pointer can also be obtained which will not affect the reference
  count but will get set to 0 when its SmartPointer peer is deleted.
+ 
+ The reference count is stored in the object itself so creating a SmartPointer 
+ needs only the one allocation. The WeakPointer peer is allocated the first time 
+ getWeak() is called.
  @see WeakPointer, SmartPointerContainer
  */
 class SmartPointer : public PlonkBase
@@ -96,11 +99,34 @@ public:
 	/// @name Construction and destruction
 	/// @{
 	
-	SmartPointer (const bool allocateWeakPointer = true) throw();
+    /** Constructor. 
+     @param allowWeakPointer If false getWeak() always returns 0 for this object. */
+	SmartPointer (const bool allowWeakPointer = true) throw();
     virtual ~SmartPointer(); // MUST be virtual unless PlonkBase gains the need to be virtual    
     
-	void incrementRefCount() throw();    
-    void decrementRefCount() throw();
+	PLONK_INLINE_LOW void incrementRefCount() throw()
+    {
+        // a new reference can only come from an existing one so needs no ordering
+        refCount.addRelaxed (1);
+    }
+    
+    PLONK_INLINE_LOW void decrementRefCount() throw()
+    {
+        plonk_assert (refCount.getValueUnchecked() > 0);
+        
+        if (refCount.addRelease (-1) == 0)
+        {
+            // see all the other threads' writes before they released their references
+            AtomicOps::acquireFence();
+            delete this;
+        }
+    }
+    
+    /** Increments the reference count only if it is not already zero.
+     This is needed to safely obtain a new reference via a WeakPointer, once
+     the count reaches zero the object is committed to being deleted.
+     @return true if the count was incremented. */
+    bool incrementRefCountIfNotZero() throw();
     
 	/// @} <!-- end Construction and destruction -->
 	
@@ -109,7 +135,7 @@ public:
 	
 //    PLONK_INLINE_LOW void update (Text const& message, Dynamic const& payload) throw() { (void)message; (void)payload; } // needed as a dummy in place of Sender::update?
     void* getWeak() const throw();
-    int getRefCount() const throw();
+    int getRefCount() const throw() { return refCount.getValueUnchecked(); }
     
     virtual SmartPointer* deepCopy() const throw() { return 0; }
     
@@ -118,64 +144,15 @@ public:
     friend class WeakPointer;
     
 protected:    
-    SmartPointerCounter* counter;
-    AtomicValue<void*> weakPointer;
+    AtomicInt refCount;
+    mutable AtomicValue<void*> weakPointer;
+    const bool weakPointerAllowed;
 	
 private:
 	SmartPointer (const SmartPointer&);
     SmartPointer& operator= (const SmartPointer&);
 };
 
-//------------------------------------------------------------------------------
-
-class SmartPointerCounter : public PlonkBase
-{
-public:
-    SmartPointerCounter (SmartPointer* smartPointer) throw();    
-    ~SmartPointerCounter();    
-    
-    SmartPointer* getSmartPointer() const throw();
-    
-    void incrementRefCount() throw();    
-    void decrementRefCount() throw();
-    int getRefCount() const throw();   
-    
-    void incrementWeakCount() throw();    
-    void decrementWeakCount() throw();
-    int getWeakCount() const throw();    
-
-    void incrementCounts() throw();    
-    void decrementCounts() throw();    
-
-private:
-    AtomicExtended<SmartPointer*> atom;
-    
-//    struct Counts
-//    {
-//        unsigned int refCount:PLONK_HALFWORDBITS;
-//        unsigned int weakCount:PLONK_HALFWORDBITS;
-//    };
-//    
-//    struct Parts
-//    {
-//        SmartPointer* smartPointer;
-//        Counts counts;    
-//    };
-//    
-//    struct Halves
-//    {
-//        SmartPointer* ptr;
-//        Long extra;
-//    };
-//    
-//    union Element
-//    {
-//        Parts parts;
-//        Halves halves;
-//    };        
-};
-
-
 //------------------------------------------------------------------------------
 
 
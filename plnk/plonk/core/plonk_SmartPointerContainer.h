@@ -154,6 +154,28 @@ public:
 		return *this;		
 	}    
     
+#if PLONK_RVALUEREFERENCES
+    /** Move constructor.
+     This takes the reference from the other container without changing the reference count. */
+	PLONK_INLINE_LOW SmartPointerContainerBase (SmartPointerContainerBase&& other) throw()
+    :   internal (getNullSmartPointer())
+	{
+        internal.swapWith (other.internal);
+	}
+    
+    /** Move assignment operator. */
+	PLONK_INLINE_LOW SmartPointerContainerBase& operator= (SmartPointerContainerBase&& other) throw()
+	{
+		if (this != &other)
+        {
+            SmartPointerContainerBase temp (static_cast<SmartPointerContainerBase&&> (other));
+            internal.swapWith (temp.internal);
+        }
+        
+		return *this;		
+	}    
+#endif
+    
 	PLONK_INLINE_LOW bool operator== (SmartPointerContainerBase const& other) const throw()
 	{
 		return internal == other.internal;
@@ -192,6 +214,19 @@ public:
 		return *this;		
 	}    
     
+#if PLONK_RVALUEREFERENCES
+    PLONK_INLINE_LOW SmartPointerContainer (SmartPointerContainer&& other) throw()
+	:	SmartPointerContainerBase<SmartPointerType> (static_cast<SmartPointerContainerBase<SmartPointerType>&&> (other))
+	{
+	}
+    
+    PLONK_INLINE_LOW SmartPointerContainer& operator= (SmartPointerContainer&& other) throw()
+	{
+        SmartPointerContainerBase<SmartPointerType>::operator= (static_cast<SmartPointerContainerBase<SmartPointerType>&&> (other));
+		return *this;		
+	}    
+#endif
+    
 };
 
 template<class SmartPointerType>
@@ -217,6 +252,19 @@ public:
         
 		return *this;		
 	}    
+    
+#if PLONK_RVALUEREFERENCES
+    PLONK_INLINE_LOW SmartPointerContainer (SmartPointerContainer&& other) throw()
+	:	SmartPointerContainerBase<SmartPointerType> (static_cast<SmartPointerContainerBase<SmartPointerType>&&> (other))
+	{
+	}
+    
+    PLONK_INLINE_LOW SmartPointerContainer& operator= (SmartPointerContainer&& other) throw()
+	{
+        SmartPointerContainerBase<SmartPointerType>::operator= (static_cast<SmartPointerContainerBase<SmartPointerType>&&> (other));
+		return *this;		
+	}    
+#endif
 
     WeakPointer* getWeakPointer() const throw()
     {
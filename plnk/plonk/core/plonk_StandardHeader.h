@@ -121,6 +121,16 @@
 
 #define PLONK_ALIGN(X) PLANK_ALIGN(X)
 
+#if (__cplusplus >= 201103L) || (defined (_MSC_VER) && (_MSC_VER >= 1600))
+    #define PLONK_RVALUEREFERENCES 1
+#endif
+
+#if PLONK_WIN
+    #define PLONK_THREADLOCAL __declspec(thread)
+#else
+    #define PLONK_THREADLOCAL __thread
+#endif
+
 #ifdef PLONK_USEPLINK
     #include "../../plink/plink.h"
 #endif
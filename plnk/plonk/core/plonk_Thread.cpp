@@ -40,8 +40,7 @@
 
 BEGIN_PLONK_NAMESPACE
 
-#include "plonk_Thread.h"
-#include "../containers/plonk_Atomic.h"
+#include "plonk_Headers.h"
 
 PlankResult Threading::run (PlankThreadRef plankThread) throw()
 {
@@ -50,6 +49,8 @@ PlankResult Threading::run (PlankThreadRef plankThread) throw()
     ResultCode result = thread->run();
     plonk_assert ((result == PlankResult_OK) || (result == PlankResult_ThreadWasDeleted));
     
+    ObjectMemoryPools::flushThreadCache();
+    
     return result;
 }
 
@@ -209,6 +210,11 @@ bool Threading::Thread::setPriorityAudio (const int blockSize, const double samp
     return pl_Thread_SetPriorityAudio (getPeerRef(), blockSize, sampleRate) == PlankResult_OK;
 }
 
+bool Threading::Thread::setAffinity (const int core) throw()
+{
+    return pl_Thread_SetAffinity (getPeerRef(), core) == PlankResult_OK;
+}
+
 Threading::ID Threading::Thread::getID() throw()
 {
     return pl_Thread_GetID (getPeerRef());
@@ -130,6 +130,10 @@ public:
         bool setPriority (const int priority) throw();
         bool setPriorityAudio (const int blockSize, const double sampleRate) throw();
         
+        /** Sets the processor core this thread should run on.
+         If the thread is not yet running this is applied when it starts. */
+        bool setAffinity (const int core) throw();
+        
         /** Get this thread's ID. */
         Threading::ID getID() throw();
         
@@ -43,11 +43,11 @@ BEGIN_PLONK_NAMESPACE
 #include "plonk_Headers.h"
 
 
-WeakPointer::WeakPointer (SmartPointerCounter* counterToUse) throw()
+WeakPointer::WeakPointer (SmartPointer* peer) throw()
 :   SmartPointer (false), // avoid infinite recursion
-    peerCounter (counterToUse)
+    atom (peer, 0)
 {
-    plonk_assert (counter != 0);
+    plonk_assert (peer != 0);
 }
 
 WeakPointer::~WeakPointer()
@@ -56,37 +56,55 @@ WeakPointer::~WeakPointer()
 
 SmartPointer* WeakPointer::getWeakPointer() const throw()
 {
-    return peerCounter->getSmartPointer();
+    return atom.getPtr();
 }    
 
-void WeakPointer::incrementWeakCount() throw()
+SmartPointer* WeakPointer::retainPeer() throw()
 {
-    peerCounter->incrementWeakCount();
+    SmartPointer* peer;
+    UnsignedLong users;
+    bool success;
+    
+    // register as a user so the peer can't complete its destructor while we increment its count
+    do
+    {
+        peer  = atom.getPtrUnchecked();
+        users = atom.getExtraUnchecked();
+        
+        if (peer == 0)
+            return 0;
+        
+        success = atom.compareAndSwap (peer, users, peer, users + 1);
+    } while (!success);
+    
+    const bool retained = peer->incrementRefCountIfNotZero();
+    
+    do
+    {
+        users = atom.getExtraUnchecked();
+        success = atom.compareAndSwap (peer, users, peer, users - 1);
+    } while (!success);
+    
+    return retained ? peer : 0;
 }
 
-void WeakPointer::decrementWeakCount() throw()
+void WeakPointer::clearPeer() throw()
 {
-    peerCounter->decrementWeakCount();
-}
-
-int WeakPointer::getWeakCount() const throw()
-{
-    return peerCounter->getWeakCount();
-}
-
-void WeakPointer::incrementPeerRefCount() throw()
-{
-    peerCounter->incrementRefCount();
-}
-
-void WeakPointer::decrementPeerRefCount() throw()
-{
-    peerCounter->decrementRefCount();
-}
-
-int WeakPointer::getPeerRefCount() const throw()
-{
-    return peerCounter->getRefCount();
+    SmartPointer* peer;
+    bool success;
+    
+    do
+    {
+        peer = atom.getPtrUnchecked();
+        
+        if (peer == 0)
+            return;
+        
+        success = atom.compareAndSwap (peer, 0, 0, 0);
+        
+        if (!success)
+            Threading::yield();
+    } while (!success);
 }
 
 END_PLONK_NAMESPACE
@@ -47,26 +47,30 @@
  This is a peer to a SmartPointer and stores a copy of the pointer. 
  The main difference is that this copy does not increment the reference 
  count of the SmartPointer and gets set to 0 when the SmartPointer is 
- deleted.
+ deleted. The SmartPointer allocates this the first time its getWeak() is called.
  @see SmartPointer, WeakPointerContainer*/
 class WeakPointer : public SmartPointer
 {
 public:
-    WeakPointer (SmartPointerCounter* counter) throw();
+    WeakPointer (SmartPointer* peer) throw();
     ~WeakPointer();
     
+    /** Get the peer SmartPointer.
+     This will be 0 if the peer has been deleted. The peer may be deleted by 
+     another thread at any time so use retainPeer() to use the peer safely. */
     SmartPointer* getWeakPointer() const throw();
     
-    void incrementWeakCount() throw();    
-    void decrementWeakCount() throw();
-    int getWeakCount() const throw();   
+    /** Get the peer SmartPointer with its reference count incremented.
+     This will be 0 if the peer has been deleted or is being deleted. If not
+     0 the caller must call decrementRefCount() on the peer when done. */
+    SmartPointer* retainPeer() throw();
     
-    void incrementPeerRefCount() throw();    
-    void decrementPeerRefCount() throw();
-    int getPeerRefCount() const throw();   
+    friend class SmartPointer;
     
 private:
-    SmartPointerCounter* const peerCounter;
+    AtomicExtended<SmartPointer*> atom; // the peer and the number of threads in retainPeer()
+    
+    void clearPeer() throw();
     
     WeakPointer();
     WeakPointer (const WeakPointer&);
@@ -61,32 +61,18 @@ public:
     {
     }        
     
-    ~WeakPointerContainer()
-    {
-        decrementWeakCount (this->getInternal());
-    }
-    
     /** Copy constructor.
 	 Note that a deep copy is not made, the copy will refer to exactly the same data. */
 	WeakPointerContainer (WeakPointerContainer const& copy) throw()
 	:	Base (static_cast<Base const&> (copy))
 	{
-        incrementWeakCount (this->getInternal());
 	}
     
     /** Assignment operator. */
     WeakPointerContainer& operator= (WeakPointerContainer const& other) throw()
 	{
 		if (this != &other)
-        {
-            WeakPointer* const weakPointer = this->getInternal();
-            WeakPointer* const otherWeakPointer = other.getInternal();
-
-            incrementWeakCount (otherWeakPointer);
-            decrementWeakCount (weakPointer);
-
-            this->setInternal (otherWeakPointer);
-        }
+            this->setInternal (other.getInternal());
         
         return *this;
     }
@@ -94,7 +80,6 @@ public:
     WeakPointerContainer (OriginalType const& original) throw()
     :   Base (original.getWeakPointer())
     {
-        incrementWeakCount (this->getInternal());
     }
             
     bool isAlive() const throw()
@@ -114,36 +99,22 @@ public:
         
         if (weakPointer != 0)
         {
-            // retain it, this ensures that if weakPointer->getWeakPointer() returns
-            // a non-null pointer that it will still be valid when passed to 
-            // construct the container object (which retains it again) OR...
-            // the pointer will be null
-            weakPointer->incrementPeerRefCount(); 
+            // retain it, this ensures that if a non-null pointer is returned
+            // it will still be valid when passed to construct the container 
+            // object (which retains it again)
+            SmartPointer* const peer = weakPointer->retainPeer();
             
-            OriginalInternal* smartPointer = static_cast<OriginalInternal*> (weakPointer->getWeakPointer());
-            
-            if (smartPointer != 0)
-                result = OriginalType (smartPointer);
-
-            // release it
-            weakPointer->decrementPeerRefCount();
+            if (peer != 0)
+            {
+                result = OriginalType (static_cast<OriginalInternal*> (peer));
+                
+                // release it
+                peer->decrementRefCount();
+            }
         }
         
         return result;
     }
-    
-private:
-    PLONK_INLINE_LOW static void incrementWeakCount (WeakPointer* const weakPointer) throw()
-    {
-        if (weakPointer != 0)
-            weakPointer->incrementWeakCount();
-    }
-    
-    PLONK_INLINE_LOW static void decrementWeakCount (WeakPointer* const weakPointer) throw()
-    {
-        if (weakPointer != 0)
-            weakPointer->decrementWeakCount();
-    }
 };
 
 
@@ -51,7 +51,7 @@ private:
 
 /** A platform independent FFT processing engine. 
  This uses Plank to decide which underlying processing engine to use (e.g., FFTReal
- or vDSP). 
+ or vDSP, or the Plank mixed-radix engine for sizes that are not a power of 2). 
  @ingroup PlonkOtherUserClasses */
 template<>
 class FFTEngineBase<float> : public SmartPointerContainer< FFTEngineInternal<float> >
@@ -61,8 +61,9 @@ public:
     typedef SmartPointerContainer<Internal>     Base;
     
     /** Create a new engine with a particular FFT size.
-     @param length  The FFT size - this must be a power of 2 or less than 16 (where it will
-                    specify the log2 FFT size e.g., 8 = pow(2,8) = 256). */
+     @param length  The FFT size - this must be a power of 2, an even size with no prime 
+                    factors other than 2, 3 and 5 (e.g., 480 or 960) or less than 16 (where 
+                    it will specify the log2 FFT size e.g., 8 = pow(2,8) = 256). */
     FFTEngineBase (const long length = 0) throw()
     :   Base (new Internal (length))
     {
@@ -132,6 +133,90 @@ public:
 private:
 };
 
+/** A platform independent double precision FFT processing engine. 
+ @see FFTEngineBase<float>
+ @ingroup PlonkOtherUserClasses */
+template<>
+class FFTEngineBase<double> : public SmartPointerContainer< FFTEngineInternal<double> >
+{
+public:
+    typedef FFTEngineInternal<double>           Internal;
+    typedef SmartPointerContainer<Internal>     Base;
+    typedef NumericalArray<double>              Buffer;
+    
+    /** Create a new engine with a particular FFT size.
+     @param length  The FFT size - this must be a power of 2, an even size with no prime 
+                    factors other than 2, 3 and 5 (e.g., 480 or 960) or less than 16 (where 
+                    it will specify the log2 FFT size e.g., 8 = pow(2,8) = 256). */
+    FFTEngineBase (const long length = 0) throw()
+    :   Base (new Internal (length))
+    {
+    }
+    
+    /** Copy constructor.
+	 Note that a deep copy is not made, the copy will refer to exactly the same data. */
+    FFTEngineBase (FFTEngineBase const& copy) throw()
+    :   Base (static_cast<Base const&> (copy))
+    {
+    }
+    
+    /** Assignment operator. */
+    FFTEngineBase& operator= (FFTEngineBase const& other) throw()
+	{
+		if (this != &other)
+            this->setInternal (other.getInternal());
+        
+        return *this;
+	}
+    
+    /** Apply the FFT to the input and place the result in output.
+     This can't be performed in-place (i.e., input and output must not point to the same data or overlap). */
+    PLONK_INLINE_LOW void forward (double* output, const double* input) throw()
+    {
+        this->getInternal()->forward (output, input);
+    }
+    
+    /** Apply the FFT to the input and place the result in output.
+     This can't be performed in-place (i.e., input and output must not point to the same data or overlap). */
+    PLONK_INLINE_LOW void forward (Buffer& output, Buffer const& input) throw()
+    {
+        plonk_assert (output.length() >= this->length());
+        plonk_assert (input.length() >= this->length());
+        this->getInternal()->forward (output.getArray(), input.getArray());
+    }    
+    
+    /** Apply the inverse-FFT to the input and place the result in output.
+     This can't be performed in-place (i.e., input and output must not point to the same data or overlap). */
+    PLONK_INLINE_LOW void inverse (double* output, const double* input) throw()
+    {
+        this->getInternal()->inverse (output, input);
+    }
+    
+    /** Apply the inverse-FFT to the input and place the result in output.
+     This can't be performed in-place (i.e., input and output must not point to the same data or overlap). */
+    PLONK_INLINE_LOW void inverse (Buffer& output, Buffer const& input) throw()
+    {
+        plonk_assert (output.length() >= this->length());
+        plonk_assert (input.length() >= this->length());
+        this->getInternal()->inverse (output.getArray(), input.getArray());
+    }        
+    
+    /** Get the FFT size. */
+    PLONK_INLINE_LOW long length() const
+    {
+        return this->getInternal()->length();
+    }
+    
+    /** Get half FFT size. 
+     This is just as a convenience as it is already cached for efficiency. */
+    PLONK_INLINE_LOW long halfLength() const
+    {
+        return this->getInternal()->halfLength();
+    }
+    
+private:
+};
+
 typedef FFTEngineBase<PLONK_TYPE_DEFAULT> FFTEngine;
 
 
@@ -55,7 +55,11 @@ public:
     FFTEngineInternal (const long length) throw()
     :   fft (pl_FFTF_Create())
     {
-        pl_FFTF_InitWithLength (this->fft, length);
+        const ResultCode result = pl_FFTF_InitWithLength (this->fft, length);
+        plonk_assert (result == PlankResult_OK);
+#ifndef PLONK_DEBUG
+        (void)result;
+#endif
     }
     
     ~FFTEngineInternal()
@@ -91,4 +95,53 @@ private:
     PlankFFTFRef fft;
 };
 
+template<>
+class FFTEngineInternal<double> : public SmartPointer
+{
+public:
+    typedef NumericalArray<double>  Buffer;
+
+    FFTEngineInternal (const long length) throw()
+    :   fft (pl_FFTD_Create())
+    {
+        const ResultCode result = pl_FFTD_InitWithLength (this->fft, length);
+        plonk_assert (result == PlankResult_OK);
+#ifndef PLONK_DEBUG
+        (void)result;
+#endif
+    }
+    
+    ~FFTEngineInternal()
+    {
+        pl_FFTD_Destroy (this->fft);
+        this->fft = 0;
+    }
+    
+    PLONK_INLINE_LOW void forward (double* output, const double* input) throw()
+    {
+        plonk_assert (output != input);
+        pl_FFTD_Forward (this->fft, output, input);
+    }
+        
+    PLONK_INLINE_LOW void inverse (double* output, const double* input) throw()
+    {
+        plonk_assert (output != input);
+        pl_FFTD_Inverse (this->fft, output, input);
+    }
+    
+    PLONK_INLINE_LOW long length() const
+    {
+        return pl_FFTD_Length (this->fft);
+    }
+    
+    PLONK_INLINE_LOW long halfLength() const
+    {
+        return pl_FFTD_HalfLength (this->fft);
+    }
+    
+    
+private:
+    PlankFFTDRef fft;
+};
+
 #endif // PLONK_FFTENGINEINTERNAL_H
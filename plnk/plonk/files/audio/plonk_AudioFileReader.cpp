@@ -65,12 +65,13 @@ AudioFileReaderInternal::AudioFileReaderInternal (const char* path, const int bu
     init (path, metaDataIOFlags);
 }
 
-ResultCode AudioFileReaderInternal::init (const char* path, AudioFileMetaDataIOFlags const& metaDataIOFlags) throw()
+ResultCode AudioFileReaderInternal::init (const char* path, AudioFileMetaDataIOFlags const& metaDataIOFlags, const bool mapped) throw()
 {
     plonk_assert (path != 0);
     
     pl_AudioFileReader_Init (getPeerRef());
-    ResultCode result = pl_AudioFileReader_OpenInternal (getPeerRef(), path, metaDataIOFlags.getValue());
+    ResultCode result = mapped ? pl_AudioFileReader_OpenMapped (getPeerRef(), path, metaDataIOFlags.getValue())
+                               : pl_AudioFileReader_OpenInternal (getPeerRef(), path, metaDataIOFlags.getValue());
     
     if (result == PlankResult_OK)
         numFramesPerBuffer = readBuffer.length() / getBytesPerFrame();
@@ -413,6 +414,17 @@ ResultCode AudioFileReaderInternal::open (const char* path, const int bufferSize
     return init (path, metaDataIOFlags);
 }
 
+ResultCode AudioFileReaderInternal::openMapped (const char* path, const int bufferSize, AudioFileMetaDataIOFlags const& metaDataIOFlags) throw()
+{
+    if ((readBuffer.length() == 0) || (bufferSize > 0))
+        readBuffer.setSize ((bufferSize > 0) ? bufferSize : AudioFile::DefaultBufferSize, false);
+    
+    numFramesPerBuffer = 0;
+    newPositionOnNextRead = -1;
+    
+    return init (path, metaDataIOFlags, true);
+}
+
 AudioFile::Format AudioFileReaderInternal::getFormat() const throw()
 {
     int value;
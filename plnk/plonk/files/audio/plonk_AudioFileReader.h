@@ -69,6 +69,7 @@ public:
     ~AudioFileReaderInternal();
     
     ResultCode open (const char* path, const int bufferSize, AudioFileMetaDataIOFlags const& metaDataIOFlags) throw();
+    ResultCode openMapped (const char* path, const int bufferSize, AudioFileMetaDataIOFlags const& metaDataIOFlags) throw();
     
     AudioFile::Format getFormat() const throw();
     AudioFile::Encoding getEncoding() const throw();
@@ -140,7 +141,7 @@ public:
     PLONK_INLINE_LOW const PlankAudioFileReaderRef getPeerRef() const { return const_cast<const PlankAudioFileReaderRef> (&peer); }
 
 private:
-    ResultCode init (const char* path, AudioFileMetaDataIOFlags const& metaDataIOFlags) throw();
+    ResultCode init (const char* path, AudioFileMetaDataIOFlags const& metaDataIOFlags, const bool mapped = false) throw();
     ResultCode init (ByteArray const& bytes, AudioFileMetaDataIOFlags const& metaDataIOFlags) throw();
 
     template<class Type>
@@ -154,6 +155,12 @@ private:
 #endif
     }
 
+    static PLONK_INLINE_LOW bool canReadDirectWithEncoding (const int encoding, const int bytesPerSample) throw()
+    {
+        const bool dataIsBigEndian = encoding & AudioFile::EncodingFlagBigEndian;
+        return (bytesPerSample == 1) || (dataIsBigEndian == bool (PLONK_BIGENDIAN));
+    }
+
     PlankAudioFileReader peer;
     Chars readBuffer;
     int numFramesPerBuffer;
@@ -192,6 +199,7 @@ void AudioFileReaderInternal::readFrames (NumericalArray<SampleType>& data,
     int encoding = getEncoding();
     int channels = getNumChannels();
     int bytesPerSample = getBytesPerSample();
+    bool canReadDirect = canReadDirectWithEncoding (encoding, bytesPerSample);
     
     plonk_assert ((encoding >= AudioFile::EncodingMin) && (encoding <= AudioFile::EncodingMax));
     plonk_assert (getBitsPerSample() > 0);
@@ -230,13 +238,31 @@ void AudioFileReaderInternal::readFrames (NumericalArray<SampleType>& data,
             plonk_assert (result == PlankResult_OK); // just continue though in release
         }
         
-        const int framesToRead = plonk::min (dataRemaining / channels, numFramesPerBuffer);
+        // direct reads don't go through the read buffer so aren't limited by its size
+        const int framesToRead = canReadDirect ? dataRemaining / channels : plonk::min (dataRemaining / channels, numFramesPerBuffer);
         
         if (framesToRead == 0)
             break; // not enough data left for one frame
 
         int framesRead;
-        result = pl_AudioFileReader_ReadFrames (getPeerRef(), PLANK_FALSE, framesToRead, readBufferArray, &framesRead);
+        const void* sourceArray = 0;
+        
+        if (canReadDirect)
+        {
+            result = pl_AudioFileReader_ReadFramesDirect (getPeerRef(), framesToRead, &sourceArray, &framesRead);
+            
+            if (result == PlankResult_FileNotMapped)
+                canReadDirect = false;
+        }
+        
+        if (!canReadDirect)
+        {
+            sourceArray = readBufferArray;
+            result = pl_AudioFileReader_ReadFrames (getPeerRef(), PLANK_FALSE, plonk::min (framesToRead, numFramesPerBuffer), readBufferArray, &framesRead);
+        }
+        
+        // only written to when swapping which direct reads never need
+        void* const convertArray = const_cast<void*> (sourceArray);
         plonk_assert ((result == PlankResult_OK) ||
                       (result == PlankResult_FileEOF) ||
                       (result == PlankResult_AudioFileFrameFormatChanged) ||
@@ -251,25 +277,25 @@ void AudioFileReaderInternal::readFrames (NumericalArray<SampleType>& data,
             {            
                 if (bytesPerSample == 2)
                 {
-                    Short* const convertBuffer = static_cast<Short*> (readBufferArray); 
+                    Short* const convertBuffer = static_cast<Short*> (convertArray); 
                     swapEndianIfNotNative (convertBuffer, samplesRead, isBigEndian);
                     Buffer::convert (dataArray, convertBuffer, samplesRead, applyScaling);
                 }
                 else if (bytesPerSample == 3)
                 {
-                    Int24* const convertBuffer = static_cast<Int24*> (readBufferArray); 
+                    Int24* const convertBuffer = static_cast<Int24*> (convertArray); 
                     swapEndianIfNotNative (convertBuffer, samplesRead, isBigEndian);
                     Buffer::convert (dataArray, convertBuffer, samplesRead, applyScaling);
                 }
                 else if (bytesPerSample == 4)
                 {
-                    Int* const convertBuffer = static_cast<Int*> (readBufferArray); 
+                    Int* const convertBuffer = static_cast<Int*> (convertArray); 
                     swapEndianIfNotNative (convertBuffer, samplesRead, isBigEndian);
                     Buffer::convert (dataArray, convertBuffer, samplesRead, applyScaling);
                 }
                 else if (bytesPerSample == 1)
                 {
-                    Char* const convertBuffer = static_cast<Char*> (readBufferArray); 
+                    Char* const convertBuffer = static_cast<Char*> (convertArray); 
                     Buffer::convert (dataArray, convertBuffer, samplesRead, applyScaling);
                 }
                 else
@@ -282,13 +308,13 @@ void AudioFileReaderInternal::readFrames (NumericalArray<SampleType>& data,
             {
                 if (bytesPerSample == 4)
                 {
-                    Float* const convertBuffer = static_cast<Float*> (readBufferArray); 
+                    Float* const convertBuffer = static_cast<Float*> (convertArray); 
                     swapEndianIfNotNative (convertBuffer, samplesRead, isBigEndian);
                     Buffer::convert (dataArray, convertBuffer, samplesRead, applyScaling);
                 }
                 else if (bytesPerSample == 8)
                 {
-                    Double* const convertBuffer = static_cast<Double*> (readBufferArray); 
+                    Double* const convertBuffer = static_cast<Double*> (convertArray); 
                     swapEndianIfNotNative (convertBuffer, samplesRead, isBigEndian);
                     Buffer::convert (dataArray, convertBuffer, samplesRead, applyScaling);
                 }
@@ -357,6 +383,7 @@ void AudioFileReaderInternal::readFrames (NumericalArray<SampleType>& data,
             isFloat = encoding & AudioFile::EncodingFlagFloat;
             isBigEndian = encoding & AudioFile::EncodingFlagBigEndian;
             isInterleaved = !(encoding & AudioFile::EncodingFlagNonIntervleaved);
+            canReadDirect = canReadDirect && canReadDirectWithEncoding (encoding, bytesPerSample);
             
             if (!getBytesPerFrame())
                 goto exit;
@@ -520,6 +547,19 @@ public:
 //    {
 //    }
 
+    /** Creates an audio file reader that maps the file into memory.
+     Uncompressed native-endian files are then converted straight from the mapping
+     rather than being copied through the read buffer first. Files that can't be
+     mapped, or are compressed, are opened normally.
+     @param path        The path of the file to read.
+     @param bufferSize  The buffer size to use when reading if the file can't be read directly. */
+    static AudioFileReader mapped (FilePath const& path, const int bufferSize = 0, AudioFileMetaDataIOFlags const& metaDataIOFlags = AudioFileMetaDataIOFlags ((UnsignedInt)AudioFile::MetaDataIOFlagsNone)) throw()
+    {
+        AudioFileReader reader;
+        reader.getInternal()->openMapped (path.fullpath().getArray(), bufferSize, metaDataIOFlags);
+        return reader;
+    }
+
     /** @internal */
     explicit AudioFileReader (Internal* internalToUse) throw() 
 	:	Base (internalToUse)
@@ -778,6 +818,73 @@ public:
         return data;
     }
 
+    /** Reads all the frames in the file and converts them to another sample rate.
+     This uses a bandlimited windowed-sinc kernel (see SincTableBase) and is 
+     intended for float and double data. The samples are always scaled.
+     @param sampleRate  The sample rate to convert to.
+     @param quality     The SincQuality preset to use.
+     @return A NumericalArray containing the interleaved sample frames. */
+    template<class SampleType>
+    NumericalArray<SampleType> readAllFramesResampled (const double sampleRate, 
+                                                       const SincQuality::Preset quality = SincQuality::Medium) throw()
+    {
+        typedef NumericalArray<SampleType> SampleArray;
+        typedef SincTableBase<SampleType> SincTableType;
+        
+        SampleArray data = readAllFrames<SampleType> (true);
+        
+        const double fileSampleRate = getSampleRate();
+        const int numChannels = getNumChannels();
+        const int numFrames = numChannels > 0 ? data.length() / numChannels : 0;
+        
+        if ((fileSampleRate <= 0.0) || (sampleRate <= 0.0) || (sampleRate == fileSampleRate) || (numFrames == 0))
+            return data;
+        
+        const SincTableType& table = SincTableType::getShared (quality);
+        const double increment = fileSampleRate / sampleRate;
+        const bool downsampling = increment > 1.0;
+        const double scale = downsampling ? 1.0 / increment : 1.0;
+        const int halfTaps = table.getScaledHalfTaps (scale);
+        const int numOutputFrames = int (numFrames * sampleRate / fileSampleRate);
+        
+        // zero padded either side of the channel's data
+        SampleArray channelData = SampleArray::withSize (numFrames + halfTaps * 2, true);
+        SampleArray result = SampleArray::withSize (numOutputFrames * numChannels);
+        SampleArray scaledRows;
+        
+        if (downsampling)
+        {
+            scaledRows.setSize (table.getScaledRowsSize (scale), false);
+            table.buildScaledRows (scale, scaledRows.getArray());
+        }
+        
+        const SampleType* const dataSamples = data.getArray();
+        const SampleType* const scaledRowSamples = scaledRows.getArray();
+        SampleType* const channelSamples = channelData.getArray();
+        SampleType* const resultSamples = result.getArray();
+        
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            int i;
+            
+            for (i = 0; i < numFrames; ++i)
+                channelSamples[halfTaps + i] = dataSamples[i * numChannels + channel];
+            
+            for (i = 0; i < numOutputFrames; ++i)
+            {
+                const double position = i * increment;
+                const int index = int (position);
+                const double frac = position - index;
+                
+                resultSamples[i * numChannels + channel] = downsampling ?
+                    table.interpolateScaled (channelSamples, index + halfTaps, frac, scale, scaledRowSamples) :
+                    table.interpolate (channelSamples, index + halfTaps, frac);
+            }
+        }
+        
+        return result;
+    }
+
     /** Reads all the frames in the file and returns them in an interleaved array. 
      @return A NumericalArray containing the interleaved sample frames.*/
     template<class SampleType>
@@ -811,6 +918,26 @@ public:
         return getOtherSignal<PLONK_TYPE_DEFAULT>();
     }    
     
+    /** Reads all the frames in the file converted to another sample rate.
+     @see readAllFramesResampled()
+     @return A Signal containing sample frames. */
+    template<class SampleType>
+    PLONK_INLINE_LOW SignalBase<SampleType> getOtherSignal (const double sampleRate, 
+                                                            const SincQuality::Preset quality = SincQuality::Medium) throw()
+    {
+        NumericalArray<SampleType> data = readAllFramesResampled<SampleType> (sampleRate, quality);
+        return SignalBase<SampleType> (data, sampleRate, getNumChannels());
+    }
+    
+    /** Reads all the frames in the file converted to another sample rate.
+     @see readAllFramesResampled()
+     @return A Signal containing sample frames. */
+    PLONK_INLINE_LOW SignalBase<PLONK_TYPE_DEFAULT> getSignal (const double sampleRate, 
+                                                               const SincQuality::Preset quality = SincQuality::Medium) throw()
+    {
+        return getOtherSignal<PLONK_TYPE_DEFAULT> (sampleRate, quality);
+    }
+    
     void setOwner (void* owner) throw()
     {
         getInternal()->setOwner (owner);
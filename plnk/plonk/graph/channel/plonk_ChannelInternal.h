@@ -85,6 +85,22 @@ public:
     
     const DataType& getState() const throw() { return state; }
     DataType& getState() throw() { return state; }
+
+    /** The Data follows the output buffer in the state blocks.
+     Channels whose Data holds pointers must override these to leave it out. */
+    int getNumStateBlocks() const throw()
+    {
+        return Internal::getNumStateBlocks() + 1;
+    }
+
+    void* getStateBlock (const int index, int& numBytes) throw()
+    {
+        if (index != Internal::getNumStateBlocks())
+            return Internal::getStateBlock (index, numBytes);
+
+        numBytes = sizeof (DataType);
+        return &state;
+    }
     
     void setSampleRate (SampleRate const& newSampleRate) throw()
     {
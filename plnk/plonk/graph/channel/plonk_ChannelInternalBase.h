@@ -172,6 +172,29 @@ public:
         outputBuffer.last() = value;
     }
     
+    /** Describes this channel as a sequence of element-wise operators for FusedOpUnit.
+     Return false (the default) if the channel can't be fused. */
+    virtual bool getFusedOp (FusedOpInfo<SampleType>& info) throw()
+    {
+        (void)info;
+        return false;
+    }
+    
+    /** The output buffer is the first state block. */
+    int getNumStateBlocks() const throw()
+    {
+        return 1;
+    }
+
+    void* getStateBlock (const int index, int& numBytes) throw()
+    {
+        if (index != 0)
+            return ChannelInternalCore::getStateBlock (index, numBytes);
+
+        numBytes = outputBuffer.length() * sizeof (SampleType);
+        return outputBuffer.getArray();
+    }
+
     PLONK_INLINE_LOW const Text getOutputTypeName() const throw()         { return TypeUtility<SampleType>::getTypeName(); }
     virtual const Text getInputTypeName() const throw()         { return TypeUtility<SampleType>::getTypeName(); }
     PLONK_INLINE_LOW int getOutputTypeCode() const throw()                { return TypeUtility<SampleType>::getTypeCode(); }
@@ -52,9 +52,16 @@ ChannelInternalCore::ChannelInternalCore (Inputs const& inputsToUse,
     inputs (inputsToUse),
     blockSize (blockSizeToUse),
     sampleRate (sampleRateToUse),
-    overlap (inputs.containsKey (IOKey::OverlapMake) ? getInputAs<DoubleVariable> (IOKey::OverlapMake) : Math<DoubleVariable>::get1())
+    overlap (inputs.containsKey (IOKey::OverlapMake) ? inputs[IOKey::OverlapMake].asUnchecked<DoubleVariable>() : Math<DoubleVariable>::get1()),
+    renderPass (0),
+    renderTask (0),
+    bufferIndex (-1),
+    bufferPlanner (0)
 {
+    plonk_staticassert (int (IOKey::NumNames) <= int (MaxInputKeys));
+    
     cacheSampleDurationTicks();
+    resolveInputs();
     
     plonk_assert (blockSize.getValue() >= 0);
     plonk_assert (overlap.getValue() > 0.0);
@@ -70,6 +77,33 @@ void ChannelInternalCore::updateTimeStamp() throw()
     }
 }
 
+void ChannelInternalCore::resolveInputs() const throw()
+{
+    const ObjectArray<int>& keys = inputs.getKeys();
+    const DynamicArray& values = inputs.getValues();
+    const int numSlots = plonk::min (keys.length(), int (MaxInputSlots));
+    int i;
+    
+    for (i = 0; i < MaxInputKeys; ++i)
+        inputSlotIndices[i] = -1;
+    
+    for (i = 0; i < numSlots; ++i)
+    {
+        const Dynamic& value = values.atUnchecked (i);
+        const int key = keys.atUnchecked (i);
+        
+        plonk_assert ((key >= 0) && (key < MaxInputKeys));
+        
+        inputSlotItems[i] = const_cast<void*> (static_cast<const void*> (&value.getItem()));
+#ifdef PLONK_DEBUG
+        inputSlotTypes[i] = value.getTypeCode();
+#endif
+        inputSlotIndices[key] = (signed char)i;
+    }
+    
+    inputSlotsGeneration = inputs.getGeneration();
+}
+
 void ChannelInternalCore::setLabel (Text const& newId) throw()
 {
     identifier = newId;
@@ -83,11 +83,26 @@ public:
     void setExpiryTimeStamp (TimeStamp const& newTimeStamp) throw();
     bool shouldBeDeletedNow (TimeStamp const& time) const throw();
     
+    enum Constants
+    {
+        MaxInputSlots = 8,
+        MaxInputKeys = 96   ///< Must be at least IOKey::NumNames.
+    };
+    
     PLONK_INLINE_HIGH const Inputs& getInputs() const throw()                                      { return this->inputs; }
+    
+    /** Returns the inputs for modification.
+     Call resolveInputs() after changing them. */
     PLONK_INLINE_HIGH Inputs& getInputs() throw()                                                  { return this->inputs; }
     
-    template<class Type> PLONK_INLINE_MID const Type& getInputAs (const int key) const throw()    { return this->inputs[key].asUnchecked<Type>(); }
-    template<class Type> PLONK_INLINE_MID Type& getInputAs (const int key) throw()                { return this->inputs[key].asUnchecked<Type>(); }
+    template<class Type> PLONK_INLINE_MID const Type& getInputAs (const int key) const throw()    { return *static_cast<const Type*> (getInputItem<Type> (key)); }
+    template<class Type> PLONK_INLINE_MID Type& getInputAs (const int key) throw()                { return *static_cast<Type*> (getInputItem<Type> (key)); }
+    
+    /** Caches a pointer to each input so getInputAs() doesn't search the input dictionary.
+     This is done on construction and again by the first getInputAs() after an
+     input is put into or removed from the dictionary (through getInputs() or a
+     shared copy of it). The inputs must not be changed while the channel is processing. */
+    void resolveInputs() const throw();
     
     const BlockSize& getBlockSize() const throw()    { return blockSize; }
     const SampleRate& getSampleRate() const throw()  { return sampleRate; }    
@@ -106,8 +121,22 @@ public:
     virtual bool isProxy() const throw()                { return false; }
     virtual bool isTypeConverter() const throw()        { return false; }
     virtual bool canUseExternalBuffer() const throw()   { return true;  }
+    virtual bool processesInputsInBackground() const throw() { return false; }
+    
+    /** Returns true if the channel writes to its output before it has pulled all its inputs.
+     For example, mixers which zero their output then add each input in turn. 
+     BufferPlanner keeps the output buffer of such a channel away from its whole input subgraph. */
+    virtual bool writesOutputBetweenInputs() const throw() { return false; }
+    
     virtual double getLatency() const throw()           { return 0.0;   }
     virtual int getNumChannels() const throw()          { return 1; }
+    virtual int getOutputTypeCode() const throw()       { return TypeCode::Unknown; } // overridden by ChannelInternalBase
+    
+    /** Returns true if a BufferPlanner has given this channel a shared output buffer. */
+    bool isUsingPlannedBuffer() const throw()           { return bufferPlanner != 0; }
+    
+    /** Returns the channel that actually does the processing for a proxy, otherwise 0. */
+    virtual ChannelInternalCore* getProxyOwner() throw() { return 0; }
     
     virtual Text getLabel() const throw()               { return identifier; }  // virtual due to proxies
     virtual void setLabel (Text const& newId) throw();                          // virtual due to proxies
@@ -126,7 +155,26 @@ public:
     /** The DSP function.
      This function will do all the processing for derived class. */
     virtual void process (ProcessInfo& info, const int channel) = 0;
-        
+
+    /** The number of blocks of memory holding this channel's running state.
+     These are what GraphSnapshot saves and restores. Subclasses with state
+     outside their Data (e.g., delay lines) should add their own blocks after
+     those of their base class. */
+    virtual int getNumStateBlocks() const throw()     { return 0; }
+
+    /** Returns one of the blocks of memory holding this channel's state.
+     The block must only contain plain data (no pointers) and its size must
+     only depend on how the channel was constructed.
+     @param index The block, from 0 to getNumStateBlocks() - 1.
+     @param numBytes On return, the size of the block in bytes.
+     @return The block or 0 if the index is out of range. */
+    virtual void* getStateBlock (const int index, int& numBytes) throw()
+    {
+        (void)index;
+        numBytes = 0;
+        return 0;
+    }
+
 protected:
     void setBlockSizeInternal (BlockSize const& newBlockSize) throw();
     void setSampleRateInternal (SampleRate const& newSampleRate) throw();
@@ -138,13 +186,47 @@ private:
     TimeStamp nextTimeStamp;
     TimeStamp expiryTimeStamp;
     Inputs inputs;
+    mutable void* inputSlotItems[MaxInputSlots];
+    mutable signed char inputSlotIndices[MaxInputKeys]; // the slot of each key or -1
+    mutable int inputSlotsGeneration;                   // the inputs' generation when the slots were resolved
+#ifdef PLONK_DEBUG
+    mutable int inputSlotTypes[MaxInputSlots];
+#endif
     BlockSize blockSize;
     SampleRate sampleRate;
     DoubleVariable overlap;
     mutable double cachedSampleDurationTicks;
+    int renderPass;     // used by ParallelRenderer while grouping subgraphs
+    int renderTask;
+    int bufferIndex;    // used by BufferPlanner and GraphSnapshot while analysing the graph
+    const void* bufferPlanner;
+    
+    friend class ParallelRenderer;
+    template<class SampleType> friend class BufferPlannerBase;
+    template<class SampleType> friend class GraphSnapshotBase;
     
     void cacheSampleDurationTicks() const throw();
     
+    template<class Type>
+    PLONK_INLINE_MID void* getInputItem (const int key) const throw()
+    {
+        plonk_assert ((key >= 0) && (key < MaxInputKeys));
+        
+        if (inputSlotsGeneration != this->inputs.getGeneration())
+            resolveInputs();
+        
+        const int slot = inputSlotIndices[key];
+        
+        if (slot >= 0)
+        {
+            plonk_assert (TypeUtility<Type>::getTypeCode() == inputSlotTypes[slot]);
+            return inputSlotItems[slot];
+        }
+        
+        // more inputs than slots or not an input
+        return const_cast<Type*> (&this->inputs[key].template asUnchecked<Type>());
+    }
+    
     ChannelInternalCore();
     ChannelInternalCore (const ChannelInternalCore&);
 	const ChannelInternalCore& operator= (const ChannelInternalCore&);    
@@ -112,6 +112,11 @@ public:
     
     bool isProxy() const throw() { return true; }
     
+    ChannelInternalCore* getProxyOwner() throw()
+    {
+        return owner.getInternal();
+    }
+    
     InternalBase* getChannel (const int /*index*/) throw()
     {
         return this;
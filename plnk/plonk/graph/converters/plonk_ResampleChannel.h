@@ -138,6 +138,30 @@ public:
         this->initProxyValue (channel, sourceValue);
     }
     
+    /** The read position and each channel's input history follow the base state blocks. */
+    int getNumStateBlocks() const throw()
+    {
+        return Internal::getNumStateBlocks() + 1 + tempBuffers.length();
+    }
+    
+    void* getStateBlock (const int index, int& numBytes) throw()
+    {
+        const int blockIndex = index - Internal::getNumStateBlocks();
+        
+        if ((blockIndex < 0) || (blockIndex > tempBuffers.length()))
+            return Internal::getStateBlock (index, numBytes);
+        
+        if (blockIndex == 0)
+        {
+            numBytes = sizeof (tempBufferPos);
+            return &tempBufferPos;
+        }
+        
+        Buffer& tempBuffer = tempBuffers.atUnchecked (blockIndex - 1);
+        numBytes = tempBuffer.length() * sizeof (SampleType);
+        return tempBuffer.getArray();
+    }
+    
     PLONK_INLINE_LOW void resizeTempBuffer (const int inputBufferLength) throw()
     {
         if (inputBufferLength != tempBuffers.atUnchecked (0).length())
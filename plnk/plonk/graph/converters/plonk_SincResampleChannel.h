@@ -0,0 +1,492 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_SINCRESAMPLECHANNEL_H
+#define PLONK_SINCRESAMPLECHANNEL_H
+
+#include "../channel/plonk_ChannelInternalCore.h"
+#include "../plonk_GraphForwardDeclarations.h"
+
+
+/** Bandlimited resampler. 
+ Works like ResampleChannelInternal but reads through a SincTable. When 
+ downsampling the kernel is stretched to move the cutoff below the output 
+ Nyquist frequency (up to SincQuality::MaxDecimation). When the rate is a 
+ single value that stays the same from one block to the next the stretched 
+ kernel is cached as a polyphase table, otherwise it is built per sample.
+ The read position is kept in double precision since float positions limit the
+ phase accuracy to well below that of the better presets. */
+template<class SampleType, SincQuality::Preset Quality>
+class SincResampleChannelInternal
+:   public ProxyOwnerChannelInternal<SampleType, ChannelInternalCore::Data>
+{
+public:
+    typedef ChannelInternalCore::Data                               Data;
+    typedef ChannelBase<SampleType>                                 ChannelType;
+    typedef ObjectArray<ChannelType>                                ChannelArrayType;
+    typedef SincResampleChannelInternal<SampleType,Quality>         ResampleInternal;
+    typedef ProxyOwnerChannelInternal<SampleType,Data>              Internal;
+    typedef ChannelInternalBase<SampleType>                         InternalBase;
+    typedef UnitBase<SampleType>                                    UnitType;
+    typedef InputDictionary                                         Inputs;
+    typedef NumericalArray<SampleType>                              Buffer;
+    typedef ObjectArray<Buffer>                                     BufferArray;
+    typedef SincTableBase<SampleType>                               SincTableType;
+    
+    typedef typename TypeUtility<SampleType>::IndexType             RateType;
+    typedef UnitBase<RateType>                                      RateUnitType;
+    typedef NumericalArray<RateType>                                RateBufferType;
+    
+    SincResampleChannelInternal (Inputs const& inputs,
+                                 Data const& data,
+                                 BlockSize const& blockSize,
+                                 SampleRate const& sampleRate,
+                                 ChannelArrayType& channels) throw()
+    :   Internal (inputs.getMaxNumChannels(), inputs, data, blockSize, sampleRate, channels),
+        table (SincTableType::getShared (Quality)),
+        tempBuffers (BufferArray::withSize (inputs.getMaxNumChannels())),
+        tempBufferPos (0.0),
+        nextInputTimeStamp (TimeStamp::getZero()),
+        scaledRowsScale (0.0),
+        previousIncrement (-1.0)
+    {
+        plonk_assert (sampleRate.getValue() > 0.0);       // no need to resample a DC signal
+        
+        maxHalfTaps = table.getScaledHalfTaps (1.0 / SincQuality::MaxDecimation);
+        extension = maxHalfTaps * 2;
+        offset = maxHalfTaps - 1;
+        
+        extensionBuffer.setSize (extension, false);
+        scratch.setSize (extension, false);
+        scaledRows.setSize (table.getMaxScaledRowsSize (1.0 / SincQuality::MaxDecimation), false);
+    }
+    
+    Text getName() const throw()
+    {
+        return "Sinc Resample";
+    }
+    
+    IntArray getInputKeys() const throw()
+    {
+        const IntArray keys (IOKey::Generic, IOKey::Rate);
+        return keys;
+    }
+    
+    void initChannel (const int channel) throw()
+    {
+        const UnitType& input = this->getInputAsUnit (IOKey::Generic);
+        const SampleType sourceValue = input.getValue (channel);
+        const RateUnitType& rateUnit = ChannelInternalCore::getInputAs<RateUnitType> (IOKey::Rate);
+        plonk_assert (input.getOverlap (channel) == Math<DoubleVariable>::get1());
+        plonk_assert (rateUnit.getOverlap (channel) == Math<DoubleVariable>::get1());
+        (void)rateUnit;
+        
+        if ((channel % this->getNumChannels()) == 0)
+        {
+            resizeTempBuffer (input.getBlockSize (0).getValue() + extension);
+            
+            // the first fetch lands the read position half the kernel before 
+            // the first input sample rather than a whole (stretched) extension
+            tempBufferPos = tempBufferPosMax + double (extension - table.getHalfTaps() - offset);
+        }
+        
+        tempBuffers.atUnchecked (channel).zero();
+        
+        this->initProxyValue (channel, sourceValue);
+    }
+    
+    /** The read position and each channel's input history follow the base state blocks. */
+    int getNumStateBlocks() const throw()
+    {
+        return Internal::getNumStateBlocks() + 1 + tempBuffers.length();
+    }
+    
+    void* getStateBlock (const int index, int& numBytes) throw()
+    {
+        const int blockIndex = index - Internal::getNumStateBlocks();
+        
+        if ((blockIndex < 0) || (blockIndex > tempBuffers.length()))
+            return Internal::getStateBlock (index, numBytes);
+        
+        if (blockIndex == 0)
+        {
+            numBytes = sizeof (tempBufferPos);
+            return &tempBufferPos;
+        }
+        
+        Buffer& tempBuffer = tempBuffers.atUnchecked (blockIndex - 1);
+        numBytes = tempBuffer.length() * sizeof (SampleType);
+        return tempBuffer.getArray();
+    }
+    
+    PLONK_INLINE_LOW void resizeTempBuffer (const int inputBufferLength) throw()
+    {
+        if (inputBufferLength != tempBuffers.atUnchecked (0).length())
+        {
+            for (int i = 0; i < tempBuffers.length(); ++i)
+            {
+                Buffer& tempBuffer = tempBuffers.atUnchecked (i);
+                tempBuffer.setSize (inputBufferLength, false);
+            }
+            
+            tempBufferUsableLength = double (inputBufferLength - extension);
+            tempBufferPosMax = tempBufferUsableLength + double (offset);
+        }
+    }
+    
+    PLONK_INLINE_LOW void getNextInputBuffer (ProcessInfo& info) throw()
+    {
+        const int numChannels = this->getNumChannels();
+        SampleType* const extensionSamples = extensionBuffer.getArray();
+        
+        info.setTimeStamp (nextInputTimeStamp);
+        
+        UnitType& inputUnit (this->getInputAsUnit (IOKey::Generic));        
+        
+        tempBufferPos -= tempBufferUsableLength;
+        
+        for (int channel = 0; channel < numChannels; ++channel)
+        {        
+            const Buffer& inputBuffer (inputUnit.process (info, channel));
+            const SampleType* const inputSamples = inputBuffer.getArray();
+            const int inputBufferLength = inputBuffer.length();
+            
+            Buffer::copyData (extensionSamples,
+                              tempBuffers.atUnchecked (channel).getArray() + tempBuffers.atUnchecked (channel).length() - extension,
+                              extension);
+            
+            resizeTempBuffer (inputBufferLength + extension);
+            
+            Buffer::copyData (tempBuffers.atUnchecked (channel).getArray(),
+                              extensionSamples,
+                              extension);
+            
+            Buffer::copyData (tempBuffers.atUnchecked (channel).getArray() + extension,
+                              inputSamples,
+                              inputBufferLength);
+        }
+        
+        nextInputTimeStamp = inputUnit.getNextTimeStamp (0);
+    }
+    
+    PLONK_INLINE_LOW SampleType lookup (const SampleType* samples, const double position, const double increment) throw()
+    {
+        const int index = int (position);
+        const double frac = position - index;
+        
+        if (increment <= 1.0)
+            return table.interpolate (samples, index, frac);
+        
+        const double scale = 1.0 / plonk::min (increment, double (SincQuality::MaxDecimation));
+        return table.interpolate (samples, index, frac, scale, scratch.getArray());
+    }
+    
+    /** Makes sure scaledRows is ready for a fixed downsampling increment.
+     Returns false (and the per sample kernel should be used) until the same
+     increment has been seen in consecutive blocks. */
+    PLONK_INLINE_LOW bool prepareScaledRows (const double increment) throw()
+    {
+        const double scale = 1.0 / plonk::min (increment, double (SincQuality::MaxDecimation));
+        const bool settled = increment == previousIncrement;
+        previousIncrement = increment;
+        
+        if (scale == scaledRowsScale)
+            return true;
+        
+        if (!settled)
+            return false;
+        
+        // allocated for any scale in the constructor
+        plonk_assert (table.getScaledRowsSize (scale) <= scaledRows.length());
+        
+        table.buildScaledRows (scale, scaledRows.getArray());
+        scaledRowsScale = scale;
+        return true;
+    }
+    
+    void process (ProcessInfo& info, const int /*channel*/) throw()
+    {
+        const Data& data = this->getState();
+        
+        UnitType& inputUnit (this->getInputAsUnit (IOKey::Generic));
+        const double inputSampleRate = inputUnit.getSampleRate (0); // should be the same sample rate for each input channel
+        
+        RateUnitType& rateUnit = ChannelInternalCore::getInputAs<RateUnitType> (IOKey::Rate);
+        
+        const int outputBufferLength = this->getOutputBuffer (0).length();
+        const int numChannels = this->getNumChannels();
+        
+        if (inputSampleRate <= 0.0)
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                const SampleType inputValue = inputUnit.process (info, channel).atUnchecked (0);
+                SampleType* const outputSamples = this->getOutputSamples (channel);
+                NumericalArrayFiller<SampleType>::fill (outputSamples, inputValue, outputBufferLength);
+            }
+        }
+        else
+        {
+            const TimeStamp infoTimeStamp = info.getTimeStamp();
+            
+            const RateBufferType& rateBuffer (rateUnit.process (info, 0));
+            const RateType* const rateSamples = rateBuffer.getArray();
+            const int rateBufferLength = rateBuffer.length();
+            const double incrementScale = inputSampleRate * data.sampleDuration;
+            
+            int outputSamplePosition = 0;
+            
+            if (rateBufferLength == 1)
+            {
+                // fixed ratio for this block
+                const double increment = incrementScale * double (rateSamples[0]);
+                plonk_assert (increment >= 0.0);
+                
+                const bool useScaledRows = (increment > 1.0) && prepareScaledRows (increment);
+                const SampleType* const scaledRowSamples = scaledRows.getArray();
+                
+                while (outputSamplePosition < outputBufferLength)
+                {
+                    if (tempBufferPos >= tempBufferPosMax) // ran out of buffer
+                        getNextInputBuffer (info);
+                    
+                    int channelSamplePosition (0);
+                    double channelBufferPos (0.0);
+                    
+                    for (int channel = 0; channel < numChannels; ++channel)
+                    {
+                        channelBufferPos = tempBufferPos;
+                        
+                        const SampleType* const tempBufferSamples = tempBuffers.atUnchecked (channel).getArray();
+                        SampleType* const outputSamples = this->getOutputSamples (channel);
+                        
+                        for (channelSamplePosition = outputSamplePosition;
+                             (channelSamplePosition < outputBufferLength) && (channelBufferPos < tempBufferPosMax);
+                             ++channelSamplePosition)
+                        {
+                            if (useScaledRows)
+                            {
+                                const int index = int (channelBufferPos);
+                                outputSamples[channelSamplePosition] = table.interpolateScaled (tempBufferSamples, index, channelBufferPos - index,
+                                                                                                scaledRowsScale, scaledRowSamples);
+                            }
+                            else
+                            {
+                                outputSamples[channelSamplePosition] = lookup (tempBufferSamples, channelBufferPos, increment);
+                            }
+                            
+                            channelBufferPos += increment;
+                        }
+                    }
+                    
+                    outputSamplePosition = channelSamplePosition;
+                    tempBufferPos = channelBufferPos;
+                }
+            }
+            else
+            {
+                // variable ratio, the rate buffer is stretched to the output if needed
+                const double rateIncrement = double (rateBufferLength) / double (outputBufferLength);
+                
+                while (outputSamplePosition < outputBufferLength)
+                {
+                    if (tempBufferPos >= tempBufferPosMax) // ran out of buffer
+                        getNextInputBuffer (info);
+                    
+                    int channelSamplePosition (0);
+                    double channelBufferPos (0.0);
+                    
+                    for (int channel = 0; channel < numChannels; ++channel)
+                    {
+                        channelBufferPos = tempBufferPos;
+                        
+                        const SampleType* const tempBufferSamples = tempBuffers.atUnchecked (channel).getArray();
+                        SampleType* const outputSamples = this->getOutputSamples (channel);
+                        
+                        for (channelSamplePosition = outputSamplePosition;
+                             (channelSamplePosition < outputBufferLength) && (channelBufferPos < tempBufferPosMax);
+                             ++channelSamplePosition)
+                        {
+                            const double increment = incrementScale * double (rateSamples[int (channelSamplePosition * rateIncrement)]);
+                            plonk_assert (increment >= 0.0);
+                            outputSamples[channelSamplePosition] = lookup (tempBufferSamples, channelBufferPos, increment);
+                            channelBufferPos += increment;
+                        }
+                    }
+                    
+                    outputSamplePosition = channelSamplePosition;
+                    tempBufferPos = channelBufferPos;
+                }
+            }
+            
+            info.setTimeStamp (infoTimeStamp); // reset for the parent graph
+        }
+    }
+    
+private:
+    const SincTableType& table;
+    BufferArray tempBuffers;
+    Buffer extensionBuffer;
+    Buffer scratch;
+    Buffer scaledRows;
+    int maxHalfTaps;
+    int extension;
+    int offset;
+    double tempBufferPos;
+    double tempBufferPosMax;
+    double tempBufferUsableLength;
+    TimeStamp nextInputTimeStamp;
+    double scaledRowsScale;
+    double previousIncrement;
+};
+
+//------------------------------------------------------------------------------
+
+/** Bandlimited sample rate converter.
+ 
+ Resamples through a Kaiser-windowed sinc kernel. This is more expensive than
+ ResampleUnit but avoids its aliasing, especially at ratios far from 1.
+ The Quality template parameter chooses one of the SincQuality presets, these 
+ share their tables between all units using that preset.
+ 
+ The rate input may be a single value per block (fixed ratio) or a buffer of
+ rates (variable ratio). Downsampling beyond SincQuality::MaxDecimation is 
+ allowed but is only band limited to that ratio.
+ 
+ @par Factory functions:
+ - ar (input, rate=1, preferredBlockSize=default, preferredSampleRate=default)
+ - kr (input, rate=1)
+ 
+ @par Inputs:
+ - input: (unit, multi) the unit to resample
+ - rate: (unit) the playback rate of the input (1 resamples only for sample rate)
+ - preferredBlockSize: the preferred output block size 
+ - preferredSampleRate: the preferred output sample rate
+ 
+ @ingroup ConverterUnits */
+template<class SampleType, SincQuality::Preset Quality>
+class SincResampleUnit
+{
+public:    
+    typedef SincResampleChannelInternal<SampleType,Quality>         ResampleInternal;
+    typedef typename ResampleInternal::Data                         Data;
+    typedef ChannelBase<SampleType>                                 ChannelType;
+    typedef ChannelInternal<SampleType,Data>                        Internal;
+    typedef UnitBase<SampleType>                                    UnitType;
+    typedef InputDictionary                                         Inputs;    
+    
+    typedef typename ResampleInternal::RateType         RateType;
+    typedef typename ResampleInternal::RateUnitType     RateUnitType;
+    typedef typename ResampleInternal::RateBufferType   RateBufferType;
+    
+    static PLONK_INLINE_LOW UnitInfos getInfo() throw()
+    {
+        const double blockSize = (double)BlockSize::getDefault().getValue();
+        const double sampleRate = SampleRate::getDefault().getValue();
+        
+        return UnitInfo ("SincResample", "Resamples signals with a bandlimited windowed-sinc kernel.",
+                         
+                         // output
+                         ChannelCount::VariableChannelCount, 
+                         IOKey::Generic,    Measure::None,     IOInfo::NoDefault,   IOLimit::None,      IOKey::End,
+                         
+                         // inputs
+                         IOKey::Generic,    Measure::None,     IOInfo::NoDefault,   IOLimit::None,
+                         IOKey::Rate,       Measure::Factor,   1.0,                 IOLimit::Minimum,   Measure::Factor,    0.0,
+                         IOKey::BlockSize,  Measure::Samples,  blockSize,           IOLimit::Minimum,   Measure::Samples,   1.0,
+                         IOKey::SampleRate, Measure::Hertz,    sampleRate,          IOLimit::Minimum,   Measure::Hertz,     0.0,
+                         IOKey::End);
+    }    
+    
+    /** Create an audio rate bandlimited sample rate converter. */
+    static UnitType ar (UnitType const& input,
+                        RateUnitType const& rate = Math<RateUnitType>::get1(),
+                        BlockSize const& preferredBlockSize = BlockSize::getDefault(),
+                        SampleRate const& preferredSampleRate = SampleRate::getDefault()) throw()
+    {
+        plonk_assert (preferredSampleRate.getValue() > 0.0); // no need to resample a DC signal
+        plonk_assert (rate.getNumChannels() == 1);
+        
+        bool needsResample = false;
+        
+        if (rate != Math<RateUnitType>::get1())
+        {
+            needsResample = true;
+        }
+        else
+        {
+            for (int i = 0; i < input.getNumChannels(); ++i)
+            {
+                if (input.getSampleRate (i) != preferredSampleRate)
+                {
+                    needsResample = true;
+                    break;
+                }
+            }
+        }
+        
+        if (!needsResample)
+            return input;
+        
+        Inputs inputs;
+        inputs.put (IOKey::Generic, input);
+        inputs.put (IOKey::Rate, rate);
+        
+        Data data = { -1.0, -1.0 };
+        
+        return UnitType::template proxiesFromInputs<ResampleInternal> (inputs,
+                                                                       data,
+                                                                       preferredBlockSize,
+                                                                       preferredSampleRate);
+    }
+    
+    static PLONK_INLINE_LOW UnitType kr (UnitType const& input, 
+                                         RateUnitType const& rate = Math<RateUnitType>::get1()) throw()
+    {
+        return ar (input,
+                   rate,
+                   BlockSize::getControlRateBlockSize(), 
+                   SampleRate::getControlRate());
+    }
+};
+
+typedef SincResampleUnit<PLONK_TYPE_DEFAULT,SincQuality::Medium>    ResampleSinc;
+typedef SincResampleUnit<PLONK_TYPE_DEFAULT,SincQuality::Best>      ResampleSincBest;
+
+
+#endif // PLONK_SINCRESAMPLECHANNEL_H
@@ -161,17 +161,30 @@ public:
     
     //--------------------------------------------------------------------------
     
-    class InputTask :  public Threading::Thread, public Channel::Receiver
+    /** Fills the buffers on the TaskPool. 
+     This is scheduled to run again when half its buffers are likely to have 
+     been freed, or immediately if the output is about to run out of buffers. */
+    class InputTask :  public TaskPool::Task, public Channel::Receiver
     {
     public:
-        typedef LockFreeQueue<TaskBuffer> TaskBufferQueue;
+        typedef RingBufferSPSC<TaskBuffer> TaskBufferQueue;
         
         InputTask (InputTaskChannelInternal* o) throw()
-        :   Threading::Thread (Text ("InputTaskChannelInternal::Thread[" + Text (*(LongLong*)&o) + Text ("]"))),
+        :   TaskPool::Task (o->getState().priority),
             weakOwner (ChannelType (static_cast<ChannelInternalType*> (o))),
-            event (Lock::MutexLock),
+            numBuffers (o->getState().numBuffers),
+            activeBuffers (numBuffers),
+            freeBuffers (numBuffers),
             inputEnded (0)
         {
+            plonk_assert (numBuffers > 0);
+            plonk_assert (o->getBlockSize().getValue() > 0);
+            
+            const int bufferSize = o->getNumChannels() * o->getBlockSize().getValue();
+            
+            // start with silent buffers queued to give the latency to fill them
+            for (int i = 0; i < numBuffers; ++i)
+                activeBuffers.push (TaskBuffer (bufferSize));
         }
         
         void changed (ChannelType const& source, Text const& message, Dynamic const& payload) throw()
@@ -180,145 +193,103 @@ public:
             currentTaskBuffer.getInternal()->messages.push (tm);
         }
         
-        void fillBuffers() throw()
+        double service() throw()
         {
             ChannelType ownerChannel (weakOwner.fromWeak());
             
-            plonk_assert (ownerChannel.isNotNull());
+            // the owner ends this task as it is deleted
+            if (ownerChannel.isNull())
+                return 0.01;
             
             InputTaskChannelInternal* owner = static_cast<InputTaskChannelInternal*> (ownerChannel.getInternal());
+            ProcessInfo& info (owner->getProcessInfo());
             
-            Data& data = owner->getState();
-            setPriority (data.priority);
-            
-            const int numBuffers = owner->getState().numBuffers;
+            UnitType& inputUnit (owner->getInputAsUnit (IOKey::Generic));
             
-            plonk_assert (numBuffers > 0);
-            plonk_assert (owner->getBlockSize().getValue() > 0);
+            if (inputUnit.shouldBeDeletedNow (info))
+            {
+                inputEnded.setValue (1);
+                return 0.01;
+            }
             
-            const int bufferSize = owner->getNumChannels() * owner->getBlockSize().getValue();
+            const int numChannels = owner->getNumChannels();
+            const int blockSize = owner->getBlockSize().getValue();
             
-            for (int i = 0; i < numBuffers; ++i)
-                activeBuffers.push (TaskBuffer (bufferSize));
-        }
-        
-        ResultCode run() throw()
-        {
-            fillBuffers();
+            plonk_assert (inputUnit.channelsHaveSameBlockSize());
             
-            Threading::yield();
-                
-            while (!getShouldExit())
+            while (freeBuffers.pop (currentTaskBuffer)) // nothing else pops so must be still available
             {
-                ChannelType ownerChannel (weakOwner.fromWeak());
-                
-                if (ownerChannel.isNull())
-                    break;
+                Buffer& buffer = currentTaskBuffer.getInternal()->buffer;
+                buffer.setSize (blockSize * numChannels, false);
                 
-                InputTaskChannelInternal* owner = static_cast<InputTaskChannelInternal*> (ownerChannel.getInternal());
-                ProcessInfo& info (owner->getProcessInfo());
-
-                UnitType& inputUnit (owner->getInputAsUnit (IOKey::Generic));
+                SampleType* bufferSamples = buffer.getArray();
                 
-                if (inputUnit.shouldBeDeletedNow (info))
+                for (int channel = 0; channel < numChannels; ++channel)
                 {
-                    inputEnded.setValue (1);
-                    Threading::sleep (0.01);
-                    continue;
-                }
-                
-                const int numChannels = owner->getNumChannels();
-                const int blockSize = owner->getBlockSize().getValue();
-                const int numFreeBuffers = freeBuffers.length();
-                
-                plonk_assert (inputUnit.channelsHaveSameBlockSize());
-
-                if (numFreeBuffers > 0)
-                {                                        
-                    currentTaskBuffer = freeBuffers.pop(); // nothing else pops so must be still available
-                    Buffer& buffer = currentTaskBuffer.getInternal()->buffer;
-                    buffer.setSize (blockSize * numChannels, false);
+                    const Buffer& inputBuffer (inputUnit.process (info, channel));
+                    const SampleType* inputSamples = inputBuffer.getArray();
+                    const int inputBufferLength = inputBuffer.length();
                     
-                    SampleType* bufferSamples = buffer.getArray();
-
-                    for (int channel = 0; channel < numChannels; ++channel)
+                    if (buffer.length() == (numChannels * inputBufferLength))
                     {
-                        const Buffer& inputBuffer (inputUnit.process (info, channel));                    
-                        const SampleType* inputSamples = inputBuffer.getArray();
-                        const int inputBufferLength = inputBuffer.length();
-                                                
-                        if (buffer.length() == (numChannels * inputBufferLength))
-                        {
-                            NumericalArray<SampleType>::copyData (bufferSamples, inputSamples, inputBufferLength);
-                            bufferSamples += inputBufferLength;
-                        }
-                        else
-                        {
-                            // probably got deleted..?
-                            buffer.zero();
-                            break;
-                        }
+                        NumericalArray<SampleType>::copyData (bufferSamples, inputSamples, inputBufferLength);
+                        bufferSamples += inputBufferLength;
+                    }
+                    else
+                    {
+                        // probably got deleted..?
+                        buffer.zero();
+                        break;
                     }
-                    
-                    activeBuffers.push (currentTaskBuffer);
-                    currentTaskBuffer = TaskBuffer::getNull();
-
-                    plonk_assert (inputUnit.channelsHaveSameSampleRate());
-                    info.offsetTimeStamp (owner->getSampleRate().getSampleDurationInTicks() * blockSize);
                 }
                 
-                if (numFreeBuffers == 1)
-                {
-                    event.wait (0.5);
-                }
-                else if (numFreeBuffers < (activeBuffers.length() * 2))
-                {
-                    Threading::sleep (owner->getBlockDurationInTicks() * TimeStamp::getReciprocalTicks());
-                }
-                else
-                {
-                    Threading::yield();
-                }
+                activeBuffers.push (currentTaskBuffer);
+                currentTaskBuffer = TaskBuffer::getNull();
+                
+                plonk_assert (inputUnit.channelsHaveSameSampleRate());
+                info.offsetTimeStamp (owner->getSampleRate().getSampleDurationInTicks() * blockSize);
+                
+                if (inputUnit.shouldBeDeletedNow (info))
+                    break;
             }
             
-            freeBuffers.clearAll();
-            activeBuffers.clearAll();
-            
-            delete this;
-            
-            return PlankResult_ThreadWasDeleted;
+            // deadline: the time for the output to use up to half the buffers
+            const int numBuffersToUse = plonk::max (activeBuffers.length() - numBuffers / 2, 1);
+            return numBuffersToUse * owner->getBlockDurationInTicks() * TimeStamp::getReciprocalTicks();
         }
-                
-        void end() throw()
-        {
-            Lock e = this->event; // take a shared copy of the event
-            setShouldExit();      // this might delete this object before the next line
-            e.signal();           // or this will proceed past the wait, or be harmless if the thread died already
-        }
-    
+        
         PLONK_INLINE_LOW bool pop (TaskBuffer& buffer) throw()
         {
             return activeBuffers.pop (buffer);
         }
-    
+        
         PLONK_INLINE_LOW void push (TaskBuffer const& buffer) throw()
         {
             buffer.getInternal()->messages.clear();
-            freeBuffers.push (buffer);
-            event.signal();
+            
+            // never fails as there are only ever numBuffers buffers between the two queues
+            const bool pushed = freeBuffers.push (buffer);
+            plonk_assert (pushed);
+#ifndef PLONK_DEBUG
+            (void)pushed;
+#endif
+            
+            // only wake the pool if the output is about to run dry, otherwise it meets its deadline
+            if (activeBuffers.length() <= plonk::max (numBuffers / 4, 1))
+                wake();
         }
         
         PLONK_INLINE_LOW bool inputHasEnded() const throw()
         {
             return inputEnded.getValueUnchecked() != 0;
         }
-    
+        
     private:
         WeakChannelType weakOwner;
+        const int numBuffers;
         TaskBufferQueue activeBuffers;
         TaskBufferQueue freeBuffers;
         TaskBuffer currentTaskBuffer;
-        Lock event;
         AtomicInt inputEnded;
     };
     
@@ -340,7 +311,7 @@ public:
         if (data.resampleInput)
             inputUnit = ResampleType::ar (inputUnit, 1, blockSize, sampleRate);
         
-        task->start();
+        TaskPool::global().add (task);
     }
     
     ~InputTaskChannelInternal()
@@ -353,7 +324,7 @@ public:
     {
         UnitType& inputUnit (this->getInputAsUnit (IOKey::Generic));
         inputUnit.removeReceiverFromChannels (task);
-        task->end(); // will delete the task when its thread exits
+        task->end(); // the pool will delete the task
         task = 0;
     }
             
@@ -362,6 +333,11 @@ public:
         return "Task";
     }       
     
+    bool processesInputsInBackground() const throw()
+    {
+        return true;
+    }
+    
     IntArray getInputKeys() const throw()
     {
         const IntArray keys (IOKey::Generic);
@@ -130,6 +130,25 @@ public:
         }
     }    
     
+    /** The circular buffers follow the base state blocks.
+     The delay states are rebuilt from the Data each block. */
+    int getNumStateBlocks() const throw()
+    {
+        return Internal::getNumStateBlocks() + circularBuffers.length();
+    }
+
+    void* getStateBlock (const int index, int& numBytes) throw()
+    {
+        const int bufferIndex = index - Internal::getNumStateBlocks();
+
+        if ((bufferIndex < 0) || (bufferIndex >= circularBuffers.length()))
+            return Internal::getStateBlock (index, numBytes);
+
+        Buffer& circularBuffer = circularBuffers.atUnchecked (bufferIndex);
+        numBytes = circularBuffer.length() * sizeof (SampleType);
+        return circularBuffer.getArray();
+    }
+
     PLONK_INLINE_LOW BufferArray& getCircularBuffers() { return circularBuffers; }
     PLONK_INLINE_LOW DelayStateArray& getDelayStates() { return delayStates; }
     
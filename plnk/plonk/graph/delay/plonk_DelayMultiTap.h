@@ -0,0 +1,518 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_DELAYMULTITAP_H
+#define PLONK_DELAYMULTITAP_H
+
+#include "../channel/plonk_ChannelInternalCore.h"
+#include "plonk_DelayForwardDeclarations.h"
+
+
+/** The weights that read a tap from a delay line at a fixed fractional position.
+ The samples from Offset before the whole part of the position are multiplied
+ by the NumWeights weights and summed. */
+template<class SampleType, Interp::TypeCode InterpTypeCode>
+class MultiTapDelayInterp
+{
+};
+
+template<class SampleType>
+class MultiTapDelayInterp<SampleType, Interp::None>
+{
+public:
+    enum Constants { NumWeights = 1, Offset = 0 };
+    
+    static PLONK_INLINE_LOW void getWeights (SampleType* weights, SampleType const& /*frac*/, SampleType const& gain) throw()
+    {
+        weights[0] = gain;
+    }
+};
+
+template<class SampleType>
+class MultiTapDelayInterp<SampleType, Interp::Linear>
+{
+public:
+    enum Constants { NumWeights = 2, Offset = 0 };
+    
+    static PLONK_INLINE_LOW void getWeights (SampleType* weights, SampleType const& frac, SampleType const& gain) throw()
+    {
+        weights[0] = (SampleType (1) - frac) * gain;
+        weights[1] = frac * gain;
+    }
+};
+
+template<class SampleType>
+class MultiTapDelayInterp<SampleType, Interp::Lagrange3>
+{
+public:
+    enum Constants { NumWeights = 4, Offset = 1 };
+    
+    // InterpLagrange3::interp expanded for each of the four samples
+    static PLONK_INLINE_LOW void getWeights (SampleType* weights, SampleType const& frac, SampleType const& gain) throw()
+    {
+        const SampleType half = Math<SampleType>::get0_5();
+        const SampleType third = Math<SampleType>::get1_3();
+        const SampleType sixth = Math<SampleType>::get1_6();
+        const SampleType frac2 = frac * frac;
+        const SampleType frac3 = frac2 * frac;
+        
+        weights[0] = (half * frac2 - third * frac - sixth * frac3) * gain;
+        weights[1] = (SampleType (1) - half * frac - frac2 + half * frac3) * gain;
+        weights[2] = (frac + half * frac2 - half * frac3) * gain;
+        weights[3] = (sixth * (frac3 - frac)) * gain;
+    }
+};
+
+/** @internal */
+template<class SampleType>
+class MultiTapDelayKernel
+{
+public:
+    static PLONK_INLINE_LOW void process (SampleType* output, const SampleType* input, const SampleType* weights, const int numWeights, const int numSamples) throw()
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            SampleType sum = weights[0] * input[i];
+            
+            for (int k = 1; k < numWeights; ++k)
+                sum += weights[k] * input[i + k];
+            
+            output[i] = sum;
+        }
+    }
+};
+
+template<>
+class MultiTapDelayKernel<float>
+{
+public:
+    static PLONK_INLINE_LOW void process (float* output, const float* input, const float* weights, const int numWeights, const int numSamples) throw()
+    {
+        pl_VectorTapsF (output, input, weights, numWeights, numSamples);
+    }
+};
+
+template<>
+class MultiTapDelayKernel<double>
+{
+public:
+    static PLONK_INLINE_LOW void process (double* output, const double* input, const double* weights, const int numWeights, const int numSamples) throw()
+    {
+        pl_VectorTapsD (output, input, weights, numWeights, numSamples);
+    }
+};
+
+template<class SampleType>
+struct MultiTapDelayData
+{
+    typedef typename TypeUtility<SampleType>::IndexType IndexType;
+    
+    ChannelInternalCore::Data base;
+    
+    IndexType maximumDuration;
+};
+
+//------------------------------------------------------------------------------
+
+/** Multi-tap delay processor. 
+ The input is written once to a circular buffer with a power of two length
+ and each output channel reads a tap from it. Taps with a delay that is 
+ constant over a block are read as a whole block at a time. */
+template<class SampleType, Interp::TypeCode InterpTypeCode>
+class MultiTapDelayChannelInternal
+:   public ProxyOwnerChannelInternal<SampleType, MultiTapDelayData<SampleType> >
+{
+public:
+    typedef MultiTapDelayData<SampleType>                                   Data;
+    typedef ChannelBase<SampleType>                                         ChannelType;
+    typedef ObjectArray<ChannelType>                                        ChannelArrayType;
+    typedef MultiTapDelayChannelInternal<SampleType,InterpTypeCode>         MultiTapDelayInternal;
+    typedef ProxyOwnerChannelInternal<SampleType,Data>                      Internal;
+    typedef UnitBase<SampleType>                                            UnitType;
+    typedef InputDictionary                                                 Inputs;
+    typedef NumericalArray<SampleType>                                      Buffer;
+    typedef typename BinaryOpFunctionsHelper<SampleType>::BinaryOpFunctionsType BinaryOpFunctionsType;
+    
+    typedef typename TypeUtility<SampleType>::IndexType                     DurationType;
+    typedef UnitBase<DurationType>                                          DurationUnitType;
+    typedef NumericalArray<DurationType>                                    DurationBufferType;
+    
+    typedef MultiTapDelayInterp<SampleType,InterpTypeCode>                  TapInterpType;
+    typedef typename InterpSelect<SampleType,DurationType,InterpTypeCode>::InterpType InterpType;
+    
+    enum Constants
+    {
+        Guard = 4 // samples copied either side of the circular buffer so interpolation needn't wrap
+    };
+    
+    MultiTapDelayChannelInternal (Inputs const& inputs, 
+                                  Data const& data, 
+                                  BlockSize const& blockSize,
+                                  SampleRate const& sampleRate,
+                                  ChannelArrayType& channels) throw()
+    :   Internal (numChannelsFromInputs (inputs), inputs, data, blockSize, sampleRate, channels),
+        ringLength (0),
+        ringMask (0),
+        writePosition (0),
+        maximumDelay (0)
+    {
+    }
+    
+    static int numChannelsFromInputs (Inputs const& inputs) throw()
+    {
+        const DurationUnitType& durations = inputs[IOKey::Duration].template asUnchecked<DurationUnitType>();
+        const UnitType& gains = inputs[IOKey::Gain].template asUnchecked<UnitType>();
+        return plonk::max (durations.getNumChannels(), gains.getNumChannels());
+    }
+    
+    Text getName() const throw()
+    {
+        return "Multi-Tap Delay";
+    }       
+    
+    IntArray getInputKeys() const throw()
+    {
+        const IntArray keys (IOKey::Generic, IOKey::Duration, IOKey::Gain);
+        return keys;
+    }    
+    
+    void initChannel (const int channel) throw()
+    {        
+        const UnitType& inputUnit = this->getInputAsUnit (IOKey::Generic);
+        
+        if ((channel % this->getNumChannels()) == 0)
+        {
+            this->setBlockSize (BlockSize::decide (inputUnit.getBlockSize (0),
+                                                   this->getBlockSize()));
+            this->setSampleRate (SampleRate::decide (inputUnit.getSampleRate (0),
+                                                     this->getSampleRate()));
+            
+            this->setOverlap (inputUnit.getOverlap (0));
+            
+            const Data& data = this->getState();
+            
+            // the whole block is written before the taps are read so this must fit too
+            maximumDelay = int (data.maximumDuration * this->getSampleRate().getValue() + 0.5);
+            ringLength = Bits::nextPowerOf2 (maximumDelay + this->getBlockSize().getValue() + int (Guard));
+            ringMask = ringLength - 1;
+            ring = Buffer::newClear (ringLength + Guard * 2);
+            writePosition = 0;
+        }
+        
+        this->initProxyValue (channel, SampleType (0));
+    }
+    
+    void process (ProcessInfo& info, const int /*channel*/) throw()
+    {
+        UnitType& inputUnit = this->getInputAsUnit (IOKey::Generic);
+        DurationUnitType& durationUnit = ChannelInternalCore::getInputAs<DurationUnitType> (IOKey::Duration);
+        UnitType& gainUnit = this->getInputAsUnit (IOKey::Gain);
+        
+        const Buffer& inputBuffer (inputUnit.process (info, 0));
+        const SampleType* const inputSamples = inputBuffer.getArray();
+        const int outputBufferLength = this->getOutputBuffer (0).length();
+        
+        plonk_assert (inputBuffer.length() == outputBufferLength);
+        plonk_assert ((outputBufferLength + maximumDelay + Guard) <= ringLength);
+
+        // write the input once for all the taps
+        SampleType* const ringSamples = ring.getArray() + Guard;
+        const int numBeforeWrap = plonk::min (outputBufferLength, ringLength - writePosition);
+        const int numAfterWrap = outputBufferLength - numBeforeWrap;
+        
+        Buffer::copyData (ringSamples + writePosition, inputSamples, numBeforeWrap);
+        
+        if (numAfterWrap > 0)
+            Buffer::copyData (ringSamples, inputSamples + numBeforeWrap, numAfterWrap);
+        
+        Buffer::copyData (ringSamples + ringLength, ringSamples, Guard);
+        Buffer::copyData (ringSamples - Guard, ringSamples + ringLength - Guard, Guard);
+        
+        const int numChannels = this->getNumChannels();
+        const double sampleRate = this->getSampleRate().getValue();
+        
+        for (int tap = 0; tap < numChannels; ++tap)
+        {
+            const DurationBufferType& durationBuffer (durationUnit.process (info, tap));
+            const Buffer& gainBuffer (gainUnit.process (info, tap));
+            SampleType* const outputSamples = this->getOutputSamples (tap);
+            const int durationBufferLength = durationBuffer.length();
+            const int gainBufferLength = gainBuffer.length();
+            
+            // a constant gain is applied in the weights when the delay is constant too
+            if (durationBufferLength == 1)
+                readBlock (outputSamples, outputBufferLength, ringSamples, 
+                           getDelay (durationBuffer.atUnchecked (0), sampleRate), 
+                           gainBufferLength == 1 ? gainBuffer.atUnchecked (0) : SampleType (1));
+            else
+                readSamples (outputSamples, outputBufferLength, ringSamples, durationBuffer, sampleRate);
+            
+            if (gainBufferLength == 1)
+            {
+                if (durationBufferLength != 1)
+                    NumericalArrayBinaryOp<SampleType,BinaryOpFunctionsType::mulop>::calcN1 (outputSamples, outputSamples, 
+                                                                                              gainBuffer.atUnchecked (0), outputBufferLength);
+            }
+            else if (gainBufferLength == outputBufferLength)
+            {
+                NumericalArrayBinaryOp<SampleType,BinaryOpFunctionsType::mulop>::calcNN (outputSamples, outputSamples, 
+                                                                                          gainBuffer.getArray(), outputBufferLength);
+            }
+            else
+            {
+                const SampleType* const gainSamples = gainBuffer.getArray();
+                const double gainIncrement = double (gainBufferLength) / double (outputBufferLength);
+                double gainPosition = 0.0;
+                
+                for (int i = 0; i < outputBufferLength; ++i)
+                {
+                    outputSamples[i] *= gainSamples[int (gainPosition)];
+                    gainPosition += gainIncrement;
+                }
+            }
+        }
+        
+        writePosition = (writePosition + outputBufferLength) & ringMask;
+    }
+    
+    /** The circular buffer and write position follow the base state blocks. */
+    int getNumStateBlocks() const throw()
+    {
+        return Internal::getNumStateBlocks() + 2;
+    }
+    
+    void* getStateBlock (const int index, int& numBytes) throw()
+    {
+        const int baseBlocks = Internal::getNumStateBlocks();
+        
+        if (index == baseBlocks)
+        {
+            numBytes = ring.length() * sizeof (SampleType);
+            return ring.getArray();
+        }
+        else if (index == (baseBlocks + 1))
+        {
+            numBytes = sizeof (writePosition);
+            return &writePosition;
+        }
+        
+        return Internal::getStateBlock (index, numBytes);
+    }
+    
+private:
+    PLONK_INLINE_LOW double getDelay (DurationType const& duration, const double sampleRate) const throw()
+    {
+        return plonk::clip (double (duration) * sampleRate, 0.0, double (maximumDelay));
+    }
+    
+    /** Reads a tap with a fixed delay using the same weights for the whole block. */
+    void readBlock (SampleType* const outputSamples, const int outputBufferLength, 
+                    const SampleType* const ringSamples, const double delay, 
+                    SampleType const& gain) const throw()
+    {
+        // the delay is less than the ring length so this is positive and truncation is floor
+        const double position = double (writePosition + ringLength) - delay;
+        const int start = int (position);
+        
+        SampleType weights[TapInterpType::NumWeights];
+        TapInterpType::getWeights (weights, SampleType (position - double (start)), gain);
+        
+        for (int done = 0; done < outputBufferLength; )
+        {
+            const int index = (start + done) & ringMask;
+            const int length = plonk::min (outputBufferLength - done, ringLength - index);
+            
+            MultiTapDelayKernel<SampleType>::process (outputSamples + done, 
+                                                      ringSamples + index - TapInterpType::Offset, 
+                                                      weights, TapInterpType::NumWeights, 
+                                                      length);
+            done += length;
+        }
+    }
+    
+    /** Reads a tap with a delay that changes during the block. */
+    void readSamples (SampleType* const outputSamples, const int outputBufferLength, 
+                      const SampleType* const ringSamples, DurationBufferType const& durationBuffer,
+                      const double sampleRate) const throw()
+    {
+        const DurationType* const durationSamples = durationBuffer.getArray();
+        const double durationIncrement = double (durationBuffer.length()) / double (outputBufferLength);
+        double durationPosition = 0.0;
+        
+        for (int i = 0; i < outputBufferLength; ++i)
+        {
+            const double position = double (writePosition + ringLength + i) - getDelay (durationSamples[int (durationPosition)], sampleRate);
+            const int whole = int (position);
+            
+            outputSamples[i] = InterpType::lookup (ringSamples + (whole & ringMask), DurationType (position - double (whole)));
+            durationPosition += durationIncrement;
+        }
+    }
+    
+    Buffer ring;
+    int ringLength;
+    int ringMask;
+    int writePosition;
+    int maximumDelay;
+};
+
+//------------------------------------------------------------------------------
+
+/** Multi-tap delay processor. 
+ Writes the input to a single circular buffer and reads any number of taps
+ from it, each with its own delay time and gain. This uses less memory and 
+ processing than a Delay for each tap, e.g., for echoes, chorus and early 
+ reflections. There is an output channel for each tap, use mix() to sum them.
+ 
+ @par Factory functions:
+ - ar (input, durations=0.5, gains=1, maximumDuration=1, mul=1, add=0, preferredBlockSize=default, preferredSampleRate=default)
+ 
+ @par Inputs:
+ - input: (unit, multi) the unit to which delay is applied
+ - durations: (unit, multi) the delay of each tap in seconds (with a multichannel input these are distributed across the input channels as for Delay)
+ - gains: (unit, multi) the gain of each tap
+ - maximumDuration: (real) the maximum delay time in seconds
+ - mul: (unit, multi) the multiplier applied to the output
+ - add: (unit, multi) the offset added to the output
+ - preferredBlockSize: the preferred output block size (for advanced usage, leave on default if unsure)
+ - preferredSampleRate: the preferred output sample rate (for advanced usage, leave on default if unsure)
+
+ @ingroup DelayUnits */
+template<class SampleType, Interp::TypeCode InterpTypeCode>
+class MultiTapDelayUnit
+{
+public:    
+    typedef MultiTapDelayChannelInternal<SampleType,InterpTypeCode> MultiTapDelayInternal;
+    typedef typename MultiTapDelayInternal::Data                    Data;
+    typedef ChannelBase<SampleType>                                 ChannelType;
+    typedef UnitBase<SampleType>                                    UnitType;
+    typedef InputDictionary                                         Inputs;
+    typedef NumericalArray2D<ChannelType,UnitType>                  UnitArrayType;
+    
+    typedef typename MultiTapDelayInternal::DurationType            DurationType;
+    typedef UnitBase<DurationType>                                  DurationUnitType;
+    typedef ChannelBase<DurationType>                               DurationChannelType;
+    typedef NumericalArray2D<DurationChannelType,DurationUnitType>  DurationUnitArrayType;
+    
+    typedef MultiTapDelayUnit<SampleType, Interp::Lagrange3>        HQ;
+    typedef MultiTapDelayUnit<SampleType, Interp::None>             N;
+    
+    static PLONK_INLINE_LOW UnitInfos getInfo() throw()
+    {
+        const double blockSize = (double)BlockSize::getDefault().getValue();
+        const double sampleRate = SampleRate::getDefault().getValue();
+        
+        return UnitInfo ("MultiTapDelay", "A delay processor with many taps.",
+                         
+                         // output
+                         ChannelCount::VariableChannelCount, 
+                         IOKey::Generic,            Measure::None,      0.0,                IOLimit::None,                         
+                         IOKey::End,
+                         
+                         // inputs
+                         IOKey::Generic,            Measure::None,      IOInfo::NoDefault,  IOLimit::None,
+                         IOKey::Duration,           Measure::Seconds,   0.5,                IOLimit::Minimum,   Measure::Seconds,   0.0,
+                         IOKey::Gain,               Measure::Factor,    1.0,                IOLimit::None,
+                         IOKey::MaximumDuration,    Measure::Seconds,   1.0,                IOLimit::Minimum,   Measure::Samples,   1.0,
+                         IOKey::Multiply,           Measure::Factor,    1.0,                IOLimit::None,
+                         IOKey::Add,                Measure::None,      0.0,                IOLimit::None,
+                         IOKey::BlockSize,          Measure::Samples,   blockSize,          IOLimit::Minimum,   Measure::Samples,   1.0,
+                         IOKey::SampleRate,         Measure::Hertz,     sampleRate,         IOLimit::Minimum,   Measure::Hertz,     0.0,
+                         IOKey::End);
+    }
+    
+    static UnitType ar (UnitType const& input,
+                        DurationUnitType const& durations = DurationType (0.5),
+                        UnitType const& gains = SampleType (1),
+                        const DurationType maximumDuration = DurationType (1.0),
+                        UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0),
+                        BlockSize const& preferredBlockSize = BlockSize::getDefault(),
+                        SampleRate const& preferredSampleRate = SampleRate::getDefault()) throw()
+    {             
+        const Data data = { { -1.0, -1.0 }, maximumDuration };
+        
+        const int numInputChannels = input.getNumChannels();
+        
+        if (numInputChannels == 1)
+        {
+            Inputs inputs;
+            inputs.put (IOKey::Generic, input);
+            inputs.put (IOKey::Duration, durations);
+            inputs.put (IOKey::Gain, gains);
+            inputs.put (IOKey::Multiply, mul);
+            inputs.put (IOKey::Add, add);
+            
+            return UnitType::template proxiesFromInputs<MultiTapDelayInternal> (inputs,
+                                                                                data, 
+                                                                                preferredBlockSize, 
+                                                                                preferredSampleRate);
+        }
+        else
+        {
+            DurationUnitArrayType durationsGrouped = durations.deinterleave (numInputChannels);
+            UnitArrayType gainsGrouped = gains.deinterleave (numInputChannels);
+            UnitArrayType resultGrouped;
+            
+            for (int i = 0; i < numInputChannels; ++i)
+            {
+                Inputs inputs;
+                inputs.put (IOKey::Generic, input[i]);
+                
+                // deinterleave leaves groups empty if there are fewer channels than groups, share these instead
+                inputs.put (IOKey::Duration, durations.getNumChannels() < numInputChannels ? DurationUnitType (durations.wrapAt (i)) : durationsGrouped.atUnchecked (i));
+                inputs.put (IOKey::Gain, gains.getNumChannels() < numInputChannels ? UnitType (gains.wrapAt (i)) : gainsGrouped.atUnchecked (i));
+                
+                UnitType unit = UnitType::template proxiesFromInputs<MultiTapDelayInternal> (inputs,
+                                                                                             data,
+                                                                                             preferredBlockSize,
+                                                                                             preferredSampleRate);
+                resultGrouped.add (unit);
+            }
+            
+            const UnitType mainUnit (resultGrouped.interleave());
+            return UnitType::applyMulAdd (mainUnit, mul, add);
+        }
+    }
+};
+
+typedef MultiTapDelayUnit<PLONK_TYPE_DEFAULT> MultiTapDelay;
+
+
+
+#endif // PLONK_DELAYMULTITAP_H
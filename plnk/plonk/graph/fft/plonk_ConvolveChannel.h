@@ -0,0 +1,638 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_CONVOLVECHANNEL_H
+#define PLONK_CONVOLVECHANNEL_H
+
+#include "../channel/plonk_ChannelInternalCore.h"
+#include "../plonk_GraphForwardDeclarations.h"
+
+template<class SampleType> class ConvolveChannelInternal;
+
+PLONK_CHANNELDATA_DECLARE(ConvolveChannelInternal,SampleType)
+{
+    ChannelInternalCore::Data base;
+    int numOutputs;
+    int maxPartitionSize;
+};
+
+//------------------------------------------------------------------------------
+
+/** One stage of a partitioned convolution. 
+ This convolves one section of the impulse response split into equal sized 
+ partitions using overlap-save. The spectrum of each input partition is kept 
+ in a frequency-domain delay line so each new partition of input needs only 
+ one forward FFT per input and one inverse FFT per output. 
+ @internal */
+template<class SampleType>
+class ConvolveStage
+{
+public:
+    typedef NumericalArray<SampleType>                  Buffer;
+    typedef NumericalArray<const SampleType*>           InputArray;
+    typedef SignalBase<SampleType>                      SignalType;
+    typedef FFTEngineBase<SampleType>                   FFTEngineType;
+    typedef typename BinaryOpFunctionsHelper<SampleType>::BinaryOpFunctionsType BinaryOpFunctionsType;
+    
+    enum Constants
+    {
+        NumStateBlocks = 4      // the input windows, the input spectra and the two positions
+    };
+    
+    ConvolveStage() throw()
+    :   partitionSize (0),
+        offset (0),
+        numPartitions (0),
+        numInputs (0),
+        numOutputs (0),
+        inputPosition (0),
+        fdlPosition (0)
+    {
+    }
+    
+    /** Prepare the stage.
+     @param impulse     The impulse response.
+     @param routes      Triplets of input, output and impulse channel indices.
+     @param offset      The first frame of the impulse to use.
+     @param size        The partition size, this must be a power of 2.
+     @param count       The number of partitions. */
+    void init (SignalType const& impulse, IntArray const& routes, 
+               const int numInputChannels, const int numOutputChannels,
+               const int startFrame, const int size, const int count) throw()
+    {
+        plonk_assert (Bits::isPowerOf2 (size));
+        
+        partitionSize = size;
+        offset = startFrame;
+        numPartitions = count;
+        numInputs = numInputChannels;
+        numOutputs = numOutputChannels;
+        inputPosition = 0;
+        fdlPosition = 0;
+        
+        const int fftSize = partitionSize * 2;
+        const int numRoutes = routes.length() / 3;
+        
+        fft = FFTEngineType (fftSize);
+        window = Buffer::newClear (numInputs * fftSize);
+        fdl = Buffer::newClear (numInputs * numPartitions * fftSize);
+        filters = Buffer::newClear (numRoutes * numPartitions * fftSize);
+        accumulators = Buffer::newClear (numOutputs * fftSize);
+        temp = Buffer::newClear (fftSize);
+        
+        // the scaling of the FFT implementation applies twice to the input and once to the inverse
+        // the FFT is not in-place so the window is used as scratch space here
+        temp.atUnchecked (0) = SampleType (1);
+        fft.forward (window.getArray(), temp.getArray());
+        const SampleType forwardScale = window.atUnchecked (0);
+        fft.inverse (temp.getArray(), window.getArray());
+        const SampleType scale = SampleType (1) / (temp.atUnchecked (0) * forwardScale);
+        window.zero();
+        
+        const int numImpulseFrames = impulse.getNumFrames();
+        const int frameStride = impulse.getFrameStride();
+        
+        for (int route = 0; route < numRoutes; ++route)
+        {
+            const SampleType* const impulseSamples = impulse.getSamples (routes.atUnchecked (route * 3 + 2));
+            
+            for (int partition = 0; partition < numPartitions; ++partition)
+            {
+                SampleType* const filterSamples = filters.getArray() + (route * numPartitions + partition) * fftSize;
+                SampleType* const tempSamples = temp.getArray();
+                const int start = offset + partition * partitionSize;
+                const int end = plonk::min (start + partitionSize, numImpulseFrames);
+                
+                temp.zero();
+                
+                for (int frame = start; frame < end; ++frame)
+                    tempSamples[frame - start] = impulseSamples[frame * frameStride] * scale;
+                
+                fft.forward (filterSamples, tempSamples);
+            }
+        }
+        
+        this->routes = routes;
+    }
+    
+    PLONK_INLINE_LOW int getPartitionSize() const throw() { return partitionSize; }
+    PLONK_INLINE_LOW int getOffset() const throw() { return offset; }
+    PLONK_INLINE_LOW int getLength() const throw() { return partitionSize * numPartitions; }
+    
+    /** Returns one of the NumStateBlocks blocks holding the stage's running state.
+     The filters are made from the impulse so aren't included. */
+    void* getStateBlock (const int index, int& numBytes) throw()
+    {
+        switch (index)
+        {
+            case 0:
+                numBytes = window.length() * sizeof (SampleType);
+                return window.getArray();
+            case 1:
+                numBytes = fdl.length() * sizeof (SampleType);
+                return fdl.getArray();
+            case 2:
+                numBytes = sizeof (inputPosition);
+                return &inputPosition;
+            case 3:
+                numBytes = sizeof (fdlPosition);
+                return &fdlPosition;
+            default:
+                numBytes = 0;
+                return 0;
+        }
+    }
+    
+    /** Add a block of input.
+     Each time a partition of input is complete its convolution is added to the
+     output rings (one after the other in @p ring) at the corresponding position. 
+     @param blockStart  The ring position corresponding to the first input sample. */
+    void process (InputArray const& inputs, const int numSamples, 
+                  Buffer& ring, const int ringSize, const int blockStart) throw()
+    {
+        const int fftSize = partitionSize * 2;
+        int done = 0;
+        
+        while (done < numSamples)
+        {
+            const int numToCopy = plonk::min (numSamples - done, partitionSize - inputPosition);
+            
+            for (int input = 0; input < numInputs; ++input)
+                Buffer::copyData (window.getArray() + input * fftSize + partitionSize + inputPosition, 
+                                  inputs.atUnchecked (input) + done, 
+                                  numToCopy);
+            
+            inputPosition += numToCopy;
+            done += numToCopy;
+            
+            if (inputPosition == partitionSize)
+            {
+                convolve (ring, ringSize, blockStart + done - partitionSize + offset);
+                inputPosition = 0;
+            }
+        }
+    }
+    
+private:
+    int partitionSize;
+    int offset;
+    int numPartitions;
+    int numInputs;
+    int numOutputs;
+    int inputPosition;
+    int fdlPosition;
+    
+    FFTEngineType fft;
+    IntArray routes;
+    Buffer window;          // the previous and current partition of each input
+    Buffer fdl;             // input spectra, numPartitions for each input
+    Buffer filters;         // impulse spectra, numPartitions for each route
+    Buffer accumulators;    // output spectra
+    Buffer temp;
+    
+    void convolve (Buffer& ring, const int ringSize, const int ringPosition) throw()
+    {
+        const int fftSize = partitionSize * 2;
+        const int numRoutes = routes.length() / 3;
+        int i;
+        
+        fdlPosition = (fdlPosition + 1) % numPartitions;
+        
+        for (i = 0; i < numInputs; ++i)
+        {
+            SampleType* const windowSamples = window.getArray() + i * fftSize;
+            fft.forward (fdl.getArray() + (i * numPartitions + fdlPosition) * fftSize, windowSamples);
+            Buffer::copyData (windowSamples, windowSamples + partitionSize, partitionSize);
+        }
+        
+        accumulators.zero();
+        
+        for (int route = 0; route < numRoutes; ++route)
+        {
+            const int input = routes.atUnchecked (route * 3);
+            const int output = routes.atUnchecked (route * 3 + 1);
+            SampleType* const accumulatorSamples = accumulators.getArray() + output * fftSize;
+            
+            for (int partition = 0; partition < numPartitions; ++partition)
+            {
+                const int slot = (fdlPosition - partition + numPartitions) % numPartitions;
+                const SampleType* const spectrumSamples = fdl.getArray() + (input * numPartitions + slot) * fftSize;
+                const SampleType* const filterSamples = filters.getArray() + (route * numPartitions + partition) * fftSize;
+                
+                multiplyAdd (accumulatorSamples, spectrumSamples, filterSamples);
+            }
+        }
+        
+        const int ringMask = ringSize - 1;
+        const int position = ringPosition & ringMask;
+        const int numBeforeWrap = plonk::min (partitionSize, ringSize - position);
+        const int numAfterWrap = partitionSize - numBeforeWrap;
+        
+        for (i = 0; i < numOutputs; ++i)
+        {
+            SampleType* const ringSamples = ring.getArray() + i * ringSize;
+            
+            // the second half is the part of the circular convolution without wrap around
+            fft.inverse (temp.getArray(), accumulators.getArray() + i * fftSize);
+            const SampleType* const resultSamples = temp.getArray() + partitionSize;
+            
+            NumericalArrayBinaryOp<SampleType,BinaryOpFunctionsType::addop>::calcNN (ringSamples + position, ringSamples + position, 
+                                                                                     resultSamples, numBeforeWrap);
+            
+            if (numAfterWrap > 0)
+                NumericalArrayBinaryOp<SampleType,BinaryOpFunctionsType::addop>::calcNN (ringSamples, ringSamples, 
+                                                                                         resultSamples + numBeforeWrap, numAfterWrap);
+        }
+    }
+    
+    /** Complex multiply two spectra in packed format and add to the accumulator. */
+    PLONK_INLINE_LOW void multiplyAdd (SampleType* const accumulatorSamples, 
+                                       const SampleType* const leftSamples, 
+                                       const SampleType* const rightSamples) throw()
+    {
+        const int fftSize = partitionSize * 2;
+        const int halfSize = partitionSize;
+        SampleType* const tempSamples = temp.getArray();
+        
+        NumericalArrayComplex<SampleType>::zmul (tempSamples, tempSamples + halfSize,
+                                                 leftSamples, leftSamples + halfSize,
+                                                 rightSamples, rightSamples + halfSize,
+                                                 halfSize);
+        
+        // DC and Nyquist are both real and packed into the first real and imaginary slots
+        tempSamples[0] = leftSamples[0] * rightSamples[0];
+        tempSamples[halfSize] = leftSamples[halfSize] * rightSamples[halfSize];
+        
+        NumericalArrayBinaryOp<SampleType,BinaryOpFunctionsType::addop>::calcNN (accumulatorSamples, accumulatorSamples, 
+                                                                                 tempSamples, fftSize);
+    }
+};
+
+//------------------------------------------------------------------------------
+
+/** Partitioned convolution channel. */
+template<class SampleType>
+class ConvolveChannelInternal
+:   public ProxyOwnerChannelInternal<SampleType, PLONK_CHANNELDATA_NAME(ConvolveChannelInternal,SampleType)>
+{
+public:
+    typedef PLONK_CHANNELDATA_NAME(ConvolveChannelInternal,SampleType)  Data;
+    typedef ChannelBase<SampleType>                                     ChannelType;
+    typedef ObjectArray<ChannelType>                                    ChannelArrayType;
+    typedef ProxyOwnerChannelInternal<SampleType,Data>                  Internal;
+    typedef UnitBase<SampleType>                                        UnitType;
+    typedef InputDictionary                                             Inputs;
+    typedef NumericalArray<SampleType>                                  Buffer;
+    typedef SignalBase<SampleType>                                      SignalType;
+    typedef ConvolveStage<SampleType>                                   StageType;
+    typedef ObjectArray<StageType>                                      StageArray;
+    typedef typename StageType::InputArray                              InputArray;
+    
+    enum Constants
+    {
+        PartitionGrowth = 4     // each stage's partitions are this much larger than the last
+    };
+    
+    ConvolveChannelInternal (Inputs const& inputs, 
+                             Data const& data, 
+                             BlockSize const& blockSize,
+                             SampleRate const& sampleRate,
+                             ChannelArrayType& channels) throw()
+    :   Internal (data.numOutputs, inputs, data, blockSize, sampleRate, channels),
+        ringSize (0),
+        ringPosition (0),
+        latency (0)
+    {
+    }
+    
+    Text getName() const throw()
+    {
+        return "Convolve";
+    }
+    
+    IntArray getInputKeys() const throw()
+    {
+        const IntArray keys (IOKey::Generic,
+                             IOKey::Signal);
+        return keys;
+    }
+    
+    void initChannel (const int channel) throw()
+    {
+        const UnitType& input = this->getInputAsUnit (IOKey::Generic);
+        
+        if ((channel % this->getNumChannels()) == 0)
+        {
+            this->setBlockSize (BlockSize::decide (input.getBlockSize (0),
+                                                   this->getBlockSize()));
+            this->setSampleRate (SampleRate::decide (input.getSampleRate (0),
+                                                     this->getSampleRate()));
+            
+            plonk_assert (input.getOverlap (0) == Math<DoubleVariable>::get1());
+            
+            initStages();
+        }
+        
+        this->initProxyValue (channel, SampleType (0));
+    }
+    
+    /** The output ring, its position and the state of each stage follow the base state blocks. */
+    int getNumStateBlocks() const throw()
+    {
+        return Internal::getNumStateBlocks() + 2 + stages.length() * StageType::NumStateBlocks;
+    }
+    
+    void* getStateBlock (const int index, int& numBytes) throw()
+    {
+        const int blockIndex = index - Internal::getNumStateBlocks();
+        
+        if ((blockIndex < 0) || (blockIndex >= (2 + stages.length() * StageType::NumStateBlocks)))
+            return Internal::getStateBlock (index, numBytes);
+        
+        if (blockIndex == 0)
+        {
+            numBytes = ring.length() * sizeof (SampleType);
+            return ring.getArray();
+        }
+        
+        if (blockIndex == 1)
+        {
+            numBytes = sizeof (ringPosition);
+            return &ringPosition;
+        }
+        
+        const int stageBlockIndex = blockIndex - 2;
+        return stages.atUnchecked (stageBlockIndex / StageType::NumStateBlocks).getStateBlock (stageBlockIndex % StageType::NumStateBlocks, numBytes);
+    }
+    
+    void process (ProcessInfo& info, const int /*channel*/) throw()
+    {
+        UnitType& inputUnit (this->getInputAsUnit (IOKey::Generic));
+        
+        const int numInputs = inputs.length();
+        const int numOutputs = this->getNumChannels();
+        const int outputBufferLength = this->getOutputBuffer (0).length();
+        const int numStages = stages.length();
+        int i;
+        
+        for (i = 0; i < numInputs; ++i)
+        {
+            const Buffer& inputBuffer (inputUnit.process (info, i));
+            plonk_assert (inputBuffer.length() == outputBufferLength);
+            inputs.atUnchecked (i) = inputBuffer.getArray();
+        }
+        
+        for (i = 0; i < numStages; ++i)
+            stages.atUnchecked (i).process (inputs, outputBufferLength, ring, ringSize, ringPosition + latency);
+        
+        const int numBeforeWrap = plonk::min (outputBufferLength, ringSize - ringPosition);
+        const int numAfterWrap = outputBufferLength - numBeforeWrap;
+        
+        for (i = 0; i < numOutputs; ++i)
+        {
+            SampleType* const outputSamples = this->getOutputSamples (i);
+            SampleType* const ringSamples = ring.getArray() + i * ringSize;
+            
+            Buffer::copyData (outputSamples, ringSamples + ringPosition, numBeforeWrap);
+            Buffer::zeroData (ringSamples + ringPosition, numBeforeWrap);
+            
+            if (numAfterWrap > 0)
+            {
+                Buffer::copyData (outputSamples + numBeforeWrap, ringSamples, numAfterWrap);
+                Buffer::zeroData (ringSamples, numAfterWrap);
+            }
+        }
+        
+        ringPosition = (ringPosition + outputBufferLength) & (ringSize - 1);
+    }
+    
+private:
+    StageArray stages;
+    InputArray inputs;
+    Buffer ring;        // the output of all stages, ringSize for each output
+    int ringSize;
+    int ringPosition;
+    int latency;
+    
+    void initStages() throw()
+    {
+        const Data& data = this->getState();
+        const UnitType& input = this->getInputAsUnit (IOKey::Generic);
+        const SignalType& impulse (this->getInputAsSignal (IOKey::Signal));
+        
+        const int numInputs = input.getNumChannels();
+        const int numOutputs = this->getNumChannels();
+        const int numImpulseChannels = impulse.getNumChannels();
+        const int numImpulseFrames = impulse.getNumFrames();
+        const int blockSize = this->getBlockSize().getValue();
+        int i, j;
+        
+        IntArray routes;
+        
+        if (numImpulseChannels == 1)
+        {
+            for (i = 0; i < numInputs; ++i)
+                addRoute (routes, i, i, 0);
+        }
+        else if (numImpulseChannels == numInputs)
+        {
+            for (i = 0; i < numInputs; ++i)
+                addRoute (routes, i, i, i);
+        }
+        else
+        {
+            plonk_assert (numImpulseChannels == (numInputs * numOutputs));
+            
+            for (i = 0; i < numInputs; ++i)
+                for (j = 0; j < numOutputs; ++j)
+                    addRoute (routes, i, j, i * numOutputs + j);
+        }
+        
+        // partitions must be a power of 2, otherwise partitions complete part way through 
+        // a block so the output is delayed so the first partition is ready in time
+        const int firstPartitionSize = Bits::nextPowerOf2 (blockSize);
+        latency = (firstPartitionSize == blockSize) ? 0 : firstPartitionSize - 1;
+        
+        stages.clear();
+        
+        int offset = 0;
+        int partitionSize = firstPartitionSize;
+        
+        while (offset < numImpulseFrames)
+        {
+            // each stage starts at least one of its own partitions into the impulse so its output is always ready in time
+            const bool isLastStage = (partitionSize * PartitionGrowth) > data.maxPartitionSize;
+            const int numPartitionsRemaining = (numImpulseFrames - offset + partitionSize - 1) / partitionSize;
+            const int numPartitions = isLastStage ? numPartitionsRemaining : plonk::min (numPartitionsRemaining, (int)PartitionGrowth);
+            
+            StageType stage;
+            stage.init (impulse, routes, numInputs, numOutputs, offset, partitionSize, numPartitions);
+            stages.add (stage);
+            
+            offset += numPartitions * partitionSize;
+            
+            if (! isLastStage)
+                partitionSize *= PartitionGrowth;
+        }
+        
+        ringSize = Bits::nextPowerOf2 (latency + offset + partitionSize + blockSize);
+        ringPosition = 0;
+        ring = Buffer::newClear (numOutputs * ringSize);
+        inputs = InputArray::withSize (numInputs);
+    }
+    
+    static PLONK_INLINE_LOW void addRoute (IntArray& routes, const int input, const int output, const int impulseChannel) throw()
+    {
+        routes.add (input);
+        routes.add (output);
+        routes.add (impulseChannel);
+    }
+};
+
+//------------------------------------------------------------------------------
+
+/** Partitioned convolution unit.
+ Convolves the input with an impulse response using partitioned overlap-save
+ FFT convolution. This is suitable for long impulse responses (e.g., reverbs).
+ 
+ The first partitions are the block size (rounded up to a power of 2) so there 
+ is no latency when the block size is a power of 2. By default all the 
+ partitions are this size. Setting maxPartitionSize uses non-uniform partitions 
+ instead: the impulse is split into stages whose partitions grow by a factor of
+ 4 up to this size, this is much more efficient for long impulses although the 
+ larger partitions are processed in a single block so the load is less even.
+ 
+ The impulse channels determine the outputs:
+ - one channel: each input is convolved with the same impulse
+ - the same number of channels as the input: each input is convolved with its own impulse
+ - inputs x outputs channels: a matrix where impulse channel (i * numOutputs + o) is 
+   the response from input i to output o, e.g., a 4 channel "true stereo" impulse 
+   for a stereo input has LL, LR, RL, RR.
+ 
+ The impulse is used at its own sample rate without resampling.
+ 
+ @par Factory functions:
+ - ar (input, impulse, maxPartitionSize=0, preferredBlockSize=noPref, preferredSampleRate=noPref)
+ - ar (input, file, maxPartitionSize=0, preferredBlockSize=noPref, preferredSampleRate=noPref)
+ 
+ @par Inputs:
+ - input: (unit, multi) the input unit
+ - impulse: (signal) the impulse response
+ - maxPartitionSize: (int) the largest partition size for non-uniform partitions
+ - preferredBlockSize: the preferred output block size 
+ - preferredSampleRate: the preferred output sample rate
+ 
+ @ingroup ConverterUnits FFTUnits */
+template<class SampleType>
+class ConvolveUnit
+{
+public:
+    typedef ConvolveChannelInternal<SampleType>     ConvolveInternal;
+    typedef typename ConvolveInternal::Data         Data;
+    typedef UnitBase<SampleType>                    UnitType;
+    typedef InputDictionary                         Inputs;
+    typedef SignalBase<SampleType>                  SignalType;
+    
+    static PLONK_INLINE_LOW UnitInfos getInfo() throw()
+    {
+        const double blockSize = (double)BlockSize::noPreference().getValue();
+        const double sampleRate = SampleRate::noPreference().getValue();
+
+        return UnitInfo ("Convolve", "Partitioned FFT convolution.",
+                         
+                         // output
+                         ChannelCount::VariableChannelCount,
+                         IOKey::Generic,            Measure::None,      IOInfo::NoDefault,  IOLimit::None,
+                         IOKey::End,
+                         
+                         // inputs
+                         IOKey::Generic,            Measure::None,      IOInfo::NoDefault,  IOLimit::None,
+                         IOKey::Signal,             Measure::None,
+                         IOKey::BlockSize,          Measure::Samples,   blockSize,          IOLimit::Minimum,   Measure::Samples,   1.0,
+                         IOKey::SampleRate,         Measure::Hertz,     sampleRate,         IOLimit::Minimum,   Measure::Hertz,     0.0,
+                         IOKey::End);
+    }
+    
+    /** Convolve with an impulse response. */
+    static UnitType ar (UnitType const& input,
+                        SignalType const& impulse,
+                        const int maxPartitionSize = 0,
+                        BlockSize const& preferredBlockSize = BlockSize::noPreference(),
+                        SampleRate const& preferredSampleRate = SampleRate::noPreference()) throw()
+    {
+        const int numInputChannels = input.getNumChannels();
+        const int numImpulseChannels = impulse.getNumChannels();
+        
+        plonk_assert ((numImpulseChannels == 1) || 
+                      (numImpulseChannels == numInputChannels) || 
+                      ((numImpulseChannels % numInputChannels) == 0));
+        
+        const int numOutputs = ((numImpulseChannels == 1) || (numImpulseChannels == numInputChannels)) 
+                               ? numInputChannels 
+                               : numImpulseChannels / numInputChannels;
+        
+        Inputs inputs;
+        inputs.put (IOKey::Generic, input);
+        inputs.put (IOKey::Signal, impulse);
+        
+        Data data = { { -1.0, -1.0 }, numOutputs, maxPartitionSize };
+        
+        return UnitType::template proxiesFromInputs<ConvolveInternal> (inputs,
+                                                                       data,
+                                                                       preferredBlockSize,
+                                                                       preferredSampleRate);
+    }
+    
+    /** Convolve with an impulse response read from an audio file. */
+    static UnitType ar (UnitType const& input,
+                        AudioFileReader& file,
+                        const int maxPartitionSize = 0,
+                        BlockSize const& preferredBlockSize = BlockSize::noPreference(),
+                        SampleRate const& preferredSampleRate = SampleRate::noPreference()) throw()
+    {
+        SignalType impulse;
+        file.initSignal (impulse);
+        file.readSignal (impulse);
+        
+        return ar (input, impulse, maxPartitionSize, preferredBlockSize, preferredSampleRate);
+    }
+};
+
+typedef ConvolveUnit<PLONK_TYPE_DEFAULT> Convolve;
+
+#endif // PLONK_CONVOLVECHANNEL_H
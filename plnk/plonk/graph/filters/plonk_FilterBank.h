@@ -0,0 +1,501 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_FILTERBANK_H
+#define PLONK_FILTERBANK_H
+
+#include "../channel/plonk_ChannelInternalCore.h"
+#include "plonk_FilterForwardDeclarations.h"
+
+
+/** Describes a filter form as a cascade of two-pole, two-zero sections.
+ The default suits forms with coefficients in the P2Z2 order (P2Z2 itself and 
+ FilterCascadeForm). */
+template<class FormType>
+class FilterBankSections
+{
+public:
+    typedef typename FormType::SampleDataType SampleType;
+    
+    enum Constants
+    {
+        NumSectionCoeffs = 5,
+        NumSections = FormType::NumCoeffs / NumSectionCoeffs
+    };
+    
+    static PLONK_INLINE_LOW void toSection (SampleType& /*a0*/, SampleType& /*a1*/, SampleType& /*a2*/) throw()
+    {
+    }
+};
+
+template<class SampleType>
+class FilterBankSections< FilterForm<SampleType, FilterFormType::B2> >
+{
+public:
+    enum Constants
+    {
+        NumSectionCoeffs = 5,
+        NumSections = 1
+    };
+    
+    // the B2 form applies a0 after the zeros
+    static PLONK_INLINE_LOW void toSection (SampleType& a0, SampleType& a1, SampleType& a2) throw()
+    {
+        a1 *= a0;
+        a2 *= a0;
+    }
+};
+
+/** @internal */
+template<class SampleType>
+class FilterBankKernel
+{
+public:
+    static PLONK_INLINE_LOW void process (SampleType* io, SampleType* state, const SampleType* coeffs, const int coeffsStride, const int numChannels, const int numFrames) throw()
+    {
+        for (int c = 0; c < numChannels; ++c)
+        {
+            SampleType s1 = state[c];
+            SampleType s2 = state[numChannels + c];
+            SampleType* x = io + c;
+            const SampleType* k = coeffs + c;
+            
+            for (int n = 0; n < numFrames; ++n, x += numChannels, k += coeffsStride)
+            {
+                const SampleType input = *x;
+                const SampleType output = k[0] * input + s1;
+                s1 = k[numChannels] * input + k[numChannels * 3] * output + s2;
+                s2 = k[numChannels * 2] * input + k[numChannels * 4] * output;
+                *x = output;
+            }
+            
+            state[c] = s1;
+            state[numChannels + c] = s2;
+        }
+    }
+};
+
+template<>
+class FilterBankKernel<float>
+{
+public:
+    static PLONK_INLINE_LOW void process (float* io, float* state, const float* coeffs, const int coeffsStride, const int numChannels, const int numFrames) throw()
+    {
+        pl_VectorBiquadBankF (io, state, coeffs, coeffsStride, numChannels, numFrames);
+    }
+};
+
+template<>
+class FilterBankKernel<double>
+{
+public:
+    static PLONK_INLINE_LOW void process (double* io, double* state, const double* coeffs, const int coeffsStride, const int numChannels, const int numFrames) throw()
+    {
+        pl_VectorBiquadBankD (io, state, coeffs, coeffsStride, numChannels, numFrames);
+    }
+};
+
+//------------------------------------------------------------------------------
+
+/** Multichannel two-pole, two-zero filter bank. 
+ Filters all of its channels together with the samples interleaved so that the
+ recurrence runs with one channel per SIMD lane (4 or 8 float channels per 
+ register on SSE or AVX). The filters are computed in transposed direct form II.
+ The coefficients are taken from the same units as FilterUnit. */
+template<class FormType>
+class FilterBankChannelInternal
+:   public ProxyOwnerChannelInternal<typename FormType::SampleDataType, ChannelInternalCore::Data>
+{
+public:
+    typedef typename FormType::SampleDataType                       SampleType;
+    typedef ChannelInternalCore::Data                               Data;
+    typedef ChannelBase<SampleType>                                 ChannelType;
+    typedef ObjectArray<ChannelType>                                ChannelArrayType;
+    typedef FilterBankChannelInternal<FormType>                     FilterBankInternal;
+    typedef ProxyOwnerChannelInternal<SampleType,Data>              Internal;
+    typedef UnitBase<SampleType>                                    UnitType;
+    typedef InputDictionary                                         Inputs;
+    typedef NumericalArray<SampleType>                              Buffer;
+    typedef FilterBankSections<FormType>                            SectionsType;
+    
+    enum Constants
+    {
+        NumSectionCoeffs = SectionsType::NumSectionCoeffs,
+        NumSections = SectionsType::NumSections,
+        ChunkLength = 64
+    };
+        
+    FilterBankChannelInternal (Inputs const& inputs, 
+                               Data const& data, 
+                               BlockSize const& blockSize,
+                               SampleRate const& sampleRate,
+                               ChannelArrayType& channels) throw()
+    :   Internal (numChannelsFromInputs (inputs), inputs, data, blockSize, sampleRate, channels),
+        primed (false)
+    {
+        plonk_staticassert ((FormType::NumCoeffs % NumSectionCoeffs) == 0);
+        
+        state.setSize (NumSections * this->getNumChannels() * 2, false);
+        state.zero();
+        lastCoeffs.setSize (FormType::NumCoeffs * this->getNumChannels(), false);
+        lastCoeffs.zero();
+    }
+    
+    static int numChannelsFromInputs (Inputs const& inputs) throw()
+    {
+        const UnitType& input = inputs[IOKey::Generic].template asUnchecked<UnitType>();
+        const UnitType& coeffs = inputs[IOKey::Coeffs].template asUnchecked<UnitType>();
+        return plonk::max (input.getNumChannels(), coeffs.getNumChannels() / FormType::NumCoeffs);
+    }
+            
+    Text getName() const throw()
+    {
+        return "Filter Bank (" + FormType::getName() + ")";
+    }       
+    
+    IntArray getInputKeys() const throw()
+    {
+        const IntArray keys (IOKey::Generic, IOKey::Coeffs);
+        return keys;
+    }    
+    
+    void initChannel (const int channel) throw()
+    {        
+        const UnitType& inputUnit = this->getInputAsUnit (IOKey::Generic);
+        plonk_assert (inputUnit.getOverlap (channel) == Math<DoubleVariable>::get1());
+
+        if ((channel % this->getNumChannels()) == 0)
+        {
+            this->setBlockSize (BlockSize::decide (inputUnit.getBlockSize (0),
+                                                   this->getBlockSize()));
+            this->setSampleRate (SampleRate::decide (inputUnit.getSampleRate (0),
+                                                     this->getSampleRate()));
+        }
+        
+        this->initProxyValue (channel, SampleType (0));
+    }
+    
+    void process (ProcessInfo& info, const int /*channel*/) throw()
+    {
+        UnitType& inputUnit = this->getInputAsUnit (IOKey::Generic);
+        UnitType& coeffsUnit = this->getInputAsUnit (IOKey::Coeffs);
+
+        const int outputBufferLength = this->getOutputBuffer (0).length();
+        const int numChannels = this->getNumChannels();
+        const int numCoeffChannels = coeffsUnit.getNumChannels();
+        const int numCoeffGroups = numCoeffChannels / FormType::NumCoeffs;
+        const int sectionSize = numChannels * NumSectionCoeffs;
+        int channel, i;
+        
+        // fetch every input buffer once as each fetch has a cost even when cached
+        
+        if (inputBuffers.length() != numChannels)
+            inputBuffers.setSize (numChannels, false);
+        
+        if (coeffBuffers.length() != numCoeffChannels)
+            coeffBuffers.setSize (numCoeffChannels, false);
+
+        const Buffer** const inputBufferArray = inputBuffers.getArray();
+        const Buffer** const coeffBufferArray = coeffBuffers.getArray();
+        
+        for (channel = 0; channel < numChannels; ++channel)
+            inputBufferArray[channel] = &inputUnit.process (info, channel);
+        
+        // transpose the coefficients, once per block if they are a single unchanged set
+        // otherwise for every frame ramping from the previous block as FilterCoeffsRamp does
+        bool perFrame = false;
+        
+        for (i = 0; i < numCoeffChannels; ++i)
+        {
+            coeffBufferArray[i] = &coeffsUnit.process (info, i);
+            perFrame = perFrame || (coeffBufferArray[i]->length() != 1);
+        }
+        
+        if (lastCoeffs.length() != numChannels * FormType::NumCoeffs)
+        {
+            lastCoeffs.setSize (numChannels * FormType::NumCoeffs, false);
+            primed = false;
+        }
+        
+        SampleType* const lastCoeffSamples = lastCoeffs.getArray();
+
+        for (channel = 0; primed && ! perFrame && (channel < numChannels); ++channel)
+        {
+            const Buffer** const channelCoeffs = coeffBufferArray + (channel % numCoeffGroups) * FormType::NumCoeffs;
+            
+            for (i = 0; i < FormType::NumCoeffs; ++i)
+                perFrame = perFrame || (channelCoeffs[i]->atUnchecked (0) != lastCoeffSamples[channel * FormType::NumCoeffs + i]);
+        }
+        
+        const int numCoeffFrames = perFrame ? outputBufferLength : 1;
+        
+        if (coeffs.length() != numCoeffFrames * NumSections * sectionSize)
+            coeffs.setSize (numCoeffFrames * NumSections * sectionSize, false);
+        
+        SampleType* const coeffSamples = coeffs.getArray();
+        const int frameStride = NumSections * sectionSize;
+
+        for (channel = 0; channel < numChannels; ++channel)
+        {
+            const Buffer** const channelCoeffs = coeffBufferArray + (channel % numCoeffGroups) * FormType::NumCoeffs;
+            SampleType* const channelLast = lastCoeffSamples + channel * FormType::NumCoeffs;
+            
+            for (int section = 0; section < NumSections; ++section)
+            {
+                SampleType* const sectionSamples = coeffSamples + section * sectionSize + channel;
+                int k;
+                
+                for (k = 0; k < NumSectionCoeffs; ++k)
+                {
+                    const Buffer& coeffBuffer (*channelCoeffs[section * NumSectionCoeffs + k]);
+                    const SampleType* const source = coeffBuffer.getArray();
+                    const int sourceLength = coeffBuffer.length();
+                    SampleType& last = channelLast[section * NumSectionCoeffs + k];
+                    
+                    rampCoeffs (sectionSamples + k * numChannels, frameStride, numCoeffFrames,
+                                source, sourceLength, primed ? last : source[0]);
+                    
+                    last = source[sourceLength - 1];
+                }
+                
+                for (i = 0; i < numCoeffFrames; ++i)
+                {
+                    SampleType* const frameCoeffs = sectionSamples + i * frameStride;
+                    SectionsType::toSection (frameCoeffs[0], frameCoeffs[numChannels], frameCoeffs[numChannels * 2]);
+                }
+            }
+        }
+        
+        primed = true;
+        
+        // interleave, filter and deinterleave in chunks small enough to stay in the cache
+        const int coeffsStride = perFrame ? frameStride : 0;
+        const int chunkLength = plonk::min (outputBufferLength, int (ChunkLength));
+        
+        if (frames.length() != chunkLength * numChannels)
+            frames.setSize (chunkLength * numChannels, false);
+        
+        SampleType* const frameSamples = frames.getArray();
+        SampleType* const stateSamples = state.getArray();
+
+        for (int start = 0; start < outputBufferLength; start += chunkLength)
+        {
+            const int length = plonk::min (chunkLength, outputBufferLength - start);
+            
+            for (channel = 0; channel < numChannels; ++channel)
+            {
+                const Buffer& inputBuffer (*inputBufferArray[channel]);
+                const SampleType* const inputSamples = inputBuffer.getArray();
+                const int inputLength = inputBuffer.length();
+                SampleType* frame = frameSamples + channel;
+                
+                if (inputLength == outputBufferLength)
+                {
+                    for (i = 0; i < length; ++i, frame += numChannels)
+                        *frame = inputSamples[start + i];
+                }
+                else
+                {
+                    const double inputIncrement = double (inputLength) / double (outputBufferLength);
+                    double inputPosition = start * inputIncrement;
+                    
+                    for (i = 0; i < length; ++i, frame += numChannels)
+                    {
+                        *frame = inputSamples[int (inputPosition)];
+                        inputPosition += inputIncrement;
+                    }
+                }
+            }
+            
+            for (int section = 0; section < NumSections; ++section)
+                FilterBankKernel<SampleType>::process (frameSamples, 
+                                                       stateSamples + section * numChannels * 2, 
+                                                       coeffSamples + start * coeffsStride + section * sectionSize, 
+                                                       coeffsStride,
+                                                       numChannels, 
+                                                       length);
+            
+            for (channel = 0; channel < numChannels; ++channel)
+            {
+                SampleType* const outputSamples = this->getOutputSamples (channel) + start;
+                const SampleType* frame = frameSamples + channel;
+                
+                for (i = 0; i < length; ++i, frame += numChannels)
+                    outputSamples[i] = *frame;
+            }
+        }
+        
+        for (i = 0; i < state.length(); ++i)
+            stateSamples[i] = zap (stateSamples[i]);
+    }
+    
+    /** The filter state and the coefficients to ramp from follow the base state blocks. */
+    int getNumStateBlocks() const throw()
+    {
+        return Internal::getNumStateBlocks() + 3;
+    }
+    
+    void* getStateBlock (const int index, int& numBytes) throw()
+    {
+        switch (index - Internal::getNumStateBlocks())
+        {
+            case 0: numBytes = state.length() * sizeof (SampleType);        return state.getArray();
+            case 1: numBytes = lastCoeffs.length() * sizeof (SampleType);   return lastCoeffs.getArray();
+            case 2: numBytes = sizeof (primed);                             return &primed;
+            default: return Internal::getStateBlock (index, numBytes);
+        }
+    }
+    
+private:
+    /** Writes the coefficients for each frame, moving linearly from previous through each source value. */
+    static void rampCoeffs (SampleType* dest, const int destStride, const int numFrames,
+                            const SampleType* source, const int sourceLength, SampleType previous) throw()
+    {
+        int i = 0;
+        
+        for (int segment = 0, end = 0; segment < sourceLength; ++segment)
+        {
+            const int start = i;
+            end = ((segment + 1) * numFrames) / sourceLength;
+            
+            const SampleType target = source[segment];
+            const SampleType scale = end > start ? SampleType (1) / SampleType (end - start) : SampleType (0);
+            
+            for (; i < end; ++i, dest += destStride)
+                *dest = previous + (target - previous) * (SampleType (i - start + 1) * scale);
+            
+            previous = target;
+        }
+    }
+    
+    ObjectArray<const Buffer*> inputBuffers;
+    ObjectArray<const Buffer*> coeffBuffers;
+    Buffer frames;
+    Buffer coeffs;
+    Buffer lastCoeffs;
+    Buffer state;
+    bool primed;
+};
+
+//------------------------------------------------------------------------------
+
+/** A bank of IIR filters processed across channels. 
+ A drop in replacement for FilterUnit for the two-pole, two-zero forms (P2Z2, 
+ B2 and FilterCascadeForm) that is much faster when there are many channels. 
+ The channels are processed together, interleaved so that each channel is a 
+ lane of a SIMD register. The coefficients are from the same units as for 
+ FilterUnit, e.g., FilterCoeffs2ParamUnit for the shapes in FilterShapesP2Z2. 
+ 
+ @par Factory functions:
+ - ar (input, coeffs, mul=1, add=0, preferredBlockSize=noPreference, preferredSampleRate=noPreference)
+ 
+ @par Inputs:
+ - input: (unit, multi) the unit to filter
+ - coeffs: (unit, multi) the filter coefficients, FormType::NumCoeffs channels for each filter
+ - mul: (unit, multi) the multiplier applied to the output
+ - add: (unit, multi) the offset added to the output
+ - preferredBlockSize: the preferred output block size (for advanced usage, leave on default if unsure)
+ - preferredSampleRate: the preferred output sample rate (for advanced usage, leave on default if unsure)
+
+ @see FilterUnit
+ @ingroup FilterUnits */
+template<class FormType>
+class FilterBankUnit
+{
+public:    
+    typedef typename FormType::SampleDataType       SampleType;
+    typedef FilterBankChannelInternal<FormType>     FilterBankInternal;
+    typedef typename FilterBankInternal::Data       Data;
+    typedef ChannelBase<SampleType>                 ChannelType;
+    typedef UnitBase<SampleType>                    UnitType;
+    typedef InputDictionary                         Inputs;
+    
+    static PLONK_INLINE_LOW UnitInfos getInfo() throw()
+    {
+        const double blockSize = (double)BlockSize::noPreference().getValue();
+        const double sampleRate = SampleRate::noPreference().getValue();
+        
+        return UnitInfo ("FilterBank", "A bank of IIR filters processed across channels.",
+                         
+                         // output
+                         ChannelCount::VariableChannelCount, 
+                         IOKey::Generic,    Measure::None,      0.0,                IOLimit::None,
+                         IOKey::End,
+                         
+                         // inputs
+                         IOKey::Generic,    Measure::None,      IOInfo::NoDefault,  IOLimit::None,
+                         IOKey::Coeffs,     Measure::Coeffs,    IOInfo::NoDefault,  IOLimit::None,
+                         IOKey::Multiply,   Measure::Factor,    1.0,                IOLimit::None,
+                         IOKey::Add,        Measure::None,      0.0,                IOLimit::None,
+                         IOKey::BlockSize,  Measure::Samples,   blockSize,          IOLimit::Minimum,   Measure::Samples,           1.0,
+                         IOKey::SampleRate, Measure::Hertz,     sampleRate,         IOLimit::Minimum,   Measure::Hertz,             0.0,
+                         IOKey::End);
+    }
+                
+    /** Create a filter bank from the coefficients. */
+    static UnitType ar (UnitType const& input,
+                        UnitType const& coeffs, 
+                        UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0),
+                        BlockSize const& preferredBlockSize = BlockSize::noPreference(),
+                        SampleRate const& preferredSampleRate = SampleRate::noPreference()) throw()
+    {             
+        plonk_assert (coeffs.getNumChannels() > 0);
+        plonk_assert ((coeffs.getNumChannels() % FormType::NumCoeffs) == 0);
+        
+        Inputs inputs;
+        inputs.put (IOKey::Generic, input);
+        inputs.put (IOKey::Coeffs, coeffs);
+        inputs.put (IOKey::Multiply, mul);
+        inputs.put (IOKey::Add, add);
+        
+        Data data;
+        Memory::zero (data);
+        data.sampleRate = -1.0;        
+        data.sampleDuration = -1.0;
+        
+        return UnitType::template proxiesFromInputs<FilterBankInternal> (inputs, 
+                                                                         data, 
+                                                                         preferredBlockSize, 
+                                                                         preferredSampleRate);
+    }
+};
+
+typedef FilterBankUnit<FilterFormP2Z2> FilterBankP2Z2;
+
+#endif // PLONK_FILTERBANK_H
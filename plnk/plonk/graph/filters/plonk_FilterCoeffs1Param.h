@@ -112,7 +112,7 @@ public:
             Data& data = this->getState();
             data.params[0] = param0Unit.getValue (0);
             
-            ShapeType::calculate (data);
+            cache.calculate (data);
             
             for (int i = 0; i < FormType::NumCoeffs; ++i)
                 this->initProxyValue (i, data.coeffs[i]);            
@@ -157,13 +157,15 @@ public:
         const SampleType* const param0Samples = param0Buffer.getArray();
         const int param0Length = param0Buffer.length();
         
+        cache.setBypassed (param0Length > 1);
+        
         if (outputLength == param0Length)
         {
             for (i = 0; i < outputLength; ++i)
             {
                 data.params[0] = param0Samples[i];
                 
-                ShapeType::calculate (data);
+                cache.calculate (data);
                 
                 for (j = 0; j < FormType::NumCoeffs; ++j)
                     this->getOutputSamples (j) [i] = data.coeffs[j];
@@ -173,7 +175,7 @@ public:
         {
             data.params[0] = param0Samples[0];
 
-            ShapeType::calculate (data);
+            cache.calculate (data);
 
             for (j = 0; j < FormType::NumCoeffs; ++j)
             {
@@ -193,7 +195,7 @@ public:
             {
                 data.params[0] = param0Samples[int (param0Position)];
                 
-                ShapeType::calculate (data);
+                cache.calculate (data);
                 
                 for (j = 0; j < FormType::NumCoeffs; ++j)
                     this->getOutputSamples (j) [i] = data.coeffs[j];
@@ -205,6 +207,7 @@ public:
     
 private:
     IntArray inputKeys;
+    FilterCoeffsCache<ShapeType> cache;
 };
 
 
@@ -116,7 +116,7 @@ public:
             data.params[0] = param0Unit.getValue (0);
             data.params[1] = param1Unit.getValue (0);
             
-            ShapeType::calculate (data);
+            cache.calculate (data);
             
             for (int i = 0; i < FormType::NumCoeffs; ++i)
                 this->initProxyValue (i, data.coeffs[i]);            
@@ -163,6 +163,8 @@ public:
         const int param0BufferLength = param0Buffer.length();
         const int param1BufferLength = param1Buffer.length();
         
+        cache.setBypassed ((param0BufferLength > 1) || (param1BufferLength > 1));
+        
         if (outputBufferLength == param0BufferLength)
         {
             if (outputBufferLength == param1BufferLength)
@@ -173,7 +175,7 @@ public:
                     data.params[0] = param0Samples[i];
                     data.params[1] = param1Samples[i];
                     
-                    ShapeType::calculate (data);
+                    cache.calculate (data);
                     
                     for (j = 0; j < FormType::NumCoeffs; ++j)
                         this->getOutputSamples (j) [i] = data.coeffs[j];
@@ -188,7 +190,7 @@ public:
                 {
                     data.params[0] = param0Samples[i];
                     
-                    ShapeType::calculate (data);
+                    cache.calculate (data);
                     
                     for (j = 0; j < FormType::NumCoeffs; ++j)
                         this->getOutputSamples (j) [i] = data.coeffs[j];
@@ -206,7 +208,7 @@ public:
             {
                 data.params[1] = param1Samples[i];
                 
-                ShapeType::calculate (data);
+                cache.calculate (data);
                 
                 for (j = 0; j < FormType::NumCoeffs; ++j)
                     this->getOutputSamples (j) [i] = data.coeffs[j];
@@ -219,7 +221,7 @@ public:
             data.params[0] = param0Samples[0];
             data.params[1] = param1Samples[0];
             
-            ShapeType::calculate (data);
+            cache.calculate (data);
 
             for (i = 0; i < outputBufferLength; ++i)
             {
@@ -244,7 +246,7 @@ public:
                 data.params[0] = param0Samples[int (param0Position)];
                 data.params[1] = param1Samples[int (param1Position)];
                 
-                ShapeType::calculate (data);
+                cache.calculate (data);
                 
                 for (j = 0; j < FormType::NumCoeffs; ++j)
                     this->getOutputSamples (j) [i] = data.coeffs[j];
@@ -257,6 +259,7 @@ public:
     
 private:
     IntArray inputKeys;
+    FilterCoeffsCache<ShapeType> cache;
 };
 
 
@@ -119,7 +119,7 @@ public:
             data.params[1] = param1Unit.getValue (0);
             data.params[2] = param2Unit.getValue (0);
             
-            ShapeType::calculate (data);
+            cache.calculate (data);
             
             for (int i = 0; i < FormType::NumCoeffs; ++i)
                 this->initProxyValue (i, data.coeffs[i]);            
@@ -171,6 +171,8 @@ public:
         const int param1BufferLength = param1Buffer.length();
         const int param2BufferLength = param2Buffer.length();
         
+        cache.setBypassed ((param0BufferLength > 1) || (param1BufferLength > 1) || (param2BufferLength > 1));
+        
         if (outputBufferLength == param0BufferLength)
         {
             if ((outputBufferLength == param1BufferLength) &&
@@ -183,7 +185,7 @@ public:
                     data.params[1] = param1Samples[i];
                     data.params[2] = param2Samples[i];
                     
-                    ShapeType::calculate (data);
+                    cache.calculate (data);
                     
                     for (j = 0; j < FormType::NumCoeffs; ++j)
                         this->getOutputSamples (j) [i] = data.coeffs[j];
@@ -201,7 +203,7 @@ public:
                         data.params[0] = param0Samples[i];
                         data.params[2] = param2Samples[i];
                         
-                        ShapeType::calculate (data);
+                        cache.calculate (data);
                         
                         for (j = 0; j < FormType::NumCoeffs; ++j)
                             this->getOutputSamples (j) [i] = data.coeffs[j];
@@ -217,7 +219,7 @@ public:
                     {
                         data.params[0] = param0Samples[i];
                         
-                        ShapeType::calculate (data);
+                        cache.calculate (data);
                         
                         for (j = 0; j < FormType::NumCoeffs; ++j)
                             this->getOutputSamples (j) [i] = data.coeffs[j];
@@ -237,7 +239,7 @@ public:
                         data.params[0] = param0Samples[i];
                         data.params[1] = param1Samples[i];
                         
-                        ShapeType::calculate (data);
+                        cache.calculate (data);
                         
                         for (j = 0; j < FormType::NumCoeffs; ++j)
                             this->getOutputSamples (j) [i] = data.coeffs[j];
@@ -260,7 +262,7 @@ public:
                     data.params[1] = param1Samples[i];
                     data.params[2] = param2Samples[i];
                     
-                    ShapeType::calculate (data);
+                    cache.calculate (data);
                     
                     for (j = 0; j < FormType::NumCoeffs; ++j)
                         this->getOutputSamples (j) [i] = data.coeffs[j];
@@ -278,7 +280,7 @@ public:
                     {
                         data.params[2] = param2Samples[i];
                         
-                        ShapeType::calculate (data);
+                        cache.calculate (data);
                         
                         for (j = 0; j < FormType::NumCoeffs; ++j)
                             this->getOutputSamples (j) [i] = data.coeffs[j];
@@ -291,7 +293,7 @@ public:
                     data.params[1] = param1Samples[0];
                     data.params[2] = param2Samples[0];
                     
-                    ShapeType::calculate (data);
+                    cache.calculate (data);
 
                     for (i = 0; i < outputBufferLength; ++i)
                     {
@@ -313,7 +315,7 @@ public:
                     {
                         data.params[1] = param1Samples[i];
                         
-                        ShapeType::calculate (data);
+                        cache.calculate (data);
                         
                         for (j = 0; j < FormType::NumCoeffs; ++j)
                             this->getOutputSamples (j) [i] = data.coeffs[j];
@@ -342,7 +344,7 @@ public:
                 data.params[1] = param1Samples[int (param1Position)];
                 data.params[2] = param2Samples[int (param2Position)];
                 
-                ShapeType::calculate (data);
+                cache.calculate (data);
                 
                 for (j = 0; j < FormType::NumCoeffs; ++j)
                     this->getOutputSamples (j) [i] = data.coeffs[j];
@@ -356,6 +358,7 @@ public:
     
 private:
     IntArray inputKeys;
+    FilterCoeffsCache<ShapeType> cache;
 };
 
 
@@ -41,12 +41,106 @@
 
 #include "plonk_FilterForwardDeclarations.h"
 
+/** Ramps filter coefficients linearly through a block.
+ When the coefficients arrive in a shorter buffer than the output (e.g., from
+ control rate parameters) the forms move linearly from the coefficients at the
+ end of the previous block through each of the new values. This avoids the 
+ steps in the output that switching coefficients at the block boundary would 
+ cause without the need for resampling the coefficients to the output rate. 
+ 
+ This is the interpolation the filter shortcuts get with Interp::Linear. With 
+ the other Interp modes they resample changing coefficients to the output rate 
+ first, so the forms use those directly and only keep the ramp at the last 
+ coefficients used, ready for the coefficients' rate changing. */
+template<class SampleType, int MaxCoeffs>
+struct FilterCoeffsRamp
+{
+    SampleType values[MaxCoeffs];
+    SampleType targets[MaxCoeffs];
+    SampleType increments[MaxCoeffs];
+    int primed;
+    
+    /** Returns true if the coefficients are a single, unchanged set. */
+    PLONK_INLINE_LOW bool isSteady (const SampleType* const* sources, const int numCoeffs, const int sourceLength) const throw()
+    {
+        if ((sourceLength != 1) || ! primed)
+            return false;
+        
+        for (int i = 0; i < numCoeffs; ++i)
+            if (values[i] != sources[i][0])
+                return false;
+        
+        return true;
+    }
+    
+    /** Sets the ramp towards the coefficients at @e index in the sources. 
+     Returns the number of output samples over which to ramp. The very first 
+     coefficients are used directly rather than ramping from zero. */
+    PLONK_INLINE_LOW int segment (const SampleType* const* sources, const int numCoeffs, 
+                                  const int sourceLength, const int outputLength, const int index) throw()
+    {
+        const int length = ((index + 1) * outputLength) / sourceLength - (index * outputLength) / sourceLength;
+        int i;
+        
+        if (! primed)
+        {
+            for (i = 0; i < numCoeffs; ++i)
+            {
+                values[i] = targets[i] = sources[i][index];
+                increments[i] = SampleType (0);
+            }
+            
+            primed = true;
+        }
+        else
+        {
+            const SampleType scale = length > 0 ? SampleType (1) / SampleType (length) : SampleType (0);
+            
+            for (i = 0; i < numCoeffs; ++i)
+            {
+                values[i] = targets[i];
+                targets[i] = sources[i][index];
+                increments[i] = (targets[i] - values[i]) * scale;
+            }
+        }
+        
+        return length;
+    }
+    
+    /** Moves straight to the coefficients at @e index in the sources.
+     For blocks where the coefficients were used without ramping. */
+    PLONK_INLINE_LOW void jump (const SampleType* const* sources, const int numCoeffs, const int index) throw()
+    {
+        for (int i = 0; i < numCoeffs; ++i)
+        {
+            values[i] = targets[i] = sources[i][index];
+            increments[i] = SampleType (0);
+        }
+        
+        primed = true;
+    }
+    
+    PLONK_INLINE_LOW void step (const int numCoeffs) throw()
+    {
+        for (int i = 0; i < numCoeffs; ++i)
+            values[i] += increments[i];
+    }
+    
+    /** Settles on the targets exactly, rather than with the rounding of the steps. */
+    PLONK_INLINE_LOW void finish (const int numCoeffs) throw()
+    {
+        for (int i = 0; i < numCoeffs; ++i)
+            values[i] = targets[i];
+    }
+};
+
 template<class SampleType, signed Form>
 struct FilterData
 {    
     ChannelInternalCore::Data base;
     
     SampleType y1;
+    FilterCoeffsRamp<SampleType,3> ramp;
 };      
 
 template<class SampleType>
@@ -55,6 +149,7 @@ struct FilterData<SampleType, FilterFormType::P2Z2>
     ChannelInternalCore::Data base;
     
     SampleType y1, y2;
+    FilterCoeffsRamp<SampleType,5> ramp;
 };      
 
 template<class SampleType>
@@ -63,6 +158,7 @@ struct FilterData<SampleType, FilterFormType::B2>
     ChannelInternalCore::Data base;
     
     SampleType y1, y2;
+    FilterCoeffsRamp<SampleType,5> ramp;
 };      
 
 template<class SampleType>
@@ -71,6 +167,7 @@ struct FilterData<SampleType, FilterFormType::P1b>
     ChannelInternalCore::Data base;
     
     SampleType y1, x1;
+    FilterCoeffsRamp<SampleType,1> ramp;
 };
 
 
@@ -165,8 +262,9 @@ public:
         plonk_assert ((a0Length == a1Buffer.length()) &&
                      (a0Length == b1Buffer.length()));  // coeff buffers need to be the same length
         
+        const SampleType* const coeffSamples[NumCoeffs] = { a0Samples, a1Samples, b1Samples };
         SampleType y1 = data.y1;
-        int i;
+        int i = 0;
         
         if (inputLength == outputLength)
         {
@@ -176,31 +274,35 @@ public:
                     outputSamples[i] = process (inputSamples[i], 
                                                 a0Samples[i], a1Samples[i], b1Samples[i], 
                                                 y1);
+                
+                data.ramp.jump (coeffSamples, NumCoeffs, a0Length - 1);
             }
-            else if (a0Length == 1)
+            else if (data.ramp.isSteady (coeffSamples, NumCoeffs, a0Length))
             {
                 const SampleType a0 = a0Samples[0];
                 const SampleType a1 = a1Samples[0];
                 const SampleType b1 = b1Samples[0];
                 
                 for (i = 0; i < outputLength; ++i)
-                    for (i = 0; i < outputLength; ++i)
-                        outputSamples[i] = process (inputSamples[i], 
-                                                    a0, a1, b1, y1);
+                    outputSamples[i] = process (inputSamples[i], 
+                                                a0, a1, b1, y1);
             }
             else
             {
-                double coeffPosition = 0.0;
-                const double coeffIncrement = double (a0Length) / double (outputLength);
+                const SampleType* const coeffs = data.ramp.values;
                 
-                for (i = 0; i < outputLength; ++i)
+                for (int segment = 0, end = 0; segment < a0Length; ++segment)
                 {
-                    const int pos (coeffPosition);
-                    outputSamples[i] = process (inputSamples[i], 
-                                                a0Samples[pos], a1Samples[pos], b1Samples[pos], 
-                                                y1);
-                    coeffPosition += coeffIncrement;
+                    for (end += data.ramp.segment (coeffSamples, NumCoeffs, a0Length, outputLength, segment); i < end; ++i)
+                    {
+                        data.ramp.step (NumCoeffs);
+                        outputSamples[i] = process (inputSamples[i], 
+                                                    coeffs[CoeffA0], coeffs[CoeffA1], coeffs[CoeffB1], 
+                                                    y1);
+                    }
                 }
+                
+                data.ramp.finish (NumCoeffs);
             }
         }
         else
@@ -209,6 +311,8 @@ public:
             const SampleType a1 = a1Samples[0];
             const SampleType b1 = b1Samples[0];
             
+            data.ramp.jump (coeffSamples, NumCoeffs, 0);
+            
             double inputPosition = 0.0;
             const double inputIncrement = double (inputLength) / double (outputLength);
             
@@ -277,8 +381,9 @@ public:
         const int b1Length = b1Buffer.length();
         const int inputLength = inputBuffer.length();
                 
+        const SampleType* const coeffSamples[NumCoeffs] = { b1Samples };
         SampleType y1 = data.y1;
-        int i;
+        int i = 0;
         
         if (inputLength == outputLength)
         {
@@ -286,8 +391,10 @@ public:
             {
                 for (i = 0; i < outputLength; ++i)
                     outputSamples[i] = process (inputSamples[i], b1Samples[i], y1);
+                
+                data.ramp.jump (coeffSamples, NumCoeffs, b1Length - 1);
             }
-            else if (b1Length == 1)
+            else if (data.ramp.isSteady (coeffSamples, NumCoeffs, b1Length))
             {
                 const SampleType b1 = b1Samples[0];
                 
@@ -296,20 +403,26 @@ public:
             }
             else
             {
-                double coeffPosition = 0.0;
-                const double coeffIncrement = double (b1Length) / double (outputLength);
+                const SampleType* const coeffs = data.ramp.values;
                 
-                for (i = 0; i < outputLength; ++i)
+                for (int segment = 0, end = 0; segment < b1Length; ++segment)
                 {
-                    outputSamples[i] = process (inputSamples[i], b1Samples[int (coeffPosition)], y1);
-                    coeffPosition += coeffIncrement;
+                    for (end += data.ramp.segment (coeffSamples, NumCoeffs, b1Length, outputLength, segment); i < end; ++i)
+                    {
+                        data.ramp.step (NumCoeffs);
+                        outputSamples[i] = process (inputSamples[i], coeffs[CoeffB1], y1);
+                    }
                 }
+                
+                data.ramp.finish (NumCoeffs);
             }
         }
         else
         {
             const SampleType b1 = b1Samples[0];
             
+            data.ramp.jump (coeffSamples, NumCoeffs, 0);
+            
             double inputPosition = 0.0;
             const double inputIncrement = double (inputLength) / double (outputLength);
             
@@ -378,9 +491,10 @@ public:
         const int b1Length = b1Buffer.length();
         const int inputLength = inputBuffer.length();
         
+        const SampleType* const coeffSamples[NumCoeffs] = { b1Samples };
         SampleType y1 = data.y1;
         SampleType x1 = data.x1;
-        int i;
+        int i = 0;
         
         if (inputLength == outputLength)
         {
@@ -388,8 +502,10 @@ public:
             {
                 for (i = 0; i < outputLength; ++i)
                     outputSamples[i] = process (inputSamples[i], b1Samples[i], y1, x1);
+                
+                data.ramp.jump (coeffSamples, NumCoeffs, b1Length - 1);
             }
-            else if (b1Length == 1)
+            else if (data.ramp.isSteady (coeffSamples, NumCoeffs, b1Length))
             {
                 const SampleType b1 = b1Samples[0];
                 
@@ -398,20 +514,26 @@ public:
             }
             else
             {
-                double coeffPosition = 0.0;
-                const double coeffIncrement = double (b1Length) / double (outputLength);
+                const SampleType* const coeffs = data.ramp.values;
                 
-                for (i = 0; i < outputLength; ++i)
+                for (int segment = 0, end = 0; segment < b1Length; ++segment)
                 {
-                    outputSamples[i] = process(inputSamples[i], b1Samples[int (coeffPosition)], y1, x1);
-                    coeffPosition += coeffIncrement;
+                    for (end += data.ramp.segment (coeffSamples, NumCoeffs, b1Length, outputLength, segment); i < end; ++i)
+                    {
+                        data.ramp.step (NumCoeffs);
+                        outputSamples[i] = process (inputSamples[i], coeffs[CoeffB1], y1, x1);
+                    }
                 }
+                
+                data.ramp.finish (NumCoeffs);
             }
         }
         else
         {
             const SampleType b1 = b1Samples[0];
             
+            data.ramp.jump (coeffSamples, NumCoeffs, 0);
+            
             double inputPosition = 0.0;
             const double inputIncrement = double (inputLength) / double (outputLength);
             
@@ -492,8 +614,9 @@ public:
         
         plonk_assert (b1uLength == b1dBuffer.length());
                       
+        const SampleType* const coeffSamples[NumCoeffs] = { b1uSamples, b1dSamples };
         SampleType y1 = data.y1;
-        int i;
+        int i = 0;
         
         if (inputLength == outputLength)
         {
@@ -501,8 +624,10 @@ public:
             {
                 for (i = 0; i < outputLength; ++i)
                     outputSamples[i] = process (inputSamples[i], b1uSamples[i], b1dSamples[i], y1);
+                
+                data.ramp.jump (coeffSamples, NumCoeffs, b1uLength - 1);
             }
-            else if (b1uLength == 1)
+            else if (data.ramp.isSteady (coeffSamples, NumCoeffs, b1uLength))
             {
                 const SampleType b1u = b1uSamples[0];
                 const SampleType b1d = b1dSamples[0];
@@ -512,14 +637,18 @@ public:
             }
             else
             {
-                double coeffPosition = 0.0;
-                const double coeffIncrement = double (b1uLength) / double (outputLength);
+                const SampleType* const coeffs = data.ramp.values;
                 
-                for (i = 0; i < outputLength; ++i)
+                for (int segment = 0, end = 0; segment < b1uLength; ++segment)
                 {
-                    outputSamples[i] = process (inputSamples[i], b1uSamples[int (coeffPosition)], b1dSamples[int (coeffPosition)], y1);
-                    coeffPosition += coeffIncrement;
+                    for (end += data.ramp.segment (coeffSamples, NumCoeffs, b1uLength, outputLength, segment); i < end; ++i)
+                    {
+                        data.ramp.step (NumCoeffs);
+                        outputSamples[i] = process (inputSamples[i], coeffs[CoeffB1u], coeffs[CoeffB1d], y1);
+                    }
                 }
+                
+                data.ramp.finish (NumCoeffs);
             }
         }
         else
@@ -527,6 +656,8 @@ public:
             const SampleType b1u = b1uSamples[0];
             const SampleType b1d = b1dSamples[0];
             
+            data.ramp.jump (coeffSamples, NumCoeffs, 0);
+            
             double inputPosition = 0.0;
             const double inputIncrement = double (inputLength) / double (outputLength);
             
@@ -631,9 +762,10 @@ public:
                      (a0Length == b1Buffer.length()) &&
                      (a0Length == b2Buffer.length()));;  // coeff buffers need to be the same length
         
+        const SampleType* const coeffSamples[NumCoeffs] = { a0Samples, a1Samples, a2Samples, b1Samples, b2Samples };
         SampleType y1 = data.y1;
         SampleType y2 = data.y2;
-        int i;
+        int i = 0;
         
         if (inputLength == outputLength)
         {
@@ -644,8 +776,10 @@ public:
                                                 a0Samples[i], a1Samples[i], a2Samples[i], 
                                                 b1Samples[i], b2Samples[i], 
                                                 y1, y2);
+                
+                data.ramp.jump (coeffSamples, NumCoeffs, a0Length - 1);
             }
-            else if (a0Length == 1)
+            else if (data.ramp.isSteady (coeffSamples, NumCoeffs, a0Length))
             {
                 const SampleType a0 = a0Samples[0];
                 const SampleType a1 = a1Samples[0];
@@ -661,18 +795,21 @@ public:
             }
             else
             {
-                double coeffPosition = 0.0;
-                const double coeffIncrement = double (a0Length) / double (outputLength);
+                const SampleType* const coeffs = data.ramp.values;
                 
-                for (i = 0; i < outputLength; ++i)
+                for (int segment = 0, end = 0; segment < a0Length; ++segment)
                 {
-                    const int pos (coeffPosition);
-                    outputSamples[i] = process (inputSamples[i], 
-                                                a0Samples[pos], a1Samples[pos], a2Samples[pos], 
-                                                b1Samples[pos], b2Samples[pos], 
-                                                y1, y2);
-                    coeffPosition += coeffIncrement;
+                    for (end += data.ramp.segment (coeffSamples, NumCoeffs, a0Length, outputLength, segment); i < end; ++i)
+                    {
+                        data.ramp.step (NumCoeffs);
+                        outputSamples[i] = process (inputSamples[i], 
+                                                    coeffs[CoeffA0], coeffs[CoeffA1], coeffs[CoeffA2], 
+                                                    coeffs[CoeffB1], coeffs[CoeffB2], 
+                                                    y1, y2);
+                    }
                 }
+                
+                data.ramp.finish (NumCoeffs);
             }
         }
         else
@@ -683,6 +820,8 @@ public:
             const SampleType b1 = b1Samples[0];
             const SampleType b2 = b2Samples[0];
             
+            data.ramp.jump (coeffSamples, NumCoeffs, 0);
+            
             double inputPosition = 0.0;
             const double inputIncrement = double (inputLength) / double (outputLength);
             
@@ -791,9 +930,10 @@ public:
                      (a0Length == b1Buffer.length()) &&
                      (a0Length == b2Buffer.length()));;  // coeff buffers need to be the same length
         
+        const SampleType* const coeffSamples[NumCoeffs] = { a0Samples, a1Samples, a2Samples, b1Samples, b2Samples };
         SampleType y1 = data.y1;
         SampleType y2 = data.y2;
-        int i;
+        int i = 0;
         
         if (inputLength == outputLength)
         {
@@ -804,8 +944,10 @@ public:
                                                 a0Samples[i], a1Samples[i], a2Samples[i], 
                                                 b1Samples[i], b2Samples[i], 
                                                 y1, y2);
+                
+                data.ramp.jump (coeffSamples, NumCoeffs, a0Length - 1);
             }
-            else if (a0Length == 1)
+            else if (data.ramp.isSteady (coeffSamples, NumCoeffs, a0Length))
             {
                 const SampleType a0 = a0Samples[0];
                 const SampleType a1 = a1Samples[0];
@@ -821,18 +963,21 @@ public:
             }
             else
             {
-                double coeffPosition = 0.0;
-                const double coeffIncrement = double (a0Length) / double (outputLength);
+                const SampleType* const coeffs = data.ramp.values;
                 
-                for (i = 0; i < outputLength; ++i)
+                for (int segment = 0, end = 0; segment < a0Length; ++segment)
                 {
-                    const int pos (coeffPosition);
-                    outputSamples[i] = process (inputSamples[i], 
-                                                a0Samples[pos], a1Samples[pos], a2Samples[pos], 
-                                                b1Samples[pos], b2Samples[pos], 
-                                                y1, y2);
-                    coeffPosition += coeffIncrement;
+                    for (end += data.ramp.segment (coeffSamples, NumCoeffs, a0Length, outputLength, segment); i < end; ++i)
+                    {
+                        data.ramp.step (NumCoeffs);
+                        outputSamples[i] = process (inputSamples[i], 
+                                                    coeffs[CoeffA0], coeffs[CoeffA1], coeffs[CoeffA2], 
+                                                    coeffs[CoeffB1], coeffs[CoeffB2], 
+                                                    y1, y2);
+                    }
                 }
+                
+                data.ramp.finish (NumCoeffs);
             }
         }
         else
@@ -843,6 +988,8 @@ public:
             const SampleType b1 = b1Samples[0];
             const SampleType b2 = b2Samples[0];
             
+            data.ramp.jump (coeffSamples, NumCoeffs, 0);
+            
             double inputPosition = 0.0;
             const double inputIncrement = double (inputLength) / double (outputLength);
             
@@ -861,6 +1008,170 @@ public:
     }
 };
 
+//------------------------------------------------------------------------------
+
+template<class SampleType, int NumSections>
+struct FilterCascadeData
+{
+    ChannelInternalCore::Data base;
+    
+    SampleType s1[NumSections];
+    SampleType s2[NumSections];
+    FilterCoeffsRamp<SampleType,5> ramps[NumSections];
+};
+
+/** Cascade of two-pole, two-zero sections. 
+ Transposed Direct Form II implementation, this keeps its accuracy better than
+ the Direct Form II of P2Z2 for the higher-order filters made by chaining 
+ sections. Each section takes coefficients in the same order as the P2Z2 form.
+ The coefficient channels are grouped by input channel then by section, i.e.,
+ channel (NumCoeffs * channel + NumSectionCoeffs * section + coeff). For a single
+ channel input the outputs of NumSections coefficient units can simply be 
+ joined, for multichannel input their channels must be interleaved in groups 
+ of NumSectionCoeffs to match. */
+template<class SampleType, int NumSections>
+class FilterCascadeForm 
+:   public FilterFormBase<SampleType, FilterFormType::P2Z2Cascade>
+{
+public:
+    typedef SampleType                                          SampleDataType;
+    typedef UnitBase<SampleType>                                UnitType;
+    typedef NumericalArray<SampleType>                          Buffer;
+    typedef FilterCascadeData<SampleType, NumSections>          Data;
+    
+    enum Coeffs
+    {
+        CoeffA0, 
+        CoeffA1, 
+        CoeffA2, 
+        CoeffB1, 
+        CoeffB2, 
+        NumSectionCoeffs,
+        NumCoeffs = NumSectionCoeffs * NumSections
+    };
+    
+    static PLONK_INLINE_LOW SampleType process (SampleType const& input,
+                                                SampleType const& a0,     
+                                                SampleType const& a1,
+                                                SampleType const& a2,
+                                                SampleType const& b1,
+                                                SampleType const& b2,
+                                                SampleType& s1,
+                                                SampleType& s2) throw()
+    {
+        const SampleType output = a0 * input + s1;
+        s1 = a1 * input + b1 * output + s2;
+        s2 = a2 * input + b2 * output;
+        return output;
+    }
+    
+    static void process (SampleType* const outputSamples,
+                         const int outputLength,
+                         UnitType& inputUnit, 
+                         UnitType& coeffsUnit, 
+                         Data& data,
+                         ProcessInfo& info, 
+                         const int channel) throw()
+    {
+        const Buffer& inputBuffer (inputUnit.process (info, channel));
+        const SampleType* const inputSamples = inputBuffer.getArray();
+        const int inputLength = inputBuffer.length();
+        int i;
+
+        if (inputLength == outputLength)
+        {
+            Buffer::copyData (outputSamples, inputSamples, outputLength);
+        }
+        else
+        {
+            double inputPosition = 0.0;
+            const double inputIncrement = double (inputLength) / double (outputLength);
+            
+            for (i = 0; i < outputLength; ++i)
+            {
+                outputSamples[i] = inputSamples[int (inputPosition)];
+                inputPosition += inputIncrement;
+            }
+        }
+        
+        // each section filters the whole block in place
+        for (int section = 0; section < NumSections; ++section)
+        {
+            const int firstCoeff = NumCoeffs * channel + NumSectionCoeffs * section;
+
+            const Buffer& a0Buffer (coeffsUnit.process (info, firstCoeff + CoeffA0));
+            const Buffer& a1Buffer (coeffsUnit.process (info, firstCoeff + CoeffA1));
+            const Buffer& a2Buffer (coeffsUnit.process (info, firstCoeff + CoeffA2));
+            const Buffer& b1Buffer (coeffsUnit.process (info, firstCoeff + CoeffB1));
+            const Buffer& b2Buffer (coeffsUnit.process (info, firstCoeff + CoeffB2));
+            
+            const SampleType* const a0Samples = a0Buffer.getArray();
+            const SampleType* const a1Samples = a1Buffer.getArray();
+            const SampleType* const a2Samples = a2Buffer.getArray();
+            const SampleType* const b1Samples = b1Buffer.getArray();
+            const SampleType* const b2Samples = b2Buffer.getArray();
+            
+            const int a0Length = a0Buffer.length();
+            
+            plonk_assert ((a0Length == a1Buffer.length()) &&
+                          (a0Length == a2Buffer.length()) &&
+                          (a0Length == b1Buffer.length()) &&
+                          (a0Length == b2Buffer.length()));  // coeff buffers need to be the same length
+            
+            const SampleType* const coeffSamples[NumSectionCoeffs] = { a0Samples, a1Samples, a2Samples, b1Samples, b2Samples };
+            FilterCoeffsRamp<SampleType,NumSectionCoeffs>& ramp = data.ramps[section];
+            SampleType s1 = data.s1[section];
+            SampleType s2 = data.s2[section];
+            
+            if (a0Length == outputLength)
+            {
+                for (i = 0; i < outputLength; ++i)
+                    outputSamples[i] = process (outputSamples[i], 
+                                                a0Samples[i], a1Samples[i], a2Samples[i], 
+                                                b1Samples[i], b2Samples[i], 
+                                                s1, s2);
+                
+                ramp.jump (coeffSamples, NumSectionCoeffs, a0Length - 1);
+            }
+            else if (ramp.isSteady (coeffSamples, NumSectionCoeffs, a0Length))
+            {
+                const SampleType a0 = a0Samples[0];
+                const SampleType a1 = a1Samples[0];
+                const SampleType a2 = a2Samples[0];
+                const SampleType b1 = b1Samples[0];
+                const SampleType b2 = b2Samples[0];
+                
+                for (i = 0; i < outputLength; ++i)
+                    outputSamples[i] = process (outputSamples[i], 
+                                                a0, a1, a2, 
+                                                b1, b2, 
+                                                s1, s2);
+            }
+            else
+            {
+                const SampleType* const coeffs = ramp.values;
+                i = 0;
+                
+                for (int segment = 0, end = 0; segment < a0Length; ++segment)
+                {
+                    for (end += ramp.segment (coeffSamples, NumSectionCoeffs, a0Length, outputLength, segment); i < end; ++i)
+                    {
+                        ramp.step (NumSectionCoeffs);
+                        outputSamples[i] = process (outputSamples[i], 
+                                                    coeffs[CoeffA0], coeffs[CoeffA1], coeffs[CoeffA2], 
+                                                    coeffs[CoeffB1], coeffs[CoeffB2], 
+                                                    s1, s2);
+                    }
+                }
+                
+                ramp.finish (NumSectionCoeffs);
+            }
+            
+            data.s1[section] = zap (s1);
+            data.s2[section] = zap (s2);
+        }
+    }
+};
 
 
 
@@ -49,12 +49,17 @@ template<class ShapeType>   class FilterCoeffs1ParamUnit;
 template<class ShapeType>   class FilterCoeffs2ParamUnit;
 template<class ShapeType>   class FilterCoeffs3ParamUnit;
 template<class FormType>    class FilterUnit;
+template<class FormType>    class FilterBankUnit;
 
+template<class SampleType, int MaxCoeffs>   struct FilterCoeffsRamp;
 template<class SampleType, signed Form>     struct FilterData;
 template<class SampleType, signed Form>     class FilterForm;
+template<class SampleType, int NumSections> struct FilterCascadeData;
+template<class SampleType, int NumSections> class FilterCascadeForm;
 
 template<class SampleType, int NumCoeffs, int NumParams>    struct FilterShapeData;
 template<class SampleType, signed Form, signed Shape>       class FilterShape;
+template<class ShapeType, int NumEntries = 8>               class FilterCoeffsCache;
 
 
 #endif // PLONK_FILTERFORWARDDECLARATIONS_H
\ No newline at end of file
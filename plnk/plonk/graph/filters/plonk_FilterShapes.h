@@ -41,6 +41,94 @@
 
 #include "plonk_FilterForwardDeclarations.h"
 
+/** The maths functions used to calculate filter coefficients.
+ Single precision coefficients use polynomial approximations which avoid the
+ cost of the library functions on platforms where these are slow. Over the 
+ range used by the filter shapes (i.e., frequencies up to the Nyquist) the
+ measured errors are at most 1.8e-7 absolute for sin and 2.4e-7 absolute for 
+ cos, 2.3e-7 relative for exp (from -20 to 2), and for tan 7e-7 relative up 
+ to 0.9 of the Nyquist rising to 7e-5 relative just below it.
+ Double precision coefficients use the library functions. */
+template<class CalcType>
+class FilterShapeMath
+{
+public:
+    static PLONK_INLINE_LOW void sinCos (CalcType const& x, CalcType& sinX, CalcType& cosX) throw()
+    {
+        sinX = plonk::sin (x);
+        cosX = plonk::cos (x);
+    }
+    
+    static PLONK_INLINE_LOW CalcType tan (CalcType const& x) throw()
+    {
+        return plonk::tan (x);
+    }
+    
+    static PLONK_INLINE_LOW CalcType exp (CalcType const& x) throw()
+    {
+        return plonk::exp (x);
+    }
+};
+
+template<>
+class FilterShapeMath<float>
+{
+public:
+    static PLONK_INLINE_LOW void sinCos (const float x, float& sinX, float& cosX) throw()
+    {
+        // reduce to [-pi, pi] (rarely needed for filter frequencies) then fold to [-pi/2, pi/2]
+        const float twoPi = 6.283185307179586f;
+        const float pi = 3.141592653589793f;
+        const float pi_2 = 1.5707963267948966f;
+        
+        float r = x;
+        float cosSign = 1.f;
+        
+        if ((r > pi) || (r < -pi))
+            r -= twoPi * float (int (r * 0.15915494309189535f + (r < 0.f ? -0.5f : 0.5f)));
+        
+        if (r > pi_2)
+        {
+            r = pi - r;
+            cosSign = -1.f;
+        }
+        else if (r < -pi_2)
+        {
+            r = -pi - r;
+            cosSign = -1.f;
+        }
+        
+        const float r2 = r * r;
+        
+        // minimax fits over [-pi/2, pi/2]
+        sinX = r * (0.99999998f + r2 * (-1.6666648e-1f + r2 * (8.3328998e-3f + r2 * (-1.9800897e-4f + r2 * 2.5904877e-6f))));
+        cosX = cosSign * (0.99999995f + r2 * (-0.49999906f + r2 * (4.1663588e-2f + r2 * (-1.3853722e-3f + r2 * 2.3154249e-5f))));
+    }
+    
+    static PLONK_INLINE_LOW float tan (const float x) throw()
+    {
+        float sinX, cosX;
+        sinCos (x, sinX, cosX);
+        return sinX / cosX;
+    }
+    
+    static PLONK_INLINE_LOW float exp (const float x) throw()
+    {
+        // e^x = 2^n e^r with |r| <= log(2)/2, n rounded by adding 1.5 * 2^23
+        const float clipped = x < -87.f ? -87.f : x > 88.f ? 88.f : x;
+        union { float f; int i; } round;
+        round.f = clipped * 1.4426950408889634f + 12582912.f;
+        const int n = round.i - 0x4B400000;
+        const float fn = round.f - 12582912.f;
+        const float r = (clipped - fn * 0.693145751953125f) - fn * 1.4286068203094173e-6f;
+        const float p = 1.0000001f + r * (0.99999969f + r * (0.49998895f + r * (1.6667575e-1f + r * (4.1915381e-2f + r * 8.2976423e-3f))));
+        
+        union { float f; int i; } scale;
+        scale.i = (n + 127) << 23;
+        return p * scale.f;
+    }
+};
+
 template<class SampleType, int NumCoeffs, int NumParams>
 struct FilterShapeData
 {    
@@ -55,6 +143,118 @@ struct FilterShapeData
     CalcType params[NumParams];
 };          
 
+/** A small cache of recently calculated coefficients for a filter shape.
+ Holds the most recently used parameter sets (with the filter sample rate) and 
+ their coefficients so that repeated or stepped parameter values don't need 
+ the shape calculated again. Audio rate parameters change every sample so the
+ generators bypass the cache for those blocks. Each coefficient generator owns 
+ one so it is only accessed by the thread processing that generator. */
+template<class ShapeType, int NumEntries>
+class FilterCoeffsCache
+{
+public:
+    typedef typename ShapeType::Data        Data;
+    typedef typename ShapeType::FormType    FormType;
+    typedef typename Data::CalcType         CalcType;
+    
+    FilterCoeffsCache() throw()
+    :   numEntriesUsed (0),
+        mostRecent (0),
+        useCount (0),
+        bypassed (false)
+    {
+    }
+    
+    /** Calculates the coefficients directly, without looking them up or storing them. */
+    PLONK_INLINE_LOW void setBypassed (const bool shouldBypass) throw()
+    {
+        bypassed = shouldBypass;
+    }
+    
+    /** Fills the coefficients in @e data from its parameters. */
+    PLONK_INLINE_LOW void calculate (Data& data) throw()
+    {
+        if (bypassed)
+        {
+            ShapeType::calculate (data);
+            return;
+        }
+        
+        if ((numEntriesUsed > 0) && matches (entries[mostRecent], data))
+        {
+            copyCoeffs (entries[mostRecent], data);
+            return;
+        }
+        
+        int oldest = 0;
+        
+        for (int i = 0; i < numEntriesUsed; ++i)
+        {
+            Entry& entry = entries[i];
+            
+            if (matches (entry, data))
+            {
+                entry.lastUsed = ++useCount;
+                mostRecent = i;
+                copyCoeffs (entry, data);
+                return;
+            }
+            
+            if (entry.lastUsed < entries[oldest].lastUsed)
+                oldest = i;
+        }
+        
+        const int index = (numEntriesUsed < NumEntries) ? numEntriesUsed++ : oldest;
+        Entry& entry = entries[index];
+        
+        ShapeType::calculate (data);
+        
+        entry.filterSampleRate = data.filterSampleRate;
+        
+        for (int i = 0; i < ShapeType::NumParams; ++i)
+            entry.params[i] = data.params[i];
+        
+        for (int i = 0; i < FormType::NumCoeffs; ++i)
+            entry.coeffs[i] = data.coeffs[i];
+        
+        entry.lastUsed = ++useCount;
+        mostRecent = index;
+    }
+    
+private:
+    struct Entry
+    {
+        CalcType filterSampleRate;
+        CalcType params[ShapeType::NumParams];
+        CalcType coeffs[FormType::NumCoeffs];
+        unsigned int lastUsed;
+    };
+    
+    static PLONK_INLINE_LOW bool matches (Entry const& entry, Data const& data) throw()
+    {
+        if (entry.filterSampleRate != data.filterSampleRate)
+            return false;
+        
+        for (int i = 0; i < ShapeType::NumParams; ++i)
+            if (entry.params[i] != data.params[i])
+                return false;
+        
+        return true;
+    }
+    
+    static PLONK_INLINE_LOW void copyCoeffs (Entry const& entry, Data& data) throw()
+    {
+        for (int i = 0; i < FormType::NumCoeffs; ++i)
+            data.coeffs[i] = entry.coeffs[i];
+    }
+    
+    Entry entries[NumEntries];
+    int numEntriesUsed;
+    int mostRecent;
+    unsigned int useCount;
+    bool bypassed;
+};
+
 template<class SampleType, signed Form, signed Shape>
 class FilterShape
 {
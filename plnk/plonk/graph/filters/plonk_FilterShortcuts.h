@@ -111,7 +111,7 @@ public:
     {
         UnitType coeffs = FilterCoeffsType::ar (frequency, input.getSampleRates());
         
-        if (frequency.isConstant() == false)
+        if ((InterpTypeCode != Interp::Linear) && (frequency.isConstant() == false))
             for (int i = 0; i < coeffs.getNumChannels(); ++i)
                 coeffs.put (i, ResampleType::ar (coeffs[i]));
         
@@ -130,7 +130,7 @@ public:
     {
         UnitType coeffs = FilterCoeffsType::ar (frequency, input.getSampleRates());
         
-        if (frequency.isConstant() == false)
+        if ((InterpTypeCode != Interp::Linear) && (frequency.isConstant() == false))
             for (int i = 0; i < coeffs.getNumChannels(); ++i)
                 coeffs.put (i, ResampleType::kr (coeffs[i]));
         
@@ -207,7 +207,7 @@ public:
     {
         UnitType coeffs = FilterCoeffsType::ar (duration, input.getSampleRates());
 
-        if (duration.isConstant() == false)
+        if ((InterpTypeCode != Interp::Linear) && (duration.isConstant() == false))
             for (int i = 0; i < coeffs.getNumChannels(); ++i)
                 coeffs.put (i, ResampleType::ar (coeffs[i]));
         
@@ -226,7 +226,7 @@ public:
     {
         UnitType coeffs = FilterCoeffsType::ar (duration, input.getSampleRates());
         
-        if (duration.isConstant() == false)
+        if ((InterpTypeCode != Interp::Linear) && (duration.isConstant() == false))
             for (int i = 0; i < coeffs.getNumChannels(); ++i)
                 coeffs.put (i, ResampleType::kr (coeffs[i]));
         
@@ -307,7 +307,7 @@ public:
     {
         UnitType coeffs = FilterCoeffsType::ar (attack, release, input.getSampleRates());
         
-        if (!attack.isConstant() || !release.isConstant())
+        if ((InterpTypeCode != Interp::Linear) && (!attack.isConstant() || !release.isConstant()))
             for (int i = 0; i < coeffs.getNumChannels(); ++i)
                 coeffs.put (i, ResampleType::ar (coeffs[i]));
                 
@@ -328,7 +328,7 @@ public:
     {
         UnitType coeffs = FilterCoeffsType::ar (attack, release, input.getSampleRates());
         
-        if (!attack.isConstant() || !release.isConstant())
+        if ((InterpTypeCode != Interp::Linear) && (!attack.isConstant() || !release.isConstant()))
             for (int i = 0; i < coeffs.getNumChannels(); ++i)
                 coeffs.put (i, ResampleType::ar (coeffs[i]));
                 
@@ -404,7 +404,7 @@ public:
     {
         UnitType coeffs = FilterCoeffsType::ar (frequency, input.getSampleRates());
 
-        if (frequency.isConstant() == false)
+        if ((InterpTypeCode != Interp::Linear) && (frequency.isConstant() == false))
             for (int i = 0; i < coeffs.getNumChannels(); ++i)
                 coeffs.put (i, ResampleType::ar (coeffs[i]));
         
@@ -423,7 +423,7 @@ public:
     {
         UnitType coeffs = FilterCoeffsType::ar (frequency, input.getSampleRates());
         
-        if (frequency.isConstant() == false)
+        if ((InterpTypeCode != Interp::Linear) && (frequency.isConstant() == false))
             for (int i = 0; i < coeffs.getNumChannels(); ++i)
                 coeffs.put (i, ResampleType::kr (coeffs[i]));
         
@@ -500,7 +500,7 @@ public:
     {
         UnitType coeffs = FilterCoeffsType::ar (duration, input.getSampleRates());
 
-        if (duration.isConstant() == false)
+        if ((InterpTypeCode != Interp::Linear) && (duration.isConstant() == false))
             for (int i = 0; i < coeffs.getNumChannels(); ++i)
                 coeffs.put (i, ResampleType::ar (coeffs[i]));
         
@@ -519,7 +519,7 @@ public:
     {
         UnitType coeffs = FilterCoeffsType::ar (duration, input.getSampleRates());
         
-        if (duration.isConstant() == false)
+        if ((InterpTypeCode != Interp::Linear) && (duration.isConstant() == false))
             for (int i = 0; i < coeffs.getNumChannels(); ++i)
                 coeffs.put (i, ResampleType::kr (coeffs[i]));
         
@@ -685,7 +685,7 @@ public:
     {
         UnitType coeffs = FilterCoeffsType::ar (frequency, q, input.getSampleRates());
 
-        if ((frequency.isConstant() == false) || (q.isConstant() == false))
+        if ((InterpTypeCode != Interp::Linear) && ((frequency.isConstant() == false) || (q.isConstant() == false)))
             for (int i = 0; i < coeffs.getNumChannels(); ++i)
                 coeffs.put (i, ResampleType::ar (coeffs[i]));
         
@@ -706,7 +706,7 @@ public:
     {
         UnitType coeffs = FilterCoeffsType::ar (frequency, q, input.getSampleRates());
         
-        if (frequency.isConstant() == false)
+        if ((InterpTypeCode != Interp::Linear) && (frequency.isConstant() == false))
             for (int i = 0; i < coeffs.getNumChannels(); ++i)
                 coeffs.put (i, ResampleType::kr (coeffs[i]));
         
@@ -786,7 +786,7 @@ public:
     {
         UnitType coeffs = FilterCoeffsType::ar (frequency, q, input.getSampleRates());
         
-        if ((frequency.isConstant() == false) || (q.isConstant() == false))
+        if ((InterpTypeCode != Interp::Linear) && ((frequency.isConstant() == false) || (q.isConstant() == false)))
             for (int i = 0; i < coeffs.getNumChannels(); ++i)
                 coeffs.put (i, ResampleType::ar (coeffs[i]));
         
@@ -807,7 +807,7 @@ public:
     {
         UnitType coeffs = FilterCoeffsType::ar (frequency, q, input.getSampleRates());
         
-        if (frequency.isConstant() == false)
+        if ((InterpTypeCode != Interp::Linear) && (frequency.isConstant() == false))
             for (int i = 0; i < coeffs.getNumChannels(); ++i)
                 coeffs.put (i, ResampleType::kr (coeffs[i]));
         
@@ -916,7 +916,7 @@ public:
     {
         UnitType coeffs = FilterCoeffsType::ar (frequency, s, gain, input.getSampleRates());
         
-        if (frequency.isConstant() == false)
+        if ((InterpTypeCode != Interp::Linear) && (frequency.isConstant() == false))
             for (int i = 0; i < coeffs.getNumChannels(); ++i)
                 coeffs.put (i, ResampleType::kr (coeffs[i]));
         
@@ -1025,7 +1025,7 @@ public:
     {
         UnitType coeffs = FilterCoeffsType::ar (frequency, s, gain, input.getSampleRates());
         
-        if (frequency.isConstant() == false)
+        if ((InterpTypeCode != Interp::Linear) && (frequency.isConstant() == false))
             for (int i = 0; i < coeffs.getNumChannels(); ++i)
                 coeffs.put (i, ResampleType::kr (coeffs[i]));
         
@@ -1134,7 +1134,7 @@ public:
     {
         UnitType coeffs = FilterCoeffsType::ar (frequency, q, gain, input.getSampleRates());
         
-        if (frequency.isConstant() == false)
+        if ((InterpTypeCode != Interp::Linear) && (frequency.isConstant() == false))
             for (int i = 0; i < coeffs.getNumChannels(); ++i)
                 coeffs.put (i, ResampleType::kr (coeffs[i]));
         
@@ -1214,7 +1214,7 @@ public:
     {
         UnitType coeffs = FilterCoeffsType::ar (frequency, bandwidth, input.getSampleRates());
         
-        if (frequency.isConstant() == false)
+        if ((InterpTypeCode != Interp::Linear) && (frequency.isConstant() == false))
             for (int i = 0; i < coeffs.getNumChannels(); ++i)
                 coeffs.put (i, ResampleType::ar (coeffs[i]));
         
@@ -1235,7 +1235,7 @@ public:
     {
         UnitType coeffs = FilterCoeffsType::ar (frequency, bandwidth, input.getSampleRates());
         
-        if (frequency.isConstant() == false)
+        if ((InterpTypeCode != Interp::Linear) && (frequency.isConstant() == false))
             for (int i = 0; i < coeffs.getNumChannels(); ++i)
                 coeffs.put (i, ResampleType::kr (coeffs[i]));
         
@@ -1315,7 +1315,7 @@ public:
     {
         UnitType coeffs = FilterCoeffsType::ar (frequency, bandwidth, input.getSampleRates());
         
-        if (frequency.isConstant() == false)
+        if ((InterpTypeCode != Interp::Linear) && (frequency.isConstant() == false))
             for (int i = 0; i < coeffs.getNumChannels(); ++i)
                 coeffs.put (i, ResampleType::ar (coeffs[i]));
         
@@ -1336,7 +1336,7 @@ public:
     {
         UnitType coeffs = FilterCoeffsType::ar (frequency, bandwidth, input.getSampleRates());
         
-        if (frequency.isConstant() == false)
+        if ((InterpTypeCode != Interp::Linear) && (frequency.isConstant() == false))
             for (int i = 0; i < coeffs.getNumChannels(); ++i)
                 coeffs.put (i, ResampleType::kr (coeffs[i]));
         
@@ -1418,7 +1418,7 @@ public:
     {
         UnitType coeffs = FilterCoeffsType::ar (frequency, input.getSampleRates());
 
-        if (frequency.isConstant() == false)
+        if ((InterpTypeCode != Interp::Linear) && (frequency.isConstant() == false))
             for (int i = 0; i < coeffs.getNumChannels(); ++i)
                 coeffs.put (i, ResampleType::ar (coeffs[i]));
         
@@ -1437,7 +1437,7 @@ public:
     {
         UnitType coeffs = FilterCoeffsType::ar (frequency, input.getSampleRates());
         
-        if (frequency.isConstant() == false)
+        if ((InterpTypeCode != Interp::Linear) && (frequency.isConstant() == false))
             for (int i = 0; i < coeffs.getNumChannels(); ++i)
                 coeffs.put (i, ResampleType::kr (coeffs[i]));
         
@@ -1514,7 +1514,7 @@ public:
     {
         UnitType coeffs = FilterCoeffsType::ar (frequency, input.getSampleRates());
         
-        if (frequency.isConstant() == false)
+        if ((InterpTypeCode != Interp::Linear) && (frequency.isConstant() == false))
             for (int i = 0; i < coeffs.getNumChannels(); ++i)
                 coeffs.put (i, ResampleType::ar (coeffs[i]));
         
@@ -1533,7 +1533,7 @@ public:
     {
         UnitType coeffs = FilterCoeffsType::ar (frequency, input.getSampleRates());
         
-        if (frequency.isConstant() == false)
+        if ((InterpTypeCode != Interp::Linear) && (frequency.isConstant() == false))
             for (int i = 0; i < coeffs.getNumChannels(); ++i)
                 coeffs.put (i, ResampleType::kr (coeffs[i]));
         
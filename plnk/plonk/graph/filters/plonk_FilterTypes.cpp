@@ -56,7 +56,8 @@ FilterFormType::Name FilterFormType::fromInt (const int value) throw()
         FilterFormType::Z2,
         FilterFormType::P1Z1,
         FilterFormType::P2Z2,
-        FilterFormType::B2
+        FilterFormType::B2,
+        FilterFormType::P2Z2Cascade
     };
     
     if (value < 0 || value >= FilterFormType::NumNames)
@@ -83,7 +84,8 @@ Text FilterFormType::getName (const int index) throw()
         "Two-Zero",
         "One-Pole One-Zero", 
         "Two-Pole Two-Zero",
-        "Butterworth 2nd Order"
+        "Butterworth 2nd Order",
+        "Two-Pole Two-Zero Cascade"
     };
     
     if (index < 0 || index >= FilterFormType::NumNames)
@@ -76,6 +76,7 @@ public:
         P1Z1,
         P2Z2,
         B2,
+        P2Z2Cascade,
         NumNames
     };
     
@@ -81,7 +81,7 @@ public:
         const CalcType negtwo (-two);
         const CalcType w0 = Math<CalcType>::getPi() * data.params[Frequency] * data.filterSampleDuration;
         
-		const CalcType temp1 = one / plonk::tan (w0);
+		const CalcType temp1 = one / FilterShapeMath<CalcType>::tan (w0);
 		const CalcType temp2 = temp1 * temp1;
 		const CalcType temp3 = temp1 * Math<CalcType>::getSqrt2();
         
@@ -134,7 +134,7 @@ public:
         const CalcType negtwo (-two);
         const CalcType w0 = Math<CalcType>::getPi() * data.params[Frequency] * data.filterSampleDuration;
         
-		const CalcType temp1 = plonk::tan (w0);
+		const CalcType temp1 = FilterShapeMath<CalcType>::tan (w0);
 		const CalcType temp2 = temp1 * temp1;
 		const CalcType temp3 = temp1 * Math<CalcType>::getSqrt2();
         
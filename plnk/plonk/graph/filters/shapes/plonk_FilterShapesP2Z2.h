@@ -88,8 +88,8 @@ public:
         const CalcType half (Math<CalcType>::get0_5());
         const CalcType two (Math<CalcType>::get2());
         const CalcType w0 =  Math<CalcType>::get2Pi() * data.params[Frequency] * data.filterSampleDuration;
-        const CalcType cos_w0 = plonk::cos (w0);
-        const CalcType sin_w0 = plonk::sin (w0);		
+        CalcType sin_w0, cos_w0;
+        FilterShapeMath<CalcType>::sinCos (w0, sin_w0, cos_w0);
         const CalcType alpha = sin_w0 * half / data.params[Q];
         const CalcType temp1 = one / (one + alpha);
         const CalcType temp2 = one - cos_w0;
@@ -151,8 +151,8 @@ public:
         const CalcType half (Math<CalcType>::get0_5());
         const CalcType two (Math<CalcType>::get2());
         const CalcType w0 = Math<CalcType>::get2Pi() * data.params[Frequency] * data.filterSampleDuration;
-        const CalcType cos_w0 = plonk::cos (w0);
-        const CalcType sin_w0 = plonk::sin (w0);		
+        CalcType sin_w0, cos_w0;
+        FilterShapeMath<CalcType>::sinCos (w0, sin_w0, cos_w0);
         const CalcType alpha = sin_w0 * half / data.params[Q];
         const CalcType temp1 = one / (one + alpha);
         const CalcType temp2 = one + cos_w0;
@@ -208,12 +208,11 @@ public:
         const CalcType one (Math<CalcType>::get1());
         const CalcType half (Math<CalcType>::get0_5());
         const CalcType two (Math<CalcType>::get2());
-        const CalcType ten (Math<CalcType>::get10());
                 
-        const CalcType a = plonk::pow (ten, data.params[Gain] * (Math<CalcType>::get1_40()));
+        const CalcType a = FilterShapeMath<CalcType>::exp (data.params[Gain] * Math<CalcType>::getLog10() * Math<CalcType>::get1_40());
         const CalcType w0 = Math<CalcType>::get2Pi() * data.params[Frequency] * data.filterSampleDuration;
-        const CalcType cos_w0 = plonk::cos (w0);
-        const CalcType sin_w0 = plonk::sin (w0);		
+        CalcType sin_w0, cos_w0;
+        FilterShapeMath<CalcType>::sinCos (w0, sin_w0, cos_w0);
 
         const CalcType r2ss = half / plonk::squared (data.params[S]);
         const CalcType alpha = sin_w0 * plonk::sqrt (a) * r2ss;
@@ -273,12 +272,11 @@ public:
         const CalcType one (Math<CalcType>::get1());
         const CalcType half (Math<CalcType>::get0_5());
         const CalcType two (Math<CalcType>::get2());
-        const CalcType ten (Math<CalcType>::get10());
         
-        const CalcType a = plonk::pow (ten, data.params[Gain] * (Math<CalcType>::get1_40()));
+        const CalcType a = FilterShapeMath<CalcType>::exp (data.params[Gain] * Math<CalcType>::getLog10() * Math<CalcType>::get1_40());
         const CalcType w0 = Math<CalcType>::get2Pi() * data.params[Frequency] * data.filterSampleDuration;
-        const CalcType cos_w0 = plonk::cos (w0);
-        const CalcType sin_w0 = plonk::sin (w0);		
+        CalcType sin_w0, cos_w0;
+        FilterShapeMath<CalcType>::sinCos (w0, sin_w0, cos_w0);
         
         const CalcType r2ss = half / plonk::squared (data.params[S]);
         const CalcType alpha = sin_w0 * plonk::sqrt (a) * r2ss;
@@ -337,12 +335,11 @@ public:
         const CalcType one (Math<CalcType>::get1());
         const CalcType half (Math<CalcType>::get0_5());
         const CalcType two (Math<CalcType>::get2());
-        const CalcType ten (Math<CalcType>::get10());
                 
-        const CalcType a = plonk::pow (ten, data.params[Gain] * (Math<CalcType>::get1_40()));
+        const CalcType a = FilterShapeMath<CalcType>::exp (data.params[Gain] * Math<CalcType>::getLog10() * Math<CalcType>::get1_40());
         const CalcType w0 = Math<CalcType>::get2Pi() * data.params[Frequency] * data.filterSampleDuration;
-        const CalcType cos_w0 = plonk::cos (w0);
-        const CalcType sin_w0 = plonk::sin (w0);		
+        CalcType sin_w0, cos_w0;
+        FilterShapeMath<CalcType>::sinCos (w0, sin_w0, cos_w0);
         const CalcType alpha = sin_w0 * half / data.params[Q];
         const CalcType temp1 = alpha * a;
         const CalcType temp2 = alpha / a;
@@ -397,8 +394,8 @@ public:
         const CalcType two (Math<CalcType>::get2());
         const CalcType logSqrt2 (Math<CalcType>::getLogSqrt2());
         const CalcType w0 = Math<CalcType>::get2Pi() * data.params[Frequency] * data.filterSampleDuration;
-        const CalcType cos_w0 = plonk::cos (w0);
-        const CalcType sin_w0 = plonk::sin (w0);		
+        CalcType sin_w0, cos_w0;
+        FilterShapeMath<CalcType>::sinCos (w0, sin_w0, cos_w0);
         const CalcType alpha = sin_w0 * plonk::sinh (logSqrt2 * (data.params[Bandwidth] * w0) / sin_w0);
         const CalcType temp1 = one / (one + alpha);
                 
@@ -450,8 +447,8 @@ public:
         const CalcType two (Math<CalcType>::get2());
         const CalcType logSqrt2 (Math<CalcType>::getLogSqrt2());
         const CalcType w0 = Math<CalcType>::get2Pi() * data.params[Frequency] * data.filterSampleDuration;
-        const CalcType cos_w0 = plonk::cos (w0);
-        const CalcType sin_w0 = plonk::sin (w0);		
+        CalcType sin_w0, cos_w0;
+        FilterShapeMath<CalcType>::sinCos (w0, sin_w0, cos_w0);
         const CalcType alpha = sin_w0 * plonk::sinh (logSqrt2 * (data.params[Bandwidth] * w0) / sin_w0);
         const CalcType temp1 = one / (one + alpha);
         const CalcType temp2 = two * cos_w0 * temp1;
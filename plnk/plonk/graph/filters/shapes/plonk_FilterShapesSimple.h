@@ -78,7 +78,7 @@ public:
     static PLONK_INLINE_LOW void calculate (Data& data) throw()
     {
         const CalcType w0 = Math<CalcType>::get2Pi() * data.params[Frequency] * data.filterSampleDuration;        
-        const CalcType temp = plonk::exp (-w0);
+        const CalcType temp = FilterShapeMath<CalcType>::exp (-w0);
         
         plonk_assert (temp > CalcType (0));
         
@@ -124,7 +124,7 @@ public:
         const CalcType log0_001 (Math<CalcType>::getLog0_001());
         
         const CalcType lag = data.params[Duration];
-        const CalcType temp = (lag == zero) ? zero : plonk::exp (log0_001 / (lag * data.filterSampleRate));
+        const CalcType temp = (lag == zero) ? zero : FilterShapeMath<CalcType>::exp (log0_001 / (lag * data.filterSampleRate));
         
         plonk_assert (temp >= CalcType (0));
         
@@ -171,8 +171,8 @@ public:
         
         const CalcType attack = data.params[Attack];
         const CalcType release = data.params[Release];
-        data.coeffs[FormType::CoeffB1u] = (attack == zero) ? zero : plonk::exp (log0_001 / (attack * data.filterSampleRate));
-        data.coeffs[FormType::CoeffB1d] = (attack == zero) ? zero : plonk::exp (log0_001 / (release * data.filterSampleRate));
+        data.coeffs[FormType::CoeffB1u] = (attack == zero) ? zero : FilterShapeMath<CalcType>::exp (log0_001 / (attack * data.filterSampleRate));
+        data.coeffs[FormType::CoeffB1d] = (attack == zero) ? zero : FilterShapeMath<CalcType>::exp (log0_001 / (release * data.filterSampleRate));
         
         plonk_assert (data.coeffs[FormType::CoeffB1u] >= CalcType (0));
         plonk_assert (data.coeffs[FormType::CoeffB1d] >= CalcType (0));
@@ -217,7 +217,7 @@ public:
         const CalcType half (Math<CalcType>::get0_5());
         const CalcType w0 =  Math<CalcType>::get2Pi() * data.params[Frequency] * data.filterSampleDuration;
         
-        const CalcType temp1 = plonk::exp (-w0);
+        const CalcType temp1 = FilterShapeMath<CalcType>::exp (-w0);
         
         plonk_assert (temp1 > CalcType (0));
         
@@ -268,7 +268,7 @@ public:
         const CalcType log0_001 (Math<CalcType>::getLog0_001());
         
         const CalcType decay = data.params[Duration];
-        const CalcType temp = (decay == zero) ? zero : plonk::exp (log0_001 / (decay * data.filterSampleRate));
+        const CalcType temp = (decay == zero) ? zero : FilterShapeMath<CalcType>::exp (log0_001 / (decay * data.filterSampleRate));
         
         plonk_assert (temp >= CalcType (0));
         
@@ -0,0 +1,797 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_BLEPOSCILLATOR_H
+#define PLONK_BLEPOSCILLATOR_H
+
+#include "../channel/plonk_ChannelInternalCore.h"
+#include "../plonk_GraphForwardDeclarations.h"
+
+
+/** Waveforms available from BLEPOscillatorUnit. */
+class BLEPShape
+{
+public:
+    enum Shape
+    {
+        Saw,
+        Square,
+        Impulse,
+        NumShapes
+    };
+};
+
+/** How BLEPOscillatorUnit band limits its discontinuities.
+ @see BLEPTableBase */
+class BLEPMode
+{
+public:
+    enum Mode
+    {
+        Poly,       ///< Two sample polynomial corrections, cheapest.
+        Minimum,    ///< Minimum phase table corrections over BLEPTableBase::Span samples, less aliasing.
+        NumModes
+    };
+};
+
+template<class SampleType> class BLEPOscillatorChannelInternal;
+
+PLONK_CHANNELDATA_DECLARE(BLEPOscillatorChannelInternal,SampleType)
+{    
+    ChannelInternalCore::Data base;
+    double currentPhase;
+    double peak;
+    SampleType lastSync;
+    int shape;
+    int mode;
+};      
+
+//------------------------------------------------------------------------------
+
+/** Band limited sawtooth, pulse and impulse generator. 
+ The phases for the block are accumulated first, adding a band limited step 
+ (or impulse) to a correction buffer at each discontinuity found on the way. 
+ The naive waveform is then made from the phases and the corrections mixed in
+ using the SIMD vector functions. Corrections running past the end of the 
+ block are carried into the next one. The minimum phase corrections lag the
+ discontinuities by BLEPTableBase::getDelay() so the sawtooth's ramp is 
+ lagged by the same amount. */
+template<class SampleType>
+class BLEPOscillatorChannelInternal 
+:   public ChannelInternal<SampleType, PLONK_CHANNELDATA_NAME(BLEPOscillatorChannelInternal,SampleType)>
+{
+public:
+    typedef PLONK_CHANNELDATA_NAME(BLEPOscillatorChannelInternal,SampleType)    Data;
+    typedef typename BinaryOpFunctionsHelper<SampleType>::BinaryOpFunctionsType BinaryOpFunctionsType;
+    typedef ChannelBase<SampleType>                                             ChannelType;
+    typedef BLEPOscillatorChannelInternal<SampleType>                           BLEPOscillatorInternal;
+    typedef ChannelInternal<SampleType,Data>                                    Internal;
+    typedef ChannelInternalBase<SampleType>                                     InternalBase;
+    typedef UnitBase<SampleType>                                                UnitType;
+    typedef InputDictionary                                                     Inputs;
+    typedef NumericalArray<SampleType>                                          Buffer;
+    typedef BLEPTableBase<SampleType>                                           TableType;
+    
+    typedef typename TypeUtility<SampleType>::IndexType         FrequencyType;
+    typedef UnitBase<FrequencyType>                             FrequencyUnitType;
+    typedef NumericalArray<FrequencyType>                       FrequencyBufferType;
+
+    BLEPOscillatorChannelInternal (Inputs const& inputs, 
+                                   Data const& data, 
+                                   BlockSize const& blockSize,
+                                   SampleRate const& sampleRate) throw()
+    :   Internal (inputs, data, blockSize, sampleRate),
+        table (data.mode == BLEPMode::Minimum ? &TableType::getShared() : 0),
+        span (data.mode == BLEPMode::Minimum ? int (TableType::Span) : 1),
+        delay (data.mode == BLEPMode::Minimum ? TableType::getShared().getDelay() : 0.0)
+    {
+    }
+            
+    Text getName() const throw()
+    {
+        switch (this->getState().shape)
+        {
+            case BLEPShape::Square:     return "BLEP Square";
+            case BLEPShape::Impulse:    return "BLEP Impulse";
+            default:                    return "BLEP Saw";
+        }
+    }       
+    
+    IntArray getInputKeys() const throw()
+    {
+        if (this->getState().shape == BLEPShape::Square)
+        {
+            const IntArray keys (IOKey::Frequency, IOKey::Width, IOKey::Sync);
+            return keys;
+        }
+        else
+        {
+            const IntArray keys (IOKey::Frequency, IOKey::Sync);
+            return keys;
+        }
+    }    
+    
+    InternalBase* getChannel (const int index) throw()
+    {
+        const Inputs channelInputs = this->getInputs().getChannel (index);
+        return new BLEPOscillatorInternal (channelInputs, 
+                                           this->getState(), 
+                                           this->getBlockSize(), 
+                                           this->getSampleRate());
+    }
+    
+    void initChannel (const int channel) throw()
+    {        
+        const FrequencyUnitType& frequencyUnit = ChannelInternalCore::getInputAs<FrequencyUnitType> (IOKey::Frequency);
+        
+        this->setBlockSize (BlockSize::decide (frequencyUnit.getBlockSize (channel),
+                                               this->getBlockSize()));
+        this->setSampleRate (SampleRate::decide (frequencyUnit.getSampleRate (channel),
+                                                 this->getSampleRate()));
+        
+        this->setOverlap (frequencyUnit.getOverlap (channel));
+        
+        corrections = Buffer::newClear (this->getBlockSize().getValue() + span);
+        
+        this->initValue (SampleType (0));
+    }    
+    
+    /** The corrections carried into the next block follow the base state blocks. */
+    int getNumStateBlocks() const throw()
+    {
+        return Internal::getNumStateBlocks() + 1;
+    }
+    
+    void* getStateBlock (const int index, int& numBytes) throw()
+    {
+        if (index != Internal::getNumStateBlocks())
+            return Internal::getStateBlock (index, numBytes);
+        
+        numBytes = corrections.length() * sizeof (SampleType);
+        return corrections.getArray();
+    }
+    
+    void process (ProcessInfo& info, const int channel) throw()
+    {        
+        Data& data = this->getState();
+        const double sampleDuration = data.base.sampleDuration;
+
+        FrequencyUnitType& frequencyUnit = ChannelInternalCore::getInputAs<FrequencyUnitType> (IOKey::Frequency);
+        const FrequencyBufferType& frequencyBuffer (frequencyUnit.process (info, channel));
+        const FrequencyType* const frequencySamples = frequencyBuffer.getArray();
+        const int frequencyBufferLength = frequencyBuffer.length();
+        
+        SampleType* const outputSamples = this->getOutputSamples();
+        const int outputBufferLength = this->getOutputBuffer().length();
+        
+        int i;
+        
+        if (values.length() != outputBufferLength)
+            values.setSize (outputBufferLength, false);
+        
+        if (corrections.length() != outputBufferLength + span)
+        {
+            // keeps the carried corrections at the start
+            corrections.setSize (outputBufferLength + span, true);
+            Memory::zero (corrections.getArray() + span, outputBufferLength * sizeof (SampleType));
+        }
+        
+        Block block;
+        block.values = values.getArray();
+        block.corrections = corrections.getArray();
+        block.widths = 0;
+        block.widthPosition = 0.0;
+        block.widthIncrement = 0.0;
+        block.syncs = 0;
+        block.syncPosition = 0.0;
+        block.syncIncrement = 0.0;
+        
+        if (data.shape == BLEPShape::Square)
+        {
+            UnitType& widthUnit = ChannelInternalCore::getInputAs<UnitType> (IOKey::Width);
+            const Buffer& widthBuffer (widthUnit.process (info, channel));
+            block.widths = widthBuffer.getArray();
+            block.widthIncrement = double (widthBuffer.length()) / double (outputBufferLength);
+        }
+        
+        UnitType& syncUnit = ChannelInternalCore::getInputAs<UnitType> (IOKey::Sync);
+        
+        // a constant never crosses zero
+        if (! syncUnit.isConstant (channel))
+        {
+            const Buffer& syncBuffer (syncUnit.process (info, channel));
+            block.syncs = syncBuffer.getArray();
+            block.syncIncrement = double (syncBuffer.length()) / double (outputBufferLength);
+        }
+        
+        double currentPhase = data.currentPhase;
+
+        if (frequencyBufferLength == outputBufferLength)
+        {
+            for (i = 0; i < outputBufferLength; ++i) 
+                next (block, currentPhase, i, frequencySamples[i] * sampleDuration);
+        }
+        else if (frequencyBufferLength == 1)
+        {
+            const double phaseIncrement (frequencySamples[0] * sampleDuration);
+            
+            for (i = 0; i < outputBufferLength; ++i) 
+                next (block, currentPhase, i, phaseIncrement);
+        }
+        else
+        {
+            double frequencyPosition = 0.0;
+            const double frequencyIncrement = double (frequencyBufferLength) / double (outputBufferLength);
+            
+            for (i = 0; i < outputBufferLength; ++i) 
+            {
+                next (block, currentPhase, i, frequencySamples[int (frequencyPosition)] * sampleDuration);
+                frequencyPosition += frequencyIncrement;
+            }        
+        }
+        
+        data.currentPhase = currentPhase;
+        
+        const SampleType peak = SampleType (data.peak);
+        
+        switch (data.shape)
+        {
+            case BLEPShape::Impulse:
+                Memory::zero (outputSamples, outputBufferLength * sizeof (SampleType));
+                break;
+            default:
+                NumericalArrayBinaryOp<SampleType,BinaryOpFunctionsType::mulop>::calcN1 (outputSamples, block.values, peak, outputBufferLength);
+        }
+        
+        SampleType* const correctionSamples = corrections.getArray();
+        
+        NumericalArrayBinaryOp<SampleType,BinaryOpFunctionsType::addop>::calcNN (outputSamples, outputSamples, correctionSamples, outputBufferLength);
+        
+        // the carry may overlap the block when it is short
+        for (i = 0; i < span; ++i)
+            correctionSamples[i] = correctionSamples[outputBufferLength + i];
+        
+        Memory::zero (correctionSamples + span, outputBufferLength * sizeof (SampleType));
+    }
+    
+private:
+    const TableType* const table;
+    const int span;
+    const double delay;
+    Buffer values;
+    Buffer corrections;
+    
+    struct Block
+    {
+        SampleType* values;
+        SampleType* corrections;
+        const SampleType* widths;
+        double widthPosition;
+        double widthIncrement;
+        const SampleType* syncs;
+        double syncPosition;
+        double syncIncrement;
+    };
+    
+    /** Stores the naive value for output sample i and advances the phase to the next sample. 
+     A positive going zero crossing of the sync input restarts the cycle the 
+     same distance between the samples (so a sample later than the crossing). */
+    PLONK_INLINE_HIGH void next (Block& block, double& phase, const int i, const double increment) throw()
+    {
+        Data& data = this->getState();
+        double width = 0.5;
+        
+        if (block.widths != 0)
+        {
+            width = plonk::clip (double (block.widths[int (block.widthPosition)]), 0.0, 1.0);
+            block.widthPosition += block.widthIncrement;
+        }
+        
+        block.values[i] = SampleType (data.shape == BLEPShape::Saw ? 
+                                      value (phase, width) - 2.0 * increment * delay :
+                                      value (phase, width));
+        SampleType* const output = block.corrections + i + 1;
+        
+        if (block.syncs != 0)
+        {
+            const SampleType syncValue = block.syncs[int (block.syncPosition)];
+            block.syncPosition += block.syncIncrement;
+            
+            if ((data.lastSync <= SampleType (0)) && (syncValue > SampleType (0)))
+            {
+                const double syncFraction = double (data.lastSync) / double (data.lastSync - syncValue);
+                data.lastSync = syncValue;
+                
+                move (output, phase, increment * syncFraction, 0.0, increment, width);
+                
+                if (data.shape == BLEPShape::Impulse)
+                    impulse (output, syncFraction);
+                else
+                    step (output, syncFraction, value (0.0, width) - value (phase, width));
+                
+                phase = 0.0;
+                move (output, phase, increment * (1.0 - syncFraction), syncFraction, increment, width);
+                return;
+            }
+            
+            data.lastSync = syncValue;
+        }
+        
+        move (output, phase, increment, 0.0, increment, width);
+    }
+    
+    /** The naive waveform from -1 to 1. */
+    PLONK_INLINE_HIGH double value (const double phase, const double width) const throw()
+    {
+        switch (this->getState().shape)
+        {
+            case BLEPShape::Saw:    return phase * 2.0 - 1.0;
+            case BLEPShape::Square: return phase < width ? 1.0 : -1.0;
+            default:                return 0.0;
+        }
+    }
+    
+    /** Moves the phase, correcting the discontinuities crossed. 
+     Times are from the previous output sample to the next. */
+    PLONK_INLINE_HIGH void move (SampleType* const output, double& phase, const double amount, 
+                                 const double startTime, const double increment, const double width) throw()
+    {
+        const int shape = this->getState().shape;
+        const double end = phase + amount;
+        
+        if (amount >= 0.0)
+        {
+            if (shape == BLEPShape::Square)
+            {
+                if ((phase < width) && (end >= width))
+                    step (output, startTime + (width - phase) / increment, -2.0);
+                
+                if (end >= 1.0 + width)
+                    step (output, startTime + (1.0 + width - phase) / increment, -2.0);
+            }
+            
+            if (end >= 1.0)
+            {
+                wrap (output, startTime + (1.0 - phase) / increment, shape == BLEPShape::Saw ? -2.0 : 2.0);
+                phase = end - 1.0;
+            }
+            else
+            {
+                phase = end;
+            }
+        }
+        else
+        {
+            if (shape == BLEPShape::Square)
+            {
+                if ((phase >= width) && (end < width))
+                    step (output, startTime + (width - phase) / increment, 2.0);
+                
+                if (end < width - 1.0)
+                    step (output, startTime + (width - 1.0 - phase) / increment, 2.0);
+            }
+            
+            if (end < 0.0)
+            {
+                wrap (output, startTime - phase / increment, shape == BLEPShape::Saw ? 2.0 : -2.0);
+                phase = end + 1.0;
+            }
+            else
+            {
+                phase = end;
+            }
+        }
+    }
+    
+    PLONK_INLINE_HIGH void wrap (SampleType* const output, const double time, const double height) throw()
+    {
+        if (this->getState().shape == BLEPShape::Impulse)
+            impulse (output, time);
+        else
+            step (output, time, height);
+    }
+    
+    PLONK_INLINE_HIGH void step (SampleType* const output, const double time, const double height) throw()
+    {
+        const SampleType offset = SampleType (plonk::clip (1.0 - time, 0.0, 1.0));
+        const SampleType scaledHeight = SampleType (height * this->getState().peak);
+        
+        if (table != 0)
+            table->addStep (output, offset, scaledHeight);
+        else
+            TableType::addPolyStep (output, offset, scaledHeight);
+    }
+    
+    PLONK_INLINE_HIGH void impulse (SampleType* const output, const double time) throw()
+    {
+        const SampleType offset = SampleType (plonk::clip (1.0 - time, 0.0, 1.0));
+        const SampleType height = SampleType (this->getState().peak);
+        
+        if (table != 0)
+            table->addImpulse (output, offset, height);
+        else
+            TableType::addPolyImpulse (output, offset, height);
+    }
+};
+
+//------------------------------------------------------------------------------
+
+/** Band limited sawtooth, pulse and impulse oscillator.
+ Costs about the same as the naive SawUnit and ImpulseUnit so is cheaper 
+ than oversampling these to reduce aliasing. Unlike BandlimitedTableUnit the
+ cycle can be restarted by a sync input without aliasing (i.e., hard sync).
+ 
+ @par Factory functions:
+ - ar (shape, mode=Poly, frequency=440, width=0.5, sync=0, mul=1, add=0, preferredBlockSize=default, preferredSampleRate=default)
+ - kr (shape, mode, frequency, width=0.5, sync=0, mul=1, add=0) 
+ 
+ @par Inputs:
+ - shape: (BLEPShape::Shape) the waveform to use for the oscillator
+ - mode: (BLEPMode::Mode) the corrections used to band limit the waveform
+ - frequency: (unit, multi) the frequency of the oscillator in Hz
+ - width: (unit, multi) the proportion of the cycle the square wave is high, ignored by the other shapes
+ - sync: (unit, multi) restarts the cycle a sample after each positive going zero crossing
+ - mul: (unit, multi) the multiplier applied to the output
+ - add: (unit, multi) the offset added to the output
+ - preferredBlockSize: the preferred output block size (for advanced usage, leave on default if unsure)
+ - preferredSampleRate: the preferred output sample rate (for advanced usage, leave on default if unsure)
+
+ This is intended for float and double samples only.
+ @see BLEPTableBase
+ @ingroup GeneratorUnits ControlUnits */
+template<class SampleType>
+class BLEPOscillatorUnit
+{
+public:    
+    typedef BLEPOscillatorChannelInternal<SampleType>   BLEPOscillatorInternal;
+    typedef typename BLEPOscillatorInternal::Data       Data;
+    typedef ChannelBase<SampleType>                     ChannelType;
+    typedef ChannelInternal<SampleType,Data>            Internal;
+    typedef UnitBase<SampleType>                        UnitType;
+    typedef InputDictionary                             Inputs;
+    typedef BLEPTableBase<SampleType>                   TableType;
+    
+    typedef typename BLEPOscillatorInternal::FrequencyType         FrequencyType;
+    typedef typename BLEPOscillatorInternal::FrequencyUnitType     FrequencyUnitType;
+    typedef typename BLEPOscillatorInternal::FrequencyBufferType   FrequencyBufferType;
+    
+    static PLONK_INLINE_LOW UnitInfos getInfo() throw()
+    {
+        const double blockSize = (double)BlockSize::getDefault().getValue();
+        const double sampleRate = SampleRate::getDefault().getValue();
+        const double peak = (double)TypeUtility<SampleType>::getTypePeak();
+        
+        return UnitInfo ("BLEPOscillator", "A band limited sawtooth, pulse or impulse oscillator.",
+                         
+                         // output
+                         ChannelCount::VariableChannelCount, 
+                         IOKey::Generic,    Measure::None,      0.0,        IOLimit::Clipped,   Measure::NormalisedBipolar, -peak, peak,
+                         IOKey::End,
+                         
+                         // inputs
+                         IOKey::Frequency,  Measure::Hertz,     440.0,      IOLimit::Clipped,   Measure::SampleRateRatio,  -0.5, 0.5,
+                         IOKey::Width,      Measure::NormalisedUnipolar, 0.5, IOLimit::Clipped, Measure::NormalisedUnipolar, 0.0, 1.0,
+                         IOKey::Sync,       Measure::None,      0.0,        IOLimit::None,
+                         IOKey::Multiply,   Measure::Factor,    1.0,        IOLimit::None,
+                         IOKey::Add,        Measure::None,      0.0,        IOLimit::None,
+                         IOKey::BlockSize,  Measure::Samples,   blockSize,  IOLimit::Minimum,   Measure::Samples,           1.0,
+                         IOKey::SampleRate, Measure::Hertz,     sampleRate, IOLimit::Minimum,   Measure::Hertz,             0.0,
+                         IOKey::End);
+    }
+    
+    /** Create an audio rate band limited oscillator. */
+    static UnitType ar (const BLEPShape::Shape shape,
+                        const BLEPMode::Mode mode = BLEPMode::Poly,
+                        FrequencyUnitType const& frequency = FrequencyType (440), 
+                        UnitType const& width = SampleType (0.5),
+                        UnitType const& sync = SampleType (0),
+                        UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0),
+                        BlockSize const& preferredBlockSize = BlockSize::getDefault(),
+                        SampleRate const& preferredSampleRate = SampleRate::getDefault()) throw()
+    {             
+        // build the shared table now rather than on the audio thread
+        if (mode == BLEPMode::Minimum)
+            TableType::getShared();
+        
+        Inputs inputs;
+        inputs.put (IOKey::Frequency, frequency);
+        inputs.put (IOKey::Sync, sync);
+        inputs.put (IOKey::Multiply, mul);
+        inputs.put (IOKey::Add, add);
+        
+        if (shape == BLEPShape::Square)
+            inputs.put (IOKey::Width, width);
+                        
+        Data data;
+        Memory::zero (data);
+        data.base.sampleRate = -1.0;
+        data.base.sampleDuration = -1.0;
+        data.currentPhase = shape == BLEPShape::Square ? 0.0 : 0.5; // as SawUnit and ImpulseUnit
+        data.peak = (double)TypeUtility<SampleType>::getTypePeak();
+        data.shape = shape;
+        data.mode = mode;
+        
+        return UnitType::template createFromInputs<BLEPOscillatorInternal> (inputs, 
+                                                                            data, 
+                                                                            preferredBlockSize, 
+                                                                            preferredSampleRate);
+    }
+    
+    /** Create a control rate band limited oscillator. */
+    static UnitType kr (const BLEPShape::Shape shape,
+                        const BLEPMode::Mode mode,
+                        FrequencyUnitType const& frequency, 
+                        UnitType const& width = SampleType (0.5),
+                        UnitType const& sync = SampleType (0),
+                        UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0)) throw()
+    {
+        return ar (shape, mode, frequency, width, sync, mul, add, 
+                   BlockSize::getControlRateBlockSize(), 
+                   SampleRate::getControlRate());
+    }        
+};
+
+typedef BLEPOscillatorUnit<PLONK_TYPE_DEFAULT> BLEPOscillator;
+
+//------------------------------------------------------------------------------
+
+/** Band limited sawtooth oscillator using PolyBLEP corrections. 
+ 
+ @par Factory functions:
+ - ar (frequency=440, sync=0, mul=1, add=0, preferredBlockSize=default, preferredSampleRate=default)
+ - kr (frequency=440, sync=0, mul=1, add=0) 
+ 
+ @par Inputs:
+ - frequency: (unit, multi) the frequency of the oscillator in Hz
+ - sync: (unit, multi) restarts the cycle a sample after each positive going zero crossing
+ - mul: (unit, multi) the multiplier applied to the output
+ - add: (unit, multi) the offset added to the output
+ - preferredBlockSize: the preferred output block size (for advanced usage, leave on default if unsure)
+ - preferredSampleRate: the preferred output sample rate (for advanced usage, leave on default if unsure)
+ 
+ @see BLEPOscillatorUnit
+ @ingroup GeneratorUnits */
+template<class SampleType>
+class BLEPSawUnit
+{
+public:    
+    typedef BLEPOscillatorUnit<SampleType>                  OscillatorType;
+    typedef typename OscillatorType::UnitType               UnitType;
+    typedef typename OscillatorType::FrequencyType          FrequencyType;
+    typedef typename OscillatorType::FrequencyUnitType      FrequencyUnitType;
+    
+    static PLONK_INLINE_LOW UnitInfos getInfo() throw()
+    {
+        const double blockSize = (double)BlockSize::getDefault().getValue();
+        const double sampleRate = SampleRate::getDefault().getValue();
+        const double peak = (double)TypeUtility<SampleType>::getTypePeak();
+        
+        return UnitInfo ("BLEPSaw", "A band limited sawtooth oscillator.",
+                         
+                         // output
+                         ChannelCount::VariableChannelCount, 
+                         IOKey::Generic,    Measure::None,      0.0,        IOLimit::Clipped,   Measure::NormalisedBipolar, -peak, peak,
+                         IOKey::End,
+                         
+                         // inputs
+                         IOKey::Frequency,  Measure::Hertz,     440.0,      IOLimit::Clipped,   Measure::SampleRateRatio,  -0.5, 0.5,
+                         IOKey::Sync,       Measure::None,      0.0,        IOLimit::None,
+                         IOKey::Multiply,   Measure::Factor,    1.0,        IOLimit::None,
+                         IOKey::Add,        Measure::None,      0.0,        IOLimit::None,
+                         IOKey::BlockSize,  Measure::Samples,   blockSize,  IOLimit::Minimum,   Measure::Samples,           1.0,
+                         IOKey::SampleRate, Measure::Hertz,     sampleRate, IOLimit::Minimum,   Measure::Hertz,             0.0,
+                         IOKey::End);
+    }
+    
+    /** Create an audio rate band limited sawtooth oscillator. */
+    static UnitType ar (FrequencyUnitType const& frequency = FrequencyType (440), 
+                        UnitType const& sync = SampleType (0),
+                        UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0),
+                        BlockSize const& preferredBlockSize = BlockSize::getDefault(),
+                        SampleRate const& preferredSampleRate = SampleRate::getDefault()) throw()
+    {     
+        return OscillatorType::ar (BLEPShape::Saw, BLEPMode::Poly, frequency, SampleType (0.5), sync, mul, add, preferredBlockSize, preferredSampleRate);
+    }
+    
+    /** Create a control rate band limited sawtooth oscillator. */
+    static UnitType kr (FrequencyUnitType const& frequency, 
+                        UnitType const& sync = SampleType (0),
+                        UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0)) throw()
+    {
+        return OscillatorType::kr (BLEPShape::Saw, BLEPMode::Poly, frequency, SampleType (0.5), sync, mul, add);
+    }        
+};
+
+typedef BLEPSawUnit<PLONK_TYPE_DEFAULT> BLEPSaw;
+
+//------------------------------------------------------------------------------
+
+/** Band limited pulse wave oscillator using PolyBLEP corrections. 
+ 
+ @par Factory functions:
+ - ar (frequency=440, width=0.5, sync=0, mul=1, add=0, preferredBlockSize=default, preferredSampleRate=default)
+ - kr (frequency=440, width=0.5, sync=0, mul=1, add=0) 
+ 
+ @par Inputs:
+ - frequency: (unit, multi) the frequency of the oscillator in Hz
+ - width: (unit, multi) the proportion of the cycle the output is high
+ - sync: (unit, multi) restarts the cycle a sample after each positive going zero crossing
+ - mul: (unit, multi) the multiplier applied to the output
+ - add: (unit, multi) the offset added to the output
+ - preferredBlockSize: the preferred output block size (for advanced usage, leave on default if unsure)
+ - preferredSampleRate: the preferred output sample rate (for advanced usage, leave on default if unsure)
+ 
+ @see BLEPOscillatorUnit
+ @ingroup GeneratorUnits */
+template<class SampleType>
+class BLEPSquareUnit
+{
+public:    
+    typedef BLEPOscillatorUnit<SampleType>                  OscillatorType;
+    typedef typename OscillatorType::UnitType               UnitType;
+    typedef typename OscillatorType::FrequencyType          FrequencyType;
+    typedef typename OscillatorType::FrequencyUnitType      FrequencyUnitType;
+    
+    static PLONK_INLINE_LOW UnitInfos getInfo() throw()
+    {
+        const double blockSize = (double)BlockSize::getDefault().getValue();
+        const double sampleRate = SampleRate::getDefault().getValue();
+        const double peak = (double)TypeUtility<SampleType>::getTypePeak();
+        
+        return UnitInfo ("BLEPSquare", "A band limited pulse wave oscillator.",
+                         
+                         // output
+                         ChannelCount::VariableChannelCount, 
+                         IOKey::Generic,    Measure::None,      0.0,        IOLimit::Clipped,   Measure::NormalisedBipolar, -peak, peak,
+                         IOKey::End,
+                         
+                         // inputs
+                         IOKey::Frequency,  Measure::Hertz,     440.0,      IOLimit::Clipped,   Measure::SampleRateRatio,  -0.5, 0.5,
+                         IOKey::Width,      Measure::NormalisedUnipolar, 0.5, IOLimit::Clipped, Measure::NormalisedUnipolar, 0.0, 1.0,
+                         IOKey::Sync,       Measure::None,      0.0,        IOLimit::None,
+                         IOKey::Multiply,   Measure::Factor,    1.0,        IOLimit::None,
+                         IOKey::Add,        Measure::None,      0.0,        IOLimit::None,
+                         IOKey::BlockSize,  Measure::Samples,   blockSize,  IOLimit::Minimum,   Measure::Samples,           1.0,
+                         IOKey::SampleRate, Measure::Hertz,     sampleRate, IOLimit::Minimum,   Measure::Hertz,             0.0,
+                         IOKey::End);
+    }
+    
+    /** Create an audio rate band limited pulse wave oscillator. */
+    static UnitType ar (FrequencyUnitType const& frequency = FrequencyType (440), 
+                        UnitType const& width = SampleType (0.5),
+                        UnitType const& sync = SampleType (0),
+                        UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0),
+                        BlockSize const& preferredBlockSize = BlockSize::getDefault(),
+                        SampleRate const& preferredSampleRate = SampleRate::getDefault()) throw()
+    {     
+        return OscillatorType::ar (BLEPShape::Square, BLEPMode::Poly, frequency, width, sync, mul, add, preferredBlockSize, preferredSampleRate);
+    }
+    
+    /** Create a control rate band limited pulse wave oscillator. */
+    static UnitType kr (FrequencyUnitType const& frequency, 
+                        UnitType const& width = SampleType (0.5),
+                        UnitType const& sync = SampleType (0),
+                        UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0)) throw()
+    {
+        return OscillatorType::kr (BLEPShape::Square, BLEPMode::Poly, frequency, width, sync, mul, add);
+    }        
+};
+
+typedef BLEPSquareUnit<PLONK_TYPE_DEFAULT> BLEPSquare;
+
+//------------------------------------------------------------------------------
+
+/** Band limited impulse generator using PolyBLEP corrections. 
+ 
+ @par Factory functions:
+ - ar (frequency=440, sync=0, mul=1, add=0, preferredBlockSize=default, preferredSampleRate=default)
+ - kr (frequency=440, sync=0, mul=1, add=0) 
+ 
+ @par Inputs:
+ - frequency: (unit, multi) the frequency of the oscillator in Hz
+ - sync: (unit, multi) restarts the cycle a sample after each positive going zero crossing
+ - mul: (unit, multi) the multiplier applied to the output
+ - add: (unit, multi) the offset added to the output
+ - preferredBlockSize: the preferred output block size (for advanced usage, leave on default if unsure)
+ - preferredSampleRate: the preferred output sample rate (for advanced usage, leave on default if unsure)
+ 
+ @see BLEPOscillatorUnit
+ @ingroup GeneratorUnits */
+template<class SampleType>
+class BLEPImpulseUnit
+{
+public:    
+    typedef BLEPOscillatorUnit<SampleType>                  OscillatorType;
+    typedef typename OscillatorType::UnitType               UnitType;
+    typedef typename OscillatorType::FrequencyType          FrequencyType;
+    typedef typename OscillatorType::FrequencyUnitType      FrequencyUnitType;
+    
+    static PLONK_INLINE_LOW UnitInfos getInfo() throw()
+    {
+        const double blockSize = (double)BlockSize::getDefault().getValue();
+        const double sampleRate = SampleRate::getDefault().getValue();
+        const double peak = (double)TypeUtility<SampleType>::getTypePeak();
+        
+        return UnitInfo ("BLEPImpulse", "A band limited impulse generator.",
+                         
+                         // output
+                         ChannelCount::VariableChannelCount, 
+                         IOKey::Generic,    Measure::None,      0.0,        IOLimit::Clipped,   Measure::NormalisedBipolar, -peak, peak,
+                         IOKey::End,
+                         
+                         // inputs
+                         IOKey::Frequency,  Measure::Hertz,     440.0,      IOLimit::Clipped,   Measure::SampleRateRatio,  -0.5, 0.5,
+                         IOKey::Sync,       Measure::None,      0.0,        IOLimit::None,
+                         IOKey::Multiply,   Measure::Factor,    1.0,        IOLimit::None,
+                         IOKey::Add,        Measure::None,      0.0,        IOLimit::None,
+                         IOKey::BlockSize,  Measure::Samples,   blockSize,  IOLimit::Minimum,   Measure::Samples,           1.0,
+                         IOKey::SampleRate, Measure::Hertz,     sampleRate, IOLimit::Minimum,   Measure::Hertz,             0.0,
+                         IOKey::End);
+    }
+    
+    /** Create an audio rate band limited impulse generator. */
+    static UnitType ar (FrequencyUnitType const& frequency = FrequencyType (440), 
+                        UnitType const& sync = SampleType (0),
+                        UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0),
+                        BlockSize const& preferredBlockSize = BlockSize::getDefault(),
+                        SampleRate const& preferredSampleRate = SampleRate::getDefault()) throw()
+    {     
+        return OscillatorType::ar (BLEPShape::Impulse, BLEPMode::Poly, frequency, SampleType (0.5), sync, mul, add, preferredBlockSize, preferredSampleRate);
+    }
+    
+    /** Create a control rate band limited impulse generator. */
+    static UnitType kr (FrequencyUnitType const& frequency, 
+                        UnitType const& sync = SampleType (0),
+                        UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0)) throw()
+    {
+        return OscillatorType::kr (BLEPShape::Impulse, BLEPMode::Poly, frequency, SampleType (0.5), sync, mul, add);
+    }        
+};
+
+typedef BLEPImpulseUnit<PLONK_TYPE_DEFAULT> BLEPImpulse;
+
+
+#endif // PLONK_BLEPOSCILLATOR_H
@@ -0,0 +1,552 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_BANDLIMITEDTABLE_H
+#define PLONK_BANDLIMITEDTABLE_H
+
+#include "../channel/plonk_ChannelInternalCore.h"
+#include "../plonk_GraphForwardDeclarations.h"
+
+template<class SampleType> class BandlimitedTableChannelInternal;
+
+PLONK_CHANNELDATA_DECLARE(BandlimitedTableChannelInternal,SampleType)
+{    
+    ChannelInternalCore::Data base;
+    double currentPosition;
+    int shape;
+};      
+
+//------------------------------------------------------------------------------
+
+/** Bandlimited wavetable oscillator. 
+ Works like TableChannelInternal but reads from a shared BandlimitedWavetable, 
+ choosing the level once per block from the highest frequency in the block. 
+ The positions for the block are generated first and then looked up together 
+ using the SIMD vector functions. */
+template<class SampleType>
+class BandlimitedTableChannelInternal 
+:   public ChannelInternal<SampleType, PLONK_CHANNELDATA_NAME(BandlimitedTableChannelInternal,SampleType)>
+{
+public:
+    typedef PLONK_CHANNELDATA_NAME(BandlimitedTableChannelInternal,SampleType)  Data;
+    typedef ChannelBase<SampleType>                                             ChannelType;
+    typedef BandlimitedTableChannelInternal<SampleType>                         BandlimitedTableInternal;
+    typedef ChannelInternal<SampleType,Data>                                    Internal;
+    typedef ChannelInternalBase<SampleType>                                     InternalBase;
+    typedef UnitBase<SampleType>                                                UnitType;
+    typedef InputDictionary                                                     Inputs;
+    typedef NumericalArray<SampleType>                                          Buffer;
+    typedef BandlimitedWavetableBase<SampleType>                                WavetableType;
+    
+    typedef typename TypeUtility<SampleType>::IndexType         FrequencyType;
+    typedef UnitBase<FrequencyType>                             FrequencyUnitType;
+    typedef NumericalArray<FrequencyType>                       FrequencyBufferType;
+
+    BandlimitedTableChannelInternal (Inputs const& inputs, 
+                                     Data const& data, 
+                                     BlockSize const& blockSize,
+                                     SampleRate const& sampleRate) throw()
+    :   Internal (inputs, data, blockSize, sampleRate),
+        table (WavetableType::getShared (BandlimitedShape::Shape (data.shape)))
+    {
+    }
+            
+    Text getName() const throw()
+    {
+        return "Bandlimited Table";
+    }       
+    
+    IntArray getInputKeys() const throw()
+    {
+        const IntArray keys (IOKey::Frequency);
+        return keys;
+    }    
+    
+    InternalBase* getChannel (const int index) throw()
+    {
+        const Inputs channelInputs = this->getInputs().getChannel (index);
+        return new BandlimitedTableInternal (channelInputs, 
+                                             this->getState(), 
+                                             this->getBlockSize(), 
+                                             this->getSampleRate());
+    }
+    
+    void initChannel (const int channel) throw()
+    {        
+        const FrequencyUnitType& frequencyUnit = ChannelInternalCore::getInputAs<FrequencyUnitType> (IOKey::Frequency);
+        
+        this->setBlockSize (BlockSize::decide (frequencyUnit.getBlockSize (channel),
+                                               this->getBlockSize()));
+        this->setSampleRate (SampleRate::decide (frequencyUnit.getSampleRate (channel),
+                                                 this->getSampleRate()));
+        
+        this->setOverlap (frequencyUnit.getOverlap (channel));
+        
+        this->initValue (SampleType (0));
+    }    
+    
+    void process (ProcessInfo& info, const int channel) throw()
+    {        
+        Data& data = this->getState();
+        const double sampleDuration = data.base.sampleDuration;
+
+        FrequencyUnitType& frequencyUnit = ChannelInternalCore::getInputAs<FrequencyUnitType> (IOKey::Frequency);
+        const FrequencyBufferType& frequencyBuffer (frequencyUnit.process (info, channel));
+        
+        SampleType* const outputSamples = this->getOutputSamples();
+        const int outputBufferLength = this->getOutputBuffer().length();
+        
+        const FrequencyType* const frequencySamples = frequencyBuffer.getArray();
+        const int frequencyBufferLength = frequencyBuffer.length();
+        
+        if (positions.length() != outputBufferLength)
+        {
+            positions.setSize (outputBufferLength, false);
+            scratch.setSize (outputBufferLength, false);
+        }
+        
+        SampleType* const positionSamples = positions.getArray();
+        const double tableLength = double (table.getTableLength());
+        const double tableLengthOverSampleRate = tableLength * sampleDuration;
+        
+        double currentPosition = data.currentPosition;
+        FrequencyType maxFrequency (0);
+        int i;
+        
+        for (i = 0; i < frequencyBufferLength; ++i)
+            maxFrequency = plonk::max (maxFrequency, plonk::abs (frequencySamples[i]));
+        
+        int level;
+        SampleType fade;
+        table.selectLevel (maxFrequency * sampleDuration, level, fade);
+        
+        if (frequencyBufferLength == outputBufferLength)
+        {
+            for (i = 0; i < outputBufferLength; ++i) 
+            {
+                positionSamples[i] = SampleType (currentPosition);
+                currentPosition += frequencySamples[i] * tableLengthOverSampleRate;
+                
+                if (currentPosition >= tableLength)
+                    currentPosition -= tableLength;
+                else if (currentPosition < 0.0)	
+                    currentPosition += tableLength;                
+            }                    
+        }
+        else if (frequencyBufferLength == 1)
+        {
+            const double valueIncrement (frequencySamples[0] * tableLengthOverSampleRate);
+            
+            if (valueIncrement > 0.0)
+            {
+                for (i = 0; i < outputBufferLength; ++i) 
+                {
+                    positionSamples[i] = SampleType (currentPosition);
+                    currentPosition += valueIncrement;
+                    
+                    if (currentPosition >= tableLength)
+                        currentPosition -= tableLength;
+                }            
+            }
+            else
+            {
+                for (i = 0; i < outputBufferLength; ++i) 
+                {
+                    positionSamples[i] = SampleType (currentPosition);
+                    currentPosition += valueIncrement;
+                    
+                    if (currentPosition < 0.0)	
+                        currentPosition += tableLength;                
+                }            
+            }
+        }
+        else
+        {
+            double frequencyPosition = 0.0;
+            const double frequencyIncrement = double (frequencyBufferLength) / double (outputBufferLength);
+            
+            for (i = 0; i < outputBufferLength; ++i) 
+            {
+                positionSamples[i] = SampleType (currentPosition);
+                currentPosition += frequencySamples[int (frequencyPosition)] * tableLengthOverSampleRate;
+                
+                if (currentPosition >= tableLength)
+                    currentPosition -= tableLength;
+                else if (currentPosition < 0.0)	
+                    currentPosition += tableLength;                
+                
+                frequencyPosition += frequencyIncrement;
+            }        
+        }
+        
+        table.lookup (outputSamples, positionSamples, scratch.getArray(), level, fade, outputBufferLength);
+        
+        data.currentPosition = currentPosition;
+    }
+    
+private:
+    const WavetableType& table;
+    Buffer positions;
+    Buffer scratch;
+};
+
+//------------------------------------------------------------------------------
+
+/** Bandlimited wavetable oscillator. 
+ Unlike TableUnit (and HarmonicSawUnit etc.) this does not alias at high 
+ frequencies nor lose harmonics at low frequencies. 
+ 
+ @par Factory functions:
+ - ar (shape, frequency=440, mul=1, add=0, preferredBlockSize=default, preferredSampleRate=default)
+ - kr (shape, frequency=440, mul=1, add=0) 
+ 
+ @par Inputs:
+ - shape: (BandlimitedShape::Shape) the waveform to use for the oscillator
+ - frequency: (unit, multi) the frequency of the oscillator in Hz
+ - mul: (unit, multi) the multiplier applied to the output
+ - add: (unit, multi) the offset added to the output
+ - preferredBlockSize: the preferred output block size (for advanced usage, leave on default if unsure)
+ - preferredSampleRate: the preferred output sample rate (for advanced usage, leave on default if unsure)
+
+ @see BandlimitedWavetableBase
+ @ingroup GeneratorUnits ControlUnits */
+template<class SampleType>
+class BandlimitedTableUnit
+{
+public:    
+    typedef BandlimitedTableChannelInternal<SampleType> BandlimitedTableInternal;
+    typedef typename BandlimitedTableInternal::Data     Data;
+    typedef ChannelBase<SampleType>                     ChannelType;
+    typedef ChannelInternal<SampleType,Data>            Internal;
+    typedef UnitBase<SampleType>                        UnitType;
+    typedef InputDictionary                             Inputs;
+    typedef BandlimitedWavetableBase<SampleType>        WavetableType;
+    
+    typedef typename BandlimitedTableInternal::FrequencyType         FrequencyType;
+    typedef typename BandlimitedTableInternal::FrequencyUnitType     FrequencyUnitType;
+    typedef typename BandlimitedTableInternal::FrequencyBufferType   FrequencyBufferType;
+    
+    static PLONK_INLINE_LOW UnitInfos getInfo() throw()
+    {
+        const double blockSize = (double)BlockSize::getDefault().getValue();
+        const double sampleRate = SampleRate::getDefault().getValue();
+        
+        return UnitInfo ("BandlimitedTable", "A bandlimited wavetable oscillator.",
+                         
+                         // output
+                         ChannelCount::VariableChannelCount, 
+                         IOKey::Generic,    Measure::None,      0.0,        IOLimit::None,
+                         IOKey::End,
+                         
+                         // inputs
+                         IOKey::Frequency,  Measure::Hertz,     440.0,      IOLimit::Clipped,   Measure::SampleRateRatio,  -0.5, 0.5,
+                         IOKey::Multiply,   Measure::Factor,    1.0,        IOLimit::None,
+                         IOKey::Add,        Measure::None,      0.0,        IOLimit::None,
+                         IOKey::BlockSize,  Measure::Samples,   blockSize,  IOLimit::Minimum,   Measure::Samples,           1.0,
+                         IOKey::SampleRate, Measure::Hertz,     sampleRate, IOLimit::Minimum,   Measure::Hertz,             0.0,
+                         IOKey::End);
+    }
+    
+    /** Create an audio rate bandlimited wavetable oscillator. */
+    static UnitType ar (const BandlimitedShape::Shape shape,
+                        FrequencyUnitType const& frequency = FrequencyType (440), 
+                        UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0),
+                        BlockSize const& preferredBlockSize = BlockSize::getDefault(),
+                        SampleRate const& preferredSampleRate = SampleRate::getDefault()) throw()
+    {             
+        // build the shared table now rather than on the audio thread
+        WavetableType::getShared (shape);
+        
+        Inputs inputs;
+        inputs.put (IOKey::Frequency, frequency);
+        inputs.put (IOKey::Multiply, mul);
+        inputs.put (IOKey::Add, add);
+                        
+        Data data;
+        Memory::zero (data);
+        data.base.sampleRate = -1.0;
+        data.base.sampleDuration = -1.0;
+        data.shape = shape;
+        
+        return UnitType::template createFromInputs<BandlimitedTableInternal> (inputs, 
+                                                                              data, 
+                                                                              preferredBlockSize, 
+                                                                              preferredSampleRate);
+    }
+    
+    /** Create a control rate bandlimited wavetable oscillator. */
+    static UnitType kr (const BandlimitedShape::Shape shape,
+                        FrequencyUnitType const& frequency, 
+                        UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0)) throw()
+    {
+        return ar (shape, frequency, mul, add, 
+                   BlockSize::getControlRateBlockSize(), 
+                   SampleRate::getControlRate());
+    }        
+};
+
+typedef BandlimitedTableUnit<PLONK_TYPE_DEFAULT> BandlimitedTable;
+
+//------------------------------------------------------------------------------
+
+/** Bandlimited sawtooth oscillator. 
+ 
+ @par Factory functions:
+ - ar (frequency=440, mul=1, add=0, preferredBlockSize=default, preferredSampleRate=default)
+ - kr (frequency=440, mul=1, add=0) 
+ 
+ @par Inputs:
+ - frequency: (unit, multi) the frequency of the oscillator in Hz
+ - mul: (unit, multi) the multiplier applied to the output
+ - add: (unit, multi) the offset added to the output
+ - preferredBlockSize: the preferred output block size (for advanced usage, leave on default if unsure)
+ - preferredSampleRate: the preferred output sample rate (for advanced usage, leave on default if unsure)
+ 
+ @see BandlimitedTableUnit
+ @ingroup GeneratorUnits */
+template<class SampleType>
+class BandlimitedSawUnit
+{
+public:    
+    typedef BandlimitedTableChannelInternal<SampleType> BandlimitedTableInternal;
+    typedef typename BandlimitedTableInternal::Data     Data;
+    typedef ChannelBase<SampleType>                     ChannelType;
+    typedef ChannelInternal<SampleType,Data>            Internal;
+    typedef UnitBase<SampleType>                        UnitType;
+    typedef InputDictionary                             Inputs;
+    typedef BandlimitedTableUnit<SampleType>            TableType;
+    
+    typedef typename BandlimitedTableInternal::FrequencyType         FrequencyType;
+    typedef typename BandlimitedTableInternal::FrequencyUnitType     FrequencyUnitType;
+    typedef typename BandlimitedTableInternal::FrequencyBufferType   FrequencyBufferType;
+
+    static PLONK_INLINE_LOW UnitInfos getInfo() throw()
+    {
+        const double blockSize = (double)BlockSize::getDefault().getValue();
+        const double sampleRate = SampleRate::getDefault().getValue();
+        
+        return UnitInfo ("BandlimitedSaw", "A bandlimited sawtooth oscillator.",
+                         
+                         // output
+                         ChannelCount::VariableChannelCount, 
+                         IOKey::Generic,    Measure::None,      0.0,        IOLimit::None,
+                         IOKey::End,
+                         
+                         // inputs
+                         IOKey::Frequency,  Measure::Hertz,     440.0,      IOLimit::Clipped,   Measure::SampleRateRatio,  -0.5, 0.5,
+                         IOKey::Multiply,   Measure::Factor,    1.0,        IOLimit::None,
+                         IOKey::Add,        Measure::None,      0.0,        IOLimit::None,
+                         IOKey::BlockSize,  Measure::Samples,   blockSize,  IOLimit::Minimum,   Measure::Samples,           1.0,
+                         IOKey::SampleRate, Measure::Hertz,     sampleRate, IOLimit::Minimum,   Measure::Hertz,             0.0,
+                         IOKey::End);
+    }
+    
+    /** Create an audio rate bandlimited sawtooth oscillator. */
+    static UnitType ar (FrequencyUnitType const& frequency = FrequencyType (440), 
+                        UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0),
+                        BlockSize const& preferredBlockSize = BlockSize::getDefault(),
+                        SampleRate const& preferredSampleRate = SampleRate::getDefault()) throw()
+    {     
+        return TableType::ar (BandlimitedShape::Saw, frequency, mul, add, preferredBlockSize, preferredSampleRate);
+    }
+    
+    /** Create a control rate bandlimited sawtooth oscillator. */
+    static UnitType kr (FrequencyUnitType const& frequency, 
+                        UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0)) throw()
+    {
+        return TableType::kr (BandlimitedShape::Saw, frequency, mul, add);
+    }        
+};
+
+typedef BandlimitedSawUnit<PLONK_TYPE_DEFAULT> BandlimitedSaw;
+
+//------------------------------------------------------------------------------
+
+/** Bandlimited square wave oscillator. 
+ 
+ @par Factory functions:
+ - ar (frequency=440, mul=1, add=0, preferredBlockSize=default, preferredSampleRate=default)
+ - kr (frequency=440, mul=1, add=0) 
+ 
+ @par Inputs:
+ - frequency: (unit, multi) the frequency of the oscillator in Hz
+ - mul: (unit, multi) the multiplier applied to the output
+ - add: (unit, multi) the offset added to the output
+ - preferredBlockSize: the preferred output block size (for advanced usage, leave on default if unsure)
+ - preferredSampleRate: the preferred output sample rate (for advanced usage, leave on default if unsure)
+ 
+ @see BandlimitedTableUnit
+ @ingroup GeneratorUnits */
+template<class SampleType>
+class BandlimitedSquareUnit
+{
+public:    
+    typedef BandlimitedTableChannelInternal<SampleType> BandlimitedTableInternal;
+    typedef typename BandlimitedTableInternal::Data     Data;
+    typedef ChannelBase<SampleType>                     ChannelType;
+    typedef ChannelInternal<SampleType,Data>            Internal;
+    typedef UnitBase<SampleType>                        UnitType;
+    typedef InputDictionary                             Inputs;
+    typedef BandlimitedTableUnit<SampleType>            TableType;
+    
+    typedef typename BandlimitedTableInternal::FrequencyType         FrequencyType;
+    typedef typename BandlimitedTableInternal::FrequencyUnitType     FrequencyUnitType;
+    typedef typename BandlimitedTableInternal::FrequencyBufferType   FrequencyBufferType;
+
+    static PLONK_INLINE_LOW UnitInfos getInfo() throw()
+    {
+        const double blockSize = (double)BlockSize::getDefault().getValue();
+        const double sampleRate = SampleRate::getDefault().getValue();
+        
+        return UnitInfo ("BandlimitedSquare", "A bandlimited square wave oscillator.",
+                         
+                         // output
+                         ChannelCount::VariableChannelCount, 
+                         IOKey::Generic,    Measure::None,      0.0,        IOLimit::None,
+                         IOKey::End,
+                         
+                         // inputs
+                         IOKey::Frequency,  Measure::Hertz,     440.0,      IOLimit::Clipped,   Measure::SampleRateRatio,  -0.5, 0.5,
+                         IOKey::Multiply,   Measure::Factor,    1.0,        IOLimit::None,
+                         IOKey::Add,        Measure::None,      0.0,        IOLimit::None,
+                         IOKey::BlockSize,  Measure::Samples,   blockSize,  IOLimit::Minimum,   Measure::Samples,           1.0,
+                         IOKey::SampleRate, Measure::Hertz,     sampleRate, IOLimit::Minimum,   Measure::Hertz,             0.0,
+                         IOKey::End);
+    }
+    
+    /** Create an audio rate bandlimited square wave oscillator. */
+    static UnitType ar (FrequencyUnitType const& frequency = FrequencyType (440), 
+                        UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0),
+                        BlockSize const& preferredBlockSize = BlockSize::getDefault(),
+                        SampleRate const& preferredSampleRate = SampleRate::getDefault()) throw()
+    {     
+        return TableType::ar (BandlimitedShape::Square, frequency, mul, add, preferredBlockSize, preferredSampleRate);
+    }
+    
+    /** Create a control rate bandlimited square wave oscillator. */
+    static UnitType kr (FrequencyUnitType const& frequency, 
+                        UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0)) throw()
+    {
+        return TableType::kr (BandlimitedShape::Square, frequency, mul, add);
+    }        
+};
+
+typedef BandlimitedSquareUnit<PLONK_TYPE_DEFAULT> BandlimitedSquare;
+
+//------------------------------------------------------------------------------
+
+/** Bandlimited triangle wave oscillator. 
+ 
+ @par Factory functions:
+ - ar (frequency=440, mul=1, add=0, preferredBlockSize=default, preferredSampleRate=default)
+ - kr (frequency=440, mul=1, add=0) 
+ 
+ @par Inputs:
+ - frequency: (unit, multi) the frequency of the oscillator in Hz
+ - mul: (unit, multi) the multiplier applied to the output
+ - add: (unit, multi) the offset added to the output
+ - preferredBlockSize: the preferred output block size (for advanced usage, leave on default if unsure)
+ - preferredSampleRate: the preferred output sample rate (for advanced usage, leave on default if unsure)
+ 
+ @see BandlimitedTableUnit
+ @ingroup GeneratorUnits */
+template<class SampleType>
+class BandlimitedTriUnit
+{
+public:    
+    typedef BandlimitedTableChannelInternal<SampleType> BandlimitedTableInternal;
+    typedef typename BandlimitedTableInternal::Data     Data;
+    typedef ChannelBase<SampleType>                     ChannelType;
+    typedef ChannelInternal<SampleType,Data>            Internal;
+    typedef UnitBase<SampleType>                        UnitType;
+    typedef InputDictionary                             Inputs;
+    typedef BandlimitedTableUnit<SampleType>            TableType;
+    
+    typedef typename BandlimitedTableInternal::FrequencyType         FrequencyType;
+    typedef typename BandlimitedTableInternal::FrequencyUnitType     FrequencyUnitType;
+    typedef typename BandlimitedTableInternal::FrequencyBufferType   FrequencyBufferType;
+
+    static PLONK_INLINE_LOW UnitInfos getInfo() throw()
+    {
+        const double blockSize = (double)BlockSize::getDefault().getValue();
+        const double sampleRate = SampleRate::getDefault().getValue();
+        
+        return UnitInfo ("BandlimitedTri", "A bandlimited triangle wave oscillator.",
+                         
+                         // output
+                         ChannelCount::VariableChannelCount, 
+                         IOKey::Generic,    Measure::None,      0.0,        IOLimit::None,
+                         IOKey::End,
+                         
+                         // inputs
+                         IOKey::Frequency,  Measure::Hertz,     440.0,      IOLimit::Clipped,   Measure::SampleRateRatio,  -0.5, 0.5,
+                         IOKey::Multiply,   Measure::Factor,    1.0,        IOLimit::None,
+                         IOKey::Add,        Measure::None,      0.0,        IOLimit::None,
+                         IOKey::BlockSize,  Measure::Samples,   blockSize,  IOLimit::Minimum,   Measure::Samples,           1.0,
+                         IOKey::SampleRate, Measure::Hertz,     sampleRate, IOLimit::Minimum,   Measure::Hertz,             0.0,
+                         IOKey::End);
+    }
+    
+    /** Create an audio rate bandlimited triangle wave oscillator. */
+    static UnitType ar (FrequencyUnitType const& frequency = FrequencyType (440), 
+                        UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0),
+                        BlockSize const& preferredBlockSize = BlockSize::getDefault(),
+                        SampleRate const& preferredSampleRate = SampleRate::getDefault()) throw()
+    {     
+        return TableType::ar (BandlimitedShape::Tri, frequency, mul, add, preferredBlockSize, preferredSampleRate);
+    }
+    
+    /** Create a control rate bandlimited triangle wave oscillator. */
+    static UnitType kr (FrequencyUnitType const& frequency, 
+                        UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0)) throw()
+    {
+        return TableType::kr (BandlimitedShape::Tri, frequency, mul, add);
+    }        
+};
+
+typedef BandlimitedTriUnit<PLONK_TYPE_DEFAULT> BandlimitedTri;
+
+#endif // PLONK_BANDLIMITEDTABLE_H
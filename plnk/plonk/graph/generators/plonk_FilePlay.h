@@ -470,6 +470,44 @@ public:
                 return ResampleType::ar (task, rate);
             }
         };
+        
+        /** Like HQ but resamples using a bandlimited windowed-sinc kernel.
+         The template parameter selects the quality preset, 
+         e.g., FilePlay::Simple::Sinc<SincQuality::Best>::ar (file). */
+        template<SincQuality::Preset Quality = SincQuality::Medium>
+        class Sinc
+        {
+        public:
+            typedef InputTaskUnit<SampleType,Interp::Lagrange3>     TaskType;
+            typedef SincResampleUnit<SampleType,Quality>            ResampleType;
+            typedef typename ResampleType::RateType                 RateType;
+            typedef typename ResampleType::RateUnitType             RateUnitType;
+            
+            static UnitType ar (AudioFileReader const& file,
+                                RateUnitType const& rate = Math<RateUnitType>::get1(),
+                                IntVariable const& loopCount = 0,
+                                const int blockSizeMultiplier = 0,
+                                const int numBuffers = 16)
+            {
+                double fileSampleRate = file.getSampleRate();
+                
+                if (fileSampleRate <= 0.0)
+                    fileSampleRate = file.getDefaultSampleRate();
+                
+                const DoubleVariable multiplier = blockSizeMultiplier <= 0 ?
+                                                  (DoubleVariable (fileSampleRate) / SampleRate::getDefault()).ceil() * 2.0 :
+                                                  DoubleVariable (blockSizeMultiplier);
+                
+                UnitType play = FilePlayUnit::ar (file, loopCount,
+                                                  SampleType (1), SampleType (0),
+                                                  true,
+                                                  BlockSize::getMultipleOfDefault (multiplier));
+                
+                UnitType task = TaskType::ar (play, numBuffers);
+                
+                return ResampleType::ar (task, rate);
+            }
+        };
 
     };
 };
@@ -0,0 +1,208 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_GAUSSIANNOISE_H
+#define PLONK_GAUSSIANNOISE_H
+
+#include "../channel/plonk_ChannelInternalCore.h"
+#include "../plonk_GraphForwardDeclarations.h"
+
+template<class SampleType> class GaussianNoiseChannelInternal;
+
+PLONK_CHANNELDATA_DECLARE(GaussianNoiseChannelInternal,SampleType)
+{    
+    ChannelInternalCore::Data base;
+    
+    SampleType deviation;
+    PlankRNGStream rng;
+};              
+
+//------------------------------------------------------------------------------
+
+/** Gaussian noise generator. */
+template<class SampleType>
+class GaussianNoiseChannelInternal 
+:   public ChannelInternal<SampleType, PLONK_CHANNELDATA_NAME(GaussianNoiseChannelInternal,SampleType)>
+{
+public:
+    typedef PLONK_CHANNELDATA_NAME(GaussianNoiseChannelInternal,SampleType) Data;
+    typedef InputDictionary                                                 Inputs;
+    typedef ChannelBase<SampleType>                                         ChannelType;
+    typedef GaussianNoiseChannelInternal<SampleType>                        GaussianNoiseInternal;
+    typedef ChannelInternal<SampleType,Data>                                Internal;
+    typedef ChannelInternalBase<SampleType>                                 InternalBase;
+    typedef UnitBase<SampleType>                                            UnitType;
+    
+    GaussianNoiseChannelInternal (Inputs const& inputs, 
+                                  Data const& data, 
+                                  BlockSize const& blockSize,
+                                  SampleRate const& sampleRate) throw()
+    :   Internal (inputs, data, blockSize, sampleRate)
+    {
+    }
+            
+    Text getName() const throw()
+    {
+        return "Gaussian Noise";
+    }       
+    
+    IntArray getInputKeys() const throw()
+    {
+        const IntArray keys;
+        return keys;
+    }    
+    
+    InternalBase* getChannel (const int /*index*/) throw()
+    {
+        return this;
+    }
+    
+    void initChannel (const int /*channel*/) throw()
+    {                        
+        this->initValue (SampleType (0));
+    }    
+    
+    void process (ProcessInfo& /*info*/, const int /*channel*/) throw()
+    {        
+        Data& data = this->getState();        
+        SampleType* const outputSamples = this->getOutputSamples();
+        const int outputBufferLength = this->getOutputBuffer().length();
+        
+        NumericalArrayFiller<SampleType>::gaussian (data.rng, outputSamples, outputBufferLength, 
+                                                    SampleType (0), data.deviation);
+    }
+};
+
+//------------------------------------------------------------------------------
+
+/** A Gaussian (normally distributed) noise generator. 
+ 
+ For floating point types the output has a mean of zero and a standard deviation 
+ of one so, unlike WhiteNoise, it is not limited to the range -1...+1. Integer 
+ types use a standard deviation of a quarter of the type's peak and are clipped 
+ to the range of the type.
+ 
+ @par Factory functions:
+ - ar (mul=1, add=0, preferredBlockSize=default, preferredSampleRate=default)
+ - kr (mul=1, add=0) 
+ 
+ @par Inputs:
+ - mul: (unit, multi) the multiplier applied to the output
+ - add: (unit, multi) the offset added to the output
+ - preferredBlockSize: the preferred output block size (for advanced usage, leave on default if unsure)
+ - preferredSampleRate: the preferred output sample rate (for advanced usage, leave on default if unsure)
+
+ @ingroup GeneratorUnits ControlUnits */
+template<class SampleType>
+class GaussianNoiseUnit
+{
+public:    
+    typedef GaussianNoiseChannelInternal<SampleType>    GaussianNoiseInternal;
+    typedef typename GaussianNoiseInternal::Data        Data;
+    typedef InputDictionary                             Inputs;
+    typedef ChannelBase<SampleType>                     ChannelType;
+    typedef ChannelInternal<SampleType,Data>            Internal;
+    typedef ChannelInternalBase<SampleType>             ChannelInternalType;
+    typedef UnitBase<SampleType>                        UnitType;
+    
+    static PLONK_INLINE_LOW UnitInfos getInfo() throw()
+    {
+        const double blockSize = (double)BlockSize::getDefault().getValue();
+        const double sampleRate = SampleRate::getDefault().getValue();
+        
+        return UnitInfo ("GaussianNoise", "A Gaussian noise generator.",
+                         
+                         // output
+                         ChannelCount::VariableChannelCount, 
+                         IOKey::Generic,    Measure::None,      0.0,        IOLimit::None,
+                         IOKey::End,
+                         
+                         // inputs
+                         IOKey::Multiply,   Measure::Factor,    1.0,        IOLimit::None,
+                         IOKey::Add,        Measure::None,      0.0,        IOLimit::None,
+                         IOKey::BlockSize,  Measure::Samples,   blockSize,  IOLimit::Minimum,   Measure::Samples,           1.0,
+                         IOKey::SampleRate, Measure::Hertz,     sampleRate, IOLimit::Minimum,   Measure::Hertz,             0.0,
+                         IOKey::End);
+    }
+    
+    /** Create an audio rate Gaussian noise generator. */
+    static UnitType ar (UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0),
+                        BlockSize const& preferredBlockSize = BlockSize::getDefault(),
+                        SampleRate const& preferredSampleRate = SampleRate::getDefault()) throw()
+    {                                
+        const double peak = (double)TypeUtility<SampleType>::getTypePeak();
+        const SampleType deviation = SampleType (peak > 1.0 ? peak * 0.25 : 1.0);
+        
+        const int numChannels = plonk::max (mul.getNumChannels(), add.getNumChannels());
+        UnitType result (UnitType::withSize (numChannels));
+        
+        Inputs inputs;
+        Data data = { { -1.0, -1.0 }, deviation, { { 0, 0 }, { 0, 0 }, 0, { 0, 0, 0, 0 }, 4 } };
+        
+        RNG rng;
+        rng.seed (RNG::global().uniformInt());
+        
+        for (int i = 0; i < numChannels; ++i) 
+        {
+            rng.split (data.rng, i);
+            ChannelInternalType* internal = new GaussianNoiseInternal (inputs, 
+                                                                       data, 
+                                                                       preferredBlockSize, 
+                                                                       preferredSampleRate);
+            internal->initChannel (i);
+            result.put (i, ChannelType (internal));
+        }
+        
+        return UnitType::applyMulAdd (result, mul, add);
+    }
+    
+    /** Create a control rate Gaussian noise generator. */
+    static UnitType kr (UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0)) throw()
+    {
+        return ar (mul, add, 
+                   BlockSize::getControlRateBlockSize(), 
+                   SampleRate::getControlRate());
+    }        
+};
+
+typedef GaussianNoiseUnit<PLONK_TYPE_DEFAULT> GaussianNoise;
+
+
+#endif // PLONK_GAUSSIANNOISE_H
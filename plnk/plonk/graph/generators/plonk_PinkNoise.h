@@ -0,0 +1,257 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_PINKNOISE_H
+#define PLONK_PINKNOISE_H
+
+#include "../channel/plonk_ChannelInternalCore.h"
+#include "../plonk_GraphForwardDeclarations.h"
+
+template<class SampleType> class PinkNoiseChannelInternal;
+
+PLONK_CHANNELDATA_DECLARE(PinkNoiseChannelInternal,SampleType)
+{    
+    typedef typename TypeUtility<SampleType>::IndexType FilterType;
+    
+    ChannelInternalCore::Data base;
+    
+    FilterType b[7];
+    PlankRNGStream rng;
+};              
+
+//------------------------------------------------------------------------------
+
+/** Pink noise generator. 
+ This filters blocks of white noise with Paul Kellet's "refined" -3dB/octave 
+ filter which is accurate to within +/-0.05dB above 9.2Hz at 44.1kHz. */
+template<class SampleType>
+class PinkNoiseChannelInternal 
+:   public ChannelInternal<SampleType, PLONK_CHANNELDATA_NAME(PinkNoiseChannelInternal,SampleType)>
+{
+public:
+    typedef PLONK_CHANNELDATA_NAME(PinkNoiseChannelInternal,SampleType)     Data;
+    typedef typename Data::FilterType                                       FilterType;
+    typedef InputDictionary                                                 Inputs;
+    typedef ChannelBase<SampleType>                                         ChannelType;
+    typedef PinkNoiseChannelInternal<SampleType>                            PinkNoiseInternal;
+    typedef ChannelInternal<SampleType,Data>                                Internal;
+    typedef ChannelInternalBase<SampleType>                                 InternalBase;
+    typedef UnitBase<SampleType>                                            UnitType;
+    
+    enum Constants { WhiteBufferLength = 64 };
+    
+    PinkNoiseChannelInternal (Inputs const& inputs, 
+                              Data const& data, 
+                              BlockSize const& blockSize,
+                              SampleRate const& sampleRate) throw()
+    :   Internal (inputs, data, blockSize, sampleRate)
+    {
+    }
+            
+    Text getName() const throw()
+    {
+        return "Pink Noise";
+    }       
+    
+    IntArray getInputKeys() const throw()
+    {
+        const IntArray keys;
+        return keys;
+    }    
+    
+    InternalBase* getChannel (const int /*index*/) throw()
+    {
+        return this;
+    }
+    
+    void initChannel (const int /*channel*/) throw()
+    {                        
+        this->initValue (SampleType (0));
+    }    
+    
+    void process (ProcessInfo& /*info*/, const int /*channel*/) throw()
+    {        
+        Data& data = this->getState();        
+        SampleType* const outputSamples = this->getOutputSamples();
+        const int outputBufferLength = this->getOutputBuffer().length();
+        
+        const FilterType peak = FilterType (TypeUtility<SampleType>::getTypePeak());
+        const FilterType one = FilterType (1);
+        FilterType white[WhiteBufferLength];
+        
+        FilterType b0 = data.b[0];
+        FilterType b1 = data.b[1];
+        FilterType b2 = data.b[2];
+        FilterType b3 = data.b[3];
+        FilterType b4 = data.b[4];
+        FilterType b5 = data.b[5];
+        FilterType b6 = data.b[6];
+        
+        int numChunkSamples;
+        
+        for (int i = 0; i < outputBufferLength; i += numChunkSamples)
+        {
+            numChunkSamples = plonk::min (outputBufferLength - i, int (WhiteBufferLength));
+            NumericalArrayFiller<FilterType>::rand (data.rng, white, numChunkSamples, -one, one);
+            
+            for (int j = 0; j < numChunkSamples; ++j)
+            {
+                const FilterType w = white[j];
+                
+                b0 = FilterType (0.99886) * b0 + w * FilterType (0.0555179);
+                b1 = FilterType (0.99332) * b1 + w * FilterType (0.0750759);
+                b2 = FilterType (0.96900) * b2 + w * FilterType (0.1538520);
+                b3 = FilterType (0.86650) * b3 + w * FilterType (0.3104856);
+                b4 = FilterType (0.55000) * b4 + w * FilterType (0.5329522);
+                b5 = FilterType (-0.7616) * b5 - w * FilterType (0.0168980);
+                
+                const FilterType pink = (b0 + b1 + b2 + b3 + b4 + b5 + b6 + w * FilterType (0.5362)) * FilterType (0.11);
+                b6 = w * FilterType (0.115926);
+                
+                outputSamples[i + j] = SampleType (plonk::clip (pink, -one, one) * peak);
+            }
+        }
+        
+        data.b[0] = b0;
+        data.b[1] = b1;
+        data.b[2] = b2;
+        data.b[3] = b3;
+        data.b[4] = b4;
+        data.b[5] = b5;
+        data.b[6] = b6;
+    }
+};
+
+//------------------------------------------------------------------------------
+
+/** A pink noise generator. 
+ 
+ Pink noise has equal energy per octave (i.e., a -3dB/octave spectrum). The 
+ filter is designed for sample rates around 44.1kHz-48kHz, the output is 
+ approximately in the range -1...+1 and clipped to that range.
+ 
+ @par Factory functions:
+ - ar (mul=1, add=0, preferredBlockSize=default, preferredSampleRate=default)
+ - kr (mul=1, add=0) 
+ 
+ @par Inputs:
+ - mul: (unit, multi) the multiplier applied to the output
+ - add: (unit, multi) the offset added to the output
+ - preferredBlockSize: the preferred output block size (for advanced usage, leave on default if unsure)
+ - preferredSampleRate: the preferred output sample rate (for advanced usage, leave on default if unsure)
+
+ @ingroup GeneratorUnits ControlUnits */
+template<class SampleType>
+class PinkNoiseUnit
+{
+public:    
+    typedef PinkNoiseChannelInternal<SampleType>    PinkNoiseInternal;
+    typedef typename PinkNoiseInternal::Data        Data;
+    typedef InputDictionary                         Inputs;
+    typedef ChannelBase<SampleType>                 ChannelType;
+    typedef ChannelInternal<SampleType,Data>        Internal;
+    typedef ChannelInternalBase<SampleType>         ChannelInternalType;
+    typedef UnitBase<SampleType>                    UnitType;
+    
+    static PLONK_INLINE_LOW UnitInfos getInfo() throw()
+    {
+        const double blockSize = (double)BlockSize::getDefault().getValue();
+        const double sampleRate = SampleRate::getDefault().getValue();
+        const double peak = (double)TypeUtility<SampleType>::getTypePeak(); // will be innaccurate for LongLong
+        
+        return UnitInfo ("PinkNoise", "A pink noise generator.",
+                         
+                         // output
+                         ChannelCount::VariableChannelCount, 
+                         IOKey::Generic,    Measure::None,      0.0,        IOLimit::Clipped,   Measure::NormalisedBipolar, -peak, peak,
+                         IOKey::End,
+                         
+                         // inputs
+                         IOKey::Multiply,   Measure::Factor,    1.0,        IOLimit::None,
+                         IOKey::Add,        Measure::None,      0.0,        IOLimit::None,
+                         IOKey::BlockSize,  Measure::Samples,   blockSize,  IOLimit::Minimum,   Measure::Samples,           1.0,
+                         IOKey::SampleRate, Measure::Hertz,     sampleRate, IOLimit::Minimum,   Measure::Hertz,             0.0,
+                         IOKey::End);
+    }
+    
+    /** Create an audio rate pink noise generator. */
+    static UnitType ar (UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0),
+                        BlockSize const& preferredBlockSize = BlockSize::getDefault(),
+                        SampleRate const& preferredSampleRate = SampleRate::getDefault()) throw()
+    {                                
+        const int numChannels = plonk::max (mul.getNumChannels(), add.getNumChannels());
+        UnitType result (UnitType::withSize (numChannels));
+        
+        Inputs inputs;
+        Data data;
+        Memory::zero (data);
+        data.base.sampleRate = -1.0;
+        data.base.sampleDuration = -1.0;
+        
+        RNG rng;
+        rng.seed (RNG::global().uniformInt());
+        
+        for (int i = 0; i < numChannels; ++i) 
+        {
+            rng.split (data.rng, i);
+            ChannelInternalType* internal = new PinkNoiseInternal (inputs, 
+                                                                   data, 
+                                                                   preferredBlockSize, 
+                                                                   preferredSampleRate);
+            internal->initChannel (i);
+            result.put (i, ChannelType (internal));
+        }
+        
+        return UnitType::applyMulAdd (result, mul, add);
+    }
+    
+    /** Create a control rate pink noise generator. */
+    static UnitType kr (UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0)) throw()
+    {
+        return ar (mul, add, 
+                   BlockSize::getControlRateBlockSize(), 
+                   SampleRate::getControlRate());
+    }        
+};
+
+typedef PinkNoiseUnit<PLONK_TYPE_DEFAULT> PinkNoise;
+
+
+#endif // PLONK_PINKNOISE_H
@@ -50,7 +50,7 @@ PLONK_CHANNELDATA_DECLARE(WhiteNoiseChannelInternal,SampleType)
     
     SampleType minValue;
     SampleType maxValue;
-    PlankRNG rng;
+    PlankRNGStream rng;
 };              
 
 PLONK_CHANNELDATA_SPECIAL(WhiteNoiseChannelInternal,short)
@@ -59,7 +59,7 @@ PLONK_CHANNELDATA_SPECIAL(WhiteNoiseChannelInternal,short)
     
     int minValue;
     int maxValue;
-    PlankRNG rng;
+    PlankRNGStream rng;
 };      
 
 //------------------------------------------------------------------------------
@@ -84,7 +84,6 @@ public:
                                SampleRate const& sampleRate) throw()
     :   Internal (inputs, data, blockSize, sampleRate)
     {
-        rng.seed (data.rng.value);
     }
             
     Text getName() const throw()
@@ -114,12 +113,9 @@ public:
         SampleType* const outputSamples = this->getOutputSamples();
         const int outputBufferLength = this->getOutputBuffer().length();
         
-        for (int i = 0; i < outputBufferLength; ++i) 
-            outputSamples[i] = SampleType (rng.uniform (data.minValue, data.maxValue));
+        NumericalArrayFiller<SampleType>::rand (data.rng, outputSamples, outputBufferLength, 
+                                                SampleType (data.minValue), SampleType (data.maxValue));
     }
-    
-private:
-    RNG rng;
 };
 
 //------------------------------------------------------------------------------
@@ -251,13 +247,15 @@ public:
         UnitType result (UnitType::withSize (numChannels));
         
         Inputs inputs;
+        Data data = { { -1.0, -1.0 }, -peak, peak };
+        
+        // each channel gets its own stream split from a freshly seeded parent
+        RNG rng;
+        rng.seed (RNG::global().uniformInt());
         
         for (int i = 0; i < numChannels; ++i) 
         {
-            PlankRNG rng;
-            pl_RNG_Init (&rng);
-            pl_RNG_Seed (&rng, RNG::global().uniformInt());
-            Data data = { { -1.0, -1.0 }, -peak, peak, rng };
+            rng.split (data.rng, i);
             ChannelInternalType* internal = new WhiteNoiseInternal (inputs, 
                                                                     data, 
                                                                     preferredBlockSize, 
@@ -79,6 +79,8 @@ IOKey::Name IOKey::fromInt (const int value) throw()
         IOKey::Loop,
         IOKey::Minimum,
         IOKey::Maximum,
+        IOKey::Width,
+        IOKey::Sync,
         IOKey::BlockSize,
         IOKey::SampleRate,
         IOKey::FilterSampleRate,
@@ -158,7 +160,7 @@ Text IOKey::getName (const int keyIndex) throw()
         "Decay",
         "Release",
         "Feedback",
-        "Feedforward"
+        "Feedforward",
         "Coeffs",
         
         "FFTPacked",
@@ -169,6 +171,8 @@ Text IOKey::getName (const int keyIndex) throw()
         "Loop",
         "Minimum",
         "Maximum",
+        "Width",
+        "Sync",
         
         "Block Size",
         "Sample Rate",
@@ -249,6 +253,8 @@ IOKey::IOType IOKey::getType (const int keyIndex) throw()
         IOKey::TypeUnit,            //"Loop",
         IOKey::TypeUnit,            //"Minimum",
         IOKey::TypeUnit,            //"Maximum",
+        IOKey::TypeUnit,            //"Width",
+        IOKey::TypeUnit,            //"Sync",
         
         IOKey::TypeBlockSize,       //"BlockSize"
         IOKey::TypeSampleRate,      //"SampleRate"
@@ -330,6 +336,8 @@ Text IOKey::getTypeName (const int keyIndex) throw()
         "Unit",             //"Loop",
         "Unit",             //"Minimum",
         "Unit",             //"Maximum",
+        "Unit",             //"Width",
+        "Unit",             //"Sync",
         
         "BlockSize",        //"BlockSize"
         "SampleRate",       //"SampleRate"
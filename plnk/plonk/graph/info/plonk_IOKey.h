@@ -118,6 +118,8 @@ public:
         Loop,           ///< Loop control.
         Minimum,        ///< A minimum (e.g., threshold)
         Maximum,        ///< A maximum (e.g., threshold)
+        Width,          ///< Width, e.g., the proportion of a cycle a pulse wave is high.
+        Sync,           ///< Sync control, e.g., restarting an oscillator's cycle.
         
         BlockSize,          ///< Audio processing block size.
         SampleRate,         ///< Audio processing sample rate.
@@ -54,6 +54,8 @@ class ProcessInfo;
 class ProcessInfoInternal;
 class TimeStamp;
 class InputDictionary;
+class ParallelRenderer;
+class TaskPool;
 
 // info
 class IOKey;
@@ -70,6 +72,8 @@ template<class SampleType>                                              class Ch
 template<class SampleType>                                              class ChannelInternalBase;
 template<class SampleType, class DataType>                              class ChannelInternal;
 template<class SampleType>                                              class UnitBase;
+template<class SampleType>                                              class BufferPlannerBase;
+template<class SampleType>                                              class GraphSnapshotBase;
 template<class SampleType, class DataType>                              class ProxyOwnerChannelInternal;
 template<class SampleType>                                              class ProxyChannelInternal;
 template<class OwnerType>                                               struct ChannelData;
@@ -81,11 +85,16 @@ template<class SampleType>                                              class Nu
 template<class SampleType, PLONK_BINARYOPFUNCTION(SampleType, op)>      class BinaryOpChannelInternal;
 template<class SampleType, PLONK_UNARYOPFUNCTION(SampleType, op)>       class UnaryOpChannelInternal;
 template<class SampleType>                                              class MulAddChannelInternal;
+template<class SampleType>                                              class FusedOpChannelInternal;
+template<class SampleType>                                              struct FusedOpInfo;
 
 // common units
 template<class SampleType>                                              class MulAddUnit;
+template<class SampleType>                                              class FusedOpUnit;
 template<class SampleType>                                              class ReblockUnit;
 template<class SampleType,Interp::TypeCode>                             class ResampleUnit;
+template<class SampleType,
+         SincQuality::Preset Quality = SincQuality::Medium>              class SincResampleUnit;
 template<class SampleType>                                              class MixerUnit;
 template<class SampleType>                                              class OverlapMakeUnit;
 template<class SampleType>                                              class OverlapMixUnit;
@@ -250,5 +259,11 @@ typedef LockFreeQueue< QueueBufferBase<Int24> >                    Int24BufferQu
 typedef LockFreeQueue< QueueBufferBase<Long> >                     LongBufferQueue;
 typedef LockFreeQueue< QueueBufferBase<PLONK_TYPE_DEFAULT> >       BufferQueue;
 
+template<class SampleType>                                  class PolyVoicesInternal;
+template<class SampleType>                                  class PolyVoices;
+typedef PolyVoices<float>                                   FloatVoices;
+typedef PolyVoices<double>                                  DoubleVoices;
+typedef PolyVoices<PLONK_TYPE_DEFAULT>                      Voices;
+
 
 #endif // PLONK_GRAPHFORWARDDECLARATIONS_H
\ No newline at end of file
@@ -775,6 +775,13 @@ public:
         return MixerUnit<SampleType>::ar (*this, false);
     }
     
+    /** Evaluates the chain of element-wise operators that produce this unit in a single pass.
+     @see FusedOpUnit */
+    PLONK_INLINE_LOW UnitBase fuse() const throw()
+    {
+        return FusedOpUnit<SampleType>::ar (*this);
+    }
+    
     PLONK_INLINE_LOW UnitBase diff() const throw()
     {
         return DiffUnit<SampleType>::ar (*this);
@@ -159,6 +159,16 @@ public:
                                      this->getSampleRate());
     }        
     
+    bool getFusedOp (FusedOpInfo<SampleType>& info) throw()
+    {
+        info.numSteps = 1;
+        info.numInputs = 2;
+        info.steps[0] = FusedOpStep<SampleType>::template binaryStep<op> (-1, -2);
+        info.inputs[0] = &this->getInputAsUnit (IOKey::LeftOperand);
+        info.inputs[1] = &this->getInputAsUnit (IOKey::RightOperand);
+        return true;
+    }
+    
     void initChannel(const int channel) throw()
     {
         const UnitType& leftUnit = this->getInputAsUnit (IOKey::LeftOperand);
@@ -96,6 +96,15 @@
         return new BinaryOpInternal (channelInputs, this->getState(), this->getBlockSize(), this->getSampleRate());\
     }\
     \
+    bool getFusedOp (FusedOpInfo<float>& info) throw() {\
+        info.numSteps = 1;\
+        info.numInputs = 2;\
+        info.steps[0] = FusedOpStep<float>::binaryStep<BinaryOpFunctionsType::PLONKOP> (-1, -2);\
+        info.inputs[0] = &this->getInputAsUnit (IOKey::LeftOperand);\
+        info.inputs[1] = &this->getInputAsUnit (IOKey::RightOperand);\
+        return true;\
+    }\
+    \
     void initChannel (const int channel) throw() {\
         const UnitType& leftUnit = this->getInputAsUnit (IOKey::LeftOperand);\
         const float leftValue = leftUnit.getValue (channel);\
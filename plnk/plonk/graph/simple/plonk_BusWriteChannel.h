@@ -44,7 +44,7 @@
 
 
 /** Bus write channel. 
- Writes data to a bus. */
+ Writes data to a bus. Each channel has its own writer slot on concurrent busses. */
 template<class SampleType>
 class BusWriteChannelInternal 
 :   public ChannelInternal<SampleType, ChannelInternalCore::Data>
@@ -65,10 +65,17 @@ public:
                              Data const& data, 
                              BlockSize const& blockSize,
                              SampleRate const& sampleRate) throw()
-    :   Internal (inputs, data, blockSize, sampleRate)
+    :   Internal (inputs, data, blockSize, sampleRate),
+        writerBus (Bus::getNull()),
+        writer (-1)
     {
     }
     
+    ~BusWriteChannelInternal()
+    {
+        writerBus.removeWriter (writer);
+    }
+    
     Text getName() const throw()
     {
         const Busses& busses (this->getInputAsBusses (IOKey::Busses));
@@ -109,6 +116,10 @@ public:
     {
         const Busses& busses (this->getInputAsBusses (IOKey::Busses));
         this->setSampleRate (busses.wrapAt (channel).getSampleRate());
+        
+        writerBus.removeWriter (writer);
+        writerBus = busses.wrapAt (channel);
+        writer = writerBus.addWriter();
 
         const UnitType& input = this->getInputAsUnit (IOKey::Generic);
         this->setBlockSize (BlockSize::decide (input.getBlockSize (channel),
@@ -130,6 +141,7 @@ public:
         Bus& bus = busses.wrapAt (channel);
 
         plonk_assert (bus.getSampleRate() == this->getSampleRate());
+        plonk_assert (! bus.isConcurrent() || (bus.getInternal() == writerBus.getInternal())); // slot is for another bus
 
         UnitType& inputUnit (this->getInputAsUnit (IOKey::Generic));
         
@@ -153,10 +165,12 @@ public:
             }        
         }
         
-        bus.write (info.getTimeStamp(), outputBufferLength, outputSamples);
+        bus.write (writer, info.getTimeStamp(), outputBufferLength, outputSamples);
     }
 
 private:
+    Bus writerBus;
+    int writer;
 };
 
 //------------------------------------------------------------------------------
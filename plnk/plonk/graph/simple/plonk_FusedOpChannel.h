@@ -0,0 +1,566 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+
+ http://code.google.com/p/pl-nk/
+
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_FUSEDOPCHANNEL_H
+#define PLONK_FUSEDOPCHANNEL_H
+
+#include "../channel/plonk_ChannelInternalCore.h"
+#include "../plonk_GraphForwardDeclarations.h"
+
+/** One element-wise step of a fused expression.
+ Operands >= 0 refer to the result of an earlier step, operands < 0 refer to
+ an input (the input index is -1 - operand). The kernels are the
+ NumericalArrayUnaryOp and NumericalArrayBinaryOp specialisations for the
+ operator so fused steps use the same vectorised code as the unfused channels.
+ @internal */
+template<class SampleType>
+struct FusedOpStep
+{
+    typedef SampleType (*UnaryFunction)(SampleType const&);
+    typedef SampleType (*BinaryFunction)(SampleType const&, SampleType const&);
+    typedef void (*KernelN)(SampleType*, const SampleType*, const UnsignedLong);
+    typedef void (*KernelNN)(SampleType*, const SampleType*, const SampleType*, const UnsignedLong);
+    typedef void (*KernelN1)(SampleType*, const SampleType*, const SampleType, const UnsignedLong);
+    typedef void (*Kernel1N)(SampleType*, const SampleType, const SampleType*, const UnsignedLong);
+
+    UnaryFunction unary;        // null for binary steps
+    BinaryFunction binary;      // null for unary steps
+    KernelN calcN;
+    KernelNN calcNN;
+    KernelN1 calcN1;
+    Kernel1N calc1N;
+    int operands[2];
+
+    template<PLONK_UNARYOPFUNCTION(SampleType, op)>
+    static FusedOpStep unaryStep (const int operand) throw()
+    {
+        const FusedOpStep step = { op, 0,
+                                   NumericalArrayUnaryOp<SampleType,op>::calc, 0, 0, 0,
+                                   { operand, 0 } };
+        return step;
+    }
+
+    template<PLONK_BINARYOPFUNCTION(SampleType, op)>
+    static FusedOpStep binaryStep (const int leftOperand, const int rightOperand) throw()
+    {
+        const FusedOpStep step = { 0, op, 0,
+                                   NumericalArrayBinaryOp<SampleType,op>::calcNN,
+                                   NumericalArrayBinaryOp<SampleType,op>::calcN1,
+                                   NumericalArrayBinaryOp<SampleType,op>::calc1N,
+                                   { leftOperand, rightOperand } };
+        return step;
+    }
+};
+
+/** Describes an element-wise channel to FusedOpUnit.
+ Channels fill this in from ChannelInternalBase::getFusedOp() with their
+ steps, whose input operands index the channel's own input units.
+ @internal */
+template<class SampleType>
+struct FusedOpInfo
+{
+    enum Constants
+    {
+        MaxSteps = 2,
+        MaxInputs = 3
+    };
+
+    int numSteps;
+    int numInputs;
+    FusedOpStep<SampleType> steps[MaxSteps];
+    UnitBase<SampleType>* inputs[MaxInputs];
+};
+
+//------------------------------------------------------------------------------
+
+template<class SampleType> class FusedOpChannelInternal;
+
+PLONK_CHANNELDATA_DECLARE(FusedOpChannelInternal,SampleType)
+{
+    enum Constants
+    {
+        MaxSteps = 32,
+        MaxInputs = MaxSteps + 1
+    };
+
+    ChannelInternalCore::Data base;
+    int numSteps;
+    FusedOpStep<SampleType> steps[MaxSteps];
+};
+
+//------------------------------------------------------------------------------
+
+/** Evaluates a chain of element-wise operators in one pass.
+ The steps are run over tiles of the block so intermediate results stay in
+ a small set of cache-resident registers rather than each operator writing
+ a full output buffer and being processed through its own channel. */
+template<class SampleType>
+class FusedOpChannelInternal
+:   public ChannelInternal<SampleType, PLONK_CHANNELDATA_NAME(FusedOpChannelInternal,SampleType)>
+{
+public:
+    typedef PLONK_CHANNELDATA_NAME(FusedOpChannelInternal,SampleType)   Data;
+    typedef ChannelBase<SampleType>                                     ChannelType;
+    typedef FusedOpChannelInternal<SampleType>                          FusedOpInternal;
+    typedef ChannelInternal<SampleType,Data>                            Internal;
+    typedef ChannelInternalBase<SampleType>                             InternalBase;
+    typedef UnitBase<SampleType>                                        UnitType;
+    typedef InputDictionary                                             Inputs;
+    typedef NumericalArray<SampleType>                                  Buffer;
+    typedef NumericalArray2D<ChannelType,UnitType>                      UnitsType;
+    typedef FusedOpStep<SampleType>                                     StepType;
+
+    enum Constants
+    {
+        TileSize = 64
+    };
+
+    FusedOpChannelInternal (Inputs const& inputs,
+                            Data const& data,
+                            BlockSize const& blockSize,
+                            SampleRate const& sampleRate) throw()
+    :   Internal (inputs, data, blockSize, sampleRate)
+    {
+    }
+
+    Text getName() const throw()
+    {
+        return "Fused Operators";
+    }
+
+    IntArray getInputKeys() const throw()
+    {
+        const IntArray keys (IOKey::Units);
+        return keys;
+    }
+
+    InternalBase* getChannel (const int index) throw()
+    {
+        const Inputs channelInputs = this->getInputs().getChannel (index);
+        return new FusedOpInternal (channelInputs,
+                                    this->getState(),
+                                    this->getBlockSize(),
+                                    this->getSampleRate());
+    }
+
+    void initChannel (const int channel) throw()
+    {
+        const Data& data = this->getState();
+        const UnitsType& inputs = this->getInputAsUnits (IOKey::Units);
+        const int numInputs = inputs.length();
+
+        plonk_assert (numInputs > 0);
+        plonk_assert (numInputs <= Data::MaxInputs);
+
+        BlockSize blockSize = inputs.atUnchecked (0).getBlockSize (channel);
+        SampleRate sampleRate = inputs.atUnchecked (0).getSampleRate (channel);
+        DoubleVariable overlap = inputs.atUnchecked (0).getOverlap (channel);
+        SampleType inputValues[Data::MaxInputs];
+
+        for (int i = 0; i < numInputs; ++i)
+        {
+            const UnitType& input = inputs.atUnchecked (i);
+
+            blockSize = blockSize.selectMax (input.getBlockSize (channel));
+            sampleRate = sampleRate.selectMax (input.getSampleRate (channel));
+            inputValues[i] = input.getValue (channel);
+
+            if (! input.isConstant (channel))
+                overlap = input.getOverlap (channel);
+        }
+
+        this->setBlockSize (BlockSize::decide (blockSize, this->getBlockSize()));
+        this->setSampleRate (SampleRate::decide (sampleRate, this->getSampleRate()));
+        this->setOverlap (overlap);
+
+        registers = Buffer::newClear (data.numSteps * TileSize);
+
+        // inputs at another block size are stretched into this, sized now so process() doesn't allocate
+        const int blockSizeValue = this->getBlockSize().getValue();
+        bool needsResampling = false;
+
+        for (int i = 0; i < numInputs; ++i)
+        {
+            const int inputBlockSize = inputs.atUnchecked (i).getBlockSize (channel).getValue();
+            needsResampling = needsResampling || ((inputBlockSize != blockSizeValue) && (inputBlockSize != 1));
+        }
+
+        if (needsResampling)
+            resampled = Buffer::newClear (numInputs * blockSizeValue);
+
+        // run the steps once on the input values
+        SampleType stepValues[Data::MaxSteps];
+
+        for (int s = 0; s < data.numSteps; ++s)
+        {
+            const StepType& step = data.steps[s];
+            const int left = step.operands[0];
+            const int right = step.operands[1];
+            const SampleType leftValue = (left >= 0) ? stepValues[left] : inputValues[-1 - left];
+
+            if (step.binary == 0)
+            {
+                stepValues[s] = step.unary (leftValue);
+            }
+            else
+            {
+                const SampleType rightValue = (right >= 0) ? stepValues[right] : inputValues[-1 - right];
+                stepValues[s] = step.binary (leftValue, rightValue);
+            }
+        }
+
+        this->initValue (stepValues[data.numSteps - 1]);
+    }
+
+    /** The steps hold function pointers and are fixed when the unit is
+     built so only the base class blocks are saved, not the Data. */
+    int getNumStateBlocks() const throw()
+    {
+        return InternalBase::getNumStateBlocks();
+    }
+
+    void* getStateBlock (const int index, int& numBytes) throw()
+    {
+        return InternalBase::getStateBlock (index, numBytes);
+    }
+
+    void process (ProcessInfo& info, const int channel) throw()
+    {
+        const Data& data = this->getState();
+        const int numSteps = data.numSteps;
+
+        UnitsType& inputs = this->getInputAsUnits (IOKey::Units);
+        const int numInputs = inputs.length();
+
+        SampleType* const outputSamples = this->getOutputSamples();
+        const int outputBufferLength = this->getOutputBuffer().length();
+        SampleType* const registerSamples = registers.getArray();
+
+        const SampleType* inputSamples[Data::MaxInputs];
+        bool inputIsScalar[Data::MaxInputs];
+        int i, s;
+
+        for (i = 0; i < numInputs; ++i)
+        {
+            const Buffer& inputBuffer (inputs.atUnchecked (i).process (info, channel));
+            const int inputBufferLength = inputBuffer.length();
+
+            inputSamples[i] = inputBuffer.getArray();
+            inputIsScalar[i] = (inputBufferLength == 1) && (outputBufferLength > 1);
+
+            if ((inputBufferLength != outputBufferLength) && (inputBufferLength != 1))
+                inputSamples[i] = resample (i, numInputs, inputSamples[i], inputBufferLength, outputBufferLength);
+        }
+
+        for (int offset = 0; offset < outputBufferLength; offset += TileSize)
+        {
+            const int numTileSamples = plonk::min (int (TileSize), outputBufferLength - offset);
+
+            for (s = 0; s < numSteps; ++s)
+            {
+                const StepType& step = data.steps[s];
+                SampleType* const stepSamples = (s == (numSteps - 1)) ? outputSamples + offset : registerSamples + s * TileSize;
+
+                const int left = step.operands[0];
+                const bool leftIsScalar = (left < 0) && inputIsScalar[-1 - left];
+                const SampleType* const leftSamples = (left >= 0) ? registerSamples + left * TileSize :
+                                                      leftIsScalar ? inputSamples[-1 - left] : inputSamples[-1 - left] + offset;
+
+                if (step.binary == 0)
+                {
+                    if (leftIsScalar)
+                        NumericalArrayFiller<SampleType>::fill (stepSamples, step.unary (leftSamples[0]), numTileSamples);
+                    else
+                        step.calcN (stepSamples, leftSamples, numTileSamples);
+                }
+                else
+                {
+                    const int right = step.operands[1];
+                    const bool rightIsScalar = (right < 0) && inputIsScalar[-1 - right];
+                    const SampleType* const rightSamples = (right >= 0) ? registerSamples + right * TileSize :
+                                                           rightIsScalar ? inputSamples[-1 - right] : inputSamples[-1 - right] + offset;
+
+                    if (leftIsScalar && rightIsScalar)
+                        NumericalArrayFiller<SampleType>::fill (stepSamples, step.binary (leftSamples[0], rightSamples[0]), numTileSamples);
+                    else if (rightIsScalar)
+                        step.calcN1 (stepSamples, leftSamples, rightSamples[0], numTileSamples);
+                    else if (leftIsScalar)
+                        step.calc1N (stepSamples, leftSamples[0], rightSamples, numTileSamples);
+                    else
+                        step.calcNN (stepSamples, leftSamples, rightSamples, numTileSamples);
+                }
+            }
+        }
+    }
+
+private:
+    Buffer registers;
+    Buffer resampled;
+
+    /** Stretch an input at a different block size to ours in the same way the unfused operators do.
+     The buffer is sized by initChannel(), it only grows here if the block sizes change afterwards. */
+    const SampleType* resample (const int index, const int numInputs,
+                                const SampleType* const inputSamples, const int inputLength,
+                                const int outputLength) throw()
+    {
+        if (resampled.length() < (numInputs * outputLength))
+            resampled.setSize (numInputs * outputLength, false);
+
+        SampleType* const resampledSamples = resampled.getArray() + index * outputLength;
+
+        double position = 0.0;
+        const double increment = double (inputLength) / double (outputLength);
+
+        for (int i = 0; i < outputLength; ++i)
+        {
+            resampledSamples[i] = inputSamples[int (position)];
+            position += increment;
+        }
+
+        return resampledSamples;
+    }
+};
+
+//------------------------------------------------------------------------------
+
+/** Fuses chains of element-wise operators into single channels.
+
+ Expressions such as <code>(sine * env + 0.5).tanh() * gain</code> normally
+ create a channel per operator, each with its own output buffer and a full
+ pass over memory. This walks the expression for each channel collecting
+ binary operators, unary operators and multiply-adds (i.e., anything that
+ returns true from ChannelInternalBase::getFusedOp()) and replaces them with
+ one channel that evaluates the whole expression per tile of the block. Any
+ other units in the expression become the inputs of the fused channel and
+ are processed as normal. Sub-expressions used more than once in the
+ expression are only evaluated once.
+
+ Operators running at a different block size to the root of the expression
+ are left as inputs. If nothing can be fused the expression is returned as is.
+ Note that the original operator channels are still referenced by the
+ expression so they can be shared with other parts of the graph; only
+ the fused output should be used for processing.
+
+ @par Factory functions:
+ - ar (expression)
+
+ @par Inputs:
+ - expression: (unit, multi) the expression to fuse
+
+ @see UnitBase::fuse()
+ @ingroup ArithmeticUnits */
+template<class SampleType>
+class FusedOpUnit
+{
+public:
+    typedef FusedOpChannelInternal<SampleType>      FusedOpInternal;
+    typedef typename FusedOpInternal::Data          Data;
+    typedef typename FusedOpInternal::UnitsType     UnitsType;
+    typedef InputDictionary                         Inputs;
+    typedef ChannelBase<SampleType>                 ChannelType;
+    typedef ChannelInternalBase<SampleType>         ChannelInternalType;
+    typedef UnitBase<SampleType>                    UnitType;
+    typedef FusedOpInfo<SampleType>                 InfoType;
+
+    static PLONK_INLINE_LOW UnitInfos getInfo() throw()
+    {
+        return UnitInfo ("FusedOp", "Evaluates chains of element-wise operators in a single pass.",
+
+                         // output
+                         ChannelCount::VariableChannelCount,
+                         IOKey::Generic,            Measure::None,      IOInfo::NoDefault,  IOLimit::None,
+                         IOKey::End,
+
+                         // inputs
+                         IOKey::Generic,            Measure::None,      IOInfo::NoDefault,  IOLimit::None,
+                         IOKey::End);
+    }
+
+    /** Create a unit evaluating the element-wise operators in an expression in a single pass. */
+    static UnitType ar (UnitType const& expression) throw()
+    {
+        UnitType source (expression);
+        const int numChannels = source.getNumChannels();
+        UnitType result (UnitType::withSize (numChannels));
+        bool didFuse = false;
+
+        for (int i = 0; i < numChannels; ++i)
+        {
+            Compiler compiler (source.wrapAt (i).getBlockSize().getValue());
+            const int root = compiler.compile (source, i);
+
+            if ((root >= 0) && !compiler.failed)
+            {
+                Inputs inputs;
+                inputs.put (IOKey::Units, compiler.getInputs());
+
+                ChannelInternalType* internal = new FusedOpInternal (inputs,
+                                                                     compiler.data,
+                                                                     BlockSize::noPreference(),
+                                                                     SampleRate::noPreference());
+                internal->initChannel (i);
+                result.put (i, ChannelType (internal));
+                didFuse = true;
+            }
+            else
+            {
+                result.put (i, source.wrapAt (i));
+            }
+        }
+
+        return didFuse ? result : source;
+    }
+
+private:
+    /** Flattens an expression tree into the fused channel's steps. */
+    class Compiler
+    {
+    public:
+        Compiler (const int rootBlockSize) throw()
+        :   blockSize (rootBlockSize),
+            numInputs (0),
+            numVisited (0),
+            failed (false)
+        {
+            data.base.sampleRate = -1.0;
+            data.base.sampleDuration = -1.0;
+            data.numSteps = 0;
+        }
+
+        /** Returns the operand referring to the unit's channel. */
+        int compile (UnitType& unit, const int channel) throw()
+        {
+            ChannelInternalType* const internal = unit.wrapAt (channel).getInternal();
+
+            for (int i = 0; i < numVisited; ++i)
+                if (visited[i] == internal)
+                    return visitedOperands[i];
+
+            InfoType info;
+            int operand;
+
+            if (internal->getFusedOp (info) && (internal->getBlockSize().getValue() == blockSize))
+            {
+                const int savedNumSteps = data.numSteps;
+                const int savedNumInputs = numInputs;
+                const int savedNumVisited = numVisited;
+                const bool savedFailed = failed;
+
+                int infoOperands[InfoType::MaxInputs];
+
+                for (int i = 0; i < info.numInputs; ++i)
+                    infoOperands[i] = compile (*info.inputs[i], channel);
+
+                if ((data.numSteps + info.numSteps) <= Data::MaxSteps)
+                {
+                    const int firstStep = data.numSteps;
+
+                    for (int s = 0; s < info.numSteps; ++s)
+                    {
+                        FusedOpStep<SampleType>& step = data.steps[data.numSteps++];
+                        step = info.steps[s];
+
+                        for (int o = 0; o < 2; ++o)
+                            step.operands[o] = (step.operands[o] >= 0) ? firstStep + step.operands[o] : infoOperands[-1 - step.operands[o]];
+                    }
+
+                    operand = data.numSteps - 1;
+                }
+                else
+                {
+                    // out of steps so undo this sub-expression and use it as an input,
+                    // this only clears a failure from running out of inputs within it
+                    data.numSteps = savedNumSteps;
+                    numInputs = savedNumInputs;
+                    numVisited = savedNumVisited;
+                    failed = savedFailed;
+                    operand = addInput (unit);
+                }
+            }
+            else
+            {
+                operand = addInput (unit);
+            }
+
+            if (numVisited < Data::MaxSteps + Data::MaxInputs)
+            {
+                visited[numVisited] = internal;
+                visitedOperands[numVisited] = operand;
+                ++numVisited;
+            }
+
+            return operand;
+        }
+
+        UnitsType getInputs() const throw()
+        {
+            UnitsType units;
+
+            for (int i = 0; i < numInputs; ++i)
+                units.add (*inputs[i]);
+
+            return units;
+        }
+
+        Data data;
+        const int blockSize;
+        UnitType* inputs[Data::MaxInputs];
+        int numInputs;
+        ChannelInternalType* visited[Data::MaxSteps + Data::MaxInputs];
+        int visitedOperands[Data::MaxSteps + Data::MaxInputs];
+        int numVisited;
+        bool failed;
+
+    private:
+        int addInput (UnitType& unit) throw()
+        {
+            if (numInputs >= Data::MaxInputs)
+            {
+                failed = true;
+                return -1;
+            }
+
+            inputs[numInputs] = &unit;
+            return -1 - numInputs++;
+        }
+    };
+};
+
+typedef FusedOpUnit<PLONK_TYPE_DEFAULT> FusedOp;
+
+#endif // PLONK_FUSEDOPCHANNEL_H
@@ -41,6 +41,97 @@
 
 #include "../channel/plonk_ChannelInternalCore.h"
 #include "../plonk_GraphForwardDeclarations.h"
+#include "../utility/plonk_ParallelRenderer.h"
+
+
+/** Renders each channel of a unit as a separate ParallelRenderer task. */
+template<class SampleType>
+class ChannelsRenderJob : public ParallelRenderer::Job
+{
+public:
+    typedef UnitBase<SampleType> UnitType;
+    
+    ChannelsRenderJob (UnitType& unitToRender) throw()
+    :   unit (unitToRender)
+    {
+    }
+    
+    int getNumTasks() throw()
+    {
+        return unit.getNumChannels();
+    }
+    
+    const void* getTaskID (const int task) throw()
+    {
+        return unit.atUnchecked (task).getInternal();
+    }
+    
+    void getTaskChannels (const int task, ParallelRenderer::Channels& channels) throw()
+    {
+        channels.add (unit.atUnchecked (task).getInternal());
+    }
+    
+    void processTask (ProcessInfo& info, const int task) throw()
+    {
+        unit.process (info, task);
+    }
+    
+private:
+    UnitType& unit;
+    
+    ChannelsRenderJob& operator= (ChannelsRenderJob const&);
+};
+
+/** Renders each unit in an array as a separate ParallelRenderer task. */
+template<class SampleType>
+class UnitsRenderJob : public ParallelRenderer::Job
+{
+public:
+    typedef ChannelBase<SampleType>                 ChannelType;
+    typedef UnitBase<SampleType>                    UnitType;
+    typedef NumericalArray2D<ChannelType,UnitType>  UnitsType;
+    
+    UnitsRenderJob (UnitsType& unitsToRender, const int numChannelsToRender) throw()
+    :   units (unitsToRender),
+        numChannels (numChannelsToRender)
+    {
+    }
+    
+    int getNumTasks() throw()
+    {
+        return units.length();
+    }
+    
+    const void* getTaskID (const int task) throw()
+    {
+        return units.atUnchecked (task).getInternal();
+    }
+    
+    void getTaskChannels (const int task, ParallelRenderer::Channels& channels) throw()
+    {
+        UnitType& unit (units.atUnchecked (task));
+        
+        for (int channel = 0; channel < numChannels; ++channel)
+            channels.add (unit.wrapAt (channel).getInternal());
+    }
+    
+    void processTask (ProcessInfo& info, const int task) throw()
+    {
+        UnitType& unit (units.atUnchecked (task));
+        
+        for (int channel = 0; channel < numChannels; ++channel)
+            if (! unit.wrapAt (channel).shouldBeDeletedNow (info.getTimeStamp()))
+                unit.process (info, channel);
+    }
+    
+private:
+    UnitsType& units;
+    const int numChannels;
+    
+    UnitsRenderJob& operator= (UnitsRenderJob const&);
+};
+
+//------------------------------------------------------------------------------
 
 template<class SampleType> class ChannelMixerChannelInternal;
 
@@ -71,7 +162,9 @@ public:
                                  Data const& data, 
                                  BlockSize const& blockSize,
                                  SampleRate const& sampleRate) throw()
-    :   Internal (inputs, data, blockSize, sampleRate)
+    :   Internal (inputs, data, blockSize, sampleRate),
+        renderJob (this->getInputAsUnit (IOKey::Generic)),
+        renderPlan (renderJob)
     {
     }
     
@@ -86,6 +179,11 @@ public:
         return keys;
     }    
     
+    bool writesOutputBetweenInputs() const throw()
+    {
+        return true;
+    }
+    
     InternalBase* getChannel (const int /*index*/) throw()
     {
         return this;
@@ -121,6 +219,9 @@ public:
         
         const int numChannels = inputUnit.getNumChannels();
         
+        // render independent channels in parallel if enabled, they are then just mixed below
+        ParallelRenderer::global().render (info, renderPlan);
+        
         for (int channel = 0; channel < numChannels; ++channel)
         {
             plonk_assert (inputUnit.getOverlap (channel) == Math<DoubleVariable>::get1());
@@ -155,6 +256,10 @@ public:
         if (data.allowAutoDelete == false)
             info.resetShouldDelete();
     }
+    
+private:
+    ChannelsRenderJob<SampleType> renderJob;
+    ParallelRenderer::Plan renderPlan;
 };
 
 //------------------------------------------------------------------------------
@@ -192,7 +297,9 @@ public:
                               SampleRate const& sampleRate,
                               ChannelArrayType& channels) throw()
     :   Internal (data.preferredNumChannels > 0 ? data.preferredNumChannels : inputs.getMaxNumChannels(),
-                  inputs, data, blockSize, sampleRate, channels)
+                  inputs, data, blockSize, sampleRate, channels),
+        renderJob (this->getInputAsUnits (IOKey::Units), this->getNumChannels()),
+        renderPlan (renderJob)
     {
     }
 
@@ -206,6 +313,11 @@ public:
         const IntArray keys (IOKey::Units);
         return keys;
     }    
+    
+    bool writesOutputBetweenInputs() const throw()
+    {
+        return true;
+    }
         
     void initChannel (const int channel) throw()
     {        
@@ -237,7 +349,8 @@ public:
         
         UnitsType& units = this->getInputAsUnits (IOKey::Units);
         
-        if (data.purgeExpiredUnits)
+        // the render plan may be being built from the units
+        if (data.purgeExpiredUnits && renderPlan.canChangeTasks())
         {
             // remove nulls...
             for (unit = units.length(); --unit >= 0;)
@@ -248,6 +361,9 @@ public:
         const int numChannels = this->getNumChannels();
         const int numUnits = units.length();
         
+        // render independent units in parallel if enabled, they are then just mixed below..
+        ParallelRenderer::global().render (info, renderPlan);
+
         // ..and process.
         for (channel = 0; channel < numChannels; ++channel)
         {
@@ -293,7 +409,11 @@ public:
                 }
             }
         }
-    }    
+    }
+    
+private:
+    UnitsRenderJob<SampleType> renderJob;
+    ParallelRenderer::Plan renderPlan;
 };
 
 //------------------------------------------------------------------------------
@@ -347,6 +467,11 @@ public:
         return keys;
     }
     
+    bool writesOutputBetweenInputs() const throw()
+    {
+        return true;
+    }
+    
     static PLONK_INLINE_LOW const UnitType& getDummy() throw()
     {
         // dummy is a marker so we know we've done the whole queue up to the poiunt that we add this dummy marker
@@ -500,6 +625,11 @@ public:
         return keys;
     }    
     
+    bool writesOutputBetweenInputs() const throw()
+    {
+        return true;
+    }
+    
     InternalBase* getChannel (const int /*index*/) throw()
     {
         return this;
@@ -631,6 +761,11 @@ public:
         return keys;
     }    
     
+    bool writesOutputBetweenInputs() const throw()
+    {
+        return true;
+    }
+    
     void initChannel (const int channel) throw()
     {        
         if ((channel % this->getNumChannels()) == 0)
@@ -58,6 +58,7 @@ public:
     typedef UnitBase<SampleType>                    UnitType;
     typedef InputDictionary                         Inputs;
     typedef NumericalArray<SampleType>              Buffer;
+    typedef typename BinaryOpFunctionsHelper<SampleType>::BinaryOpFunctionsType BinaryOpFunctionsType;
         
     MulAddChannelInternal (Inputs const& inputs, 
                            Data const& data, 
@@ -90,6 +91,18 @@ public:
                                      this->getSampleRate());
     }        
     
+    bool getFusedOp (FusedOpInfo<SampleType>& info) throw()
+    {
+        info.numSteps = 2;
+        info.numInputs = 3;
+        info.steps[0] = FusedOpStep<SampleType>::template binaryStep<BinaryOpFunctionsType::mulop> (-1, -2);
+        info.steps[1] = FusedOpStep<SampleType>::template binaryStep<BinaryOpFunctionsType::addop> (0, -3);
+        info.inputs[0] = &this->getInputAsUnit (IOKey::Generic);
+        info.inputs[1] = &this->getInputAsUnit (IOKey::Multiply);
+        info.inputs[2] = &this->getInputAsUnit (IOKey::Add);
+        return true;
+    }
+    
     void initChannel(const int channel) throw()
     {
         UnitType& inputUnit (this->getInputAsUnit (IOKey::Generic));
@@ -274,6 +287,18 @@ public:
                                           this->getSampleRate());
     }        
     
+    bool getFusedOp (FusedOpInfo<float>& info) throw()
+    {
+        info.numSteps = 2;
+        info.numInputs = 3;
+        info.steps[0] = FusedOpStep<float>::binaryStep<BinaryOpFunctionsHelper<float>::BinaryOpFunctionsType::mulop> (-1, -2);
+        info.steps[1] = FusedOpStep<float>::binaryStep<BinaryOpFunctionsHelper<float>::BinaryOpFunctionsType::addop> (0, -3);
+        info.inputs[0] = &this->getInputAsUnit (IOKey::Generic);
+        info.inputs[1] = &this->getInputAsUnit (IOKey::Multiply);
+        info.inputs[2] = &this->getInputAsUnit (IOKey::Add);
+        return true;
+    }
+    
     void initChannel(const int channel) throw()
     {
         UnitType& inputUnit (this->getInputAsUnit (IOKey::Generic));
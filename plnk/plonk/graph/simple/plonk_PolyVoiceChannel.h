@@ -0,0 +1,788 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_POLYVOICECHANNEL_H
+#define PLONK_POLYVOICECHANNEL_H
+
+#include "../channel/plonk_ChannelInternalCore.h"
+#include "../plonk_GraphForwardDeclarations.h"
+
+
+/** A note event sent to a PolyVoices pool. */
+struct PolyVoiceEvent
+{
+    enum Types
+    {
+        NoteOff,
+        NoteOn,
+        AllNotesOff
+    };
+    
+    int type;
+    int note;
+    float velocity;
+};
+
+/** The shared part of a PolyVoices pool. 
+ The voices and everything needed to restart them are built on construction,
+ all the voice allocation happens in processEvents() on the audio thread. */
+template<class SampleType>
+class PolyVoicesInternal : public SmartPointer
+{
+public:
+    typedef ChannelBase<SampleType>                 ChannelType;
+    typedef UnitBase<SampleType>                    UnitType;
+    typedef NumericalArray2D<ChannelType,UnitType>  UnitsType;
+    typedef Variable<SampleType>                    VariableType;
+    typedef ObjectArray<VariableType>               VariablesType;
+    typedef NumericalArray<SampleType>              Buffer;
+    typedef ObjectArray<ChannelInternalCore*>       Channels;
+    typedef ObjectArray<const void*>                Resources;
+    typedef RingBufferMPSC<PolyVoiceEvent>          Events;
+    
+    typedef UnitType (*VoiceFunction) (VariableType const& frequency, 
+                                       VariableType const& velocity, 
+                                       VariableType const& gate);
+    
+    enum StealModes
+    {
+        StealOldest,
+        StealQuietest
+    };
+    
+    enum Constants
+    {
+        MaxEventsPerBlock = 64
+    };
+    
+    PolyVoicesInternal (const int numVoicesToUse,
+                        VoiceFunction function,
+                        const int stealModeToUse,
+                        const int eventCapacity) throw()
+    :   events (eventCapacity),
+        numVoices (numVoicesToUse),
+        numChannels (0),
+        stealMode (stealModeToUse),
+        numActive (0),
+        numFree (numVoicesToUse),
+        age (0)
+    {
+        plonk_assert (numVoices > 0);
+        plonk_assert (function != 0);
+        
+        int voice;
+        
+        frequencies = VariablesType::withSize (numVoices);
+        velocities = VariablesType::withSize (numVoices);
+        gates = VariablesType::withSize (numVoices);
+        
+        for (voice = 0; voice < numVoices; ++voice)
+        {
+            frequencies.put (voice, VariableType (SampleType (0)));
+            velocities.put (voice, VariableType (SampleType (0)));
+            gates.put (voice, VariableType (SampleType (0)));
+            
+            const UnitType unit = function (frequencies.atUnchecked (voice), 
+                                            velocities.atUnchecked (voice), 
+                                            gates.atUnchecked (voice));
+            voices.add (unit);
+            
+            plonk_assert ((voice == 0) || (unit.getNumChannels() == numChannels)); // voices must have the same number of channels
+            numChannels = plonk::max (numChannels, unit.getNumChannels());
+        }
+        
+        notes = IntArray::newClear (numVoices);
+        gateOn = IntArray::newClear (numVoices);
+        ages = LongLongArray::newClear (numVoices);
+        levels = Buffer::newClear (numVoices);
+        restarting = IntArray::newClear (numVoices);
+        pendingVelocities = FloatArray::newClear (numVoices);
+        activeVoices = IntArray::newClear (numVoices);
+        activePositions = IntArray::withSize (numVoices);
+        freeVoices = IntArray::withSize (numVoices);
+        
+        for (voice = 0; voice < numVoices; ++voice)
+        {
+            activePositions.atUnchecked (voice) = -1;
+            freeVoices.atUnchecked (voice) = numVoices - 1 - voice;
+        }
+        
+        initResetState();
+    }
+    
+    PLONK_INLINE_LOW Events& getEvents() throw()                      { return events; }
+    PLONK_INLINE_LOW const UnitsType& getVoices() const throw()       { return voices; }
+    PLONK_INLINE_LOW UnitType& getVoice (const int voice) throw()     { return voices.atUnchecked (voice); }
+    PLONK_INLINE_LOW int getNumVoices() const throw()                 { return numVoices; }
+    PLONK_INLINE_LOW int getNumChannels() const throw()               { return numChannels; }
+    PLONK_INLINE_LOW int getStealMode() const throw()                 { return stealMode; }
+    PLONK_INLINE_LOW int getNumActive() const throw()                 { return numActive; }
+    PLONK_INLINE_LOW int getActiveVoice (const int index) const throw()  { return activeVoices.atUnchecked (index); }
+    PLONK_INLINE_LOW bool isGateOn (const int voice) const throw()    { return gateOn.atUnchecked (voice) != 0; }
+    PLONK_INLINE_LOW bool isRestarting (const int voice) const throw() { return restarting.atUnchecked (voice) != 0; }
+    PLONK_INLINE_LOW void setLevel (const int voice, const SampleType level) throw() { levels.atUnchecked (voice) = level; }
+    
+    /** Applies the queued note events. Only call this from the audio thread. */
+    void processEvents() throw()
+    {
+        PolyVoiceEvent eventsThisTime[MaxEventsPerBlock];
+        int numEvents;
+        
+        // leave any more for the next block to bound the time taken
+        numEvents = events.popItems (eventsThisTime, MaxEventsPerBlock);
+        
+        for (int i = 0; i < numEvents; ++i)
+        {
+            const PolyVoiceEvent& event = eventsThisTime[i];
+            
+            switch (event.type)
+            {
+                case PolyVoiceEvent::NoteOn:        noteOnNow (event.note, event.velocity); break;
+                case PolyVoiceEvent::NoteOff:       noteOffNow (event.note, false);         break;
+                case PolyVoiceEvent::AllNotesOff:   noteOffNow (0, true);                   break;
+                default: plonk_assertfalse;
+            }
+        }
+    }
+    
+    /** Stops processing the voice at an index in the active voices. 
+     The last active voice moves to this index. */
+    void deactivate (const int index) throw()
+    {
+        const int voice = activeVoices.atUnchecked (index);
+        const int last = activeVoices.atUnchecked (--numActive);
+        
+        activeVoices.atUnchecked (index) = last;
+        activePositions.atUnchecked (last) = index;
+        activePositions.atUnchecked (voice) = -1;
+        gateOn.atUnchecked (voice) = 0;
+        gates.atUnchecked (voice).setValue (SampleType (0));
+        freeVoices.atUnchecked (numFree++) = voice;
+    }
+    
+    /** Resets a voice and starts its latest note. 
+     Called directly for a free voice, or after a voice that was still sounding
+     has been faded out for a block. */
+    void startVoice (const int voice) throw()
+    {
+        resetVoice (voice);
+        
+        restarting.atUnchecked (voice) = 0;
+        levels.atUnchecked (voice) = SampleType (0);
+        
+        frequencies.atUnchecked (voice).setValue (SampleType (plonk::m2f (double (notes.atUnchecked (voice)))));
+        velocities.atUnchecked (voice).setValue (SampleType (pendingVelocities.atUnchecked (voice)));
+        gates.atUnchecked (voice).setValue (SampleType (gateOn.atUnchecked (voice)));
+    }
+    
+private:
+    Events events;
+    UnitsType voices;
+    VariablesType frequencies;
+    VariablesType velocities;
+    VariablesType gates;
+    
+    const int numVoices;
+    int numChannels;
+    const int stealMode;
+    
+    // audio thread voice state
+    IntArray notes;
+    IntArray gateOn;
+    LongLongArray ages;
+    Buffer levels;
+    IntArray restarting;        // fading out before starting its latest note
+    FloatArray pendingVelocities;
+    IntArray activeVoices;      // dense array of the voices being processed
+    IntArray activePositions;   // index of each voice in activeVoices or -1
+    IntArray freeVoices;        // stack of the voices not being processed
+    int numActive;
+    int numFree;
+    LongLong age;
+    
+    // the initial state of the channels that belong to each voice
+    Channels voiceChannels;
+    IntArray channelStarts;     // first channel of each voice, plus the end
+    IntArray blockSizes;        // size of each state block of the voice channels in order
+    IntArray blockStarts;       // index in blockSizes of each voice's first block
+    LongLongArray stateStarts;  // offset of each voice's first block in initialState
+    CharArray initialState;
+    
+    static void collect (ChannelInternalCore* channel, Channels& channels) throw()
+    {
+        if (channels.contains (channel))
+            return;
+        
+        channels.add (channel);
+        
+        Channels dependencies;
+        Resources resources;
+        static_cast<const ChannelInternalCore*> (channel)->getInputs().getDependencies (dependencies, resources);
+        
+        if (channel->getProxyOwner() != 0)
+            dependencies.add (channel->getProxyOwner());
+        
+        for (int i = 0; i < dependencies.length(); ++i)
+            collect (dependencies.atUnchecked (i), channels);
+    }
+    
+    /** Keeps the state blocks of each voice's channels as they were built. 
+     Channels reachable from more than one voice (e.g., an LFO passed to all 
+     of them) are shared and never reset. */
+    void initResetState() throw()
+    {
+        int voice, i, j, channel;
+        
+        ObjectArray<Channels> channelsPerVoice = ObjectArray<Channels>::withSize (numVoices);
+        
+        for (voice = 0; voice < numVoices; ++voice)
+        {
+            const UnitType& unit = voices.atUnchecked (voice);
+            
+            for (channel = 0; channel < unit.getNumChannels(); ++channel)
+                collect (unit.atUnchecked (channel).getInternal(), channelsPerVoice.atUnchecked (voice));
+        }
+        
+        channelStarts = IntArray::withSize (numVoices + 1);
+        blockStarts = IntArray::withSize (numVoices);
+        stateStarts = LongLongArray::withSize (numVoices);
+        LongLong stateLength = 0;
+        
+        for (voice = 0; voice < numVoices; ++voice)
+        {
+            const Channels& channels = channelsPerVoice.atUnchecked (voice);
+            
+            channelStarts.atUnchecked (voice) = voiceChannels.length();
+            blockStarts.atUnchecked (voice) = blockSizes.length();
+            stateStarts.atUnchecked (voice) = stateLength;
+            
+            for (i = 0; i < channels.length(); ++i)
+            {
+                ChannelInternalCore* const channelInternal = channels.atUnchecked (i);
+                bool shared = false;
+                
+                for (j = 0; (j < numVoices) && ! shared; ++j)
+                    shared = (j != voice) && channelsPerVoice.atUnchecked (j).contains (channelInternal);
+                
+                if (! shared)
+                {
+                    voiceChannels.add (channelInternal);
+                    
+                    for (j = 0; j < channelInternal->getNumStateBlocks(); ++j)
+                    {
+                        int numBytes;
+                        channelInternal->getStateBlock (j, numBytes);
+                        blockSizes.add (numBytes);
+                        stateLength += numBytes;
+                    }
+                }
+            }
+        }
+        
+        channelStarts.atUnchecked (numVoices) = voiceChannels.length();
+        initialState = CharArray::withSize (int (stateLength));
+        
+        char* state = initialState.getArray();
+        
+        for (i = 0; i < voiceChannels.length(); ++i)
+        {
+            ChannelInternalCore* const channelInternal = voiceChannels.atUnchecked (i);
+            
+            for (j = 0; j < channelInternal->getNumStateBlocks(); ++j)
+            {
+                int numBytes;
+                const void* const block = channelInternal->getStateBlock (j, numBytes);
+                
+                if (numBytes > 0)
+                    Memory::copy (state, block, numBytes);
+                
+                state += numBytes;
+            }
+        }
+    }
+    
+    /** Puts a voice's channels back to how they were built. 
+     Only the channels' state blocks are restored, state held elsewhere (e.g., 
+     the position of a FilePlay's reader or the contents of a shared buffer) 
+     carries on from where the last note left it. Output buffers shared by a 
+     BufferPlanner belong to other channels too so these are left alone, as 
+     are any blocks that have changed size. */
+    void resetVoice (const int voice) throw()
+    {
+        const char* state = initialState.getArray() + stateStarts.atUnchecked (voice);
+        const int end = channelStarts.atUnchecked (voice + 1);
+        int blockIndex = blockStarts.atUnchecked (voice);
+        
+        for (int i = channelStarts.atUnchecked (voice); i < end; ++i)
+        {
+            ChannelInternalCore* const channelInternal = voiceChannels.atUnchecked (i);
+            const int numBlocks = channelInternal->getNumStateBlocks();
+            
+            for (int j = 0; j < numBlocks; ++j)
+            {
+                const int initialBytes = blockSizes.atUnchecked (blockIndex++);
+                int numBytes;
+                void* const block = channelInternal->getStateBlock (j, numBytes);
+                
+                if ((numBytes == initialBytes) && (numBytes > 0) && 
+                    ((j > 0) || ! channelInternal->isUsingPlannedBuffer()))
+                    Memory::copy (block, state, numBytes);
+                
+                state += initialBytes;
+            }
+        }
+    }
+    
+    int stealVoice() throw()
+    {
+        // voices already released are taken first
+        bool releasedOnly = false;
+        int i;
+        
+        for (i = 0; (i < numActive) && ! releasedOnly; ++i)
+            releasedOnly = gateOn.atUnchecked (activeVoices.atUnchecked (i)) == 0;
+        
+        int chosen = -1;
+        
+        for (i = 0; i < numActive; ++i)
+        {
+            const int voice = activeVoices.atUnchecked (i);
+            
+            if (releasedOnly && gateOn.atUnchecked (voice))
+                continue;
+            
+            if (chosen < 0)
+                chosen = voice;
+            else if (stealMode == StealQuietest)
+            {
+                if (levels.atUnchecked (voice) < levels.atUnchecked (chosen))
+                    chosen = voice;
+            }
+            else if (ages.atUnchecked (voice) < ages.atUnchecked (chosen))
+            {
+                chosen = voice;
+            }
+        }
+        
+        return chosen;
+    }
+    
+    void noteOnNow (const int note, const float velocity) throw()
+    {
+        int voice = -1;
+        int i;
+        
+        // retrigger a voice already holding this note
+        for (i = 0; (i < numActive) && (voice < 0); ++i)
+        {
+            const int activeVoice = activeVoices.atUnchecked (i);
+            
+            if (gateOn.atUnchecked (activeVoice) && (notes.atUnchecked (activeVoice) == note))
+                voice = activeVoice;
+        }
+        
+        bool sounding = voice >= 0;
+        
+        if (voice < 0)
+        {
+            if (numFree > 0)
+            {
+                voice = freeVoices.atUnchecked (--numFree);
+                activePositions.atUnchecked (voice) = numActive;
+                activeVoices.atUnchecked (numActive++) = voice;
+            }
+            else
+            {
+                voice = stealVoice();
+                sounding = true;
+            }
+        }
+        
+        notes.atUnchecked (voice) = note;
+        gateOn.atUnchecked (voice) = 1;
+        ages.atUnchecked (voice) = ++age;
+        pendingVelocities.atUnchecked (voice) = velocity;
+        
+        // a voice still sounding is faded out over the next block before it restarts
+        if (sounding)
+            restarting.atUnchecked (voice) = 1;
+        else
+            startVoice (voice);
+    }
+    
+    void noteOffNow (const int note, const bool allNotes) throw()
+    {
+        for (int i = 0; i < numActive; ++i)
+        {
+            const int voice = activeVoices.atUnchecked (i);
+            
+            if (gateOn.atUnchecked (voice) && (allNotes || (notes.atUnchecked (voice) == note)))
+            {
+                gateOn.atUnchecked (voice) = 0;
+                gates.atUnchecked (voice).setValue (SampleType (0));
+            }
+        }
+    }
+};
+
+//------------------------------------------------------------------------------
+
+/** A pool of preallocated voices for a PolyVoice unit.
+ The voices are built from a function that is passed the frequency, velocity 
+ and gate variables for one voice and returns its unit, normally ending with
+ an envelope controlled by the gate that deletes when done.
+ 
+ noteOn(), noteOff() and allNotesOff() can be called from any thread. They 
+ queue events which are applied at the start of the PolyVoice unit's next 
+ block. Starting a voice restores the state blocks its channels had when built,
+ nothing is allocated on the audio thread. If there are no free voices one
+ is stolen, preferring voices that have been released. A stolen or retriggered
+ voice is faded out over one block before its new note starts.
+ 
+ A voice stops being processed when it signals that it should be deleted 
+ (e.g., its envelope finished) or when it is silent after its note was
+ released. Only use a pool with one PolyVoice unit.
+ @see PolyVoiceUnit */
+template<class SampleType>
+class PolyVoices : public SmartPointerContainer<PolyVoicesInternal<SampleType> >
+{
+public:
+    typedef PolyVoicesInternal<SampleType>          Internal;
+    typedef SmartPointerContainer<Internal>         Base;
+    typedef typename Internal::UnitsType            UnitsType;
+    typedef typename Internal::VariableType         VariableType;
+    typedef typename Internal::VoiceFunction        VoiceFunction;
+    
+    enum StealModes
+    {
+        StealOldest = Internal::StealOldest,
+        StealQuietest = Internal::StealQuietest
+    };
+    
+    /** Creates the pool.
+     @param numVoices       The number of voices to build.
+     @param function        Builds each voice.
+     @param stealMode       StealOldest or StealQuietest.
+     @param eventCapacity   The number of events that can be queued between blocks. */
+    PolyVoices (const int numVoices,
+                VoiceFunction function,
+                const int stealMode = StealOldest,
+                const int eventCapacity = 256) throw()
+    :   Base (new Internal (numVoices, function, stealMode, eventCapacity))
+    {
+    }
+    
+    explicit PolyVoices (Internal* internalToUse) throw() 
+	:	Base (internalToUse)
+	{
+	}
+    
+    PolyVoices (PolyVoices const& copy) throw()
+    :   Base (static_cast<Base const&> (copy))
+    {
+    }
+    
+    PolyVoices& operator= (PolyVoices const& other) throw()
+	{
+		if (this != &other)
+            this->setInternal (other.getInternal());
+        return *this;
+	}
+    
+    /** Starts a voice, @return @c false if the event queue was full. */
+    PLONK_INLINE_LOW bool noteOn (const int note, const float velocity = 1.f) throw()
+    {
+        const PolyVoiceEvent event = { PolyVoiceEvent::NoteOn, note, velocity };
+        return this->getInternal()->getEvents().push (event);
+    }
+    
+    /** Releases the voices playing a note, @return @c false if the event queue was full. */
+    PLONK_INLINE_LOW bool noteOff (const int note) throw()
+    {
+        const PolyVoiceEvent event = { PolyVoiceEvent::NoteOff, note, 0.f };
+        return this->getInternal()->getEvents().push (event);
+    }
+    
+    /** Releases all the voices, @return @c false if the event queue was full. */
+    PLONK_INLINE_LOW bool allNotesOff() throw()
+    {
+        const PolyVoiceEvent event = { PolyVoiceEvent::AllNotesOff, 0, 0.f };
+        return this->getInternal()->getEvents().push (event);
+    }
+    
+    PLONK_INLINE_LOW int getNumVoices() const throw()             { return this->getInternal()->getNumVoices(); }
+    PLONK_INLINE_LOW int getNumChannels() const throw()           { return this->getInternal()->getNumChannels(); }
+    PLONK_INLINE_LOW const UnitsType& getVoices() const throw()   { return this->getInternal()->getVoices(); }
+    
+    PLONK_OBJECTARROWOPERATOR(PolyVoices);
+};
+
+//------------------------------------------------------------------------------
+
+/** Mixes the active voices of a PolyVoices pool. */
+template<class SampleType>
+class PolyVoiceChannelInternal
+:   public ProxyOwnerChannelInternal<SampleType, ChannelInternalCore::Data>
+{
+public:
+    typedef ChannelInternalCore::Data                                           Data;
+    typedef typename BinaryOpFunctionsHelper<SampleType>::BinaryOpFunctionsType BinaryOpFunctionsType;
+    typedef ChannelBase<SampleType>                                             ChannelType;
+    typedef ObjectArray<ChannelType>                                            ChannelArrayType;
+    typedef ProxyOwnerChannelInternal<SampleType,Data>                          Internal;
+    typedef UnitBase<SampleType>                                                UnitType;
+    typedef InputDictionary                                                     Inputs;
+    typedef NumericalArray<SampleType>                                          Buffer;
+    typedef PolyVoices<SampleType>                                              PolyVoicesType;
+    typedef PolyVoicesInternal<SampleType>                                      PolyVoicesInternalType;
+    
+    PolyVoiceChannelInternal (Inputs const& inputs,
+                              Data const& data,
+                              BlockSize const& blockSize,
+                              SampleRate const& sampleRate,
+                              ChannelArrayType& channels,
+                              PolyVoicesType const& voicesToUse) throw()
+    :   Internal (voicesToUse.getNumChannels(), inputs, data, blockSize, sampleRate, channels),
+        voices (voicesToUse)
+    {
+    }
+    
+    Text getName() const throw()
+    {
+        return "Poly Voice";
+    }
+    
+    IntArray getInputKeys() const throw()
+    {
+        const IntArray keys (IOKey::Units);
+        return keys;
+    }
+    
+    bool writesOutputBetweenInputs() const throw()
+    {
+        return true;
+    }
+    
+    void initChannel (const int channel) throw()
+    {
+        if ((channel % this->getNumChannels()) == 0)
+        {
+            this->setBlockSize (BlockSize::decide (BlockSize::getDefault(),
+                                                   this->getBlockSize()));
+            this->setSampleRate (SampleRate::decide (SampleRate::getDefault(),
+                                                     this->getSampleRate()));
+        }
+        
+        this->initProxyValue (channel, SampleType (0));
+    }
+    
+    void process (ProcessInfo& info, const int /*channel*/) throw()
+    {
+        PolyVoicesInternalType* const pool = voices.getInternal();
+        pool->processEvents();
+        
+        const int numChannels = this->getNumChannels();
+        const bool shouldDelete = info.getShouldDelete();
+        const SampleType silence = SampleType (TypeUtility<SampleType>::getTypePeak() * 0.0001);
+        int i, channel;
+        
+        for (channel = 0; channel < numChannels; ++channel)
+            this->getOutputBuffer (channel).zero();
+        
+        // free voices are never visited
+        for (int index = 0; index < pool->getNumActive();)
+        {
+            const int voice = pool->getActiveVoice (index);
+            UnitType& voiceUnit = pool->getVoice (voice);
+            const bool restarting = pool->isRestarting (voice);
+            const bool needsLevel = ! pool->isGateOn (voice) || (pool->getStealMode() == PolyVoicesInternalType::StealQuietest);
+            SampleType level (0);
+            
+            info.resetShouldDelete();
+            
+            for (channel = 0; channel < numChannels; ++channel)
+            {
+                const Buffer& inputBuffer (voiceUnit.process (info, channel));
+                const SampleType* const inputSamples = inputBuffer.getArray();
+                const int inputBufferLength = inputBuffer.length();
+                
+                Buffer& outputBuffer = this->getOutputBuffer (channel);
+                SampleType* const outputSamples = outputBuffer.getArray();
+                const int outputBufferLength = outputBuffer.length();
+                
+                if (restarting)
+                {
+                    // fade out the previous note
+                    double inputPosition = 0.0;
+                    const double inputIncrement = double (inputBufferLength) / double (outputBufferLength);
+                    const double fadeIncrement = 1.0 / double (outputBufferLength);
+                    double fade = 1.0;
+                    
+                    for (i = 0; i < outputBufferLength; ++i)
+                    {
+                        outputSamples[i] += SampleType (inputSamples[int (inputPosition)] * fade);
+                        inputPosition += inputIncrement;
+                        fade -= fadeIncrement;
+                    }
+                }
+                else if (inputBufferLength == outputBufferLength)
+                {
+                    NumericalArrayBinaryOp<SampleType,BinaryOpFunctionsType::addop>::calcNN (outputSamples, outputSamples, inputSamples, outputBufferLength);
+                }
+                else if (inputBufferLength == 1)
+                {
+                    NumericalArrayBinaryOp<SampleType,BinaryOpFunctionsType::addop>::calcN1 (outputSamples, outputSamples, inputSamples[0], outputBufferLength);
+                }
+                else
+                {
+                    double inputPosition = 0.0;
+                    const double inputIncrement = double (inputBufferLength) / double (outputBufferLength);
+                    
+                    for (i = 0; i < outputBufferLength; ++i)
+                    {
+                        outputSamples[i] += inputSamples[int (inputPosition)];
+                        inputPosition += inputIncrement;
+                    }
+                }
+                
+                if (needsLevel)
+                    level = plonk::max (level, inputBuffer.findMaximumAbs());
+            }
+            
+            if (restarting)
+            {
+                pool->startVoice (voice);
+                ++index;
+            }
+            else if (info.getShouldDelete() || (! pool->isGateOn (voice) && (level <= silence)))
+            {
+                pool->deactivate (index); // the last active voice is moved here
+            }
+            else
+            {
+                pool->setLevel (voice, level);
+                ++index;
+            }
+        }
+        
+        if (shouldDelete)
+            info.setShouldDelete();
+        else
+            info.resetShouldDelete();
+    }
+    
+private:
+    PolyVoicesType voices;
+};
+
+//------------------------------------------------------------------------------
+
+/** Plays a pool of preallocated voices.
+ 
+ @par Factory functions:
+ - ar (voices, mul=1, add=0, preferredBlockSize=default, preferredSampleRate=default)
+ 
+ @par Inputs:
+ - voices: (polyvoices) the pool of voices to play, started and stopped with its noteOn() and noteOff()
+ - mul: (unit, multi) the multiplier applied to the output
+ - add: (unit, multi) the offset aded to the output
+ - preferredBlockSize: the preferred output block size (for advanced usage, leave on default if unsure)
+ - preferredSampleRate: the preferred output sample rate (for advanced usage, leave on default if unsure)
+ 
+ @see PolyVoices
+ @ingroup MiscUnits */
+template<class SampleType>
+class PolyVoiceUnit
+{
+public:
+    typedef PolyVoiceChannelInternal<SampleType>    PolyVoiceInternal;
+    typedef typename PolyVoiceInternal::Data        Data;
+    typedef ChannelBase<SampleType>                 ChannelType;
+    typedef ObjectArray<ChannelType>                ChannelArrayType;
+    typedef UnitBase<SampleType>                    UnitType;
+    typedef InputDictionary                         Inputs;
+    typedef PolyVoices<SampleType>                  PolyVoicesType;
+    
+    static PLONK_INLINE_LOW UnitInfos getInfo() throw()
+    {
+        const double blockSize = (double)BlockSize::getDefault().getValue();
+        const double sampleRate = SampleRate::getDefault().getValue();
+        
+        return UnitInfo ("PolyVoice", "Plays a pool of preallocated voices.",
+                         
+                         // output
+                         ChannelCount::VariableChannelCount,
+                         IOKey::Generic,     Measure::None,      IOInfo::NoDefault,  IOLimit::None,      IOKey::End,
+                         
+                         // inputs
+                         IOKey::Units,       Measure::None,
+                         IOKey::Multiply,    Measure::Factor,    1.0,                IOLimit::None,
+                         IOKey::Add,         Measure::None,      0.0,                IOLimit::None,
+                         IOKey::BlockSize,   Measure::Samples,   blockSize,          IOLimit::Minimum,   Measure::Samples,   1.0,
+                         IOKey::SampleRate,  Measure::Hertz,     sampleRate,         IOLimit::Minimum,   Measure::Hertz,     0.0,
+                         IOKey::End);
+    }
+    
+    /** Create an audio rate voice player. */
+    static UnitType ar (PolyVoicesType const& voices,
+                        UnitType const& mul = SampleType (1),
+                        UnitType const& add = SampleType (0),
+                        BlockSize const& preferredBlockSize = BlockSize::getDefault(),
+                        SampleRate const& preferredSampleRate = SampleRate::getDefault()) throw()
+    {
+        // the voices are inputs so the graph utilities can see them
+        Inputs inputs;
+        inputs.put (IOKey::Units, voices.getVoices());
+        
+        Data data = { -1.0, -1.0 };
+        
+        ChannelArrayType channels;
+        new PolyVoiceInternal (inputs, data, preferredBlockSize, preferredSampleRate, channels, voices);
+        
+        for (int i = 0; i < channels.length(); ++i)
+            channels.atUnchecked (i).initChannel (i);
+        
+        return UnitType::applyMulAdd (UnitType (channels), mul, add);
+    }
+};
+
+typedef PolyVoiceUnit<PLONK_TYPE_DEFAULT> PolyVoice;
+
+
+
+#endif // PLONK_POLYVOICECHANNEL_H
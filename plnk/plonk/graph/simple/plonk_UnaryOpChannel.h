@@ -165,6 +165,15 @@ public:
                                     this->getSampleRate());
     }    
     
+    bool getFusedOp (FusedOpInfo<SampleType>& info) throw()
+    {
+        info.numSteps = 1;
+        info.numInputs = 1;
+        info.steps[0] = FusedOpStep<SampleType>::template unaryStep<op> (-1);
+        info.inputs[0] = &this->getInputAsUnit (IOKey::Generic);
+        return true;
+    }
+    
     void initChannel (const int channel) throw()
     {
         const UnitType& input = this->getInputAsUnit (IOKey::Generic);
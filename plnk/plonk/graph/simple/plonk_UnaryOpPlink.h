@@ -97,6 +97,14 @@
         return new UnaryOpInternal (channelInputs, this->getState(), this->getBlockSize(), this->getSampleRate());\
     }\
     \
+    bool getFusedOp (FusedOpInfo<float>& info) throw() {\
+        info.numSteps = 1;\
+        info.numInputs = 1;\
+        info.steps[0] = FusedOpStep<float>::unaryStep<UnaryOpFunctionsType::PLONKOP> (-1);\
+        info.inputs[0] = &this->getInputAsUnit (IOKey::Generic);\
+        return true;\
+    }\
+    \
     void initChannel (const int channel) throw() {\
         const UnitType& input = this->getInputAsUnit (IOKey::Generic);\
         const float sourceValue = input.getValue (channel);\
@@ -0,0 +1,455 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_BUFFERPLANNER_H
+#define PLONK_BUFFERPLANNER_H
+
+#include "../plonk_GraphForwardDeclarations.h"
+#include "../channel/plonk_ChannelInternalBase.h"
+#include "plonk_ParallelRenderer.h"
+
+
+/** Assigns the intermediate outputs of a graph to a pool of shared buffers.
+ Normally every channel keeps its own output buffer even though most are 
+ only read once, by a single consumer, during the same block. plan() walks the
+ graph pulled by a unit and gives these outputs buffers from a small pool 
+ instead, in the manner of a register allocator, so the working set of a large
+ graph is only a few buffers rather than one per channel.
+ 
+ The exact order in which a channel processes its inputs isn't known so the
+ allocation is conservative. A channel is only given a shared buffer if it has 
+ exactly one consumer in the graph, has the same sample type, block size and 
+ sample rate as the root with no overlap, and canUseExternalBuffer() returns
+ @c true. Constants, proxies and the root's own channels keep their buffers. 
+ An input's buffer is kept distinct from its consumer's and from those of 
+ every channel its sibling inputs might process while it is waiting to be read.
+ The buffer of a channel which writes its output between pulling its inputs
+ is kept distinct from every channel in its input subgraph.
+ 
+ This is optional, and only safe while the graph is processed from the root
+ as it was when planned. The output of a planned channel is only valid until
+ its consumer has processed so don't read it directly (e.g., from another
+ unit held elsewhere). Call plan() again after the graph, block size or sample 
+ rate are changed and don't plan or clear() while the graph is being processed.
+ Graphs with patches, unit queues or other inputs which change while 
+ running are not planned at all. Tasks containing planned channels are 
+ rendered serially by ParallelRenderer since its threads would share the pool.
+ @see ChannelInternalCore::canUseExternalBuffer() */
+template<class SampleType>
+class BufferPlannerBase
+{
+public:
+    typedef ChannelInternalBase<SampleType>     InternalType;
+    typedef ChannelBase<SampleType>             ChannelType;
+    typedef UnitBase<SampleType>                UnitType;
+    typedef NumericalArray<SampleType>          Buffer;
+    typedef ObjectArray<Buffer>                 Buffers;
+    typedef ObjectArray<ChannelType>            ChannelArray;
+    typedef ObjectArray<ChannelInternalCore*>   Channels;
+    typedef ObjectArray<const void*>            Resources;
+    typedef ObjectArray<IntArray>               IntArrays;
+    
+    BufferPlannerBase() throw()
+    {
+    }
+    
+    ~BufferPlannerBase()
+    {
+        clear();
+    }
+    
+    /** Plans the buffers for the graph pulled by a unit.
+     Any previous plan is cleared first. 
+     @return @c false if the graph could not be planned because it can change 
+     while running, in which case nothing is changed. */
+    bool plan (UnitType const& root) throw()
+    {
+        clear();
+        
+        const int numRoots = root.getNumChannels();
+        
+        if (numRoots == 0)
+            return true;
+        
+        const InternalType* const first = root.atUnchecked (0).getInternal();
+        rootBlockSize = first->getBlockSize().getValue();
+        rootSampleRate = first->getSampleRate().getValue();
+        
+        bool complete = true;
+        int i;
+        
+        numNodes = 0;
+        numOrdered = 0;
+        numInputs = 0;
+        
+        for (i = 0; i < numRoots; ++i)
+        {
+            ChannelInternalCore* const channel = root.atUnchecked (i).getInternal();
+            
+            if (addChannel (channel, -1, false) < 0)
+                complete = false;
+        }
+        
+        for (i = 0; i < numRoots; ++i)
+            eligible.atUnchecked (root.atUnchecked (i).getInternal()->bufferIndex) = 0;
+        
+        if (complete)
+        {
+            // post order puts inputs before their consumers so run backwards,
+            // each region is headed by a root or a channel with several consumers
+            forbidden = IntArray::newClear (numNodes + 1);
+            regions.setSize (numNodes, false);
+            numBuffers = 0;
+            
+            for (i = numNodes; --i >= 0;)
+            {
+                const int node = order.atUnchecked (i);
+                
+                if (isHead (node))
+                {
+                    IntArray& seeds = regions.atUnchecked (node);
+                    const int numSeeds = seeds.length();
+                    int j;
+                    
+                    for (j = 0; j < numSeeds; ++j)
+                        ++forbidden.atUnchecked (seeds.atUnchecked (j));
+                    
+                    allocate (node, -1);
+                    
+                    for (j = 0; j < numSeeds; ++j)
+                        --forbidden.atUnchecked (seeds.atUnchecked (j));
+                }
+            }
+            
+            buffers.setSize (numBuffers, false);
+            
+            for (i = 0; i < numBuffers; ++i)
+                buffers.atUnchecked (i) = Buffer::newClear (rootBlockSize);
+            
+            int numPlanned = 0;
+            
+            for (i = 0; i < numNodes; ++i)
+                if (assigned.atUnchecked (i) >= 0)
+                    ++numPlanned;
+            
+            planned.setSize (numPlanned, false);
+            numPlanned = 0;
+            
+            for (i = 0; i < numNodes; ++i)
+            {
+                const int buffer = assigned.atUnchecked (i);
+                
+                if (buffer >= 0)
+                {
+                    InternalType* const internal = static_cast<InternalType*> (nodes.atUnchecked (i));
+                    internal->setOutputBuffer (buffers.atUnchecked (buffer));
+                    internal->bufferPlanner = this;
+                    planned.atUnchecked (numPlanned++) = ChannelType (internal);
+                }
+            }
+        }
+        
+        for (i = 0; i < numNodes; ++i)
+            nodes.atUnchecked (i)->bufferIndex = -1;
+        
+        nodes = Channels();
+        order = IntArray();
+        consumers = IntArray();
+        eligible = IntArray();
+        inputStarts = IntArray();
+        inputEnds = IntArray();
+        inputs = IntArray();
+        assigned = IntArray();
+        regions = IntArrays();
+        forbidden = IntArray();
+        
+        if (planned.length() > 0)
+            ParallelRenderer::invalidatePlans();
+        
+        return complete;
+    }
+    
+    /** Gives the planned channels their own buffers again. */
+    void clear() throw()
+    {
+        const int numPlanned = planned.length();
+        
+        for (int i = 0; i < numPlanned; ++i)
+        {
+            InternalType* const internal = planned.atUnchecked (i).getInternal();
+            internal->bufferPlanner = 0;
+            internal->removeExternalBuffer();
+        }
+        
+        planned.clear();
+        buffers.clear();
+        
+        if (numPlanned > 0)
+            ParallelRenderer::invalidatePlans();
+    }
+    
+    /** The number of channels using the shared buffers. */
+    PLONK_INLINE_LOW int getNumPlannedChannels() const throw()  { return planned.length(); }
+    
+    /** The number of buffers shared between the planned channels. */
+    PLONK_INLINE_LOW int getNumBuffers() const throw()          { return buffers.length(); }
+    
+private:
+    ChannelArray planned;
+    Buffers buffers;
+    
+    // used only while planning
+    int rootBlockSize;
+    double rootSampleRate;
+    int numBuffers;
+    int numNodes;
+    int numOrdered;
+    int numInputs;
+    Channels nodes;
+    IntArray order;
+    IntArray consumers;
+    IntArray eligible;      // 1 if a node could share, 0 if not, -1 if it is processed in the background
+    IntArray inputStarts;   // range of each node's entries in inputs
+    IntArray inputEnds;
+    IntArray inputs;
+    IntArray assigned;
+    IntArrays regions;      // buffers live while each region head may be processed
+    IntArray forbidden;     // count of the reasons each buffer can't be used at the moment
+    
+    /** Adds a channel and its inputs, returning its index or -1 if its inputs can change. 
+     Channels processed in the background, e.g., by an InputTask, keep their own buffers. */
+    int addChannel (ChannelInternalCore* channel, const int consumer, const bool background) throw()
+    {
+        if (channel->bufferIndex >= 0)
+        {
+            ++consumers.atUnchecked (channel->bufferIndex);
+            
+            if (background)
+                removeBackground (channel->bufferIndex);
+            
+            return channel->bufferIndex;
+        }
+        
+        const int index = numNodes++;
+        
+        // arrays only grow to the size needed so double them here instead
+        if (index >= nodes.length())
+        {
+            const int size = plonk::max (64, nodes.length() * 2);
+            nodes.setSize (size, true);
+            order.setSize (size, true);
+            consumers.setSize (size, true);
+            eligible.setSize (size, true);
+            assigned.setSize (size, true);
+            inputStarts.setSize (size, true);
+            inputEnds.setSize (size, true);
+        }
+        
+        channel->bufferIndex = index;
+        nodes.atUnchecked (index) = channel;
+        consumers.atUnchecked (index) = consumer < 0 ? 0 : 1;
+        eligible.atUnchecked (index) = background ? -1 : isEligible (channel) ? 1 : 0;
+        assigned.atUnchecked (index) = -1;
+        inputStarts.atUnchecked (index) = 0;
+        inputEnds.atUnchecked (index) = 0;
+        
+        Channels dependencies;
+        Resources resources;
+        bool complete = static_cast<const ChannelInternalCore*> (channel)->getInputs().getDependencies (dependencies, resources);
+        
+        if (channel->getProxyOwner() != 0)
+            dependencies.add (channel->getProxyOwner());
+        
+        const int numDependencies = dependencies.length();
+        const bool inputsInBackground = background || channel->processesInputsInBackground();
+        int i;
+        
+        for (i = 0; i < numDependencies; ++i)
+            if (addChannel (dependencies.atUnchecked (i), index, inputsInBackground) < 0)
+                complete = false;
+        
+        // each node's inputs are stored together in post order
+        if ((numInputs + numDependencies) > inputs.length())
+            inputs.setSize (plonk::max (64, (numInputs + numDependencies) * 2), true);
+        
+        inputStarts.atUnchecked (index) = numInputs;
+        
+        for (i = 0; i < numDependencies; ++i)
+            inputs.atUnchecked (numInputs++) = dependencies.atUnchecked (i)->bufferIndex;
+        
+        inputEnds.atUnchecked (index) = numInputs;
+        order.atUnchecked (numOrdered++) = index;
+        
+        return complete ? index : -1;
+    }
+    
+    void removeBackground (const int node) throw()
+    {
+        if (eligible.atUnchecked (node) < 0)
+            return;
+        
+        eligible.atUnchecked (node) = -1;
+        
+        const int end = inputEnds.atUnchecked (node);
+        
+        for (int i = inputStarts.atUnchecked (node); i < end; ++i)
+            removeBackground (inputs.atUnchecked (i));
+    }
+    
+    bool isEligible (ChannelInternalCore* channel) const throw()
+    {
+        if (channel->isNull() || channel->isConstant() || channel->isProxy() || channel->isProxyOwner() ||
+            ! channel->canUseExternalBuffer() || (channel->bufferPlanner != 0) ||
+            (channel->getOutputTypeCode() != TypeUtility<SampleType>::getTypeCode()) ||
+            ! isInStep (channel))
+            return false;
+        
+        return ! static_cast<const InternalType*> (channel)->isUsingExternalBuffer();
+    }
+    
+    /** Whether a channel processes exactly once per block of the root. */
+    bool isInStep (const ChannelInternalCore* channel) const throw()
+    {
+        return (channel->getBlockSize().getValue() == rootBlockSize) &&
+               (channel->getSampleRate().getValue() == rootSampleRate) &&
+               (channel->getOverlap().getValue() == 1.0);
+    }
+    
+    PLONK_INLINE_LOW bool isHead (const int node) const throw()
+    {
+        return consumers.atUnchecked (node) != 1;
+    }
+    
+    PLONK_INLINE_LOW bool isPooled (const int node, const int consumer) const throw()
+    {
+        return ! isHead (node) && (eligible.atUnchecked (node) > 0) && isInStep (nodes.atUnchecked (consumer));
+    }
+    
+    /** Chooses buffers for a channel's inputs then for the rest of its region. 
+     Its inputs must avoid its own buffer and the buffers of their siblings which 
+     may be processed in any order, everything inside a sibling's subgraph must 
+     also avoid those since it may be processed while they are waiting. If the
+     channel writes its output between its inputs everything below it avoids its 
+     buffer too. */
+    void allocate (const int node, const int buffer) throw()
+    {
+        const int start = inputStarts.atUnchecked (node);
+        const int end = inputEnds.atUnchecked (node);
+        const bool keepBuffer = (buffer >= 0) && nodes.atUnchecked (node)->writesOutputBetweenInputs();
+        int i;
+        
+        if (buffer >= 0)
+            ++forbidden.atUnchecked (buffer);
+        
+        for (i = start; i < end; ++i)
+        {
+            const int input = inputs.atUnchecked (i);
+            
+            if (isPooled (input, node))
+            {
+                int choice = 0;
+                
+                while (forbidden.atUnchecked (choice) > 0)
+                    ++choice;
+                
+                assigned.atUnchecked (input) = choice;
+                ++forbidden.atUnchecked (choice);
+                numBuffers = plonk::max (numBuffers, choice + 1);
+            }
+        }
+        
+        if ((buffer >= 0) && ! keepBuffer)
+            --forbidden.atUnchecked (buffer);
+        
+        for (i = start; i < end; ++i)
+        {
+            const int input = inputs.atUnchecked (i);
+            const int inputBuffer = assigned.atUnchecked (input);
+            
+            if (isHead (input))
+            {
+                IntArray& seeds = regions.atUnchecked (input);
+                int numSeeds = seeds.length();
+                int j;
+                
+                for (j = 0; j < numBuffers; ++j)
+                    if (forbidden.atUnchecked (j) > 0)
+                        ++numSeeds;
+                
+                if (numSeeds > seeds.length())
+                {
+                    int seed = seeds.length();
+                    seeds.setSize (numSeeds, true);
+                    
+                    for (j = 0; j < numBuffers; ++j)
+                        if (forbidden.atUnchecked (j) > 0)
+                            seeds.atUnchecked (seed++) = j;
+                }
+            }
+            else if (inputBuffer >= 0)
+            {
+                --forbidden.atUnchecked (inputBuffer);
+                allocate (input, inputBuffer);
+                ++forbidden.atUnchecked (inputBuffer);
+            }
+            else
+            {
+                allocate (input, -1);
+            }
+        }
+        
+        for (i = start; i < end; ++i)
+        {
+            const int inputBuffer = assigned.atUnchecked (inputs.atUnchecked (i));
+            
+            if ((inputBuffer >= 0) && ! isHead (inputs.atUnchecked (i)))
+                --forbidden.atUnchecked (inputBuffer);
+        }
+        
+        if (keepBuffer)
+            --forbidden.atUnchecked (buffer);
+    }
+    
+    BufferPlannerBase (BufferPlannerBase const&);
+    BufferPlannerBase& operator= (BufferPlannerBase const&);
+};
+
+typedef BufferPlannerBase<PLONK_TYPE_DEFAULT> BufferPlanner;
+
+
+#endif // PLONK_BUFFERPLANNER_H
@@ -57,7 +57,16 @@ public:
     typedef Dictionary<BusType>                                                 BusDictionary;
     typedef typename BinaryOpFunctionsHelper<SampleType>::BinaryOpFunctionsType BinaryOpFunctionsType;    
 
+    enum Constants
+    {
+        MaxWriters = 16,    // writer slots on a concurrent bus
+        MaxBlocks = 32      // blocks in a concurrent bus's ring
+    };
+    
     BusBufferInternal() throw()
+    :   ringBlockSize (0),
+        ringNumBlocks (0),
+        writers (0)
     {
         this->bufferSize.addReceiver(this);
         this->writeBlockSize.addReceiver(this);
@@ -74,16 +83,57 @@ public:
         bufferEndTime (bufferStartTime + TimeStamp::fromSamples (bufferSize.getValue(), sampleRate)),
         latestValidTime (TimeStamp::getZero()),
         readDiff (0.0),
-        firstWriteSize (0)
+        firstWriteSize (0),
+        ringBlockSize (0),
+        ringNumBlocks (0),
+        writers (0)
     {
         this->bufferSize.addReceiver(this);
         this->writeBlockSize.addReceiver(this);
     } 
     
+    /** Creates a concurrent bus.
+     The ring holds @p numBlocks blocks of @p blockSize samples for each of
+     the MaxWriters writer slots and is never resized. */
+    BusBufferInternal (BlockSize const& blockSize,
+                       const int numBlocks,
+                       SampleRate const& sampleRateToUse) throw()
+    :   bufferSize (blockSize.getValue() * numBlocks),
+        writeBlockSize (blockSize.getValue()),
+        sampleRate (sampleRateToUse),
+        buffer (Buffer::newClear (blockSize.getValue() * numBlocks * MaxWriters)),
+        bufferStartTime (TimeStamp::getZero()),
+        bufferEndTime (TimeStamp::getZero()),
+        latestValidTime (TimeStamp::getZero()),
+        readDiff (0.0),
+        firstWriteSize (0),
+        ringBlockSize (blockSize.getValue()),
+        ringNumBlocks (numBlocks),
+        writers (new Writer[MaxWriters])
+    {
+        plonk_assert (ringBlockSize > 0);
+        plonk_assert ((ringNumBlocks > 1) && (ringNumBlocks <= MaxBlocks));
+        
+        this->bufferSize.addReceiver(this);
+        this->writeBlockSize.addReceiver(this);
+        
+        for (int i = 0; i < MaxWriters; ++i)
+        {
+            writers[i].claimed.setValue (0);
+            writers[i].committed.setValue (-1);
+            writers[i].epoch = -1;
+            
+            for (int j = 0; j < MaxBlocks; ++j)
+                writers[i].stamps[j].setValue (-1);
+        }
+    }
+    
     ~BusBufferInternal()
     {
         this->bufferSize.removeReceiver(this);
         this->writeBlockSize.removeReceiver(this);
+        
+        delete [] writers;
     }
     
     void changed (BlockSize::Sender const& source, Text const& message, Dynamic const& payload) throw()
@@ -95,6 +145,12 @@ public:
         
         if (blockSizeSource == bufferSize)
         {
+            if (isConcurrent())
+            {
+                plonk_assertfalse; // the ring of a concurrent bus has a fixed size
+                return;
+            }
+            
             plonk_assert (bufferSize.getValue() > buffer.length()); // code assumes the buffer will only grow at the moment
             
             buffer.setSize (bufferSize.getValue(), true); // copies existing data and zeros extra space too
@@ -106,13 +162,34 @@ public:
         }
     }
     
-    PLONK_INLINE_LOW void growBufferSize() throw()                            { bufferSize.setValue (bufferSize.getValue() * 2); }
+    PLONK_INLINE_LOW bool isConcurrent() const throw()                        { return writers != 0; }
+    PLONK_INLINE_LOW void growBufferSize() throw()                            { if (! isConcurrent()) bufferSize.setValue (bufferSize.getValue() * 2); }
     PLONK_INLINE_LOW BlockSize getBufferSize() const throw()                  { return bufferSize; }
     PLONK_INLINE_LOW BlockSize getWriteBlockSize() const throw()              { return writeBlockSize; }
     PLONK_INLINE_LOW SampleRate getSampleRate() const throw()                 { return sampleRate; }
-    PLONK_INLINE_LOW double getDuration() const throw()                       { return (bufferEndTime - bufferStartTime).getValue(); }
-    PLONK_INLINE_LOW const TimeStamp& getLatestValidTime() const throw()      { return latestValidTime; }
-    PLONK_INLINE_LOW const TimeStamp getEarliestValidTime() const throw()     { return latestValidTime - this->getDuration(); }
+    
+    PLONK_INLINE_LOW double getDuration() const throw()
+    {
+        if (isConcurrent())
+            return TimeStamp::fromSamples (ringBlockSize * (ringNumBlocks - 1), sampleRate.getValue()).getValue();
+        
+        return (bufferEndTime - bufferStartTime).getValue();
+    }
+    
+    PLONK_INLINE_LOW const TimeStamp getLatestValidTime() const throw()
+    {
+        if (isConcurrent())
+        {
+            LongLong latest, complete;
+            findEpochs (latest, complete);
+            return TimeStamp::fromSamples (double ((complete + 1) * ringBlockSize), sampleRate.getValue());
+        }
+        
+        return latestValidTime;
+    }
+    
+    PLONK_INLINE_LOW const TimeStamp getEarliestValidTime() const throw()     { return this->getLatestValidTime() - this->getDuration(); }
+
     Text getLabel() const throw()                                   { return identifier; }
     void setLabel (Text const& newId) throw()                       { identifier = newId; }
 
@@ -131,10 +208,108 @@ public:
         return buffer.findRMS();
     }
     
+    /** Claims a writer slot on a concurrent bus.
+     @return The slot to pass to write(), or -1 if the bus is not concurrent
+     or all the slots are in use. */
+    int addWriter() throw()
+    {
+        if (! isConcurrent())
+            return -1;
+        
+        for (int i = 0; i < MaxWriters; ++i)
+        {
+            Writer& writer = writers[i];
+            
+            if (writer.claimed.compareAndSwap (0, 1))
+            {
+                // the slot is only seen by readers once it is reset
+                writer.committed.setValue (-1);
+                writer.epoch = -1;
+                
+                for (int j = 0; j < MaxBlocks; ++j)
+                    writer.stamps[j].setValue (-1);
+                
+                writer.claimed.setValueRelease (2);
+                return i;
+            }
+        }
+        
+        plonk_assertfalse; // too many writers
+        return -1;
+    }
+    
+    void removeWriter (const int writerIndex) throw()
+    {
+        if (isConcurrent() && (writerIndex >= 0))
+            writers[writerIndex].claimed.setValueRelease (0);
+    }
+    
+    /** Writes to a writer slot, or mixes into the bus as write() does if the bus is not concurrent. 
+     Each slot must only be written by one thread at a time. */
+    void write (const int writerIndex,
+                TimeStamp const& writeStartTime,
+                const int numWriteSamples,
+                const SampleType* sourceData) throw()
+    {
+        if (! isConcurrent())
+        {
+            write (writeStartTime, numWriteSamples, sourceData);
+            return;
+        }
+        
+        if (writerIndex < 0)
+            return;
+        
+        Writer& writer = writers[writerIndex];
+        SampleType* const ringSamples = buffer.getArray();
+        
+        LongLong position = LongLong (writeStartTime.toSamples (sampleRate.getValue()) + 0.5);
+        int numSamplesRemaining = numWriteSamples;
+        
+        while (numSamplesRemaining > 0)
+        {
+            const LongLong epoch = position / ringBlockSize;
+            const int offset = int (position - epoch * ringBlockSize);
+            const int ringIndex = int (epoch % ringNumBlocks);
+            const int samplesThisTime = plonk::min (numSamplesRemaining, ringBlockSize - offset);
+            
+            SampleType* const blockSamples = ringSamples + (ringIndex * MaxWriters + writerIndex) * ringBlockSize;
+            
+            if (epoch != writer.epoch)
+            {
+                // invalidate the old contents before overwriting them so
+                // readers part way through them will discard what they read
+                writer.epoch = epoch;
+                writer.stamps[ringIndex].setValue (-1);
+                AtomicOps::releaseFence();
+                
+                if (offset > 0)
+                    NumericalArray<SampleType>::zeroData (blockSamples, offset);
+            }
+            
+            NumericalArray<SampleType>::copyData (blockSamples + offset, sourceData, samplesThisTime);
+            
+            if ((offset + samplesThisTime) == ringBlockSize)
+            {
+                writer.stamps[ringIndex].setValueRelease (epoch);
+                writer.committed.setValueRelease (epoch);
+            }
+            
+            numSamplesRemaining -= samplesThisTime;
+            sourceData += samplesThisTime;
+            position += samplesThisTime;
+        }
+    }
+    
     void write (TimeStamp writeStartTime,
                 const int numWriteSamples,
                 const SampleType* sourceData) throw()
     {
+        plonk_assert (! isConcurrent()); // concurrent busses need a writer slot
+        
+        if (isConcurrent())
+            return;
+        
         const int currentBufferSize = bufferSize.getValue();
         const double currentSampleRate = sampleRate.getValue();
         
@@ -216,6 +391,12 @@ public:
                const int numReadSamples, 
                SampleType* destData) throw()
     {                                
+        if (isConcurrent())
+        {
+            readRing (readStartTime, numReadSamples, destData);
+            return;
+        }
+        
         const int currentBufferSize = bufferSize.getValue();
         const double currentSampleRate = sampleRate.getValue();
         
@@ -285,6 +466,151 @@ public:
         
 
 private:
+    struct Writer
+    {
+        AtomicInt claimed;                  // 0 free, 1 being reset, 2 in use
+        AtomicLongLong committed;           // the latest complete block
+        LongLong epoch;                     // the block being written, only used by the writer
+        AtomicLongLong stamps[MaxBlocks];   // the block held in each ring position or -1
+        char padding[64];                   // keeps neighbouring writers off each other's cache lines
+    };
+    
+    /** Finds the latest block committed by any writer and the latest block
+     committed by all of them. Writers that have fallen further behind than
+     the ring holds (e.g., their graph is no longer being processed, or they
+     were added long after the others and have not written yet) are ignored. */
+    void findEpochs (LongLong& latest, LongLong& complete) const throw()
+    {
+        int i;
+        
+        latest = -1;
+        
+        for (i = 0; i < MaxWriters; ++i)
+            if (writers[i].claimed.getValueAcquire() == 2)
+                latest = plonk::max (latest, writers[i].committed.getValueAcquire());
+        
+        complete = latest;
+        
+        for (i = 0; i < MaxWriters; ++i)
+        {
+            if (writers[i].claimed.getValueAcquire() == 2)
+            {
+                const LongLong committed = writers[i].committed.getValueAcquire();
+                
+                if (committed > (latest - ringNumBlocks))
+                    complete = plonk::min (complete, committed);
+            }
+        }
+    }
+    
+    /** Sums the writer slots for the requested samples.
+     Only blocks committed by every writer are read and blocks overwritten
+     during the read are discarded, if any part of the read is unavailable
+     the output is zeroed and the read time is not advanced. A reader which
+     has fallen behind further than the ring holds is resynced to the latest
+     complete block. */
+    void readRing (TimeStamp& readStartTime,
+                   const int numReadSamples, 
+                   SampleType* destData) throw()
+    {
+        const double currentSampleRate = sampleRate.getValue();
+        const SampleType* const ringSamples = buffer.getArray();
+        
+        LongLong latest, complete;
+        findEpochs (latest, complete);
+        
+        LongLong position;
+        
+        if (readStartTime < TimeStamp::getZero())
+            position = (complete + 1) * ringBlockSize - numReadSamples;
+        else
+            position = LongLong (readStartTime.toSamples (currentSampleRate) + 0.5);
+        
+        const LongLong startPosition = position;
+        SampleType* dest = destData;
+        int numSamplesRemaining = numReadSamples;
+        bool valid = (complete >= 0) && (position >= 0);
+        bool overrun = false;
+        
+        while (valid && (numSamplesRemaining > 0))
+        {
+            const LongLong epoch = position / ringBlockSize;
+            const int offset = int (position - epoch * ringBlockSize);
+            const int ringIndex = int (epoch % ringNumBlocks);
+            const int samplesThisTime = plonk::min (numSamplesRemaining, ringBlockSize - offset);
+            
+            if (epoch <= (latest - ringNumBlocks))
+            {
+                overrun = true;
+                valid = false;
+                break;
+            }
+            
+            if (epoch > complete)
+            {
+                valid = false;
+                break;
+            }
+            
+            int mixed[MaxWriters];
+            int numMixed = 0;
+            
+            for (int i = 0; i < MaxWriters; ++i)
+            {
+                const Writer& writer = writers[i];
+                
+                if ((writer.claimed.getValueAcquire() == 2) && 
+                    (writer.stamps[ringIndex].getValueAcquire() == epoch))
+                {
+                    const SampleType* const blockSamples = ringSamples + (ringIndex * MaxWriters + i) * ringBlockSize + offset;
+                    
+                    if (numMixed == 0)
+                        NumericalArray<SampleType>::copyData (dest, blockSamples, samplesThisTime);
+                    else
+                        NumericalArrayBinaryOp<SampleType, BinaryOpFunctionsType::addop>::calcNN (dest, dest, blockSamples, samplesThisTime);
+                    
+                    mixed[numMixed++] = i;
+                }
+            }
+            
+            if (numMixed == 0)
+                NumericalArray<SampleType>::zeroData (dest, samplesThisTime);
+            
+            AtomicOps::acquireFence();
+            
+            for (int i = 0; i < numMixed; ++i)
+            {
+                if (writers[mixed[i]].stamps[ringIndex].getValueUnchecked() != epoch)
+                {
+                    overrun = true;
+                    valid = false;
+                }
+            }
+            
+            numSamplesRemaining -= samplesThisTime;
+            dest += samplesThisTime;
+            position += samplesThisTime;
+        }
+        
+        if (valid)
+        {
+            readStartTime = TimeStamp::fromSamples (double (startPosition + numReadSamples), currentSampleRate);
+        }
+        else if (overrun && (readStartTime >= TimeStamp::getZero()))
+        {
+            // the blocks we wanted have gone so start again from the latest
+            readStartTime = TimeStamp::getSentinel();
+            readRing (readStartTime, numReadSamples, destData);
+        }
+        else
+        {
+            if (readStartTime < TimeStamp::getZero())
+                readStartTime = TimeStamp::getSentinel();
+            
+            NumericalArray<SampleType>::zeroData (destData, numReadSamples);
+        }
+    }
+    
     BlockSize bufferSize;       // size of the circular buffer
     BlockSize writeBlockSize;   // estimated size of the write operations
     SampleRate sampleRate;      // sample rate of the audio
@@ -295,6 +621,9 @@ private:
     double readDiff;
     int firstWriteSize;         // size of the actual first write
     Text identifier;            // named ID for the buffer
+    int ringBlockSize;          // block size of a concurrent bus, 0 otherwise
+    int ringNumBlocks;          // number of blocks in the ring of a concurrent bus
+    Writer* writers;            // writer slots of a concurrent bus, 0 otherwise
 };
 
 
@@ -303,7 +632,17 @@ private:
  from the bus at "any" block size and get enough data to fill their output. 
  Of course this depends on the buffer size being large enough (although the
  buffer should automatically resize if you try to read in larger chunks
- than the current buffer size allows). */
+ than the current buffer size allows). 
+ 
+ These busses must only be written and read on one thread. Busses created 
+ with createConcurrent() or addConcurrentBus() may be written and read from 
+ any number of threads (e.g., the ParallelRenderer's workers) without locks. 
+ They have a fixed ring of blocks where each writer mixes into its own slot
+ and commits each complete block by publishing the block's epoch (its position 
+ in time in blocks). Readers sum the slots for blocks that every writer has 
+ committed so they always get whole blocks, this may be a block later than 
+ reading a bus written earlier on the same thread. Each writer needs a slot 
+ from addWriter(), BusWrite does this for you. */
 template<class SampleType>
 class BusBuffer : public SmartPointerContainer<BusBufferInternal<SampleType> >
 {
@@ -341,6 +680,17 @@ public:
     {
     }        
     
+    /** Creates a concurrent bus.
+     @param blockSize The size of the blocks that are committed to the bus.
+     @param numBlocks The number of blocks held for readers (2 to Internal::MaxBlocks).
+     @param sampleRate The sample rate of the bus. */
+    static BusBuffer createConcurrent (BlockSize const& blockSize = BlockSize::getDefault(),
+                                       const int numBlocks = 8,
+                                       SampleRate const& sampleRate = SampleRate::getDefault()) throw()
+    {
+        return BusBuffer (new Internal (blockSize, numBlocks, sampleRate));
+    }
+    
     explicit BusBuffer (Internal* internal) throw()
     :   Base (internal)
     {
@@ -350,6 +700,14 @@ public:
 	:	Base (static_cast<Base const&> (copy))
 	{
 	}        
+    
+    BusBuffer& operator= (BusBuffer const& other) throw()
+	{
+		if (this != &other)
+            this->setInternal (other.getInternal());
+        
+        return *this;
+	}
             
     static const BusBuffer& getNull() throw()
 	{
@@ -357,6 +715,7 @@ public:
 		return null;
 	}	                    
     
+    PLONK_INLINE_LOW bool isConcurrent() const throw()                        { return this->getInternal()->isConcurrent(); }
     PLONK_INLINE_LOW void growBufferSize() throw()                            { this->getInternal()->growBufferSize(); }
     PLONK_INLINE_LOW const BlockSize getBufferSize() const throw()            { return this->getInternal()->getBufferSize(); }
     PLONK_INLINE_LOW BlockSize getBufferSize() throw()                        { return this->getInternal()->getBufferSize(); }
@@ -365,7 +724,7 @@ public:
     PLONK_INLINE_LOW const SampleRate getSampleRate() const throw()           { return this->getInternal()->getSampleRate(); }
     PLONK_INLINE_LOW SampleRate getSampleRate() throw()                       { return this->getInternal()->getSampleRate(); }
     PLONK_INLINE_LOW double getDuration() throw()                             { return this->getInternal()->getDuration(); }
-    PLONK_INLINE_LOW const TimeStamp& getLatestValidTime() const throw()      { return this->getInternal()->getLatestValidTime(); }
+    PLONK_INLINE_LOW const TimeStamp  getLatestValidTime() const throw()      { return this->getInternal()->getLatestValidTime(); }
     PLONK_INLINE_LOW const TimeStamp  getEarliestValidTime() const throw()    { return this->getInternal()->getEarliestValidTime(); }
     PLONK_INLINE_LOW Text getLabel() const throw()                            { return this->getInternal()->getLabel(); }
     PLONK_INLINE_LOW void setLabel(Text const& newId) throw()                 { this->getInternal()->setLabel (newId); }
@@ -376,6 +735,26 @@ public:
         this->getInternal()->write (timeStamp, numSamples, sourceData);
     }
     
+    /** Write data with a given time stamp start to a writer slot.
+     For busses that are not concurrent this is the same as write() without a slot. */
+    PLONK_INLINE_LOW void write (const int writer, TimeStamp const& timeStamp, const int numSamples, const SampleType* sourceData) throw()
+    {
+        this->getInternal()->write (writer, timeStamp, numSamples, sourceData);
+    }
+    
+    /** Claims a writer slot on a concurrent bus.
+     @return The slot or -1 if the bus is not concurrent (or has no free slots). */
+    PLONK_INLINE_LOW int addWriter() throw()
+    {
+        return this->getInternal()->addWriter();
+    }
+    
+    /** Frees a slot returned by addWriter(). */
+    PLONK_INLINE_LOW void removeWriter (const int writer) throw()
+    {
+        this->getInternal()->removeWriter (writer);
+    }
+    
     /** Read data from the bus with a given time stamp. */
     PLONK_INLINE_LOW void read (TimeStamp& timeStamp, const int numSamples, SampleType* destData) throw()
     {
@@ -431,6 +810,20 @@ public:
         dictionary.put (name, newBusBuffer);
     }
     
+    /** Adds a concurrent bus to the named busses.
+     @see createConcurrent() */
+    static void addConcurrentBus (Text const& name, 
+                                  BlockSize const& blockSize = BlockSize::getDefault(),
+                                  const int numBlocks = 8,
+                                  SampleRate const& sampleRate = SampleRate::getDefault()) throw()
+    {
+        BusDictionary& dictionary = getBusDictionary();
+        
+        plonk_assert (dictionary.getKeys().contains (name) == false);
+        
+        dictionary.put (name, createConcurrent (blockSize, numBlocks, sampleRate));
+    }
+    
     static void removeBus (Text const& name) throw()
     {
         getBusDictionary().remove (name);
@@ -0,0 +1,579 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_GRAPHSNAPSHOT_H
+#define PLONK_GRAPHSNAPSHOT_H
+
+#include "../plonk_GraphForwardDeclarations.h"
+#include "../channel/plonk_ChannelInternalBase.h"
+
+
+/** Saves and restores the running state of a graph.
+ A snapshot holds the state of every channel in the graph pulled by a unit:
+ each channel's output buffer, its Data and any other state it keeps such as
+ delay lines (see ChannelInternalCore::getStateBlock()). Restoring this into 
+ a graph built in the same way resumes it from where the snapshot was taken 
+ rather than from the start with empty delay lines, envelopes, filters etc, 
+ e.g., so a standby instance can take over a running patch.
+ 
+ There is no registry of unit types so the graph itself can't be built from
+ a snapshot. Instead the snapshot records the topology, that is the name, 
+ output type, block size and sample rate of each channel and which channels 
+ are its inputs. restore() only changes anything if these and the size of 
+ every state block match the graph it is given.
+ 
+ The file is a RIFF file with the format ID "PLGS" holding these chunks:
+ - "head" the version, counts and a byte order mark
+ - "chan" a record for each channel in the order they are found from the root
+ - "inpt" the indices of each channel's inputs
+ - "name" the null terminated channel names
+ - "stat" the state blocks, each aligned to 16 bytes in the file
+ - "blck" the position and size of each state block in "stat"
+ 
+ Everything is stored in the native byte order so the state blocks are 
+ copied straight from the file to the channels. Restoring from a file maps 
+ it rather than reading it. A snapshot is only portable between builds 
+ which have the same Data layouts. 
+ 
+ Graphs with patches, unit queues or other inputs which change while
+ running can't be saved. Don't save or restore while the graph is being 
+ processed. Timestamps aren't restored so the graph continues from the 
+ current time of the process it is restored into. */
+template<class SampleType>
+class GraphSnapshotBase
+{
+public:
+    typedef UnitBase<SampleType>                UnitType;
+    typedef ObjectArray<ChannelInternalCore*>   Channels;
+    typedef ObjectArray<const void*>            Resources;
+    
+    enum Constants
+    {
+        Version = 1,
+        ByteOrderMark = 0x01020304,
+        Alignment = 16
+    };
+    
+    /** Saves the state of the graph pulled by a unit to a file.
+     @return @c false if the graph can change while running or the file 
+     could not be written. */
+    static bool save (UnitType const& root, Text const& path) throw()
+    {
+        Graph graph;
+        const bool success = collect (root, graph) && write (graph, path);
+        release (graph);
+        return success;
+    }
+    
+    /** Restores the state of the graph pulled by a unit from a file. 
+     @return @c false if the file could not be read or doesn't match the 
+     graph, in which case nothing is changed. */
+    static bool restore (UnitType const& root, Text const& path) throw()
+    {
+        PlankFile file;
+        pl_File_Init (&file);
+        
+        bool success = pl_File_OpenMapped (&file, path.getArray(), PLANK_FALSE) == PlankResult_OK;
+        
+        if (! success)
+            success = pl_File_OpenBinaryRead (&file, path.getArray(), PLANK_FALSE, PLANK_FALSE) == PlankResult_OK;
+        
+        if (success)
+            success = restoreFile (root, &file);
+        
+        pl_File_DeInit (&file);
+        return success;
+    }
+    
+    /** Restores the state of the graph pulled by a unit from a snapshot in memory. 
+     @return @c false if the snapshot doesn't match the graph, in which case 
+     nothing is changed. */
+    static bool restore (UnitType const& root, const void* data, const LongLong numBytes) throw()
+    {
+        PlankFile file;
+        pl_File_Init (&file);
+        
+        bool success = pl_File_OpenMemory (&file, const_cast<void*> (data), numBytes, 
+                                           PLANKFILE_READ | PLANKFILE_BINARY) == PlankResult_OK;
+        
+        if (success)
+            success = restoreFile (root, &file);
+        
+        pl_File_DeInit (&file);
+        return success;
+    }
+    
+private:
+    struct Header
+    {
+        int byteOrderMark;
+        int version;
+        int sampleTypeCode;
+        int numChannels;
+        int numInputs;
+        int numBlocks;
+        int namesLength;
+        int reserved;
+    };
+    
+    struct ChannelRecord
+    {
+        int outputTypeCode;
+        int nameOffset;
+        int firstInput;
+        int numInputs;
+        int firstBlock;
+        int numBlocks;
+        int blockSize;
+        int reserved;
+        double sampleRate;
+    };
+    
+    struct BlockRecord
+    {
+        LongLong offset;    // from the start of the "stat" data
+        int numBytes;
+        int reserved;
+    };
+    
+    typedef ObjectArray<ChannelRecord>  ChannelRecords;
+    typedef ObjectArray<BlockRecord>    BlockRecords;
+    
+    struct Graph
+    {
+        Graph() throw()
+        :   numNodes (0),
+            numInputs (0)
+        {
+        }
+        
+        int numNodes;
+        int numInputs;
+        Channels nodes;
+        IntArray inputStarts;   // range of each node's entries in inputs
+        IntArray inputEnds;
+        IntArray inputs;
+    };
+    
+    /** Indexes the channels pulled by the root and their inputs.
+     @return @c false if the inputs could change at run time. */
+    static bool collect (UnitType const& root, Graph& graph) throw()
+    {
+        const int numRoots = root.getNumChannels();
+        bool complete = true;
+        
+        for (int i = 0; i < numRoots; ++i)
+            if (addChannel (graph, root.atUnchecked (i).getInternal()) < 0)
+                complete = false;
+        
+        return complete;
+    }
+    
+    static int addChannel (Graph& graph, ChannelInternalCore* channel) throw()
+    {
+        if (channel->bufferIndex >= 0)
+            return channel->bufferIndex;
+        
+        const int index = graph.numNodes++;
+        
+        // arrays only grow to the size needed so double them here instead
+        if (index >= graph.nodes.length())
+        {
+            const int size = plonk::max (64, graph.nodes.length() * 2);
+            graph.nodes.setSize (size, true);
+            graph.inputStarts.setSize (size, true);
+            graph.inputEnds.setSize (size, true);
+        }
+        
+        channel->bufferIndex = index;
+        graph.nodes.atUnchecked (index) = channel;
+        
+        Channels dependencies;
+        Resources resources;
+        bool complete = static_cast<const ChannelInternalCore*> (channel)->getInputs().getDependencies (dependencies, resources);
+        
+        if (channel->getProxyOwner() != 0)
+            dependencies.add (channel->getProxyOwner());
+        
+        const int numDependencies = dependencies.length();
+        int i;
+        
+        for (i = 0; i < numDependencies; ++i)
+            if (addChannel (graph, dependencies.atUnchecked (i)) < 0)
+                complete = false;
+        
+        if ((graph.numInputs + numDependencies) > graph.inputs.length())
+            graph.inputs.setSize (plonk::max (64, (graph.numInputs + numDependencies) * 2), true);
+        
+        graph.inputStarts.atUnchecked (index) = graph.numInputs;
+        
+        for (i = 0; i < numDependencies; ++i)
+            graph.inputs.atUnchecked (graph.numInputs++) = dependencies.atUnchecked (i)->bufferIndex;
+        
+        graph.inputEnds.atUnchecked (index) = graph.numInputs;
+        
+        return complete ? index : -1;
+    }
+    
+    static void release (Graph& graph) throw()
+    {
+        for (int i = 0; i < graph.numNodes; ++i)
+            graph.nodes.atUnchecked (i)->bufferIndex = -1;
+    }
+    
+    static int getNumBlocks (Graph const& graph) throw()
+    {
+        int numBlocks = 0;
+        
+        for (int i = 0; i < graph.numNodes; ++i)
+            numBlocks += graph.nodes.atUnchecked (i)->getNumStateBlocks();
+        
+        return numBlocks;
+    }
+    
+    static bool write (Graph const& graph, Text const& path) throw()
+    {
+        const int numChannels = graph.numNodes;
+        const int numBlocks = getNumBlocks (graph);
+        ChannelRecords channelRecords = ChannelRecords::withSize (numChannels);
+        BlockRecords blockRecords = BlockRecords::withSize (numBlocks);
+        TextArray names = TextArray::withSize (numChannels);
+        int namesLength = 0;
+        int firstBlock = 0;
+        int i, j;
+        
+        for (i = 0; i < numChannels; ++i)
+        {
+            ChannelInternalCore* const channel = graph.nodes.atUnchecked (i);
+            ChannelRecord& record = channelRecords.atUnchecked (i);
+            
+            Memory::zero (record);
+            names.atUnchecked (i) = channel->getName();
+            record.outputTypeCode = channel->getOutputTypeCode();
+            record.nameOffset = namesLength;
+            record.firstInput = graph.inputStarts.atUnchecked (i);
+            record.numInputs = graph.inputEnds.atUnchecked (i) - record.firstInput;
+            record.firstBlock = firstBlock;
+            record.numBlocks = channel->getNumStateBlocks();
+            record.blockSize = channel->getBlockSize().getValue();
+            record.sampleRate = channel->getSampleRate().getValue();
+            
+            namesLength += names.atUnchecked (i).length() + 1;
+            firstBlock += record.numBlocks;
+        }
+        
+        namesLength = ((namesLength + Alignment - 1) / Alignment) * Alignment;
+        CharArray namesData = CharArray::newClear (namesLength);
+        
+        for (i = 0; i < numChannels; ++i)
+            Memory::copy (namesData.getArray() + channelRecords.atUnchecked (i).nameOffset, 
+                          names.atUnchecked (i).getArray(), 
+                          names.atUnchecked (i).length());
+        
+        Header header;
+        Memory::zero (header);
+        header.byteOrderMark = ByteOrderMark;
+        header.version = Version;
+        header.sampleTypeCode = TypeUtility<SampleType>::getTypeCode();
+        header.numChannels = numChannels;
+        header.numInputs = graph.numInputs;
+        header.numBlocks = numBlocks;
+        header.namesLength = namesLength;
+        
+        PlankIffFileWriter writer;
+        pl_IffFileWriter_Init (&writer);
+        
+        ResultCode result = pl_IffFileWriter_OpenReplacing (&writer, path.getArray(), PLANK_FALSE, "RIFF", "PLGS", PLANKIFFFILE_ID_FCC);
+        
+        if (result == PlankResult_OK)
+            result = pl_IffFileWriter_WriteChunk (&writer, 0, "head", &header, sizeof (Header), PLANKIFFFILEWRITER_MODEAPPEND);
+        
+        if (result == PlankResult_OK)
+            result = pl_IffFileWriter_WriteChunk (&writer, 0, "chan", channelRecords.getArray(), numChannels * sizeof (ChannelRecord), PLANKIFFFILEWRITER_MODEAPPEND);
+        
+        if (result == PlankResult_OK)
+            result = pl_IffFileWriter_WriteChunk (&writer, 0, "inpt", graph.inputs.getArray(), graph.numInputs * sizeof (int), PLANKIFFFILEWRITER_MODEAPPEND);
+        
+        if (result == PlankResult_OK)
+            result = pl_IffFileWriter_WriteChunk (&writer, 0, "name", namesData.getArray(), namesLength, PLANKIFFFILEWRITER_MODEAPPEND);
+        
+        // the blocks are aligned in the file so the state chunk is created first to find its
+        // position then reserved at its full size and filled in one pass
+        PlankIffFileWriterChunkInfoRef stateInfo = 0;
+        LongLong stateLength = 0;
+        
+        if (result == PlankResult_OK)
+            result = pl_IffFileWriter_WriteChunk (&writer, 0, "stat", 0, 0, PLANKIFFFILEWRITER_MODEAPPEND);
+        
+        if (result == PlankResult_OK)
+            result = pl_IffFileWriter_SeekChunk (&writer, 0, "stat", &stateInfo, 0);
+        
+        if ((result == PlankResult_OK) && (stateInfo == 0))
+            result = PlankResult_FileWriteError;
+        
+        if (result == PlankResult_OK)
+        {
+            const LongLong statePos = stateInfo->chunkPos;
+            
+            for (i = 0, firstBlock = 0; i < numChannels; ++i)
+            {
+                ChannelInternalCore* const channel = graph.nodes.atUnchecked (i);
+                const int channelBlocks = channelRecords.atUnchecked (i).numBlocks;
+                
+                for (j = 0; j < channelBlocks; ++j)
+                {
+                    BlockRecord& record = blockRecords.atUnchecked (firstBlock + j);
+                    int numBytes;
+                    channel->getStateBlock (j, numBytes);
+                    
+                    stateLength += (Alignment - ((statePos + stateLength) % Alignment)) % Alignment;
+                    
+                    Memory::zero (record);
+                    record.offset = stateLength;
+                    record.numBytes = numBytes;
+                    
+                    stateLength += numBytes;
+                }
+                
+                firstBlock += channelBlocks;
+            }
+            
+            if (stateLength > 0x7fffffff)
+                result = PlankResult_FileWriteError;
+            
+            if (result == PlankResult_OK)
+                result = pl_IffFileWriter_WriteChunk (&writer, 0, "stat", 0, PlankUI (stateLength), PLANKIFFFILEWRITER_MODEAPPEND);
+            
+            PlankFileRef file = pl_IffFileWriter_GetFile (&writer);
+            
+            if (result == PlankResult_OK)
+                result = pl_File_SetPosition (file, statePos);
+            
+            LongLong position = 0;
+            
+            for (i = 0, firstBlock = 0; (i < numChannels) && (result == PlankResult_OK); ++i)
+            {
+                ChannelInternalCore* const channel = graph.nodes.atUnchecked (i);
+                const int channelBlocks = channelRecords.atUnchecked (i).numBlocks;
+                
+                for (j = 0; (j < channelBlocks) && (result == PlankResult_OK); ++j)
+                {
+                    const BlockRecord& record = blockRecords.atUnchecked (firstBlock + j);
+                    int numBytes;
+                    const void* const block = channel->getStateBlock (j, numBytes);
+                    
+                    if (record.offset > position)
+                        result = pl_File_WriteZeros (file, int (record.offset - position));
+                    
+                    if ((result == PlankResult_OK) && (numBytes > 0))
+                        result = pl_File_Write (file, block, numBytes);
+                    
+                    position = record.offset + numBytes;
+                }
+                
+                firstBlock += channelBlocks;
+            }
+        }
+        
+        if (result == PlankResult_OK)
+            result = pl_IffFileWriter_WriteChunk (&writer, 0, "blck", blockRecords.getArray(), numBlocks * sizeof (BlockRecord), PLANKIFFFILEWRITER_MODEAPPEND);
+        
+        const ResultCode closeResult = pl_IffFileWriter_DeInit (&writer);
+        
+        return (result == PlankResult_OK) && (closeResult == PlankResult_OK);
+    }
+    
+    static bool restoreFile (UnitType const& root, PlankFileRef file) throw()
+    {
+        PlankIffFileReader reader;
+        pl_IffFileReader_Init (&reader);
+        
+        Graph graph;
+        bool success = (pl_IffFileReader_OpenWithFile (&reader, file) == PlankResult_OK) && 
+                       collect (root, graph) && 
+                       read (graph, &reader);
+        
+        release (graph);
+        pl_IffFileReader_DeInit (&reader);
+        
+        return success;
+    }
+    
+    static bool readChunk (PlankIffFileReaderRef reader, const char* chunkID, void* data, const int numBytes, LongLong* chunkPos = 0) throw()
+    {
+        LongLong length, pos;
+        int bytesRead = 0;
+        
+        if ((pl_IffFileReader_SeekChunk (reader, 0, chunkID, &length, &pos) != PlankResult_OK) || (length < numBytes))
+            return false;
+        
+        if (chunkPos != 0)
+            *chunkPos = pos;
+        
+        if (numBytes == 0)
+            return true;
+        
+        PlankFileRef file = pl_IffFileReader_GetFile (reader);
+        
+        return (pl_File_SetPosition (file, pos) == PlankResult_OK) &&
+               (pl_File_Read (file, data, numBytes, &bytesRead) == PlankResult_OK) &&
+               (bytesRead == numBytes);
+    }
+    
+    static bool read (Graph const& graph, PlankIffFileReaderRef reader) throw()
+    {
+        PlankIffID mainID, formatID;
+        pl_IffFileReader_GetMainID (reader, &mainID);
+        pl_IffFileReader_GetFormatID (reader, &formatID);
+        
+        if ((mainID.fcc != pl_FourCharCode ("RIFF")) || (formatID.fcc != pl_FourCharCode ("PLGS")))
+            return false;
+        
+        Header header;
+        
+        if (! readChunk (reader, "head", &header, sizeof (Header)))
+            return false;
+        
+        if ((header.byteOrderMark != ByteOrderMark) ||
+            (header.version != Version) ||
+            (header.sampleTypeCode != TypeUtility<SampleType>::getTypeCode()) ||
+            (header.numChannels != graph.numNodes) ||
+            (header.numInputs != graph.numInputs) ||
+            (header.numBlocks != getNumBlocks (graph)) ||
+            (header.namesLength < 1))
+            return false;
+        
+        const int numChannels = header.numChannels;
+        const int numBlocks = header.numBlocks;
+        ChannelRecords channelRecords = ChannelRecords::withSize (numChannels);
+        BlockRecords blockRecords = BlockRecords::withSize (numBlocks);
+        IntArray inputs = IntArray::withSize (header.numInputs);
+        CharArray names = CharArray::withSize (header.namesLength);
+        LongLong stateLength, statePos;
+        int i, j;
+        
+        if (! readChunk (reader, "chan", channelRecords.getArray(), numChannels * sizeof (ChannelRecord)) ||
+            ! readChunk (reader, "inpt", inputs.getArray(), header.numInputs * sizeof (int)) ||
+            ! readChunk (reader, "name", names.getArray(), header.namesLength) ||
+            ! readChunk (reader, "blck", blockRecords.getArray(), numBlocks * sizeof (BlockRecord)) ||
+            (pl_IffFileReader_SeekChunk (reader, 0, "stat", &stateLength, &statePos) != PlankResult_OK))
+            return false;
+        
+        names.atUnchecked (header.namesLength - 1) = 0;
+        
+        // check everything before changing anything
+        for (i = 0; i < numChannels; ++i)
+        {
+            ChannelInternalCore* const channel = graph.nodes.atUnchecked (i);
+            const ChannelRecord& record = channelRecords.atUnchecked (i);
+            const int firstInput = graph.inputStarts.atUnchecked (i);
+            
+            if ((record.outputTypeCode != channel->getOutputTypeCode()) ||
+                (record.blockSize != channel->getBlockSize().getValue()) ||
+                (record.sampleRate != channel->getSampleRate().getValue()) ||
+                (record.firstInput != firstInput) ||
+                (record.numInputs != (graph.inputEnds.atUnchecked (i) - firstInput)) ||
+                (record.numBlocks != channel->getNumStateBlocks()) ||
+                (record.firstBlock < 0) || ((record.firstBlock + record.numBlocks) > numBlocks) ||
+                (record.nameOffset < 0) || (record.nameOffset >= header.namesLength) ||
+                (channel->getName() != (names.getArray() + record.nameOffset)))
+                return false;
+            
+            for (j = 0; j < record.numInputs; ++j)
+                if (inputs.atUnchecked (firstInput + j) != graph.inputs.atUnchecked (firstInput + j))
+                    return false;
+            
+            for (j = 0; j < record.numBlocks; ++j)
+            {
+                const BlockRecord& blockRecord = blockRecords.atUnchecked (record.firstBlock + j);
+                int numBytes;
+                channel->getStateBlock (j, numBytes);
+                
+                if ((blockRecord.numBytes != numBytes) || (blockRecord.offset < 0) ||
+                    ((blockRecord.offset + numBytes) > stateLength))
+                    return false;
+            }
+        }
+        
+        PlankFileRef file = pl_IffFileReader_GetFile (reader);
+        
+        for (i = 0; i < numChannels; ++i)
+        {
+            ChannelInternalCore* const channel = graph.nodes.atUnchecked (i);
+            const ChannelRecord& record = channelRecords.atUnchecked (i);
+            
+            for (j = 0; j < record.numBlocks; ++j)
+            {
+                const BlockRecord& blockRecord = blockRecords.atUnchecked (record.firstBlock + j);
+                int numBytes;
+                void* const block = channel->getStateBlock (j, numBytes);
+                
+                if (numBytes == 0)
+                    continue;
+                
+                const void* source;
+                int bytesRead = 0;
+                
+                if (pl_File_SetPosition (file, statePos + blockRecord.offset) != PlankResult_OK)
+                    return false;
+                
+                // copy straight from mapped files and memory, otherwise read
+                ResultCode result = pl_File_ReadDirect (file, &source, numBytes, &bytesRead);
+                
+                if (result == PlankResult_OK)
+                    Memory::copy (block, source, bytesRead);
+                else if (result == PlankResult_FileNotMapped)
+                    result = pl_File_Read (file, block, numBytes, &bytesRead);
+                
+                if ((result != PlankResult_OK) || (bytesRead != numBytes))
+                    return false;
+            }
+        }
+        
+        return true;
+    }
+    
+    GraphSnapshotBase();
+    GraphSnapshotBase (GraphSnapshotBase const&);
+    GraphSnapshotBase& operator= (GraphSnapshotBase const&);
+};
+
+typedef GraphSnapshotBase<PLONK_TYPE_DEFAULT> GraphSnapshot;
+
+
+#endif // PLONK_GRAPHSNAPSHOT_H
@@ -167,5 +167,100 @@ void InputDictionary::resetExpiredUnits() throw()
     }
 }
 
+template<class SampleType>
+static void addUnitDependencies (UnitBase<SampleType> const& unit,
+                                 ObjectArray<ChannelInternalCore*>& channels) throw()
+{
+    const int numChannels = unit.getNumChannels();
+    
+    for (int i = 0; i < numChannels; ++i)
+        channels.add (unit.atUnchecked (i).getInternal());
+}
+
+template<class SampleType>
+static void addUnitsDependencies (NumericalArray2D<ChannelBase<SampleType>,UnitBase<SampleType> > const& units,
+                                  ObjectArray<ChannelInternalCore*>& channels) throw()
+{
+    const int numUnits = units.length();
+    
+    for (int i = 0; i < numUnits; ++i)
+        addUnitDependencies (units.atUnchecked (i), channels);
+}
+
+template<class SampleType>
+static void addBussesDependencies (PLONK_BUSARRAYBASETYPE<BusBuffer<SampleType> > const& busses,
+                                   ObjectArray<const void*>& resources) throw()
+{
+    const int numBusses = busses.length();
+    
+    // concurrent busses can be shared between threads
+    for (int i = 0; i < numBusses; ++i)
+        if (! busses.atUnchecked (i).isConcurrent())
+            resources.add (busses.atUnchecked (i).getInternal());
+}
+
+bool InputDictionary::getDependencies (ObjectArray<ChannelInternalCore*>& channels, 
+                                       ObjectArray<const void*>& resources) const throw()
+{
+    const DynamicArray& items = this->getValues();
+    const int numItems = items.length();
+    bool complete = true;
+    
+    for (int i = 0; i < numItems; ++i)
+    {
+        const Dynamic& item = items.atUnchecked (i);
+        const int type = item.getTypeCode();
+        
+        switch (type)
+        {
+            case TypeCode::FloatUnit:       addUnitDependencies (item.asUnchecked<FloatUnit>(), channels);          break;
+            case TypeCode::DoubleUnit:      addUnitDependencies (item.asUnchecked<DoubleUnit>(), channels);         break;
+            case TypeCode::IntUnit:         addUnitDependencies (item.asUnchecked<IntUnit>(), channels);            break;
+            case TypeCode::ShortUnit:       addUnitDependencies (item.asUnchecked<ShortUnit>(), channels);          break;
+            case TypeCode::Int24Unit:       addUnitDependencies (item.asUnchecked<Int24Unit>(), channels);          break;
+            case TypeCode::LongUnit:        addUnitDependencies (item.asUnchecked<LongUnit>(), channels);           break;
+
+            case TypeCode::FloatUnits:      addUnitsDependencies (item.asUnchecked<FloatUnits>(), channels);        break;
+            case TypeCode::DoubleUnits:     addUnitsDependencies (item.asUnchecked<DoubleUnits>(), channels);       break;
+            case TypeCode::IntUnits:        addUnitsDependencies (item.asUnchecked<IntUnits>(), channels);          break;
+            case TypeCode::ShortUnits:      addUnitsDependencies (item.asUnchecked<ShortUnits>(), channels);        break;
+            case TypeCode::Int24Units:      addUnitsDependencies (item.asUnchecked<Int24Units>(), channels);        break;
+            case TypeCode::LongUnits:       addUnitsDependencies (item.asUnchecked<LongUnits>(), channels);         break;
+
+            case TypeCode::FloatChannel:    channels.add (item.asUnchecked<FloatChannel>().getInternal());          break;
+            case TypeCode::DoubleChannel:   channels.add (item.asUnchecked<DoubleChannel>().getInternal());         break;
+            case TypeCode::IntChannel:      channels.add (item.asUnchecked<IntChannel>().getInternal());            break;
+            case TypeCode::ShortChannel:    channels.add (item.asUnchecked<ShortChannel>().getInternal());          break;
+            case TypeCode::Int24Channel:    channels.add (item.asUnchecked<Int24Channel>().getInternal());          break;
+            case TypeCode::LongChannel:     channels.add (item.asUnchecked<LongChannel>().getInternal());           break;
+
+            case TypeCode::FloatBusses:     addBussesDependencies (item.asUnchecked<FloatBusses>(), resources);     break;
+            case TypeCode::DoubleBusses:    addBussesDependencies (item.asUnchecked<DoubleBusses>(), resources);    break;
+            case TypeCode::IntBusses:       addBussesDependencies (item.asUnchecked<IntBusses>(), resources);       break;
+            case TypeCode::ShortBusses:     addBussesDependencies (item.asUnchecked<ShortBusses>(), resources);     break;
+            case TypeCode::Int24Busses:     addBussesDependencies (item.asUnchecked<Int24Busses>(), resources);     break;
+            case TypeCode::LongBusses:      addBussesDependencies (item.asUnchecked<LongBusses>(), resources);      break;
+
+            default:
+                if (TypeCode::isBus (type)              ||
+                    TypeCode::isAudioFileReader (type)  ||
+                    TypeCode::isBufferQueue (type))
+                {
+                    resources.add (item.getItem().getInternal());
+                }
+                else if (((type >= TypeCode::FloatChannelVariable) && (type <= TypeCode::LongBussesVariable)) ||
+                         TypeCode::isUnitQueue (type)   ||
+                         TypeCode::isDynamic (type)     ||
+                         (type == TypeCode::DynamicArray))
+                {
+                    complete = false;
+                }
+                
+                // other types (values, variables, arrays, tables etc) are only read
+        }
+    }
+    
+    return complete;
+}
 
 END_PLONK_NAMESPACE
@@ -81,6 +81,17 @@ public:
     
     void resetExpiredUnits() throw();
     
+    /** Collects the channels and shared objects used when processing these inputs.
+     Unit, units and channel inputs add their channel internals to @p channels.
+     Inputs with state that is modified during processing (busses, file 
+     readers and buffer queues) add their internals to @p resources, except 
+     concurrent busses which any thread may use. This is not recursive.
+     @return @c false if the inputs could change which channels are processed
+     at run time (e.g., unit variables or unit queues) so the collected
+     dependencies are incomplete. */
+    bool getDependencies (ObjectArray<ChannelInternalCore*>& channels, 
+                          ObjectArray<const void*>& resources) const throw();
+    
     PLONK_OBJECTARROWOPERATOR(InputDictionary);
 };
 
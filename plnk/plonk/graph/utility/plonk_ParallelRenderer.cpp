@@ -0,0 +1,532 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#include "../../core/plonk_StandardHeader.h"
+
+BEGIN_PLONK_NAMESPACE
+
+#include "../../core/plonk_Headers.h"
+
+static AtomicInt& getRenderPass() throw()
+{
+    static AtomicInt pass;
+    return pass;
+}
+
+static AtomicInt& getPlanGeneration() throw()
+{
+    static AtomicInt planGeneration;
+    return planGeneration;
+}
+
+// builders share the render pass marks in the channels so only one may run at once
+static Lock& getBuildLock() throw()
+{
+    static Lock lock (Lock::MutexLock);
+    return lock;
+}
+
+//------------------------------------------------------------------------------
+
+ParallelRenderer::Plan::Groups::Groups() throw()
+:   planGeneration (-1)
+{
+}
+
+ParallelRenderer::Plan::Builder::Builder (Plan& owner) throw()
+:   plan (owner),
+    state (Plan::Idle)
+{
+}
+
+double ParallelRenderer::Plan::Builder::service() throw()
+{
+    // the plan may have been deleted unless we win the request
+    if (state.compareAndSwap (Plan::Requested, Plan::Building))
+    {
+        getBuildLock().lock();
+        ParallelRenderer::buildGroups (plan.job, plan.groups[1 - plan.current]);
+        getBuildLock().unlock();
+        
+        state.setValue (Plan::Ready);
+    }
+    
+    // woken when the next build is requested
+    return 1.0;
+}
+
+ParallelRenderer::Plan::Plan (Job& jobToPlan) throw()
+:   job (jobToPlan),
+    current (0),
+    builder (new Builder (*this))
+{
+    TaskPool::global().add (builder);
+}
+
+ParallelRenderer::Plan::~Plan()
+{
+    builder->state.compareAndSwap (Requested, Idle);
+    
+    while (builder->state.getValue() == Building)
+        Threading::yield();
+    
+    builder->end(); // the pool will delete the builder
+}
+
+bool ParallelRenderer::Plan::canChangeTasks() throw()
+{
+    // cancel a build that has not started yet, a later render() requests another
+    builder->state.compareAndSwap (Requested, Idle);
+    return builder->state.getValue() != Building;
+}
+
+bool ParallelRenderer::Plan::isValid (Groups const& groupsToCheck) throw()
+{
+    const int numTasks = job.getNumTasks();
+    
+    if ((groupsToCheck.taskIDs.length() != numTasks) || 
+        (groupsToCheck.planGeneration != getPlanGeneration().getValue()))
+        return false;
+    
+    for (int i = 0; i < numTasks; ++i)
+        if (groupsToCheck.taskIDs.atUnchecked (i) != job.getTaskID (i))
+            return false;
+    
+    return true;
+}
+
+//------------------------------------------------------------------------------
+
+ParallelRenderer::Worker::Worker (ParallelRenderer& owner, const int index) throw()
+:   Threading::Thread ("ParallelRenderer::Worker"),
+    renderer (owner),
+    participant (index),
+    event (Lock::MutexLock)
+{
+}
+
+ResultCode ParallelRenderer::Worker::run() throw()
+{
+    int seen = renderer.generation.getValue();
+    
+    while (! getShouldExit())
+    {
+        int current = renderer.generation.getValue();
+        
+        for (int spin = 0; (current == seen) && (spin < SpinCount); ++spin)
+        {
+            Threading::yield();
+            current = renderer.generation.getValue();
+        }
+        
+        if (current == seen)
+        {
+            event.wait();
+        }
+        else
+        {
+            seen = current;
+            ++renderer.active;
+            
+            // the render may have finished before we got here
+            if (renderer.open.getValue() && (renderer.generation.getValue() == seen))
+                renderer.renderGroups (participant);
+            
+            --renderer.active;
+        }
+    }
+    
+    return 0;
+}
+
+void ParallelRenderer::Worker::wake() throw()
+{
+    event.signal();
+}
+
+//------------------------------------------------------------------------------
+
+ParallelRenderer::ParallelRenderer() throw()
+:   job (0),
+    groups (0),
+    numParticipants (1)
+{
+    for (int i = 0; i < MaxThreads; ++i)
+        workers[i] = 0;
+    
+    for (int i = 0; i <= MaxThreads; ++i)
+        cursors[i].end = 0;
+}
+
+ParallelRenderer::~ParallelRenderer()
+{
+    setNumThreads (0);
+}
+
+ParallelRenderer& ParallelRenderer::global() throw()
+{
+    static ParallelRenderer renderer;
+    return renderer;
+}
+
+void ParallelRenderer::setNumThreads (const int newNumThreads) throw()
+{
+    plonk_assert (! Threading::currentThreadIsAudioThread());
+    
+    const int count = plonk::clip (newNumThreads, 0, (int)MaxThreads);
+    
+    // wait for any render in progress
+    while (! busy.compareAndSwap (0, 1))
+        Threading::yield();
+
+    const int oldCount = numThreads.getValue();
+    int i;
+    
+    for (i = count; i < oldCount; ++i)
+    {
+        workers[i]->setShouldExit();
+        workers[i]->wake();
+        
+        while (workers[i]->isRunning())
+            Threading::sleep (0.000001);
+        
+        delete workers[i];
+        workers[i] = 0;
+    }
+    
+    for (i = oldCount; i < count; ++i)
+    {
+        workers[i] = new Worker (*this, i + 1);
+        workers[i]->setPriorityAudio (BlockSize::getDefault().getValue(), 
+                                      SampleRate::getDefault().getValue());
+        workers[i]->setAffinity (i + 1);
+        workers[i]->start();
+    }
+    
+    numThreads.setValue (count);
+    busy.setValue (0);
+}
+
+bool ParallelRenderer::render (ProcessInfo& info, Plan& planToUse) throw()
+{
+    if (numThreads.getValue() == 0)
+        return false;
+    
+    if (! busy.compareAndSwap (0, 1))
+        return false;
+    
+    const int count = numThreads.getValue();
+    AtomicInt& buildState = planToUse.builder->state;
+    int i;
+    
+    if (! planToUse.isValid (planToUse.groups[planToUse.current]))
+    {
+        // swap in the last build, it may be out of date already
+        if (buildState.getValue() == Plan::Ready)
+        {
+            planToUse.current = 1 - planToUse.current;
+            buildState.setValue (Plan::Idle);
+        }
+        
+        if (! planToUse.isValid (planToUse.groups[planToUse.current]))
+        {
+            if (buildState.compareAndSwap (Plan::Idle, Plan::Requested))
+                planToUse.builder->wake();
+            
+            busy.setValue (0);
+            return false;
+        }
+    }
+    
+    const Plan::Groups& groupsToUse = planToUse.groups[planToUse.current];
+    const int numGroups = groupsToUse.getNumGroups();
+    
+    if ((count == 0) || (numGroups < 2))
+    {
+        busy.setValue (0);
+        return false;
+    }
+    
+    job = &planToUse.job;
+    groups = &groupsToUse;
+    timeStamp = info.getTimeStamp();
+    numParticipants = count + 1;
+    pending.setValue (numGroups);
+    shouldDelete.setValue (0);
+    
+    const int numUsed = plonk::min (numParticipants, numGroups);
+    
+    for (i = 0; i < numParticipants; ++i)
+    {
+        Cursor& cursor = cursors[i];
+        
+        if (i < numUsed)
+        {
+            cursor.next.setValue ((i * numGroups) / numUsed);
+            cursor.end = ((i + 1) * numGroups) / numUsed;
+        }
+        else
+        {
+            cursor.next.setValue (0);
+            cursor.end = 0;
+        }
+    }
+    
+    open.setValue (1);
+    ++generation;
+    
+    for (i = 1; i < numUsed; ++i)
+        workers[i - 1]->wake();
+    
+    renderGroups (0);
+    
+    while (pending.getValue() > 0)
+        Threading::yield();
+    
+    open.setValue (0);
+    
+    // workers may still be looking for groups to steal
+    while (active.getValue() > 0)
+        Threading::yield();
+    
+    if (shouldDelete.getValue())
+        info.setShouldDelete();
+    
+    job = 0;
+    groups = 0;
+    busy.setValue (0);
+    
+    return true;
+}
+
+void ParallelRenderer::renderGroups (const int participant) throw()
+{
+    ProcessInfo& info = infos[participant];
+    info.setTimeStamp (timeStamp);
+    
+    const int* const groupTasks = groups->groupTasks.getArray();
+    const int* const groupStarts = groups->groupStarts.getArray();
+    
+    // our own groups first, then steal from the others
+    for (int i = 0; i < numParticipants; ++i)
+    {
+        Cursor& cursor = cursors[(participant + i) % numParticipants];
+        int group;
+        
+        while ((group = ++cursor.next - 1) < cursor.end)
+        {
+            const int end = groupStarts[group + 1];
+            
+            for (int j = groupStarts[group]; j < end; ++j)
+            {
+                info.resetShouldDelete();
+                job->processTask (info, groupTasks[j]);
+                
+                if (info.getShouldDelete())
+                    shouldDelete.setValue (1);
+            }
+            
+            --pending;
+        }
+    }
+}
+
+void ParallelRenderer::buildGroups (Job& jobToPlan, Plan::Groups& planToBuild) throw()
+{
+    const int numTasks = jobToPlan.getNumTasks();
+    int i, task;
+    
+    ++getRenderPass();
+    
+    planToBuild.planGeneration = getPlanGeneration().getValue();
+    planToBuild.taskIDs.setSize (numTasks, false);
+    planToBuild.groupTasks.setSize (numTasks, false);
+    planToBuild.groupStarts.clear();
+    
+    IntArray parents = IntArray::withSize (numTasks);
+    IntArray incomplete = IntArray::newClear (numTasks);
+    IntArray resourceTasks;
+    Resources resources;
+    Channels channels;
+    
+    for (task = 0; task < numTasks; ++task)
+        parents.atUnchecked (task) = task;
+    
+    for (task = 0; task < numTasks; ++task)
+    {
+        planToBuild.taskIDs.atUnchecked (task) = jobToPlan.getTaskID (task);
+        
+        channels.clear();
+        jobToPlan.getTaskChannels (task, channels);
+        
+        const int numChannels = channels.length();
+        
+        for (i = 0; i < numChannels; ++i)
+            if (! addChannel (channels.atUnchecked (i), task, parents, resources, resourceTasks))
+                incomplete.atUnchecked (task) = 1;
+    }
+    
+    // tasks using the same bus, file reader etc must be rendered together too
+    const int numResources = resources.length();
+    
+    for (i = 1; i < numResources; ++i)
+    {
+        const void* const resource = resources.atUnchecked (i);
+        
+        for (int j = 0; j < i; ++j)
+        {
+            if (resources.atUnchecked (j) == resource)
+            {
+                merge (parents, resourceTasks.atUnchecked (i), resourceTasks.atUnchecked (j));
+                break;
+            }
+        }
+    }
+    
+    for (task = 0; task < numTasks; ++task)
+        if (incomplete.atUnchecked (task))
+            incomplete.atUnchecked (findRoot (parents, task)) = 1;
+    
+    // roots are always the lowest task in their group so groups are ordered 
+    // by their first task, count the tasks in each group then place them
+    IntArray starts = IntArray::newClear (numTasks + 1);
+    int numPlaced = 0;
+    
+    for (task = 0; task < numTasks; ++task)
+    {
+        const int root = findRoot (parents, task);
+        
+        if (! incomplete.atUnchecked (root))
+            ++starts.atUnchecked (root + 1);
+    }
+    
+    for (task = 0; task < numTasks; ++task)
+    {
+        const int size = starts.atUnchecked (task + 1);
+        starts.atUnchecked (task + 1) = numPlaced;
+        
+        if ((parents.atUnchecked (task) == task) && ! incomplete.atUnchecked (task))
+        {
+            planToBuild.groupStarts.add (numPlaced);
+            numPlaced += size;
+        }
+    }
+    
+    planToBuild.groupStarts.add (numPlaced);
+    planToBuild.groupTasks.setSize (numPlaced, false);
+    
+    for (task = 0; task < numTasks; ++task)
+    {
+        const int root = findRoot (parents, task);
+        
+        if (! incomplete.atUnchecked (root))
+            planToBuild.groupTasks.atUnchecked (starts.atUnchecked (root + 1)++) = task;
+    }
+}
+
+bool ParallelRenderer::addChannel (ChannelInternalCore* channel, const int task, IntArray& parents, 
+                                   Resources& resources, IntArray& resourceTasks) throw()
+{
+    // constants never process after their first block so can be shared freely
+    if ((channel == 0) || channel->isConstant())
+        return true;
+    
+    const int pass = getRenderPass().getValue();
+    
+    if (channel->renderPass == pass)
+    {
+        merge (parents, task, channel->renderTask);
+        return true;
+    }
+    
+    channel->renderPass = pass;
+    channel->renderTask = task;
+    
+    bool complete = addChannel (channel->getProxyOwner(), task, parents, resources, resourceTasks);
+    
+    // shared buffers are only safe when the graph is processed in order
+    if (channel->isUsingPlannedBuffer())
+        complete = false;
+    
+    Channels inputs;
+    
+    if (! static_cast<const ChannelInternalCore*> (channel)->getInputs().getDependencies (inputs, resources))
+        complete = false;
+    
+    while (resourceTasks.length() < resources.length())
+        resourceTasks.add (task);
+    
+    const int numInputs = inputs.length();
+    
+    for (int i = 0; i < numInputs; ++i)
+        if (! addChannel (inputs.atUnchecked (i), task, parents, resources, resourceTasks))
+            complete = false;
+    
+    return complete;
+}
+
+void ParallelRenderer::invalidatePlans() throw()
+{
+    ++getPlanGeneration();
+}
+
+int ParallelRenderer::findRoot (IntArray& parents, int task) throw()
+{
+    while (parents.atUnchecked (task) != task)
+    {
+        const int parent = parents.atUnchecked (task);
+        parents.atUnchecked (task) = parents.atUnchecked (parent);
+        task = parent;
+    }
+    
+    return task;
+}
+
+void ParallelRenderer::merge (IntArray& parents, const int task1, const int task2) throw()
+{
+    const int root1 = findRoot (parents, task1);
+    const int root2 = findRoot (parents, task2);
+    
+    // keep the lowest task as the root
+    if (root1 < root2)
+        parents.atUnchecked (root2) = root1;
+    else if (root2 < root1)
+        parents.atUnchecked (root1) = root2;
+}
+
+END_PLONK_NAMESPACE
@@ -0,0 +1,247 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_PARALLELRENDERER_H
+#define PLONK_PARALLELRENDERER_H
+
+#include "../plonk_GraphForwardDeclarations.h"
+#include "../utility/plonk_ProcessInfo.h"
+#include "../../core/plonk_Thread.h"
+#include "../../core/plonk_Lock.h"
+#include "plonk_TaskPool.h"
+
+
+/** Renders independent sibling subgraphs on a pool of worker threads.
+ Mixers pass their inputs to render() as a Job with one task per input. The 
+ channels reachable from each task are collected and tasks which share any 
+ channels, or any inputs with modifiable state (busses other than concurrent
+ busses, file readers, buffer queues) are merged into a single group. Each group is rendered on one thread 
+ in task order so the shared parts are still only processed once per block. 
+ The groups are divided between the worker threads and the calling thread,
+ threads that run out of groups steal the remaining groups from the others.
+ 
+ The grouping is stored in a Plan which is only rebuilt when the tasks in the
+ job change. This is done on the TaskPool so the graph is never walked on the
+ audio thread, the new grouping is swapped in at the start of the first
+ render() after it is ready and the tasks are rendered serially until then.
+ Tasks that can change which channels they process while running 
+ (i.e., those using patches or unit queues) and tasks containing channels
+ given shared buffers by a BufferPlanner are not rendered here. The caller 
+ must always render all of its tasks serially after calling render(), any 
+ channels already processed for the current time stamp are not processed again.
+ 
+ Nested calls (e.g., mixers inside other mixers' tasks) and calls from
+ other threads while a render is in progress return @c false immediately
+ so their tasks are rendered serially by the caller.
+ 
+ There are no worker threads by default so all rendering is serial. Use
+ setNumThreads() or AudioHostBase::setNumRenderThreads() to enable it.
+ @see UnitMixerUnit, ChannelMixerUnit */
+class ParallelRenderer
+{
+public:
+    enum Constants
+    {
+        MaxThreads = 31,
+        SpinCount = 64
+    };
+    
+    typedef ObjectArray<ChannelInternalCore*>   Channels;
+    typedef ObjectArray<const void*>            Resources;
+    
+    /** A set of sibling tasks to render. */
+    class Job
+    {
+    public:
+        virtual ~Job() { }
+        
+        virtual int getNumTasks() throw() = 0;
+        
+        /** Identifies a task, this is used to check whether a Plan is still valid. */
+        virtual const void* getTaskID (const int task) throw() = 0;
+        
+        /** Adds the channels processed by a task to the array. */
+        virtual void getTaskChannels (const int task, Channels& channels) throw() = 0;
+        
+        /** Renders the task. This may be called from any of the worker threads. */
+        virtual void processTask (ProcessInfo& info, const int task) throw() = 0;
+    };
+    
+    /** Caches the grouping of the tasks in a Job.
+     The job must outlive the plan. Its tasks are read on a TaskPool worker 
+     while the plan is being built so they may only be changed on the 
+     rendering thread, and only when canChangeTasks() returns @c true. */
+    class Plan
+    {
+    public:
+        Plan (Job& job) throw();
+        ~Plan();
+        
+        /** Call before changing the job's tasks on the rendering thread.
+         @return @c false if the plan is being built from the tasks, in which 
+         case they must be left until a later block. */
+        bool canChangeTasks() throw();
+        
+    private:
+        enum States
+        {
+            Idle,
+            Requested,
+            Building,
+            Ready
+        };
+        
+        struct Groups
+        {
+            Groups() throw();
+            PLONK_INLINE_LOW int getNumGroups() const throw() { return plonk::max (groupStarts.length() - 1, 0); }
+            
+            Resources taskIDs;
+            int planGeneration;
+            IntArray groupTasks;    // task indices grouped together in task order
+            IntArray groupStarts;   // index of each group's first task in groupTasks, plus the end
+        };
+        
+        /** Builds the spare Groups when woken. 
+         This is owned by the TaskPool and holds the state so a build can 
+         be cancelled by the plan's destructor. */
+        class Builder : public TaskPool::Task
+        {
+        public:
+            Builder (Plan& plan) throw();
+            double service() throw();
+            
+        private:
+            Plan& plan;
+            AtomicInt state;
+            
+            friend class Plan;
+            friend class ParallelRenderer;
+        };
+        
+        Job& job;
+        Groups groups[2];
+        int current;            // the groups used by render(), the builder fills the other
+        Builder* builder;
+        
+        bool isValid (Groups const& groupsToCheck) throw();
+        
+        friend class ParallelRenderer;
+        
+        Plan (Plan const&);
+        Plan& operator= (Plan const&);
+    };
+    
+    ParallelRenderer() throw();
+    ~ParallelRenderer();
+    
+    /** Get the renderer used by the mixers. */
+    static ParallelRenderer& global() throw();
+    
+    /** Set the number of worker threads.
+     Zero (the default) stops all the workers. Each worker is given audio
+     priority and pinned to its own core, leaving the first core for the
+     audio thread where the platform allows. Do not call this on the audio thread. */
+    void setNumThreads (const int numThreads) throw();
+    
+    /** Get the number of worker threads. */
+    PLONK_INLINE_LOW int getNumThreads() const throw() { return numThreads.getValue(); }
+    
+    /** Render the parallelisable tasks in a plan's job.
+     If any task sets the should delete flag this is also set in @p info.
+     @return @c true if the tasks were rendered or @c false if the caller
+     should simply render them serially. */
+    bool render (ProcessInfo& info, Plan& plan) throw();
+    
+    /** Forces every Plan to be rebuilt before it is next used.
+     This is called by BufferPlanner when it changes which channels share buffers. */
+    static void invalidatePlans() throw();
+    
+private:
+    class Worker : public Threading::Thread
+    {
+    public:
+        Worker (ParallelRenderer& renderer, const int participant) throw();
+        ResultCode run() throw();
+        void wake() throw();
+        
+    private:
+        ParallelRenderer& renderer;
+        const int participant;
+        Lock event;
+    };
+    
+    struct PLONK_ALIGN(64) Cursor
+    {
+        AtomicInt next;
+        int end;
+    };
+    
+    AtomicInt numThreads;
+    AtomicInt busy;
+    AtomicInt open;
+    AtomicInt generation;
+    AtomicInt active;
+    AtomicInt pending;
+    AtomicInt shouldDelete;
+    
+    Job* job;
+    const Plan::Groups* groups;
+    TimeStamp timeStamp;
+    int numParticipants;
+    
+    Worker* workers[MaxThreads];
+    Cursor cursors[MaxThreads + 1];
+    ProcessInfo infos[MaxThreads + 1];
+    
+    void renderGroups (const int participant) throw();
+    
+    static void buildGroups (Job& job, Plan::Groups& groups) throw();
+    static bool addChannel (ChannelInternalCore* channel, const int task, IntArray& parents, 
+                            Resources& resources, IntArray& resourceTasks) throw();
+    
+    static int findRoot (IntArray& parents, int task) throw();
+    static void merge (IntArray& parents, const int task1, const int task2) throw();
+    
+    ParallelRenderer (ParallelRenderer const&);
+    ParallelRenderer& operator= (ParallelRenderer const&);
+};
+
+
+
+#endif // PLONK_PARALLELRENDERER_H
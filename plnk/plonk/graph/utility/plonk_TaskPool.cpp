@@ -0,0 +1,256 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+ by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#include "../../core/plonk_StandardHeader.h"
+
+BEGIN_PLONK_NAMESPACE
+
+#include "../../core/plonk_Headers.h"
+
+TaskPool::Task::Task (const int priorityToUse) throw()
+:   pool (0),
+    deadline (0.0),
+    priority (priorityToUse),
+    running (false)
+{
+}
+
+void TaskPool::Task::wake() throw()
+{
+    woken.setValue (1);
+    
+    if (pool)
+        pool->event.signal();
+}
+
+void TaskPool::Task::end() throw()
+{
+    TaskPool* const owner = pool; // a worker may delete this as soon as it is marked as ended
+    ended.setValue (1);
+    
+    if (owner)
+        owner->event.signal();
+}
+
+//------------------------------------------------------------------------------
+
+TaskPool::Worker::Worker (TaskPool& owner) throw()
+:   Threading::Thread ("TaskPool::Worker"),
+    pool (owner)
+{
+}
+
+ResultCode TaskPool::Worker::run() throw()
+{
+    while (! getShouldExit())
+    {
+        double waitTime;
+        Task* const task = pool.acquire (waitTime);
+        
+        if (task)
+            pool.release (task, task->ended.getValue() ? -1.0 : task->service());
+        else
+            pool.event.wait (waitTime);
+    }
+    
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+
+TaskPool::TaskPool() throw()
+:   lock (Lock::MutexLock),
+    event (Lock::MutexLock),
+    threadsLock (Lock::MutexLock)
+{
+    for (int i = 0; i < MaxThreads; ++i)
+        workers[i] = 0;
+}
+
+TaskPool::~TaskPool()
+{
+    setNumThreads (0);
+    
+    for (int i = 0; i < tasks.length(); ++i)
+        delete tasks.atUnchecked (i);
+}
+
+TaskPool& TaskPool::global() throw()
+{
+    static TaskPool pool;
+    return pool;
+}
+
+void TaskPool::setNumThreads (const int newNumThreads) throw()
+{
+    AutoLock l (threadsLock);
+    resizeWorkers (newNumThreads);
+}
+
+void TaskPool::resizeWorkers (const int newNumThreads) throw()
+{
+    const int count = plonk::clip (newNumThreads, 0, (int)MaxThreads);
+    const int oldCount = numThreads.getValue();
+    int i;
+    
+    for (i = count; i < oldCount; ++i)
+        workers[i]->setShouldExit();
+    
+    for (i = count; i < oldCount; ++i)
+    {
+        while (workers[i]->isRunning())
+        {
+            event.signal();
+            Threading::sleep (0.000001);
+        }
+        
+        delete workers[i];
+        workers[i] = 0;
+    }
+    
+    for (i = oldCount; i < count; ++i)
+    {
+        workers[i] = new Worker (*this);
+        workers[i]->start();
+        
+        while (! workers[i]->isRunning())
+            Threading::yield();
+    }
+    
+    numThreads.setValue (count);
+}
+
+int TaskPool::getNumTasks() const throw()
+{
+    AutoLock l (lock);
+    return tasks.length();
+}
+
+void TaskPool::add (Task* task) throw()
+{
+    plonk_assert (task != 0);
+    plonk_assert (task->pool == 0);
+    
+    // checked again under the lock since another thread may be starting them
+    if (numThreads.getValue() == 0)
+    {
+        AutoLock l (threadsLock);
+        
+        if (numThreads.getValue() == 0)
+            resizeWorkers (DefaultNumThreads);
+    }
+    
+    task->pool = this;
+    task->woken.setValue (1);
+    
+    lock.lock();
+    tasks.add (task);
+    lock.unlock();
+    
+    event.signal();
+}
+
+TaskPool::Task* TaskPool::acquire (double& waitTime) throw()
+{
+    AutoLock l (lock);
+    
+    const double now = pl_TimeNow();
+    const int numTasks = tasks.length();
+    
+    Task* best = 0;
+    double bestDeadline = 0.0;
+    int numDue = 0;
+    
+    for (int i = 0; i < numTasks; ++i)
+    {
+        Task* const task = tasks.atUnchecked (i);
+        
+        if (task->running)
+            continue;
+        
+        const double deadline = (task->woken.getValue() || task->ended.getValue()) ? now : task->deadline;
+        
+        if (deadline <= now)
+            ++numDue;
+        
+        if ((best == 0) || 
+            (deadline < bestDeadline) || 
+            ((deadline == bestDeadline) && (task->priority > best->priority)))
+        {
+            best = task;
+            bestDeadline = deadline;
+        }
+    }
+    
+    if ((best == 0) || (bestDeadline > now))
+    {
+        // zero waits until signalled
+        waitTime = best ? bestDeadline - now : 0.0;
+        return 0;
+    }
+    
+    // a single signal only wakes one worker so pass it on if more are due
+    if (numDue > 1)
+        event.signal();
+    
+    best->woken.setValue (0);
+    best->running = true;
+    return best;
+}
+
+void TaskPool::release (Task* task, const double delay) throw()
+{
+    lock.lock();
+    
+    task->running = false;
+    
+    const bool finished = (delay < 0.0) || task->ended.getValue();
+    
+    if (finished)
+        tasks.removeItem (task);
+    else
+        task->deadline = pl_TimeNow() + delay;
+    
+    lock.unlock();
+    
+    if (finished)
+        delete task;
+}
+
+
+END_PLONK_NAMESPACE
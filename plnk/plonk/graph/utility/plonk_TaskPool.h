@@ -0,0 +1,157 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+ by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_TASKPOOL_H
+#define PLONK_TASKPOOL_H
+
+#include "../plonk_GraphForwardDeclarations.h"
+#include "../../core/plonk_Thread.h"
+#include "../../core/plonk_Lock.h"
+
+
+/** Services background tasks on a shared, fixed-size pool of worker threads.
+ Each call to Task::service() returns how long the task can wait before it 
+ needs servicing again, the workers always service the task with the earliest
+ deadline (ties go to the higher priority). A task can be serviced sooner by 
+ calling Task::wake(). Idle workers block on a condition until the next 
+ deadline or a wake rather than polling.
+ 
+ Tasks are owned by the pool once added and are deleted by the pool (on one 
+ of its workers) after Task::end() is called or service() returns a negative 
+ time. A task is never serviced by more than one worker at once.
+ 
+ The global pool starts DefaultNumThreads workers when the first task is added
+ if setNumThreads() has not been called. Tasks may be added and the number of 
+ threads set from any thread.
+ @see InputTaskUnit */
+class TaskPool
+{
+public:
+    enum Constants
+    {
+        MaxThreads = 32,
+        DefaultNumThreads = 2
+    };
+    
+    /** A task to be serviced by a TaskPool. */
+    class Task
+    {
+    public:
+        Task (const int priority = 50) throw();
+        virtual ~Task() { }
+        
+        /** Does the task's work.
+         @return The time in seconds before the task next needs to be serviced,
+         or a negative time if it has finished and should be deleted. */
+        virtual double service() throw() = 0;
+        
+        /** Requests the task is serviced as soon as possible. 
+         This may be called from any thread. */
+        void wake() throw();
+        
+        /** Requests the task is deleted, service() may not be called again.
+         This may be called from any thread but the task must not be accessed
+         afterwards. */
+        void end() throw();
+        
+        PLONK_INLINE_LOW int getPriority() const throw() { return priority; }
+        
+    private:
+        TaskPool* pool;
+        double deadline;
+        const int priority;
+        bool running;
+        AtomicInt woken;
+        AtomicInt ended;
+        
+        friend class TaskPool;
+        
+        Task (Task const&);
+        Task& operator= (Task const&);
+    };
+    
+    TaskPool() throw();
+    ~TaskPool();
+    
+    /** Get the pool used by the task units. */
+    static TaskPool& global() throw();
+    
+    /** Set the number of worker threads. 
+     This must be at least one if any tasks are added. */
+    void setNumThreads (const int numThreads) throw();
+    
+    /** Get the number of worker threads. */
+    PLONK_INLINE_LOW int getNumThreads() const throw() { return numThreads.getValue(); }
+    
+    /** Get the number of tasks in the pool. */
+    int getNumTasks() const throw();
+    
+    /** Add a task to the pool, it is serviced as soon as possible. */
+    void add (Task* task) throw();
+    
+private:
+    class Worker : public Threading::Thread
+    {
+    public:
+        Worker (TaskPool& pool) throw();
+        ResultCode run() throw();
+        
+    private:
+        TaskPool& pool;
+    };
+    
+    typedef ObjectArray<Task*> Tasks;
+    
+    Lock lock;          // protects the tasks and their scheduling state
+    Lock event;         // wakes idle workers
+    Lock threadsLock;   // serialises starting and stopping workers
+    Tasks tasks;
+    AtomicInt numThreads;
+    Worker* workers[MaxThreads];
+    
+    void resizeWorkers (const int newNumThreads) throw();
+    Task* acquire (double& waitTime) throw();
+    void release (Task* task, const double delay) throw();
+    
+    TaskPool (TaskPool const&);
+    TaskPool& operator= (TaskPool const&);
+};
+
+
+
+#endif // PLONK_TASKPOOL_H
@@ -0,0 +1,198 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+ by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLONK_OFFLINEAUDIOHOST_H
+#define PLONK_OFFLINEAUDIOHOST_H
+
+BEGIN_PLONK_NAMESPACE
+
+/** An audio host that renders the graph to a file as fast as possible.
+ Rather than being driven by an audio device, startHost() renders the graph
+ in a loop on the calling thread and returns when the render is complete. 
+ Output blocks are interleaved into one of two write buffers; when a buffer 
+ is full it is passed to a writer thread so the render can continue into the 
+ other buffer while the file is written. 
+ 
+ Set the output using setOutputPath() (a PCM file, the format is chosen from 
+ the file extension) or setFileWriter() and the length using setDuration().
+ Any audio inputs are fed silence. After the render the timing statistics
+ (e.g., getRealtimeFactor()) report how the render performed.
+ @see AudioHostBase */
+template<class SampleType>
+class OfflineAudioHostBase : public AudioHostBase<SampleType>
+{
+public:
+    typedef NumericalArray<SampleType*>            BufferArray;
+    typedef NumericalArray<const SampleType*>      ConstBufferArray;
+    typedef NumericalArray<SampleType>             BufferType;
+    typedef AudioFileWriter<SampleType>            FileWriterType;
+    
+    enum Constants
+    {
+        DefaultWriteBufferSize = 16384
+    };
+
+    /** Default constructor. */
+    OfflineAudioHostBase() throw();
+    ~OfflineAudioHostBase();
+    
+    Text getHostName() const throw();
+    Text getNativeHostName() const throw();
+    Text getInputName() const throw();
+    Text getOutputName() const throw();
+    
+    /** Get the mean block render time as a proportion of the block duration. */
+    double getCpuUsage() const throw();
+
+    /** Render the graph to the file.
+     This returns when the duration has been rendered, stopHost() is called
+     from another thread or writing to the file fails. */
+    void startHost() throw();
+    
+    /** Stop a render in progress. */
+    void stopHost() throw();
+    
+    /** Set the path of a PCM file to render to. 
+     The file is created (with getNumOutputs() channels) when the render 
+     starts and closed when it finishes. This must be called before 
+     startHost() to have any effect. */
+    void setOutputPath (FilePath const& path) throw();
+    
+    /** Set an already opened file writer to render to.
+     This could be used to write compressed formats. Its number of channels
+     must match getNumOutputs(), it is not closed after the render. This must 
+     be called before startHost() to have any effect. */
+    void setFileWriter (FileWriterType const& writer) throw();
+    
+    /** Get the file writer used by the most recent render. */
+    PLONK_INLINE_LOW FileWriterType getFileWriter() const throw() { return fileWriter; }
+
+    /** Set the duration to render in seconds.
+     If this is zero (the default) the render continues until stopHost() is 
+     called. This must be called before startHost() to have any effect. */
+    PLONK_INLINE_LOW void setDuration (const double seconds) throw() { duration = seconds; }
+    
+    /** Get the duration to render in seconds. */
+    PLONK_INLINE_LOW double getDuration() const throw() { return duration; }
+    
+    /** Set the size of each of the two write buffers in frames.
+     This is rounded up to a multiple of the host block size. This must be 
+     called before startHost() to have any effect. */
+    PLONK_INLINE_LOW void setWriteBufferSize (const int numFrames) throw() { writeBufferSize = numFrames; }
+    
+    /** Get the size of each of the two write buffers in frames. */
+    PLONK_INLINE_LOW int getWriteBufferSize() const throw() { return writeBufferSize; }
+
+    /** Get the number of frames rendered. */
+    PLONK_INLINE_LOW LongLong getNumFramesRendered() const throw() { return numFramesRendered; }
+    
+    /** Get the number of host blocks rendered. */
+    PLONK_INLINE_LOW LongLong getNumBlocksRendered() const throw() { return numBlocksRendered; }
+    
+    /** Get the wall-clock time the render took in seconds (including the file writes). */
+    PLONK_INLINE_LOW double getRenderTime() const throw() { return renderTime; }
+    
+    /** Get the duration of audio rendered divided by the time the render took. 
+     Values above 1 are faster than realtime. */
+    double getRealtimeFactor() const throw();
+    
+    /** Get the render throughput in frames per second. */
+    double getThroughput() const throw();
+    
+    /** Get the shortest time taken to process a host block in seconds. */
+    PLONK_INLINE_LOW double getMinBlockTime() const throw() { return minBlockTime; }
+    
+    /** Get the mean time taken to process a host block in seconds. */
+    double getMeanBlockTime() const throw();
+    
+    /** Get the longest time taken to process a host block in seconds. */
+    PLONK_INLINE_LOW double getMaxBlockTime() const throw() { return maxBlockTime; }
+    
+    /** Determine whether the most recent render failed to write to the file. */
+    PLONK_INLINE_LOW bool getWriteFailed() const throw() { return writeFailed.getValue() != 0; }
+    
+private:
+    class Writer : public Threading::Thread
+    {
+    public:
+        Writer (OfflineAudioHostBase& owner) throw();
+        ResultCode run() throw();
+        
+    private:
+        OfflineAudioHostBase& host;
+    };
+    
+    FilePath outputPath;
+    FileWriterType fileWriter;
+    double duration;
+    int writeBufferSize;
+    
+    BufferType writeBuffers[2];
+    AtomicInt writeBufferFrames[2]; // zero when free, otherwise the number of frames waiting to be written
+    Lock writeEvent;
+    Lock renderEvent;
+    AtomicInt writeFailed;
+    AtomicInt shouldStop;
+    
+    LongLong numFramesRendered;
+    LongLong numBlocksRendered;
+    double renderTime;
+    double totalBlockTime;
+    double minBlockTime;
+    double maxBlockTime;
+    
+    bool openFileWriter() throw();
+    void resetStatistics() throw();
+    void queueWriteBuffer (const int index, const int numFrames) throw();
+    void waitForWriteBuffer (const int index) throw();
+};
+
+class OfflineAudioHost : public OfflineAudioHostBase<float>
+{
+public:
+    OfflineAudioHost() throw();
+    ~OfflineAudioHost();
+};
+
+#define PLANK_INLINING_FUNCTIONS 1
+#include "plonk_OfflineAudioHostInline.h"
+#undef PLANK_INLINING_FUNCTIONS
+
+END_PLONK_NAMESPACE
+
+#endif  // PLONK_OFFLINEAUDIOHOST_H
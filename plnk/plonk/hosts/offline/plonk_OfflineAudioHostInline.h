@@ -0,0 +1,329 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+ by Martin Robinson
+ 
+ http://code.google.com/p/pl-nk/
+ 
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+ 
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+ 
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor 
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE 
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR 
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE 
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) 
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT 
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT 
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ 
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#if PLANK_INLINING_FUNCTIONS
+
+template<class SampleType>
+OfflineAudioHostBase<SampleType>::Writer::Writer (OfflineAudioHostBase& owner) throw()
+:   Threading::Thread ("OfflineAudioHost::Writer"),
+    host (owner)
+{
+}
+
+template<class SampleType>
+ResultCode OfflineAudioHostBase<SampleType>::Writer::run() throw()
+{
+    int index = 0;
+    
+    // buffers are always queued alternately, drain any that are full before exiting
+    while (true)
+    {
+        const int numFrames = host.writeBufferFrames[index].getValue();
+        
+        if (numFrames > 0)
+        {
+            if (! host.fileWriter.writeFrames (numFrames, host.writeBuffers[index].getArray()))
+                host.writeFailed = true;
+            
+            host.writeBufferFrames[index] = 0;
+            host.renderEvent.signal();
+            index ^= 1;
+        }
+        else if (getShouldExit())
+        {
+            break;
+        }
+        else
+        {
+            host.writeEvent.wait();
+        }
+    }
+    
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+
+template<class SampleType>
+OfflineAudioHostBase<SampleType>::OfflineAudioHostBase() throw()
+:   duration (0.0),
+    writeBufferSize (DefaultWriteBufferSize),
+    writeEvent (Lock::MutexLock),
+    renderEvent (Lock::MutexLock)
+{
+    this->setPreferredHostBlockSize (512);
+    this->setPreferredGraphBlockSize (128);
+    this->setPreferredHostSampleRate (44100.0);
+    this->setNumInputs (0);
+    this->setNumOutputs (2);
+    
+    resetStatistics();
+}
+
+template<class SampleType>
+OfflineAudioHostBase<SampleType>::~OfflineAudioHostBase()
+{
+}
+
+template<class SampleType>
+Text OfflineAudioHostBase<SampleType>::getHostName() const throw()
+{
+    return "Offline (" + TypeUtility<SampleType>::getTypeName() + ")";
+}
+
+template<class SampleType>
+Text OfflineAudioHostBase<SampleType>::getNativeHostName() const throw()
+{
+    return "AudioFileWriter";
+}
+
+template<class SampleType>
+Text OfflineAudioHostBase<SampleType>::getInputName() const throw()
+{
+    return "Silence";
+}
+
+template<class SampleType>
+Text OfflineAudioHostBase<SampleType>::getOutputName() const throw()
+{
+    return outputPath.fullpath();
+}
+
+template<class SampleType>
+double OfflineAudioHostBase<SampleType>::getCpuUsage() const throw()
+{
+    const double blockDuration = this->getPreferredHostBlockSize() / this->getPreferredHostSampleRate();
+    return blockDuration > 0.0 ? getMeanBlockTime() / blockDuration : 0.0;
+}
+
+template<class SampleType>
+void OfflineAudioHostBase<SampleType>::setOutputPath (FilePath const& path) throw()
+{
+    outputPath = path;
+    fileWriter = FileWriterType();
+}
+
+template<class SampleType>
+void OfflineAudioHostBase<SampleType>::setFileWriter (FileWriterType const& writer) throw()
+{
+    outputPath = FilePath();
+    fileWriter = writer;
+}
+
+template<class SampleType>
+double OfflineAudioHostBase<SampleType>::getRealtimeFactor() const throw()
+{
+    return renderTime > 0.0 ? (numFramesRendered / this->getPreferredHostSampleRate()) / renderTime : 0.0;
+}
+
+template<class SampleType>
+double OfflineAudioHostBase<SampleType>::getThroughput() const throw()
+{
+    return renderTime > 0.0 ? numFramesRendered / renderTime : 0.0;
+}
+
+template<class SampleType>
+double OfflineAudioHostBase<SampleType>::getMeanBlockTime() const throw()
+{
+    return numBlocksRendered > 0 ? totalBlockTime / numBlocksRendered : 0.0;
+}
+
+template<class SampleType>
+void OfflineAudioHostBase<SampleType>::stopHost() throw()
+{
+    shouldStop = true;
+}
+
+template<class SampleType>
+bool OfflineAudioHostBase<SampleType>::openFileWriter() throw()
+{
+    const int numOutputs = this->getNumOutputs();
+    
+    if (outputPath.fullpath().length() > 0)
+    {
+        const ChannelLayout layout = numOutputs == 1 ? PLANKAUDIOFILE_LAYOUT_MONO :
+                                     numOutputs == 2 ? PLANKAUDIOFILE_LAYOUT_STEREO :
+                                                       PLANKAUDIOFILE_LAYOUT_DISCRETE | numOutputs;
+        
+        fileWriter = FileWriterType (outputPath, layout, this->getPreferredHostSampleRate(), writeBufferSize);
+    }
+    
+    return fileWriter.isNotNull() && 
+           fileWriter.isReady() &&
+           (fileWriter.getNumChannels() == numOutputs);
+}
+
+template<class SampleType>
+void OfflineAudioHostBase<SampleType>::resetStatistics() throw()
+{
+    numFramesRendered = 0;
+    numBlocksRendered = 0;
+    renderTime = 0.0;
+    totalBlockTime = 0.0;
+    minBlockTime = 0.0;
+    maxBlockTime = 0.0;
+}
+
+template<class SampleType>
+void OfflineAudioHostBase<SampleType>::queueWriteBuffer (const int index, const int numFrames) throw()
+{
+    writeBufferFrames[index] = numFrames;
+    writeEvent.signal();
+}
+
+template<class SampleType>
+void OfflineAudioHostBase<SampleType>::waitForWriteBuffer (const int index) throw()
+{
+    while (writeBufferFrames[index].getValue() != 0)
+        renderEvent.wait();
+}
+
+template<class SampleType>
+void OfflineAudioHostBase<SampleType>::startHost() throw()
+{
+    int i;
+    
+    if (this->getNumOutputs() < 1 || ! openFileWriter())
+    {
+        plonk_assertfalse;
+        return;
+    }
+    
+    shouldStop = false;
+    writeFailed = false;
+    resetStatistics();
+    
+    this->startHostInternal();
+    
+    const int numInputs = this->getNumInputs();
+    const int numOutputs = this->getNumOutputs();
+    const int hostBlockSize = this->getPreferredHostBlockSize();
+    const int writeBlockSize = ((plonk::max (writeBufferSize, 1) + hostBlockSize - 1) / hostBlockSize) * hostBlockSize;
+    const LongLong numFramesToRender = duration > 0.0 ? LongLong (duration * this->getPreferredHostSampleRate() + 0.5) : 0;
+
+    BufferType silence = BufferType::newClear (hostBlockSize);
+    BufferType outputBuffer = BufferType::withSize (hostBlockSize * numOutputs);
+    
+    for (i = 0; i < 2; ++i)
+    {
+        writeBuffers[i] = BufferType::withSize (writeBlockSize * numOutputs);
+        writeBufferFrames[i] = 0;
+    }
+    
+    Writer writer (*this);
+    writer.start();
+    
+    while (! writer.isRunning())
+        Threading::sleep (0.000001);
+    
+    int writeIndex = 0;
+    int writePosition = 0;
+    const double renderStart = pl_TimeNow();
+    
+    while (! shouldStop.getValue() && ! writeFailed.getValue() &&
+           ((numFramesToRender == 0) || (numFramesRendered < numFramesToRender)))
+    {
+        // process() advances (and in debug builds nulls) the buffer pointers so these must be reset each block
+        for (i = 0; i < numInputs; ++i)
+            this->getInputs().atUnchecked (i) = silence.getArray();
+        
+        for (i = 0; i < numOutputs; ++i)
+            this->getOutputs().atUnchecked (i) = outputBuffer.getArray() + i * hostBlockSize;
+        
+        const double blockStart = pl_TimeNow();
+        this->process();
+        const double blockTime = pl_TimeNow() - blockStart;
+        
+        totalBlockTime += blockTime;
+        minBlockTime = numBlocksRendered == 0 ? blockTime : plonk::min (minBlockTime, blockTime);
+        maxBlockTime = plonk::max (maxBlockTime, blockTime);
+        ++numBlocksRendered;
+        
+        const int numFrames = numFramesToRender == 0 ? hostBlockSize : int (plonk::min (LongLong (hostBlockSize), numFramesToRender - numFramesRendered));
+        
+        const SampleType* const outputSamples = outputBuffer.getArray();
+        SampleType* const writeSamples = writeBuffers[writeIndex].getArray() + writePosition * numOutputs;
+        
+        for (i = 0; i < numOutputs; ++i)
+        {
+            const SampleType* src = outputSamples + i * hostBlockSize;
+            SampleType* dst = writeSamples + i;
+            
+            for (int j = 0; j < numFrames; ++j, dst += numOutputs)
+                *dst = src[j];
+        }
+        
+        writePosition += numFrames;
+        numFramesRendered += numFrames;
+        
+        if (writePosition == writeBlockSize)
+        {
+            queueWriteBuffer (writeIndex, writePosition);
+            writeIndex ^= 1;
+            writePosition = 0;
+            waitForWriteBuffer (writeIndex);
+        }
+    }
+    
+    if (writePosition > 0)
+        queueWriteBuffer (writeIndex, writePosition);
+    
+    writer.setShouldExit();
+    writeEvent.signal();
+    
+    while (writer.isRunning())
+        Threading::sleep (0.000001);
+    
+    renderTime = pl_TimeNow() - renderStart;
+    
+    // this thread was only the audio thread for the duration of the render
+    if (Threading::currentThreadIsAudioThread())
+        Threading::setAudioThreadID (0);
+    
+    if (outputPath.fullpath().length() > 0)
+        fileWriter.close();
+
+    for (i = 0; i < 2; ++i)
+        writeBuffers[i] = BufferType();
+
+    this->setIsRunning (false);
+    this->hostStopped();
+}
+
+#endif // PLANK_INLINING_FUNCTIONS
+
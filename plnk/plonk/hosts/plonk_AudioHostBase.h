@@ -63,6 +63,7 @@ public:
     :   preferredHostSampleRate (0.0),
         preferredHostBlockSize (0),
         preferredGraphBlockSize (0),
+        numRenderThreads (-1),
         isRunning (false),
         isPaused (false)
     { 
@@ -109,6 +110,19 @@ public:
      This must be called before startHost() to have any effect. */
     PLONK_INLINE_LOW void setPreferredGraphBlockSize (const int newSize) throw() {  preferredGraphBlockSize = newSize; }
     
+    /** Get the number of extra threads used to render the graph.
+     This is -1 if setNumRenderThreads() has not been called. */
+    PLONK_INLINE_LOW int getNumRenderThreads() const throw() { return numRenderThreads; }
+    
+    /** Set the number of extra threads used to render the graph.
+     Mixers will then render their independent inputs in parallel using 
+     the ParallelRenderer. Zero renders everything on the audio thread. If
+     this is not called the ParallelRenderer is left as it is, so threads set
+     up with ParallelRenderer::setNumThreads() are kept. This must be called
+     before startHost() to have any effect. 
+     @see ParallelRenderer */
+    PLONK_INLINE_LOW void setNumRenderThreads (const int numThreads) throw() {  numRenderThreads = numThreads; }
+    
     /** Set the number of audio inputs required.
      This must be called before startHost() to have any effect. */
     void setNumInputs (const int numInputs) throw();
@@ -234,6 +248,10 @@ protected:
     void startHostInternal() throw()
     {
         initFormat();
+
+        if (numRenderThreads >= 0)
+            ParallelRenderer::global().setNumThreads (numRenderThreads);
+        
         outputUnit = constructGraph();
         hostStarting();
         
@@ -259,6 +277,7 @@ private:
     double preferredHostSampleRate;
     int preferredHostBlockSize;
     int preferredGraphBlockSize;
+    int numRenderThreads;
 	AtomicInt isRunning;
     AtomicInt isPaused;
     OptionDictionary otherOptions;
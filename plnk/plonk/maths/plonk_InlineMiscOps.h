@@ -237,6 +237,31 @@ public:
     };
 };
 
+/** Quality presets for windowed-sinc resampling.
+ Each preset doubles the taps (and roughly the CPU cost) of the one before.
+ The figures are the worst image/alias level for content at up to 0.4 of the 
+ sample rate (e.g., 17.6kHz at 44.1kHz). 
+ @see SincTableBase */
+class SincQuality
+{
+public:
+    enum Preset
+    {
+        Low,        ///< 8 taps, -44dB.
+        Medium,     ///< 16 taps, -64dB.
+        High,       ///< 32 taps, -88dB.
+        Best,       ///< 64 taps, -111dB.
+        NumPresets
+    };
+    
+    enum Constants
+    {
+        /** The largest downsampling ratio a SincResampleUnit band limits for.
+         Faster rates still play but alias above this. */
+        MaxDecimation = 4
+    };
+};
+
 template<class ValueType, class IndexType, Interp::TypeCode TypeCode>
 class InterpSelect
 {
@@ -72,6 +72,8 @@ public:
         ResultCode result = pl_NeuralNetworkF_InitWithLayersAndRange (&network, layers.getArray(), layers.length(), range);
         plonk_assert (result == PlankResult_OK);
         
+        Memory::zero (batch);
+        
         networkOutputs.referTo (pl_NeuralNetworkF_GetNumOutputs (&network),
                                 const_cast<float*> (pl_NeuralNetworkF_GetOutputsPtr (&network)));
          
@@ -85,6 +87,8 @@ public:
         ResultCode result = pl_NeuralNetworkF_InitFromJSON (&network, json);
         plonk_assert (result == PlankResult_OK);
         
+        Memory::zero (batch);
+        
         networkOutputs.referTo (pl_NeuralNetworkF_GetNumOutputs (&network),
                                 const_cast<float*> (pl_NeuralNetworkF_GetOutputsPtr (&network)));
         
@@ -95,6 +99,7 @@ public:
     
     ~NeuralNetworkInternal()
     {
+        pl_NeuralBatchF_DeInit (&batch);
         ResultCode result = pl_NeuralNetworkF_DeInit (&network);
         plonk_assert (result == PlankResult_OK);
 
@@ -178,6 +183,99 @@ private:
 #endif
     }
     
+    void propogate (float* outputs, const float* inputs, const int numPatterns) throw()
+    {
+        const int numOutputs = this->getNumOutputs();
+        
+        this->prepareBatch (numPatterns);
+        ResultCode result = pl_NeuralBatchF_Propogate (&batch, inputs, numPatterns);
+        plonk_assert (result == PlankResult_OK);
+        
+        VectorType::copyData (outputs, pl_NeuralBatchF_GetOutputsPtr (&batch), numOutputs * numPatterns);
+        
+#ifndef PLONK_DEBUG
+        (void)result;
+#endif
+    }
+    
+    void backProp (const float* inputs, const float* targets, const int numPatterns) throw()
+    {
+        this->prepareBatch (numPatterns);
+        ResultCode result = pl_NeuralNetworkF_BackPropBatch (&network, &batch, inputs, targets, numPatterns);
+        plonk_assert (result == PlankResult_OK);
+        
+#ifndef PLONK_DEBUG
+        (void)result;
+#endif
+    }
+    
+    /** Trains with mini-batches of the patterns, each split across the threads.
+     The calling thread takes the first slice of each mini-batch and the 
+     workers (which are only kept for the duration of this call) the others, 
+     the network is updated once all the slices' gradients are ready. */
+    void train (const float* inputs, const float* targets, const int numPatterns, 
+                const int numEpochs, const int batchSize, const int numThreads) throw()
+    {
+        if (numPatterns < 1)
+            return;
+        
+        const int numInputs = this->getNumInputs();
+        const int numOutputs = this->getNumOutputs();
+        const int batchSizeChecked = plonk::clip (batchSize, 1, numPatterns);
+        const int numSlices = plonk::clip (numThreads, 1, batchSizeChecked);
+        const int sliceSize = (batchSizeChecked + numSlices - 1) / numSlices;
+        
+        ObjectArray<BatchWorker*> workers;
+        int i;
+        
+        this->prepareBatch (sliceSize);
+        numWorkersDone.setValue (0);
+        
+        for (i = 1; i < numSlices; ++i)
+        {
+            BatchWorker* worker = new BatchWorker (*this, sliceSize);
+            worker->start();
+            workers.add (worker);
+        }
+        
+        for (int epoch = 0; epoch < numEpochs; ++epoch)
+        {
+            for (int start = 0; start < numPatterns; start += batchSizeChecked)
+            {
+                const int count = plonk::min (batchSizeChecked, numPatterns - start);
+                const int firstCount = plonk::min (sliceSize, count);
+                int numDispatched = 0;
+                
+                numWorkersDone.setValue (0);
+                
+                for (int slice = firstCount; slice < count; slice += sliceSize, ++numDispatched)
+                {
+                    const int offset = start + slice;
+                    workers[numDispatched]->dispatch (inputs + offset * numInputs, 
+                                                      targets + offset * numOutputs,
+                                                      plonk::min (sliceSize, count - slice));
+                }
+                
+                pl_NeuralBatchF_Gradient (&batch, inputs + start * numInputs, targets + start * numOutputs, firstCount);
+                
+                while (numWorkersDone.getValue() < numDispatched)
+                    workersDone.wait();
+                
+                // the gradients are all from the same weights so can be applied in turn
+                pl_NeuralNetworkF_ApplyBatch (&network, &batch, count);
+                
+                for (i = 0; i < numDispatched; ++i)
+                    pl_NeuralNetworkF_ApplyBatch (&network, &workers[i]->batch, count);
+            }
+        }
+        
+        for (i = 0; i < workers.length(); ++i)
+        {
+            workers[i]->stop();
+            delete workers[i];
+        }
+    }
+    
     PLONK_INLINE_LOW void setActFunc (ActFunc const& function) throw()
     {
         ResultCode result = pl_NeuralNetworkF_SetActFunc (&network, function);
@@ -198,10 +296,99 @@ private:
 #endif
     }
     
+    class BatchWorker : public Threading::Thread
+    {
+    public:
+        BatchWorker (NeuralNetworkInternal& owner, const int maxPatterns) throw()
+        :   Threading::Thread ("NeuralNetwork::BatchWorker"),
+            owner (owner),
+            inputs (0),
+            targets (0),
+            numPatterns (0),
+            event (Lock::MutexLock)
+        {
+            ResultCode result = pl_NeuralBatchF_Init (&batch, &owner.network, maxPatterns);
+            plonk_assert (result == PlankResult_OK);
+            
+#ifndef PLONK_DEBUG
+            (void)result;
+#endif
+        }
+        
+        ~BatchWorker()
+        {
+            pl_NeuralBatchF_DeInit (&batch);
+        }
+        
+        ResultCode run() throw()
+        {
+            for (;;)
+            {
+                event.wait();
+                
+                if (getShouldExit())
+                    break;
+                
+                pl_NeuralBatchF_Gradient (&batch, inputs, targets, numPatterns);
+                
+                ++owner.numWorkersDone;
+                owner.workersDone.signal();
+            }
+            
+            return 0;
+        }
+        
+        void dispatch (const float* inputsToUse, const float* targetsToUse, const int count) throw()
+        {
+            inputs = inputsToUse;
+            targets = targetsToUse;
+            numPatterns = count;
+            event.signal();
+        }
+        
+        void stop() throw()
+        {
+            setShouldExit();
+            event.signal();
+            
+            while (isRunning())
+                Threading::sleep (0.000001);
+        }
+        
+        PlankNeuralBatchF batch;
+        
+    private:
+        NeuralNetworkInternal& owner;
+        const float* inputs;
+        const float* targets;
+        int numPatterns;
+        Lock event;
+        
+        BatchWorker (BatchWorker const&);
+        BatchWorker& operator= (BatchWorker const&);
+    };
+    
+    void prepareBatch (const int numPatterns) throw()
+    {
+        if (batch.maxPatterns < numPatterns)
+        {
+            pl_NeuralBatchF_DeInit (&batch);
+            ResultCode result = pl_NeuralBatchF_Init (&batch, &network, numPatterns);
+            plonk_assert (result == PlankResult_OK);
+            
+#ifndef PLONK_DEBUG
+            (void)result;
+#endif
+        }
+    }
+    
     friend class NeuralNetworkBase<float>;
     
     PlankNeuralNetworkF network;
     VectorType networkOutputs;
+    PlankNeuralBatchF batch;
+    AtomicInt numWorkersDone;
+    Lock workersDone;
 };
 
 
@@ -359,6 +546,57 @@ public:
         }
     }
     
+    /** Propogates a batch of input vectors.
+     @param outputs Receives numPatterns output vectors one after the other.
+     @param inputs numPatterns input vectors one after the other. */
+    void propogate (VectorType& outputs, VectorType const& inputs, const int numPatterns) throw()
+    {
+        plonk_assert (numPatterns > 0);
+        plonk_assert (inputs.length() == numPatterns * this->getNumInputs());
+        
+        outputs.setSize (numPatterns * this->getNumOutputs(), false);
+        this->getInternal()->propogate (outputs.getArray(), inputs.getArray(), numPatterns);
+    }
+    
+    /** Trains the network with a mini-batch.
+     The weights are moved once by the mean gradient of the patterns.
+     @param inputs numPatterns input vectors one after the other.
+     @param targets numPatterns target vectors one after the other. */
+    void backProp (VectorType const& inputs, VectorType const& targets, const int numPatterns) throw()
+    {
+        plonk_assert (numPatterns > 0);
+        plonk_assert (inputs.length() == numPatterns * this->getNumInputs());
+        plonk_assert (targets.length() == numPatterns * this->getNumOutputs());
+        
+        this->getInternal()->backProp (inputs.getArray(), targets.getArray(), numPatterns);
+    }
+    
+    /** Trains the network with mini-batches of the patterns.
+     Each mini-batch of @e batchSize patterns updates the weights once with 
+     the mean gradient, the patterns in a mini-batch are shared between 
+     @e numThreads threads (including the calling thread). */
+    void train (Patterns const& patterns, const int numEpochs, const int batchSize, const int numThreads = 1) throw()
+    {
+        const int numPatterns = patterns.length();
+        const Pattern* patternArray = patterns.getArray();
+        const int numInputs = this->getNumInputs();
+        const int numOutputs = this->getNumOutputs();
+        
+        VectorType inputs = VectorType::withSize (numPatterns * numInputs);
+        VectorType targets = VectorType::withSize (numPatterns * numOutputs);
+        
+        for (int j = 0; j < numPatterns; ++j)
+        {
+            plonk_assert (patternArray[j].i.length() == numInputs);
+            plonk_assert (patternArray[j].t.length() == numOutputs);
+            
+            VectorType::copyData (inputs.getArray() + j * numInputs, patternArray[j].i.getArray(), numInputs);
+            VectorType::copyData (targets.getArray() + j * numOutputs, patternArray[j].t.getArray(), numOutputs);
+        }
+        
+        this->getInternal()->train (inputs.getArray(), targets.getArray(), numPatterns, numEpochs, batchSize, numThreads);
+    }
+    
     void reset (const ValueType amount = 0.1f) throw()
     {
         pl_NeuralNetworkF_Reset (&this->getInternal()->network, amount);
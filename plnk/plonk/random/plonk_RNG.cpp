@@ -46,10 +46,12 @@ BEGIN_PLONK_NAMESPACE
 RNGInternal::RNGInternal() throw()
 {
     pl_RNG_Init (&rng);
+    pl_RNGStream_Init (&stream);
 }
 
 RNGInternal::~RNGInternal()
 {
+    pl_RNGStream_DeInit (&stream);
     pl_RNG_DeInit (&rng);
 }
 
@@ -88,6 +90,7 @@ RNG& RNG::audio() throw()
 void RNG::seed (const unsigned int value) throw()
 {
     pl_RNG_Seed (this->getInternal()->getRNGRef(), value);
+    pl_RNGStream_Seed (this->getInternal()->getStreamRef(), value);
 }
 
 unsigned int RNG::uniformInt() throw()
@@ -169,6 +172,40 @@ double RNG::exponential (const double min, const double max) throw()
                           min, max);
 }
 
+void RNG::fillUniform (float* const dst, const UnsignedLong size, const float min, const float max) throw()
+{
+    pl_RNGStream_FillUniformF (this->getInternal()->getStreamRef(), dst, size, min, max);
+}
+
+void RNG::fillUniform (double* const dst, const UnsignedLong size, const double min, const double max) throw()
+{
+    pl_RNGStream_FillUniformD (this->getInternal()->getStreamRef(), dst, size, min, max);
+}
+
+void RNG::fillExponential (float* const dst, const UnsignedLong size, const float min, const float max) throw()
+{
+    pl_RNGStream_FillExponentialF (this->getInternal()->getStreamRef(), dst, size, min, max);
+}
+
+void RNG::fillExponential (double* const dst, const UnsignedLong size, const double min, const double max) throw()
+{
+    pl_RNGStream_FillExponentialD (this->getInternal()->getStreamRef(), dst, size, min, max);
+}
+
+void RNG::fillGaussian (float* const dst, const UnsignedLong size, const float mean, const float deviation) throw()
+{
+    pl_RNGStream_FillGaussianF (this->getInternal()->getStreamRef(), dst, size, mean, deviation);
+}
+
+void RNG::fillGaussian (double* const dst, const UnsignedLong size, const double mean, const double deviation) throw()
+{
+    pl_RNGStream_FillGaussianD (this->getInternal()->getStreamRef(), dst, size, mean, deviation);
+}
+
+void RNG::split (PlankRNGStream& child, const UnsignedLong index) throw()
+{
+    pl_RNGStream_Split (this->getInternal()->getStreamRef(), &child, index);
+}
 
 
 END_PLONK_NAMESPACE
@@ -56,8 +56,10 @@ public:
     
 private:
     PLONK_INLINE_HIGH PlankRNGRef getRNGRef() { return &rng; }
+    PLONK_INLINE_HIGH PlankRNGStreamRef getStreamRef() { return &stream; }
 
     PlankRNG rng;
+    PlankRNGStream stream;
 };
 
 /** Random number generator. 
@@ -79,7 +81,8 @@ public:
      NB This will be no longer sufficient when multicore. */
     static RNG& audio() throw();
     
-    /** Seed this random number generator. */
+    /** Seed this random number generator. 
+     This seeds both the single value generator and the stream used to fill arrays. */
     void seed (const unsigned int value) throw();
     
     /** Generate a random integer. */
@@ -121,6 +124,28 @@ public:
     /** Generate a exponentially distributed random double between min and max. */
     double exponential (const double min, const double max) throw();     
     
+    /** Fill an array with uniformly distributed random floats between min and max. */
+    void fillUniform (float* const dst, const UnsignedLong size, const float min, const float max) throw();
+    
+    /** Fill an array with uniformly distributed random doubles between min and max. */
+    void fillUniform (double* const dst, const UnsignedLong size, const double min, const double max) throw();
+    
+    /** Fill an array with exponentially distributed random floats between min and max. */
+    void fillExponential (float* const dst, const UnsignedLong size, const float min, const float max) throw();
+    
+    /** Fill an array with exponentially distributed random doubles between min and max. */
+    void fillExponential (double* const dst, const UnsignedLong size, const double min, const double max) throw();
+    
+    /** Fill an array with normally distributed random floats. */
+    void fillGaussian (float* const dst, const UnsignedLong size, const float mean, const float deviation) throw();
+    
+    /** Fill an array with normally distributed random doubles. */
+    void fillGaussian (double* const dst, const UnsignedLong size, const double mean, const double deviation) throw();
+    
+    /** Initialise a stream as the independent child of this generator with a given index.
+     This is useful for giving each channel of a unit its own stream. */
+    void split (PlankRNGStream& child, const UnsignedLong index) throw();
+    
     PLONK_OBJECTARROWOPERATOR(RNG);
 };
 
@@ -0,0 +1,97 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+
+ http://code.google.com/p/pl-nk/
+
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+#ifndef PLNK_TEST_H
+#define PLNK_TEST_H
+
+/** Checks shared by the regression tests in this folder.
+ Each test is a standalone program that links against the library built from
+ the sources listed in plnk/juce_module_info and returns non-zero if any check
+ fails. E.g., from this folder on Linux:
+ @code
+ g++ -std=c++11 -mcx16 -I../plnk plonk_RingBufferTest.cpp libplnk.a -lpthread -ldl -o plonk_RingBufferTest
+ @endcode
+ Checks stay active in release builds, unlike plonk_assert. */
+
+#include "plonk/plonk.h"
+#include <stdio.h>
+
+using namespace plonk;
+
+static int plnk_TestNumFailures = 0;
+
+#define plnk_check(condition)\
+    do {\
+        if (!(condition)) {\
+            ++plnk_TestNumFailures;\
+            printf ("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition);\
+        }\
+    } while (0)
+
+static inline int plnk_TestResult (const char* name)
+{
+    printf ("%s %s\n", name, (plnk_TestNumFailures == 0) ? "passed" : "FAILED");
+    return (plnk_TestNumFailures == 0) ? 0 : 1;
+}
+
+/** A thread that runs a test function once.
+ Plank resets a thread when its function returns so Thread::wait() can't join
+ it, waitUntilFinished() waits until the thread is no longer using this object. */
+class plnk_TestThread : public Threading::Thread
+{
+public:
+    ResultCode run()
+    {
+        test();
+        finished.setValue (1);
+        return 0;
+    }
+
+    void waitUntilFinished() throw()
+    {
+        while (!finished.getValue() || isRunning())
+            Threading::sleep (0.001);
+    }
+
+    virtual void test() = 0;
+
+private:
+    AtomicInt finished;
+};
+
+#endif // PLNK_TEST_H
@@ -0,0 +1,162 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+
+ http://code.google.com/p/pl-nk/
+
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+// Regression test for BufferPlanner: a planned graph must sound identical to
+// the same graph with private buffers, so no planned buffer may be shared by
+// outputs that are live at the same time.
+
+#include "plnk_Test.h"
+
+static const int blockSize = 512;
+
+static Unit voice (const int i)
+{
+    Unit a = Sine::ar (100.f + i, 0.5f);
+    Unit b = Saw::ar (50.f + i * 0.5f, 0.25f);
+    Unit c = (a * b + Sine::ar (3.f + i * 0.01f)) * 0.1f;
+    Unit d = LPF::ar (c, 1000.f + i);
+    Unit e = (d + a * 0.01f).tanh();
+    return e * (0.5f + 0.001f * i);
+}
+
+static Unit buildVoices()
+{
+    Units voices;
+
+    for (int i = 0; i < 16; ++i)
+        voices.add (voice (i));
+
+    return Mixer::ar (voices);
+}
+
+static Unit buildChains()
+{
+    Units chains;
+
+    for (int i = 0; i < 8; ++i)
+    {
+        Unit chain = Saw::ar (50.f + i);
+
+        for (int j = 0; j < 20; ++j)
+            chain = chain * 0.999f + 0.0001f;
+
+        chains.add (chain);
+    }
+
+    return Mixer::ar (chains);
+}
+
+// a mixer's buffer must not be reused by anything its inputs still need
+static Unit buildNestedMixes()
+{
+    Units voices;
+
+    for (int i = 0; i < 4; ++i)
+        voices.add ((Sine::ar (200.f + i * 50) * Sine::ar (3.f + i)).tanh());
+
+    return Unit (Mixer::ar (voices)).mix() * Sine::ar (2) + Sine::ar (7);
+}
+
+// branches processed in the background must keep their own buffers (a unit
+// can't be shared with the rest of the graph as it would be processed on two threads)
+static Unit buildTasks()
+{
+    Units voices;
+
+    for (int i = 0; i < 8; ++i)
+    {
+        Unit background = Sine::ar (100.f + i) * 0.5f;
+        Unit direct = Sine::ar (100.f + i) * 0.5f;
+        voices.add (InputTask::ar ((background * 0.3f).tanh(), 4) + direct * 0.1f);
+    }
+
+    return Mixer::ar (voices);
+}
+
+static void testGraph (Unit (*build)(), const bool hasTasks)
+{
+    Unit reference = build();
+    Unit planned = build();
+
+    BufferPlanner planner;
+    plnk_check (planner.plan (planned));
+    plnk_check (planner.getNumPlannedChannels() > 0);
+
+    if (!hasTasks)
+        plnk_check (planner.getNumBuffers() < planner.getNumPlannedChannels());
+
+    ProcessInfo referenceInfo, plannedInfo;
+    const double blockDuration = SampleRate::getDefault().getSampleDurationInTicks() * blockSize;
+    float maxDifference = 0.f;
+
+    for (int b = 0; b < 100; ++b)
+    {
+        if (b == 50)
+            planner.clear();
+
+        reference.process (referenceInfo);
+        planned.process (plannedInfo);
+
+        const float* referenceSamples = reference.getOutputSamples (0);
+        const float* plannedSamples = planned.getOutputSamples (0);
+
+        for (int i = 0; i < blockSize; ++i)
+            maxDifference = plonk::max (maxDifference, plonk::abs (referenceSamples[i] - plannedSamples[i]));
+
+        referenceInfo.offsetTimeStamp (blockDuration);
+        plannedInfo.offsetTimeStamp (blockDuration);
+
+        if (hasTasks)
+            Threading::sleep (0.002); // so both graphs' tasks finish in time
+    }
+
+    plnk_check (maxDifference == 0.f);
+}
+
+int main()
+{
+    SampleRate::getDefault().setValue (44100.0);
+    BlockSize::getDefault().setValue (blockSize);
+
+    testGraph (buildVoices, false);
+    testGraph (buildChains, false);
+    testGraph (buildNestedMixes, false);
+    testGraph (buildTasks, true);
+
+    return plnk_TestResult ("BufferPlanner");
+}
@@ -0,0 +1,227 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+
+ http://code.google.com/p/pl-nk/
+
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+// Regression test for concurrent busses: readers only ever see blocks that all
+// the writers have committed, and a concurrent bus sounds the same as a serial
+// one in a graph.
+
+#include "plnk_Test.h"
+
+static const int blockSize = 64;
+static const int readSize = 48;
+static const int numWriters = 6;
+static const int numBlocks = 1000;
+static const double sampleRate = 44100.0;
+
+/** State shared by the writers, the reader and the thread stepping the blocks. */
+class BusTestState
+{
+public:
+    BusTestState() throw()
+    :   bus (FloatBus::createConcurrent (BlockSize (blockSize), 8, SampleRate (sampleRate)))
+    {
+        block.setValue (-1);
+    }
+
+    FloatBus bus;
+    AtomicInt block;        // the block the writers may write
+    AtomicInt numWritten;   // blocks written by all the writers
+    AtomicInt numFinished;  // writers that have written all their blocks
+};
+
+/** Writes its index + 1 to each block in two halves. */
+class BusWriter : public plnk_TestThread
+{
+public:
+    BusWriter() throw()
+    :   state (0), index (0)
+    {
+    }
+
+    void test()
+    {
+        const int slot = state->bus.addWriter();
+        float data[blockSize];
+
+        for (int i = 0; i < blockSize; ++i)
+            data[i] = float (index + 1);
+
+        for (int b = 0; b < numBlocks; ++b)
+        {
+            while (state->block.getValue() < b)
+                Threading::yield();
+
+            state->bus.write (slot, TimeStamp::fromSamples (b * blockSize, sampleRate), blockSize / 2, data);
+            state->bus.write (slot, TimeStamp::fromSamples (b * blockSize + blockSize / 2, sampleRate), blockSize / 2, data);
+            ++state->numWritten;
+        }
+
+        ++state->numFinished;
+    }
+
+    BusTestState* state;
+    int index;
+};
+
+/** Reads until the writers finish, counting complete, empty and mixed reads. */
+class BusReader : public plnk_TestThread
+{
+public:
+    BusReader() throw()
+    :   state (0), numComplete (0), numEmpty (0), numMixed (0)
+    {
+    }
+
+    void test()
+    {
+        const float complete = float (numWriters * (numWriters + 1) / 2);
+        TimeStamp time = TimeStamp::getSentinel();
+        float data[readSize];
+
+        while (state->numFinished.getValue() < numWriters)
+        {
+            state->bus.read (time, readSize, data);
+
+            bool isComplete = true;
+            bool isEmpty = true;
+
+            for (int i = 0; i < readSize; ++i)
+            {
+                if (data[i] != complete)
+                    isComplete = false;
+
+                if (data[i] != 0.f)
+                    isEmpty = false;
+            }
+
+            if (isComplete)
+                ++numComplete;
+            else if (isEmpty)
+                ++numEmpty;
+            else
+                ++numMixed;
+
+            Threading::yield();
+        }
+    }
+
+    BusTestState* state;
+    int numComplete;
+    int numEmpty;
+    int numMixed;
+};
+
+static void testConcurrentWriters()
+{
+    BusTestState state;
+    BusWriter writers[numWriters];
+    BusReader reader;
+
+    for (int i = 0; i < numWriters; ++i)
+    {
+        writers[i].state = &state;
+        writers[i].index = i;
+        writers[i].start();
+    }
+
+    reader.state = &state;
+    reader.start();
+
+    for (int b = 0; b < numBlocks; ++b)
+    {
+        state.block.setValue (b);
+
+        while (state.numWritten.getValue() < (b + 1) * numWriters)
+            Threading::yield();
+    }
+
+    for (int i = 0; i < numWriters; ++i)
+        writers[i].waitUntilFinished();
+
+    reader.waitUntilFinished();
+
+    plnk_check (reader.numMixed == 0);
+    plnk_check (reader.numComplete > 0);
+}
+
+static void testGraph()
+{
+    FloatBus::addBus ("serial");
+    FloatBus::addConcurrentBus ("concurrent");
+
+    Unit source = Sine::ar (440) * 0.5;
+    Unit serialWrite = BusWrite::ar (FloatBusses (FloatBus ("serial")), source);
+    Unit concurrentWrite = BusWrite::ar (FloatBusses (FloatBus ("concurrent")), source);
+    Unit serialRead = BusRead::ar (FloatBusses (FloatBus ("serial")));
+    Unit concurrentRead = BusRead::ar (FloatBusses (FloatBus ("concurrent")));
+
+    const int graphBlockSize = BlockSize::getDefault().getValue();
+    ProcessInfo info;
+    float maxDifference = 0.f;
+    int numNonZero = 0;
+
+    for (int b = 0; b < 200; ++b)
+    {
+        serialWrite.process (info, 0);
+        concurrentWrite.process (info, 0);
+
+        const float* serial = serialRead.process (info, 0).getArray();
+        const float* concurrent = concurrentRead.process (info, 0).getArray();
+
+        for (int i = 0; i < graphBlockSize; ++i)
+        {
+            maxDifference = plonk::max (maxDifference, plonk::abs (serial[i] - concurrent[i]));
+
+            if (concurrent[i] != 0.f)
+                ++numNonZero;
+        }
+
+        info.offsetTimeStamp (TimeStamp::fromSamples (graphBlockSize, SampleRate::getDefault().getValue()));
+    }
+
+    plnk_check (maxDifference == 0.f);
+    plnk_check (numNonZero > 0);
+}
+
+int main()
+{
+    testConcurrentWriters();
+    testGraph();
+
+    return plnk_TestResult ("ConcurrentBus");
+}
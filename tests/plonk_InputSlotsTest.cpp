@@ -0,0 +1,118 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+
+ http://code.google.com/p/pl-nk/
+
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+// Regression test for the cached input slots in ChannelInternalCore: inputs
+// replaced through the shared input dictionary must be picked up whether or
+// not the slots have already been resolved.
+
+#include "plnk_Test.h"
+
+static const int blockSize = 16;
+
+static void processBlock (Unit& unit, ProcessInfo& info)
+{
+    unit.process (info);
+    info.offsetTimeStamp (SampleRate::getDefault().getSampleDurationInTicks() * blockSize);
+}
+
+static void testReplacedBeforeProcessing()
+{
+    Unit replaced = Sine::ar (440.f, 1.f, 0.f);
+    Unit reference = Sine::ar (880.f, 1.f, 0.f);
+
+    {
+        Channel channel = replaced.wrapAt (0);
+        Channel::Inputs inputs = channel.getInputs();
+        inputs.put (IOKey::Frequency, Unit (880.f)); // releases the 440 constant
+    }
+
+    ProcessInfo replacedInfo, referenceInfo;
+    float maxDifference = 0.f;
+
+    for (int b = 0; b < 50; ++b)
+    {
+        processBlock (replaced, replacedInfo);
+        processBlock (reference, referenceInfo);
+
+        for (int i = 0; i < blockSize; ++i)
+            maxDifference = plonk::max (maxDifference, plonk::abs (replaced.getOutputSamples (0)[i] - reference.getOutputSamples (0)[i]));
+    }
+
+    plnk_check (maxDifference < 1.0e-6f);
+}
+
+static void testReplacedAfterProcessing()
+{
+    Unit sine = Sine::ar (440.f, 1.f, 0.f);
+    ProcessInfo info;
+
+    for (int b = 0; b < 10; ++b)
+        processBlock (sine, info);
+
+    {
+        Channel channel = sine.wrapAt (0);
+        Channel::Inputs inputs = channel.getInputs();
+        inputs.put (IOKey::Frequency, Unit (0.f)); // the phase stops so the output holds
+    }
+
+    float minimum = 1.f;
+    float maximum = -1.f;
+
+    for (int b = 0; b < 10; ++b)
+    {
+        processBlock (sine, info);
+
+        for (int i = 0; i < blockSize; ++i)
+        {
+            minimum = plonk::min (minimum, sine.getOutputSamples (0)[i]);
+            maximum = plonk::max (maximum, sine.getOutputSamples (0)[i]);
+        }
+    }
+
+    plnk_check (maximum == minimum);
+}
+
+int main()
+{
+    BlockSize::getDefault().setValue (blockSize);
+
+    testReplacedBeforeProcessing();
+    testReplacedAfterProcessing();
+
+    return plnk_TestResult ("InputSlots");
+}
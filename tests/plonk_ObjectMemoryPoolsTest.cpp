@@ -0,0 +1,228 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+
+ http://code.google.com/p/pl-nk/
+
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+// Regression test for ObjectMemoryPools: size classes, blocks handed between
+// threads, caches of exiting threads and the audio thread's deferred frees.
+
+#include "plnk_Test.h"
+
+static const int numChurnThreads = 4;
+static const int numChurnIterations = 50000;
+
+/** Allocates and frees a mix of sizes, passing some blocks to other threads. */
+class ChurnThread : public plnk_TestThread
+{
+public:
+    ChurnThread() throw()
+    :   queue (0), seed (0), numCorrupt (0)
+    {
+    }
+
+    void test()
+    {
+        for (int i = 0; i < numChurnIterations; ++i)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            Floats floats = Floats::newClear (2 + (seed >> 8) % 300);
+            floats[0] = 1.f;
+            floats[floats.length() - 1] = 2.f;
+
+            if ((seed & 3) == 0)
+            {
+                queue->push (floats);
+            }
+            else if ((seed & 3) == 1)
+            {
+                Floats other = queue->pop();
+
+                if ((other.length() > 0) && ((other[0] != 1.f) || (other[other.length() - 1] != 2.f)))
+                    ++numCorrupt;
+            }
+        }
+
+        ObjectMemoryPools::flushThreadCache();
+    }
+
+    LockFreeQueue<Floats>* queue;
+    unsigned int seed;
+    int numCorrupt;
+};
+
+/** Fills its cache with blocks then exits without flushing it. */
+class ExitingThread : public plnk_TestThread
+{
+public:
+    void test()
+    {
+        ObjectArray<Floats> floats;
+
+        for (int i = 0; i < 40; ++i)
+            floats.add (Floats::newClear (100));
+    }
+};
+
+/** Churns enough blocks on the audio thread to need magazines and a cache it
+ must not allocate itself. */
+class AudioThread : public plnk_TestThread
+{
+public:
+    void test()
+    {
+        Threading::setAudioThreadID (Threading::getCurrentThreadID());
+
+        ObjectArray<Floats> floats;
+
+        for (int i = 0; i < 200; ++i)
+            floats.add (Floats::newClear (300));
+
+        floats.clear();
+
+        for (int i = 0; i < 100; ++i)
+            floats.add (Floats::newClear (5000));
+
+        floats.clear();
+    }
+};
+
+static int getSizeClassForFloats (const int length)
+{
+    return ObjectMemoryPools::getSizeClass (length * sizeof (float) + ObjectMemoryPools::Alignment);
+}
+
+static void testSizeClasses()
+{
+    for (UnsignedLong size = 1; size < 100000; ++size)
+    {
+        const int sizeClass = ObjectMemoryPools::getSizeClass (size);
+        const UnsignedLong bytes = ObjectMemoryPools::getSizeClassBytes (sizeClass);
+
+        plnk_check (bytes >= size);
+        plnk_check ((sizeClass == 0) || (ObjectMemoryPools::getSizeClassBytes (sizeClass - 1) < size));
+        plnk_check (bytes <= size * 1.25 + ObjectMemoryPools::MinimumBlockSize);
+        plnk_check (ObjectMemoryPools::getSizeClass (bytes) == sizeClass);
+    }
+}
+
+static void testChurn (ObjectMemoryPools& pools)
+{
+    LockFreeQueue<Floats> queue;
+    ChurnThread threads[numChurnThreads];
+
+    for (int i = 0; i < numChurnThreads; ++i)
+    {
+        threads[i].queue = &queue;
+        threads[i].seed = 1234 + i;
+        threads[i].start();
+    }
+
+    for (int i = 0; i < numChurnThreads; ++i)
+    {
+        threads[i].waitUntilFinished();
+        plnk_check (threads[i].numCorrupt == 0);
+    }
+
+    queue.clearAll();
+
+    const ObjectMemoryPools::Stats stats = pools.getStats();
+    plnk_check (stats.hits > 0);
+    plnk_check (stats.numBlocks <= stats.highWater);
+}
+
+static void testThreadExit (ObjectMemoryPools& pools)
+{
+    const int sizeClass = getSizeClassForFloats (100);
+
+    ExitingThread thread;
+    thread.start();
+    thread.waitUntilFinished();
+    Threading::sleep (0.1); // for the thread's exit callbacks
+
+    // the exiting thread's cache went back to the shared pools so these are all reused
+    const ObjectMemoryPools::Stats before = pools.getStats (sizeClass);
+
+    {
+        ObjectArray<Floats> floats;
+
+        for (int i = 0; i < 40; ++i)
+            floats.add (Floats::newClear (100));
+    }
+
+    const ObjectMemoryPools::Stats after = pools.getStats (sizeClass);
+    plnk_check (after.misses == before.misses);
+}
+
+static void testAudioThread (ObjectMemoryPools& pools)
+{
+    const int sizeClass = getSizeClassForFloats (5000);
+
+    pools.preheat (300 * sizeof (float), 200);
+
+    AudioThread thread;
+    thread.start();
+    thread.waitUntilFinished();
+
+    // give the background thread time to pool the blocks the audio thread deferred
+    Threading::sleep (0.3);
+
+    const ObjectMemoryPools::Stats before = pools.getStats (sizeClass);
+
+    {
+        ObjectArray<Floats> floats;
+
+        for (int i = 0; i < 100; ++i)
+            floats.add (Floats::newClear (5000));
+    }
+
+    const ObjectMemoryPools::Stats after = pools.getStats (sizeClass);
+    plnk_check (after.misses == before.misses);
+}
+
+int main()
+{
+    ObjectMemoryPools* pools = new ObjectMemoryPools (Memory::global());
+    pools->init();
+
+    testSizeClasses();
+    testChurn (*pools);
+    testThreadExit (*pools);
+    testAudioThread (*pools);
+
+    delete pools;
+
+    return plnk_TestResult ("ObjectMemoryPools");
+}
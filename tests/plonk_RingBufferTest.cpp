@@ -0,0 +1,276 @@
+/*
+ -------------------------------------------------------------------------------
+ This file is part of the Plink, Plonk, Plank libraries
+  by Martin Robinson
+
+ http://code.google.com/p/pl-nk/
+
+ Copyright University of the West of England, Bristol 2011-14
+ All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without
+ modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+ * Neither the name of University of the West of England, Bristol nor
+   the names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ DISCLAIMED. IN NO EVENT SHALL UNIVERSITY OF THE WEST OF ENGLAND, BRISTOL BE
+ LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+ This software makes use of third party libraries. For more information see:
+ doc/license.txt included in the distribution.
+ -------------------------------------------------------------------------------
+ */
+
+// Regression test for RingBufferSPSC and RingBufferMPSC: capacity, ordering
+// across threads, batches that wrap the ring and values with reference counts.
+
+#include "plnk_Test.h"
+
+static const int numItems = 400000;
+static const int numProducers = 4;
+
+/** Pushes 0...numItems-1 one at a time or in batches. */
+class SPSCProducer : public plnk_TestThread
+{
+public:
+    SPSCProducer (RingBufferSPSC<int> const& ringToUse, const bool batchesToUse) throw()
+    :   ring (ringToUse), batches (batchesToUse)
+    {
+    }
+
+    void test()
+    {
+        int values[50];
+        int i = 0;
+
+        while (i < numItems)
+        {
+            if (batches)
+            {
+                const int count = plonk::min (50, numItems - i);
+
+                for (int j = 0; j < count; ++j)
+                    values[j] = i + j;
+
+                const int numPushed = ring.pushItems (values, count);
+                i += numPushed;
+
+                if (numPushed == 0)
+                    Threading::yield();
+            }
+            else if (ring.push (i))
+            {
+                ++i;
+            }
+            else
+            {
+                Threading::yield();
+            }
+        }
+    }
+
+private:
+    RingBufferSPSC<int> ring;
+    const bool batches;
+};
+
+/** Pushes its own sequence, tagged with its index, mixing single values and batches. */
+class MPSCProducer : public plnk_TestThread
+{
+public:
+    MPSCProducer() throw()
+    :   index (0)
+    {
+    }
+
+    void test()
+    {
+        const int numOwnItems = numItems / numProducers;
+        int values[8];
+        int i = 0;
+
+        while (i < numOwnItems)
+        {
+            if ((i % 3) == 0)
+            {
+                const int count = plonk::min (8, numOwnItems - i);
+
+                for (int j = 0; j < count; ++j)
+                    values[j] = index * numItems + i + j;
+
+                const int numPushed = ring.pushItems (values, count);
+                i += numPushed;
+
+                if (numPushed == 0)
+                    Threading::yield();
+            }
+            else if (ring.push (index * numItems + i))
+            {
+                ++i;
+            }
+            else
+            {
+                Threading::yield();
+            }
+        }
+    }
+
+    RingBufferMPSC<int> ring;
+    int index;
+};
+
+static void testCapacity()
+{
+    RingBufferSPSC<int> spsc (1000);
+    plnk_check (spsc.getCapacity() == 1024);
+
+    RingBufferMPSC<int> mpsc (256);
+    plnk_check (mpsc.getCapacity() == 256);
+
+    int value;
+    plnk_check (!mpsc.pop (value));
+
+    for (int i = 0; i < mpsc.getCapacity(); ++i)
+        plnk_check (mpsc.push (i));
+
+    plnk_check (!mpsc.push (-1));
+    plnk_check (mpsc.length() == mpsc.getCapacity());
+
+    int values[300];
+    plnk_check (mpsc.popItems (values, 300) == 256);
+    plnk_check ((values[0] == 0) && (values[255] == 255));
+    plnk_check (mpsc.length() == 0);
+}
+
+static void testSPSC (const bool batches)
+{
+    RingBufferSPSC<int> ring (1000);
+    SPSCProducer producer (ring, batches);
+    producer.start();
+
+    int values[64];
+    int next = 0;
+    bool inOrder = true;
+
+    while (next < numItems)
+    {
+        const int count = batches ? ring.popItems (values, 64) : (ring.pop (values[0]) ? 1 : 0);
+
+        for (int j = 0; j < count; ++j)
+            if (values[j] != next + j)
+                inOrder = false;
+
+        next += count;
+
+        if (count == 0)
+            Threading::yield();
+    }
+
+    producer.waitUntilFinished();
+
+    plnk_check (inOrder);
+    plnk_check (ring.length() == 0);
+}
+
+static void testMPSC()
+{
+    RingBufferMPSC<int> ring (256);
+    MPSCProducer producers[numProducers];
+
+    for (int i = 0; i < numProducers; ++i)
+    {
+        producers[i].ring = ring;
+        producers[i].index = i;
+        producers[i].start();
+    }
+
+    int next[numProducers] = { 0 };
+    int values[16];
+    int total = 0;
+    bool inOrder = true;
+
+    while (total < numItems)
+    {
+        const int count = (total & 1) ? ring.popItems (values, 16) : (ring.pop (values[0]) ? 1 : 0);
+
+        for (int j = 0; j < count; ++j)
+        {
+            const int index = values[j] / numItems;
+
+            if ((index < 0) || (index >= numProducers) || ((values[j] % numItems) != next[index]))
+                inOrder = false;
+            else
+                ++next[index];
+        }
+
+        total += count;
+
+        if (count == 0)
+            Threading::yield();
+    }
+
+    for (int i = 0; i < numProducers; ++i)
+    {
+        producers[i].waitUntilFinished();
+        plnk_check (next[i] == numItems / numProducers);
+    }
+
+    plnk_check (inOrder);
+    plnk_check (ring.length() == 0);
+}
+
+static void testObjectValues()
+{
+    Text text ("hello");
+
+    {
+        RingBufferSPSC<Text> ring (4);
+
+        for (int i = 0; i < 4; ++i)
+            plnk_check (ring.push (text));
+
+        plnk_check (!ring.push (text));
+        plnk_check (text.getInternal()->getRefCount() == 5);
+
+        Text popped;
+        plnk_check (ring.pop (popped));
+        plnk_check (popped == text);
+
+        Text others[3] = { "x", "y", "z" };
+        plnk_check (ring.pushItems (others, 3) == 1);
+
+        Text values[8];
+        plnk_check (ring.popItems (values, 8) == 4);
+        plnk_check (values[3] == "x");
+
+        ring.push (text); // left for the destructor
+    }
+
+    plnk_check (text.getInternal()->getRefCount() == 1);
+}
+
+int main()
+{
+    testCapacity();
+    testSPSC (false);
+    testSPSC (true);
+    testMPSC();
+    testObjectValues();
+
+    return plnk_TestResult ("RingBuffer");
+}